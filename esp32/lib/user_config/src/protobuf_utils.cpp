@@ -37,6 +37,20 @@ void printDecodedConfig(const UserConfiguration *pb_config) {
                   pb_config->enabled_sensors_multiple[i].cell_id);
     Serial.printf(" %03d - index=%d\r\n", i,
                   pb_config->enabled_sensors_multiple[i].index);
+    Serial.printf(" %03d - period=%u\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].period);
+    Serial.printf(" %03d - phase=%u\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].phase);
+    Serial.printf(" %03d - aggregate_count=%u\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].aggregate_count);
+    Serial.printf(" %03d - aggregate_period=%u\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].aggregate_period);
+    Serial.printf(" %03d - deadband_absolute=%.4f\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].deadband_absolute);
+    Serial.printf(" %03d - deadband_relative=%.4f\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].deadband_relative);
+    Serial.printf(" %03d - heartbeat=%u\r\n", i,
+                  pb_config->enabled_sensors_multiple[i].heartbeat);
   }
 
   Serial.println();
@@ -0,0 +1,261 @@
+/**
+ * @file aggregate_replay.c
+ * @brief Replays recorded measurements and compares raw and summary uplinks
+ *
+ * Reads a csv with a header and a time column in seconds followed by one
+ * column per sensor. Every row is a measurement of each sensor, encoded the
+ * same way as the sensor callbacks. The measurements are then uploaded twice:
+ *
+ * - raw: every measurement is stored and uploaded
+ * - summary: measurements pass through the aggregator from stm32/lib/sensors
+ *   and only the Summary of each window is stored and uploaded
+ *
+ * Stored measurements are packed into RepeatedSensorMeasurements the same way
+ * as FormatPayload, up to 16 per uplink and the max payload size.
+ *
+ * Build and run from extras/aggregation:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include -I../../proto/c/include \
+ *     aggregate_replay.c ../../stm32/lib/sensors/src/aggregate.c \
+ *     ../../proto/c/src/sensor.c ../../proto/c/src/sensor.pb.c \
+ *     ../../proto/c/src/pb_*.c -lm -o aggregate_replay
+ * ./aggregate_replay -c 60 ../compression/tx_power/data_1_minute_sampling.csv
+ * @endcode
+ *
+ * Pass -c for aggregate_count, -p for aggregate_period in seconds, -s to
+ * replay every nth row and -b for the max payload size in bytes (default
+ * LORAWAN_APP_DATA_BUFFER_MAX_SIZE). Columns are given the sensor types
+ * POWER_VOLTAGE, POWER_CURRENT, TEROS12_VWC and so on in order.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "aggregate.h"
+#include "sensor.h"
+
+/** Max payload size of the stm32 */
+#define LORAWAN_APP_DATA_BUFFER_MAX_SIZE 242
+
+/** Max number of measurements in a RepeatedSensorMeasurements */
+#define MAX_PER_UPLINK 16
+
+/** Max number of sensor columns */
+#define MAX_COLUMNS 8
+
+/** Timestamp of the first row */
+#define START_TS 1700000000
+
+/** Uplink accounting of one replay */
+typedef struct {
+  /** Measurements in the FRAM buffer */
+  uint64_t records;
+  /** Bytes in the FRAM buffer */
+  uint64_t stored_bytes;
+  /** Number of uplinks */
+  uint64_t uplinks;
+  /** Bytes of all uplinks */
+  uint64_t uplink_bytes;
+  /** Measurements packed into the current uplink */
+  SensorMeasurement pending[MAX_PER_UPLINK];
+  /** Length of @ref pending */
+  size_t pending_len;
+} Uplink;
+
+/** Max payload size */
+static size_t payload_size = LORAWAN_APP_DATA_BUFFER_MAX_SIZE;
+
+/**
+ * @brief Encode the packed measurements as one uplink
+ */
+static void Send(Uplink *up) {
+  if (up->pending_len == 0) {
+    return;
+  }
+
+  Metadata meta = Metadata_init_default;
+  uint8_t buffer[RepeatedSensorMeasurements_size];
+  size_t length = 0;
+  if (EncodeRepeatedSensorMeasurements(meta, up->pending, up->pending_len,
+                                       buffer, sizeof(buffer),
+                                       &length) != SENSOR_OK) {
+    fprintf(stderr, "could not encode uplink\n");
+    exit(1);
+  }
+
+  up->uplinks++;
+  up->uplink_bytes += length;
+  up->pending_len = 0;
+}
+
+/**
+ * @brief Store a measurement, packing it into the current uplink
+ *
+ * The uplink is sent first if the measurement does not fit.
+ */
+static void Store(Uplink *up, const SensorMeasurement *meas) {
+  uint8_t buffer[SensorMeasurement_size];
+  size_t length = sizeof(buffer);
+  if (EncodeSensorMeasurement(meas, buffer, &length) != SENSOR_OK) {
+    fprintf(stderr, "could not encode measurement\n");
+    exit(1);
+  }
+  up->records++;
+  up->stored_bytes += length;
+
+  if (up->pending_len == MAX_PER_UPLINK) {
+    Send(up);
+  }
+
+  up->pending[up->pending_len++] = *meas;
+
+  Metadata meta = Metadata_init_default;
+  size_t size = 0;
+  RepeatedSensorMeasurementsSize(meta, up->pending, up->pending_len, &size);
+  if (size > payload_size && up->pending_len > 1) {
+    up->pending_len--;
+    Send(up);
+    up->pending[up->pending_len++] = *meas;
+  }
+}
+
+static void PrintRow(const char *name, const Uplink *up) {
+  printf("%-8s %10llu %12llu %10llu %12llu\n", name,
+         (unsigned long long)up->records,
+         (unsigned long long)up->stored_bytes,
+         (unsigned long long)up->uplinks,
+         (unsigned long long)up->uplink_bytes);
+}
+
+static void Usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [-c count] [-p period_s] [-s step] [-b payload_size] "
+          "file.csv\n",
+          name);
+}
+
+int main(int argc, char **argv) {
+  uint32_t count = 0;
+  uint32_t period = 0;
+  unsigned long step = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "c:p:s:b:")) != -1) {
+    switch (opt) {
+      case 'c':
+        count = (uint32_t)strtoul(optarg, NULL, 10);
+        break;
+      case 'p':
+        period = (uint32_t)strtoul(optarg, NULL, 10);
+        break;
+      case 's':
+        step = strtoul(optarg, NULL, 10);
+        break;
+      case 'b':
+        payload_size = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        Usage(argv[0]);
+        return 1;
+    }
+  }
+
+  if (optind + 1 != argc || step == 0 || (count == 0 && period == 0)) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  FILE *file = fopen(argv[optind], "r");
+  if (file == NULL) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  static Aggregator agg;
+  static Uplink raw;
+  static Uplink summary;
+  AggregateInit(&agg);
+
+  char line[512];
+  // skip header
+  if (fgets(line, sizeof(line), file) == NULL) {
+    fprintf(stderr, "empty file\n");
+    return 1;
+  }
+
+  size_t columns = 0;
+  unsigned long row = 0;
+  double first = 0;
+  double last = 0;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (row++ % step != 0) {
+      continue;
+    }
+
+    char *end = line;
+    const double t = strtod(end, &end);
+    if (row == 1) {
+      first = t;
+    }
+    last = t;
+
+    size_t col = 0;
+    while (*end == ',' && col < MAX_COLUMNS) {
+      const double x = strtod(end + 1, &end);
+
+      SensorMeasurement meas = SensorMeasurement_init_zero;
+      meas.has_meta = true;
+      meas.meta.cell_id = 1;
+      meas.meta.logger_id = 1;
+      meas.meta.ts = START_TS + (uint32_t)(t - first);
+      meas.type = (SensorType)(col + 1);
+      meas.which_value = SensorMeasurement_decimal_tag;
+      meas.value.decimal = x;
+
+      Store(&raw, &meas);
+
+      SensorMeasurement sum;
+      switch (AggregateAdd(&agg, col, count, period, &meas, &sum)) {
+        case AGGREGATE_RAW:
+          Store(&summary, &meas);
+          break;
+        case AGGREGATE_SUMMARY:
+          Store(&summary, &sum);
+          break;
+        case AGGREGATE_HELD:
+          break;
+      }
+      ++col;
+    }
+    if (col > columns) {
+      columns = col;
+    }
+  }
+  fclose(file);
+
+  // partial windows are uploaded when the sensors stop
+  SensorMeasurement sum;
+  while (AggregateFlush(&agg, &sum)) {
+    Store(&summary, &sum);
+  }
+  Send(&raw);
+  Send(&summary);
+
+  printf("%zu sensors, %lu rows, %.1f s, count %u, period %u s, payload %zu B"
+         "\n\n",
+         columns, (row + step - 1) / step, last - first, count, period,
+         payload_size);
+  printf("%-8s %10s %12s %10s %12s\n", "", "records", "stored_B", "uplinks",
+         "uplink_B");
+  PrintRow("raw", &raw);
+  PrintRow("summary", &summary);
+  printf("\nuplink bytes reduced by %.1f%%\n",
+         100.0 * (1.0 - (double)summary.uplink_bytes / raw.uplink_bytes));
+
+  return 0;
+}
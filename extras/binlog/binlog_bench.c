@@ -0,0 +1,201 @@
+/**
+ * @file binlog_bench.c
+ * @brief Compares the time per log call of APP_LOG and BINLOG on the host
+ *
+ * Links binlog.c from stm32/lib/binlog with stubs of the interrupt mask and
+ * the verbose levels.
+ * APP_LOG is modeled after UTIL_ADV_TRACE_COND_FSend, which formats the
+ * timestamp and the message with vsnprintf into a temporary buffer and copies
+ * it into the trace fifo. A payload hex dump is logged the way SendTxData
+ * did before, with an APP_LOG per byte, and with a single BINLOG. The times
+ * are only indicative, the cycles on the stm32 are counted by
+ * example_binlog.
+ *
+ * A line of text and two records are then written to a capture file to check
+ * the decoder:
+ *
+ * @code
+ * gcc -O2 -no-pie -Ihost -I../../stm32/Inc -I../../stm32/lib/binlog/include \
+ *     binlog_bench.c ../../stm32/lib/binlog/src/binlog.c -o binlog_bench
+ * ./binlog_bench 100000 capture.bin
+ * python ../../stm32/binlog_table.py binlog_bench binlog.json
+ * ents binlog --file binlog.json capture.bin
+ * @endcode
+ *
+ * -no-pie keeps the addresses of the format strings the same as in the ELF.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "binlog.h"
+
+/** Same as UTIL_ADV_TRACE_TMP_BUF_SIZE */
+#define TMP_BUF_SIZE 512
+
+/** Same as UTIL_ADV_TRACE_FIFO_SIZE */
+#define FIFO_SIZE 1024
+
+/** Length of the payload */
+#define PAYLOAD_SIZE 50
+
+/** Records logged between flushes */
+#define BATCH 8
+
+/** Trace fifo */
+static char fifo[FIFO_SIZE];
+
+/** Write position in the trace fifo */
+static size_t fifo_pos = 0;
+
+/** Milliseconds since start, changed so nothing is folded */
+static volatile uint32_t now = 12345;
+
+/** Capture of the frames */
+static FILE *capture = NULL;
+
+/**
+ * @brief Copy a formatted message into the trace fifo
+ */
+static void FifoWrite(const char *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    fifo[fifo_pos++ % FIFO_SIZE] = data[i];
+  }
+}
+
+/**
+ * @brief Model of UTIL_ADV_TRACE_COND_FSend
+ */
+static void TraceFSend(int ts, const char *fmt, ...) {
+  char buf[TMP_BUF_SIZE];
+  if (ts) {
+    const int len =
+        snprintf(buf, sizeof(buf), "%ds%03d:", (int)(now / 1000),
+                 (int)(now % 1000));
+    FifoWrite(buf, len);
+  }
+
+  va_list args;
+  va_start(args, fmt);
+  const int len = vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  FifoWrite(buf, len);
+}
+
+#define APP_LOG(TS, VL, ...) TraceFSend(TS, __VA_ARGS__)
+
+/**
+ * @brief Timestamp of the records
+ */
+static uint32_t Timestamp(void) { return now; }
+
+/**
+ * @brief Drop the frames
+ */
+static bool Discard(const uint8_t *data, size_t len) {
+  (void)data;
+  (void)len;
+  return true;
+}
+
+/**
+ * @brief Write the frames to the capture
+ */
+static bool Capture(const uint8_t *data, size_t len) {
+  return fwrite(data, 1, len, capture) == len;
+}
+
+/**
+ * @brief Current time in ns
+ */
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+  const long iterations = (argc > 1) ? atol(argv[1]) : 100000;
+  const char *path = (argc > 2) ? argv[2] : "capture.bin";
+
+  uint8_t payload[PAYLOAD_SIZE];
+  for (int i = 0; i < PAYLOAD_SIZE; i++) {
+    payload[i] = i * 37;
+  }
+
+  BinlogInit(VLEVEL_M, Timestamp);
+
+  // hex dump
+  double start = Now();
+  for (long i = 0; i < iterations; i++) {
+    APP_LOG(TS_ON, VLEVEL_M, "Payload (%d): ", PAYLOAD_SIZE);
+    for (int j = 0; j < PAYLOAD_SIZE; j++) {
+      APP_LOG(TS_OFF, VLEVEL_M, "%02X ", payload[j]);
+    }
+    APP_LOG(TS_OFF, VLEVEL_M, "\r\n");
+    now++;
+  }
+  const double hex_app_log = Now() - start;
+
+  double hex_binlog = 0;
+  double hex_flush = 0;
+  for (long i = 0; i < iterations; i += BATCH) {
+    start = Now();
+    for (int j = 0; j < BATCH; j++) {
+      BINLOG(VLEVEL_M, "Payload (%d): %H\r\n", PAYLOAD_SIZE,
+             BINLOG_BLOB(payload, PAYLOAD_SIZE));
+      now++;
+    }
+    const double logged = Now();
+    BinlogFlush(Discard);
+    hex_binlog += logged - start;
+    hex_flush += Now() - logged;
+  }
+
+  // single integer
+  start = Now();
+  for (long i = 0; i < iterations; i++) {
+    APP_LOG(TS_ON, VLEVEL_M, "Buffer length: %u\r\n", PAYLOAD_SIZE);
+    now++;
+  }
+  const double int_app_log = Now() - start;
+
+  double int_binlog = 0;
+  double int_flush = 0;
+  for (long i = 0; i < iterations; i += BATCH) {
+    start = Now();
+    for (int j = 0; j < BATCH; j++) {
+      BINLOG(VLEVEL_M, "Buffer length: %u\r\n", PAYLOAD_SIZE);
+      now++;
+    }
+    const double logged = Now();
+    BinlogFlush(Discard);
+    int_binlog += logged - start;
+    int_flush += Now() - logged;
+  }
+
+  printf("%-10s %10s %10s %10s\n", "ns per log", "APP_LOG", "BINLOG",
+         "flush");
+  printf("%-10s %10.1f %10.1f %10.1f\n", "hex dump", hex_app_log / iterations,
+         hex_binlog / iterations, hex_flush / iterations);
+  printf("%-10s %10.1f %10.1f %10.1f\n", "integer", int_app_log / iterations,
+         int_binlog / iterations, int_flush / iterations);
+
+  capture = fopen(path, "wb");
+  if (capture == NULL) {
+    perror(path);
+    return 1;
+  }
+  fputs("text from APP_LOG\r\n", capture);
+  BINLOG(VLEVEL_M, "Payload (%d): %H\r\n", PAYLOAD_SIZE,
+         BINLOG_BLOB(payload, PAYLOAD_SIZE));
+  BINLOG(VLEVEL_M, "Buffer length: %u\r\n", PAYLOAD_SIZE);
+  BinlogFlush(Capture);
+  fclose(capture);
+
+  return 0;
+}
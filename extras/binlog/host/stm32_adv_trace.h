@@ -0,0 +1,26 @@
+/**
+ * @file stm32_adv_trace.h
+ * @brief Verbose levels of the trace for building the logging on the host
+ */
+
+#ifndef EXTRAS_BINLOG_HOST_STM32_ADV_TRACE_H_
+#define EXTRAS_BINLOG_HOST_STM32_ADV_TRACE_H_
+
+#include <stdint.h>
+
+#define VLEVEL_OFF 0
+#define VLEVEL_ALWAYS 0
+#define VLEVEL_L 1
+#define VLEVEL_M 2
+#define VLEVEL_H 3
+
+#define TS_OFF 0
+#define TS_ON 1
+#define T_REG_OFF 0
+
+#define UTIL_ADV_TRACE_OK 0
+
+int UTIL_ADV_TRACE_COND_FSend(uint32_t level, uint32_t region, uint32_t ts,
+                              const char *fmt, ...);
+
+#endif  // EXTRAS_BINLOG_HOST_STM32_ADV_TRACE_H_
@@ -0,0 +1,19 @@
+/**
+ * @file stm32wlxx_hal.h
+ * @brief Interrupt mask of CMSIS for building binlog.c on the host
+ */
+
+#ifndef EXTRAS_BINLOG_HOST_STM32WLXX_HAL_H_
+#define EXTRAS_BINLOG_HOST_STM32WLXX_HAL_H_
+
+#include <stdint.h>
+
+static uint32_t host_primask = 0;
+
+static inline uint32_t __get_PRIMASK(void) { return host_primask; }
+
+static inline void __disable_irq(void) { host_primask = 1; }
+
+static inline void __set_PRIMASK(uint32_t primask) { host_primask = primask; }
+
+#endif  // EXTRAS_BINLOG_HOST_STM32WLXX_HAL_H_
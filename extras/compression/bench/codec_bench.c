@@ -0,0 +1,157 @@
+/**
+ * @file codec_bench.c
+ * @brief Reports which codec CodecCompress selects on recorded payloads
+ *
+ * Each input file is split into LoRaWAN sized payloads which are compressed
+ * with CodecCompress under the given CPU budget. Every payload is decoded
+ * again to check the round trip. Prints the size of each payload with every
+ * codec, followed by the selection distribution over all files.
+ *
+ * Build and run from extras/compression:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/compress/include bench/codec_bench.c \
+ *     ../../stm32/lib/compress/src/{codec,delta,lz77,lz77_dict,rle}.c \
+ *     -o codec_bench
+ * find messages adc_bin -name '*.bin' | xargs ./codec_bench -b 0
+ * @endcode
+ *
+ * Pass -D COMPRESS_DISABLE_<CODEC> to gcc to see the effect of excluding a
+ * codec.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "codec.h"
+
+/** Size of a single payload, max LoRaWAN payload less the codec header */
+#define PAYLOAD_SIZE 221
+
+static const char *codec_names[CODEC_COUNT] = {
+    "none", "rle", "delta", "lz77", "lz77_dict",
+};
+
+static uint8_t *ReadFile(const char *path, size_t *len) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  *len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *data = malloc(*len);
+  if (data && fread(data, 1, *len, f) != *len) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+  return data;
+}
+
+int main(int argc, char **argv) {
+  uint32_t budget = CODEC_BUDGET_UNLIMITED;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "b:")) != -1) {
+    if (opt == 'b') {
+      budget = strtoul(optarg, NULL, 0);
+    } else {
+      fprintf(stderr, "usage: %s [-b budget_cycles] FILE...\n", argv[0]);
+      return 1;
+    }
+  }
+  if (optind >= argc) {
+    fprintf(stderr, "usage: %s [-b budget_cycles] FILE...\n", argv[0]);
+    return 1;
+  }
+
+  size_t selected_count[CODEC_COUNT] = {0};
+  size_t codec_bytes[CODEC_COUNT] = {0};
+  size_t total_in = 0;
+  size_t total_out = 0;
+  size_t payloads = 0;
+  int failed = 0;
+
+  printf("%-40s %6s %4s", "file", "offset", "len");
+  for (int c = 0; c < CODEC_COUNT; c++) {
+    printf(" %9s", codec_names[c]);
+  }
+  printf(" %9s\n", "selected");
+
+  for (int arg = optind; arg < argc; arg++) {
+    size_t len = 0;
+    uint8_t *data = ReadFile(argv[arg], &len);
+    if (!data) {
+      fprintf(stderr, "could not read %s\n", argv[arg]);
+      failed = 1;
+      continue;
+    }
+
+    const char *name = strrchr(argv[arg], '/');
+    name = name ? name + 1 : argv[arg];
+
+    for (size_t off = 0; off < len; off += PAYLOAD_SIZE) {
+      const size_t n = (len - off < PAYLOAD_SIZE) ? len - off : PAYLOAD_SIZE;
+      uint8_t out[2 * CODEC_MAX_PAYLOAD];
+      size_t out_len = 0;
+
+      printf("%-40s %6zu %4zu", name, off, n);
+      for (int c = 0; c < CODEC_COUNT; c++) {
+        if (!CodecAvailable(c)) {
+          printf(" %9s", "-");
+          continue;
+        }
+        if (CodecEncode(c, data + off, n, out, sizeof(out), &out_len) !=
+            COMPRESS_OK) {
+          printf(" %9s", "err");
+          failed = 1;
+          continue;
+        }
+        codec_bytes[c] += out_len;
+        printf(" %9zu", out_len);
+      }
+
+      CodecId selected = CODEC_NONE;
+      if (CodecCompress(data + off, n, budget, out, sizeof(out), &out_len,
+                        &selected) != COMPRESS_OK) {
+        fprintf(stderr, "compress failed for %s at offset %zu\n", name, off);
+        failed = 1;
+        continue;
+      }
+      printf(" %9s\n", codec_names[selected]);
+
+      uint8_t decoded[CODEC_MAX_PAYLOAD];
+      size_t decoded_len = 0;
+      if (CodecDecode(out, out_len, decoded, sizeof(decoded), &decoded_len) !=
+              COMPRESS_OK ||
+          decoded_len != n || memcmp(decoded, data + off, n) != 0) {
+        fprintf(stderr, "round trip failed for %s at offset %zu\n", name, off);
+        failed = 1;
+      }
+
+      ++selected_count[selected];
+      total_in += n;
+      total_out += out_len;
+      ++payloads;
+    }
+
+    free(data);
+  }
+
+  printf("\nbudget %u cycles, %zu payloads, %zu -> %zu bytes (%.3f)\n",
+         budget, payloads, total_in, total_out,
+         total_out ? (double)total_in / total_out : 0.0);
+  printf("%-10s %8s %8s %10s\n", "codec", "selected", "percent", "bytes_only");
+  for (int c = 0; c < CODEC_COUNT; c++) {
+    printf("%-10s %8zu %7.1f%% %10zu\n", codec_names[c], selected_count[c],
+           payloads ? 100.0 * selected_count[c] / payloads : 0.0,
+           codec_bytes[c]);
+  }
+
+  return failed;
+}
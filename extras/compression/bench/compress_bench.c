@@ -0,0 +1,537 @@
+/**
+ * @file compress_bench.c
+ * @brief Benchmarks every codec in stm32/lib/compress over the corpora
+ *
+ * Each input file is split into LoRaWAN sized payloads which are compressed
+ * independently, matching how the firmware uses the codecs. For every
+ * (file, codec) pair the following is reported:
+ *
+ * - ratio: uncompressed bytes / compressed bytes, including codec headers
+ * - enc_MBps: encode throughput on the host
+ * - stack: peak stack of a single encode, measured by running the codec on
+ *   a painted stack
+ * - heap: peak heap of a single encode, malloc is wrapped by the linker
+ * - m4_cyc_B: estimated Cortex-M4 cycles per input byte
+ * - m4_us: estimated time to encode a full payload at CPU_HZ
+ * - model_cyc_B: CodecCost() estimate used by the CodecCompress budget
+ *
+ * Cortex-M4 cycles come from an instruction count model. The number of host
+ * instructions per nanosecond is calibrated for each codec by single
+ * stepping one encode with ptrace, which works without hardware performance
+ * counters. The timed host runs are converted to instruction counts with that
+ * rate, then scaled to Thumb-2 instructions and cycles with -t and -c. The
+ * defaults are rough figures for -Os code running from flash with wait
+ * states, refine them against DWT->CYCCNT on target.
+ *
+ * Build and run from extras/compression:
+ *
+ * @code
+ * SRC=../../stm32/lib/compress/src
+ * gcc -O2 -I../../stm32/lib/compress/include bench/compress_bench.c \
+ *     $SRC/{codec,delta,dict,lz77,lz77_dict,lz78,rle}.c \
+ *     -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc,--wrap=free \
+ *     -o compress_bench
+ * find messages adc_bin rld_files -type f | xargs ./compress_bench -o bench.csv
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "codec.h"
+#include "delta.h"
+#include "lz77.h"
+#include "lz78.h"
+#include "rle.h"
+
+/** Default payload size, max LoRaWAN payload less the codec header */
+#define PAYLOAD_SIZE 221
+
+/** Default number of bytes read from each file */
+#define MAX_FILE_BYTES (64 * 1024)
+
+/** Size of the painted stack the codecs run on */
+#define BENCH_STACK_SIZE (64 * 1024)
+
+/** Byte used to paint the stack */
+#define STACK_PAINT 0xA5
+
+/** Minimum time spent timing each (file, codec) pair */
+#define MIN_TIMING_SECONDS 0.05
+
+/** Bytes of the first file used to calibrate instructions per nanosecond */
+#define CALIBRATION_BYTES 96
+
+/** Clock of the STM32WLE5 */
+#define CPU_HZ 48000000.0
+
+/** Encoder signature shared by all codecs */
+typedef CompressStatus (*EncodeFn)(const uint8_t *data, size_t length,
+                                   uint8_t *buffer, size_t size,
+                                   size_t *out_len);
+
+/** Decoder signature shared by all codecs */
+typedef CompressStatus (*DecodeFn)(const uint8_t *data, size_t length,
+                                   uint8_t *buffer, size_t size,
+                                   size_t *out_len);
+
+/** A codec under test */
+typedef struct {
+  const char *name;
+  EncodeFn encode;
+  DecodeFn decode;
+  /** CodecId for the cost model, -1 if not selectable */
+  int id;
+  /** Calibrated host instructions per nanosecond */
+  double insn_per_ns;
+} BenchCodec;
+
+static CompressStatus EncodeNone(const uint8_t *d, size_t l, uint8_t *b,
+                                 size_t s, size_t *o) {
+  return CodecEncode(CODEC_NONE, d, l, b, s, o);
+}
+
+static CompressStatus EncodeLZ77(const uint8_t *d, size_t l, uint8_t *b,
+                                 size_t s, size_t *o) {
+  return LZ77Encode(d, l, NULL, b, s, o);
+}
+
+static CompressStatus DecodeLZ77(const uint8_t *d, size_t l, uint8_t *b,
+                                 size_t s, size_t *o) {
+  return LZ77Decode(d, l, NULL, b, s, o);
+}
+
+static CompressStatus EncodeLZ77Dict(const uint8_t *d, size_t l, uint8_t *b,
+                                     size_t s, size_t *o) {
+  return LZ77Encode(d, l, &lz77_dict, b, s, o);
+}
+
+static CompressStatus DecodeLZ77Dict(const uint8_t *d, size_t l, uint8_t *b,
+                                     size_t s, size_t *o) {
+  return LZ77Decode(d, l, &lz77_dict, b, s, o);
+}
+
+static CompressStatus EncodeSelect(const uint8_t *d, size_t l, uint8_t *b,
+                                   size_t s, size_t *o) {
+  return CodecCompress(d, l, CODEC_BUDGET_UNLIMITED, b, s, o, NULL);
+}
+
+static BenchCodec codecs[] = {
+    {"none", EncodeNone, CodecDecode, CODEC_NONE, 0},
+    {"rle", RLEEncode, RLEDecode, CODEC_RLE, 0},
+    {"delta", DeltaEncode, DeltaDecode, CODEC_DELTA, 0},
+    {"lz77", EncodeLZ77, DecodeLZ77, CODEC_LZ77, 0},
+    {"lz77_dict", EncodeLZ77Dict, DecodeLZ77Dict, CODEC_LZ77_DICT, 0},
+    {"lz78", LZ78Encode, LZ78Decode, -1, 0},
+    {"select", EncodeSelect, CodecDecode, -1, 0},
+};
+
+#define NUM_CODECS (sizeof(codecs) / sizeof(codecs[0]))
+
+/** Arguments of the encode run on the painted stack or under ptrace */
+static struct {
+  const BenchCodec *codec;
+  const uint8_t *data;
+  size_t length;
+  uint8_t buffer[2 * CODEC_MAX_PAYLOAD];
+  size_t out_len;
+} job;
+
+static void RunJob(void) {
+  if (job.codec != NULL) {
+    job.codec->encode(job.data, job.length, job.buffer, sizeof(job.buffer),
+                      &job.out_len);
+  }
+}
+
+/*
+ * Heap accounting, enabled with the --wrap linker flags
+ */
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+
+static int heap_tracking = 0;
+static size_t heap_current = 0;
+static size_t heap_peak = 0;
+
+/** Allocations are prefixed with their size so free can account for them */
+typedef union {
+  size_t size;
+  max_align_t align;
+} HeapHeader;
+
+static void *Track(HeapHeader *h, size_t size) {
+  if (h == NULL) {
+    return NULL;
+  }
+  h->size = heap_tracking ? size : 0;
+  heap_current += h->size;
+  if (heap_current > heap_peak) {
+    heap_peak = heap_current;
+  }
+  return h + 1;
+}
+
+void *__wrap_malloc(size_t size) {
+  return Track(__real_malloc(sizeof(HeapHeader) + size), size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  return Track(__real_calloc(1, sizeof(HeapHeader) + n * size), n * size);
+}
+
+void __wrap_free(void *ptr) {
+  if (ptr == NULL) {
+    return;
+  }
+  HeapHeader *h = (HeapHeader *)ptr - 1;
+  heap_current -= h->size;
+  __real_free(h);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  if (ptr == NULL) {
+    return __wrap_malloc(size);
+  }
+  HeapHeader *h = (HeapHeader *)ptr - 1;
+  heap_current -= h->size;
+  return Track(__real_realloc(h, sizeof(HeapHeader) + size), size);
+}
+
+/*
+ * Stack measurement
+ */
+
+static ucontext_t main_ctx;
+static ucontext_t bench_ctx;
+static uint8_t bench_stack[BENCH_STACK_SIZE] __attribute__((aligned(16)));
+
+/**
+ * @brief Runs the job on a painted stack
+ *
+ * @return Number of stack bytes touched
+ */
+static size_t StackUsage(void) {
+  memset(bench_stack, STACK_PAINT, sizeof(bench_stack));
+
+  getcontext(&bench_ctx);
+  bench_ctx.uc_stack.ss_sp = bench_stack;
+  bench_ctx.uc_stack.ss_size = sizeof(bench_stack);
+  bench_ctx.uc_link = &main_ctx;
+  makecontext(&bench_ctx, RunJob, 0);
+  swapcontext(&main_ctx, &bench_ctx);
+
+  // stack grows down, find the lowest touched byte
+  size_t i = 0;
+  while (i < sizeof(bench_stack) && bench_stack[i] == STACK_PAINT) {
+    ++i;
+  }
+  return sizeof(bench_stack) - i;
+}
+
+/*
+ * Instruction counting
+ */
+
+/**
+ * @brief Counts user space instructions of the job by single stepping it
+ *
+ * @return Instructions executed, 0 if ptrace is not available
+ */
+static unsigned long CountInstructions(void) {
+  const pid_t pid = fork();
+  if (pid < 0) {
+    return 0;
+  }
+  if (pid == 0) {
+    ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+    raise(SIGSTOP);
+    RunJob();
+    _exit(0);
+  }
+
+  int status = 0;
+  waitpid(pid, &status, 0);
+  if (!WIFSTOPPED(status)) {
+    return 0;
+  }
+
+  unsigned long count = 0;
+  for (;;) {
+    if (ptrace(PTRACE_SINGLESTEP, pid, NULL, NULL) < 0) {
+      kill(pid, SIGKILL);
+      waitpid(pid, &status, 0);
+      return 0;
+    }
+    waitpid(pid, &status, 0);
+    if (WIFEXITED(status) || WIFSIGNALED(status)) {
+      break;
+    }
+    ++count;
+  }
+
+  return count;
+}
+
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Seconds per encode of the job, averaged over many runs
+ */
+static double TimeJob(void) {
+  size_t runs = 0;
+  const double start = Now();
+  double elapsed = 0;
+  do {
+    RunJob();
+    ++runs;
+    elapsed = Now() - start;
+  } while (elapsed < MIN_TIMING_SECONDS / 10);
+  return elapsed / runs;
+}
+
+/**
+ * @brief Calibrates host instructions per nanosecond for every codec
+ *
+ * @param data Sample input
+ * @param length Number of bytes in @p data
+ */
+static void Calibrate(const uint8_t *data, size_t length) {
+  // instructions of the fork/exit path, subtracted from every count
+  job.codec = NULL;
+  const unsigned long baseline = CountInstructions();
+
+  for (size_t c = 0; c < NUM_CODECS; c++) {
+    job.codec = &codecs[c];
+    job.data = data;
+    job.length = length;
+
+    const unsigned long insn = CountInstructions();
+    const double ns = TimeJob() * 1e9;
+    if (insn > baseline && ns > 0) {
+      codecs[c].insn_per_ns = (insn - baseline) / ns;
+    }
+    fprintf(stderr, "calibrated %-10s %8lu insn for %zu bytes\n",
+            codecs[c].name, insn > baseline ? insn - baseline : 0, length);
+  }
+}
+
+static uint8_t *ReadFile(const char *path, size_t max, size_t *len) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  *len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  if (*len > max) {
+    *len = max;
+  }
+  uint8_t *data = malloc(*len ? *len : 1);
+  if (data && fread(data, 1, *len, f) != *len) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+  return data;
+}
+
+static void Usage(const char *prog) {
+  fprintf(stderr,
+          "usage: %s [-p payload_size] [-m max_file_bytes] [-t thumb_ratio] "
+          "[-c cpi] [-o out.csv] FILE...\n",
+          prog);
+}
+
+int main(int argc, char **argv) {
+  size_t payload_size = PAYLOAD_SIZE;
+  size_t max_bytes = MAX_FILE_BYTES;
+  // Thumb-2 instructions per x86-64 instruction
+  double thumb_ratio = 1.3;
+  // Cortex-M4 cycles per instruction including flash wait states
+  double cpi = 1.4;
+  const char *csv_path = NULL;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "p:m:t:c:o:")) != -1) {
+    switch (opt) {
+      case 'p':
+        payload_size = strtoul(optarg, NULL, 0);
+        break;
+      case 'm':
+        max_bytes = strtoul(optarg, NULL, 0);
+        break;
+      case 't':
+        thumb_ratio = strtod(optarg, NULL);
+        break;
+      case 'c':
+        cpi = strtod(optarg, NULL);
+        break;
+      case 'o':
+        csv_path = optarg;
+        break;
+      default:
+        Usage(argv[0]);
+        return 1;
+    }
+  }
+  if (optind >= argc || payload_size == 0 ||
+      payload_size > CODEC_MAX_PAYLOAD) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  FILE *csv = NULL;
+  if (csv_path != NULL) {
+    csv = fopen(csv_path, "w");
+    if (csv == NULL) {
+      fprintf(stderr, "could not open %s\n", csv_path);
+      return 1;
+    }
+    fprintf(csv,
+            "file,codec,payloads,bytes_in,bytes_out,ratio,enc_MBps,"
+            "stack_bytes,heap_bytes,m4_cycles_per_byte,m4_us_per_payload,"
+            "model_cycles_per_byte\n");
+  }
+
+  printf("%-34s %-10s %5s %7s %7s %6s %9s %6s %5s %9s %8s %11s\n", "file",
+         "codec", "n", "in", "out", "ratio", "enc_MBps", "stack", "heap",
+         "m4_cyc_B", "m4_us", "model_cyc_B");
+
+  int failed = 0;
+  int calibrated = 0;
+
+  // stack used by the context switch itself
+  job.codec = NULL;
+  const size_t stack_baseline = StackUsage();
+
+  for (int arg = optind; arg < argc; arg++) {
+    size_t len = 0;
+    uint8_t *data = ReadFile(argv[arg], max_bytes, &len);
+    if (!data) {
+      fprintf(stderr, "could not read %s\n", argv[arg]);
+      failed = 1;
+      continue;
+    }
+    if (len == 0) {
+      free(data);
+      continue;
+    }
+
+    if (!calibrated) {
+      Calibrate(data, len < CALIBRATION_BYTES ? len : CALIBRATION_BYTES);
+      calibrated = 1;
+    }
+
+    const char *name = strrchr(argv[arg], '/');
+    name = name ? name + 1 : argv[arg];
+
+    for (size_t c = 0; c < NUM_CODECS; c++) {
+      const BenchCodec *codec = &codecs[c];
+      job.codec = codec;
+
+      size_t payloads = 0;
+      size_t bytes_out = 0;
+      size_t stack_peak = 0;
+      size_t heap_max = 0;
+      double model_cycles = 0;
+
+      for (size_t off = 0; off < len; off += payload_size) {
+        job.data = data + off;
+        job.length = (len - off < payload_size) ? len - off : payload_size;
+
+        heap_tracking = 1;
+        heap_current = 0;
+        heap_peak = 0;
+        const size_t stack = StackUsage() - stack_baseline;
+        heap_tracking = 0;
+
+        if (stack > stack_peak) stack_peak = stack;
+        if (heap_peak > heap_max) heap_max = heap_peak;
+
+        // round trip
+        uint8_t decoded[CODEC_MAX_PAYLOAD];
+        size_t decoded_len = 0;
+        if (codec->encode(job.data, job.length, job.buffer, sizeof(job.buffer),
+                          &job.out_len) != COMPRESS_OK ||
+            codec->decode(job.buffer, job.out_len, decoded, sizeof(decoded),
+                          &decoded_len) != COMPRESS_OK ||
+            decoded_len != job.length ||
+            memcmp(decoded, job.data, job.length) != 0) {
+          fprintf(stderr, "%s: round trip failed for %s at offset %zu\n",
+                  codec->name, name, off);
+          failed = 1;
+        }
+
+        bytes_out += job.out_len;
+        if (codec->id >= 0) {
+          model_cycles += CodecCost(codec->id, job.length);
+        }
+        ++payloads;
+      }
+
+      // throughput over the whole file
+      size_t runs = 0;
+      const double start = Now();
+      double elapsed = 0;
+      do {
+        for (size_t off = 0; off < len; off += payload_size) {
+          job.data = data + off;
+          job.length = (len - off < payload_size) ? len - off : payload_size;
+          RunJob();
+        }
+        ++runs;
+        elapsed = Now() - start;
+      } while (elapsed < MIN_TIMING_SECONDS);
+
+      const double sec_per_byte = elapsed / runs / len;
+      const double m4_cyc_per_byte =
+          sec_per_byte * 1e9 * codec->insn_per_ns * thumb_ratio * cpi;
+      const double m4_us =
+          m4_cyc_per_byte * (len < payload_size ? len : payload_size) /
+          CPU_HZ * 1e6;
+      const double ratio = (double)len / bytes_out;
+      const double mbps = 1e-6 / sec_per_byte;
+      const double model = (codec->id >= 0) ? model_cycles / len : 0;
+
+      printf("%-34.34s %-10s %5zu %7zu %7zu %6.3f %9.2f %6zu %5zu %9.1f %8.0f",
+             name, codec->name, payloads, len, bytes_out, ratio, mbps,
+             stack_peak, heap_max, m4_cyc_per_byte, m4_us);
+      if (codec->id >= 0) {
+        printf(" %11.1f\n", model);
+      } else {
+        printf(" %11s\n", "-");
+      }
+
+      if (csv) {
+        fprintf(csv, "%s,%s,%zu,%zu,%zu,%.4f,%.3f,%zu,%zu,%.2f,%.1f,%.2f\n",
+                name, codec->name, payloads, len, bytes_out, ratio, mbps,
+                stack_peak, heap_max, m4_cyc_per_byte, m4_us, model);
+      }
+    }
+
+    free(data);
+  }
+
+  if (csv) {
+    fclose(csv);
+  }
+
+  return failed;
+}
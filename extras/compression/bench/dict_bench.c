@@ -0,0 +1,238 @@
+/**
+ * @file dict_bench.c
+ * @brief Compares the arena trie dictionary against the legacy uthash one
+ *
+ * Each input file is split into LoRaWAN sized messages. For every message the
+ * dictionary is reset and an LZ78 parse is run, looking up and inserting every
+ * phrase. Memory is the peak number of bytes used by the dictionary and
+ * throughput is the number of input bytes parsed per second.
+ *
+ * The legacy dictionary keys phrases on C strings and cannot store zero bytes,
+ * those are replaced with 0x01 before parsing with it. The number of replaced
+ * bytes is reported.
+ *
+ * Build and run from extras/compression:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/compress/include -Ibench \
+ *     bench/dict_bench.c bench/legacy_dict.c \
+ *     ../../stm32/lib/compress/src/dict.c \
+ *     ../../stm32/lib/compress/src/lz78.c -o dict_bench
+ * find messages adc_bin -name '*.bin' | xargs ./dict_bench
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dict.h"
+#include "legacy_dict.h"
+#include "lz78.h"
+
+/** Size of a single message, max LoRaWAN payload */
+#define MESSAGE_SIZE 222
+
+/** Number of times each file is parsed when timing */
+#define ITERATIONS 200
+
+/** Results for a single dictionary implementation */
+typedef struct {
+  /** Peak bytes used by the dictionary */
+  size_t peak_bytes;
+  /** Max number of phrases in a single message */
+  size_t max_entries;
+  /** Seconds spent parsing */
+  double seconds;
+} BenchResult;
+
+static Dict trie;
+
+static double Now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief LZ78 parse of a message with the arena trie
+ *
+ * @return Number of phrases added
+ */
+static size_t ParseTrie(const uint8_t *data, size_t len) {
+  DictInit(&trie);
+
+  uint16_t cur = DICT_ROOT;
+  for (size_t i = 0; i < len; i++) {
+    const int next = DictFind(&trie, cur, data[i]);
+    if (next != DICT_NOT_FOUND) {
+      cur = (uint16_t)next;
+    } else {
+      DictAdd(&trie, cur, data[i]);
+      cur = DICT_ROOT;
+    }
+  }
+
+  return trie.count;
+}
+
+/**
+ * @brief LZ78 parse of a message with the legacy uthash dictionary
+ *
+ * @return Number of phrases added
+ */
+static size_t ParseLegacy(const uint8_t *data, size_t len) {
+  char key[256];
+  size_t key_len = 0;
+  int next_code = 1;
+
+  dict_init();
+
+  for (size_t i = 0; i < len; i++) {
+    key[key_len] = data[i] ? (char)data[i] : 0x01;
+    key[key_len + 1] = '\0';
+
+    if (dict_search(key) != -1 && key_len < sizeof(key) - 2) {
+      ++key_len;
+    } else {
+      dict_add(key, next_code++);
+      key_len = 0;
+    }
+  }
+
+  dict_free();
+
+  return next_code - 1;
+}
+
+/**
+ * @brief Checks the LZ78 codec round trips a message
+ *
+ * @return Compressed size, 0 on failure
+ */
+static size_t RoundTrip(const uint8_t *data, size_t len) {
+  uint8_t compressed[2 * MESSAGE_SIZE];
+  uint8_t decompressed[MESSAGE_SIZE];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  if (LZ78Encode(data, len, compressed, sizeof(compressed), &compressed_len) !=
+      COMPRESS_OK) {
+    return 0;
+  }
+  if (LZ78Decode(compressed, compressed_len, decompressed,
+                 sizeof(decompressed), &decompressed_len) != COMPRESS_OK) {
+    return 0;
+  }
+  if (decompressed_len != len || memcmp(data, decompressed, len) != 0) {
+    return 0;
+  }
+
+  return compressed_len;
+}
+
+static uint8_t *ReadFile(const char *path, size_t *len) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  *len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  uint8_t *data = malloc(*len);
+  if (data && fread(data, 1, *len, f) != *len) {
+    free(data);
+    data = NULL;
+  }
+  fclose(f);
+  return data;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s FILE...\n", argv[0]);
+    return 1;
+  }
+
+  printf("%-40s %8s %6s | %10s %8s %9s | %10s %8s %9s | %7s\n", "file",
+         "bytes", "zeros", "trie_bytes", "entries", "trie_MB/s", "uthash_B",
+         "entries", "uthsh_MB/s", "lz78");
+
+  int failed = 0;
+
+  for (int arg = 1; arg < argc; arg++) {
+    size_t len = 0;
+    uint8_t *data = ReadFile(argv[arg], &len);
+    if (!data) {
+      fprintf(stderr, "could not read %s\n", argv[arg]);
+      failed = 1;
+      continue;
+    }
+
+    size_t zeros = 0;
+    for (size_t i = 0; i < len; i++) {
+      zeros += data[i] == 0;
+    }
+
+    BenchResult trie_res = {sizeof(Dict), 0, 0.0};
+    BenchResult legacy_res = {0, 0, 0.0};
+    size_t compressed_total = 0;
+
+    // memory, entries and correctness
+    dict_heap_peak = 0;
+    for (size_t off = 0; off < len; off += MESSAGE_SIZE) {
+      const size_t n = (len - off < MESSAGE_SIZE) ? len - off : MESSAGE_SIZE;
+
+      size_t entries = ParseTrie(data + off, n);
+      if (entries > trie_res.max_entries) trie_res.max_entries = entries;
+
+      entries = ParseLegacy(data + off, n);
+      if (entries > legacy_res.max_entries) legacy_res.max_entries = entries;
+
+      const size_t compressed_len = RoundTrip(data + off, n);
+      if (compressed_len == 0) {
+        fprintf(stderr, "round trip failed for %s at offset %zu\n", argv[arg],
+                off);
+        failed = 1;
+      }
+      compressed_total += compressed_len;
+    }
+    legacy_res.peak_bytes = dict_heap_peak;
+
+    // throughput
+    double start = Now();
+    for (int it = 0; it < ITERATIONS; it++) {
+      for (size_t off = 0; off < len; off += MESSAGE_SIZE) {
+        const size_t n = (len - off < MESSAGE_SIZE) ? len - off : MESSAGE_SIZE;
+        ParseTrie(data + off, n);
+      }
+    }
+    trie_res.seconds = Now() - start;
+
+    start = Now();
+    for (int it = 0; it < ITERATIONS; it++) {
+      for (size_t off = 0; off < len; off += MESSAGE_SIZE) {
+        const size_t n = (len - off < MESSAGE_SIZE) ? len - off : MESSAGE_SIZE;
+        ParseLegacy(data + off, n);
+      }
+    }
+    legacy_res.seconds = Now() - start;
+
+    const double mb = (double)len * ITERATIONS / 1e6;
+    const char *name = strrchr(argv[arg], '/');
+    name = name ? name + 1 : argv[arg];
+
+    printf("%-40s %8zu %6zu | %10zu %8zu %9.1f | %10zu %8zu %9.1f | %7.3f\n",
+           name, len, zeros, trie_res.peak_bytes, trie_res.max_entries,
+           mb / trie_res.seconds, legacy_res.peak_bytes,
+           legacy_res.max_entries, mb / legacy_res.seconds,
+           (double)compressed_total / len);
+
+    free(data);
+  }
+
+  return failed;
+}
@@ -0,0 +1,60 @@
+#include <stddef.h>
+#include <stdlib.h>
+
+size_t dict_heap_bytes = 0;
+size_t dict_heap_peak = 0;
+
+static void *counted_malloc(size_t sz) {
+  dict_heap_bytes += sz;
+  if (dict_heap_bytes > dict_heap_peak) {
+    dict_heap_peak = dict_heap_bytes;
+  }
+  return malloc(sz);
+}
+
+static void counted_free(void *ptr, size_t sz) {
+  dict_heap_bytes -= sz;
+  free(ptr);
+}
+
+// account for the allocations made inside uthash
+#define uthash_malloc(sz) counted_malloc(sz)
+#define uthash_free(ptr, sz) counted_free(ptr, sz)
+
+#include "legacy_dict.h"
+
+#include <stdio.h>
+
+// Global dictionary variable
+static DictEntry *dictionary = NULL;
+
+// Initialize the dictionary (optional, uthash initializes on first use)
+void dict_init() { dictionary = NULL; }
+
+// Add an entry to the dictionary
+void dict_add(const char *key, int value) {
+  DictEntry *entry = counted_malloc(sizeof(DictEntry));
+  if (!entry) {
+    fprintf(stderr, "Memory allocation failed\n");
+    return;
+  }
+  strcpy(entry->key, key);
+  entry->value = value;
+  HASH_ADD_STR(dictionary, key, entry);
+}
+
+// Search for an entry in the dictionary by key
+int dict_search(const char *key) {
+  DictEntry *entry;
+  HASH_FIND_STR(dictionary, key, entry);
+  return entry ? entry->value : -1;  // Return -1 if not found
+}
+
+// Free all dictionary entries
+void dict_free() {
+  DictEntry *entry, *tmp;
+  HASH_ITER(hh, dictionary, entry, tmp) {
+    HASH_DEL(dictionary, entry);
+    counted_free(entry, sizeof(DictEntry));
+  }
+}
@@ -0,0 +1,275 @@
+/**
+ * @file power_delta_test.c
+ * @brief Checks the power delta encoder against captured ADC traces
+ *
+ * The adc_bin traces are a sequence of serialized messages each holding a
+ * single varint ADC code. Consecutive codes are paired as the voltage and
+ * current of a burst sample, the same order the ADS1219 is read in burst mode,
+ * and timestamped at the given sample period with a millisecond of jitter on
+ * every third sample.
+ *
+ * Samples are pushed to a PowerDeltaRing. Whenever the ring fills, and at the
+ * end of the trace, it is drained into RepeatedPowerDeltas records of
+ * POWER_DELTA_RECORD_SIZE bytes. Every record is decoded with nanopb,
+ * unpacked and expanded back to samples that must match the input. The size of
+ * the ring and of the records is reported per sample against the 12 bytes of a
+ * raw sample.
+ *
+ * Build and run from extras/compression:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/ads/include -I../../proto/c/include \
+ *     bench/power_delta_test.c ../../stm32/lib/ads/src/power_delta.c \
+ *     ../../proto/c/src/{pb_common,pb_decode,pb_encode}.c \
+ *     ../../proto/c/src/{soil_power_sensor,sensor}.pb.c -o power_delta_test
+ * find adc_bin -name '*.bin' | xargs ./power_delta_test
+ * @endcode
+ *
+ * Pass -p to change the sample period in ms (default 22, 90 SPS per channel)
+ * and -s to change the record size. Returns non-zero if any sample does not
+ * round trip or the records of a trace are not smaller than raw samples.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pb_decode.h"
+#include "power_delta.h"
+
+/** Max number of entries in a single record */
+#define MAX_ENTRIES 256
+
+/** Size of a raw sample, timestamp and two 32-bit codes */
+#define RAW_SAMPLE_SIZE 12
+
+/** Ring under test */
+static PowerDeltaRing ring;
+
+/** Running totals for a trace */
+typedef struct {
+  /** Samples in the trace */
+  size_t samples;
+  /** Samples that did not round trip */
+  size_t mismatches;
+  /** Bytes used in the ring summed at every flush */
+  size_t ring_bytes;
+  /** Samples in the ring summed at every flush */
+  size_t ring_samples;
+  /** Records written */
+  size_t records;
+  /** Bytes in records */
+  size_t record_bytes;
+} TraceResult;
+
+/**
+ * @brief Read ADC codes from a trace of serialized adcValue messages
+ *
+ * @return Array of codes, NULL on error
+ */
+static int32_t *ReadTrace(const char *path, size_t *count) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    return NULL;
+  }
+  fseek(f, 0, SEEK_END);
+  const size_t len = ftell(f);
+  fseek(f, 0, SEEK_SET);
+
+  uint8_t *data = malloc(len);
+  int32_t *codes = malloc(len * sizeof(int32_t));
+  if (!data || !codes || fread(data, 1, len, f) != len) {
+    fclose(f);
+    free(data);
+    free(codes);
+    return NULL;
+  }
+  fclose(f);
+
+  pb_istream_t stream = pb_istream_from_buffer(data, len);
+  *count = 0;
+  while (stream.bytes_left > 0) {
+    uint32_t tag = 0;
+    pb_wire_type_t wire_type;
+    bool eof = false;
+    uint64_t value = 0;
+    if (!pb_decode_tag(&stream, &wire_type, &tag, &eof) || tag != 1 ||
+        wire_type != PB_WT_VARINT || !pb_decode_varint(&stream, &value)) {
+      free(data);
+      free(codes);
+      return NULL;
+    }
+    codes[(*count)++] = (int32_t)(uint32_t)value;
+  }
+
+  free(data);
+  return codes;
+}
+
+/**
+ * @brief Drain the ring into records, checking each against the input
+ *
+ * @param expected Input samples, advanced past the drained samples
+ */
+static bool Flush(const PowerSample **expected, size_t record_size,
+                  TraceResult *res) {
+  static PowerDeltaEntry entries[MAX_ENTRIES];
+  static PowerSample expanded[MAX_ENTRIES];
+  uint8_t record[256];
+
+  res->ring_bytes += ring.used;
+  res->ring_samples += ring.count;
+
+  while (ring.count > 0) {
+    size_t len = 0;
+    if (PowerDeltaRecord(&ring, 1, 2, record, record_size, &len) !=
+        POWER_DELTA_OK) {
+      return false;
+    }
+    res->records++;
+    res->record_bytes += len;
+
+    RepeatedPowerDeltas deltas = RepeatedPowerDeltas_init_zero;
+    pb_istream_t stream = pb_istream_from_buffer(record, len);
+    if (!pb_decode(&stream, RepeatedPowerDeltas_fields, &deltas) ||
+        deltas.logger_id != 1 || deltas.cell_id != 2) {
+      return false;
+    }
+
+    size_t count = 0;
+    if (PowerDeltaUnpack(deltas.packed_entries.bytes,
+                         deltas.packed_entries.size, entries, MAX_ENTRIES,
+                         &count) != POWER_DELTA_OK) {
+      return false;
+    }
+
+    PowerDeltaExpand(entries, count, expanded);
+
+    // the first entry only stores seconds
+    const PowerSample *first = *expected;
+    for (size_t i = 0; i < count; i++) {
+      const PowerSample *in = &(*expected)[i];
+      const uint32_t in_ms =
+          (in->seconds - first->seconds) * 1000 + in->ms - first->ms;
+      const uint32_t out_ms =
+          (expanded[i].seconds - expanded[0].seconds) * 1000 + expanded[i].ms;
+      if (in_ms != out_ms || in->voltage != expanded[i].voltage ||
+          in->current != expanded[i].current ||
+          expanded[0].seconds != first->seconds) {
+        res->mismatches++;
+      }
+    }
+    *expected += count;
+  }
+
+  return true;
+}
+
+static bool RunTrace(const int32_t *codes, size_t count, uint32_t period,
+                     size_t record_size, TraceResult *res) {
+  const size_t n = count / 2;
+  PowerSample *samples = malloc(n * sizeof(PowerSample));
+  if (!samples) {
+    return false;
+  }
+
+  uint64_t ms = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint64_t t = ms + (i % 3 == 2);
+    samples[i].seconds = 1700000000 + (uint32_t)(t / 1000);
+    samples[i].ms = (uint16_t)(t % 1000);
+    samples[i].voltage = codes[2 * i];
+    samples[i].current = codes[2 * i + 1];
+    ms += period;
+  }
+
+  memset(res, 0, sizeof(*res));
+  res->samples = n;
+
+  PowerDeltaRingInit(&ring);
+  const PowerSample *expected = samples;
+  bool ok = true;
+
+  for (size_t i = 0; i < n && ok; i++) {
+    if (PowerDeltaRingPush(&ring, &samples[i]) == POWER_DELTA_FULL) {
+      ok = Flush(&expected, record_size, res) &&
+           PowerDeltaRingPush(&ring, &samples[i]) == POWER_DELTA_OK;
+    }
+  }
+  if (ok) {
+    ok = Flush(&expected, record_size, res);
+  }
+
+  free(samples);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  uint32_t period = 22;
+  size_t record_size = POWER_DELTA_RECORD_SIZE;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "p:s:")) != -1) {
+    switch (opt) {
+      case 'p':
+        period = (uint32_t)atoi(optarg);
+        break;
+      case 's':
+        record_size = (size_t)atoi(optarg);
+        break;
+      default:
+        fprintf(stderr, "usage: %s [-p period_ms] [-s record_size] FILE...\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (optind >= argc || record_size == 0 || record_size > 256) {
+    fprintf(stderr, "usage: %s [-p period_ms] [-s record_size] FILE...\n",
+            argv[0]);
+    return 1;
+  }
+
+  printf("%-40s %8s %8s %8s %8s %8s %6s\n", "file", "samples", "ring_B/s",
+         "records", "rec_B/s", "ratio", "errors");
+
+  int failed = 0;
+
+  for (int arg = optind; arg < argc; arg++) {
+    size_t count = 0;
+    int32_t *codes = ReadTrace(argv[arg], &count);
+    if (!codes) {
+      fprintf(stderr, "could not read %s\n", argv[arg]);
+      failed = 1;
+      continue;
+    }
+
+    TraceResult res;
+    if (!RunTrace(codes, count, period, record_size, &res)) {
+      fprintf(stderr, "encoding failed for %s\n", argv[arg]);
+      failed = 1;
+    }
+    if (res.mismatches > 0 ||
+        res.record_bytes >= res.samples * RAW_SAMPLE_SIZE) {
+      failed = 1;
+    }
+
+    const char *name = strrchr(argv[arg], '/');
+    name = name ? name + 1 : argv[arg];
+
+    const double ring_per_sample =
+        res.ring_samples ? (double)res.ring_bytes / res.ring_samples : 0.0;
+    const double rec_per_sample =
+        res.samples ? (double)res.record_bytes / res.samples : 0.0;
+
+    printf("%-40s %8zu %8.2f %8zu %8.2f %8.3f %6zu\n", name, res.samples,
+           ring_per_sample, res.records, rec_per_sample,
+           rec_per_sample / RAW_SAMPLE_SIZE, res.mismatches);
+
+    free(codes);
+  }
+
+  return failed;
+}
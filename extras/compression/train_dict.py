@@ -0,0 +1,220 @@
+"""Trains a static dictionary for the LZ77 codec
+
+Individual uplinks are too short for adaptive LZ to find repeats, but the
+field tags, sensor types and ids are shared across payloads. The dictionary
+primes the LZ77 window with the most common substrings so they can be
+referenced from the first byte of a payload.
+
+Training is a simplified version of the zstd COVER algorithm. Every d-mer is
+scored by the number of payloads it appears in. Segments are greedily picked
+by the sum of scores of the d-mers they contain, and d-mers are zeroed once
+covered so the dictionary does not repeat itself. The best segments are placed
+at the end of the dictionary, closest to the data.
+
+Held-out performance is estimated with leave-one-file-out cross validation,
+the dictionary is trained on every other file and the ratio on the remaining
+file is compared to compressing without a dictionary.
+
+Usage from extras/compression with the ents package installed:
+
+    python train_dict.py messages/*.bin \\
+        --c-out ../../stm32/lib/compress/src/lz77_dict.c \\
+        --py-out ../../python/src/ents/compress/dictionary.py
+"""
+
+import argparse
+from collections import defaultdict
+from pathlib import Path
+
+from ents.compress.lz77 import MAX_DICT_SIZE, compress_lz77, decompress_lz77
+
+# max LoRaWAN payload at the highest data rate
+PAYLOAD_SIZE = 222
+
+
+def split_payloads(data: bytes, size: int) -> list[bytes]:
+    """Splits a capture into payload sized chunks."""
+
+    return [data[i : i + size] for i in range(0, len(data), size)]
+
+
+def train(samples: list[bytes], dict_size: int, dmer: int, segment: int) -> bytes:
+    """Trains a dictionary from a set of payloads.
+
+    Args:
+        samples: Training payloads.
+        dict_size: Max size of the dictionary in bytes.
+        dmer: Length of substrings scored.
+        segment: Length of segments added to the dictionary.
+
+    Returns:
+        Trained dictionary, may be shorter than dict_size if the samples run
+        out of useful segments.
+    """
+
+    # document frequency of every d-mer
+    freq = defaultdict(int)
+    for s in samples:
+        for d in {s[i : i + dmer] for i in range(len(s) - dmer + 1)}:
+            freq[d] += 1
+
+    segments = []
+    size = 0
+    while size < dict_size:
+        best_score = 0
+        best_seg = b""
+        for s in samples:
+            for i in range(max(len(s) - segment, 0) + 1):
+                seg = s[i : i + segment]
+                dmers = {seg[j : j + dmer] for j in range(len(seg) - dmer + 1)}
+                # d-mers seen in a single payload are not worth storing
+                score = sum(freq[d] for d in dmers if freq[d] > 1)
+                if score > best_score:
+                    best_score = score
+                    best_seg = seg
+
+        if best_score == 0:
+            break
+
+        best_seg = best_seg[: dict_size - size]
+        for j in range(len(best_seg) - dmer + 1):
+            freq[best_seg[j : j + dmer]] = 0
+
+        segments.append(best_seg)
+        size += len(best_seg)
+
+    # most valuable segments last so they are closest to the data
+    return b"".join(reversed(segments))
+
+
+def compressed_size(samples: list[bytes], dictionary: bytes) -> int:
+    """Total compressed size of samples, verifying each round trip."""
+
+    dict_id = 1 if dictionary else 0
+    total = 0
+    for s in samples:
+        c = compress_lz77(s, dictionary, dict_id)
+        assert decompress_lz77(c, {dict_id: dictionary}) == s, "round trip failed"
+        total += len(c)
+    return total
+
+
+def write_c(path: Path, dictionary: bytes, dict_id: int):
+    """Writes the dictionary as a C source file."""
+
+    lines = []
+    for i in range(0, len(dictionary), 12):
+        chunk = dictionary[i : i + 12]
+        lines.append("    " + ", ".join(f"0x{b:02x}" for b in chunk) + ",")
+
+    path.write_text(
+        "/**\n"
+        " * @file lz77_dict.c\n"
+        " * @brief Static dictionary used to prime LZ77\n"
+        " *\n"
+        " * Generated by extras/compression/train_dict.py, do not edit. The same\n"
+        " * dictionary is in python/src/ents/compress/dictionary.py.\n"
+        " */\n"
+        "\n"
+        '#include "lz77.h"\n'
+        "\n"
+        f"static const uint8_t lz77_dict_data[{len(dictionary)}] = {{\n"
+        + "\n".join(lines)
+        + "\n};\n"
+        "\n"
+        "const LZ77Dict lz77_dict = {\n"
+        f"    .id = {dict_id},\n"
+        "    .data = lz77_dict_data,\n"
+        "    .len = sizeof(lz77_dict_data),\n"
+        "};\n"
+    )
+
+
+def write_py(path: Path, dictionary: bytes, dict_id: int):
+    """Writes the dictionary as a Python module."""
+
+    hex_str = dictionary.hex()
+    lines = [hex_str[i : i + 64] for i in range(0, len(hex_str), 64)]
+
+    path.write_text(
+        '"""Static dictionaries for LZ77\n'
+        "\n"
+        "Generated by extras/compression/train_dict.py, do not edit. The same\n"
+        "dictionary is in stm32/lib/compress/src/lz77_dict.c.\n"
+        '"""\n'
+        "\n"
+        f"DICT_ID = {dict_id}\n"
+        "\n"
+        "DICT = bytes.fromhex(\n"
+        + "\n".join(f'    "{line}"' for line in lines)
+        + "\n)\n"
+        "\n"
+        "DICTIONARIES = {\n"
+        "    DICT_ID: DICT,\n"
+        "}\n"
+    )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("files", nargs="+", type=Path, help="Captured payloads")
+    parser.add_argument("--size", type=int, default=MAX_DICT_SIZE)
+    parser.add_argument("--dmer", type=int, default=4)
+    parser.add_argument("--segment", type=int, default=16)
+    parser.add_argument("--payload-size", type=int, default=PAYLOAD_SIZE)
+    parser.add_argument("--id", type=int, default=1, help="Dictionary version")
+    parser.add_argument("--c-out", type=Path, help="Path to write C source")
+    parser.add_argument("--py-out", type=Path, help="Path to write Python module")
+    args = parser.parse_args()
+
+    if not 1 <= args.id <= 0xFF:
+        parser.error("id must be between 1 and 255")
+    if args.size > MAX_DICT_SIZE:
+        parser.error(f"size must be at most {MAX_DICT_SIZE}")
+
+    files = {
+        f.name: split_payloads(f.read_bytes(), args.payload_size) for f in args.files
+    }
+
+    print(
+        f"{'held out':<32} {'bytes':>7} {'no dict':>8} {'dict':>8} "
+        f"{'ratio':>6} {'ratio dict':>10}"
+    )
+
+    totals = [0, 0, 0]
+    for name, samples in files.items():
+        training = [s for n, f in files.items() if n != name for s in f]
+        dictionary = train(training, args.size, args.dmer, args.segment)
+
+        raw = sum(len(s) for s in samples)
+        no_dict = compressed_size(samples, b"")
+        with_dict = compressed_size(samples, dictionary)
+
+        totals[0] += raw
+        totals[1] += no_dict
+        totals[2] += with_dict
+
+        print(
+            f"{name:<32} {raw:>7} {no_dict:>8} {with_dict:>8} "
+            f"{raw / no_dict:>6.3f} {raw / with_dict:>10.3f}"
+        )
+
+    print(
+        f"{'total':<32} {totals[0]:>7} {totals[1]:>8} {totals[2]:>8} "
+        f"{totals[0] / totals[1]:>6.3f} {totals[0] / totals[2]:>10.3f}"
+    )
+
+    samples = [s for f in files.values() for s in f]
+    dictionary = train(samples, args.size, args.dmer, args.segment)
+    print(f"\nTrained dictionary {args.id} on all files: {len(dictionary)} bytes")
+
+    if args.c_out:
+        write_c(args.c_out, dictionary, args.id)
+        print(f"Wrote {args.c_out}")
+    if args.py_out:
+        write_py(args.py_out, dictionary, args.id)
+        print(f"Wrote {args.py_out}")
+
+
+if __name__ == "__main__":
+    main()
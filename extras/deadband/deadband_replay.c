@@ -0,0 +1,432 @@
+/**
+ * @file deadband_replay.c
+ * @brief Replays measurements through the deadband and reports FIFO and
+ * airtime savings
+ *
+ * Measurements come from a csv with a header, a time column in seconds and
+ * one column per sensor, or from synthetic flat channels with -S. They are
+ * stored twice, once raw and once filtered by the deadband from
+ * stm32/lib/sensors. Every upload interval the stored measurements are packed
+ * into RepeatedSensorMeasurements the same way as FormatPayload, and each
+ * uplink is charged the LoRa time on air of its LoRaWAN frame.
+ *
+ * The backend holds the last uploaded value until the next one. The max error
+ * column compares that held value against every replayed sample, which stays
+ * within the deadband of each channel.
+ *
+ * Build and run from extras/deadband:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include -I../../proto/c/include \
+ *     deadband_replay.c ../../stm32/lib/sensors/src/deadband.c \
+ *     ../../proto/c/src/sensor.c ../../proto/c/src/sensor.pb.c \
+ *     ../../proto/c/src/pb_*.c -lm -o deadband_replay
+ * ./deadband_replay -S 24
+ * @endcode
+ *
+ * Pass -l absolute[:relative[:heartbeat]] once per column to set the limits,
+ * the last one is used for the remaining columns. -u sets the upload interval
+ * in seconds (default 900), -f the spreading factor (default 10), -p the
+ * sample period of synthetic channels in seconds (default 60) and -s replays
+ * every nth csv row.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "deadband.h"
+#include "sensor.h"
+
+/** Max payload size of the stm32 */
+#define LORAWAN_APP_DATA_BUFFER_MAX_SIZE 242
+
+/** MHDR, FHDR, FPort and MIC of a LoRaWAN uplink */
+#define LORAWAN_OVERHEAD 13
+
+/** Max number of measurements in a RepeatedSensorMeasurements */
+#define MAX_PER_UPLINK 16
+
+/** Max number of channels */
+#define MAX_COLUMNS 8
+
+/** Max number of measurements waiting in the FIFO */
+#define MAX_FIFO 4096
+
+/** Timestamp of the first sample */
+#define START_TS 1700000000
+
+/** Upload accounting of one replay */
+typedef struct {
+  /** Measurements stored */
+  uint64_t records;
+  /** Bytes stored in the FIFO, including the length byte */
+  uint64_t fifo_bytes;
+  /** Most bytes waiting in the FIFO at once */
+  uint64_t fifo_peak;
+  /** Bytes waiting in the FIFO */
+  uint64_t fifo_used;
+  /** Number of uplinks */
+  uint64_t uplinks;
+  /** Bytes of all LoRaWAN frames */
+  uint64_t uplink_bytes;
+  /** Time on air of all uplinks in s */
+  double airtime;
+  /** Measurements waiting in the FIFO */
+  SensorMeasurement fifo[MAX_FIFO];
+  /** Length of @ref fifo */
+  size_t fifo_len;
+} Upload;
+
+/** Replayed channel */
+typedef struct {
+  /** Type of the measurements */
+  SensorType type;
+  /** Deadband of the channel */
+  DeadbandLimits limits;
+  /** Value held by the backend */
+  double held;
+  /** Largest difference between a sample and the held value */
+  double max_err;
+  /** Number of stored samples */
+  uint64_t stored;
+} Channel;
+
+/** Spreading factor */
+static int sf = 10;
+
+/**
+ * @brief LoRa time on air in s at 125 kHz, CR 4/5, 8 symbol preamble,
+ * explicit header and CRC
+ */
+static double TimeOnAir(size_t len) {
+  const double tsym = (double)(1 << sf) / 125000.0;
+  const int de = sf >= 11 ? 1 : 0;
+  const double num = 8.0 * len - 4.0 * sf + 28 + 16;
+  double n = ceil(num / (4.0 * (sf - 2 * de))) * 5;
+  if (n < 0) {
+    n = 0;
+  }
+  return (8 + 4.25) * tsym + (8 + n) * tsym;
+}
+
+/**
+ * @brief Send one uplink of measurements from the front of the FIFO
+ */
+static void SendOne(Upload *up, size_t count) {
+  Metadata meta = Metadata_init_default;
+  uint8_t buffer[RepeatedSensorMeasurements_size];
+  size_t length = 0;
+  if (EncodeRepeatedSensorMeasurements(meta, up->fifo, count, buffer,
+                                       sizeof(buffer), &length) != SENSOR_OK) {
+    fprintf(stderr, "could not encode uplink\n");
+    exit(1);
+  }
+
+  up->uplinks++;
+  up->uplink_bytes += length + LORAWAN_OVERHEAD;
+  up->airtime += TimeOnAir(length + LORAWAN_OVERHEAD);
+
+  up->fifo_len -= count;
+  memmove(up->fifo, up->fifo + count, up->fifo_len * sizeof(up->fifo[0]));
+}
+
+/**
+ * @brief Upload everything in the FIFO
+ */
+static void Flush(Upload *up) {
+  while (up->fifo_len > 0) {
+    // largest prefix that fits the payload
+    size_t count = 1;
+    while (count < up->fifo_len && count < MAX_PER_UPLINK) {
+      Metadata meta = Metadata_init_default;
+      size_t size = 0;
+      RepeatedSensorMeasurementsSize(meta, up->fifo, count + 1, &size);
+      if (size > LORAWAN_APP_DATA_BUFFER_MAX_SIZE) {
+        break;
+      }
+      ++count;
+    }
+    SendOne(up, count);
+  }
+  up->fifo_used = 0;
+}
+
+static void Store(Upload *up, const SensorMeasurement *meas) {
+  uint8_t buffer[SensorMeasurement_size];
+  size_t length = sizeof(buffer);
+  if (EncodeSensorMeasurement(meas, buffer, &length) != SENSOR_OK) {
+    fprintf(stderr, "could not encode measurement\n");
+    exit(1);
+  }
+
+  if (up->fifo_len == MAX_FIFO) {
+    Flush(up);
+  }
+  up->fifo[up->fifo_len++] = *meas;
+
+  up->records++;
+  up->fifo_bytes += length + 1;
+  up->fifo_used += length + 1;
+  if (up->fifo_used > up->fifo_peak) {
+    up->fifo_peak = up->fifo_used;
+  }
+}
+
+/** Pseudo random noise in [-1, 1] */
+static double Noise(void) {
+  static uint32_t state = 12345;
+  state = state * 1103515245u + 12345u;
+  return ((state >> 8) & 0xffff) / 32767.5 - 1.0;
+}
+
+/**
+ * @brief Synthetic sample of a flat channel
+ *
+ * - soil temperature: daily swing of 3 C at 0.1 C resolution
+ * - water level: flat at 1.2 m with sensor noise of 1 mm and a 10 cm rise
+ *   between 30 and 36 h
+ * - leaf wetness: dry during the day and dew between 3 and 8 h in whole %
+ */
+static double Synthetic(size_t col, double t) {
+  const double hour = fmod(t / 3600.0, 24.0);
+  switch (col) {
+    case 0:
+      return round((20.0 + 3.0 * sin(2 * M_PI * (hour - 9) / 24)) * 10) / 10;
+    case 1: {
+      double level = 1.2 + 0.001 * Noise();
+      if (t >= 30 * 3600.0 && t < 36 * 3600.0) {
+        level += 0.1;
+      }
+      return round(level * 1000) / 1000;
+    }
+    default:
+      if (hour >= 3 && hour < 8) {
+        return round(60 * sin(M_PI * (hour - 3) / 5));
+      }
+      return 0;
+  }
+}
+
+/**
+ * @brief Store a sample raw and through the deadband
+ */
+static void Replay(Deadband *db, Channel *ch, size_t col, double t, double x,
+                   Upload *raw, Upload *filtered) {
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.has_meta = true;
+  meas.meta.cell_id = 1;
+  meas.meta.logger_id = 1;
+  meas.meta.ts = START_TS + (uint32_t)t;
+  meas.type = ch->type;
+  meas.which_value = SensorMeasurement_decimal_tag;
+  meas.value.decimal = x;
+
+  Store(raw, &meas);
+
+  int entry = -1;
+  if (DeadbandCheck(db, col, &ch->limits, &meas, &entry)) {
+    Store(filtered, &meas);
+    DeadbandUpdate(db, entry, col, &meas);
+    ch->held = x;
+    ch->stored++;
+  }
+
+  if (fabs(x - ch->held) > ch->max_err) {
+    ch->max_err = fabs(x - ch->held);
+  }
+}
+
+static void PrintRow(const char *name, const Upload *up) {
+  printf("%-9s %9llu %10llu %9llu %9llu %11llu %11.1f\n", name,
+         (unsigned long long)up->records,
+         (unsigned long long)up->fifo_bytes,
+         (unsigned long long)up->fifo_peak, (unsigned long long)up->uplinks,
+         (unsigned long long)up->uplink_bytes, up->airtime);
+}
+
+static double Reduction(double raw, double filtered) {
+  return raw > 0 ? 100.0 * (1.0 - filtered / raw) : 0.0;
+}
+
+static void Usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [-l abs[:rel[:heartbeat]]]... [-u upload_s] [-f sf] "
+          "[-s step] (file.csv | -S hours [-p period_s])\n",
+          name);
+}
+
+int main(int argc, char **argv) {
+  DeadbandLimits limits[MAX_COLUMNS];
+  size_t limits_len = 0;
+  uint32_t upload = 900;
+  double synthetic_hours = 0;
+  uint32_t period = 60;
+  unsigned long step = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "l:u:f:S:p:s:")) != -1) {
+    switch (opt) {
+      case 'l': {
+        if (limits_len == MAX_COLUMNS) {
+          Usage(argv[0]);
+          return 1;
+        }
+        DeadbandLimits *l = &limits[limits_len++];
+        char *end = NULL;
+        l->absolute = strtof(optarg, &end);
+        l->relative = *end == ':' ? strtof(end + 1, &end) : 0;
+        l->heartbeat = *end == ':' ? strtoul(end + 1, &end, 10) : 0;
+        break;
+      }
+      case 'u':
+        upload = strtoul(optarg, NULL, 10);
+        break;
+      case 'f':
+        sf = atoi(optarg);
+        break;
+      case 'S':
+        synthetic_hours = atof(optarg);
+        break;
+      case 'p':
+        period = strtoul(optarg, NULL, 10);
+        break;
+      case 's':
+        step = strtoul(optarg, NULL, 10);
+        break;
+      default:
+        Usage(argv[0]);
+        return 1;
+    }
+  }
+
+  const bool synthetic = synthetic_hours > 0;
+  if ((synthetic ? optind != argc : optind + 1 != argc) || upload == 0 ||
+      sf < 7 || sf > 12 || period == 0 || step == 0) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  static Deadband db;
+  static Upload raw;
+  static Upload filtered;
+  static Channel channels[MAX_COLUMNS];
+  DeadbandInit(&db);
+
+  // synthetic channels default to their resolution with an hourly heartbeat
+  const SensorType synthetic_types[] = {SensorType_TEROS12_TEMP,
+                                        SensorType_ALSMPM2F_WATER_LEVEL,
+                                        SensorType_PHYTOS31_LEAF_WETNESS};
+  const DeadbandLimits synthetic_limits[] = {
+      {0.2f, 0, 3600}, {0.005f, 0, 3600}, {0, 0, 3600}};
+
+  for (size_t i = 0; i < MAX_COLUMNS; i++) {
+    if (synthetic && i < 3) {
+      channels[i].type = synthetic_types[i];
+      channels[i].limits = synthetic_limits[i];
+    } else {
+      channels[i].type = (SensorType)(i + 1);
+    }
+    if (limits_len > 0) {
+      channels[i].limits = limits[i < limits_len ? i : limits_len - 1];
+    }
+  }
+
+  size_t columns = 0;
+  double duration = 0;
+  double next_upload = upload;
+
+  if (synthetic) {
+    columns = 3;
+    duration = synthetic_hours * 3600;
+    for (double t = 0; t < duration; t += period) {
+      if (t >= next_upload) {
+        Flush(&raw);
+        Flush(&filtered);
+        next_upload += upload;
+      }
+      for (size_t col = 0; col < columns; col++) {
+        Replay(&db, &channels[col], col, t, Synthetic(col, t), &raw,
+               &filtered);
+      }
+    }
+  } else {
+    FILE *file = fopen(argv[optind], "r");
+    if (file == NULL) {
+      perror(argv[optind]);
+      return 1;
+    }
+
+    char line[512];
+    // skip header
+    if (fgets(line, sizeof(line), file) == NULL) {
+      fprintf(stderr, "empty file\n");
+      return 1;
+    }
+
+    unsigned long row = 0;
+    double first = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+      if (row++ % step != 0) {
+        continue;
+      }
+
+      char *end = line;
+      double t = strtod(end, &end);
+      if (row == 1) {
+        first = t;
+      }
+      t -= first;
+      duration = t;
+
+      if (t >= next_upload) {
+        Flush(&raw);
+        Flush(&filtered);
+        next_upload += upload;
+      }
+
+      size_t col = 0;
+      while (*end == ',' && col < MAX_COLUMNS) {
+        const double x = strtod(end + 1, &end);
+        Replay(&db, &channels[col], col, t, x, &raw, &filtered);
+        ++col;
+      }
+      if (col > columns) {
+        columns = col;
+      }
+    }
+    fclose(file);
+  }
+
+  Flush(&raw);
+  Flush(&filtered);
+
+  printf("%zu channels, %.1f h, upload every %u s, SF%d\n\n", columns,
+         duration / 3600, upload, sf);
+  printf("%-9s %9s %10s %9s %9s %11s %11s\n", "", "records", "fifo_B",
+         "fifo_peak", "uplinks", "uplink_B", "airtime_s");
+  PrintRow("raw", &raw);
+  PrintRow("deadband", &filtered);
+  printf("%-9s %8.1f%% %9.1f%% %8.1f%% %8.1f%% %10.1f%% %10.1f%%\n\n",
+         "saved", Reduction(raw.records, filtered.records),
+         Reduction(raw.fifo_bytes, filtered.fifo_bytes),
+         Reduction(raw.fifo_peak, filtered.fifo_peak),
+         Reduction(raw.uplinks, filtered.uplinks),
+         Reduction(raw.uplink_bytes, filtered.uplink_bytes),
+         Reduction(raw.airtime, filtered.airtime));
+
+  printf("%-8s %4s %10s %10s %10s %10s %10s\n", "channel", "type", "absolute",
+         "relative", "heartbeat", "stored", "max_err");
+  for (size_t i = 0; i < columns; i++) {
+    const Channel *ch = &channels[i];
+    printf("%-8zu %4d %10g %10g %10u %10llu %10g\n", i, ch->type,
+           ch->limits.absolute, ch->limits.relative, ch->limits.heartbeat,
+           (unsigned long long)ch->stored, ch->max_err);
+  }
+
+  return 0;
+}
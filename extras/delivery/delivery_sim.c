@@ -0,0 +1,359 @@
+/**
+ * @file delivery_sim.c
+ * @brief Counts measurements lost and duplicated over a lossy link with and
+ * without the pending window of the FIFO
+ *
+ * Links the FIFO, FRAM and MB85RC1MT sources from stm32/lib/storage against a
+ * fake HAL that keeps the chip in memory, as in extras/fifo_batch. Every step
+ * the node puts a measurement into the buffer and uploads up to -k of them in
+ * a single uplink. Each measurement holds a unique id, so the backend knows
+ * exactly what it received. The link is lossy:
+ *
+ * - the send is refused by the stack, e.g. for the duty cycle
+ * - the uplink is not received by any gateway
+ * - the uplink is received but the ack of the backend is lost
+ * - the node resets between the uplink and the ack
+ * - the backend fails to store single measurements and asks for a reupload
+ *
+ * Four builds are compared:
+ *
+ * - drop: the measurements are dropped from the buffer when the payload is
+ *   formatted, as FormatPayload did before the pending window
+ * - unconfirmed: the measurements are moved to the pending window but
+ *   committed after every uplink that was sent, since without an ack or a
+ *   response the node can not tell if it was heard
+ * - pending: the measurements are moved to the pending window with FramPend,
+ *   committed on an ack and rolled back otherwise, or if any failed
+ * - selective: as pending, but only the failed measurements are queued again
+ *   with FramCommitExcept, as PayloadAck does
+ *
+ * The backend drops measurements it already received by their sequence
+ * number, and checks that a measurement keeps its number when it is uploaded
+ * again. After the last measurement the node keeps uploading until the buffer
+ * is empty.
+ *
+ * Build and run from extras/delivery:
+ *
+ * @code
+ * gcc -O2 -DFRAM_MB85RC1MT -I../fifo_batch/stubs \
+ *     -I../../stm32/lib/storage/include delivery_sim.c \
+ *     ../../stm32/lib/storage/src/fifo.c ../../stm32/lib/storage/src/fram.c \
+ *     ../../stm32/lib/storage/src/mb85rc1mt.c -o delivery_sim
+ * ./delivery_sim
+ * @endcode
+ *
+ * Pass -n for the number of measurements (default 20000), -k for the
+ * measurements per uplink (default 4), -f, -u, -a and -r for the probability
+ * in percent of a refused send (default 5), a lost uplink (default 20), a lost
+ * ack (default 10), a reset (default 1) and a measurement the backend fails to
+ * store (-e, default 0), and -S for the seed.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fifo.h"
+#include "i2c.h"
+
+/** Max number of measurements */
+#define MAX_MEAS 1000000
+
+/** Max measurements per uplink */
+#define MAX_PER_UPLINK 16
+
+/** Steps after the last measurement to empty the buffer */
+#define DRAIN_STEPS 100000
+
+I2C_HandleTypeDef hi2c1;
+
+/** Contents of the chip */
+static uint8_t chip[1 << 17];
+
+/** Flat address from the device and memory address of the MB85RC1MT */
+static uint32_t ChipAddr(uint16_t dev, uint16_t mem) {
+  return ((uint32_t)(dev & 0x0e) << 15) | mem;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout) {
+  const uint32_t addr = ChipAddr(DevAddress, MemAddress);
+  if (addr + Size > sizeof(chip)) {
+    return HAL_ERROR;
+  }
+  memcpy(chip + addr, pData, Size);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c,
+                                   uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+  const uint32_t addr = ChipAddr(DevAddress, MemAddress);
+  if (addr + Size > sizeof(chip)) {
+    return HAL_ERROR;
+  }
+  memcpy(pData, chip + addr, Size);
+  return HAL_OK;
+}
+
+/** Probabilities of the link in percent */
+typedef struct {
+  /** Send refused by the stack */
+  unsigned int refused;
+  /** Uplink not received */
+  unsigned int uplink;
+  /** Ack not received */
+  unsigned int ack;
+  /** Reset before the ack */
+  unsigned int reset;
+  /** Measurement not stored by the backend */
+  unsigned int failed;
+} SimLink;
+
+/** Handling of the measurements of an uplink */
+typedef enum {
+  /** Dropped when formatted */
+  BUILD_DROP,
+  /** Pending until sent */
+  BUILD_UNCONFIRMED,
+  /** Pending until acked, all uploaded again on a failure */
+  BUILD_PENDING,
+  /** Pending until acked, the failed ones uploaded again */
+  BUILD_SELECTIVE,
+} SimBuild;
+
+/** Result of a run */
+typedef struct {
+  /** Uplinks received by the backend */
+  unsigned long uplinks;
+  /** Measurements in uplinks that were sent */
+  unsigned long sent;
+  /** Distinct measurements received */
+  unsigned long delivered;
+  /** Measurements never received */
+  unsigned long lost;
+  /** Measurements dropped by a full buffer */
+  unsigned long full;
+  /** Measurements received again and dropped by their number */
+  unsigned long duplicates;
+  /** Measurements received under a different number than before */
+  unsigned long renumbered;
+  /** Measurements left in the buffer */
+  unsigned long left;
+} SimResult;
+
+/** Sequence number each measurement was first received with, 0 if never */
+static uint32_t received[MAX_MEAS];
+
+static uint32_t rng_state = 1;
+
+/** Uniform in [0, 100) */
+static unsigned int Percent(void) {
+  // xorshift32
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state % 100;
+}
+
+/**
+ * @brief Backend, stores the measurements of an uplink
+ *
+ * @return Number of measurements that failed, their indices in @p failed
+ */
+static uint16_t Receive(const uint32_t *ids, uint32_t seq, size_t count,
+                        const SimLink *link, uint16_t *failed,
+                        SimResult *res) {
+  uint16_t failed_count = 0;
+  ++res->uplinks;
+  for (size_t i = 0; i < count; i++) {
+    const uint32_t id = ids[i];
+    if (received[id] != 0) {
+      ++res->duplicates;
+      if (received[id] != seq + i) {
+        ++res->renumbered;
+      }
+    } else if (link->failed > 0 && Percent() < link->failed) {
+      // duplicates are dropped before they are stored, so never fail
+      failed[failed_count++] = i;
+    } else {
+      received[id] = seq + i;
+      ++res->delivered;
+    }
+  }
+  return failed_count;
+}
+
+/**
+ * @brief Node, a single tx
+ */
+static void Upload(SimBuild build, size_t per_uplink, const SimLink *link,
+                   SimResult *res) {
+  uint32_t ids[MAX_PER_UPLINK];
+  uint16_t failed[MAX_PER_UPLINK];
+  uint16_t failed_count = 0;
+  size_t count = 0;
+  const uint32_t seq = FramSeq() + FramPendingLen();
+
+  // format
+  uint8_t meas[UINT8_MAX];
+  uint8_t len;
+  while (count < per_uplink && FramPeek(count, meas, &len) == FRAM_OK) {
+    memcpy(&ids[count++], meas, sizeof(ids[0]));
+  }
+  if (count == 0) {
+    return;
+  }
+  if (build != BUILD_DROP) {
+    FramPend(count);
+  } else {
+    for (size_t i = 0; i < count; i++) {
+      FramDrop();
+    }
+  }
+
+  if (Percent() < link->refused) {
+    FramRollback();
+    return;
+  }
+  res->sent += count;
+
+  const int heard = Percent() >= link->uplink;
+  if (heard) {
+    failed_count = Receive(ids, seq, count, link, failed, res);
+  }
+
+  if (Percent() < link->reset) {
+    // the pending window only lives in RAM
+    FIFO_Init();
+    return;
+  }
+
+  if (build == BUILD_UNCONFIRMED) {
+    FramCommit();
+  } else if (!heard || Percent() < link->ack) {
+    FramRollback();
+  } else if (failed_count == 0) {
+    FramCommit();
+  } else if (build != BUILD_SELECTIVE ||
+             FramCommitExcept(failed, failed_count) != FRAM_OK) {
+    FramRollback();
+  }
+}
+
+/**
+ * @brief Run a build
+ *
+ * @param build Handling of the measurements of an uplink
+ * @param n Number of measurements
+ * @param per_uplink Max measurements per uplink
+ * @param link Probabilities of the link
+ * @param seed Seed of the link
+ * @param res Result
+ */
+static void Simulate(SimBuild build, uint32_t n, size_t per_uplink,
+                     const SimLink *link, uint32_t seed, SimResult *res) {
+  *res = (SimResult){0};
+  memset(received, 0, sizeof(received));
+  rng_state = seed;
+  FramBufferClear();
+
+  for (uint32_t id = 0; id < n; id++) {
+    // each measurement is 14 bytes like an encoded SensorMeasurement
+    uint8_t meas[14] = {0};
+    memcpy(meas, &id, sizeof(id));
+    if (FramPut(meas, sizeof(meas)) == FRAM_BUFFER_FULL) {
+      ++res->full;
+    }
+    Upload(build, per_uplink, link, res);
+  }
+
+  for (int i = 0; i < DRAIN_STEPS && FramBufferLen() > 0; i++) {
+    Upload(build, per_uplink, link, res);
+  }
+
+  res->left = FramBufferLen();
+  res->lost = n - res->delivered - res->full - res->left;
+}
+
+static void PrintRow(const char *build, const SimResult *res, uint32_t n) {
+  printf("%-11s %8lu %8lu %10lu %6.2f%% %8lu %6lu %10lu %10lu\n", build,
+         res->uplinks, res->sent, res->delivered, 100.0 * res->delivered / n,
+         res->lost, res->full, res->duplicates, res->renumbered);
+}
+
+int main(int argc, char **argv) {
+  uint32_t n = 20000;
+  size_t per_uplink = 4;
+  SimLink link = {5, 20, 10, 1, 0};
+  uint32_t seed = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "n:k:f:u:a:r:e:S:")) != -1) {
+    switch (opt) {
+      case 'n':
+        n = (uint32_t)atoi(optarg);
+        break;
+      case 'k':
+        per_uplink = (size_t)atoi(optarg);
+        break;
+      case 'f':
+        link.refused = (unsigned int)atoi(optarg);
+        break;
+      case 'u':
+        link.uplink = (unsigned int)atoi(optarg);
+        break;
+      case 'a':
+        link.ack = (unsigned int)atoi(optarg);
+        break;
+      case 'r':
+        link.reset = (unsigned int)atoi(optarg);
+        break;
+      case 'e':
+        link.failed = (unsigned int)atoi(optarg);
+        break;
+      case 'S':
+        seed = (uint32_t)atoi(optarg);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-n meas] [-k per_uplink] [-f refused_pct] "
+                "[-u uplink_loss_pct] [-a ack_loss_pct] [-r reset_pct] "
+                "[-e failed_pct] [-S seed]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (n == 0 || n > MAX_MEAS || per_uplink == 0 ||
+      per_uplink > MAX_PER_UPLINK || seed == 0) {
+    fprintf(stderr, "1 to %d measurements, 1 to %d per uplink, seed not 0\n",
+            MAX_MEAS, MAX_PER_UPLINK);
+    return 1;
+  }
+
+  printf("%u measurements, %zu per uplink, refused %u%%, uplink loss %u%%, "
+         "ack loss %u%%, reset %u%%, failed %u%%\n\n",
+         n, per_uplink, link.refused, link.uplink, link.ack, link.reset,
+         link.failed);
+  printf("%-11s %8s %8s %10s %7s %8s %6s %10s %10s\n", "build", "uplinks",
+         "sent", "delivered", "pct", "lost", "full", "duplicate",
+         "renumbered");
+
+  SimResult res;
+  Simulate(BUILD_DROP, n, per_uplink, &link, seed, &res);
+  PrintRow("drop", &res, n);
+  Simulate(BUILD_UNCONFIRMED, n, per_uplink, &link, seed, &res);
+  PrintRow("unconfirmed", &res, n);
+  Simulate(BUILD_PENDING, n, per_uplink, &link, seed, &res);
+  PrintRow("pending", &res, n);
+  Simulate(BUILD_SELECTIVE, n, per_uplink, &link, seed, &res);
+  PrintRow("selective", &res, n);
+
+  return 0;
+}
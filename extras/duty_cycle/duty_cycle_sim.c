@@ -0,0 +1,292 @@
+/**
+ * @file duty_cycle_sim.c
+ * @brief Checks the transmit planner against a model of the EU868 and US915
+ * rules while draining a backlog
+ *
+ * The node starts with a full FRAM buffer after an outage and keeps measuring.
+ * Each tx takes as many measurements as fit in the payload of the data rate.
+ * Every run is checked by a reference model that keeps every uplink:
+ *
+ * - EU868: the airtime within any hour that ends with an uplink is at most
+ *   36 s, 1% of the hour
+ * - US915: a single uplink is at most 400 ms on air
+ *
+ * Two builds are compared:
+ *
+ * - period: sends on every tx period, as before the planner. An uplink the
+ *   reference model refuses is lost, since its measurements were already
+ *   dropped from the buffer when the payload was formatted
+ * - planner: stm32/lib/txplan caps the payload to the dwell time, skips a tx
+ *   the budget has no room for, and sends back to back while the backlog is
+ *   large
+ *
+ * Build and run from extras/duty_cycle:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/Inc -I../../stm32/lib/txplan/include \
+ *     duty_cycle_sim.c ../../stm32/lib/txplan/src/txplan.c \
+ *     ../../stm32/Src/lora_size.c -o duty_cycle_sim
+ * ./duty_cycle_sim
+ * @endcode
+ *
+ * Pass -m for the measurement period in s (default 60), -u for the tx period
+ * in s (default 30), -s for the size of an encoded measurement in bytes
+ * (default 10), -b for the measurements in the buffer at the start (default
+ * 44) and -H for the simulated duration in hours (default 6).
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "lora_size.h"
+#include "txplan.h"
+
+/** Measurements that fit in the FRAM buffer */
+#define BUFFER_LEN 44
+
+/** Max number of uplinks kept by the reference model */
+#define MAX_UPLINKS 100000
+
+/** Duty cycle window of EU868 in ms */
+#define HOUR_MS 3600000
+
+/** Airtime allowed per hour in EU868 in ms */
+#define EU868_BUDGET_MS 36000
+
+/** Dwell time limit of US915 in ms */
+#define US915_DWELL_MS 400
+
+/** Region and data rate of a run */
+typedef struct {
+  /** Name of the run */
+  const char *name;
+  /** LoRaMacRegion_t value */
+  unsigned int region;
+  /** Data rate */
+  int8_t dr;
+} SimRun;
+
+/** Result of a run */
+typedef struct {
+  /** Uplinks sent */
+  uint32_t uplinks;
+  /** Uplinks refused by the reference model */
+  uint32_t refused;
+  /** Measurements lost with refused uplinks */
+  uint32_t lost;
+  /** Measurements lost to a full buffer */
+  uint32_t dropped;
+  /** Largest airtime within an hour in ms */
+  uint32_t max_hour_ms;
+  /** Longest uplink in ms */
+  uint32_t max_airtime;
+  /** Time until the buffer was empty in s, 0 if it never was */
+  uint32_t drained_s;
+} SimResult;
+
+static const SimRun runs[] = {
+    {"EU868 DR0", TXPLAN_REGION_EU868, 0},
+    {"EU868 DR3", TXPLAN_REGION_EU868, 3},
+    {"EU868 DR5", TXPLAN_REGION_EU868, 5},
+    {"US915 DR0", TXPLAN_REGION_US915, 0},
+    {"US915 DR3", TXPLAN_REGION_US915, 3},
+};
+
+/** Start of every uplink accepted by the reference model in ms */
+static uint32_t sent_at[MAX_UPLINKS];
+
+/** Airtime of every uplink accepted by the reference model in ms */
+static uint32_t sent_ms[MAX_UPLINKS];
+
+/**
+ * @brief Reference model, airtime within the hour that ends at @p now
+ */
+static uint32_t HourAirtime(uint32_t len, uint32_t now) {
+  uint32_t total = 0;
+  for (uint32_t i = len; i > 0 && now - sent_at[i - 1] < HOUR_MS; i--) {
+    total += sent_ms[i - 1];
+  }
+  return total;
+}
+
+/**
+ * @brief Reference model, check if an uplink complies with the region
+ */
+static int Allowed(const SimRun *run, uint32_t len, uint32_t now,
+                   uint32_t airtime) {
+  if (run->region == TXPLAN_REGION_EU868) {
+    return HourAirtime(len, now) + airtime <= EU868_BUDGET_MS;
+  }
+  return airtime <= US915_DWELL_MS;
+}
+
+/**
+ * @brief Run a region and data rate
+ *
+ * @param run Region and data rate
+ * @param planned Use the planner
+ * @param measure_ms Measurement period in ms
+ * @param tx_ms Tx period in ms
+ * @param meas_size Size of an encoded measurement in bytes
+ * @param backlog Measurements in the buffer at the start
+ * @param duration Simulated time in ms
+ * @param res Result
+ */
+static void Simulate(const SimRun *run, int planned, uint32_t measure_ms,
+                     uint32_t tx_ms, uint32_t meas_size, uint32_t backlog,
+                     uint32_t duration, SimResult *res) {
+  TxPlanConfig config;
+  TxPlanRegion(run->region, &config);
+  TxPlan plan;
+  TxPlanInit(&plan, &config, 0);
+
+  *res = (SimResult){0};
+  uint32_t len = 0;
+  uint32_t next_measure = measure_ms;
+  uint32_t next_tx = tx_ms;
+
+  uint32_t max_payload = lorawan_max_payload(run->region, run->dr);
+  if (planned) {
+    const uint32_t dwell = TxPlanMaxPayload(run->region, run->dr,
+                                            config.dwell_ms);
+    if (max_payload > dwell) {
+      max_payload = dwell;
+    }
+  }
+  const uint32_t max_airtime =
+      TxPlanAirtime(run->region, run->dr, (uint8_t)max_payload);
+
+  // a payload holds at least one measurement, as in FormatPayload
+  uint32_t per_uplink = max_payload / meas_size;
+  if (per_uplink == 0) {
+    per_uplink = 1;
+  }
+
+  for (uint32_t now = 0; now < duration;) {
+    if (now == next_measure) {
+      if (backlog < BUFFER_LEN) {
+        backlog++;
+      } else {
+        res->dropped++;
+      }
+      next_measure += measure_ms;
+    }
+
+    if (now == next_tx) {
+      next_tx += tx_ms;
+      const int fits = !planned || TxPlanWait(&plan, now, max_airtime) == 0;
+      if (backlog > 0 && fits) {
+        const uint32_t count = backlog < per_uplink ? backlog : per_uplink;
+        const uint32_t payload =
+            count * meas_size < 255 ? count * meas_size : 255;
+        const uint32_t airtime =
+            TxPlanAirtime(run->region, run->dr, (uint8_t)payload);
+        backlog -= count;
+
+        if (airtime > res->max_airtime) {
+          res->max_airtime = airtime;
+        }
+        if (!Allowed(run, len, now, airtime)) {
+          res->refused++;
+          res->lost += count;
+        } else if (len < MAX_UPLINKS) {
+          sent_at[len] = now;
+          sent_ms[len++] = airtime;
+          res->uplinks++;
+          const uint32_t hour = HourAirtime(len, now);
+          if (hour > res->max_hour_ms) {
+            res->max_hour_ms = hour;
+          }
+        }
+
+        if (planned) {
+          TxPlanSent(&plan, now, airtime);
+          next_tx = now + TxPlanNext(&plan, now, max_airtime, backlog, tx_ms);
+        }
+      }
+    }
+
+    if (backlog == 0 && res->drained_s == 0) {
+      res->drained_s = now / 1000;
+    }
+
+    now = next_measure < next_tx ? next_measure : next_tx;
+  }
+}
+
+static void PrintRow(const char *run, const char *build, const SimResult *res,
+                     double hours) {
+  printf("%-10s %-8s %9.1f %8u %6u %8u %9.1f %8u ", run, build,
+         res->uplinks / hours, res->refused, res->lost, res->dropped,
+         res->max_hour_ms / 1000.0, res->max_airtime);
+  if (res->drained_s != 0) {
+    printf("%8u\n", res->drained_s);
+  } else {
+    printf("%8s\n", "-");
+  }
+}
+
+int main(int argc, char **argv) {
+  uint32_t measure_s = 60;
+  uint32_t tx_s = 30;
+  uint32_t meas_size = 10;
+  uint32_t backlog = BUFFER_LEN;
+  double hours = 6;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "m:u:s:b:H:")) != -1) {
+    switch (opt) {
+      case 'm':
+        measure_s = (uint32_t)atoi(optarg);
+        break;
+      case 'u':
+        tx_s = (uint32_t)atoi(optarg);
+        break;
+      case 's':
+        meas_size = (uint32_t)atoi(optarg);
+        break;
+      case 'b':
+        backlog = (uint32_t)atoi(optarg);
+        break;
+      case 'H':
+        hours = atof(optarg);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-m measure_s] [-u tx_s] [-s meas_bytes] "
+                "[-b backlog] [-H hours]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (measure_s == 0 || tx_s == 0 || meas_size == 0 || hours <= 0 ||
+      hours > 1000) {
+    fprintf(stderr, "periods, size and hours must be positive\n");
+    return 1;
+  }
+  if (backlog > BUFFER_LEN) {
+    backlog = BUFFER_LEN;
+  }
+
+  const uint32_t duration = (uint32_t)(hours * HOUR_MS);
+  printf("%.1f h, measure %u s, tx %u s, %u bytes per measurement, "
+         "%u buffered\n\n",
+         hours, measure_s, tx_s, meas_size, backlog);
+  printf("%-10s %-8s %9s %8s %6s %8s %9s %8s %8s\n", "run", "build",
+         "uplink/h", "refused", "lost", "dropped", "max_s/h", "max_ms",
+         "drain_s");
+  for (size_t r = 0; r < sizeof(runs) / sizeof(runs[0]); r++) {
+    SimResult res;
+    Simulate(&runs[r], 0, measure_s * 1000, tx_s * 1000, meas_size, backlog,
+             duration, &res);
+    PrintRow(runs[r].name, "period", &res, hours);
+    Simulate(&runs[r], 1, measure_s * 1000, tx_s * 1000, meas_size, backlog,
+             duration, &res);
+    PrintRow("", "planner", &res, hours);
+  }
+
+  return 0;
+}
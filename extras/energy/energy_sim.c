@@ -0,0 +1,321 @@
+/**
+ * @file energy_sim.c
+ * @brief Simulates the energy per measurement and per uplink of a build
+ *
+ * The energy accounts from stm32/lib/energy are run against a virtual clock
+ * in ms. A day of the node is replayed with the same hooks the firmware
+ * calls: ENERGY_SCOPE at the top of each sequencer task, ENERGY_WAIT around
+ * HAL_Delay, ENERGY_SLEEP or ENERGY_STOP in UTIL_SEQ_Idle and EnergyRadio
+ * from the RF switch. The workload is modeled on the firmware:
+ *
+ * - a measurement runs for MEASURE_RUN_MS and blocks for MEASURE_WAIT_MS in
+ *   the two HAL_Delay(60) of the ADS1219 driver
+ * - an uplink formats the payload in SendTxData, transmits for UPLINK_TOA_MS
+ *   and opens both class A receive windows, with LmHandlerProcess after each
+ *   radio event
+ *
+ * Each build differs in how the node idles:
+ *
+ * - sleep: LOW_POWER_DISABLE set in sys_conf.h, the sequencer idles in sleep
+ *   mode, which is the current firmware
+ * - stop: Stop2 enabled, every wakeup reinitializes the board for
+ *   STOP_WAKE_MS
+ *
+ * and in how the measurement waits for the ADS1219, with HAL_Delay or with
+ * LowPowerDelay from stm32/lib/lowpower, marked "+lpd". LowPowerDelay idles
+ * in the same low power mode as the sequencer.
+ *
+ * The currents are ENERGY_CURRENTS_DEFAULT, so the results are only as good as
+ * those constants. Stop2 has not been measured on the board and defaults to
+ * the idle current, pass -s to try another value.
+ *
+ * Build and run from extras/energy:
+ *
+ * @code
+ * gcc -O2 -I../binlog/host -I../../stm32/Inc \
+ *     -I../../stm32/lib/energy/include energy_sim.c \
+ *     ../../stm32/lib/energy/src/energy.c -o energy_sim
+ * ./energy_sim -m 60 -u 300 -s 1000
+ * @endcode
+ *
+ * Pass -m for the measurement period in s (default 60), -u for the uplink
+ * period in s (default 300), -s for the Stop2 current in uA and -H for the
+ * simulated duration in hours (default 24).
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "energy.h"
+#include "utilities_def.h"
+
+/** Time the measurement task runs in ms */
+#define MEASURE_RUN_MS 8
+/** Time the measurement task blocks in HAL_Delay in ms */
+#define MEASURE_WAIT_MS 120
+
+/** Time SendTxData runs in ms */
+#define UPLINK_RUN_MS 15
+/** Time LmHandlerProcess runs after each radio event in ms */
+#define PROCESS_RUN_MS 2
+/** Time on air of an uplink in ms, about 50 bytes at SF7 */
+#define UPLINK_TOA_MS 92
+/** Delay from the end of the uplink to the first receive window in ms */
+#define RX1_DELAY_MS 1000
+/** Delay from the end of the uplink to the second receive window in ms */
+#define RX2_DELAY_MS 2000
+/** Length of a receive window without a downlink in ms */
+#define RX_WINDOW_MS 25
+
+/** Time to reinitialize the board after Stop2 in ms */
+#define STOP_WAKE_MS 2
+
+/** Time of the virtual clock in ms */
+static uint64_t now = 0;
+
+/** Virtual clock */
+static uint32_t Clock(void) { return (uint32_t)now; }
+
+/** Energy of the measurements including their low power waits in uJ */
+static uint64_t measure_uj = 0;
+
+/** Build under test */
+typedef struct {
+  /** Name printed in the report */
+  const char *name;
+  /** Account of UTIL_SEQ_Idle */
+  EnergyState idle;
+  /** Time awake after each wakeup in ms */
+  uint32_t wake_ms;
+  /** Waits of drivers use LowPowerDelay instead of HAL_Delay */
+  bool lowpower_delay;
+} Build;
+
+/** Builds compared by the simulation */
+static const Build builds[] = {
+    {"sleep", ENERGY_SLEEP, 0, false},
+    {"sleep+lpd", ENERGY_SLEEP, 0, true},
+    {"stop", ENERGY_STOP, STOP_WAKE_MS, false},
+    {"stop+lpd", ENERGY_STOP, STOP_WAKE_MS, true},
+};
+
+/**
+ * @brief Idle in the low power state of the build for a time
+ */
+static void Idle(const Build *build, uint64_t ms) {
+  if (ms == 0) {
+    return;
+  }
+
+  const int prev = EnergyEnter(build->idle);
+  now += ms;
+  EnergyReturn(prev);
+  now += build->wake_ms;
+}
+
+/**
+ * @brief Wait of a driver
+ */
+static void Delay(const Build *build, uint64_t ms) {
+  if (build->lowpower_delay) {
+    Idle(build, ms);
+    return;
+  }
+
+  ENERGY_SCOPE(ENERGY_WAIT);
+  now += ms;
+}
+
+/**
+ * @brief Measurement task
+ */
+static void Measure(const Build *build) {
+  ENERGY_SCOPE(CFG_SEQ_Task_Measurement);
+  now += MEASURE_RUN_MS / 2;
+  Delay(build, MEASURE_WAIT_MS / 2);
+  Delay(build, MEASURE_WAIT_MS / 2);
+  now += MEASURE_RUN_MS / 2;
+}
+
+/**
+ * @brief LoRaWAN stack task after a radio event
+ */
+static void Process(void) {
+  ENERGY_SCOPE(CFG_SEQ_Task_LmHandlerProcess);
+  now += PROCESS_RUN_MS;
+}
+
+/**
+ * @brief Uplink task and the radio events that follow it
+ */
+static void Uplink(const Build *build) {
+  {
+    ENERGY_SCOPE(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent);
+    now += UPLINK_RUN_MS;
+  }
+
+  EnergyRadio(ENERGY_RADIO_TX);
+  Idle(build, UPLINK_TOA_MS);
+  EnergyRadio(ENERGY_RADIO_OFF);
+  Process();
+  const uint64_t tx_done = now;
+
+  Idle(build, tx_done + RX1_DELAY_MS - now);
+  EnergyRadio(ENERGY_RADIO_RX);
+  Idle(build, RX_WINDOW_MS);
+  EnergyRadio(ENERGY_RADIO_OFF);
+  Process();
+
+  Idle(build, tx_done + RX2_DELAY_MS - now);
+  EnergyRadio(ENERGY_RADIO_RX);
+  Idle(build, RX_WINDOW_MS);
+  EnergyRadio(ENERGY_RADIO_OFF);
+  Process();
+}
+
+/**
+ * @brief Energy of every account and the radio up to now in uJ
+ */
+static uint64_t Total(const EnergyCurrents *currents) {
+  uint64_t uj = 0;
+  for (int i = 0; i < ENERGY_ACCOUNTS; i++) {
+    uj += EnergyMicrojoules(i, currents);
+  }
+  for (int i = 0; i < ENERGY_RADIO_STATES; i++) {
+    uj += EnergyRadioMicrojoules(i, currents);
+  }
+  return uj;
+}
+
+/**
+ * @brief Replays the node for a duration
+ *
+ * Uplinks are scheduled a second after a measurement. An event that is due
+ * while the previous one is still running starts as soon as it ends.
+ */
+static void Run(const Build *build, const EnergyCurrents *currents,
+                uint64_t measure_ms, uint64_t upload_ms, uint64_t duration_ms) {
+  now = 0;
+  measure_uj = 0;
+  EnergyInit(Clock, 1000);
+
+  uint64_t next_measure = 0;
+  uint64_t next_upload = 1000;
+  while (now < duration_ms) {
+    const uint64_t next =
+        (next_measure <= next_upload) ? next_measure : next_upload;
+    if (next > now) {
+      Idle(build, next - now);
+    }
+
+    if (next == next_measure) {
+      // the accounts of a task leave out its low power waits
+      const uint64_t before = Total(currents);
+      Measure(build);
+      measure_uj += Total(currents) - before;
+      next_measure += measure_ms;
+    } else {
+      Uplink(build);
+      next_upload += upload_ms;
+    }
+  }
+}
+
+/**
+ * @brief Energy of a task per entry in mJ
+ */
+static double PerEntry(uint64_t uj, uint32_t count) {
+  return (count > 0) ? (double)uj / count / 1000 : 0.0;
+}
+
+/**
+ * @brief Prints the residency and energy of the last run
+ */
+static void Report(const Build *build, const EnergyCurrents *currents) {
+  uint64_t all = 0;
+  uint64_t task_ticks = 0;
+  for (int i = 0; i < ENERGY_ACCOUNTS; i++) {
+    all += EnergyGet(i)->ticks;
+    if (i < ENERGY_MAX_TASKS) {
+      task_ticks += EnergyGet(i)->ticks;
+    }
+  }
+  const uint64_t uj = Total(currents);
+
+  const uint32_t measurements = EnergyGet(CFG_SEQ_Task_Measurement)->count;
+
+  const uint32_t uplinks =
+      EnergyGet(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent)->count;
+  const uint64_t uplink_uj =
+      EnergyTaskMicrojoules(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent,
+                            currents) +
+      EnergyTaskMicrojoules(CFG_SEQ_Task_LmHandlerProcess, currents) +
+      EnergyRadioMicrojoules(ENERGY_RADIO_TX, currents) +
+      EnergyRadioMicrojoules(ENERGY_RADIO_RX, currents);
+
+  const double seconds = (double)all / EnergyTicksPerSecond();
+  const double mean_ma = (double)uj / currents->voltage_mv / seconds;
+
+  printf("%-10s%8.3f%8.3f%8.3f%8.3f%8.3f%12.3f%12.3f%10.3f\n", build->name,
+         100.0 * task_ticks / all,
+         100.0 * EnergyGet(ENERGY_RUN)->ticks / all,
+         100.0 * EnergyGet(ENERGY_WAIT)->ticks / all,
+         100.0 * EnergyGet(ENERGY_SLEEP)->ticks / all,
+         100.0 * EnergyGet(ENERGY_STOP)->ticks / all,
+         PerEntry(measure_uj, measurements), PerEntry(uplink_uj, uplinks),
+         mean_ma);
+}
+
+int main(int argc, char *argv[]) {
+  uint64_t measure_s = 60;
+  uint64_t upload_s = 300;
+  uint64_t hours = 24;
+  EnergyCurrents currents = ENERGY_CURRENTS_DEFAULT;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "m:u:s:H:")) != -1) {
+    switch (opt) {
+      case 'm':
+        measure_s = strtoull(optarg, NULL, 10);
+        break;
+      case 'u':
+        upload_s = strtoull(optarg, NULL, 10);
+        break;
+      case 's':
+        currents.stop_ua = strtoul(optarg, NULL, 10);
+        break;
+      case 'H':
+        hours = strtoull(optarg, NULL, 10);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-m measure_s] [-u upload_s] [-s stop_ua] "
+                "[-H hours]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (measure_s == 0 || upload_s == 0 || hours == 0 || hours > 1000) {
+    fprintf(stderr, "periods must be positive and hours at most 1000\n");
+    return 1;
+  }
+
+  printf("%" PRIu64 " h, measurement every %" PRIu64 " s, uplink every %" PRIu64
+         " s, stop2 at %u uA\n\n",
+         hours, measure_s, upload_s, (unsigned)currents.stop_ua);
+  printf("%-10s%8s%8s%8s%8s%8s%12s%12s%10s\n", "build", "task%", "run%",
+         "wait%", "sleep%", "stop%", "mJ/meas", "mJ/uplink", "mean mA");
+  for (size_t i = 0; i < sizeof(builds) / sizeof(builds[0]); i++) {
+    Run(&builds[i], &currents, measure_s * 1000, upload_s * 1000,
+        hours * 3600 * 1000);
+    Report(&builds[i], &currents);
+  }
+
+  return 0;
+}
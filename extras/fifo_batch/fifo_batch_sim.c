@@ -0,0 +1,230 @@
+/**
+ * @file fifo_batch_sim.c
+ * @brief Counts the I2C transactions of putting a measurement cycle into the
+ * FRAM buffer
+ *
+ * Links the FIFO, FRAM and MB85RC1MT sources from stm32/lib/storage against a
+ * fake HAL that keeps the chip in memory and counts every
+ * HAL_I2C_Mem_Write/HAL_I2C_Mem_Read. A cycle puts one measurement per size
+ * given on the command line, once with a FramPut each and once staged in a
+ * FramBatch with a single FramBatchCommit. The buffer is drained with FramGet
+ * after every cycle like an upload, which is not counted.
+ *
+ * Build and run from extras/fifo_batch:
+ *
+ * @code
+ * gcc -O2 -DFRAM_MB85RC1MT -Istubs -I../../stm32/lib/storage/include \
+ *     fifo_batch_sim.c ../../stm32/lib/storage/src/fifo.c \
+ *     ../../stm32/lib/storage/src/fram.c \
+ *     ../../stm32/lib/storage/src/mb85rc1mt.c -o fifo_batch_sim
+ * ./fifo_batch_sim 25 25 20 25 25 25 25 25
+ * @endcode
+ *
+ * The batch row is only printed when fifo.h has FramBatch, so the same file
+ * also measures older versions of the sources.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fifo.h"
+#include "i2c.h"
+
+/** Number of cycles */
+#define CYCLES 100
+
+/** Max measurements per cycle */
+#define MAX_MEAS 32
+
+/** Device address and two memory address bytes of a transaction */
+#define I2C_HEADER 3
+
+I2C_HandleTypeDef hi2c1;
+
+/** Contents of the chip */
+static uint8_t chip[1 << 17];
+
+/** Number of transactions */
+static unsigned long transactions = 0;
+
+/** Number of bytes on the bus */
+static unsigned long bus_bytes = 0;
+
+/**
+ * @brief Flat address from the device and memory address of the MB85RC1MT
+ */
+static uint32_t ChipAddr(uint16_t dev, uint16_t mem) {
+  return ((uint32_t)(dev & 0x0e) << 15) | mem;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout) {
+  (void)hi2c;
+  (void)MemAddSize;
+  (void)Timeout;
+
+  const uint32_t addr = ChipAddr(DevAddress, MemAddress);
+  if (addr + Size > sizeof(chip)) {
+    return HAL_ERROR;
+  }
+
+  memcpy(chip + addr, pData, Size);
+  ++transactions;
+  bus_bytes += I2C_HEADER + Size;
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c,
+                                   uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+  (void)hi2c;
+  (void)MemAddSize;
+  (void)Timeout;
+
+  const uint32_t addr = ChipAddr(DevAddress, MemAddress);
+  if (addr + Size > sizeof(chip)) {
+    return HAL_ERROR;
+  }
+
+  memcpy(pData, chip + addr, Size);
+  ++transactions;
+  bus_bytes += I2C_HEADER + Size;
+
+  return HAL_OK;
+}
+
+/** Measurements of a cycle */
+typedef struct {
+  uint8_t data[MAX_MEAS][UINT8_MAX];
+  size_t len[MAX_MEAS];
+  size_t count;
+} Cycle;
+
+/**
+ * @brief Drains the buffer and checks it holds the cycle in order
+ *
+ * @return 0 on success
+ */
+static int Drain(const Cycle *cycle) {
+  uint8_t data[UINT8_MAX];
+  uint8_t len = 0;
+
+  for (size_t i = 0; i < cycle->count; i++) {
+    if (FramGet(data, &len) != FRAM_OK || len != cycle->len[i] ||
+        memcmp(data, cycle->data[i], len) != 0) {
+      fprintf(stderr, "measurement %zu read back wrong\n", i);
+      return -1;
+    }
+  }
+
+  if (FramBufferLen() != 0) {
+    fprintf(stderr, "buffer not empty after the cycle\n");
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Prints the transactions and bytes per cycle since the last reset
+ */
+static void Report(const char *name) {
+  printf("%-8s %12.1f %12.1f\n", name, (double)transactions / CYCLES,
+         (double)bus_bytes / CYCLES);
+}
+
+int main(int argc, char *argv[]) {
+  Cycle cycle = {0};
+
+  if (argc < 2 || argc - 1 > MAX_MEAS) {
+    fprintf(stderr, "usage: %s size [size ...]\n", argv[0]);
+    return 1;
+  }
+
+  size_t total = 0;
+  for (int i = 1; i < argc; i++) {
+    const long len = strtol(argv[i], NULL, 10);
+    if (len < 1 || len > UINT8_MAX) {
+      fprintf(stderr, "size must be 1 to %d\n", UINT8_MAX);
+      return 1;
+    }
+    cycle.len[cycle.count] = len;
+    for (long j = 0; j < len; j++) {
+      cycle.data[cycle.count][j] = (uint8_t)(cycle.count * 31 + j);
+    }
+    ++cycle.count;
+    total += len;
+  }
+
+  printf("%zu measurements per cycle, %zu bytes, %d cycles\n\n", cycle.count,
+         total, CYCLES);
+  printf("%-8s %12s %12s\n", "", "i2c/cycle", "bytes/cycle");
+
+  FramBufferClear();
+
+  transactions = 0;
+  bus_bytes = 0;
+  unsigned long drain_transactions = 0;
+  unsigned long drain_bytes = 0;
+  for (int c = 0; c < CYCLES; c++) {
+    for (size_t i = 0; i < cycle.count; i++) {
+      if (FramPut(cycle.data[i], cycle.len[i]) != FRAM_OK) {
+        fprintf(stderr, "FramPut failed\n");
+        return 1;
+      }
+    }
+
+    const unsigned long t = transactions;
+    const unsigned long b = bus_bytes;
+    if (Drain(&cycle) != 0) {
+      return 1;
+    }
+    drain_transactions += transactions - t;
+    drain_bytes += bus_bytes - b;
+  }
+  transactions -= drain_transactions;
+  bus_bytes -= drain_bytes;
+  Report("put");
+
+#ifdef FRAM_BATCH_SIZE
+  static FramBatch batch;
+  FramBatchInit(&batch);
+
+  transactions = 0;
+  bus_bytes = 0;
+  drain_transactions = 0;
+  drain_bytes = 0;
+  for (int c = 0; c < CYCLES; c++) {
+    for (size_t i = 0; i < cycle.count; i++) {
+      if (FramBatchAdd(&batch, cycle.data[i], cycle.len[i]) != FRAM_OK) {
+        fprintf(stderr, "FramBatchAdd failed\n");
+        return 1;
+      }
+    }
+    if (FramBatchCommit(&batch) != FRAM_OK) {
+      fprintf(stderr, "FramBatchCommit failed\n");
+      return 1;
+    }
+
+    const unsigned long t = transactions;
+    const unsigned long b = bus_bytes;
+    if (Drain(&cycle) != 0) {
+      return 1;
+    }
+    drain_transactions += transactions - t;
+    drain_bytes += bus_bytes - b;
+  }
+  transactions -= drain_transactions;
+  bus_bytes -= drain_bytes;
+  Report("batch");
+#endif /* FRAM_BATCH_SIZE */
+
+  return 0;
+}
@@ -0,0 +1,13 @@
+/**
+ * @file prof.h
+ * @brief Host stand in for lib/prof, scopes are not timed
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef EXTRAS_FIFO_BATCH_STUBS_PROF_H_
+#define EXTRAS_FIFO_BATCH_STUBS_PROF_H_
+
+#define PROF_SCOPE(name)
+
+#endif  // EXTRAS_FIFO_BATCH_STUBS_PROF_H_
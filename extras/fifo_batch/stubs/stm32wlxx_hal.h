@@ -0,0 +1,40 @@
+/**
+ * @file stm32wlxx_hal.h
+ * @brief Host stand in for the parts of the HAL used by lib/storage
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_HAL_H_
+#define EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_HAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef enum {
+  HAL_OK = 0,
+  HAL_ERROR,
+  HAL_BUSY,
+  HAL_TIMEOUT,
+} HAL_StatusTypeDef;
+
+typedef struct {
+  int unused;
+} I2C_HandleTypeDef;
+
+#define I2C_MEMADD_SIZE_16BIT 2
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout);
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c,
+                                   uint16_t DevAddress, uint16_t MemAddress,
+                                   uint16_t MemAddSize, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout);
+
+static inline void HAL_Delay(uint32_t Delay) { (void)Delay; }
+
+#endif  // EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_HAL_H_
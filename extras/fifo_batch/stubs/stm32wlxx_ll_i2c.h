@@ -0,0 +1,3 @@
+#ifndef EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_LL_I2C_H_
+#define EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_LL_I2C_H_
+#endif  // EXTRAS_FIFO_BATCH_STUBS_STM32WLXX_LL_I2C_H_
@@ -0,0 +1,8 @@
+#ifndef EXTRAS_FIFO_BATCH_STUBS_SYS_APP_H_
+#define EXTRAS_FIFO_BATCH_STUBS_SYS_APP_H_
+
+#include <stdio.h>
+
+#define APP_PRINTF(...)
+
+#endif  // EXTRAS_FIFO_BATCH_STUBS_SYS_APP_H_
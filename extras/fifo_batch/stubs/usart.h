@@ -0,0 +1,3 @@
+#ifndef EXTRAS_FIFO_BATCH_STUBS_USART_H_
+#define EXTRAS_FIFO_BATCH_STUBS_USART_H_
+#endif  // EXTRAS_FIFO_BATCH_STUBS_USART_H_
@@ -0,0 +1,10 @@
+#ifndef EXTRAS_FIFO_BATCH_STUBS_USERCONFIG_H_
+#define EXTRAS_FIFO_BATCH_STUBS_USERCONFIG_H_
+
+/** Same address as lib/userConfig/include/userConfig.h */
+#define USER_CONFIG_START_ADDRESS 1794
+
+/** Same address as lib/userConfig/include/userConfig.h */
+#define USER_CONFIG_LEN_ADDR 1792
+
+#endif  // EXTRAS_FIFO_BATCH_STUBS_USERCONFIG_H_
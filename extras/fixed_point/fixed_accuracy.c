@@ -0,0 +1,245 @@
+/**
+ * @file fixed_accuracy.c
+ * @brief Compares the fixed point sensor conversions against the double
+ * reference
+ *
+ * Links fixed.c, calibration.c and parse.c from stm32/lib/sensors and sweeps
+ * the raw input range of every converted measurement. Each conversion is done
+ * the same way as in its driver and compared against the double equation it
+ * replaced. The ADS1219 statistics are computed from random bursts of codes
+ * around a sine, with the calibration from DISABLE_CALIBRATION and with an
+ * example user calibration.
+ *
+ * Build and run from extras/fixed_point:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include -I../../proto/c/include \
+ *     fixed_accuracy.c ../../stm32/lib/sensors/src/fixed.c \
+ *     ../../stm32/lib/sensors/src/calibration.c \
+ *     ../../stm32/lib/sensors/src/parse.c -lm -o fixed_accuracy
+ * ./fixed_accuracy
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "calibration.h"
+#include "fixed.h"
+#include "parse.h"
+
+/** Number of random ADS1219 bursts per calibration */
+#define BURSTS 10000
+
+/** Max samples per burst */
+#define BURST_MAX 64
+
+/** Errors of a single conversion */
+typedef struct {
+  const char *name;
+  unsigned long n;
+  double max_abs;
+  double max_rel;
+} Errors;
+
+/**
+ * @brief Add a fixed point result to the errors
+ *
+ * The relative error skips references close to 0.
+ */
+static void Compare(Errors *e, double fixed, double ref) {
+  const double abs_err = fabs(fixed - ref);
+  if (abs_err > e->max_abs) {
+    e->max_abs = abs_err;
+  }
+  if (fabs(ref) > 1e-3) {
+    const double rel_err = abs_err / fabs(ref);
+    if (rel_err > e->max_rel) {
+      e->max_rel = rel_err;
+    }
+  }
+  ++e->n;
+}
+
+static void Print(const Errors *e) {
+  printf("%-22s %10lu %14.3e %14.3e\n", e->name, e->n, e->max_abs,
+         e->max_rel);
+}
+
+/** Linear congruential generator, the same sequence on every host */
+static uint32_t Rand(void) {
+  static uint32_t state = 1;
+  state = state * 1664525 + 1013904223;
+  return state;
+}
+
+/**
+ * @brief Copy of RootOfSum in stm32/lib/ads/src/ads.c
+ */
+static q32_t RootOfSum(q32_t a, q32_t b, q32_t c, q32_t d) {
+  const q32_t limit = Q32FromInt(1 << 14);
+  int shift = 0;
+  while ((a > limit || a < -limit || b > limit || b < -limit ||
+          c > limit || c < -limit || d > limit || d < -limit) &&
+         shift < 31) {
+    a /= 2;
+    b /= 2;
+    c /= 2;
+    d /= 2;
+    ++shift;
+  }
+
+  const q32_t sum = Q32Mul(a, a) + 2 * Q32Mul(b, c) + Q32Mul(d, d);
+  const q32_t root = Q32Sqrt(sum);
+  if (root > (Q32_MAX >> shift)) {
+    return Q32_MAX;
+  }
+  return root << shift;
+}
+
+/**
+ * @brief Sweep single ADS1219 codes and random bursts of a channel
+ *
+ * @param type Measurement type of the channel
+ * @param m Double slope
+ * @param b Double offset
+ * @param errors Single, mean, min/max and rms errors
+ */
+static void SweepAds(SensorType type, double m, double b, Errors errors[4]) {
+  const Calibration *cal = CalibrationGet(type);
+
+  for (int32_t raw = -(1 << 23); raw < (1 << 23); raw += 97) {
+    const q32_t fixed = CalibrationApply(cal, Q32FromInt(raw));
+    Compare(&errors[0], Q32ToDouble(fixed), (m * raw) + b);
+  }
+
+  for (int i = 0; i < BURSTS; i++) {
+    const uint32_t count = 1 + (Rand() % BURST_MAX);
+    const double amp = Rand() % (1 << 23);
+    const double offset = ((double)(Rand() % (1 << 23)) - (1 << 22)) / 2;
+
+    int64_t sum = 0;
+    uint64_t sum_sq = 0;
+    int32_t min = INT32_MAX;
+    int32_t max = INT32_MIN;
+    for (uint32_t j = 0; j < count; j++) {
+      double x = offset + (amp * sin(j * 0.3)) + ((Rand() % 200) - 100.0);
+      if (x > (1 << 23) - 1) {
+        x = (1 << 23) - 1;
+      } else if (x < -(1 << 23)) {
+        x = -(1 << 23);
+      }
+      const int32_t code = (int32_t)x;
+      sum += code;
+      sum_sq += (int64_t)code * code;
+      min = (code < min) ? code : min;
+      max = (code > max) ? code : max;
+    }
+
+    // same as ConvertReading in ads.c
+    const q32_t mean = Q32FromRatio(sum, count);
+    const q32_t rms = Q32SqrtRatio(sum_sq, count);
+    const q32_t lo = CalibrationApply(cal, Q32FromInt(min));
+    const q32_t hi = CalibrationApply(cal, Q32FromInt(max));
+    const double fixed_mean = Q32ToDouble(CalibrationApply(cal, mean));
+    const double fixed_min = Q32ToDouble((lo < hi) ? lo : hi);
+    const double fixed_max = Q32ToDouble((lo < hi) ? hi : lo);
+    const double fixed_rms = Q32ToDouble(
+        RootOfSum(Q32Mul(cal->m, rms), Q32Mul(cal->m, mean), cal->b, cal->b));
+
+    // double reference, ConvertReading before the port
+    const double ref_mean = (double)sum / count;
+    const double ref_rms = sqrt((double)sum_sq / count);
+    const double ref_lo = (m * min) + b;
+    const double ref_hi = (m * max) + b;
+    const double ref_mean_sq =
+        (m * m * ref_rms * ref_rms) + (2 * m * b * ref_mean) + (b * b);
+
+    Compare(&errors[1], fixed_mean, (m * ref_mean) + b);
+    Compare(&errors[2], fixed_min, fmin(ref_lo, ref_hi));
+    Compare(&errors[2], fixed_max, fmax(ref_lo, ref_hi));
+    Compare(&errors[3], fixed_rms, sqrt(fmax(ref_mean_sq, 0.0)));
+  }
+}
+
+int main(void) {
+  printf("%-22s %10s %14s %14s\n", "conversion", "samples", "max abs",
+         "max rel");
+
+  // watermark ADC codes
+  Errors ss = {.name = "watermark ss kPa"};
+  Errors ts = {.name = "watermark ts C"};
+  for (uint32_t raw = 0; raw < (1 << 12); raw++) {
+    const double v = (double)raw * 3.3 / ((1 << 12) - 1);
+    const q32_t ss_fixed = CalibrationApply(
+        CalibrationGet(SensorType_WATERMARK200SS_SOIL_TENSION),
+        Q32FromInt(raw));
+    const q32_t ts_fixed = CalibrationApply(
+        CalibrationGet(SensorType_WATERMARK200TS_SOIL_TEMPERATURE),
+        Q32FromInt(raw));
+    Compare(&ss, Q32ToDouble(ss_fixed), v / 0.0117);
+    Compare(&ts, Q32ToDouble(ts_fixed),
+            ((50.68 * (v - 0.490) + 20) - 32) * 5.0 / 9.0);
+  }
+  Print(&ss);
+  Print(&ts);
+
+  // teros12 calibrated counts, 0.01 steps over the sensor range
+  Errors vwc = {.name = "teros12 vwc_adj %"};
+  for (int i = 100000; i <= 400000; i++) {
+    // parsed from the response like Teros12ParseMeasurement
+    char str[16];
+    snprintf(str, sizeof(str), "%d.%02d", i / 100, i % 100);
+    const char *s = str;
+    q32_t raw = 0;
+    ParseFixed(&s, &raw);
+
+    const q32_t fixed = CalibrationApply(
+        CalibrationGet(SensorType_TEROS12_VWC_ADJ), raw);
+    const double ref = ((3.879e-4 * (i / 100.0)) - 0.6956) * 100;
+    Compare(&vwc, Q32ToDouble(fixed), ref);
+  }
+  Print(&vwc);
+
+  // yfs210c pulses over 10 ms to 100 s
+  Errors flow = {.name = "yfs210c L/min"};
+  for (uint32_t pulses = 0; pulses <= 2000; pulses += 3) {
+    for (uint32_t ss = 1; ss <= 600000; ss = (ss * 5 / 4) + 1) {
+      const q32_t fixed =
+          CalibrationApply(CalibrationGet(SensorType_YFS210C_FLOW),
+                           Q32FromRatio(pulses, ss));
+      Compare(&flow, Q32ToDouble(fixed), (pulses / 7.5) / (ss / 6000.0));
+    }
+  }
+  Print(&flow);
+
+  // ads1219 with the DISABLE_CALIBRATION defaults
+  Errors ads_default[4] = {{.name = "ads voltage single"},
+                           {.name = "ads voltage mean"},
+                           {.name = "ads voltage min/max"},
+                           {.name = "ads voltage rms"}};
+  SweepAds(SensorType_POWER_VOLTAGE, 1.0 / 1000, 0, ads_default);
+  for (int i = 0; i < 4; i++) {
+    Print(&ads_default[i]);
+  }
+
+  // ads1219 with an example user calibration, set the way ADC_init does
+  const float slope = 0.000296f;
+  const float offset = -0.4387f;
+  const Calibration current_cal = {Q32FromFloat(slope), Q32FromFloat(offset)};
+  CalibrationSet(SensorType_POWER_CURRENT, &current_cal);
+
+  Errors ads_cal[4] = {{.name = "ads current single"},
+                       {.name = "ads current mean"},
+                       {.name = "ads current min/max"},
+                       {.name = "ads current rms"}};
+  SweepAds(SensorType_POWER_CURRENT, slope, offset, ads_cal);
+  for (int i = 0; i < 4; i++) {
+    Print(&ads_cal[i]);
+  }
+
+  return 0;
+}
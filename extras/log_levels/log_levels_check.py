@@ -0,0 +1,146 @@
+#!/usr/bin/env python
+"""Checks that logs above the threshold of a module are compiled out
+
+Builds log_module.c on the host with the real sys_app.h, log_conf.h and
+binlog.h at every APP_LOG_LEVEL, and with thresholds set for its own module
+and for another module. The objects are measured with log_report.py from
+stm32, the same way as the firmware. Exits with 1 if a check fails:
+
+- the flash of the module grows with every level
+- the format strings and argument functions of a level are in the object
+  exactly when the level is compiled
+- APP_LOG_LEVEL_SDI12 overrides APP_LOG_LEVEL for the module
+- APP_LOG_LEVEL_PCAP02 does not change the module
+
+    python log_levels_check.py
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+STM32 = os.path.join(HERE, "..", "..", "stm32")
+
+sys.path.insert(0, STM32)
+
+from log_report import LEVELS, format_report, measure  # noqa: E402
+
+CFLAGS = [
+    "-Os",
+    "-ffunction-sections",
+    "-fdata-sections",
+    "-fstack-usage",
+    "-I" + os.path.join(HERE, "..", "binlog", "host"),
+    "-I" + os.path.join(STM32, "Inc"),
+    "-I" + os.path.join(STM32, "lib", "binlog", "include"),
+]
+
+MODULES = {os.path.join("Src", "log_module.c"): "SDI12"}
+
+# format string and argument function of the calls at each level
+CALLS = {
+    "VLEVEL_OFF": [b"log_module always"],
+    "VLEVEL_L": [b"log_module error", b"LogLevelL"],
+    "VLEVEL_M": [b"log_module sum", b"log_module binlog", b"LogLevelM"],
+    "VLEVEL_H": [b"log_module data", b"log_module hex", b"LogLevelH"],
+}
+
+
+def build(build_dir: str, defines: list[str]) -> tuple[int, int, bytes]:
+    """Builds log_module.c into build_dir/src like PlatformIO.
+
+    Args:
+        build_dir: Build directory.
+        defines: Macros of the build.
+
+    Returns:
+        Flash, largest stack frame and contents of the object.
+    """
+
+    obj = os.path.join(build_dir, "src", "log_module.o")
+    os.makedirs(os.path.dirname(obj))
+    subprocess.run(
+        [
+            "gcc",
+            *CFLAGS,
+            *("-D" + d for d in defines),
+            "-c",
+            os.path.join(HERE, "log_module.c"),
+            "-o",
+            obj,
+        ],
+        check=True,
+    )
+    flash, stack = measure(build_dir, MODULES)["SDI12"]
+    with open(obj, "rb") as f:
+        return flash, stack, f.read()
+
+
+def main() -> int:
+    failures = []
+
+    def check(ok: bool, msg: str):
+        if not ok:
+            failures.append(msg)
+
+    with tempfile.TemporaryDirectory() as tmp:
+        results = {}
+        objs = {}
+        for level in LEVELS:
+            flash, stack, obj = build(
+                os.path.join(tmp, level), [f"APP_LOG_LEVEL={level}"]
+            )
+            results[level] = {"SDI12": (flash, stack)}
+            objs[level] = obj
+
+        module_off = build(
+            os.path.join(tmp, "module_off"),
+            ["APP_LOG_LEVEL=VLEVEL_H", "APP_LOG_LEVEL_SDI12=VLEVEL_OFF"],
+        )
+        other_off = build(
+            os.path.join(tmp, "other_off"),
+            ["APP_LOG_LEVEL=VLEVEL_H", "APP_LOG_LEVEL_PCAP02=VLEVEL_OFF"],
+        )
+
+    print(format_report(results))
+    print()
+    print(f"{'level':<12}{'flash':>10}{'stack':>10}")
+    for level in LEVELS:
+        flash, stack = results[level]["SDI12"]
+        print(f"{level:<12}{flash:>10}{stack:>10}")
+
+    for prev, level in zip(LEVELS, LEVELS[1:]):
+        check(
+            results[level]["SDI12"][0] > results[prev]["SDI12"][0],
+            f"flash of {level} is not above {prev}",
+        )
+
+    for i, threshold in enumerate(LEVELS):
+        for level in LEVELS:
+            compiled = LEVELS.index(level) <= i
+            for name in CALLS[level]:
+                check(
+                    (name in objs[threshold]) == compiled,
+                    f"{name.decode()} {'missing' if compiled else 'found'} "
+                    f"with APP_LOG_LEVEL={threshold}",
+                )
+
+    check(
+        module_off[2] == objs["VLEVEL_OFF"],
+        "APP_LOG_LEVEL_SDI12=VLEVEL_OFF differs from APP_LOG_LEVEL=VLEVEL_OFF",
+    )
+    check(
+        other_off[2] == objs["VLEVEL_H"],
+        "APP_LOG_LEVEL_PCAP02=VLEVEL_OFF changed the module",
+    )
+
+    for msg in failures:
+        print(f"FAIL: {msg}")
+    print(f"{len(failures)} failures")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,55 @@
+/**
+ * @file log_module.c
+ * @brief Module with logging at every level, measured by log_levels_check.py
+ *
+ * Logs the way the drivers do, with APP_LOG from sys_app.h and BINLOG from
+ * binlog.h. Each level has a call with a format string that is checked in
+ * the object and an argument from a function that is only called if the log
+ * is compiled.
+ *
+ * @date 2026-10-19
+ */
+
+#define APP_LOG_MODULE SDI12
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "binlog.h"
+#include "sys_app.h"
+
+/** Value logged at VLEVEL_L, only referenced by the compiled logs */
+int LogLevelL(void);
+
+/** Value logged at VLEVEL_M */
+int LogLevelM(void);
+
+/** Value logged at VLEVEL_H */
+int LogLevelH(void);
+
+int LogModuleMeasure(const uint8_t *data, size_t len) {
+  APP_LOG(TS_OFF, VLEVEL_ALWAYS, "log_module always\r\n");
+
+  int sum = 0;
+  for (size_t i = 0; i < len; i++) {
+    sum += data[i];
+  }
+
+  if (sum == 0) {
+    APP_LOG(TS_ON, VLEVEL_L, "log_module error %d\r\n", LogLevelL());
+    return -1;
+  }
+
+  APP_LOG(TS_ON, VLEVEL_M, "log_module sum %d of %d\r\n", sum, LogLevelM());
+  BINLOG(VLEVEL_M, "log_module binlog %d\r\n", sum);
+
+  APP_LOG(TS_OFF, VLEVEL_H, "log_module data (%u): ", (unsigned)len);
+  for (size_t i = 0; i < len; i++) {
+    APP_LOG(TS_OFF, VLEVEL_H, "%02X ", data[i]);
+  }
+  APP_LOG(TS_OFF, VLEVEL_H, "\r\n");
+  BINLOG(VLEVEL_H, "log_module hex %d: %H\r\n", LogLevelH(),
+         BINLOG_BLOB(data, len));
+
+  return sum;
+}
@@ -0,0 +1,238 @@
+/**
+ * @file rate_sim.c
+ * @brief Simulates the rate controller through an upload outage
+ *
+ * A node is stepped once a second for a number of days. Uploads fail during
+ * an outage at the start of the second day, so measurements pile up in the
+ * FRAM buffer. Each scenario is run with three builds:
+ *
+ * - fixed: uploads at the nominal period, as before the controller
+ * - nohyst: stm32/lib/rate without hysteresis, draining stops one measurement
+ *   below backlog_high
+ * - rate: stm32/lib/rate with the default config, as the firmware does now
+ *
+ * As in the firmware the controller is updated on every tx, a tx with an
+ * empty buffer sends nothing, a failed uplink keeps its measurement, and a
+ * measurement is lost when the buffer is full. The backlog counts as cleared
+ * once it is down to backlog_clear.
+ *
+ * Build and run from extras/rate:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/rate/include rate_sim.c \
+ *     ../../stm32/lib/rate/src/rate.c -o rate_sim
+ * ./rate_sim
+ * @endcode
+ *
+ * Pass -d for the simulated days (default 3), -o for the hours of the upload
+ * outage (default 12), -m and -u for the nominal measurement and tx periods in
+ * s (default 60 and 30), and -H, -C and -s for backlog_high, backlog_clear and
+ * drain_scale of the controller.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rate.h"
+
+/** Measurements that fit in the FRAM buffer */
+#define BUFFER_LEN 44
+
+/** Energy of an uplink in mJ, see extras/energy */
+#define UPLINK_MJ 38.7
+
+/** Seconds in a day */
+#define DAY_S 86400
+
+/** Scenario of a run */
+typedef struct {
+  /** Simulated days */
+  int days;
+  /** Hours without uploads at the start of the second day */
+  double outage_h;
+  /** Measurement period in s */
+  uint32_t measure_s;
+  /** Nominal tx period in s */
+  uint32_t upload_s;
+  /** Backlog at which the buffer counts as cleared after the outage */
+  uint32_t clear_backlog;
+} Scenario;
+
+/** Result of a run */
+typedef struct {
+  /** Measurements taken */
+  uint64_t measured;
+  /** Measurements uploaded */
+  uint64_t uploaded;
+  /** Measurements lost to a full buffer */
+  uint64_t dropped;
+  /** Uplinks sent */
+  uint64_t uplinks;
+  /** Uplinks sent during the outage */
+  uint64_t failed;
+  /** Seconds from the end of the outage until the backlog is cleared */
+  uint64_t clear_s;
+  /** Whether the backlog was cleared before the end of the run */
+  int cleared;
+  /** Sum of the age of uploaded measurements in s */
+  uint64_t age_s;
+  /** Largest backlog */
+  uint32_t peak_backlog;
+  /** Number of times the controller changed the rate */
+  uint32_t changes;
+} SimResult;
+
+/**
+ * @brief Run a scenario
+ *
+ * @param s Scenario
+ * @param config Thresholds of the controller, NULL for a fixed rate
+ * @param res Result
+ */
+static void Simulate(const Scenario *s, const RateConfig *config,
+                     SimResult *res) {
+  RateController rate;
+  if (config != NULL) {
+    RateInit(&rate, config);
+  }
+
+  // time each buffered measurement was taken, oldest first
+  uint64_t taken[BUFFER_LEN];
+  uint32_t backlog = 0;
+  uint64_t next_measure = s->measure_s;
+  uint64_t next_tx = s->upload_s;
+
+  *res = (SimResult){0};
+
+  const uint64_t duration = (uint64_t)s->days * DAY_S;
+  const uint64_t outage_start = DAY_S;
+  const uint64_t outage_end = DAY_S + (uint64_t)(s->outage_h * 3600);
+
+  for (uint64_t t = 0; t < duration; t++) {
+    if (t >= next_measure) {
+      res->measured++;
+      if (backlog < BUFFER_LEN) {
+        taken[backlog++] = t;
+      } else {
+        res->dropped++;
+      }
+      next_measure += s->measure_s;
+    }
+
+    if (t >= next_tx) {
+      uint64_t tx_period = s->upload_s;
+      if (config != NULL) {
+        if (RateUpdate(&rate, backlog)) {
+          res->changes++;
+        }
+        tx_period = RateUploadPeriod(&rate, s->upload_s);
+      }
+
+      const int outage = t >= outage_start && t < outage_end;
+      if (backlog > 0) {
+        res->uplinks++;
+        if (outage) {
+          res->failed++;
+        } else {
+          res->age_s += t - taken[0];
+          for (uint32_t i = 1; i < backlog; i++) {
+            taken[i - 1] = taken[i];
+          }
+          backlog--;
+          res->uploaded++;
+        }
+      }
+      next_tx = t + tx_period;
+    }
+
+    if (backlog > res->peak_backlog) {
+      res->peak_backlog = backlog;
+    }
+    if (!res->cleared && t >= outage_end && backlog <= s->clear_backlog) {
+      res->clear_s = t - outage_end;
+      res->cleared = 1;
+    }
+  }
+}
+
+static void PrintRow(const char *build, const SimResult *res, double days) {
+  char clear[16] = "never";
+  if (res->cleared) {
+    snprintf(clear, sizeof(clear), "%.1f", res->clear_s / 60.0);
+  }
+  printf("%-8s %9.0f %8lu %8lu %8s %8.1f %7u %7u %9.0f\n", build,
+         res->uplinks / days, (unsigned long)res->failed,
+         (unsigned long)res->dropped, clear,
+         res->uploaded ? res->age_s / 60.0 / res->uploaded : 0.0,
+         res->peak_backlog, res->changes, res->uplinks * UPLINK_MJ / days);
+}
+
+int main(int argc, char **argv) {
+  Scenario s = {3, 12, 60, 30, 0};
+  RateConfig config = RATE_CONFIG_DEFAULT;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "d:o:m:u:H:C:s:")) != -1) {
+    switch (opt) {
+      case 'd':
+        s.days = atoi(optarg);
+        break;
+      case 'o':
+        s.outage_h = atof(optarg);
+        break;
+      case 'm':
+        s.measure_s = (uint32_t)atoi(optarg);
+        break;
+      case 'u':
+        s.upload_s = (uint32_t)atoi(optarg);
+        break;
+      case 'H':
+        config.backlog_high = (uint16_t)atoi(optarg);
+        break;
+      case 'C':
+        config.backlog_clear = (uint16_t)atoi(optarg);
+        break;
+      case 's':
+        config.drain_scale = (uint16_t)atoi(optarg);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-d days] [-o outage_h] [-m measure_s] [-u tx_s]\n"
+                "       [-H backlog_high] [-C backlog_clear] "
+                "[-s drain_scale]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (s.days <= 1 || s.measure_s == 0 || s.upload_s == 0) {
+    fprintf(stderr, "days must be at least 2 and periods positive\n");
+    return 1;
+  }
+
+  s.clear_backlog = config.backlog_clear;
+
+  RateConfig nohyst = config;
+  nohyst.backlog_clear = nohyst.backlog_high - 1;
+
+  printf("%d days, %.0f h outage, measure %u s, tx %u s, drain at %u to %u "
+         "by %u%%\n\n",
+         s.days, s.outage_h, s.measure_s, s.upload_s, config.backlog_high,
+         config.backlog_clear, config.drain_scale);
+  printf("%-8s %9s %8s %8s %8s %8s %7s %7s %9s\n", "build", "uplink/d",
+         "failed", "dropped", "clear_m", "age_m", "backlog", "changes",
+         "tx_mJ/d");
+
+  const double days = s.days;
+  SimResult res;
+  Simulate(&s, NULL, &res);
+  PrintRow("fixed", &res, days);
+  Simulate(&s, &nohyst, &res);
+  PrintRow("nohyst", &res, days);
+  Simulate(&s, &config, &res);
+  PrintRow("rate", &res, days);
+
+  return 0;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file async_sim.c
+ * @brief Simulates the awake time of one measurement cycle
+ *
+ * The async queue from stm32/lib/sensors is run against a virtual clock with
+ * virtual drivers that model the bus timing of the ADS1219 and SDI-12 probes.
+ * The same sensors are then measured back to back the way the blocking
+ * drivers do, where the MCU is awake for every conversion and wait. Both
+ * timelines are printed with one character per bucket of time:
+ *
+ * - '#' the MCU is awake talking to a sensor
+ * - '.' a conversion is in progress and the MCU sleeps (async only)
+ *
+ * Each argument is a sensor, "ads" for an ADS1219 channel or "sdi:<ttt>" for
+ * an SDI-12 probe reporting ttt seconds in its aM! response. Every ADS1219
+ * channel shares the I2C device and every SDI-12 probe shares the bus.
+ *
+ * Build and run from extras/scheduling:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include async_sim.c \
+ *     ../../stm32/lib/sensors/src/async.c -o async_sim
+ * ./async_sim ads ads sdi:1 sdi:1
+ * @endcode
+ *
+ * Pass -b to change the width of a timeline bucket in ms (default 50).
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "async.h"
+
+/** Max length of the simulated cycle in ms */
+#define SIM_MAX_MS 20000
+
+/** I2C transfer to configure and start a conversion in ms */
+#define ADS_START_MS 1
+/** ADS1219 conversion at 20 SPS in ms */
+#define ADS_CONVERSION_MS 120
+/** I2C transfer to read and power down in ms */
+#define ADS_READ_MS 1
+
+/** Break and marking before a command in ms */
+#define SDI_WAKE_MS 21
+/** aM! and its "atttn<CR><LF>" response at 1200 baud in ms */
+#define SDI_MEASURE_MS 58
+/** aD0! and a ~30 character response at 1200 baud in ms */
+#define SDI_DATA_MS 290
+
+typedef enum {
+  SENSOR_ADS,
+  SENSOR_SDI,
+} SensorType;
+
+/** Virtual sensor passed as driver context */
+typedef struct {
+  SensorType type;
+  /** Reported measurement time of SDI-12 probes in ms */
+  uint32_t ttt;
+  /** Step of the measurement */
+  int step;
+} Sensor;
+
+/** Virtual time in ms */
+static uint32_t now;
+
+/** Awake buckets of the current timeline */
+static char timeline[SIM_MAX_MS];
+
+/** I2C device held by an ADS1219 conversion */
+static bool ads_busy;
+
+/** SDI-12 bus held by a measurement */
+static bool sdi_busy;
+
+/** Time the last measurement finished */
+static uint32_t finished;
+
+/**
+ * @brief Keeps the MCU awake for @p ms
+ */
+static void Awake(uint32_t ms) {
+  for (uint32_t t = now; t < now + ms && t < SIM_MAX_MS; t++) {
+    timeline[t] = '#';
+  }
+  now += ms;
+}
+
+/**
+ * @brief Marks a conversion in progress while the MCU sleeps
+ */
+static void Converting(uint32_t from, uint32_t ms) {
+  for (uint32_t t = from; t < from + ms && t < SIM_MAX_MS; t++) {
+    if (timeline[t] != '#') {
+      timeline[t] = '.';
+    }
+  }
+}
+
+static uint32_t Clock(void) { return now; }
+
+static void Done(uint8_t id, AsyncStatus status) {
+  (void)id;
+  (void)status;
+  finished = now;
+}
+
+static AsyncStatus Start(void *ctx, uint32_t *wait_ms) {
+  Sensor *sensor = ctx;
+  bool *bus = sensor->type == SENSOR_ADS ? &ads_busy : &sdi_busy;
+  if (*bus) {
+    return ASYNC_BUSY;
+  }
+  *bus = true;
+
+  sensor->step = 0;
+  if (sensor->type == SENSOR_ADS) {
+    Awake(ADS_START_MS);
+    *wait_ms = ADS_CONVERSION_MS;
+  } else {
+    // break, the probe needs the marking before the command
+    Awake(1);
+    *wait_ms = SDI_WAKE_MS;
+  }
+  Converting(now, *wait_ms);
+  return ASYNC_WAIT;
+}
+
+static AsyncStatus Poll(void *ctx, uint32_t *wait_ms) {
+  Sensor *sensor = ctx;
+
+  if (sensor->type == SENSOR_ADS) {
+    Awake(ADS_READ_MS);
+    ads_busy = false;
+    return ASYNC_DONE;
+  }
+
+  switch (sensor->step++) {
+    case 0:
+      // aM! and response, then sleep through the measurement
+      Awake(SDI_MEASURE_MS);
+      *wait_ms = sensor->ttt;
+      break;
+    case 1:
+      // break before aD0!
+      Awake(1);
+      *wait_ms = SDI_WAKE_MS;
+      break;
+    default:
+      Awake(SDI_DATA_MS);
+      sdi_busy = false;
+      return ASYNC_DONE;
+  }
+
+  Converting(now, *wait_ms);
+  return ASYNC_WAIT;
+}
+
+/** Virtual driver of both sensor types */
+static const AsyncDriver driver = {Start, Poll, NULL};
+
+/**
+ * @brief Measures the sensors one after another with busy waits
+ *
+ * @return Awake time in ms
+ */
+static uint32_t Blocking(const Sensor *sensors, size_t n) {
+  memset(timeline, ' ', sizeof(timeline));
+  now = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    if (sensors[i].type == SENSOR_ADS) {
+      Awake(ADS_START_MS + ADS_CONVERSION_MS + ADS_READ_MS);
+    } else {
+      Awake(SDI_WAKE_MS + SDI_MEASURE_MS + sensors[i].ttt + SDI_WAKE_MS +
+            SDI_DATA_MS);
+    }
+  }
+
+  finished = now;
+  return now;
+}
+
+/**
+ * @brief Measures the sensors with the async queue
+ *
+ * The MCU sleeps until AsyncNext whenever no step is due.
+ *
+ * @return Awake time in ms
+ */
+static uint32_t Async(Sensor *sensors, size_t n) {
+  static AsyncQueue queue;
+
+  memset(timeline, ' ', sizeof(timeline));
+  now = 0;
+  ads_busy = false;
+  sdi_busy = false;
+
+  AsyncInit(&queue);
+  for (size_t i = 0; i < n; i++) {
+    AsyncSubmit(&queue, &driver, &sensors[i], i);
+  }
+
+  uint32_t awake = 0;
+  uint32_t wake = 0;
+  do {
+    const uint32_t start = now;
+    AsyncRun(&queue, Clock, Done);
+    awake += now - start;
+
+    if (AsyncNext(&queue, &wake) && (int32_t)(wake - now) > 0) {
+      now = wake;
+    }
+  } while (queue.len > 0 && now < SIM_MAX_MS);
+
+  return awake;
+}
+
+static void PrintTimeline(const char *name, uint32_t bucket) {
+  printf("%-9s|", name);
+  for (uint32_t t = 0; t < finished && t < SIM_MAX_MS; t += bucket) {
+    // a bucket is awake if any ms in it is awake
+    char c = ' ';
+    for (uint32_t j = t; j < t + bucket && j < SIM_MAX_MS; j++) {
+      if (timeline[j] == '#') {
+        c = '#';
+        break;
+      }
+      if (timeline[j] == '.') {
+        c = '.';
+      }
+    }
+    putchar(c);
+  }
+  printf("|\n");
+}
+
+static void Usage(const char *name) {
+  fprintf(stderr, "usage: %s [-b bucket_ms] ads|sdi:<ttt>...\n", name);
+}
+
+int main(int argc, char **argv) {
+  uint32_t bucket = 50;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "b:")) != -1) {
+    switch (opt) {
+      case 'b':
+        bucket = (uint32_t)atoi(optarg);
+        break;
+      default:
+        Usage(argv[0]);
+        return 1;
+    }
+  }
+
+  const size_t n = argc - optind;
+  if (n == 0 || n > ASYNC_MAX_TASKS || bucket == 0) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  Sensor sensors[ASYNC_MAX_TASKS];
+  for (size_t i = 0; i < n; i++) {
+    const char *arg = argv[optind + i];
+    memset(&sensors[i], 0, sizeof(Sensor));
+    if (strcmp(arg, "ads") == 0) {
+      sensors[i].type = SENSOR_ADS;
+    } else if (strncmp(arg, "sdi:", 4) == 0) {
+      sensors[i].type = SENSOR_SDI;
+      sensors[i].ttt = (uint32_t)atoi(arg + 4) * 1000;
+    } else {
+      fprintf(stderr, "invalid sensor %s\n", arg);
+      return 1;
+    }
+  }
+
+  printf("%zu sensors, %u ms per character\n\n", n, bucket);
+
+  const uint32_t blocking_awake = Blocking(sensors, n);
+  const uint32_t blocking_total = finished;
+  PrintTimeline("blocking", bucket);
+
+  const uint32_t async_awake = Async(sensors, n);
+  const uint32_t async_total = finished;
+  PrintTimeline("async", bucket);
+
+  printf("\n%-9s %10s %10s\n", "", "cycle_ms", "awake_ms");
+  printf("%-9s %10u %10u\n", "blocking", blocking_total, blocking_awake);
+  printf("%-9s %10u %10u\n", "async", async_total, async_awake);
+
+  return 0;
+}
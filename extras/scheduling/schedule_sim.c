@@ -0,0 +1,202 @@
+/**
+ * @file schedule_sim.c
+ * @brief Simulates the sensor schedule and reports wakeups per hour
+ *
+ * Each argument is a sensor given as period[:phase] in seconds, the same
+ * values as the period and phase fields of EnabledSensorMultiple. The schedule
+ * from stm32/lib/sensors is run against a virtual clock where every measured
+ * sensor keeps the MCU awake for a fixed time. Results are compared against
+ * the alternatives:
+ *
+ * - global: one periodic timer at the gcd of all periods measuring every
+ *   sensor on each tick, the only way to honour different periods with a
+ *   single global measurement interval
+ * - separate: one timer per sensor, every deadline is its own wakeup unless
+ *   deadlines are identical
+ * - schedule: the min-heap with the coalescing window
+ *
+ * Build and run from extras/scheduling:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include schedule_sim.c \
+ *     ../../stm32/lib/sensors/src/schedule.c -o schedule_sim
+ * ./schedule_sim 60 60:0.5 300:30 900:2 3600:45
+ * @endcode
+ *
+ * Pass -w to change the coalescing window in ms (default SCHEDULE_WINDOW),
+ * -m for the awake time per measurement in ms (default 200) and -H for the
+ * simulated duration in hours (default 24).
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "schedule.h"
+
+/** Result of a simulation run */
+typedef struct {
+  /** Number of timer wakeups */
+  uint64_t wakeups;
+  /** Number of sensor measurements */
+  uint64_t measurements;
+  /** Time spent measuring in ms */
+  uint64_t awake_ms;
+  /** Largest time a sensor was measured before its deadline in ms */
+  uint32_t max_early_ms;
+  /** Largest time a sensor was measured after its deadline in ms */
+  uint32_t max_late_ms;
+} SimResult;
+
+static uint32_t Gcd(uint32_t a, uint32_t b) {
+  while (b != 0) {
+    const uint32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/**
+ * @brief Run the schedule over a virtual clock
+ *
+ * Deadlines are tracked separately from the schedule to measure how early or
+ * late each sensor was measured.
+ */
+static void Simulate(const uint32_t *period, const uint32_t *phase, size_t n,
+                     uint32_t window, uint32_t measure_ms, uint64_t duration,
+                     SimResult *res) {
+  static Schedule schedule;
+  uint64_t deadline[SCHEDULE_MAX_ENTRIES];
+  uint8_t ids[SCHEDULE_MAX_ENTRIES];
+
+  memset(res, 0, sizeof(*res));
+  ScheduleInit(&schedule, window);
+  for (size_t i = 0; i < n; i++) {
+    ScheduleAdd(&schedule, i, period[i], phase[i]);
+    deadline[i] = phase[i];
+  }
+
+  // 64-bit virtual time, the schedule only sees the lower 32 bits
+  uint64_t now = 0;
+  while (now < duration) {
+    const size_t count =
+        SchedulePopDue(&schedule, (uint32_t)now, ids, SCHEDULE_MAX_ENTRIES);
+
+    for (size_t j = 0; j < count; j++) {
+      const uint8_t i = ids[j];
+      // time the measurement completes
+      const uint64_t t = now + j * measure_ms;
+      if (t < deadline[i] && deadline[i] - t > res->max_early_ms) {
+        res->max_early_ms = deadline[i] - t;
+      }
+      if (t > deadline[i] && t - deadline[i] > res->max_late_ms) {
+        res->max_late_ms = t - deadline[i];
+      }
+      // first deadline after the window, the same as the schedule
+      while (deadline[i] <= now + window) {
+        deadline[i] += period[i];
+      }
+    }
+
+    res->wakeups++;
+    res->measurements += count;
+    res->awake_ms += count * measure_ms;
+
+    // measurements delay the next wakeup
+    const uint64_t busy_until = now + count * measure_ms;
+    uint32_t next = 0;
+    ScheduleNext(&schedule, &next);
+    const uint64_t due = now + (int32_t)(next - (uint32_t)now);
+    now = due > busy_until ? due : busy_until;
+  }
+}
+
+static void PrintRow(const char *name, double hours, double wakeups,
+                     double measurements, double awake_ms, uint32_t early,
+                     uint32_t late) {
+  printf("%-10s %10.1f %10.1f %10.1f %8u %8u\n", name, wakeups / hours,
+         measurements / hours, awake_ms / hours / 1000.0, early, late);
+}
+
+int main(int argc, char **argv) {
+  uint32_t window = SCHEDULE_WINDOW;
+  uint32_t measure_ms = 200;
+  double hours = 24;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "w:m:H:")) != -1) {
+    switch (opt) {
+      case 'w':
+        window = (uint32_t)atoi(optarg);
+        break;
+      case 'm':
+        measure_ms = (uint32_t)atoi(optarg);
+        break;
+      case 'H':
+        hours = atof(optarg);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-w window_ms] [-m measure_ms] [-H hours] "
+                "period[:phase]...\n",
+                argv[0]);
+        return 1;
+    }
+  }
+
+  const size_t n = argc - optind;
+  if (n == 0 || n > SCHEDULE_MAX_ENTRIES || hours <= 0) {
+    fprintf(stderr,
+            "usage: %s [-w window_ms] [-m measure_ms] [-H hours] "
+            "period[:phase]...\n",
+            argv[0]);
+    return 1;
+  }
+
+  uint32_t period[SCHEDULE_MAX_ENTRIES];
+  uint32_t phase[SCHEDULE_MAX_ENTRIES];
+  for (size_t i = 0; i < n; i++) {
+    char *end = NULL;
+    period[i] = (uint32_t)(strtod(argv[optind + i], &end) * 1000);
+    phase[i] = 0;
+    if (*end == ':') {
+      phase[i] = (uint32_t)(strtod(end + 1, &end) * 1000);
+    }
+    if (*end != '\0' || period[i] == 0 || period[i] > SCHEDULE_MAX_PERIOD) {
+      fprintf(stderr, "invalid sensor %s\n", argv[optind + i]);
+      return 1;
+    }
+  }
+
+  const uint64_t duration = (uint64_t)(hours * 3600000);
+
+  // a single periodic timer can not honour the phases, they are ignored
+  uint32_t gcd = period[0];
+  for (size_t i = 1; i < n; i++) {
+    gcd = Gcd(gcd, period[i]);
+  }
+  const double global_wakeups = (double)duration / gcd;
+
+  SimResult separate;
+  Simulate(period, phase, n, 0, 0, duration, &separate);
+
+  SimResult sched;
+  Simulate(period, phase, n, window, measure_ms, duration, &sched);
+
+  printf("%zu sensors, %.1f h, window %u ms, %u ms per measurement\n\n", n,
+         hours, window, measure_ms);
+  printf("%-10s %10s %10s %10s %8s %8s\n", "", "wakeup/h", "meas/h",
+         "awake_s/h", "early", "late");
+  PrintRow("global", hours, global_wakeups, global_wakeups * n,
+           global_wakeups * n * measure_ms, 0, 0);
+  PrintRow("separate", hours, separate.wakeups, separate.measurements,
+           (double)separate.measurements * measure_ms, 0, 0);
+  PrintRow("schedule", hours, sched.wakeups, sched.measurements,
+           sched.awake_ms, sched.max_early_ms, sched.max_late_ms);
+
+  return 0;
+}
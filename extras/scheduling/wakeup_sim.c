@@ -0,0 +1,321 @@
+/**
+ * @file wakeup_sim.c
+ * @brief Simulates coalescing the timers of the node and reports wakeups per
+ * day
+ *
+ * The measurement, LoRaWAN tx and WiFi upload timers are armed from different
+ * modules with independent phases. Each typical configuration is run twice
+ * against a virtual clock in ms:
+ *
+ * - separate: every timer is periodic with its own phase, as before the
+ *   coalescer. Timers restarted from their callback, the tx timer and the
+ *   periodic UTIL_TIMERs, drift by the latency of the timer interrupt on
+ *   every period
+ * - coalesced: every timer is rearmed through stm32/lib/wakeup with the
+ *   slack. The measurement timer is armed with WakeupAt for the next deadline
+ *   of the sensor schedule, the others with WakeupPeriod
+ * - firmware: as coalesced, with the slack capped by WakeupSetMaxSlack as
+ *   main.c does for the upload method, 0 for LoRaWAN
+ *
+ * A wakeup keeps the mcu awake for a fixed overhead plus the time of every
+ * task it runs. Deadlines that fall while the mcu is awake run in the same
+ * awake period. An uplink is followed by the two class A receive windows,
+ * which are opened by the LoRaWAN stack and are never coalesced.
+ *
+ * Build and run from extras/scheduling:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/wakeup/include wakeup_sim.c \
+ *     ../../stm32/lib/wakeup/src/wakeup.c -o wakeup_sim
+ * ./wakeup_sim
+ * @endcode
+ *
+ * Pass -g for the grid in ms (default WAKEUP_GRID), -s for the slack in ms
+ * (default WAKEUP_SLACK), -w for the overhead of a wakeup in ms (default 2),
+ * -d for the drift of a restarted timer per period in ms (default 1), -H for
+ * the simulated duration in hours (default 24) and -r for the seed of the
+ * random phases.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wakeup.h"
+
+/** Max number of timers in a configuration */
+#define MAX_TIMERS 4
+
+/** Receive windows after an uplink, RECEIVE_DELAY1 and 2 of the stack */
+#define RX_WINDOWS 2
+
+/** Delay of the first receive window in ms, the second is twice this */
+#define RX_DELAY_MS 1000
+
+/** Time a receive window keeps the mcu awake in ms */
+#define RX_AWAKE_MS 30
+
+/** Periodic timer of a task */
+typedef struct {
+  /** Name of the task */
+  const char *name;
+  /** Period in ms */
+  uint32_t period;
+  /** Time the task keeps the mcu awake in ms */
+  uint32_t awake_ms;
+  /** Task sends a LoRaWAN uplink */
+  int uplink;
+  /** Timer is restarted from its callback, drifts when separate and uses
+   * WakeupPeriod when coalesced */
+  int restarted;
+} SimTimer;
+
+/** Typical configuration of the node */
+typedef struct {
+  /** Name of the configuration */
+  const char *name;
+  /** Timers */
+  SimTimer timers[MAX_TIMERS];
+  /** Number of timers */
+  size_t len;
+  /** Max slack the firmware allows for the upload method in ms */
+  uint32_t max_slack;
+} SimConfig;
+
+/** Result of a simulation run */
+typedef struct {
+  /** Number of wakeups */
+  uint64_t wakeups;
+  /** Number of tasks run */
+  uint64_t tasks;
+  /** Time awake in ms */
+  uint64_t awake_ms;
+  /** Largest time a task ran after its nominal deadline in ms */
+  uint32_t max_late_ms;
+} SimResult;
+
+/**
+ * @brief Typical configurations
+ *
+ * Tx runs every Upload_interval / (sensors + 1) / 2 as set in SendTxData. A
+ * measurement blocks for 120 ms in the ADS1219 driver, an uplink transmits
+ * for about 92 ms and a WiFi upload waits a second for the response.
+ */
+static const SimConfig configs[] = {
+    {"lora 60 s",
+     {{"measure", 60000, 128, 0, 0}, {"tx", 15000, 110, 1, 1}},
+     2,
+     0},
+    {"lora 300 s 3 sensors",
+     {{"measure", 300000, 384, 0, 0}, {"tx", 37500, 110, 1, 1}},
+     2,
+     0},
+    {"lora 900 s",
+     {{"measure", 900000, 128, 0, 0}, {"tx", 225000, 110, 1, 1}},
+     2,
+     0},
+    {"wifi 60 s",
+     {{"measure", 60000, 128, 0, 0}, {"upload", 60000, 1100, 0, 1}},
+     2,
+     UINT32_MAX},
+    {"wifi 300 s",
+     {{"measure", 300000, 128, 0, 0}, {"upload", 300000, 1100, 0, 1}},
+     2,
+     UINT32_MAX},
+};
+
+/** Time of the virtual clock in ms */
+static uint64_t now = 0;
+
+/** Virtual clock, the coalescer only sees the lower 32 bits */
+static uint32_t Clock(void) { return (uint32_t)now; }
+
+/**
+ * @brief Run a configuration over a virtual clock
+ *
+ * @param config Configuration
+ * @param coalesce Rearm the timers through the coalescer
+ * @param phase First deadline of each timer in ms
+ * @param grid Grid of the coalescer in ms
+ * @param slack Slack of every timer in ms
+ * @param max_slack Cap of the slack passed to WakeupSetMaxSlack in ms
+ * @param wake_ms Overhead of a wakeup in ms
+ * @param drift_ms Drift of a restarted timer per period in ms
+ * @param duration Simulated time in ms
+ * @param res Result
+ */
+static void Simulate(const SimConfig *config, int coalesce,
+                     const uint32_t *phase, uint32_t grid, uint32_t slack,
+                     uint32_t max_slack, uint32_t wake_ms, uint32_t drift_ms,
+                     uint64_t duration, SimResult *res) {
+  uint64_t fire[MAX_TIMERS];
+  uint64_t nominal[MAX_TIMERS];
+  // receive windows still to open
+  uint64_t rx[MAX_TIMERS * RX_WINDOWS];
+  size_t rx_len = 0;
+
+  memset(res, 0, sizeof(*res));
+  now = 0;
+  WakeupInit(Clock, grid);
+  WakeupSetMaxSlack(max_slack);
+  for (size_t i = 0; i < config->len; i++) {
+    nominal[i] = phase[i];
+    fire[i] = coalesce ? WakeupAt(i, phase[i], slack) : phase[i];
+  }
+
+  for (;;) {
+    // earliest timer or receive window
+    uint64_t next = UINT64_MAX;
+    for (size_t i = 0; i < config->len; i++) {
+      if (fire[i] < next) {
+        next = fire[i];
+      }
+    }
+    for (size_t j = 0; j < rx_len; j++) {
+      if (rx[j] < next) {
+        next = rx[j];
+      }
+    }
+    if (next >= duration) {
+      break;
+    }
+
+    res->wakeups++;
+    uint64_t awake_until = next + wake_ms;
+
+    // run everything due until the mcu goes back to sleep
+    for (int ran = 1; ran;) {
+      ran = 0;
+      for (size_t i = 0; i < config->len; i++) {
+        if (fire[i] > awake_until) {
+          continue;
+        }
+        const SimTimer *timer = &config->timers[i];
+        const uint64_t start = awake_until;
+        if (start - nominal[i] > res->max_late_ms) {
+          res->max_late_ms = start - nominal[i];
+        }
+
+        // rearmed in the timer callback, when the timer fired
+        now = fire[i];
+        if (coalesce) {
+          nominal[i] += timer->period;
+          fire[i] = now + (timer->restarted
+                               ? WakeupPeriod(i, timer->period, slack)
+                               : WakeupAt(i, nominal[i], slack));
+        } else {
+          fire[i] += timer->period + (timer->restarted ? drift_ms : 0);
+          nominal[i] = fire[i];
+        }
+
+        awake_until += timer->awake_ms;
+        res->tasks++;
+        ran = 1;
+
+        if (timer->uplink && rx_len + RX_WINDOWS <= MAX_TIMERS * RX_WINDOWS) {
+          for (int w = 1; w <= RX_WINDOWS; w++) {
+            rx[rx_len++] = start + w * RX_DELAY_MS;
+          }
+        }
+      }
+      for (size_t j = 0; j < rx_len;) {
+        if (rx[j] > awake_until) {
+          j++;
+          continue;
+        }
+        awake_until += RX_AWAKE_MS;
+        rx[j] = rx[--rx_len];
+        ran = 1;
+      }
+    }
+
+    res->awake_ms += awake_until - next;
+  }
+}
+
+static void PrintRow(const char *config, const char *build, double days,
+                     const SimResult *res) {
+  printf("%-22s %-10s %12.1f %12.1f %10.1f %8u\n", config, build,
+         res->wakeups / days, res->tasks / days, res->awake_ms / days / 1000.0,
+         res->max_late_ms);
+}
+
+int main(int argc, char **argv) {
+  uint32_t grid = WAKEUP_GRID;
+  uint32_t slack = WAKEUP_SLACK;
+  uint32_t wake_ms = 2;
+  uint32_t drift_ms = 1;
+  double hours = 24;
+  unsigned int seed = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "g:s:w:d:H:r:")) != -1) {
+    switch (opt) {
+      case 'g':
+        grid = (uint32_t)atoi(optarg);
+        break;
+      case 's':
+        slack = (uint32_t)atoi(optarg);
+        break;
+      case 'w':
+        wake_ms = (uint32_t)atoi(optarg);
+        break;
+      case 'd':
+        drift_ms = (uint32_t)atoi(optarg);
+        break;
+      case 'H':
+        hours = atof(optarg);
+        break;
+      case 'r':
+        seed = (unsigned int)atoi(optarg);
+        break;
+      default:
+        fprintf(stderr,
+                "usage: %s [-g grid_ms] [-s slack_ms] [-w wake_ms] "
+                "[-d drift_ms] [-H hours] [-r seed]\n",
+                argv[0]);
+        return 1;
+    }
+  }
+  if (hours <= 0) {
+    fprintf(stderr, "hours must be positive\n");
+    return 1;
+  }
+
+  const uint64_t duration = (uint64_t)(hours * 3600000);
+  const double days = hours / 24;
+  srand(seed);
+
+  printf("%.1f h, grid %u ms, slack %u ms, %u ms per wakeup, %u ms drift\n\n",
+         hours, grid, slack, wake_ms, drift_ms);
+  printf("%-22s %-10s %12s %12s %10s %8s\n", "config", "build", "wakeup/day",
+         "tasks/day", "awake_s/d", "late");
+  for (size_t c = 0; c < sizeof(configs) / sizeof(configs[0]); c++) {
+    const SimConfig *config = &configs[c];
+
+    // timers are started from different tasks up to the slack apart
+    uint32_t phase[MAX_TIMERS];
+    for (size_t i = 0; i < config->len; i++) {
+      phase[i] = config->timers[i].period + rand() % (slack + 1);
+    }
+
+    SimResult separate;
+    Simulate(config, 0, phase, grid, slack, UINT32_MAX, wake_ms, drift_ms,
+             duration, &separate);
+    SimResult coalesced;
+    Simulate(config, 1, phase, grid, slack, UINT32_MAX, wake_ms, drift_ms,
+             duration, &coalesced);
+    SimResult firmware;
+    Simulate(config, 1, phase, grid, slack, config->max_slack, wake_ms,
+             drift_ms, duration, &firmware);
+
+    PrintRow(config->name, "separate", days, &separate);
+    PrintRow("", "coalesced", days, &coalesced);
+    PrintRow("", "firmware", days, &firmware);
+  }
+
+  return 0;
+}
@@ -0,0 +1,326 @@
+/**
+ * @file bus_model.c
+ *
+ * @see bus_model.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "bus_model.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "lowpower.h"
+#include "sdi12.h"
+#include "stm32_lpm.h"
+#include "usart.h"
+
+/** Time of a character at 1200 baud in us */
+#define CHAR_US 8333
+/** Break length in us */
+#define BREAK_US 12000
+/** Delay of a probe before answering in us */
+#define RESPONSE_DELAY_US 8000
+
+static DMA_HandleTypeDef hdma_lpuart1_rx;
+UART_HandleTypeDef hlpuart1 = {&hdma_lpuart1_rx};
+GPIO_TypeDef sdi12_dir_port;
+
+static BusProbe probes[BUS_MAX_PROBES];
+static int probes_len;
+
+/** Virtual time in us */
+static uint64_t now;
+
+/** Time the last break started, 0 if none */
+static uint64_t last_break;
+
+/** Time spent on the UART in us */
+static uint64_t active;
+
+/** Time spent in low power waits in us */
+static uint64_t low_power;
+
+/** DMA receive waiting for its idle event */
+static struct {
+  UART_HandleTypeDef *huart;
+  const uint8_t *data;
+  uint16_t size;
+  /** Time of the idle event in us */
+  uint64_t done_at;
+  bool pending;
+} rx;
+
+/** Response to the last command */
+static char response[SDI12_LINE_SIZE];
+
+static int not_awake;
+static bool trace;
+
+void BusReset(void) {
+  memset(probes, 0, sizeof(probes));
+  probes_len = 0;
+  now = 1000;
+  last_break = 0;
+  active = 0;
+  low_power = 0;
+  rx.pending = false;
+  response[0] = '\0';
+  not_awake = 0;
+}
+
+bool BusAddProbe(char addr, uint16_t ttt, const char *data) {
+  if (probes_len >= BUS_MAX_PROBES) {
+    return false;
+  }
+
+  BusProbe *probe = &probes[probes_len++];
+  probe->addr = addr;
+  probe->ttt = ttt;
+  snprintf(probe->data, sizeof(probe->data), "%s", data);
+  return true;
+}
+
+BusProbe *BusProbeGet(char addr) {
+  for (int i = 0; i < probes_len; i++) {
+    if (probes[i].addr == addr) {
+      return &probes[i];
+    }
+  }
+  return NULL;
+}
+
+uint32_t BusClock(void) { return (uint32_t)(now / 1000); }
+
+void BusSleepUntil(uint32_t ms) {
+  const uint64_t t = (uint64_t)ms * 1000;
+  if (t > now) {
+    now = t;
+  }
+}
+
+uint32_t BusActiveTime(void) { return (uint32_t)(active / 1000); }
+
+uint32_t BusLowPowerTime(void) { return (uint32_t)(low_power / 1000); }
+
+int BusNotAwake(void) { return not_awake; }
+
+void BusTrace(bool enable) { trace = enable; }
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state) {
+  (void)port;
+  (void)pin;
+  (void)state;
+}
+
+HAL_StatusTypeDef HAL_LIN_SendBreak(UART_HandleTypeDef *huart) {
+  (void)huart;
+
+  last_break = now;
+  for (int i = 0; i < probes_len; i++) {
+    BusProbe *probe = &probes[i];
+    if (probe->ready != 0 && !probe->concurrent && now < probe->ready) {
+      probe->ready = 0;
+      probe->aborted++;
+    }
+  }
+
+  if (trace) {
+    printf("%8.1f break\n", now / 1000.0);
+  }
+
+  return HAL_OK;
+}
+
+/**
+ * @brief Answer a command as the addressed probe
+ */
+static void Respond(const char *cmd) {
+  response[0] = '\0';
+
+  BusProbe *probe = BusProbeGet(cmd[0]);
+  if (probe == NULL) {
+    return;
+  }
+
+  const char *op = cmd + 1;
+  // a measurement ends when the probe reports it or the data is requested
+  const uint64_t measure_end = now + (uint64_t)probe->ttt * 1000000;
+  if (strcmp(op, "M!") == 0 || strcmp(op, "MC!") == 0) {
+    snprintf(response, sizeof(response), "%c%03u%u\r\n", probe->addr,
+             probe->ttt, 3u);
+    probe->ready = measure_end;
+    probe->concurrent = false;
+    probe->crc = op[1] == 'C';
+  } else if (strcmp(op, "C!") == 0 || strcmp(op, "CC!") == 0) {
+    snprintf(response, sizeof(response), "%c%03u%02u\r\n", probe->addr,
+             probe->ttt, 3u);
+    probe->ready = measure_end;
+    probe->concurrent = true;
+    probe->crc = op[1] == 'C';
+  } else if (strcmp(op, "D0!") == 0) {
+    if (probe->ready != 0 && now >= probe->ready) {
+      int len = snprintf(response, sizeof(response), "%c%s", probe->addr,
+                         probe->data);
+      if (probe->crc) {
+        const uint16_t crc = SDI12Crc(response, len);
+        response[len++] = 0x40 | (crc >> 12);
+        response[len++] = 0x40 | ((crc >> 6) & 0x3F);
+        response[len++] = 0x40 | (crc & 0x3F);
+      }
+      // flip a bit like noise on the bus
+      if (probe->corrupt > 0) {
+        probe->corrupt--;
+        response[1] ^= 0x01;
+      }
+      snprintf(response + len, sizeof(response) - len, "\r\n");
+    } else {
+      snprintf(response, sizeof(response), "%c\r\n", probe->addr);
+      probe->empty++;
+    }
+    probe->ready = 0;
+  }
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *data, uint16_t size,
+                                    uint32_t timeout) {
+  (void)huart;
+  (void)timeout;
+
+  char cmd[16] = {};
+  memcpy(cmd, data, size < sizeof(cmd) - 1 ? size : sizeof(cmd) - 1);
+
+  const bool awake =
+      last_break != 0 && now >= last_break + BREAK_US + CHAR_US;
+  now += (uint64_t)size * CHAR_US;
+  active += (uint64_t)size * CHAR_US;
+  last_break = 0;
+
+  if (trace) {
+    printf("%8.1f -> %s%s\n", now / 1000.0, cmd, awake ? "" : " (asleep)");
+  }
+
+  if (awake) {
+    Respond(cmd);
+  } else {
+    not_awake++;
+    response[0] = '\0';
+  }
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *data,
+                                   uint16_t size, uint32_t timeout) {
+  (void)huart;
+
+  const size_t len = strlen(response);
+  const uint64_t start = now;
+  HAL_StatusTypeDef ret = HAL_OK;
+
+  if (len >= size) {
+    memcpy(data, response, size);
+    now += RESPONSE_DELAY_US + (uint64_t)size * CHAR_US;
+  } else {
+    // blocks until the timeout when fewer characters arrive
+    memcpy(data, response, len);
+    now += (uint64_t)timeout * 1000;
+    ret = HAL_TIMEOUT;
+  }
+  active += now - start;
+
+  if (trace) {
+    printf("%8.1f <- %.*s%s\n", now / 1000.0, (int)strcspn(response, "\r"),
+           response, ret == HAL_TIMEOUT ? " (timeout)" : "");
+  }
+  response[0] = '\0';
+
+  return ret;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+                                               uint8_t *data, uint16_t size) {
+  const size_t len = strlen(response);
+  if (len == 0) {
+    // nothing arrives, the caller times out
+    return HAL_OK;
+  }
+
+  const uint16_t received = len < size ? len : size;
+  memcpy(data, response, received);
+  memmove(response, response + received, len - received + 1);
+
+  // the idle event fires one character after the last one, the caller waits
+  // for it
+  const uint64_t duration =
+      RESPONSE_DELAY_US + ((uint64_t)received + 1) * CHAR_US;
+  active += duration;
+
+  rx.huart = huart;
+  rx.data = data;
+  rx.size = received;
+  rx.done_at = now + duration;
+  rx.pending = true;
+
+  return HAL_OK;
+}
+
+/**
+ * @brief Fire the idle event of a DMA receive once its time has come
+ */
+static void CompleteReceive(void) {
+  if (!rx.pending || now < rx.done_at) {
+    return;
+  }
+  rx.pending = false;
+
+  if (trace) {
+    int shown = 0;
+    while (shown < rx.size && rx.data[shown] != '\r') {
+      shown++;
+    }
+    printf("%8.1f <- %.*s (idle)\n", rx.done_at / 1000.0, shown,
+           (const char *)rx.data);
+  }
+
+  HAL_UARTEx_RxEventCallback(rx.huart, rx.size);
+}
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart) {
+  (void)huart;
+  response[0] = '\0';
+  rx.pending = false;
+  return HAL_OK;
+}
+
+void LowPowerDelay(uint32_t ms) {
+  now += (uint64_t)ms * 1000;
+  low_power += (uint64_t)ms * 1000;
+  CompleteReceive();
+}
+
+bool LowPowerWaitFor(volatile const bool *flag, uint32_t timeout_ms) {
+  // sleep until the idle event of the receive or the timeout
+  const uint64_t timeout = now + (uint64_t)timeout_ms * 1000;
+  const uint64_t until =
+      (rx.pending && rx.done_at < timeout) ? rx.done_at : timeout;
+  if (!*flag && until > now) {
+    low_power += until - now;
+    now = until;
+    CompleteReceive();
+  }
+  return *flag;
+}
+
+void UTIL_LPM_SetStopMode(UTIL_LPM_bm_t lpm_id_bm, UTIL_LPM_State_t state) {
+  (void)lpm_id_bm;
+  (void)state;
+}
+
+uint32_t HAL_GetTick(void) {
+  now += 1000;
+  CompleteReceive();
+  return BusClock();
+}
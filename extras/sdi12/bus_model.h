@@ -0,0 +1,106 @@
+/**
+ * @file bus_model.h
+ * @brief Virtual SDI-12 bus with scripted probes
+ *
+ * Implements the UART and GPIO functions used by stm32/lib/sdi12 against a
+ * virtual clock. Every character on the bus takes 8.33 ms (1200 baud, 10
+ * bits). Probes follow the parts of SDI-12 v1.4 used by the library:
+ *
+ * - commands are ignored unless a break and 8.33 ms of marking preceded them
+ * - aM! and aC! answer "atttn" and "atttnn" and measure for ttt seconds,
+ *   aMC! and aCC! add a CRC to the data
+ * - aD0! answers the scripted data when the measurement finished, otherwise
+ *   just the address
+ * - a break aborts an aM! measurement, aC! measurements continue
+ *
+ * A read shorter than the requested size blocks for the full timeout, the
+ * same as HAL_UART_Receive. A DMA receive to idle completes one character
+ * time after the last character, once the caller waited that long.
+ * HAL_GetTick advances the clock by 1 ms per call to model a busy wait.
+ * LowPowerDelay and LowPowerWaitFor advance it by the time waited, which is
+ * counted as low power.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef EXTRAS_SDI12_BUS_MODEL_H_
+#define EXTRAS_SDI12_BUS_MODEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** Max number of probes on the bus */
+#define BUS_MAX_PROBES 10
+
+/** Virtual probe */
+typedef struct {
+  /** Address */
+  char addr;
+  /** Measurement time in s reported by aM! and aC! */
+  uint16_t ttt;
+  /** Response to aD0!, without the address and CRLF */
+  char data[76];
+  /** Time the measurement finishes in us, 0 if not measuring */
+  uint64_t ready;
+  /** A measurement was started with aC! */
+  bool concurrent;
+  /** The data of the measurement includes a CRC */
+  bool crc;
+  /** Number of data responses to corrupt */
+  int corrupt;
+  /** Number of aM! measurements aborted by a break */
+  int aborted;
+  /** Number of aD0! answered without data */
+  int empty;
+} BusProbe;
+
+/**
+ * @brief Remove all probes and reset the clock
+ */
+void BusReset(void);
+
+/**
+ * @brief Add a probe to the bus
+ *
+ * @return false if the bus is full
+ */
+bool BusAddProbe(char addr, uint16_t ttt, const char *data);
+
+/**
+ * @brief Get the probe with an address
+ *
+ * @return NULL if no probe has the address
+ */
+BusProbe *BusProbeGet(char addr);
+
+/**
+ * @brief Current virtual time in ms
+ */
+uint32_t BusClock(void);
+
+/**
+ * @brief Sleep until @p ms
+ */
+void BusSleepUntil(uint32_t ms);
+
+/**
+ * @brief Time in ms the UART spent transmitting or receiving
+ */
+uint32_t BusActiveTime(void);
+
+/**
+ * @brief Time in ms spent in LowPowerDelay and LowPowerWaitFor
+ */
+uint32_t BusLowPowerTime(void);
+
+/**
+ * @brief Number of commands sent without waking the probes first
+ */
+int BusNotAwake(void);
+
+/**
+ * @brief Print every command and response with its time
+ */
+void BusTrace(bool enable);
+
+#endif  // EXTRAS_SDI12_BUS_MODEL_H_
@@ -0,0 +1,6 @@
+/**
+ * @file gpio.h
+ * @brief Host stand-in, see main.h
+ */
+
+#include "main.h"
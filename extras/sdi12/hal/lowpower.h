@@ -0,0 +1,18 @@
+/**
+ * @file lowpower.h
+ * @brief Host stand-in for stm32/lib/lowpower
+ *
+ * The waits advance the virtual clock of the bus model, see bus_model.h.
+ */
+
+#ifndef EXTRAS_SDI12_HAL_LOWPOWER_H_
+#define EXTRAS_SDI12_HAL_LOWPOWER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+void LowPowerDelay(uint32_t ms);
+
+bool LowPowerWaitFor(volatile const bool *flag, uint32_t timeout_ms);
+
+#endif  // EXTRAS_SDI12_HAL_LOWPOWER_H_
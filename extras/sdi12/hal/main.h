@@ -0,0 +1,38 @@
+/**
+ * @file main.h
+ * @brief Host stand-in for the HAL types used by the SDI-12 library
+ *
+ * Only what stm32/lib/sdi12/src/sdi12.c needs to build against the bus model.
+ */
+
+#ifndef EXTRAS_SDI12_HAL_MAIN_H_
+#define EXTRAS_SDI12_HAL_MAIN_H_
+
+#include <stdint.h>
+
+typedef enum {
+  HAL_OK = 0x00,
+  HAL_ERROR = 0x01,
+  HAL_BUSY = 0x02,
+  HAL_TIMEOUT = 0x03,
+} HAL_StatusTypeDef;
+
+typedef enum {
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET,
+} GPIO_PinState;
+
+typedef struct {
+  int unused;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef sdi12_dir_port;
+
+#define SDI12_DIR_GPIO_Port (&sdi12_dir_port)
+#define SDI12_DIR_Pin 0
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+uint32_t HAL_GetTick(void);
+
+#endif  // EXTRAS_SDI12_HAL_MAIN_H_
@@ -0,0 +1,20 @@
+/**
+ * @file stm32_lpm.h
+ * @brief Host stand-in for the UTIL_LPM calls of the SDI-12 library
+ */
+
+#ifndef EXTRAS_SDI12_HAL_STM32_LPM_H_
+#define EXTRAS_SDI12_HAL_STM32_LPM_H_
+
+#include <stdint.h>
+
+typedef uint32_t UTIL_LPM_bm_t;
+
+typedef enum {
+  UTIL_LPM_ENABLE = 0,
+  UTIL_LPM_DISABLE,
+} UTIL_LPM_State_t;
+
+void UTIL_LPM_SetStopMode(UTIL_LPM_bm_t lpm_id_bm, UTIL_LPM_State_t state);
+
+#endif  // EXTRAS_SDI12_HAL_STM32_LPM_H_
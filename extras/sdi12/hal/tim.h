@@ -0,0 +1,6 @@
+/**
+ * @file tim.h
+ * @brief Host stand-in, see main.h
+ */
+
+#include "main.h"
@@ -0,0 +1,41 @@
+/**
+ * @file usart.h
+ * @brief Host stand-in for the SDI-12 UART, implemented by the bus model
+ */
+
+#ifndef EXTRAS_SDI12_HAL_USART_H_
+#define EXTRAS_SDI12_HAL_USART_H_
+
+#include "main.h"
+
+typedef struct {
+  int unused;
+} DMA_HandleTypeDef;
+
+typedef struct {
+  DMA_HandleTypeDef *hdmarx;
+} UART_HandleTypeDef;
+
+extern UART_HandleTypeDef hlpuart1;
+
+#define __HAL_UART_FLUSH_DRREGISTER(handle) ((void)(handle))
+#define __HAL_DMA_DISABLE_IT(handle, it) ((void)(handle))
+#define DMA_IT_HT 0
+
+HAL_StatusTypeDef HAL_LIN_SendBreak(UART_HandleTypeDef *huart);
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *data, uint16_t size,
+                                    uint32_t timeout);
+
+HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *data,
+                                   uint16_t size, uint32_t timeout);
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+                                               uint8_t *data, uint16_t size);
+
+HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart);
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+
+#endif  // EXTRAS_SDI12_HAL_USART_H_
@@ -0,0 +1,13 @@
+/**
+ * @file utilities_def.h
+ * @brief Host stand-in, see stm32_lpm.h
+ */
+
+#ifndef EXTRAS_SDI12_HAL_UTILITIES_DEF_H_
+#define EXTRAS_SDI12_HAL_UTILITIES_DEF_H_
+
+typedef enum {
+  CFG_LPM_SDI12_Id,
+} CFG_LPM_Id_t;
+
+#endif  // EXTRAS_SDI12_HAL_UTILITIES_DEF_H_
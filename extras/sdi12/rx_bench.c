@@ -0,0 +1,119 @@
+/**
+ * @file rx_bench.c
+ * @brief Benchmarks the latency of reading an SDI-12 data response
+ *
+ * Every reading sends aD0! to a probe on the virtual bus and measures the
+ * time from the end of the command until the line is handed to the parser.
+ * SDI12ReadData reads a fixed 30 characters, the size the library used
+ * before, and SDI12ReadLine completes on the CRLF of an idle line. The
+ * minimum is the time the probe needs to send the response at 1200 baud.
+ *
+ * Build and run from extras/sdi12:
+ *
+ * @code
+ * gcc -O2 -Ihal -I../../stm32/lib/sdi12/include \
+ *     -I../../stm32/lib/sensors/include rx_bench.c bus_model.c \
+ *     ../../stm32/lib/sdi12/src/sdi12.c ../../stm32/lib/sensors/src/parse.c \
+ *     ../../stm32/lib/sensors/src/fixed.c -o rx_bench
+ * ./rx_bench
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "bus_model.h"
+#include "sdi12.h"
+
+/** Size of the fixed read used before SDI12ReadLine */
+#define FIXED_READ_SIZE 30
+
+/** Timeout of a read in ms */
+#define READ_TIMEOUT 1000
+
+/** Scripted reading */
+typedef struct {
+  const char *name;
+  /** Response to aD0! without address, CRC and CRLF */
+  const char *data;
+  /** Append a CRC like after aMC! */
+  bool crc;
+  /** Corrupt the response, the CRC check must fail */
+  bool corrupt;
+} Reading;
+
+static const Reading readings[] = {
+    {"teros12", "+1846.16+22.3+1234", false, false},
+    {"teros21", "-12.3+22.1", false, false},
+    {"teros12 crc", "+1846.16+22.3+1234", true, false},
+    {"teros12 bad crc", "+1846.16+22.3+1234", true, true},
+    {"6 values", "+1.234+5.678+9.012+3.456+7.890+1.234", false, false},
+};
+
+/**
+ * @brief Send aD0! to the probe with a finished measurement
+ */
+static void RequestData(const Reading *reading) {
+  BusReset();
+  BusAddProbe('0', 0, reading->data);
+  BusProbe *probe = BusProbeGet('0');
+  probe->ready = 1;
+  probe->crc = reading->crc;
+  probe->corrupt = reading->corrupt ? 1 : 0;
+
+  // wake the probe and wait out the marking
+  HAL_LIN_SendBreak(&hlpuart1);
+  BusSleepUntil(BusClock() + 21);
+  HAL_UART_Transmit(&hlpuart1, (const uint8_t *)"0D0!", 4, 1000);
+}
+
+/**
+ * @brief Check the line is the complete response and its CRC is valid
+ */
+static bool Valid(char *line, const Reading *reading) {
+  char *end = strstr(line, "\r\n");
+  if (!end) {
+    return false;
+  }
+  *end = '\0';
+
+  if (reading->crc && SDI12CheckCrc(line) != SDI12_OK) {
+    return false;
+  }
+
+  return line[0] == '0' && strcmp(line + 1, reading->data) == 0;
+}
+
+int main(void) {
+  printf("%-16s %6s %10s %10s %10s %6s %6s\n", "", "chars", "min_ms",
+         "fixed_ms", "line_ms", "fixed", "line");
+
+  for (size_t i = 0; i < sizeof(readings) / sizeof(readings[0]); i++) {
+    const Reading *reading = &readings[i];
+    // address, data, CRC and CRLF
+    const size_t chars = 1 + strlen(reading->data) + (reading->crc ? 3 : 0) + 2;
+
+    char fixed[SDI12_LINE_SIZE] = {};
+    RequestData(reading);
+    uint32_t start = BusClock();
+    SDI12ReadData(fixed, FIXED_READ_SIZE, READ_TIMEOUT);
+    const uint32_t fixed_ms = BusClock() - start;
+
+    char line[SDI12_LINE_SIZE] = {};
+    RequestData(reading);
+    start = BusClock();
+    SDI12ReadLine(line, sizeof(line), READ_TIMEOUT);
+    const uint32_t line_ms = BusClock() - start;
+
+    // a corrupted response must be rejected
+    const bool expect = !reading->corrupt;
+    printf("%-16s %6zu %10.1f %10u %10u %6s %6s\n", reading->name, chars,
+           chars * 8.333, fixed_ms, line_ms,
+           Valid(fixed, reading) == expect ? "ok" : "bad",
+           Valid(line, reading) == expect ? "ok" : "bad");
+  }
+
+  return 0;
+}
@@ -0,0 +1,203 @@
+/**
+ * @file sdi12_sim.c
+ * @brief Runs the async SDI-12 measurements against the virtual bus
+ *
+ * Each argument is a probe given as addr:ttt, the address and the measurement
+ * time in seconds it reports. All probes are measured once with aM!, where
+ * the bus is held until each probe's data is read, and once with aC!, where
+ * every probe is started before the first one is read. The library in
+ * stm32/lib/sdi12 is driven by the AsyncQueue from stm32/lib/sensors, the
+ * same as on the stm32.
+ *
+ * Every probe must return its scripted data and none may be aborted or read
+ * before it finished, otherwise the exit status is 1.
+ *
+ * Build and run from extras/sdi12:
+ *
+ * @code
+ * gcc -O2 -Ihal -I../../stm32/lib/sdi12/include \
+ *     -I../../stm32/lib/sensors/include sdi12_sim.c bus_model.c \
+ *     ../../stm32/lib/sdi12/src/sdi12.c ../../stm32/lib/sensors/src/async.c \
+ *     ../../stm32/lib/sensors/src/parse.c ../../stm32/lib/sensors/src/fixed.c \
+ *     -o sdi12_sim
+ * ./sdi12_sim 0:1 1:1 2:2 3:1
+ * @endcode
+ *
+ * Pass -t to print every command and response.
+ *
+ * @date 2026-10-19
+ */
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "async.h"
+#include "bus_model.h"
+#include "sdi12.h"
+
+/** Probe measured by the simulation */
+typedef struct {
+  char addr;
+  uint16_t ttt;
+  /** Scripted response to aD0! */
+  char data[32];
+  /** Response returned by the library */
+  char result[32];
+  /** Final status */
+  AsyncStatus status;
+  /** Time the measurement finished in ms */
+  uint32_t finished;
+} SimProbe;
+
+/** Use aC! instead of aM! */
+static bool concurrent;
+
+static SimProbe probes[BUS_MAX_PROBES];
+
+static AsyncStatus Start(void *ctx, uint32_t *wait_ms) {
+  const SimProbe *probe = ctx;
+  return SDI12MeasureStart(probe->addr, concurrent, true, wait_ms);
+}
+
+static AsyncStatus Poll(void *ctx, uint32_t *wait_ms) {
+  SimProbe *probe = ctx;
+  return SDI12MeasurePoll(probe->addr, probe->result, sizeof(probe->result),
+                          wait_ms);
+}
+
+static void Cancel(void *ctx) {
+  const SimProbe *probe = ctx;
+  SDI12MeasureCancel(probe->addr);
+}
+
+static const AsyncDriver driver = {Start, Poll, Cancel};
+
+static void Done(uint8_t id, AsyncStatus status) {
+  probes[id].status = status;
+  probes[id].finished = BusClock();
+}
+
+/**
+ * @brief Measure every probe once
+ *
+ * @return Number of failed checks
+ */
+static int Run(size_t n, bool use_concurrent, bool trace) {
+  static AsyncQueue queue;
+
+  concurrent = use_concurrent;
+  BusReset();
+  BusTrace(trace);
+  for (size_t i = 0; i < n; i++) {
+    BusAddProbe(probes[i].addr, probes[i].ttt, probes[i].data);
+    probes[i].result[0] = '\0';
+    probes[i].status = ASYNC_ERROR;
+  }
+
+  AsyncInit(&queue);
+  for (size_t i = 0; i < n; i++) {
+    AsyncSubmit(&queue, &driver, &probes[i], i);
+  }
+
+  const uint32_t start = BusClock();
+  uint32_t awake = 0;
+  uint32_t wake = 0;
+  while (queue.len > 0) {
+    const uint32_t t = BusClock();
+    const uint32_t low_power = BusLowPowerTime();
+    AsyncRun(&queue, BusClock, Done);
+    awake += (BusClock() - t) - (BusLowPowerTime() - low_power);
+
+    if (AsyncNext(&queue, &wake)) {
+      BusSleepUntil(wake);
+    }
+  }
+  const uint32_t cycle = BusClock() - start;
+
+  int failed = 0;
+  for (size_t i = 0; i < n; i++) {
+    const SimProbe *probe = &probes[i];
+    const BusProbe *bus_probe = BusProbeGet(probe->addr);
+
+    char expected[40];
+    snprintf(expected, sizeof(expected), "%c%s", probe->addr, probe->data);
+
+    const bool ok = probe->status == ASYNC_DONE &&
+                    strcmp(probe->result, expected) == 0 &&
+                    bus_probe->aborted == 0 && bus_probe->empty == 0;
+    if (!ok) {
+      printf("probe %c failed: status %d, data \"%s\", aborted %d, empty %d\n",
+             probe->addr, probe->status, probe->result, bus_probe->aborted,
+             bus_probe->empty);
+      ++failed;
+    }
+  }
+  if (BusNotAwake() > 0) {
+    printf("%d commands sent to sleeping probes\n", BusNotAwake());
+    ++failed;
+  }
+
+  printf("%-10s %10u %10u %10u %8s\n", use_concurrent ? "aC!" : "aM!", cycle,
+         awake, BusActiveTime(), failed == 0 ? "ok" : "FAILED");
+
+  return failed;
+}
+
+static void Usage(const char *name) {
+  fprintf(stderr, "usage: %s [-t] addr:ttt...\n", name);
+}
+
+int main(int argc, char **argv) {
+  bool trace = false;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t")) != -1) {
+    switch (opt) {
+      case 't':
+        trace = true;
+        break;
+      default:
+        Usage(argv[0]);
+        return 1;
+    }
+  }
+
+  const size_t n = argc - optind;
+  if (n == 0 || n > BUS_MAX_PROBES) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  uint32_t sum_ttt = 0;
+  uint32_t max_ttt = 0;
+  for (size_t i = 0; i < n; i++) {
+    const char *arg = argv[optind + i];
+    SimProbe *probe = &probes[i];
+    if (strlen(arg) < 3 || arg[1] != ':' ||
+        SDI12AddressFromIndex((uint8_t)arg[0], &probe->addr) != SDI12_OK) {
+      fprintf(stderr, "invalid probe %s\n", arg);
+      return 1;
+    }
+    probe->ttt = (uint16_t)atoi(arg + 2);
+
+    // Teros12 style response, different for every probe
+    snprintf(probe->data, sizeof(probe->data), "+%.2f+%.1f+%u",
+             1800.0 + 10 * i, 20.0 + i, 100u + (unsigned)i);
+
+    sum_ttt += probe->ttt * 1000;
+    if (probe->ttt * 1000u > max_ttt) {
+      max_ttt = probe->ttt * 1000;
+    }
+  }
+
+  printf("%zu probes, ttt sum %u ms, ttt max %u ms\n\n", n, sum_ttt, max_ttt);
+  printf("%-10s %10s %10s %10s %8s\n", "", "cycle_ms", "awake_ms", "uart_ms",
+         "check");
+
+  int failed = Run(n, false, trace);
+  failed += Run(n, true, trace);
+
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,500 @@
+/**
+ * @file parse_fuzz.c
+ * @brief Fuzzes the sensor response parsers against sscanf
+ *
+ * Links parse.c and fixed.c from stm32/lib/sensors. Every format that used
+ * to be parsed with sscanf is generated with random values and then mutated
+ * by inserting, deleting and replacing characters. Each string goes through
+ * the original sscanf format and through the same sequence of parsers the
+ * driver now uses. Both have to accept or reject the string, and accepted
+ * values have to match. Floats are compared in Q32.32 against %lf, which
+ * accepts the same strings as %f with the precision of a double.
+ *
+ * Exponents, infinity and NaN are not accepted by ParseFixed, so strings with
+ * a number followed by e or E, or containing inf or nan, are skipped.
+ *
+ * The time per parse of sscanf and of the parsers is measured on a valid
+ * Teros12 response. It is only indicative, the cycles on the stm32 are
+ * counted by example_parse.
+ *
+ * Build and run from extras/sscanf_free:
+ *
+ * @code
+ * gcc -O2 -I../../stm32/lib/sensors/include parse_fuzz.c \
+ *     ../../stm32/lib/sensors/src/parse.c \
+ *     ../../stm32/lib/sensors/src/fixed.c -lm -o parse_fuzz
+ * ./parse_fuzz 1000000
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include "parse.h"
+
+/** Max length of a generated string */
+#define STR_LEN 256
+
+/** Max mutations of a generated string */
+#define MAX_MUTATIONS 4
+
+/** Number of mismatches printed per format */
+#define MAX_PRINT 5
+
+/** Iterations of the timing */
+#define BENCH_ITER 1000000
+
+/** Results of a single format */
+typedef struct {
+  const char *name;
+  /** Characters used by mutations */
+  const char *alphabet;
+  /** Generate a valid string */
+  void (*generate)(char *str);
+  /** Parse with both and compare, 1 on mismatch */
+  int (*compare)(const char *str, bool *accepted);
+  unsigned long n;
+  unsigned long accepted;
+  unsigned long skipped;
+  unsigned long mismatches;
+} Format;
+
+/** Linear congruential generator, the same sequence on every host */
+static uint32_t Rand(void) {
+  static uint64_t state = 1;
+  state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+  return state >> 33;
+}
+
+/**
+ * @brief Check a parsed value against the double reference
+ *
+ * Allows half of the resolution for the rounding of the parser and the
+ * precision of the reference. Values out of range have to saturate.
+ */
+static bool SameFixed(q32_t fixed, double ref) {
+  if (ref >= 2147483647.5) {
+    return fixed == Q32_MAX;
+  }
+  if (ref <= -2147483647.5) {
+    return fixed == -Q32_MAX;
+  }
+
+  const double diff = fabs(((double)fixed / 4294967296.0) - ref);
+  return diff <= (0.5 / 4294967296.0) + (fabs(ref) * 0x1p-52);
+}
+
+/**
+ * @brief Check a parsed integer against the %d reference
+ *
+ * The result of %d out of the int range is undefined, those are skipped.
+ */
+static bool SameInt(int32_t value, int ref) {
+  if (value == INT32_MAX || value == INT32_MIN) {
+    return true;
+  }
+  return value == ref;
+}
+
+/**
+ * @brief Append a random digit string
+ */
+static void Digits(char *str, int max) {
+  int n = Rand() % (max + 1);
+  // occasionally long runs of digits
+  if (Rand() % 50 == 0) {
+    n = Rand() % 25;
+  }
+  for (int i = 0; i < n; i++) {
+    char d[2] = {(char)('0' + (Rand() % 10)), '\0'};
+    strcat(str, d);
+  }
+}
+
+/**
+ * @brief Append a random decimal number
+ *
+ * @param sign Always add a sign
+ */
+static void Number(char *str, bool sign) {
+  const uint32_t r = Rand() % 3;
+  if (sign || r == 0) {
+    strcat(str, (Rand() % 2) ? "+" : "-");
+  }
+
+  Digits(str, 5);
+  if (Rand() % 4 != 0) {
+    strcat(str, ".");
+    Digits(str, 6);
+  }
+}
+
+/**
+ * @brief Append a random address character
+ */
+static void Address(char *str) {
+  static const char addrs[] = "0123456789ABCZabz";
+  char a[2] = {addrs[Rand() % (sizeof(addrs) - 1)], '\0'};
+  strcat(str, a);
+}
+
+/**
+ * @brief Insert, delete or replace random characters
+ */
+static void Mutate(char *str, const char *alphabet) {
+  const int mutations = Rand() % (MAX_MUTATIONS + 1);
+  const size_t alphabet_len = strlen(alphabet);
+
+  for (int i = 0; i < mutations; i++) {
+    const size_t len = strlen(str);
+    const size_t pos = (len > 0) ? Rand() % (len + 1) : 0;
+    const char c = alphabet[Rand() % alphabet_len];
+
+    switch (Rand() % 4) {
+      case 0:
+        if (len + 1 < STR_LEN) {
+          memmove(str + pos + 1, str + pos, len - pos + 1);
+          str[pos] = c;
+        }
+        break;
+      case 1:
+        if (pos < len) {
+          memmove(str + pos, str + pos + 1, len - pos);
+        }
+        break;
+      case 2:
+        if (pos < len) {
+          str[pos] = c;
+        }
+        break;
+      default:
+        // truncate
+        str[pos] = '\0';
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Check for input outside of the grammar of ParseFixed
+ */
+static bool Unsupported(const char *str) {
+  for (const char *s = str; *s != '\0'; s++) {
+    if ((s[0] == '.' || (s[0] >= '0' && s[0] <= '9')) &&
+        (s[1] == 'e' || s[1] == 'E')) {
+      return true;
+    }
+    if (strncasecmp(s, "inf", 3) == 0 || strncasecmp(s, "nan", 3) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void GenerateTeros12(char *str) {
+  Address(str);
+  strcat(str, "+");
+  Number(str, false);
+  Number(str, true);
+  strcat(str, "+");
+  Digits(str, 6);
+}
+
+static int CompareTeros12(const char *str, bool *accepted) {
+  char ref_addr = 0;
+  double ref_vwc = 0;
+  double ref_temp = 0;
+  int ref_ec = 0;
+  const bool ref_ok = sscanf(str, "%1c+%lf%lf+%d", &ref_addr, &ref_vwc,
+                             &ref_temp, &ref_ec) == 4;
+
+  // same as Teros12ParseMeasurement
+  char addr = 0;
+  q32_t vwc = 0;
+  q32_t temp = 0;
+  int32_t ec = 0;
+  const char *s = str;
+  const bool ok = ParseChar(&s, &addr) && ParseLiteral(&s, "+") &&
+                  ParseFixed(&s, &vwc) && ParseFixed(&s, &temp) &&
+                  ParseLiteral(&s, "+") && ParseInt(&s, &ec);
+
+  *accepted = ok;
+  if (ok != ref_ok) {
+    return 1;
+  }
+  if (!ok) {
+    return 0;
+  }
+  return !(addr == ref_addr && SameFixed(vwc, ref_vwc) &&
+           SameFixed(temp, ref_temp) && SameInt(ec, ref_ec));
+}
+
+static void GenerateTeros21(char *str) {
+  Address(str);
+  strcat(str, "-");
+  Number(str, false);
+  Number(str, true);
+}
+
+static int CompareTeros21(const char *str, bool *accepted) {
+  char ref_addr = 0;
+  double ref_pot = 0;
+  double ref_temp = 0;
+  const bool ref_ok =
+      sscanf(str, "%1c-%lf%lf", &ref_addr, &ref_pot, &ref_temp) == 3;
+
+  // same as Teros21ParseMeasurement
+  char addr = 0;
+  q32_t pot = 0;
+  q32_t temp = 0;
+  const char *s = str;
+  const bool ok = ParseChar(&s, &addr) && ParseLiteral(&s, "-") &&
+                  ParseFixed(&s, &pot) && ParseFixed(&s, &temp);
+
+  *accepted = ok;
+  if (ok != ref_ok) {
+    return 1;
+  }
+  if (!ok) {
+    return 0;
+  }
+  return !(addr == ref_addr && SameFixed(pot, ref_pot) &&
+           SameFixed(temp, ref_temp));
+}
+
+static void GenerateMeasure(char *str) {
+  Address(str);
+  Digits(str, 3);
+  Digits(str, 2);
+}
+
+static int CompareMeasure(const char *str, bool *accepted) {
+  char ref_addr = 0;
+  unsigned short ref_time = 0;
+  unsigned char ref_num = 0;
+  const int rc =
+      sscanf(str, "%1c%3hu%1hhu", &ref_addr, &ref_time, &ref_num);
+
+  // same as ParseMeasurementResponse
+  char addr = 0;
+  uint32_t time = 0;
+  uint32_t num = 0;
+  int fields = 0;
+  const char *s = str;
+  if (ParseChar(&s, &addr)) {
+    ++fields;
+    if (ParseUint(&s, 3, &time)) {
+      ++fields;
+      if (ParseUint(&s, 1, &num)) {
+        ++fields;
+      }
+    }
+  }
+
+  *accepted = (fields == 3);
+  const int ref_fields = (rc < 0) ? 0 : rc;
+  if (fields != ref_fields) {
+    return 1;
+  }
+  return !((fields < 1 || addr == ref_addr) &&
+           (fields < 2 || time == ref_time) &&
+           (fields < 3 || num == ref_num));
+}
+
+static int CompareConcurrent(const char *str, bool *accepted) {
+  char ref_addr = 0;
+  unsigned short ref_time = 0;
+  unsigned char ref_num = 0;
+  const bool ref_ok =
+      sscanf(str, "%1c%3hu%2hhu", &ref_addr, &ref_time, &ref_num) == 3;
+
+  // same as ParseConcurrentResponse
+  char addr = 0;
+  uint32_t time = 0;
+  uint32_t num = 0;
+  const char *s = str;
+  const bool ok = ParseChar(&s, &addr) && ParseUint(&s, 3, &time) &&
+                  ParseUint(&s, 2, &num);
+
+  *accepted = ok;
+  if (ok != ref_ok) {
+    return 1;
+  }
+  if (!ok) {
+    return 0;
+  }
+  return !(addr == ref_addr && time == ref_time && num == ref_num);
+}
+
+static void GenerateEdu0157(char *str) {
+  static const char *dirs[] = {"N", "NE", "E", "SE", "S", "SW", "W", "NW"};
+
+  strcat(str, "WindSpeed:");
+  Number(str, false);
+  strcat(str, " m/s, WindDirection:");
+  strcat(str, dirs[Rand() % 8]);
+  strcat(str, ", Altitude:");
+  Number(str, false);
+  strcat(str, " m, Pressure:");
+  Number(str, false);
+  strcat(str, " hPa, Temp:");
+  Number(str, false);
+  strcat(str, " C, Humi:");
+  Number(str, false);
+  strcat(str, " %RH");
+}
+
+static int CompareEdu0157(const char *str, bool *accepted) {
+  double ref[5] = {0};
+  char ref_dir[4] = {0};
+  const bool ref_ok =
+      sscanf(str,
+             "WindSpeed:%lf m/s, WindDirection:%3[^,], Altitude:%lf m, "
+             "Pressure:%lf hPa, Temp:%lf C, Humi:%lf %%RH",
+             &ref[0], ref_dir, &ref[1], &ref[2], &ref[3], &ref[4]) == 6;
+
+  // same as EDU0157MeasureAll
+  q32_t values[5] = {0};
+  char dir[4] = {0};
+  const char *s = str;
+  const bool ok = ParseLiteral(&s, "WindSpeed:") &&
+                  ParseFixed(&s, &values[0]) &&
+                  ParseLiteral(&s, " m/s, WindDirection:") &&
+                  ParseToken(&s, ',', dir, sizeof(dir)) &&
+                  ParseLiteral(&s, ", Altitude:") &&
+                  ParseFixed(&s, &values[1]) &&
+                  ParseLiteral(&s, " m, Pressure:") &&
+                  ParseFixed(&s, &values[2]) &&
+                  ParseLiteral(&s, " hPa, Temp:") &&
+                  ParseFixed(&s, &values[3]) &&
+                  ParseLiteral(&s, " C, Humi:") && ParseFixed(&s, &values[4]);
+
+  *accepted = ok;
+  if (ok != ref_ok) {
+    return 1;
+  }
+  if (!ok) {
+    return 0;
+  }
+  if (strcmp(dir, ref_dir) != 0) {
+    return 1;
+  }
+  for (int i = 0; i < 5; i++) {
+    if (!SameFixed(values[i], ref[i])) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Time per parse in ns of a valid Teros12 response
+ */
+static void Bench(void) {
+  const char *str = "0+1846.16+22.3+20000";
+  volatile double sink = 0;
+
+  clock_t start = clock();
+  for (int i = 0; i < BENCH_ITER; i++) {
+    char addr = 0;
+    float vwc = 0;
+    float temp = 0;
+    int ec = 0;
+    sscanf(str, "%1c+%f%f+%d", &addr, &vwc, &temp, &ec);
+    sink += vwc;
+  }
+  const double t_sscanf = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  start = clock();
+  for (int i = 0; i < BENCH_ITER; i++) {
+    char addr = 0;
+    q32_t vwc = 0;
+    q32_t temp = 0;
+    int32_t ec = 0;
+    const char *s = str;
+    if (ParseChar(&s, &addr) && ParseLiteral(&s, "+") &&
+        ParseFixed(&s, &vwc) && ParseFixed(&s, &temp) &&
+        ParseLiteral(&s, "+") && ParseInt(&s, &ec)) {
+      sink += vwc;
+    }
+  }
+  const double t_parse = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("\nteros12 \"%s\", ns per parse\n", str);
+  printf("sscanf %10.1f\n", t_sscanf * 1e9 / BENCH_ITER);
+  printf("parse  %10.1f\n", t_parse * 1e9 / BENCH_ITER);
+}
+
+int main(int argc, char *argv[]) {
+  const unsigned long iterations = (argc > 1) ? strtoul(argv[1], NULL, 10)
+                                              : 100000;
+
+  Format formats[] = {
+      {.name = "teros12",
+       .alphabet = "0123456789+-. \t",
+       .generate = GenerateTeros12,
+       .compare = CompareTeros12},
+      {.name = "teros21",
+       .alphabet = "0123456789+-. \t",
+       .generate = GenerateTeros21,
+       .compare = CompareTeros21},
+      {.name = "sdi12 measure",
+       .alphabet = "0123456789aZ \t",
+       .generate = GenerateMeasure,
+       .compare = CompareMeasure},
+      {.name = "sdi12 concurrent",
+       .alphabet = "0123456789aZ \t",
+       .generate = GenerateMeasure,
+       .compare = CompareConcurrent},
+      {.name = "edu0157",
+       .alphabet = "0123456789+-. \t,:/mNSEW%",
+       .generate = GenerateEdu0157,
+       .compare = CompareEdu0157},
+  };
+  const int num_formats = sizeof(formats) / sizeof(formats[0]);
+
+  for (int f = 0; f < num_formats; f++) {
+    Format *fmt = &formats[f];
+    for (unsigned long i = 0; i < iterations; i++) {
+      char str[STR_LEN] = {0};
+      fmt->generate(str);
+      Mutate(str, fmt->alphabet);
+
+      ++fmt->n;
+      if (Unsupported(str)) {
+        ++fmt->skipped;
+        continue;
+      }
+
+      bool accepted = false;
+      if (fmt->compare(str, &accepted)) {
+        if (fmt->mismatches < MAX_PRINT) {
+          printf("%s mismatch: \"%s\"\n", fmt->name, str);
+        }
+        ++fmt->mismatches;
+      }
+      if (accepted) {
+        ++fmt->accepted;
+      }
+    }
+  }
+
+  printf("%-18s %10s %10s %10s %10s\n", "format", "strings", "accepted",
+         "skipped", "mismatch");
+  for (int f = 0; f < num_formats; f++) {
+    const Format *fmt = &formats[f];
+    printf("%-18s %10lu %10lu %10lu %10lu\n", fmt->name, fmt->n,
+           fmt->accepted, fmt->skipped, fmt->mismatches);
+  }
+
+  Bench();
+
+  return 0;
+}
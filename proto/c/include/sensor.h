@@ -82,6 +82,26 @@ SensorStatus EncodeSensorMeasurement(const SensorMeasurement* meas,
 SensorStatus EncodeRepeatedSensorMeasurements(Metadata meta, const SensorMeasurement meas[],
     size_t count, uint8_t* buffer, size_t size, size_t* length);
 
+/**
+ * @brief Encodes multiple sensor measurements with a sequence number.
+ *
+ * Same as EncodeRepeatedSensorMeasurements with the seq field set, so the
+ * backend can drop measurements that are uploaded more than once.
+ *
+ * @param seq Sequence number of the first measurement, 0 for none.
+ * @param meta Metadata for the measurements.
+ * @param meas Array of SensorMeasurements to encode.
+ * @param count Number of measurements in the array.
+ * @param buffer Pointer to the output buffer.
+ * @param size Size of buffer.
+ * @param length Pointer to the length of the output buffer.
+ *
+ * @return SENSOR_SUCCESS on success, SENSOR_ERROR on failure.
+ */
+SensorStatus EncodeSequencedSensorMeasurements(uint32_t seq, Metadata meta,
+    const SensorMeasurement meas[], size_t count, uint8_t* buffer, size_t size,
+    size_t* length);
+
 /**
  * @brief Encodes a uint64_t sensor measurement into a buffer.
  *
@@ -128,6 +148,20 @@ SensorStatus EncodeDoubleMeasurement(Metadata meta,
                              double value, SensorType type,
                              uint8_t* buffer, size_t* size);
 
+/**
+ * @brief Encodes a summary of a window of measurements into a buffer.
+ * @param meta Metadata for the measurement, ts is the start of the window.
+ * @param summary Statistics of the window.
+ * @param type The SensorType of the summarized measurements.
+ * @param buffer Pointer to the output buffer.
+ * @param size Pointer to the size of the output buffer. On success, updated to
+ * the number of bytes written.
+ * @return SENSOR_SUCCESS on success, SENSOR_ERROR on failure.
+ */
+SensorStatus EncodeSummaryMeasurement(Metadata meta, const Summary* summary,
+                                      SensorType type, uint8_t* buffer,
+                                      size_t* size);
+
 /**
  * @brief Decodes a sensor measurement from a buffer.
  *
@@ -154,6 +188,21 @@ SensorStatus DecodeSensorMeasurement(const uint8_t* data, const size_t len,
 SensorStatus RepeatedSensorMeasurementsSize(Metadata meta, const SensorMeasurement meas[], 
         size_t count, size_t *size);
 
+/**
+ * @brief Gets the size of multiple sensor measurements with a sequence number
+ * when encoded.
+ *
+ * @param seq Sequence number of the first measurement, 0 for none.
+ * @param meta Metadata for the measurements.
+ * @param meas Array of SensorMeasurements to encode.
+ * @param count Number of measurements in the array.
+ * @param size Pointer to the size variable to populate.
+ *
+ * @return SENSOR_SUCCESS on success, SENSOR_ERROR on failure.
+ */
+SensorStatus SequencedSensorMeasurementsSize(uint32_t seq, Metadata meta,
+        const SensorMeasurement meas[], size_t count, size_t *size);
+
 
 /**
  * @brief Decodes multiple sensor measurements from a buffer.
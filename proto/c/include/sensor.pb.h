@@ -88,7 +88,8 @@ typedef struct _Metadata {
 } Metadata;
 
 typedef struct _SensorResponse {
-    /* Index of measurements */
+    /* Index of the measurement in the RepeatedSensorMeasurements counted from 1,
+ 0 for all of them */
     uint32_t idx;
     /* Error code */
     SensorError error;
@@ -97,8 +98,24 @@ typedef struct _SensorResponse {
 typedef struct _RepeatedSensorResponses {
     pb_size_t responses_count;
     SensorResponse responses[16];
+    /* Sequence number of the RepeatedSensorMeasurements that is answered, 0 for
+ the last one uploaded */
+    uint32_t seq;
 } RepeatedSensorResponses;
 
+/* *
+ Statistics of the samples of a single sensor type over a window. Uploaded
+ in place of the samples when aggregation is enabled for the sensor. */
+typedef struct _Summary {
+    /* * Number of samples in the window */
+    uint32_t count;
+    float min;
+    float mean;
+    float max;
+    /* * Sample standard deviation, 0 for a single sample */
+    float stddev;
+} Summary;
+
 typedef struct _SensorMeasurement {
     /* * Metadata for the measurement */
     bool has_meta;
@@ -110,6 +127,8 @@ typedef struct _SensorMeasurement {
         uint32_t unsigned_int;
         int32_t signed_int;
         double decimal;
+        /* * Summary of a window, ts of the metadata is the first sample */
+        Summary summary;
     } value;
     /* * Index of the measurement */
     uint32_t idx;
@@ -124,6 +143,11 @@ typedef struct _RepeatedSensorMeasurements {
     /* * List of sensor measurements */
     pb_size_t measurements_count;
     SensorMeasurement measurements[16];
+    /* *
+ Sequence number of the first measurement, the following ones are numbered
+ consecutively. A measurement that is uploaded again keeps its number, so
+ duplicates can be dropped. Never 0, which means not numbered. */
+    uint32_t seq;
 } RepeatedSensorMeasurements;
 
 
@@ -154,14 +178,16 @@ const char *SensorError_name(SensorError v);
 /* Initializer values for message structs */
 #define Metadata_init_default                    {0, 0, 0}
 #define SensorResponse_init_default              {0, _SensorError_MIN}
-#define RepeatedSensorResponses_init_default     {0, {SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default}}
+#define RepeatedSensorResponses_init_default     {0, {SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default, SensorResponse_init_default}, 0}
+#define Summary_init_default                     {0, 0, 0, 0, 0}
 #define SensorMeasurement_init_default           {false, Metadata_init_default, _SensorType_MIN, 0, {0}, 0}
-#define RepeatedSensorMeasurements_init_default  {false, Metadata_init_default, _SensorType_MIN, 0, {SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default}}
+#define RepeatedSensorMeasurements_init_default  {false, Metadata_init_default, _SensorType_MIN, 0, {SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default, SensorMeasurement_init_default}, 0}
 #define Metadata_init_zero                       {0, 0, 0}
 #define SensorResponse_init_zero                 {0, _SensorError_MIN}
-#define RepeatedSensorResponses_init_zero        {0, {SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero}}
+#define RepeatedSensorResponses_init_zero        {0, {SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero, SensorResponse_init_zero}, 0}
+#define Summary_init_zero                        {0, 0, 0, 0, 0}
 #define SensorMeasurement_init_zero              {false, Metadata_init_zero, _SensorType_MIN, 0, {0}, 0}
-#define RepeatedSensorMeasurements_init_zero     {false, Metadata_init_zero, _SensorType_MIN, 0, {SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero}}
+#define RepeatedSensorMeasurements_init_zero     {false, Metadata_init_zero, _SensorType_MIN, 0, {SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero, SensorMeasurement_init_zero}, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define Metadata_cell_id_tag                     1
@@ -170,15 +196,23 @@ const char *SensorError_name(SensorError v);
 #define SensorResponse_idx_tag                   1
 #define SensorResponse_error_tag                 2
 #define RepeatedSensorResponses_responses_tag    1
+#define RepeatedSensorResponses_seq_tag          2
+#define Summary_count_tag                        1
+#define Summary_min_tag                          2
+#define Summary_mean_tag                         3
+#define Summary_max_tag                          4
+#define Summary_stddev_tag                       5
 #define SensorMeasurement_meta_tag               1
 #define SensorMeasurement_type_tag               2
 #define SensorMeasurement_unsigned_int_tag       3
 #define SensorMeasurement_signed_int_tag         4
 #define SensorMeasurement_decimal_tag            5
+#define SensorMeasurement_summary_tag            7
 #define SensorMeasurement_idx_tag                6
 #define RepeatedSensorMeasurements_meta_tag      1
 #define RepeatedSensorMeasurements_type_tag      2
 #define RepeatedSensorMeasurements_measurements_tag 3
+#define RepeatedSensorMeasurements_seq_tag       4
 
 /* Struct field encoding specification for nanopb */
 #define Metadata_FIELDLIST(X, a) \
@@ -195,26 +229,39 @@ X(a, STATIC,   SINGULAR, UENUM,    error,             2)
 #define SensorResponse_DEFAULT NULL
 
 #define RepeatedSensorResponses_FIELDLIST(X, a) \
-X(a, STATIC,   REPEATED, MESSAGE,  responses,         1)
+X(a, STATIC,   REPEATED, MESSAGE,  responses,         1) \
+X(a, STATIC,   SINGULAR, UINT32,   seq,               2)
 #define RepeatedSensorResponses_CALLBACK NULL
 #define RepeatedSensorResponses_DEFAULT NULL
 #define RepeatedSensorResponses_responses_MSGTYPE SensorResponse
 
+#define Summary_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, UINT32,   count,             1) \
+X(a, STATIC,   SINGULAR, FLOAT,    min,               2) \
+X(a, STATIC,   SINGULAR, FLOAT,    mean,              3) \
+X(a, STATIC,   SINGULAR, FLOAT,    max,               4) \
+X(a, STATIC,   SINGULAR, FLOAT,    stddev,            5)
+#define Summary_CALLBACK NULL
+#define Summary_DEFAULT NULL
+
 #define SensorMeasurement_FIELDLIST(X, a) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  meta,              1) \
 X(a, STATIC,   SINGULAR, UENUM,    type,              2) \
 X(a, STATIC,   ONEOF,    UINT32,   (value,unsigned_int,value.unsigned_int),   3) \
 X(a, STATIC,   ONEOF,    INT32,    (value,signed_int,value.signed_int),   4) \
 X(a, STATIC,   ONEOF,    DOUBLE,   (value,decimal,value.decimal),   5) \
-X(a, STATIC,   SINGULAR, UINT32,   idx,               6)
+X(a, STATIC,   SINGULAR, UINT32,   idx,               6) \
+X(a, STATIC,   ONEOF,    MESSAGE,  (value,summary,value.summary),   7)
 #define SensorMeasurement_CALLBACK NULL
 #define SensorMeasurement_DEFAULT NULL
 #define SensorMeasurement_meta_MSGTYPE Metadata
+#define SensorMeasurement_value_summary_MSGTYPE Summary
 
 #define RepeatedSensorMeasurements_FIELDLIST(X, a) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  meta,              1) \
 X(a, STATIC,   SINGULAR, UENUM,    type,              2) \
-X(a, STATIC,   REPEATED, MESSAGE,  measurements,      3)
+X(a, STATIC,   REPEATED, MESSAGE,  measurements,      3) \
+X(a, STATIC,   SINGULAR, UINT32,   seq,               4)
 #define RepeatedSensorMeasurements_CALLBACK NULL
 #define RepeatedSensorMeasurements_DEFAULT NULL
 #define RepeatedSensorMeasurements_meta_MSGTYPE Metadata
@@ -223,6 +270,7 @@ X(a, STATIC,   REPEATED, MESSAGE,  measurements,      3)
 extern const pb_msgdesc_t Metadata_msg;
 extern const pb_msgdesc_t SensorResponse_msg;
 extern const pb_msgdesc_t RepeatedSensorResponses_msg;
+extern const pb_msgdesc_t Summary_msg;
 extern const pb_msgdesc_t SensorMeasurement_msg;
 extern const pb_msgdesc_t RepeatedSensorMeasurements_msg;
 
@@ -230,16 +278,18 @@ extern const pb_msgdesc_t RepeatedSensorMeasurements_msg;
 #define Metadata_fields &Metadata_msg
 #define SensorResponse_fields &SensorResponse_msg
 #define RepeatedSensorResponses_fields &RepeatedSensorResponses_msg
+#define Summary_fields &Summary_msg
 #define SensorMeasurement_fields &SensorMeasurement_msg
 #define RepeatedSensorMeasurements_fields &RepeatedSensorMeasurements_msg
 
 /* Maximum encoded size of messages (where known) */
 #define Metadata_size                            18
-#define RepeatedSensorMeasurements_size          678
-#define RepeatedSensorResponses_size             160
+#define RepeatedSensorMeasurements_size          956
+#define RepeatedSensorResponses_size             166
 #define SENSOR_PB_H_MAX_SIZE                     RepeatedSensorMeasurements_size
-#define SensorMeasurement_size                   39
+#define SensorMeasurement_size                   56
 #define SensorResponse_size                      8
+#define Summary_size                             26
 
 #ifdef __cplusplus
 } /* extern "C" */
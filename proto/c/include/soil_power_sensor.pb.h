@@ -215,6 +215,7 @@ typedef struct _PowerMeasurementDelta {
     uint32_t current_delta;
 } PowerMeasurementDelta;
 
+typedef PB_BYTES_ARRAY_T(254) RepeatedPowerDeltas_packed_entries_t;
 /* *
  Repeated delta power measurements.
 
@@ -228,6 +229,9 @@ typedef struct _RepeatedPowerDeltas {
     uint32_t cell_id;
     /* Repeating entries */
     pb_callback_t entries;
+    /* Entries packed back to back as three varints each (ts, voltage_delta,
+ current_delta) without the per entry tag and length */
+    RepeatedPowerDeltas_packed_entries_t packed_entries;
 } RepeatedPowerDeltas;
 
 /* Teros12 measurement message */
@@ -429,6 +433,28 @@ typedef struct _EnabledSensorMultiple {
     EnabledSensor enabled_sensor;
     uint32_t cell_id;
     uint32_t index;
+    /* Measurement period in seconds, 0 uses Upload_interval */
+    uint32_t period;
+    /* Offset of the first measurement in seconds from the start of measurements */
+    uint32_t phase;
+    /* Upload a Summary every aggregate_count samples instead of each sample, 0
+ disables the limit */
+    uint32_t aggregate_count;
+    /* Upload a Summary once the window spans aggregate_period seconds, 0
+ disables the limit. Samples are uploaded raw if both limits are 0. */
+    uint32_t aggregate_period;
+    /* Only upload a sample that differs from the last uploaded one by more than
+ deadband_absolute, in the units of the measurement */
+    float deadband_absolute;
+    /* Only upload a sample that differs from the last uploaded one by more than
+ deadband_relative times its magnitude, e.g. 0.05 for 5%. A sample is
+ uploaded if it exceeds either threshold, or on any change if both are 0. */
+    float deadband_relative;
+    /* Upload a sample at least every heartbeat seconds even without a change,
+ 0 disables. A sample that is not uploaded means the value stayed within
+ the deadband of the previous one. Filtering is disabled if all three are
+ 0 or the sensor is aggregated. */
+    uint32_t heartbeat;
 } EnabledSensorMultiple;
 
 typedef struct _UserConfiguration {
@@ -629,7 +655,7 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define CurrentMeasurement_init_default          {0}
 #define PowerDeltaEntry_init_default             {0, 0, 0}
 #define PowerMeasurementDelta_init_default       {0, 0}
-#define RepeatedPowerDeltas_init_default         {0, 0, {{NULL}, NULL}}
+#define RepeatedPowerDeltas_init_default         {0, 0, {{NULL}, NULL}, {0, {0}}}
 #define Teros12Measurement_init_default          {0, 0, 0, 0}
 #define Teros21Measurement_init_default          {0, 0}
 #define Phytos31Measurement_init_default         {0, 0}
@@ -655,7 +681,7 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define PowerCommand_init_default                {_PowerCommand_Type_MIN, _PowerCommand_WakeupReason_MIN, 0}
 #define UserConfiguration_init_default           {0, 0, _Uploadmethod_MIN, 0, 0, {_EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN}, 0, 0, 0, 0, "", "", "", 0, 0, {EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default, EnabledSensorMultiple_init_default}}
 #define adcValue_init_default                    {0}
-#define EnabledSensorMultiple_init_default       {_EnabledSensor_MIN, 0, 0}
+#define EnabledSensorMultiple_init_default       {_EnabledSensor_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 #define MeasurementMetadata_init_zero            {0, 0, 0}
 #define PowerMeasurement_init_zero               {0, 0}
 #define VoltageDeltaMeasurement_init_zero        {0}
@@ -664,7 +690,7 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define CurrentMeasurement_init_zero             {0}
 #define PowerDeltaEntry_init_zero                {0, 0, 0}
 #define PowerMeasurementDelta_init_zero          {0, 0}
-#define RepeatedPowerDeltas_init_zero            {0, 0, {{NULL}, NULL}}
+#define RepeatedPowerDeltas_init_zero            {0, 0, {{NULL}, NULL}, {0, {0}}}
 #define Teros12Measurement_init_zero             {0, 0, 0, 0}
 #define Teros21Measurement_init_zero             {0, 0}
 #define Phytos31Measurement_init_zero            {0, 0}
@@ -690,7 +716,7 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define PowerCommand_init_zero                   {_PowerCommand_Type_MIN, _PowerCommand_WakeupReason_MIN, 0}
 #define UserConfiguration_init_zero              {0, 0, _Uploadmethod_MIN, 0, 0, {_EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN, _EnabledSensor_MIN}, 0, 0, 0, 0, "", "", "", 0, 0, {EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero, EnabledSensorMultiple_init_zero}}
 #define adcValue_init_zero                       {0}
-#define EnabledSensorMultiple_init_zero          {_EnabledSensor_MIN, 0, 0}
+#define EnabledSensorMultiple_init_zero          {_EnabledSensor_MIN, 0, 0, 0, 0, 0, 0, 0, 0, 0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define MeasurementMetadata_cell_id_tag          1
@@ -710,6 +736,7 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define RepeatedPowerDeltas_logger_id_tag        1
 #define RepeatedPowerDeltas_cell_id_tag          2
 #define RepeatedPowerDeltas_entries_tag          3
+#define RepeatedPowerDeltas_packed_entries_tag   4
 #define Teros12Measurement_vwc_raw_tag           2
 #define Teros12Measurement_vwc_adj_tag           3
 #define Teros12Measurement_temp_tag              4
@@ -781,6 +808,13 @@ const char *PowerCommand_WakeupReason_name(PowerCommand_WakeupReason v);
 #define EnabledSensorMultiple_enabled_sensor_tag 1
 #define EnabledSensorMultiple_cell_id_tag        2
 #define EnabledSensorMultiple_index_tag          3
+#define EnabledSensorMultiple_period_tag         4
+#define EnabledSensorMultiple_phase_tag          5
+#define EnabledSensorMultiple_aggregate_count_tag 6
+#define EnabledSensorMultiple_aggregate_period_tag 7
+#define EnabledSensorMultiple_deadband_absolute_tag 8
+#define EnabledSensorMultiple_deadband_relative_tag 9
+#define EnabledSensorMultiple_heartbeat_tag      10
 #define UserConfiguration_logger_id_tag          1
 #define UserConfiguration_cell_id_tag            2
 #define UserConfiguration_Upload_method_tag      3
@@ -863,7 +897,8 @@ X(a, STATIC,   SINGULAR, UINT32,   current_delta,     3)
 #define RepeatedPowerDeltas_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UINT32,   logger_id,         1) \
 X(a, STATIC,   SINGULAR, UINT32,   cell_id,           2) \
-X(a, CALLBACK, REPEATED, MESSAGE,  entries,           3)
+X(a, CALLBACK, REPEATED, MESSAGE,  entries,           3) \
+X(a, STATIC,   SINGULAR, BYTES,    packed_entries,    4)
 #define RepeatedPowerDeltas_CALLBACK pb_default_field_callback
 #define RepeatedPowerDeltas_DEFAULT NULL
 #define RepeatedPowerDeltas_entries_MSGTYPE PowerDeltaEntry
@@ -1098,7 +1133,14 @@ X(a, STATIC,   SINGULAR, UINT32,   adc,               1)
 #define EnabledSensorMultiple_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, UENUM,    enabled_sensor,    1) \
 X(a, STATIC,   SINGULAR, UINT32,   cell_id,           2) \
-X(a, STATIC,   SINGULAR, UINT32,   index,             3)
+X(a, STATIC,   SINGULAR, UINT32,   index,             3) \
+X(a, STATIC,   SINGULAR, UINT32,   period,            4) \
+X(a, STATIC,   SINGULAR, UINT32,   phase,             5) \
+X(a, STATIC,   SINGULAR, UINT32,   aggregate_count,   6) \
+X(a, STATIC,   SINGULAR, UINT32,   aggregate_period,  7) \
+X(a, STATIC,   SINGULAR, FLOAT,    deadband_absolute, 8) \
+X(a, STATIC,   SINGULAR, FLOAT,    deadband_relative, 9) \
+X(a, STATIC,   SINGULAR, UINT32,   heartbeat,        10)
 #define EnabledSensorMultiple_CALLBACK NULL
 #define EnabledSensorMultiple_DEFAULT NULL
 
@@ -1183,12 +1225,12 @@ extern const pb_msgdesc_t EnabledSensorMultiple_msg;
 #define CurrentMeasurement_size                  9
 #define D10Measurement_size                      21
 #define EDU0157Measurement_size                  51
-#define EnabledSensorMultiple_size               14
-#define Esp32Command_size                        946
+#define EnabledSensorMultiple_size               54
+#define Esp32Command_size                        1474
 #define IrrigationCommand_size                   4
 #define MeasurementMetadata_size                 18
 #define Measurement_size                         73
-#define MicroSDCommand_size                      943
+#define MicroSDCommand_size                      1471
 #define PCAP02Measurement_size                   9
 #define PageCommand_size                         20
 #define Phytos31Measurement_size                 18
@@ -1203,8 +1245,8 @@ extern const pb_msgdesc_t EnabledSensorMultiple_msg;
 #define Teros12Measurement_size                  33
 #define Teros21Measurement_size                  18
 #define TestCommand_size                         13
-#define UserConfigCommand_size                   499
-#define UserConfiguration_size                   494
+#define UserConfigCommand_size                   1139
+#define UserConfiguration_size                   1134
 #define VoltageDeltaMeasurement_size             6
 #define VoltageMeasurement_size                  9
 #define WATERMARK200SSMeasurement_size           9
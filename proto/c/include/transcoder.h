@@ -56,16 +56,17 @@ size_t EncodePowerMeasurement(uint32_t ts, uint32_t logger_id, uint32_t cell_id,
 /**
  * @brief Encodes power delta measurements
  *
- * The timestamp is not able to encode timezones and is references from UTC+0.
+ * Serializes a RepeatedPowerDeltas message with a single entry. The values are
+ * stored as is, delta encoding of sample streams is done by power_delta.h.
  * The serialized data is stored in @p buffer with the number of bytes written
  * being returned by the function. A return value of -1 indicates an error in
  * encoding.
  *
- * @param ts Unix epochs
+ * @param ts Unix epochs or milliseconds since the previous entry
  * @param logger_id Logger Id
  * @param cell_id Cell Id
- * @param voltage Voltage measured in mV
- * @param current Current measured in uA
+ * @param voltage Voltage or zigzag encoded voltage delta
+ * @param current Current or zigzag encoded current delta
  * @param buffer Buffer to store serialized measurement
  * @return Number of bytes in @p buffer
  */
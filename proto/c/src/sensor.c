@@ -167,6 +167,14 @@ SensorStatus EncodeSensorMeasurement(const SensorMeasurement *meas, uint8_t *buf
 
 SensorStatus EncodeRepeatedSensorMeasurements(Metadata meta, const SensorMeasurement meas[],
     size_t count, uint8_t* buffer, size_t size, size_t* length) {
+    return EncodeSequencedSensorMeasurements(0, meta, meas, count, buffer,
+                                             size, length);
+}
+
+
+SensorStatus EncodeSequencedSensorMeasurements(uint32_t seq, Metadata meta,
+    const SensorMeasurement meas[], size_t count, uint8_t* buffer, size_t size,
+    size_t* length) {
 
     RepeatedSensorMeasurements rep_meas = RepeatedSensorMeasurements_init_zero;
 
@@ -176,6 +184,7 @@ SensorStatus EncodeRepeatedSensorMeasurements(Metadata meta, const SensorMeasure
     if (sensor_status != SENSOR_OK) {
         return sensor_status;
     }
+    rep_meas.seq = seq;
 
     // encode
     pb_ostream_t ostream = pb_ostream_from_buffer(buffer, size);
@@ -191,6 +200,12 @@ SensorStatus EncodeRepeatedSensorMeasurements(Metadata meta, const SensorMeasure
 
 SensorStatus RepeatedSensorMeasurementsSize(Metadata meta, const SensorMeasurement meas[], 
         size_t count, size_t *size) {
+    return SequencedSensorMeasurementsSize(0, meta, meas, count, size);
+}
+
+
+SensorStatus SequencedSensorMeasurementsSize(uint32_t seq, Metadata meta,
+        const SensorMeasurement meas[], size_t count, size_t *size) {
 
     RepeatedSensorMeasurements rep_meas = RepeatedSensorMeasurements_init_zero;
 
@@ -200,6 +215,7 @@ SensorStatus RepeatedSensorMeasurementsSize(Metadata meta, const SensorMeasureme
     if (sensor_status != SENSOR_OK) {
         return sensor_status;
     }
+    rep_meas.seq = seq;
 
     // get size
     bool status = pb_get_encoded_size(
@@ -258,6 +274,22 @@ SensorStatus EncodeDoubleMeasurement(Metadata meta, double value, SensorType typ
 }
 
 
+SensorStatus EncodeSummaryMeasurement(Metadata meta, const Summary* summary,
+                                      SensorType type, uint8_t* buffer,
+                                      size_t* size) {
+    SensorMeasurement meas = SensorMeasurement_init_zero;
+
+    meas.meta = meta;
+    meas.has_meta = true;
+
+    meas.type = type;
+    meas.which_value = SensorMeasurement_summary_tag;
+    meas.value.summary = *summary;
+
+    return EncodeSensorMeasurement(&meas, buffer, size);
+}
+
+
 SensorStatus DecodeSensorMeasurement(const uint8_t* data, const size_t len,
                              SensorMeasurement* meas) {
     pb_istream_t istream = pb_istream_from_buffer(data, len);
@@ -15,6 +15,9 @@ PB_BIND(SensorResponse, SensorResponse, AUTO)
 PB_BIND(RepeatedSensorResponses, RepeatedSensorResponses, AUTO)
 
 
+PB_BIND(Summary, Summary, AUTO)
+
+
 PB_BIND(SensorMeasurement, SensorMeasurement, AUTO)
 
 
@@ -57,6 +57,45 @@ size_t EncodePowerMeasurement(uint32_t ts, uint32_t logger_id, uint32_t cell_id,
   return EncodeMeasurement(&meas, buffer);
 }
 
+/**
+ * @brief Encodes a single entry of RepeatedPowerDeltas
+ *
+ * Callback for the repeated entries field, @p arg points to a PowerDeltaEntry.
+ */
+static bool EncodePowerDeltaEntry(pb_ostream_t* stream,
+                                  const pb_field_t* field, void* const* arg) {
+  const PowerDeltaEntry* entry = *arg;
+
+  if (!pb_encode_tag_for_field(stream, field)) {
+    return false;
+  }
+
+  return pb_encode_submessage(stream, PowerDeltaEntry_fields, entry);
+}
+
+size_t EncodePowerDeltaMeasurement(uint32_t ts, uint32_t logger_id,
+                                   uint32_t cell_id, uint32_t voltage,
+                                   uint32_t current, uint8_t* buffer) {
+  PowerDeltaEntry entry = PowerDeltaEntry_init_zero;
+  entry.ts = ts;
+  entry.voltage_delta = voltage;
+  entry.current_delta = current;
+
+  RepeatedPowerDeltas deltas = RepeatedPowerDeltas_init_zero;
+  deltas.logger_id = logger_id;
+  deltas.cell_id = cell_id;
+  deltas.entries.funcs.encode = EncodePowerDeltaEntry;
+  deltas.entries.arg = &entry;
+
+  pb_ostream_t ostream = pb_ostream_from_buffer(buffer, 256);
+  bool status = pb_encode(&ostream, RepeatedPowerDeltas_fields, &deltas);
+  if (!status) {
+    return -1;
+  }
+
+  return ostream.bytes_written;
+}
+
 size_t EncodeTeros12Measurement(uint32_t ts, uint32_t logger_id,
                                 uint32_t cell_id, double vwc_raw,
                                 double vwc_adj, double temp, uint32_t ec,
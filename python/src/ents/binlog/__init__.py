@@ -0,0 +1,14 @@
+"""Decoder of the deferred binary log
+
+Turns the records of stm32/lib/binlog back into text with the table of
+format strings extracted by stm32/binlog_table.py.
+"""
+
+from .decode import BinlogDecoder, cobs_decode, format_record, load_table
+
+__all__ = [
+    "BinlogDecoder",
+    "cobs_decode",
+    "format_record",
+    "load_table",
+]
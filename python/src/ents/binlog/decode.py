@@ -0,0 +1,217 @@
+"""Binary log records
+
+Mirrors stm32/lib/binlog/src/binlog.c. Records are sent as 0x00, the COBS
+encoded record, 0x00, mixed with the text of APP_LOG. A record is
+
+    uint16 length of the rest of the record
+    uint8  verbose level
+    uint32 timestamp in ms
+    uint32 address of the format string, 0 for dropped records
+    ...    arguments
+
+with all fields little endian. The arguments are decoded following the
+conversions of the format string.
+"""
+
+import json
+import re
+import struct
+
+ID_DROPPED = 0
+
+HEADER = struct.Struct("<HBII")
+
+CONVERSION = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\d*)(?P<precision>\.\d*)?"
+    r"(?P<length>hh|h|ll|l|z|j|t|L)?(?P<conv>[diouxXcfFeEgGsH%])"
+)
+
+
+def load_table(path: str) -> dict[int, str]:
+    """Loads the format strings written by binlog_table.py.
+
+    Args:
+        path: Path to binlog.json.
+
+    Returns:
+        Format strings keyed by address.
+    """
+
+    with open(path) as f:
+        return {int(addr, 16): fmt for addr, fmt in json.load(f).items()}
+
+
+def cobs_decode(data: bytes) -> bytes:
+    """Decodes a COBS encoded frame without delimiters.
+
+    Args:
+        data: Encoded frame.
+
+    Returns:
+        Decoded data.
+
+    Raises:
+        ValueError: The frame is not valid COBS.
+    """
+
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("Invalid COBS frame")
+        out += data[i + 1 : i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def _take(args: bytes, pos: int, size: int) -> bytes:
+    """Slice of an argument, raising when the record is too short."""
+
+    if pos + size > len(args):
+        raise ValueError("Record too short for its format")
+    return args[pos : pos + size]
+
+
+def format_record(fmt: str, args: bytes) -> str:
+    """Formats the arguments of a record.
+
+    Args:
+        fmt: printf style format string, with %H for blobs.
+        args: Arguments of the record.
+
+    Returns:
+        Formatted text.
+
+    Raises:
+        ValueError: The arguments do not match the format.
+    """
+
+    out = []
+    pos = 0
+    last = 0
+    for match in CONVERSION.finditer(fmt):
+        out.append(fmt[last : match.start()])
+        last = match.end()
+
+        conv = match["conv"]
+        spec = "%" + match["flags"] + match["width"] + (match["precision"] or "")
+        wide = match["length"] == "ll"
+
+        if conv == "%":
+            out.append("%")
+            continue
+
+        if conv in "di":
+            size = 8 if wide else 4
+            value = int.from_bytes(_take(args, pos, size), "little", signed=True)
+        elif conv in "ouxXc":
+            size = 8 if wide else 4
+            value = int.from_bytes(_take(args, pos, size), "little")
+        elif conv in "fFeEgG":
+            size = 8
+            (value,) = struct.unpack("<d", _take(args, pos, size))
+        elif conv == "s":
+            end = args.find(b"\0", pos)
+            if end < 0:
+                raise ValueError("Unterminated string argument")
+            size = end + 1 - pos
+            value = args[pos:end].decode(errors="replace")
+        else:
+            (length,) = struct.unpack("<H", _take(args, pos, 2))
+            size = 2 + length
+            value = _take(args, pos + 2, length).hex().upper()
+            conv = "s"
+
+        if conv == "c":
+            value &= 0xFF
+        out.append((spec + conv) % value)
+        pos += size
+
+    out.append(fmt[last:])
+    if pos != len(args):
+        raise ValueError("Record longer than its format")
+    return "".join(out)
+
+
+class BinlogDecoder:
+    """Splits a log stream into text and decoded records.
+
+    Bytes between a pair of 0x00 are a frame. A frame that does not decode is
+    passed on as text and its closing 0x00 is taken as the start of the next
+    frame instead, so the decoder syncs up when started in the middle of a
+    frame.
+    """
+
+    def __init__(self, table: dict[int, str]):
+        """Creates a decoder.
+
+        Args:
+            table: Format strings keyed by address, see load_table.
+        """
+
+        self.table = table
+        self.in_frame = False
+        self.frame = bytearray()
+
+    def feed(self, data: bytes) -> str:
+        """Decodes the next chunk of the stream.
+
+        Args:
+            data: Bytes read from the node.
+
+        Returns:
+            Text and decoded records, in order.
+        """
+
+        out = []
+        for byte in data:
+            if byte != 0:
+                if self.in_frame:
+                    self.frame.append(byte)
+                else:
+                    out.append(chr(byte))
+                continue
+
+            if self.in_frame:
+                try:
+                    out.append(self.decode(bytes(self.frame)))
+                    self.in_frame = False
+                except ValueError:
+                    out.append(bytes(self.frame).decode(errors="replace"))
+                self.frame.clear()
+            else:
+                self.in_frame = True
+
+        return "".join(out)
+
+    def decode(self, frame: bytes) -> str:
+        """Decodes a single frame.
+
+        Args:
+            frame: COBS encoded record without delimiters.
+
+        Returns:
+            Record formatted with a timestamp like APP_LOG.
+
+        Raises:
+            ValueError: The frame is not a valid record.
+        """
+
+        record = cobs_decode(frame)
+        if len(record) < HEADER.size:
+            raise ValueError("Record too short")
+        length, _, timestamp, fmt_id = HEADER.unpack_from(record)
+        if length != len(record) - 2:
+            raise ValueError("Record length does not match the frame")
+        args = record[HEADER.size :]
+
+        prefix = f"{timestamp // 1000}s{timestamp % 1000:03d}:"
+        if fmt_id == ID_DROPPED:
+            (count,) = struct.unpack("<I", _take(args, 0, 4))
+            return f"{prefix}binlog: {count} records dropped\r\n"
+        if fmt_id not in self.table:
+            return f"{prefix}binlog: unknown format 0x{fmt_id:08x}\r\n"
+        return prefix + format_record(self.table[fmt_id], args)
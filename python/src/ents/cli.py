@@ -5,7 +5,9 @@ from datetime import datetime, timedelta
 
 import numpy as np
 import pandas as pd
+import serial
 
+from .binlog import BinlogDecoder, load_table
 from .calibrate.linear_regression import (
     linear_regression,
     print_coef,
@@ -19,6 +21,9 @@ from .calibrate.plots import (
     plot_residuals_hist,
 )
 from .calibrate.recorder import Recorder
+from .energy import Currents, decode_energy, estimate, format_estimate
+from .energy import find_blobs as find_energy_blobs
+from .prof import decode_stats, find_blobs, format_stats
 from .proto.decode import decode_measurement, decode_response
 from .proto.encode import (
     encode_phytos31_measurement,
@@ -50,6 +55,9 @@ def entry():
     create_calib_parser(subparsers)
     create_sim_parser(subparsers)
     create_sim_generic_parser(subparsers)
+    create_binlog_parser(subparsers)
+    create_prof_parser(subparsers)
+    create_energy_parser(subparsers)
 
     args = parser.parse_args()
     args.func(args)
@@ -294,6 +302,188 @@ def create_calib_parser(subparsers):
     return calib_p
 
 
+def create_binlog_parser(subparsers):
+    """Creates the binary log subparser
+
+    Args:
+        subparsers: Reference to subparser group
+    Returns:
+        Reference to new subparser
+    """
+
+    binlog_p = subparsers.add_parser(
+        "binlog", help="Print the log of a node, decoding BINLOG records"
+    )
+    binlog_p.add_argument(
+        "--baud", type=int, default=115200, help="Baud rate (default: 115200)"
+    )
+    binlog_p.add_argument(
+        "--file",
+        action="store_true",
+        help="Read a capture of the log from a file instead of a serial port",
+    )
+    binlog_p.add_argument(
+        "table", type=str, help="binlog.json from the build directory"
+    )
+    binlog_p.add_argument("port", type=str, help="Board serial port or capture")
+    binlog_p.set_defaults(func=binlog)
+
+    return binlog_p
+
+
+def binlog(args):
+    decoder = BinlogDecoder(load_table(args.table))
+
+    if args.file:
+        with open(args.port, "rb") as f:
+            print(decoder.feed(f.read()), end="")
+        return
+
+    with serial.Serial(args.port, args.baud, timeout=0.1) as ser:
+        try:
+            while True:
+                print(decoder.feed(ser.read(256)), end="", flush=True)
+        except KeyboardInterrupt as _:
+            pass
+
+
+def create_prof_parser(subparsers):
+    """Creates the profiling subparser
+
+    Args:
+        subparsers: Reference to subparser group
+    Returns:
+        Reference to new subparser
+    """
+
+    prof_p = subparsers.add_parser(
+        "prof", help="Print the profiling tables logged by a node"
+    )
+    prof_p.add_argument(
+        "--baud", type=int, default=115200, help="Baud rate (default: 115200)"
+    )
+    prof_p.add_argument(
+        "--file",
+        action="store_true",
+        help="Read a capture of the log from a file instead of a serial port",
+    )
+    prof_p.add_argument("table", type=str, help="binlog.json from the build directory")
+    prof_p.add_argument("port", type=str, help="Board serial port or capture")
+    prof_p.set_defaults(func=prof)
+
+    return prof_p
+
+
+def prof(args):
+    decoder = BinlogDecoder(load_table(args.table))
+
+    if args.file:
+        with open(args.port, "rb") as f:
+            blobs = find_blobs(decoder.feed(f.read()))
+        if not blobs:
+            print("No profiling table in the capture")
+            return
+        print(format_stats(decode_stats(blobs[-1])))
+        return
+
+    # tables are only complete at the end of their line
+    text = ""
+    with serial.Serial(args.port, args.baud, timeout=0.1) as ser:
+        try:
+            while True:
+                text += decoder.feed(ser.read(256))
+                lines = text.split("\n")
+                text = lines.pop()
+                for blob in find_blobs("\n".join(lines)):
+                    print(format_stats(decode_stats(blob)), end="\n\n", flush=True)
+        except KeyboardInterrupt as _:
+            pass
+
+
+def create_energy_parser(subparsers):
+    """Creates the energy subparser
+
+    Args:
+        subparsers: Reference to subparser group
+    Returns:
+        Reference to new subparser
+    """
+
+    energy_p = subparsers.add_parser(
+        "energy", help="Print the energy accounts logged by a node"
+    )
+    energy_p.add_argument(
+        "--baud", type=int, default=115200, help="Baud rate (default: 115200)"
+    )
+    energy_p.add_argument(
+        "--file",
+        action="store_true",
+        help="Read a capture of the log from a file instead of a serial port",
+    )
+    defaults = Currents()
+    for name, help_text in [
+        ("run_ma", "Current while awake in mA"),
+        ("sleep_ma", "Current in sleep mode in mA"),
+        ("stop_ma", "Current in Stop2 mode in mA"),
+        ("rx_ma", "Current added by the radio receiving in mA"),
+        ("tx_ma", "Current added by the radio transmitting in mA"),
+        ("voltage", "Supply voltage in V"),
+    ]:
+        default = getattr(defaults, name)
+        energy_p.add_argument(
+            f"--{name.replace('_', '-')}",
+            dest=name,
+            type=float,
+            default=default,
+            help=f"{help_text} (default: {default})",
+        )
+    energy_p.add_argument(
+        "table", type=str, help="binlog.json from the build directory"
+    )
+    energy_p.add_argument("port", type=str, help="Board serial port or capture")
+    energy_p.set_defaults(func=energy)
+
+    return energy_p
+
+
+def energy(args):
+    decoder = BinlogDecoder(load_table(args.table))
+    currents = Currents(
+        run_ma=args.run_ma,
+        sleep_ma=args.sleep_ma,
+        stop_ma=args.stop_ma,
+        rx_ma=args.rx_ma,
+        tx_ma=args.tx_ma,
+        voltage=args.voltage,
+    )
+
+    def report(blob):
+        accounts = decode_energy(blob)
+        return format_estimate(accounts, estimate(accounts, currents))
+
+    if args.file:
+        with open(args.port, "rb") as f:
+            blobs = find_energy_blobs(decoder.feed(f.read()))
+        if not blobs:
+            print("No energy accounts in the capture")
+            return
+        print(report(blobs[-1]))
+        return
+
+    # accounts are only complete at the end of their line
+    text = ""
+    with serial.Serial(args.port, args.baud, timeout=0.1) as ser:
+        try:
+            while True:
+                text += decoder.feed(ser.read(256))
+                lines = text.split("\n")
+                text = lines.pop()
+                for blob in find_energy_blobs("\n".join(lines)):
+                    print(report(blob), end="\n\n", flush=True)
+        except KeyboardInterrupt as _:
+            pass
+
+
 def create_encode_generic_parser(subparsers):
     """Create generic encode command subparser
 
@@ -349,7 +539,11 @@ def create_encode_generic_parser(subparsers):
         metavar=("idx", "status"),
         action="append",
         required=True,
-        help="Specify as: --resp <idx> <status>",
+        help="Specify as: --resp <idx> <status>, idx counts the measurements "
+        "from 1, 0 for all of them",
+    )
+    response_parser.add_argument(
+        "--seq", type=int, default=0, help="Sequence number of the upload"
     )
     response_parser.set_defaults(func=handle_encode_generic_response)
 
@@ -404,6 +598,7 @@ def handle_encode_generic_response(args):
     """Takes arguments and encode a sensor response message"""
 
     resp = {
+        "seq": args.seq,
         "responses": [],
     }
 
@@ -412,8 +607,8 @@ def handle_encode_generic_response(args):
         status = r[1]
         resp["responses"].append(
             {
-                "uploadIndex": idx,
-                "status": status,
+                "idx": idx,
+                "error": status,
             }
         )
 
@@ -0,0 +1,17 @@
+"""Compression codecs shared with the firmware
+
+Implementations are bit-exact with the C versions in stm32/lib/compress so
+payloads compressed on the node can be decompressed by the backend.
+"""
+
+from .codec import Codec, compress_payload, decompress_payload, encode_payload
+from .lz77 import compress_lz77, decompress_lz77
+
+__all__ = [
+    "Codec",
+    "compress_lz77",
+    "compress_payload",
+    "decompress_lz77",
+    "decompress_payload",
+    "encode_payload",
+]
@@ -0,0 +1,101 @@
+"""Per payload codec dispatch
+
+Mirrors stm32/lib/compress/src/codec.c. Compressed payloads start with a one
+byte codec id followed by the output of the codec.
+"""
+
+from enum import IntEnum
+
+from .delta import compress_delta, decompress_delta
+from .dictionary import DICT, DICT_ID
+from .lz77 import compress_lz77, decompress_lz77
+from .rle import compress_rle, decompress_rle
+
+
+class Codec(IntEnum):
+    """Codec ids stored in the first byte of a payload."""
+
+    NONE = 0
+    RLE = 1
+    DELTA = 2
+    LZ77 = 3
+    LZ77_DICT = 4
+
+
+def encode_payload(data: bytes, codec: Codec) -> bytes:
+    """Encodes a payload with a specific codec.
+
+    Args:
+        data: Uncompressed payload.
+        codec: Codec to use.
+
+    Returns:
+        Codec id followed by the compressed payload.
+    """
+
+    if codec == Codec.NONE:
+        body = bytes(data)
+    elif codec == Codec.RLE:
+        body = compress_rle(data)
+    elif codec == Codec.DELTA:
+        body = compress_delta(data)
+    elif codec == Codec.LZ77:
+        body = compress_lz77(data)
+    elif codec == Codec.LZ77_DICT:
+        body = compress_lz77(data, DICT, DICT_ID)
+    else:
+        raise ValueError(f"Unknown codec {codec}")
+
+    return bytes([codec]) + body
+
+
+def compress_payload(data: bytes, codecs=tuple(Codec)) -> bytes:
+    """Encodes a payload with the codec producing the smallest output.
+
+    Ties go to the codec tried first, matching CodecCompress.
+
+    Args:
+        data: Uncompressed payload.
+        codecs: Codecs to try, cheapest first.
+
+    Returns:
+        Codec id followed by the compressed payload.
+    """
+
+    best = None
+    for codec in codecs:
+        out = encode_payload(data, codec)
+        if best is None or len(out) < len(best):
+            best = out
+    return best
+
+
+def decompress_payload(data: bytes) -> bytes:
+    """Decodes a payload created by the firmware.
+
+    Args:
+        data: Codec id followed by the compressed payload.
+
+    Returns:
+        Uncompressed payload.
+
+    Raises:
+        ValueError: Unknown codec or corrupt payload.
+    """
+
+    if len(data) < 1:
+        raise ValueError("Empty payload")
+
+    codec = data[0]
+    body = data[1:]
+
+    if codec == Codec.NONE:
+        return bytes(body)
+    elif codec == Codec.RLE:
+        return decompress_rle(body)
+    elif codec == Codec.DELTA:
+        return decompress_delta(body)
+    elif codec in (Codec.LZ77, Codec.LZ77_DICT):
+        return decompress_lz77(body)
+    else:
+        raise ValueError(f"Unknown codec {codec}")
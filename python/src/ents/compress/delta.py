@@ -0,0 +1,118 @@
+"""Record stride delta with zero run coding
+
+Mirrors stm32/lib/compress/src/delta.c. Each byte is XORed with the byte one
+stride earlier, the stride being picked as the one producing the most zeros.
+The stream is the stride followed by (zeros, literals) varint pairs with the
+literal bytes following each pair.
+"""
+
+MAX_STRIDE = 32
+
+
+def _write_varint(out: bytearray, value: int):
+    while True:
+        b = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            return
+
+
+def _read_varint(data: bytes, idx: int) -> tuple[int, int]:
+    value = 0
+    shift = 0
+    while True:
+        if idx >= len(data) or shift >= 32:
+            raise ValueError("Invalid varint")
+        b = data[idx]
+        idx += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            return value, idx
+
+
+def _delta(data: bytes, stride: int) -> bytes:
+    return bytes(
+        data[i] if i < stride else data[i] ^ data[i - stride] for i in range(len(data))
+    )
+
+
+def _best_stride(data: bytes) -> int:
+    """Stride producing the most zeros, ties go to the smallest."""
+
+    best_stride = 1
+    best_zeros = 0
+    for stride in range(1, min(MAX_STRIDE, len(data) - 1) + 1):
+        zeros = _delta(data, stride).count(0)
+        if zeros > best_zeros:
+            best_zeros = zeros
+            best_stride = stride
+    return best_stride
+
+
+def compress_delta(data: bytes) -> bytes:
+    """Delta encodes data.
+
+    Args:
+        data: Uncompressed bytes.
+
+    Returns:
+        Compressed stream.
+    """
+
+    stride = _best_stride(data)
+    delta = _delta(data, stride)
+
+    out = bytearray([stride])
+    i = 0
+    while i < len(delta):
+        zeros = 0
+        while i + zeros < len(delta) and delta[i + zeros] == 0:
+            zeros += 1
+        lit = 0
+        while i + zeros + lit < len(delta) and delta[i + zeros + lit] != 0:
+            lit += 1
+
+        _write_varint(out, zeros)
+        _write_varint(out, lit)
+        out += delta[i + zeros : i + zeros + lit]
+        i += zeros + lit
+
+    return bytes(out)
+
+
+def decompress_delta(data: bytes) -> bytes:
+    """Decompresses a stream created by compress_delta.
+
+    Args:
+        data: Compressed stream.
+
+    Returns:
+        Uncompressed bytes.
+
+    Raises:
+        ValueError: Corrupt stream.
+    """
+
+    if len(data) < 1 or not 1 <= data[0] <= MAX_STRIDE:
+        raise ValueError("Invalid stride")
+    stride = data[0]
+
+    out = bytearray()
+    idx = 1
+    while idx < len(data):
+        zeros, idx = _read_varint(data, idx)
+        lit, idx = _read_varint(data, idx)
+        if idx + lit > len(data):
+            raise ValueError("Truncated literal")
+
+        delta = bytes(zeros) + data[idx : idx + lit]
+        idx += lit
+        for d in delta:
+            pos = len(out)
+            out.append(d if pos < stride else d ^ out[pos - stride])
+
+    return bytes(out)
@@ -0,0 +1,24 @@
+"""Static dictionaries for LZ77
+
+Generated by extras/compression/train_dict.py, do not edit. The same
+dictionary is in stm32/lib/compress/src/lz77_dict.c.
+"""
+
+DICT_ID = 1
+
+DICT = bytes.fromhex(
+    "0a0a0801100118c1b0ffbf06120919910a0a080110011887adffbf0612091991"
+    "0a0a0801100118c9e0e0bf06120919910a0a0804100718f0abe3ac0512121100"
+    "8125c9f73feb3f19ea989c0c7837483f485a8fe73f19801606ffaf1c473f0a0a"
+    "37efc6e33f1997c087398eea453f0a0afa11d5df3f19ad554a0648a2443f0a0a"
+    "651cfcd73f1982ab5c0e2945433f0a0a5deb0ad03f199bd39e0a92d4413f0a0a"
+    "1212119d8125c9f73feb3f19ea989c0c12121118a9a8485a8fe73f19801606ff"
+    "1212114fe92f37efc6e33f1997c0873912121196071cfa11d5df3f19ad554a06"
+    "121211e05ba15deb0ad03f199bd39e0a121211787a03651cfcd73f1982ab5c0e"
+    "1999d0655ff751403f0a0a0801100118bf061212117993e01b0a13c03f1999d0"
+    "ffbf0612091991cb7f48bf7d3d3f0a0a"
+)
+
+DICTIONARIES = {
+    DICT_ID: DICT,
+}
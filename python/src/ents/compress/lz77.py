@@ -0,0 +1,203 @@
+"""LZ77 codec primed with a static dictionary
+
+Mirrors stm32/lib/compress/src/lz77.c. The stream format is:
+
+    dictionary id (1 byte, 0 for none)
+    uncompressed length (base 128 varint)
+    tokens packed MSB first
+        0 + 8 bit literal
+        1 + 11 bit distance - 1 + 5 bit length - 3
+
+The window is the dictionary followed by the bytes already decoded, so a
+match can reference the dictionary from the first byte of a payload. The
+encoder is greedy and picks the longest match, preferring the closest one on
+ties, which keeps the output identical to the firmware.
+"""
+
+from .dictionary import DICTIONARIES
+
+MIN_MATCH = 3
+DISTANCE_BITS = 11
+LENGTH_BITS = 5
+WINDOW_SIZE = 1 << DISTANCE_BITS
+MAX_MATCH = MIN_MATCH + (1 << LENGTH_BITS) - 1
+MAX_DICT_SIZE = 1024
+
+
+class _BitWriter:
+    """MSB first bit packer"""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.bits = 0
+
+    def write(self, value: int, nbits: int):
+        for i in range(nbits - 1, -1, -1):
+            if self.bits % 8 == 0:
+                self.buffer.append(0)
+            if (value >> i) & 1:
+                self.buffer[-1] |= 0x80 >> (self.bits % 8)
+            self.bits += 1
+
+
+class _BitReader:
+    """MSB first bit reader"""
+
+    def __init__(self, data: bytes):
+        self.data = data
+        self.bits = 0
+
+    def read(self, nbits: int) -> int:
+        if self.bits + nbits > len(self.data) * 8:
+            raise ValueError("Unexpected end of stream")
+
+        value = 0
+        for _ in range(nbits):
+            byte = self.data[self.bits // 8]
+            value = (value << 1) | ((byte >> (7 - self.bits % 8)) & 1)
+            self.bits += 1
+        return value
+
+
+def _longest_match(window: bytes, cur: int, end: int) -> tuple[int, int]:
+    """Finds the longest match for window[cur:] in the preceding window.
+
+    Args:
+        window: Dictionary followed by the input data.
+        cur: Position of the lookahead in window.
+        end: Length of window.
+
+    Returns:
+        Tuple of (distance, length), length is 0 if no match was found.
+    """
+
+    best_dist = 0
+    best_len = 0
+    max_len = min(MAX_MATCH, end - cur)
+
+    for dist in range(1, min(cur, WINDOW_SIZE) + 1):
+        start = cur - dist
+        length = 0
+        while length < max_len and window[start + length] == window[cur + length]:
+            length += 1
+        if length > best_len:
+            best_dist = dist
+            best_len = length
+            if length == max_len:
+                break
+
+    return best_dist, best_len
+
+
+def compress_lz77(data: bytes, dictionary: bytes = b"", dict_id: int = 0) -> bytes:
+    """Compresses data with LZ77 primed by a static dictionary.
+
+    Args:
+        data: Uncompressed bytes.
+        dictionary: Bytes used to prime the window.
+        dict_id: Id stored in the stream to select the dictionary on decode.
+            Must be 0 if no dictionary is used.
+
+    Returns:
+        Compressed stream.
+
+    Raises:
+        ValueError: Invalid dictionary or id.
+    """
+
+    if len(dictionary) > MAX_DICT_SIZE:
+        raise ValueError(f"Dictionary larger than {MAX_DICT_SIZE} bytes")
+    if not 0 <= dict_id <= 0xFF or (dict_id == 0) != (len(dictionary) == 0):
+        raise ValueError("Invalid dictionary id")
+
+    out = bytearray([dict_id])
+
+    length = len(data)
+    while True:
+        b = length & 0x7F
+        length >>= 7
+        if length:
+            out.append(b | 0x80)
+        else:
+            out.append(b)
+            break
+
+    window = bytes(dictionary) + bytes(data)
+    cur = len(dictionary)
+    end = len(window)
+
+    bw = _BitWriter()
+    while cur < end:
+        dist, length = _longest_match(window, cur, end)
+        if length >= MIN_MATCH:
+            bw.write(1, 1)
+            bw.write(dist - 1, DISTANCE_BITS)
+            bw.write(length - MIN_MATCH, LENGTH_BITS)
+            cur += length
+        else:
+            bw.write(0, 1)
+            bw.write(window[cur], 8)
+            cur += 1
+
+    return bytes(out + bw.buffer)
+
+
+def decompress_lz77(data: bytes, dictionaries: dict[int, bytes] | None = None) -> bytes:
+    """Decompresses a stream created by compress_lz77.
+
+    Args:
+        data: Compressed stream.
+        dictionaries: Mapping of dictionary id to bytes. Defaults to the
+            dictionaries shipped with the firmware.
+
+    Returns:
+        Uncompressed bytes.
+
+    Raises:
+        ValueError: Corrupt stream or unknown dictionary.
+    """
+
+    if dictionaries is None:
+        dictionaries = DICTIONARIES
+
+    if len(data) < 2:
+        raise ValueError("Stream too short")
+
+    dict_id = data[0]
+    if dict_id == 0:
+        dictionary = b""
+    elif dict_id in dictionaries:
+        dictionary = dictionaries[dict_id]
+    else:
+        raise ValueError(f"Unknown dictionary id {dict_id}")
+
+    idx = 1
+    length = 0
+    shift = 0
+    while True:
+        if idx >= len(data) or shift >= 32:
+            raise ValueError("Invalid length")
+        b = data[idx]
+        idx += 1
+        length |= (b & 0x7F) << shift
+        shift += 7
+        if not b & 0x80:
+            break
+
+    window = bytearray(dictionary)
+    start = len(window)
+    end = start + length
+
+    br = _BitReader(data[idx:])
+    while len(window) < end:
+        if br.read(1):
+            dist = br.read(DISTANCE_BITS) + 1
+            match_len = br.read(LENGTH_BITS) + MIN_MATCH
+            if dist > len(window) or len(window) + match_len > end:
+                raise ValueError("Invalid match")
+            for _ in range(match_len):
+                window.append(window[-dist])
+        else:
+            window.append(br.read(8))
+
+    return bytes(window[start:])
@@ -0,0 +1,90 @@
+"""PackBits style run length encoding
+
+Mirrors stm32/lib/compress/src/rle.c. Each packet starts with a control byte:
+
+    0x00-0x7F: followed by control + 1 literal bytes
+    0x80-0xFF: followed by a single byte repeated (control & 0x7F) + 3 times
+"""
+
+MIN_RUN = 3
+MAX_RUN = MIN_RUN + 0x7F
+MAX_LITERAL = 128
+
+
+def _run_length(data: bytes, start: int) -> int:
+    """Length of the run of identical bytes at start, capped at MAX_RUN."""
+
+    run = 1
+    while (
+        start + run < len(data) and run < MAX_RUN and data[start + run] == data[start]
+    ):
+        run += 1
+    return run
+
+
+def compress_rle(data: bytes) -> bytes:
+    """Run length encodes data.
+
+    Args:
+        data: Uncompressed bytes.
+
+    Returns:
+        Compressed stream.
+    """
+
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = _run_length(data, i)
+        if run >= MIN_RUN:
+            out.append(0x80 | (run - MIN_RUN))
+            out.append(data[i])
+            i += run
+            continue
+
+        lit = run
+        while (
+            i + lit < len(data)
+            and lit < MAX_LITERAL
+            and _run_length(data, i + lit) < MIN_RUN
+        ):
+            lit += 1
+
+        out.append(lit - 1)
+        out += data[i : i + lit]
+        i += lit
+
+    return bytes(out)
+
+
+def decompress_rle(data: bytes) -> bytes:
+    """Decompresses a stream created by compress_rle.
+
+    Args:
+        data: Compressed stream.
+
+    Returns:
+        Uncompressed bytes.
+
+    Raises:
+        ValueError: Corrupt stream.
+    """
+
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        ctrl = data[i]
+        i += 1
+        if ctrl & 0x80:
+            if i >= len(data):
+                raise ValueError("Truncated run")
+            out += bytes([data[i]]) * ((ctrl & 0x7F) + MIN_RUN)
+            i += 1
+        else:
+            lit = ctrl + 1
+            if i + lit > len(data):
+                raise ValueError("Truncated literal")
+            out += data[i : i + lit]
+            i += lit
+
+    return bytes(out)
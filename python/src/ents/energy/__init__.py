@@ -0,0 +1,27 @@
+"""Decoder of the energy accounts
+
+Reads the accounts of stm32/lib/energy, which the firmware logs periodically
+as a BINLOG record, and estimates the energy per measurement and per uplink.
+"""
+
+from .decode import (
+    Account,
+    Currents,
+    EnergyReport,
+    Estimate,
+    decode_energy,
+    estimate,
+    find_blobs,
+    format_estimate,
+)
+
+__all__ = [
+    "Account",
+    "Currents",
+    "EnergyReport",
+    "Estimate",
+    "decode_energy",
+    "estimate",
+    "find_blobs",
+    "format_estimate",
+]
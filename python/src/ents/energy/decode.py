@@ -0,0 +1,277 @@
+"""Energy accounts
+
+Mirrors EnergySerialize in stm32/lib/energy/src/energy.c. The blob is
+
+    uint8  version
+    uint8  number of accounts
+    uint8  number of radio states
+    uint32 ticks per second
+
+followed by each account as
+
+    uint32 number of entries
+    uint64 time in ticks
+    uint64 time waiting in ticks
+
+and each radio state as
+
+    uint32 number of entries
+    uint64 time in ticks
+
+with all fields little endian. The first accounts are the sequencer tasks by
+their CFG_SEQ_Task_* id and the last four are the run, wait, sleep and stop
+states. The firmware logs the blob as hex in "Energy: %H" records.
+"""
+
+import re
+import struct
+from dataclasses import dataclass, field
+
+VERSION = 1
+
+HEADER = struct.Struct("<BBBI")
+
+ACCOUNT = struct.Struct("<IQQ")
+
+RADIO = struct.Struct("<IQ")
+
+ENERGY = re.compile(r"Energy: ([0-9A-F]*)")
+
+# CFG_SEQ_Task_Id_t in stm32/Inc/utilities_def.h
+TASKS = [
+    "LmHandlerProcess",
+    "LoRaSend",
+    "LoRaStoreContext",
+    "LoRaStopJoin",
+    "Measurement",
+    "TimeSync",
+    "WiFiUpload",
+    "UserConfigStop",
+    "UserConfigCheck",
+]
+
+# EnergyState after the tasks
+STATES = ["run", "wait", "sleep", "stop"]
+
+# EnergyRadioState
+RADIO_STATES = ["radio off", "radio rx", "radio tx"]
+
+# tasks that send an uplink and the stack that handles it
+UPLINK_TASKS = ["LoRaSend", "WiFiUpload"]
+STACK_TASKS = ["LmHandlerProcess"]
+
+
+@dataclass
+class Account:
+    """Time charged to an account, in seconds."""
+
+    name: str
+    count: int
+    time: float
+    wait: float = 0.0
+
+
+@dataclass
+class EnergyReport:
+    """Decoded accounts of a node."""
+
+    tasks: list[Account]
+    states: list[Account]
+    radio: list[Account]
+
+    def get(self, name: str) -> Account:
+        """Finds an account by name.
+
+        Raises:
+            KeyError: No account has the name.
+        """
+
+        for account in self.tasks + self.states + self.radio:
+            if account.name == name:
+                return account
+        raise KeyError(name)
+
+    @property
+    def duration(self) -> float:
+        """Wall time covered by the accounts."""
+
+        return sum(a.time for a in self.tasks + self.states)
+
+
+@dataclass
+class Currents:
+    """Current draw of the board, defaults of ENERGY_CURRENTS_DEFAULT."""
+
+    run_ma: float = 11.811
+    sleep_ma: float = 4.820
+    stop_ma: float = 4.820
+    rx_ma: float = 5.0
+    tx_ma: float = 100.054
+    voltage: float = 3.9
+
+    def state(self, name: str) -> float:
+        """Current of an account or radio state in mA."""
+
+        return {
+            "sleep": self.sleep_ma,
+            "stop": self.stop_ma,
+            "radio off": 0.0,
+            "radio rx": self.rx_ma,
+            "radio tx": self.tx_ma,
+        }.get(name, self.run_ma)
+
+
+@dataclass
+class Estimate:
+    """Energy of a report, in J, and the mean current in mA."""
+
+    energy: dict[str, float] = field(default_factory=dict)
+    total: float = 0.0
+    duration: float = 0.0
+    per_measurement: float = 0.0
+    per_uplink: float = 0.0
+    mean_current: float = 0.0
+
+
+def decode_energy(blob: bytes) -> EnergyReport:
+    """Decodes energy accounts.
+
+    Args:
+        blob: Accounts written by EnergySerialize.
+
+    Returns:
+        Accounts with tasks that never ran left out.
+
+    Raises:
+        ValueError: The blob is not valid.
+    """
+
+    if len(blob) < HEADER.size:
+        raise ValueError("Energy accounts too short")
+    version, accounts, radio_states, ticks_per_second = HEADER.unpack_from(blob)
+    if version != VERSION:
+        raise ValueError(f"Unsupported energy accounts version {version}")
+    if len(blob) != HEADER.size + accounts * ACCOUNT.size + radio_states * RADIO.size:
+        raise ValueError("Energy accounts length does not match its accounts")
+    if accounts < len(STATES) or radio_states != len(RADIO_STATES):
+        raise ValueError("Energy accounts without the low power or radio states")
+    if ticks_per_second == 0:
+        raise ValueError("Energy accounts without a tick rate")
+
+    max_tasks = accounts - len(STATES)
+    tasks = []
+    states = []
+    for i in range(accounts):
+        count, ticks, wait = ACCOUNT.unpack_from(blob, HEADER.size + i * ACCOUNT.size)
+        if i >= max_tasks:
+            name = STATES[i - max_tasks]
+        elif i < len(TASKS):
+            name = TASKS[i]
+        else:
+            name = f"task_{i}"
+        account = Account(
+            name=name,
+            count=count,
+            time=ticks / ticks_per_second,
+            wait=wait / ticks_per_second,
+        )
+        if i >= max_tasks:
+            states.append(account)
+        elif count or ticks:
+            tasks.append(account)
+
+    radio = []
+    offset = HEADER.size + accounts * ACCOUNT.size
+    for i, name in enumerate(RADIO_STATES):
+        count, ticks = RADIO.unpack_from(blob, offset + i * RADIO.size)
+        radio.append(Account(name=name, count=count, time=ticks / ticks_per_second))
+
+    return EnergyReport(tasks=tasks, states=states, radio=radio)
+
+
+def estimate(report: EnergyReport, currents: Currents = None) -> Estimate:
+    """Estimates the energy of a report.
+
+    A measurement is the Measurement task including its waits. An uplink is
+    the task that sends it, the LoRaWAN stack and the radio, divided by the
+    number of uplinks.
+
+    Args:
+        report: Output of decode_energy.
+        currents: Current draw of the board, the defaults if None.
+
+    Returns:
+        Energy of every account and the estimates.
+    """
+
+    if currents is None:
+        currents = Currents()
+
+    def joules(account: Account, wait: bool = False) -> float:
+        time = account.time + (account.wait if wait else 0.0)
+        return time * currents.state(account.name) * 1e-3 * currents.voltage
+
+    result = Estimate(duration=report.duration)
+    for account in report.tasks + report.states + report.radio:
+        result.energy[account.name] = joules(account)
+    result.total = sum(result.energy.values())
+    if result.duration:
+        result.mean_current = result.total / result.duration / currents.voltage * 1e3
+
+    by_name = {a.name: a for a in report.tasks}
+    measurement = by_name.get("Measurement")
+    if measurement is not None and measurement.count:
+        result.per_measurement = joules(measurement, wait=True) / measurement.count
+
+    uplinks = sum(by_name[n].count for n in UPLINK_TASKS if n in by_name)
+    if uplinks:
+        uplink = sum(
+            joules(by_name[n], wait=True)
+            for n in UPLINK_TASKS + STACK_TASKS
+            if n in by_name
+        )
+        uplink += result.energy["radio rx"] + result.energy["radio tx"]
+        result.per_uplink = uplink / uplinks
+
+    return result
+
+
+def find_blobs(text: str) -> list[bytes]:
+    """Finds the energy accounts in a decoded log.
+
+    Args:
+        text: Log decoded by BinlogDecoder.
+
+    Returns:
+        Accounts in the order they were logged.
+    """
+
+    return [bytes.fromhex(match) for match in ENERGY.findall(text)]
+
+
+def format_estimate(report: EnergyReport, result: Estimate) -> str:
+    """Formats energy accounts and their estimate.
+
+    Args:
+        report: Output of decode_energy.
+        result: Output of estimate.
+
+    Returns:
+        Table of the accounts followed by the estimates.
+    """
+
+    lines = [
+        f"{'account':<18}{'count':>10}{'time s':>12}{'wait s':>10}"
+        f"{'time %':>10}{'energy mJ':>12}"
+    ]
+    for a in report.tasks + report.states + report.radio:
+        share = a.time / report.duration * 100 if report.duration else 0.0
+        lines.append(
+            f"{a.name:<18}{a.count:>10}{a.time:>12.3f}{a.wait:>10.3f}"
+            f"{share:>10.3f}{result.energy[a.name] * 1e3:>12.3f}"
+        )
+    lines.append("")
+    lines.append(f"Energy per measurement: {result.per_measurement * 1e3:.3f} mJ")
+    lines.append(f"Energy per uplink: {result.per_uplink * 1e3:.3f} mJ")
+    lines.append(f"Mean current: {result.mean_current:.3f} mA")
+    return "\n".join(lines)
@@ -0,0 +1,14 @@
+"""Decoder of the profiling table
+
+Reads the table of stm32/lib/prof, which the firmware logs periodically as
+a BINLOG record.
+"""
+
+from .decode import ScopeStats, decode_stats, find_blobs, format_stats
+
+__all__ = [
+    "ScopeStats",
+    "decode_stats",
+    "find_blobs",
+    "format_stats",
+]
@@ -0,0 +1,125 @@
+"""Profiling table
+
+Mirrors ProfSerialize in stm32/lib/prof/src/prof.c. The table is
+
+    uint8  version
+    uint8  number of entries
+    uint32 ticks per second
+
+followed by each entry as
+
+    char[12] name padded with NUL
+    uint32   number of calls
+    uint32   shortest call in ticks
+    uint32   longest call in ticks
+    uint64   sum of all calls in ticks
+
+with all fields little endian. The firmware logs the table as a hex blob in
+"Profile: %H" records.
+"""
+
+import re
+import struct
+from dataclasses import dataclass
+
+VERSION = 1
+
+NAME_SIZE = 12
+
+HEADER = struct.Struct("<BBI")
+
+ENTRY = struct.Struct(f"<{NAME_SIZE}sIIIQ")
+
+PROFILE = re.compile(r"Profile: ([0-9A-F]*)")
+
+
+@dataclass
+class ScopeStats:
+    """Statistics of a scope, in seconds."""
+
+    name: str
+    count: int
+    min: float
+    max: float
+    total: float
+
+    @property
+    def mean(self) -> float:
+        """Mean time of a call, 0 without calls."""
+
+        return self.total / self.count if self.count else 0.0
+
+
+def decode_stats(blob: bytes) -> list[ScopeStats]:
+    """Decodes a profiling table.
+
+    Args:
+        blob: Table written by ProfSerialize.
+
+    Returns:
+        Statistics of every entry, in the order of the table.
+
+    Raises:
+        ValueError: The blob is not a valid table.
+    """
+
+    if len(blob) < HEADER.size:
+        raise ValueError("Profiling table too short")
+    version, count, ticks_per_second = HEADER.unpack_from(blob)
+    if version != VERSION:
+        raise ValueError(f"Unsupported profiling table version {version}")
+    if len(blob) != HEADER.size + count * ENTRY.size:
+        raise ValueError("Profiling table length does not match its entries")
+    if ticks_per_second == 0:
+        raise ValueError("Profiling table without a tick rate")
+
+    stats = []
+    for i in range(count):
+        name, calls, low, high, total = ENTRY.unpack_from(
+            blob, HEADER.size + i * ENTRY.size
+        )
+        stats.append(
+            ScopeStats(
+                name=name.split(b"\0", 1)[0].decode(errors="replace"),
+                count=calls,
+                min=low / ticks_per_second,
+                max=high / ticks_per_second,
+                total=total / ticks_per_second,
+            )
+        )
+    return stats
+
+
+def find_blobs(text: str) -> list[bytes]:
+    """Finds the profiling tables in a decoded log.
+
+    Args:
+        text: Log decoded by BinlogDecoder.
+
+    Returns:
+        Tables in the order they were logged.
+    """
+
+    return [bytes.fromhex(match) for match in PROFILE.findall(text)]
+
+
+def format_stats(stats: list[ScopeStats]) -> str:
+    """Formats a profiling table.
+
+    Args:
+        stats: Output of decode_stats.
+
+    Returns:
+        Table in us, sorted by total time.
+    """
+
+    lines = [
+        f"{'scope':<12}{'count':>10}{'min us':>12}{'mean us':>12}"
+        f"{'max us':>12}{'total ms':>12}"
+    ]
+    for s in sorted(stats, key=lambda s: s.total, reverse=True):
+        lines.append(
+            f"{s.name:<12}{s.count:>10}{s.min * 1e6:>12.1f}{s.mean * 1e6:>12.1f}"
+            f"{s.max * 1e6:>12.1f}{s.total * 1e3:>12.1f}"
+        )
+    return "\n".join(lines)
@@ -300,10 +300,11 @@ def encode_sensor_response(resp_dict: dict) -> bytes:
     """Encodes a sensor response message.
 
     {
+        seq: int,
         responses: [
             {
-                status: int,
-                message: str,
+                idx: int,
+                error: str,
             },
             ...
         ]
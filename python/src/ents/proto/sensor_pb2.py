@@ -24,25 +24,27 @@ _sym_db = _symbol_database.Default()
 
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0csensor.proto\":\n\x08Metadata\x12\x0f\n\x07\x63\x65ll_id\x18\x01 \x01(\r\x12\x11\n\tlogger_id\x18\x02 \x01(\r\x12\n\n\x02ts\x18\x03 \x01(\r\":\n\x0eSensorResponse\x12\x0b\n\x03idx\x18\x01 \x01(\r\x12\x1b\n\x05\x65rror\x18\x02 \x01(\x0e\x32\x0c.SensorError\"=\n\x17RepeatedSensorResponses\x12\"\n\tresponses\x18\x01 \x03(\x0b\x32\x0f.SensorResponse\"\x9e\x01\n\x11SensorMeasurement\x12\x17\n\x04meta\x18\x01 \x01(\x0b\x32\t.Metadata\x12\x19\n\x04type\x18\x02 \x01(\x0e\x32\x0b.SensorType\x12\x16\n\x0cunsigned_int\x18\x03 \x01(\rH\x00\x12\x14\n\nsigned_int\x18\x04 \x01(\x05H\x00\x12\x11\n\x07\x64\x65\x63imal\x18\x05 \x01(\x01H\x00\x12\x0b\n\x03idx\x18\x06 \x01(\rB\x07\n\x05value\"z\n\x1aRepeatedSensorMeasurements\x12\x17\n\x04meta\x18\x01 \x01(\x0b\x32\t.Metadata\x12\x19\n\x04type\x18\x02 \x01(\x0e\x32\x0b.SensorType\x12(\n\x0cmeasurements\x18\x03 \x03(\x0b\x32\x12.SensorMeasurement*\xd4\x05\n\nSensorType\x12\x08\n\x04NONE\x10\x00\x12\x11\n\rPOWER_VOLTAGE\x10\x01\x12\x11\n\rPOWER_CURRENT\x10\x02\x12\x0f\n\x0bTEROS12_VWC\x10\x03\x12\x13\n\x0fTEROS12_VWC_ADJ\x10\x04\x12\x10\n\x0cTEROS12_TEMP\x10\x05\x12\x0e\n\nTEROS12_EC\x10\x06\x12\x14\n\x10PHYTOS31_VOLTAGE\x10\x07\x12\x19\n\x15PHYTOS31_LEAF_WETNESS\x10\x08\x12\x13\n\x0f\x42ME280_PRESSURE\x10\t\x12\x0f\n\x0b\x42ME280_TEMP\x10\n\x12\x13\n\x0f\x42ME280_HUMIDITY\x10\x0b\x12\x16\n\x12TEROS21_MATRIC_POT\x10\x0c\x12\x10\n\x0cTEROS21_TEMP\x10\r\x12\x13\n\x0fSEN0308_VOLTAGE\x10\x0e\x12\x14\n\x10SEN0308_HUMIDITY\x10\x0f\x12\x13\n\x0fSEN0257_VOLTAGE\x10\x10\x12\x14\n\x10SEN0257_PRESSURE\x10\x11\x12\x10\n\x0cYFS210C_FLOW\x10\x12\x12\x16\n\x12PCAP02_CAPACITANCE\x10\x13\x12\x0c\n\x08\x44\x31\x30_FLOW\x10\x14\x12\x16\n\x12\x44\x31\x30_VOLUME_ELAPSED\x10\x15\x12\x14\n\x10\x44\x31\x30_TIME_ELAPSED\x10\x16\x12\x1f\n\x1bWATERMARK200SS_SOIL_TENSION\x10\x17\x12#\n\x1fWATERMARK200TS_SOIL_TEMPERATURE\x10\x18\x12\x16\n\x12\x45\x44U0157_WIND_SPEED\x10\x19\x12\x1a\n\x16\x45\x44U0157_WIND_DIRECTION\x10\x1a\x12\x14\n\x10\x45\x44U0157_ALTITUDE\x10\x1b\x12\x14\n\x10\x45\x44U0157_PRESSURE\x10\x1c\x12\x10\n\x0c\x45\x44U0157_TEMP\x10\x1d\x12\x14\n\x10\x45\x44U0157_HUMIDITY\x10\x1e\x12\x18\n\x14\x41LSMPM2F_WATER_LEVEL\x10\x1f\x12\x14\n\x10\x41LSMPM2F_VOLTAGE\x10 *b\n\x0bSensorError\x12\x06\n\x02OK\x10\x00\x12\x0b\n\x07GENERAL\x10\x01\x12\n\n\x06LOGGER\x10\x02\x12\x08\n\x04\x43\x45LL\x10\x03\x12\x0f\n\x0bUNSUPPORTED\x10\x04\x12\x0b\n\x07INVALID\x10\x05\x12\n\n\x06\x44\x45\x43ODE\x10\x06\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x0csensor.proto\":\n\x08Metadata\x12\x0f\n\x07\x63\x65ll_id\x18\x01 \x01(\r\x12\x11\n\tlogger_id\x18\x02 \x01(\r\x12\n\n\x02ts\x18\x03 \x01(\r\":\n\x0eSensorResponse\x12\x0b\n\x03idx\x18\x01 \x01(\r\x12\x1b\n\x05\x65rror\x18\x02 \x01(\x0e\x32\x0c.SensorError\"J\n\x17RepeatedSensorResponses\x12\"\n\tresponses\x18\x01 \x03(\x0b\x32\x0f.SensorResponse\x12\x0b\n\x03seq\x18\x02 \x01(\r\"P\n\x07Summary\x12\r\n\x05\x63ount\x18\x01 \x01(\r\x12\x0b\n\x03min\x18\x02 \x01(\x02\x12\x0c\n\x04mean\x18\x03 \x01(\x02\x12\x0b\n\x03max\x18\x04 \x01(\x02\x12\x0e\n\x06stddev\x18\x05 \x01(\x02\"\xbb\x01\n\x11SensorMeasurement\x12\x17\n\x04meta\x18\x01 \x01(\x0b\x32\t.Metadata\x12\x19\n\x04type\x18\x02 \x01(\x0e\x32\x0b.SensorType\x12\x16\n\x0cunsigned_int\x18\x03 \x01(\rH\x00\x12\x14\n\nsigned_int\x18\x04 \x01(\x05H\x00\x12\x11\n\x07\x64\x65\x63imal\x18\x05 \x01(\x01H\x00\x12\x1b\n\x07summary\x18\x07 \x01(\x0b\x32\x08.SummaryH\x00\x12\x0b\n\x03idx\x18\x06 \x01(\rB\x07\n\x05value\"\x87\x01\n\x1aRepeatedSensorMeasurements\x12\x17\n\x04meta\x18\x01 \x01(\x0b\x32\t.Metadata\x12\x19\n\x04type\x18\x02 \x01(\x0e\x32\x0b.SensorType\x12(\n\x0cmeasurements\x18\x03 \x03(\x0b\x32\x12.SensorMeasurement\x12\x0b\n\x03seq\x18\x04 \x01(\r*\xd4\x05\n\nSensorType\x12\x08\n\x04NONE\x10\x00\x12\x11\n\rPOWER_VOLTAGE\x10\x01\x12\x11\n\rPOWER_CURRENT\x10\x02\x12\x0f\n\x0bTEROS12_VWC\x10\x03\x12\x13\n\x0fTEROS12_VWC_ADJ\x10\x04\x12\x10\n\x0cTEROS12_TEMP\x10\x05\x12\x0e\n\nTEROS12_EC\x10\x06\x12\x14\n\x10PHYTOS31_VOLTAGE\x10\x07\x12\x19\n\x15PHYTOS31_LEAF_WETNESS\x10\x08\x12\x13\n\x0f\x42ME280_PRESSURE\x10\t\x12\x0f\n\x0b\x42ME280_TEMP\x10\n\x12\x13\n\x0f\x42ME280_HUMIDITY\x10\x0b\x12\x16\n\x12TEROS21_MATRIC_POT\x10\x0c\x12\x10\n\x0cTEROS21_TEMP\x10\r\x12\x13\n\x0fSEN0308_VOLTAGE\x10\x0e\x12\x14\n\x10SEN0308_HUMIDITY\x10\x0f\x12\x13\n\x0fSEN0257_VOLTAGE\x10\x10\x12\x14\n\x10SEN0257_PRESSURE\x10\x11\x12\x10\n\x0cYFS210C_FLOW\x10\x12\x12\x16\n\x12PCAP02_CAPACITANCE\x10\x13\x12\x0c\n\x08\x44\x31\x30_FLOW\x10\x14\x12\x16\n\x12\x44\x31\x30_VOLUME_ELAPSED\x10\x15\x12\x14\n\x10\x44\x31\x30_TIME_ELAPSED\x10\x16\x12\x1f\n\x1bWATERMARK200SS_SOIL_TENSION\x10\x17\x12#\n\x1fWATERMARK200TS_SOIL_TEMPERATURE\x10\x18\x12\x16\n\x12\x45\x44U0157_WIND_SPEED\x10\x19\x12\x1a\n\x16\x45\x44U0157_WIND_DIRECTION\x10\x1a\x12\x14\n\x10\x45\x44U0157_ALTITUDE\x10\x1b\x12\x14\n\x10\x45\x44U0157_PRESSURE\x10\x1c\x12\x10\n\x0c\x45\x44U0157_TEMP\x10\x1d\x12\x14\n\x10\x45\x44U0157_HUMIDITY\x10\x1e\x12\x18\n\x14\x41LSMPM2F_WATER_LEVEL\x10\x1f\x12\x14\n\x10\x41LSMPM2F_VOLTAGE\x10 *b\n\x0bSensorError\x12\x06\n\x02OK\x10\x00\x12\x0b\n\x07GENERAL\x10\x01\x12\n\n\x06LOGGER\x10\x02\x12\x08\n\x04\x43\x45LL\x10\x03\x12\x0f\n\x0bUNSUPPORTED\x10\x04\x12\x0b\n\x07INVALID\x10\x05\x12\n\n\x06\x44\x45\x43ODE\x10\x06\x62\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'sensor_pb2', _globals)
 if not _descriptor._USE_C_DESCRIPTORS:
   DESCRIPTOR._loaded_options = None
-  _globals['_SENSORTYPE']._serialized_start=485
-  _globals['_SENSORTYPE']._serialized_end=1209
-  _globals['_SENSORERROR']._serialized_start=1211
-  _globals['_SENSORERROR']._serialized_end=1309
+  _globals['_SENSORTYPE']._serialized_start=623
+  _globals['_SENSORTYPE']._serialized_end=1347
+  _globals['_SENSORERROR']._serialized_start=1349
+  _globals['_SENSORERROR']._serialized_end=1447
   _globals['_METADATA']._serialized_start=16
   _globals['_METADATA']._serialized_end=74
   _globals['_SENSORRESPONSE']._serialized_start=76
   _globals['_SENSORRESPONSE']._serialized_end=134
   _globals['_REPEATEDSENSORRESPONSES']._serialized_start=136
-  _globals['_REPEATEDSENSORRESPONSES']._serialized_end=197
-  _globals['_SENSORMEASUREMENT']._serialized_start=200
-  _globals['_SENSORMEASUREMENT']._serialized_end=358
-  _globals['_REPEATEDSENSORMEASUREMENTS']._serialized_start=360
-  _globals['_REPEATEDSENSORMEASUREMENTS']._serialized_end=482
+  _globals['_REPEATEDSENSORRESPONSES']._serialized_end=210
+  _globals['_SUMMARY']._serialized_start=212
+  _globals['_SUMMARY']._serialized_end=292
+  _globals['_SENSORMEASUREMENT']._serialized_start=295
+  _globals['_SENSORMEASUREMENT']._serialized_end=482
+  _globals['_REPEATEDSENSORMEASUREMENTS']._serialized_start=485
+  _globals['_REPEATEDSENSORMEASUREMENTS']._serialized_end=620
 # @@protoc_insertion_point(module_scope)
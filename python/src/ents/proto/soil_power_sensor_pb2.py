@@ -25,17 +25,17 @@ _sym_db = _symbol_database.Default()
 from . import sensor_pb2 as sensor__pb2
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x17soil_power_sensor.proto\x1a\x0csensor.proto\"E\n\x13MeasurementMetadata\x12\x0f\n\x07\x63\x65ll_id\x18\x01 \x01(\r\x12\x11\n\tlogger_id\x18\x02 \x01(\r\x12\n\n\x02ts\x18\x03 \x01(\r\"4\n\x10PowerMeasurement\x12\x0f\n\x07voltage\x18\x02 \x01(\x01\x12\x0f\n\x07\x63urrent\x18\x03 \x01(\x01\"*\n\x17VoltageDeltaMeasurement\x12\x0f\n\x07voltage\x18\x01 \x01(\r\"*\n\x17\x43urrentDeltaMeasurement\x12\x0f\n\x07\x63urrent\x18\x01 \x01(\r\"%\n\x12VoltageMeasurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\"%\n\x12\x43urrentMeasurement\x12\x0f\n\x07\x63urrent\x18\x01 \x01(\x01\"K\n\x0fPowerDeltaEntry\x12\n\n\x02ts\x18\x01 \x01(\r\x12\x15\n\rvoltage_delta\x18\x02 \x01(\r\x12\x15\n\rcurrent_delta\x18\x03 \x01(\r\"E\n\x15PowerMeasurementDelta\x12\x15\n\rvoltage_delta\x18\x02 \x01(\r\x12\x15\n\rcurrent_delta\x18\x03 \x01(\r\"\\\n\x13RepeatedPowerDeltas\x12\x11\n\tlogger_id\x18\x01 \x01(\r\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12!\n\x07\x65ntries\x18\x03 \x03(\x0b\x32\x10.PowerDeltaEntry\"P\n\x12Teros12Measurement\x12\x0f\n\x07vwc_raw\x18\x02 \x01(\x01\x12\x0f\n\x07vwc_adj\x18\x03 \x01(\x01\x12\x0c\n\x04temp\x18\x04 \x01(\x01\x12\n\n\x02\x65\x63\x18\x05 \x01(\r\"6\n\x12Teros21Measurement\x12\x12\n\nmatric_pot\x18\x01 \x01(\x01\x12\x0c\n\x04temp\x18\x02 \x01(\x01\"<\n\x13Phytos31Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x14\n\x0cleaf_wetness\x18\x02 \x01(\x01\"L\n\x11\x42ME280Measurement\x12\x10\n\x08pressure\x18\x01 \x01(\r\x12\x13\n\x0btemperature\x18\x02 \x01(\x05\x12\x10\n\x08humidity\x18\x03 \x01(\r\"7\n\x12SEN0308Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x10\n\x08humidity\x18\x02 \x01(\x01\"7\n\x12SEN0257Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x10\n\x08pressure\x18\x02 \x01(\x01\"\"\n\x12YFS210CMeasurement\x12\x0c\n\x04\x66low\x18\x01 \x01(\x01\"(\n\x11PCAP02Measurement\x12\x13\n\x0b\x63\x61pacitance\x18\x01 \x01(\x01\"J\n\x0e\x44\x31\x30Measurement\x12\x0c\n\x04\x66low\x18\x01 \x01(\x01\x12\x15\n\rvolumeElapsed\x18\x02 \x01(\r\x12\x13\n\x0btimeElapsed\x18\x03 \x01(\r\"1\n\x19WATERMARK200SSMeasurement\x12\x14\n\x0csoil_tension\x18\x01 \x01(\x01\"0\n\x19WATERMARK200TSMeasurement\x12\x13\n\x0btemperature\x18\x01 \x01(\x01\"\x8b\x01\n\x12\x45\x44U0157Measurement\x12\x12\n\nwind_speed\x18\x01 \x01(\x01\x12\x16\n\x0ewind_direction\x18\x02 \x01(\r\x12\x10\n\x08\x61ltitude\x18\x03 \x01(\x01\x12\x10\n\x08pressure\x18\x04 \x01(\x01\x12\x13\n\x0btemperature\x18\x05 \x01(\x01\x12\x10\n\x08humidity\x18\x06 \x01(\x01\"6\n\x13\x41LSMPM2FMeasurement\x12\x0e\n\x06meters\x18\x01 \x01(\x01\x12\x0f\n\x07voltage\x18\x02 \x01(\x01\"\x82\x05\n\x0bMeasurement\x12\"\n\x04meta\x18\x01 \x01(\x0b\x32\x14.MeasurementMetadata\x12\"\n\x05power\x18\x02 \x01(\x0b\x32\x11.PowerMeasurementH\x00\x12&\n\x07teros12\x18\x03 \x01(\x0b\x32\x13.Teros12MeasurementH\x00\x12(\n\x08phytos31\x18\x04 \x01(\x0b\x32\x14.Phytos31MeasurementH\x00\x12$\n\x06\x62me280\x18\x05 \x01(\x0b\x32\x12.BME280MeasurementH\x00\x12&\n\x07teros21\x18\x06 \x01(\x0b\x32\x13.Teros21MeasurementH\x00\x12&\n\x07sen0308\x18\x07 \x01(\x0b\x32\x13.SEN0308MeasurementH\x00\x12&\n\x07sen0257\x18\x08 \x01(\x0b\x32\x13.SEN0257MeasurementH\x00\x12&\n\x07yfs210c\x18\t \x01(\x0b\x32\x13.YFS210CMeasurementH\x00\x12$\n\x06pcap02\x18\n \x01(\x0b\x32\x12.PCAP02MeasurementH\x00\x12\x1e\n\x03\x64\x31\x30\x18\x0b \x01(\x0b\x32\x0f.D10MeasurementH\x00\x12\x34\n\x0ewatermark200ss\x18\x0c \x01(\x0b\x32\x1a.WATERMARK200SSMeasurementH\x00\x12\x34\n\x0ewatermark200ts\x18\r \x01(\x0b\x32\x1a.WATERMARK200TSMeasurementH\x00\x12&\n\x07\x65\x64u0157\x18\x0e \x01(\x0b\x32\x13.EDU0157MeasurementH\x00\x12*\n\nwaterLevel\x18\x0f \x01(\x0b\x32\x14.ALSMPM2FMeasurementH\x00\x42\r\n\x0bmeasurement\"X\n\x08Response\x12$\n\x04resp\x18\x01 \x01(\x0e\x32\x16.Response.ResponseType\"&\n\x0cResponseType\x12\x0b\n\x07SUCCESS\x10\x00\x12\t\n\x05\x45RROR\x10\x01\"\xc4\x02\n\x0c\x45sp32Command\x12$\n\x0cpage_command\x18\x01 \x01(\x0b\x32\x0c.PageCommandH\x00\x12$\n\x0ctest_command\x18\x02 \x01(\x0b\x32\x0c.TestCommandH\x00\x12$\n\x0cwifi_command\x18\x03 \x01(\x0b\x32\x0c.WiFiCommandH\x00\x12*\n\x0fmicrosd_command\x18\x04 \x01(\x0b\x32\x0f.MicroSDCommandH\x00\x12\x30\n\x12irrigation_command\x18\x05 \x01(\x0b\x32\x12.IrrigationCommandH\x00\x12\x31\n\x13user_config_command\x18\x06 \x01(\x0b\x32\x12.UserConfigCommandH\x00\x12&\n\rpower_command\x18\x07 \x01(\x0b\x32\r.PowerCommandH\x00\x42\t\n\x07\x63ommand\"\xb6\x01\n\x0bPageCommand\x12.\n\x0c\x66ile_request\x18\x01 \x01(\x0e\x32\x18.PageCommand.RequestType\x12\x17\n\x0f\x66ile_descriptor\x18\x02 \x01(\r\x12\x12\n\nblock_size\x18\x03 \x01(\r\x12\x11\n\tnum_bytes\x18\x04 \x01(\r\"7\n\x0bRequestType\x12\x08\n\x04OPEN\x10\x00\x12\t\n\x05\x43LOSE\x10\x01\x12\x08\n\x04READ\x10\x02\x12\t\n\x05WRITE\x10\x03\"\x82\x01\n\x0bTestCommand\x12\'\n\x05state\x18\x01 \x01(\x0e\x32\x18.TestCommand.ChangeState\x12\x0c\n\x04\x64\x61ta\x18\x02 \x01(\x05\"<\n\x0b\x43hangeState\x12\x0b\n\x07RECEIVE\x10\x00\x12\x13\n\x0fRECEIVE_REQUEST\x10\x01\x12\x0b\n\x07REQUEST\x10\x02\"\xc5\x02\n\x0bWiFiCommand\x12\x1f\n\x04type\x18\x01 \x01(\x0e\x32\x11.WiFiCommand.Type\x12\x0c\n\x04ssid\x18\x02 \x01(\t\x12\x0e\n\x06passwd\x18\x03 \x01(\t\x12\x0b\n\x03url\x18\x04 \x01(\t\x12\x0c\n\x04port\x18\x08 \x01(\r\x12\n\n\x02rc\x18\x05 \x01(\r\x12\n\n\x02ts\x18\x06 \x01(\r\x12\x0c\n\x04resp\x18\x07 \x01(\x0c\x12\x0b\n\x03mac\x18\t \x01(\t\x12\x0f\n\x07\x63lients\x18\n \x01(\r\"\x97\x01\n\x04Type\x12\x0b\n\x07\x43ONNECT\x10\x00\x12\x08\n\x04POST\x10\x01\x12\t\n\x05\x43HECK\x10\x02\x12\x08\n\x04TIME\x10\x03\x12\x0e\n\nDISCONNECT\x10\x04\x12\x0e\n\nCHECK_WIFI\x10\x05\x12\r\n\tCHECK_API\x10\x06\x12\x0c\n\x08NTP_SYNC\x10\x07\x12\x08\n\x04HOST\x10\x08\x12\r\n\tSTOP_HOST\x10\t\x12\r\n\tHOST_INFO\x10\n\"\xad\x01\n\x11UserConfigCommand\x12,\n\x04type\x18\x01 \x01(\x0e\x32\x1e.UserConfigCommand.RequestType\x12\'\n\x0b\x63onfig_data\x18\x02 \x01(\x0b\x32\x12.UserConfiguration\"A\n\x0bRequestType\x12\x12\n\x0eREQUEST_CONFIG\x10\x00\x12\x13\n\x0fRESPONSE_CONFIG\x10\x01\x12\t\n\x05START\x10\x02\"\x91\x04\n\x0eMicroSDCommand\x12\"\n\x04type\x18\x01 \x01(\x0e\x32\x14.MicroSDCommand.Type\x12\x10\n\x08\x66ilename\x18\x02 \x01(\t\x12&\n\x02rc\x18\x03 \x01(\x0e\x32\x1a.MicroSDCommand.ReturnCode\x12\x1c\n\x04meas\x18\x04 \x01(\x0b\x32\x0c.MeasurementH\x00\x12 \n\x02uc\x18\x05 \x01(\x0b\x32\x12.UserConfigurationH\x00\x12\x30\n\x12sensor_measurement\x18\x06 \x01(\x0b\x32\x12.SensorMeasurementH\x00\x12\x43\n\x1crepeated_sensor_measurements\x18\x07 \x01(\x0b\x32\x1b.RepeatedSensorMeasurementsH\x00\x12\x12\n\x08raw_data\x18\x08 \x01(\x0cH\x00\" \n\x04Type\x12\x08\n\x04SAVE\x10\x00\x12\x0e\n\nUSERCONFIG\x10\x01\"\xab\x01\n\nReturnCode\x12\x0b\n\x07SUCCESS\x10\x00\x12\x11\n\rERROR_GENERAL\x10\x01\x12\x1e\n\x1a\x45RROR_MICROSD_NOT_INSERTED\x10\x02\x12#\n\x1f\x45RROR_FILE_SYSTEM_NOT_MOUNTABLE\x10\x03\x12\x1d\n\x19\x45RROR_PAYLOAD_NOT_DECODED\x10\x04\x12\x19\n\x15\x45RROR_FILE_NOT_OPENED\x10\x05\x42\x06\n\x04\x64\x61ta\"\x94\x01\n\x11IrrigationCommand\x12%\n\x04type\x18\x01 \x01(\x0e\x32\x17.IrrigationCommand.Type\x12\'\n\x05state\x18\x02 \x01(\x0e\x32\x18.IrrigationCommand.State\"\x11\n\x04Type\x12\t\n\x05\x43HECK\x10\x00\"\x1c\n\x05State\x12\x08\n\x04OPEN\x10\x00\x12\t\n\x05\x43LOSE\x10\x01\"\xab\x03\n\x0cPowerCommand\x12 \n\x04type\x18\x01 \x01(\x0e\x32\x12.PowerCommand.Type\x12*\n\x06reason\x18\x02 \x01(\x0e\x32\x1a.PowerCommand.WakeupReason\x12\x12\n\nboot_count\x18\x03 \x01(\r\"\x1d\n\x04Type\x12\t\n\x05SLEEP\x10\x00\x12\n\n\x06WAKEUP\x10\x01\"\x99\x02\n\x0cWakeupReason\x12\x15\n\x11POWER_WAKEUP_EXT0\x10\x00\x12\x15\n\x11POWER_WAKEUP_EXT1\x10\x01\x12\x16\n\x12POWER_WAKEUP_TIMER\x10\x02\x12\x19\n\x15POWER_WAKEUP_TOUCHPAD\x10\x03\x12\x14\n\x10POWER_WAKEUP_ULP\x10\x04\x12\x15\n\x11POWER_WAKEUP_GPIO\x10\x05\x12\x15\n\x11POWER_WAKEUP_UART\x10\x06\x12\x15\n\x11POWER_WAKEUP_WIFI\x10\x07\x12\x16\n\x12POWER_WAKEUP_COCPU\x10\x08\x12 \n\x1cPOWER_WAKEUP_COCPU_TRAP_TRIG\x10\t\x12\x13\n\x0fPOWER_WAKEUP_BT\x10\n\"\x96\x03\n\x11UserConfiguration\x12\x11\n\tlogger_id\x18\x01 \x01(\r\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12$\n\rUpload_method\x18\x03 \x01(\x0e\x32\r.Uploadmethod\x12\x17\n\x0fUpload_interval\x18\x04 \x01(\r\x12\'\n\x0f\x65nabled_sensors\x18\x05 \x03(\x0e\x32\x0e.EnabledSensor\x12\x38\n\x18\x65nabled_sensors_multiple\x18\x0e \x03(\x0b\x32\x16.EnabledSensorMultiple\x12\x15\n\rVoltage_Slope\x18\x06 \x01(\x01\x12\x16\n\x0eVoltage_Offset\x18\x07 \x01(\x01\x12\x15\n\rCurrent_Slope\x18\x08 \x01(\x01\x12\x16\n\x0e\x43urrent_Offset\x18\t \x01(\x01\x12\x11\n\tWiFi_SSID\x18\n \x01(\t\x12\x15\n\rWiFi_Password\x18\x0b \x01(\t\x12\x18\n\x10\x41PI_Endpoint_URL\x18\x0c \x01(\t\x12\x19\n\x11\x41PI_Endpoint_Port\x18\r \x01(\r\"\x17\n\x08\x61\x64\x63Value\x12\x0b\n\x03\x61\x64\x63\x18\x01 \x01(\r\"_\n\x15\x45nabledSensorMultiple\x12&\n\x0e\x65nabled_sensor\x18\x01 \x01(\x0e\x32\x0e.EnabledSensor\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12\r\n\x05index\x18\x03 \x01(\r*\xdc\x01\n\rEnabledSensor\x12\x0b\n\x07Voltage\x10\x00\x12\x0b\n\x07\x43urrent\x10\x01\x12\x0b\n\x07Teros12\x10\x02\x12\x0b\n\x07Teros21\x10\x03\x12\n\n\x06\x42ME280\x10\x04\x12\x0c\n\x08Phytos31\x10\x05\x12\x0b\n\x07SEN0308\x10\x06\x12\x0b\n\x07SEN0257\x10\x07\x12\x0b\n\x07YFS210C\x10\x08\x12\n\n\x06PCAP02\x10\t\x12\x07\n\x03\x44\x31\x30\x10\n\x12\x12\n\x0eWATERMARK200SS\x10\x0b\x12\x12\n\x0eWATERMARK200TS\x10\x0c\x12\x0b\n\x07\x45\x44U0157\x10\r\x12\x0c\n\x08\x41LSMPM2F\x10\x0e*\"\n\x0cUploadmethod\x12\x08\n\x04LoRa\x10\x00\x12\x08\n\x04WiFi\x10\x01\x62\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\x17soil_power_sensor.proto\x1a\x0csensor.proto\"E\n\x13MeasurementMetadata\x12\x0f\n\x07\x63\x65ll_id\x18\x01 \x01(\r\x12\x11\n\tlogger_id\x18\x02 \x01(\r\x12\n\n\x02ts\x18\x03 \x01(\r\"4\n\x10PowerMeasurement\x12\x0f\n\x07voltage\x18\x02 \x01(\x01\x12\x0f\n\x07\x63urrent\x18\x03 \x01(\x01\"*\n\x17VoltageDeltaMeasurement\x12\x0f\n\x07voltage\x18\x01 \x01(\r\"*\n\x17\x43urrentDeltaMeasurement\x12\x0f\n\x07\x63urrent\x18\x01 \x01(\r\"%\n\x12VoltageMeasurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\"%\n\x12\x43urrentMeasurement\x12\x0f\n\x07\x63urrent\x18\x01 \x01(\x01\"K\n\x0fPowerDeltaEntry\x12\n\n\x02ts\x18\x01 \x01(\r\x12\x15\n\rvoltage_delta\x18\x02 \x01(\r\x12\x15\n\rcurrent_delta\x18\x03 \x01(\r\"E\n\x15PowerMeasurementDelta\x12\x15\n\rvoltage_delta\x18\x02 \x01(\r\x12\x15\n\rcurrent_delta\x18\x03 \x01(\r\"t\n\x13RepeatedPowerDeltas\x12\x11\n\tlogger_id\x18\x01 \x01(\r\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12!\n\x07\x65ntries\x18\x03 \x03(\x0b\x32\x10.PowerDeltaEntry\x12\x16\n\x0epacked_entries\x18\x04 \x01(\x0c\"P\n\x12Teros12Measurement\x12\x0f\n\x07vwc_raw\x18\x02 \x01(\x01\x12\x0f\n\x07vwc_adj\x18\x03 \x01(\x01\x12\x0c\n\x04temp\x18\x04 \x01(\x01\x12\n\n\x02\x65\x63\x18\x05 \x01(\r\"6\n\x12Teros21Measurement\x12\x12\n\nmatric_pot\x18\x01 \x01(\x01\x12\x0c\n\x04temp\x18\x02 \x01(\x01\"<\n\x13Phytos31Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x14\n\x0cleaf_wetness\x18\x02 \x01(\x01\"L\n\x11\x42ME280Measurement\x12\x10\n\x08pressure\x18\x01 \x01(\r\x12\x13\n\x0btemperature\x18\x02 \x01(\x05\x12\x10\n\x08humidity\x18\x03 \x01(\r\"7\n\x12SEN0308Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x10\n\x08humidity\x18\x02 \x01(\x01\"7\n\x12SEN0257Measurement\x12\x0f\n\x07voltage\x18\x01 \x01(\x01\x12\x10\n\x08pressure\x18\x02 \x01(\x01\"\"\n\x12YFS210CMeasurement\x12\x0c\n\x04\x66low\x18\x01 \x01(\x01\"(\n\x11PCAP02Measurement\x12\x13\n\x0b\x63\x61pacitance\x18\x01 \x01(\x01\"J\n\x0e\x44\x31\x30Measurement\x12\x0c\n\x04\x66low\x18\x01 \x01(\x01\x12\x15\n\rvolumeElapsed\x18\x02 \x01(\r\x12\x13\n\x0btimeElapsed\x18\x03 \x01(\r\"1\n\x19WATERMARK200SSMeasurement\x12\x14\n\x0csoil_tension\x18\x01 \x01(\x01\"0\n\x19WATERMARK200TSMeasurement\x12\x13\n\x0btemperature\x18\x01 \x01(\x01\"\x8b\x01\n\x12\x45\x44U0157Measurement\x12\x12\n\nwind_speed\x18\x01 \x01(\x01\x12\x16\n\x0ewind_direction\x18\x02 \x01(\r\x12\x10\n\x08\x61ltitude\x18\x03 \x01(\x01\x12\x10\n\x08pressure\x18\x04 \x01(\x01\x12\x13\n\x0btemperature\x18\x05 \x01(\x01\x12\x10\n\x08humidity\x18\x06 \x01(\x01\"6\n\x13\x41LSMPM2FMeasurement\x12\x0e\n\x06meters\x18\x01 \x01(\x01\x12\x0f\n\x07voltage\x18\x02 \x01(\x01\"\x82\x05\n\x0bMeasurement\x12\"\n\x04meta\x18\x01 \x01(\x0b\x32\x14.MeasurementMetadata\x12\"\n\x05power\x18\x02 \x01(\x0b\x32\x11.PowerMeasurementH\x00\x12&\n\x07teros12\x18\x03 \x01(\x0b\x32\x13.Teros12MeasurementH\x00\x12(\n\x08phytos31\x18\x04 \x01(\x0b\x32\x14.Phytos31MeasurementH\x00\x12$\n\x06\x62me280\x18\x05 \x01(\x0b\x32\x12.BME280MeasurementH\x00\x12&\n\x07teros21\x18\x06 \x01(\x0b\x32\x13.Teros21MeasurementH\x00\x12&\n\x07sen0308\x18\x07 \x01(\x0b\x32\x13.SEN0308MeasurementH\x00\x12&\n\x07sen0257\x18\x08 \x01(\x0b\x32\x13.SEN0257MeasurementH\x00\x12&\n\x07yfs210c\x18\t \x01(\x0b\x32\x13.YFS210CMeasurementH\x00\x12$\n\x06pcap02\x18\n \x01(\x0b\x32\x12.PCAP02MeasurementH\x00\x12\x1e\n\x03\x64\x31\x30\x18\x0b \x01(\x0b\x32\x0f.D10MeasurementH\x00\x12\x34\n\x0ewatermark200ss\x18\x0c \x01(\x0b\x32\x1a.WATERMARK200SSMeasurementH\x00\x12\x34\n\x0ewatermark200ts\x18\r \x01(\x0b\x32\x1a.WATERMARK200TSMeasurementH\x00\x12&\n\x07\x65\x64u0157\x18\x0e \x01(\x0b\x32\x13.EDU0157MeasurementH\x00\x12*\n\nwaterLevel\x18\x0f \x01(\x0b\x32\x14.ALSMPM2FMeasurementH\x00\x42\r\n\x0bmeasurement\"X\n\x08Response\x12$\n\x04resp\x18\x01 \x01(\x0e\x32\x16.Response.ResponseType\"&\n\x0cResponseType\x12\x0b\n\x07SUCCESS\x10\x00\x12\t\n\x05\x45RROR\x10\x01\"\xc4\x02\n\x0c\x45sp32Command\x12$\n\x0cpage_command\x18\x01 \x01(\x0b\x32\x0c.PageCommandH\x00\x12$\n\x0ctest_command\x18\x02 \x01(\x0b\x32\x0c.TestCommandH\x00\x12$\n\x0cwifi_command\x18\x03 \x01(\x0b\x32\x0c.WiFiCommandH\x00\x12*\n\x0fmicrosd_command\x18\x04 \x01(\x0b\x32\x0f.MicroSDCommandH\x00\x12\x30\n\x12irrigation_command\x18\x05 \x01(\x0b\x32\x12.IrrigationCommandH\x00\x12\x31\n\x13user_config_command\x18\x06 \x01(\x0b\x32\x12.UserConfigCommandH\x00\x12&\n\rpower_command\x18\x07 \x01(\x0b\x32\r.PowerCommandH\x00\x42\t\n\x07\x63ommand\"\xb6\x01\n\x0bPageCommand\x12.\n\x0c\x66ile_request\x18\x01 \x01(\x0e\x32\x18.PageCommand.RequestType\x12\x17\n\x0f\x66ile_descriptor\x18\x02 \x01(\r\x12\x12\n\nblock_size\x18\x03 \x01(\r\x12\x11\n\tnum_bytes\x18\x04 \x01(\r\"7\n\x0bRequestType\x12\x08\n\x04OPEN\x10\x00\x12\t\n\x05\x43LOSE\x10\x01\x12\x08\n\x04READ\x10\x02\x12\t\n\x05WRITE\x10\x03\"\x82\x01\n\x0bTestCommand\x12\'\n\x05state\x18\x01 \x01(\x0e\x32\x18.TestCommand.ChangeState\x12\x0c\n\x04\x64\x61ta\x18\x02 \x01(\x05\"<\n\x0b\x43hangeState\x12\x0b\n\x07RECEIVE\x10\x00\x12\x13\n\x0fRECEIVE_REQUEST\x10\x01\x12\x0b\n\x07REQUEST\x10\x02\"\xc5\x02\n\x0bWiFiCommand\x12\x1f\n\x04type\x18\x01 \x01(\x0e\x32\x11.WiFiCommand.Type\x12\x0c\n\x04ssid\x18\x02 \x01(\t\x12\x0e\n\x06passwd\x18\x03 \x01(\t\x12\x0b\n\x03url\x18\x04 \x01(\t\x12\x0c\n\x04port\x18\x08 \x01(\r\x12\n\n\x02rc\x18\x05 \x01(\r\x12\n\n\x02ts\x18\x06 \x01(\r\x12\x0c\n\x04resp\x18\x07 \x01(\x0c\x12\x0b\n\x03mac\x18\t \x01(\t\x12\x0f\n\x07\x63lients\x18\n \x01(\r\"\x97\x01\n\x04Type\x12\x0b\n\x07\x43ONNECT\x10\x00\x12\x08\n\x04POST\x10\x01\x12\t\n\x05\x43HECK\x10\x02\x12\x08\n\x04TIME\x10\x03\x12\x0e\n\nDISCONNECT\x10\x04\x12\x0e\n\nCHECK_WIFI\x10\x05\x12\r\n\tCHECK_API\x10\x06\x12\x0c\n\x08NTP_SYNC\x10\x07\x12\x08\n\x04HOST\x10\x08\x12\r\n\tSTOP_HOST\x10\t\x12\r\n\tHOST_INFO\x10\n\"\xad\x01\n\x11UserConfigCommand\x12,\n\x04type\x18\x01 \x01(\x0e\x32\x1e.UserConfigCommand.RequestType\x12\'\n\x0b\x63onfig_data\x18\x02 \x01(\x0b\x32\x12.UserConfiguration\"A\n\x0bRequestType\x12\x12\n\x0eREQUEST_CONFIG\x10\x00\x12\x13\n\x0fRESPONSE_CONFIG\x10\x01\x12\t\n\x05START\x10\x02\"\x91\x04\n\x0eMicroSDCommand\x12\"\n\x04type\x18\x01 \x01(\x0e\x32\x14.MicroSDCommand.Type\x12\x10\n\x08\x66ilename\x18\x02 \x01(\t\x12&\n\x02rc\x18\x03 \x01(\x0e\x32\x1a.MicroSDCommand.ReturnCode\x12\x1c\n\x04meas\x18\x04 \x01(\x0b\x32\x0c.MeasurementH\x00\x12 \n\x02uc\x18\x05 \x01(\x0b\x32\x12.UserConfigurationH\x00\x12\x30\n\x12sensor_measurement\x18\x06 \x01(\x0b\x32\x12.SensorMeasurementH\x00\x12\x43\n\x1crepeated_sensor_measurements\x18\x07 \x01(\x0b\x32\x1b.RepeatedSensorMeasurementsH\x00\x12\x12\n\x08raw_data\x18\x08 \x01(\x0cH\x00\" \n\x04Type\x12\x08\n\x04SAVE\x10\x00\x12\x0e\n\nUSERCONFIG\x10\x01\"\xab\x01\n\nReturnCode\x12\x0b\n\x07SUCCESS\x10\x00\x12\x11\n\rERROR_GENERAL\x10\x01\x12\x1e\n\x1a\x45RROR_MICROSD_NOT_INSERTED\x10\x02\x12#\n\x1f\x45RROR_FILE_SYSTEM_NOT_MOUNTABLE\x10\x03\x12\x1d\n\x19\x45RROR_PAYLOAD_NOT_DECODED\x10\x04\x12\x19\n\x15\x45RROR_FILE_NOT_OPENED\x10\x05\x42\x06\n\x04\x64\x61ta\"\x94\x01\n\x11IrrigationCommand\x12%\n\x04type\x18\x01 \x01(\x0e\x32\x17.IrrigationCommand.Type\x12\'\n\x05state\x18\x02 \x01(\x0e\x32\x18.IrrigationCommand.State\"\x11\n\x04Type\x12\t\n\x05\x43HECK\x10\x00\"\x1c\n\x05State\x12\x08\n\x04OPEN\x10\x00\x12\t\n\x05\x43LOSE\x10\x01\"\xab\x03\n\x0cPowerCommand\x12 \n\x04type\x18\x01 \x01(\x0e\x32\x12.PowerCommand.Type\x12*\n\x06reason\x18\x02 \x01(\x0e\x32\x1a.PowerCommand.WakeupReason\x12\x12\n\nboot_count\x18\x03 \x01(\r\"\x1d\n\x04Type\x12\t\n\x05SLEEP\x10\x00\x12\n\n\x06WAKEUP\x10\x01\"\x99\x02\n\x0cWakeupReason\x12\x15\n\x11POWER_WAKEUP_EXT0\x10\x00\x12\x15\n\x11POWER_WAKEUP_EXT1\x10\x01\x12\x16\n\x12POWER_WAKEUP_TIMER\x10\x02\x12\x19\n\x15POWER_WAKEUP_TOUCHPAD\x10\x03\x12\x14\n\x10POWER_WAKEUP_ULP\x10\x04\x12\x15\n\x11POWER_WAKEUP_GPIO\x10\x05\x12\x15\n\x11POWER_WAKEUP_UART\x10\x06\x12\x15\n\x11POWER_WAKEUP_WIFI\x10\x07\x12\x16\n\x12POWER_WAKEUP_COCPU\x10\x08\x12 \n\x1cPOWER_WAKEUP_COCPU_TRAP_TRIG\x10\t\x12\x13\n\x0fPOWER_WAKEUP_BT\x10\n\"\x96\x03\n\x11UserConfiguration\x12\x11\n\tlogger_id\x18\x01 \x01(\r\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12$\n\rUpload_method\x18\x03 \x01(\x0e\x32\r.Uploadmethod\x12\x17\n\x0fUpload_interval\x18\x04 \x01(\r\x12\'\n\x0f\x65nabled_sensors\x18\x05 \x03(\x0e\x32\x0e.EnabledSensor\x12\x38\n\x18\x65nabled_sensors_multiple\x18\x0e \x03(\x0b\x32\x16.EnabledSensorMultiple\x12\x15\n\rVoltage_Slope\x18\x06 \x01(\x01\x12\x16\n\x0eVoltage_Offset\x18\x07 \x01(\x01\x12\x15\n\rCurrent_Slope\x18\x08 \x01(\x01\x12\x16\n\x0e\x43urrent_Offset\x18\t \x01(\x01\x12\x11\n\tWiFi_SSID\x18\n \x01(\t\x12\x15\n\rWiFi_Password\x18\x0b \x01(\t\x12\x18\n\x10\x41PI_Endpoint_URL\x18\x0c \x01(\t\x12\x19\n\x11\x41PI_Endpoint_Port\x18\r \x01(\r\"\x17\n\x08\x61\x64\x63Value\x12\x0b\n\x03\x61\x64\x63\x18\x01 \x01(\r\"\xfa\x01\n\x15\x45nabledSensorMultiple\x12&\n\x0e\x65nabled_sensor\x18\x01 \x01(\x0e\x32\x0e.EnabledSensor\x12\x0f\n\x07\x63\x65ll_id\x18\x02 \x01(\r\x12\r\n\x05index\x18\x03 \x01(\r\x12\x0e\n\x06period\x18\x04 \x01(\r\x12\r\n\x05phase\x18\x05 \x01(\r\x12\x17\n\x0f\x61ggregate_count\x18\x06 \x01(\r\x12\x18\n\x10\x61ggregate_period\x18\x07 \x01(\r\x12\x19\n\x11\x64\x65\x61\x64\x62\x61nd_absolute\x18\x08 \x01(\x02\x12\x19\n\x11\x64\x65\x61\x64\x62\x61nd_relative\x18\t \x01(\x02\x12\x11\n\theartbeat\x18\n \x01(\r*\xdc\x01\n\rEnabledSensor\x12\x0b\n\x07Voltage\x10\x00\x12\x0b\n\x07\x43urrent\x10\x01\x12\x0b\n\x07Teros12\x10\x02\x12\x0b\n\x07Teros21\x10\x03\x12\n\n\x06\x42ME280\x10\x04\x12\x0c\n\x08Phytos31\x10\x05\x12\x0b\n\x07SEN0308\x10\x06\x12\x0b\n\x07SEN0257\x10\x07\x12\x0b\n\x07YFS210C\x10\x08\x12\n\n\x06PCAP02\x10\t\x12\x07\n\x03\x44\x31\x30\x10\n\x12\x12\n\x0eWATERMARK200SS\x10\x0b\x12\x12\n\x0eWATERMARK200TS\x10\x0c\x12\x0b\n\x07\x45\x44U0157\x10\r\x12\x0c\n\x08\x41LSMPM2F\x10\x0e*\"\n\x0cUploadmethod\x12\x08\n\x04LoRa\x10\x00\x12\x08\n\x04WiFi\x10\x01\x62\x06proto3')
 
 _globals = globals()
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, _globals)
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'soil_power_sensor_pb2', _globals)
 if not _descriptor._USE_C_DESCRIPTORS:
   DESCRIPTOR._loaded_options = None
-  _globals['_ENABLEDSENSOR']._serialized_start=4948
-  _globals['_ENABLEDSENSOR']._serialized_end=5168
-  _globals['_UPLOADMETHOD']._serialized_start=5170
-  _globals['_UPLOADMETHOD']._serialized_end=5204
+  _globals['_ENABLEDSENSOR']._serialized_start=5128
+  _globals['_ENABLEDSENSOR']._serialized_end=5348
+  _globals['_UPLOADMETHOD']._serialized_start=5350
+  _globals['_UPLOADMETHOD']._serialized_end=5384
   _globals['_MEASUREMENTMETADATA']._serialized_start=41
   _globals['_MEASUREMENTMETADATA']._serialized_end=110
   _globals['_POWERMEASUREMENT']._serialized_start=112
@@ -53,79 +53,79 @@ if not _descriptor._USE_C_DESCRIPTORS:
   _globals['_POWERMEASUREMENTDELTA']._serialized_start=409
   _globals['_POWERMEASUREMENTDELTA']._serialized_end=478
   _globals['_REPEATEDPOWERDELTAS']._serialized_start=480
-  _globals['_REPEATEDPOWERDELTAS']._serialized_end=572
-  _globals['_TEROS12MEASUREMENT']._serialized_start=574
-  _globals['_TEROS12MEASUREMENT']._serialized_end=654
-  _globals['_TEROS21MEASUREMENT']._serialized_start=656
-  _globals['_TEROS21MEASUREMENT']._serialized_end=710
-  _globals['_PHYTOS31MEASUREMENT']._serialized_start=712
-  _globals['_PHYTOS31MEASUREMENT']._serialized_end=772
-  _globals['_BME280MEASUREMENT']._serialized_start=774
-  _globals['_BME280MEASUREMENT']._serialized_end=850
-  _globals['_SEN0308MEASUREMENT']._serialized_start=852
-  _globals['_SEN0308MEASUREMENT']._serialized_end=907
-  _globals['_SEN0257MEASUREMENT']._serialized_start=909
-  _globals['_SEN0257MEASUREMENT']._serialized_end=964
-  _globals['_YFS210CMEASUREMENT']._serialized_start=966
-  _globals['_YFS210CMEASUREMENT']._serialized_end=1000
-  _globals['_PCAP02MEASUREMENT']._serialized_start=1002
-  _globals['_PCAP02MEASUREMENT']._serialized_end=1042
-  _globals['_D10MEASUREMENT']._serialized_start=1044
-  _globals['_D10MEASUREMENT']._serialized_end=1118
-  _globals['_WATERMARK200SSMEASUREMENT']._serialized_start=1120
-  _globals['_WATERMARK200SSMEASUREMENT']._serialized_end=1169
-  _globals['_WATERMARK200TSMEASUREMENT']._serialized_start=1171
-  _globals['_WATERMARK200TSMEASUREMENT']._serialized_end=1219
-  _globals['_EDU0157MEASUREMENT']._serialized_start=1222
-  _globals['_EDU0157MEASUREMENT']._serialized_end=1361
-  _globals['_ALSMPM2FMEASUREMENT']._serialized_start=1363
-  _globals['_ALSMPM2FMEASUREMENT']._serialized_end=1417
-  _globals['_MEASUREMENT']._serialized_start=1420
-  _globals['_MEASUREMENT']._serialized_end=2062
-  _globals['_RESPONSE']._serialized_start=2064
-  _globals['_RESPONSE']._serialized_end=2152
-  _globals['_RESPONSE_RESPONSETYPE']._serialized_start=2114
-  _globals['_RESPONSE_RESPONSETYPE']._serialized_end=2152
-  _globals['_ESP32COMMAND']._serialized_start=2155
-  _globals['_ESP32COMMAND']._serialized_end=2479
-  _globals['_PAGECOMMAND']._serialized_start=2482
-  _globals['_PAGECOMMAND']._serialized_end=2664
-  _globals['_PAGECOMMAND_REQUESTTYPE']._serialized_start=2609
-  _globals['_PAGECOMMAND_REQUESTTYPE']._serialized_end=2664
-  _globals['_TESTCOMMAND']._serialized_start=2667
-  _globals['_TESTCOMMAND']._serialized_end=2797
-  _globals['_TESTCOMMAND_CHANGESTATE']._serialized_start=2737
-  _globals['_TESTCOMMAND_CHANGESTATE']._serialized_end=2797
-  _globals['_WIFICOMMAND']._serialized_start=2800
-  _globals['_WIFICOMMAND']._serialized_end=3125
-  _globals['_WIFICOMMAND_TYPE']._serialized_start=2974
-  _globals['_WIFICOMMAND_TYPE']._serialized_end=3125
-  _globals['_USERCONFIGCOMMAND']._serialized_start=3128
-  _globals['_USERCONFIGCOMMAND']._serialized_end=3301
-  _globals['_USERCONFIGCOMMAND_REQUESTTYPE']._serialized_start=3236
-  _globals['_USERCONFIGCOMMAND_REQUESTTYPE']._serialized_end=3301
-  _globals['_MICROSDCOMMAND']._serialized_start=3304
-  _globals['_MICROSDCOMMAND']._serialized_end=3833
-  _globals['_MICROSDCOMMAND_TYPE']._serialized_start=3619
-  _globals['_MICROSDCOMMAND_TYPE']._serialized_end=3651
-  _globals['_MICROSDCOMMAND_RETURNCODE']._serialized_start=3654
-  _globals['_MICROSDCOMMAND_RETURNCODE']._serialized_end=3825
-  _globals['_IRRIGATIONCOMMAND']._serialized_start=3836
-  _globals['_IRRIGATIONCOMMAND']._serialized_end=3984
-  _globals['_IRRIGATIONCOMMAND_TYPE']._serialized_start=3937
-  _globals['_IRRIGATIONCOMMAND_TYPE']._serialized_end=3954
-  _globals['_IRRIGATIONCOMMAND_STATE']._serialized_start=3956
-  _globals['_IRRIGATIONCOMMAND_STATE']._serialized_end=3984
-  _globals['_POWERCOMMAND']._serialized_start=3987
-  _globals['_POWERCOMMAND']._serialized_end=4414
-  _globals['_POWERCOMMAND_TYPE']._serialized_start=4101
-  _globals['_POWERCOMMAND_TYPE']._serialized_end=4130
-  _globals['_POWERCOMMAND_WAKEUPREASON']._serialized_start=4133
-  _globals['_POWERCOMMAND_WAKEUPREASON']._serialized_end=4414
-  _globals['_USERCONFIGURATION']._serialized_start=4417
-  _globals['_USERCONFIGURATION']._serialized_end=4823
-  _globals['_ADCVALUE']._serialized_start=4825
-  _globals['_ADCVALUE']._serialized_end=4848
-  _globals['_ENABLEDSENSORMULTIPLE']._serialized_start=4850
-  _globals['_ENABLEDSENSORMULTIPLE']._serialized_end=4945
+  _globals['_REPEATEDPOWERDELTAS']._serialized_end=596
+  _globals['_TEROS12MEASUREMENT']._serialized_start=598
+  _globals['_TEROS12MEASUREMENT']._serialized_end=678
+  _globals['_TEROS21MEASUREMENT']._serialized_start=680
+  _globals['_TEROS21MEASUREMENT']._serialized_end=734
+  _globals['_PHYTOS31MEASUREMENT']._serialized_start=736
+  _globals['_PHYTOS31MEASUREMENT']._serialized_end=796
+  _globals['_BME280MEASUREMENT']._serialized_start=798
+  _globals['_BME280MEASUREMENT']._serialized_end=874
+  _globals['_SEN0308MEASUREMENT']._serialized_start=876
+  _globals['_SEN0308MEASUREMENT']._serialized_end=931
+  _globals['_SEN0257MEASUREMENT']._serialized_start=933
+  _globals['_SEN0257MEASUREMENT']._serialized_end=988
+  _globals['_YFS210CMEASUREMENT']._serialized_start=990
+  _globals['_YFS210CMEASUREMENT']._serialized_end=1024
+  _globals['_PCAP02MEASUREMENT']._serialized_start=1026
+  _globals['_PCAP02MEASUREMENT']._serialized_end=1066
+  _globals['_D10MEASUREMENT']._serialized_start=1068
+  _globals['_D10MEASUREMENT']._serialized_end=1142
+  _globals['_WATERMARK200SSMEASUREMENT']._serialized_start=1144
+  _globals['_WATERMARK200SSMEASUREMENT']._serialized_end=1193
+  _globals['_WATERMARK200TSMEASUREMENT']._serialized_start=1195
+  _globals['_WATERMARK200TSMEASUREMENT']._serialized_end=1243
+  _globals['_EDU0157MEASUREMENT']._serialized_start=1246
+  _globals['_EDU0157MEASUREMENT']._serialized_end=1385
+  _globals['_ALSMPM2FMEASUREMENT']._serialized_start=1387
+  _globals['_ALSMPM2FMEASUREMENT']._serialized_end=1441
+  _globals['_MEASUREMENT']._serialized_start=1444
+  _globals['_MEASUREMENT']._serialized_end=2086
+  _globals['_RESPONSE']._serialized_start=2088
+  _globals['_RESPONSE']._serialized_end=2176
+  _globals['_RESPONSE_RESPONSETYPE']._serialized_start=2138
+  _globals['_RESPONSE_RESPONSETYPE']._serialized_end=2176
+  _globals['_ESP32COMMAND']._serialized_start=2179
+  _globals['_ESP32COMMAND']._serialized_end=2503
+  _globals['_PAGECOMMAND']._serialized_start=2506
+  _globals['_PAGECOMMAND']._serialized_end=2688
+  _globals['_PAGECOMMAND_REQUESTTYPE']._serialized_start=2633
+  _globals['_PAGECOMMAND_REQUESTTYPE']._serialized_end=2688
+  _globals['_TESTCOMMAND']._serialized_start=2691
+  _globals['_TESTCOMMAND']._serialized_end=2821
+  _globals['_TESTCOMMAND_CHANGESTATE']._serialized_start=2761
+  _globals['_TESTCOMMAND_CHANGESTATE']._serialized_end=2821
+  _globals['_WIFICOMMAND']._serialized_start=2824
+  _globals['_WIFICOMMAND']._serialized_end=3149
+  _globals['_WIFICOMMAND_TYPE']._serialized_start=2998
+  _globals['_WIFICOMMAND_TYPE']._serialized_end=3149
+  _globals['_USERCONFIGCOMMAND']._serialized_start=3152
+  _globals['_USERCONFIGCOMMAND']._serialized_end=3325
+  _globals['_USERCONFIGCOMMAND_REQUESTTYPE']._serialized_start=3260
+  _globals['_USERCONFIGCOMMAND_REQUESTTYPE']._serialized_end=3325
+  _globals['_MICROSDCOMMAND']._serialized_start=3328
+  _globals['_MICROSDCOMMAND']._serialized_end=3857
+  _globals['_MICROSDCOMMAND_TYPE']._serialized_start=3643
+  _globals['_MICROSDCOMMAND_TYPE']._serialized_end=3675
+  _globals['_MICROSDCOMMAND_RETURNCODE']._serialized_start=3678
+  _globals['_MICROSDCOMMAND_RETURNCODE']._serialized_end=3849
+  _globals['_IRRIGATIONCOMMAND']._serialized_start=3860
+  _globals['_IRRIGATIONCOMMAND']._serialized_end=4008
+  _globals['_IRRIGATIONCOMMAND_TYPE']._serialized_start=3961
+  _globals['_IRRIGATIONCOMMAND_TYPE']._serialized_end=3978
+  _globals['_IRRIGATIONCOMMAND_STATE']._serialized_start=3980
+  _globals['_IRRIGATIONCOMMAND_STATE']._serialized_end=4008
+  _globals['_POWERCOMMAND']._serialized_start=4011
+  _globals['_POWERCOMMAND']._serialized_end=4438
+  _globals['_POWERCOMMAND_TYPE']._serialized_start=4125
+  _globals['_POWERCOMMAND_TYPE']._serialized_end=4154
+  _globals['_POWERCOMMAND_WAKEUPREASON']._serialized_start=4157
+  _globals['_POWERCOMMAND_WAKEUPREASON']._serialized_end=4438
+  _globals['_USERCONFIGURATION']._serialized_start=4441
+  _globals['_USERCONFIGURATION']._serialized_end=4847
+  _globals['_ADCVALUE']._serialized_start=4849
+  _globals['_ADCVALUE']._serialized_end=4872
+  _globals['_ENABLEDSENSORMULTIPLE']._serialized_start=4875
+  _globals['_ENABLEDSENSORMULTIPLE']._serialized_end=5125
 # @@protoc_insertion_point(module_scope)
@@ -0,0 +1,145 @@
+"""Tests the decoder of the deferred binary log."""
+
+import struct
+import unittest
+
+from ents.binlog.decode import BinlogDecoder, cobs_decode, format_record
+
+# frame of BINLOG(1, MIX, -5, 7u, 0xbeef, "str", 1.5f, -3LL, 'z') written by
+# stm32/lib/binlog with a timestamp of 12345 ms
+MIX = "mix %d %u %x %s %f %lld %c\r\n"
+MIX_ID = 0x00405320
+MIX_FRAME = bytes.fromhex(
+    "022d04013930010420534006fbffffff07010103efbe01047374720101010101010cf83f"
+    "fdffffffffffffff7a010101"
+)
+
+TABLE = {
+    MIX_ID: MIX,
+    0x08001000: "Payload (%d): %H\r\n",
+}
+
+
+def cobs_encode(data: bytes) -> bytes:
+    """Encodes data like Encode in binlog.c, without delimiters."""
+
+    out = bytearray([0])
+    code_pos = 0
+    code = 1
+    for byte in data:
+        if byte != 0:
+            out.append(byte)
+            code += 1
+        if byte == 0 or code == 0xFF:
+            out[code_pos] = code
+            code_pos = len(out)
+            out.append(0)
+            code = 1
+    out[code_pos] = code
+    return bytes(out)
+
+
+def record(fmt_id: int, args: bytes, timestamp: int = 0) -> bytes:
+    """Builds a frame with delimiters."""
+
+    body = struct.pack("<BII", 2, timestamp, fmt_id) + args
+    return b"\0" + cobs_encode(struct.pack("<H", len(body)) + body) + b"\0"
+
+
+class TestCobs(unittest.TestCase):
+    """Tests COBS decoding."""
+
+    def test_firmware_parity(self):
+        """Tests a frame written by the firmware."""
+
+        data = cobs_decode(MIX_FRAME)
+        self.assertEqual(len(data) - 2, struct.unpack_from("<H", data)[0])
+
+    def test_round_trip(self):
+        """Tests zeros and blocks longer than 254 bytes."""
+
+        for data in [b"", b"\0", b"\0\0", bytes(range(256)) * 3, b"\1" * 254]:
+            self.assertEqual(data, cobs_decode(cobs_encode(data)))
+
+    def test_invalid(self):
+        """Tests a code past the end of the frame."""
+
+        with self.assertRaises(ValueError):
+            cobs_decode(b"\x05ab")
+
+
+class TestFormat(unittest.TestCase):
+    """Tests formatting the arguments of a record."""
+
+    def test_blob(self):
+        """Tests %H."""
+
+        args = struct.pack("<iH", 3, 3) + b"\x0a\x00\xff"
+        self.assertEqual(
+            "Payload (3): 0A00FF\r\n", format_record(TABLE[0x08001000], args)
+        )
+
+    def test_width(self):
+        """Tests flags, width and precision."""
+
+        args = struct.pack("<Id", 7, 2.5)
+        self.assertEqual("007 2.50 %", format_record("%03u %.2f %%", args))
+
+    def test_mismatch(self):
+        """Tests arguments not matching the format."""
+
+        with self.assertRaises(ValueError):
+            format_record("%d %d", struct.pack("<i", 1))
+        with self.assertRaises(ValueError):
+            format_record("%d", struct.pack("<ii", 1, 2))
+        with self.assertRaises(ValueError):
+            format_record("%s", b"abc")
+
+
+class TestDecoder(unittest.TestCase):
+    """Tests splitting a stream into text and records."""
+
+    def test_firmware_parity(self):
+        """Tests a frame written by the firmware."""
+
+        decoder = BinlogDecoder(TABLE)
+        self.assertEqual(
+            "12s345:mix -5 7 beef str 1.500000 -3 z\r\n",
+            decoder.feed(b"\0" + MIX_FRAME + b"\0"),
+        )
+
+    def test_mixed(self):
+        """Tests records between text, fed a byte at a time."""
+
+        stream = (
+            b"text\r\n"
+            + record(0x08001000, struct.pack("<iH", 1, 1) + b"\0", 1500)
+            + record(0, struct.pack("<I", 4), 2000)
+            + b"more text\r\n"
+            + record(0x1234, b"")
+        )
+
+        decoder = BinlogDecoder(TABLE)
+        out = "".join(decoder.feed(bytes([b])) for b in stream)
+        self.assertEqual(
+            "text\r\n"
+            "1s500:Payload (1): 00\r\n"
+            "2s000:binlog: 4 records dropped\r\n"
+            "more text\r\n"
+            "0s000:binlog: unknown format 0x00001234\r\n",
+            out,
+        )
+
+    def test_resync(self):
+        """Tests starting in the middle of a frame."""
+
+        frame = record(0x08001000, struct.pack("<iH", 1, 1) + b"\0")
+        stream = frame[5:] + b"text\r\n" + frame
+
+        decoder = BinlogDecoder(TABLE)
+        out = decoder.feed(stream)
+        self.assertTrue(out.endswith("text\r\n0s000:Payload (1): 00\r\n"))
+
+
+if __name__ == "__main__":
+    unittest.main()
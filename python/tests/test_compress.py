@@ -0,0 +1,157 @@
+"""Tests the compression codecs shared with the firmware."""
+
+import unittest
+
+from ents.compress.codec import (
+    Codec,
+    compress_payload,
+    decompress_payload,
+    encode_payload,
+)
+from ents.compress.delta import compress_delta, decompress_delta
+from ents.compress.dictionary import DICT, DICT_ID
+from ents.compress.lz77 import compress_lz77, decompress_lz77
+from ents.compress.rle import compress_rle, decompress_rle
+
+# extras/compression/messages/meas_power.bin
+MEAS_POWER = bytes.fromhex(
+    "0a0a0804100718f0abe3ac051212110000000000c0a240190000000000005940"
+)
+
+# output of LZ77Encode in stm32/test/test_compress
+MEAS_POWER_LZ77 = bytes.fromhex(
+    "00200502810040801c30f055b8d58050904822008000b0144400cc040800592000"
+)
+MEAS_POWER_LZ77_DICT = bytes.fromhex("01208ff6c000580a2200660204002c9000")
+MEAS_POWER_RLE = bytes.fromhex(
+    "0e0a0a0804100718f0abe3ac05121211820003c0a240198300015940"
+)
+MEAS_POWER_DELTA = bytes.fromhex(
+    "0100010a010b020c14171fe85b484fa917010203110405c062e2591905025919"
+)
+MEAS_POWER_CODEC = bytes.fromhex("0401208ff6c000580a2200660204002c9000")
+
+
+class TestLZ77(unittest.TestCase):
+    """Tests LZ77 with and without a static dictionary."""
+
+    def test_round_trip(self):
+        """Tests compressing and decompressing without a dictionary."""
+
+        compressed = compress_lz77(MEAS_POWER)
+        self.assertEqual(MEAS_POWER, decompress_lz77(compressed))
+
+    def test_round_trip_dict(self):
+        """Tests compressing and decompressing with the shipped dictionary."""
+
+        compressed = compress_lz77(MEAS_POWER, DICT, DICT_ID)
+        self.assertEqual(MEAS_POWER, decompress_lz77(compressed))
+
+    def test_empty(self):
+        """Tests an empty payload."""
+
+        compressed = compress_lz77(b"", DICT, DICT_ID)
+        self.assertEqual(b"", decompress_lz77(compressed))
+
+    def test_repetitive(self):
+        """Tests overlapping matches."""
+
+        data = bytes(i % 4 for i in range(200))
+        compressed = compress_lz77(data)
+        self.assertLess(len(compressed), len(data))
+        self.assertEqual(data, decompress_lz77(compressed))
+
+    def test_firmware_parity(self):
+        """Tests output is identical to the firmware encoder."""
+
+        self.assertEqual(MEAS_POWER_LZ77, compress_lz77(MEAS_POWER))
+        self.assertEqual(
+            MEAS_POWER_LZ77_DICT, compress_lz77(MEAS_POWER, DICT, DICT_ID)
+        )
+
+    def test_unknown_dict(self):
+        """Tests decoding with a missing dictionary."""
+
+        with self.assertRaises(ValueError):
+            decompress_lz77(MEAS_POWER_LZ77_DICT, {})
+
+    def test_invalid_dict_id(self):
+        """Tests a dictionary without an id."""
+
+        with self.assertRaises(ValueError):
+            compress_lz77(MEAS_POWER, DICT, 0)
+
+
+class TestRLE(unittest.TestCase):
+    """Tests run length encoding."""
+
+    def test_firmware_parity(self):
+        """Tests output is identical to the firmware encoder."""
+
+        compressed = compress_rle(MEAS_POWER)
+        self.assertEqual(MEAS_POWER_RLE, compressed)
+        self.assertEqual(MEAS_POWER, decompress_rle(compressed))
+
+    def test_long_run(self):
+        """Tests runs longer than a single packet."""
+
+        data = bytes(300)
+        compressed = compress_rle(data)
+        self.assertEqual(6, len(compressed))
+        self.assertEqual(data, decompress_rle(compressed))
+
+    def test_corrupt(self):
+        """Tests a truncated literal packet."""
+
+        with self.assertRaises(ValueError):
+            decompress_rle(b"\x03\x01\x02")
+
+
+class TestDelta(unittest.TestCase):
+    """Tests delta encoding."""
+
+    def test_firmware_parity(self):
+        """Tests output is identical to the firmware encoder."""
+
+        compressed = compress_delta(MEAS_POWER)
+        self.assertEqual(MEAS_POWER_DELTA, compressed)
+        self.assertEqual(MEAS_POWER, decompress_delta(compressed))
+
+    def test_records(self):
+        """Tests the stride is detected on repeated records."""
+
+        data = bytes(i // 12 if i % 12 == 3 else 0x40 + i % 12 for i in range(120))
+        compressed = compress_delta(data)
+        self.assertEqual(12, compressed[0])
+        self.assertLess(len(compressed), len(data) // 2)
+        self.assertEqual(data, decompress_delta(compressed))
+
+
+class TestCodec(unittest.TestCase):
+    """Tests codec selection and dispatch."""
+
+    def test_firmware_parity(self):
+        """Tests selection is identical to the firmware."""
+
+        compressed = compress_payload(MEAS_POWER)
+        self.assertEqual(MEAS_POWER_CODEC, compressed)
+        self.assertEqual(Codec.LZ77_DICT, compressed[0])
+        self.assertEqual(MEAS_POWER, decompress_payload(compressed))
+
+    def test_each_codec(self):
+        """Tests round trip of every codec."""
+
+        for codec in Codec:
+            compressed = encode_payload(MEAS_POWER, codec)
+            self.assertEqual(codec, compressed[0])
+            self.assertEqual(MEAS_POWER, decompress_payload(compressed))
+
+    def test_unknown(self):
+        """Tests an unknown codec id."""
+
+        with self.assertRaises(ValueError):
+            decompress_payload(bytes([len(Codec)]) + MEAS_POWER)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,146 @@
+"""Tests the decoder of the energy accounts."""
+
+import struct
+import unittest
+
+from ents.energy.decode import (
+    Currents,
+    decode_energy,
+    estimate,
+    find_blobs,
+    format_estimate,
+)
+
+# accounts written by EnergySerialize on the host at 1024 ticks per second,
+# with two measurements of 8 ticks and 120 ticks of HAL_Delay each, one
+# uplink of 16 ticks, 96 ticks of tx and 32 ticks of rx while sleeping and 2
+# ticks of LmHandlerProcess in between
+BLOB = bytes.fromhex(
+    "011403000400000100000002000000000000000000000000000000010000001000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000020000001000000000000000f00000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000000000000000000000000000000000000000000000000000000000000"
+    "000000000000000400000000000000000000000000000002000000f00000000000000000"
+    "000000000000000400000080200000000000000000000000000000000000000000000000"
+    "000000000000000000000002000000162100000000000001000000200000000000000001"
+    "0000006000000000000000"
+)
+
+
+class TestDecode(unittest.TestCase):
+    """Tests decoding the accounts."""
+
+    def test_firmware_parity(self):
+        """Tests accounts written by energy.c."""
+
+        report = decode_energy(BLOB)
+        self.assertEqual(
+            ["LmHandlerProcess", "LoRaSend", "Measurement"],
+            [a.name for a in report.tasks],
+        )
+        self.assertEqual(
+            ["run", "wait", "sleep", "stop"], [a.name for a in report.states]
+        )
+
+        measurement = report.get("Measurement")
+        self.assertEqual(2, measurement.count)
+        self.assertAlmostEqual(16 / 1024, measurement.time)
+        self.assertAlmostEqual(240 / 1024, measurement.wait)
+
+        self.assertEqual(2, report.get("wait").count)
+        self.assertAlmostEqual(240 / 1024, report.get("wait").time)
+        self.assertEqual(4, report.get("sleep").count)
+        self.assertAlmostEqual(8320 / 1024, report.get("sleep").time)
+        self.assertAlmostEqual(4 / 1024, report.get("run").time)
+
+        self.assertEqual(1, report.get("radio tx").count)
+        self.assertAlmostEqual(96 / 1024, report.get("radio tx").time)
+        self.assertAlmostEqual(32 / 1024, report.get("radio rx").time)
+
+        self.assertAlmostEqual(8598 / 1024, report.duration)
+
+    def test_invalid(self):
+        """Tests rejecting truncated accounts and other versions."""
+
+        with self.assertRaises(ValueError):
+            decode_energy(BLOB[:-1])
+        with self.assertRaises(ValueError):
+            decode_energy(b"\x02" + BLOB[1:])
+        with self.assertRaises(ValueError):
+            decode_energy(b"\x01")
+        with self.assertRaises(ValueError):
+            decode_energy(struct.pack("<BBBI", 1, 2, 3, 1024) + bytes(2 * 20 + 3 * 12))
+
+
+class TestEstimate(unittest.TestCase):
+    """Tests the energy estimates."""
+
+    def test_estimate(self):
+        """Tests the energy per measurement and per uplink."""
+
+        currents = Currents(
+            run_ma=10.0, sleep_ma=1.0, stop_ma=0.5, rx_ma=5.0, tx_ma=100.0, voltage=3.0
+        )
+        result = estimate(decode_energy(BLOB), currents)
+
+        # 128 ticks including the waits at 10 mA and 3 V
+        self.assertAlmostEqual(128 / 1024 * 30e-3, result.per_measurement)
+        # task and stack at 10 mA, tx at 100 mA and rx at 5 mA
+        self.assertAlmostEqual(
+            (18 * 30e-3 + 96 * 300e-3 + 32 * 15e-3) / 1024, result.per_uplink
+        )
+        self.assertAlmostEqual(8320 / 1024 * 3e-3, result.energy["sleep"])
+        self.assertAlmostEqual(0.0, result.energy["radio off"])
+        self.assertAlmostEqual(
+            result.total / result.duration / 3.0 * 1e3, result.mean_current
+        )
+
+    def test_defaults(self):
+        """Tests the defaults match ENERGY_CURRENTS_DEFAULT."""
+
+        result = estimate(decode_energy(BLOB))
+        self.assertAlmostEqual(128 / 1024 * 11.811e-3 * 3.9, result.per_measurement)
+
+    def test_no_entries(self):
+        """Tests estimates without measurements or uplinks."""
+
+        blob = struct.pack("<BBBI", 1, 4, 3, 1024)
+        blob += struct.pack("<IQQ", 0, 1024, 0) + bytes(3 * 20)
+        blob += bytes(3 * 12)
+        result = estimate(decode_energy(blob))
+        self.assertEqual([], decode_energy(blob).tasks)
+        self.assertEqual(0.0, result.per_measurement)
+        self.assertEqual(0.0, result.per_uplink)
+        self.assertAlmostEqual(11.811, result.mean_current)
+
+
+class TestLog(unittest.TestCase):
+    """Tests finding accounts in a log."""
+
+    def test_find(self):
+        """Tests accounts between text lines."""
+
+        text = (
+            "60s000:Profile: 010000CA9A3B\r\n"
+            f"60s000:Energy: {BLOB.hex().upper()}\r\n"
+            "61s000:SEND REQUEST\r\n"
+        )
+        self.assertEqual([BLOB], find_blobs(text))
+
+    def test_format(self):
+        """Tests the table and estimates."""
+
+        report = decode_energy(BLOB)
+        lines = format_estimate(report, estimate(report)).splitlines()
+        self.assertEqual(1 + 3 + 4 + 3 + 1 + 3, len(lines))
+        self.assertEqual(["Measurement", "2"], lines[3].split()[:2])
+        self.assertTrue(lines[-3].startswith("Energy per measurement: 5.758 mJ"))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,85 @@
+"""Tests the decoder of the profiling table."""
+
+import struct
+import unittest
+
+from ents.prof.decode import decode_stats, find_blobs, format_stats
+
+# table written by ProfSerialize on the host, with fifo_put called twice for
+# 480 and 520 ns, lm_send once for 48000 ns and sensor_0 never
+BLOB = bytes.fromhex(
+    "010300ca9a3b6669666f5f7075740000000002000000e001000008020000e80300000000"
+    "00006c6d5f73656e6400000000000100000080bb000080bb000080bb0000000000007365"
+    "6e736f725f30000000000000000000000000000000000000000000000000"
+)
+
+
+class TestDecode(unittest.TestCase):
+    """Tests decoding the table."""
+
+    def test_firmware_parity(self):
+        """Tests a table written by prof.c."""
+
+        stats = decode_stats(BLOB)
+        self.assertEqual(["fifo_put", "lm_send", "sensor_0"], [s.name for s in stats])
+
+        fifo_put = stats[0]
+        self.assertEqual(2, fifo_put.count)
+        self.assertAlmostEqual(480e-9, fifo_put.min)
+        self.assertAlmostEqual(520e-9, fifo_put.max)
+        self.assertAlmostEqual(1000e-9, fifo_put.total)
+        self.assertAlmostEqual(500e-9, fifo_put.mean)
+
+        self.assertAlmostEqual(48e-6, stats[1].total)
+        self.assertEqual(0, stats[2].count)
+        self.assertEqual(0.0, stats[2].mean)
+
+    def test_ticks(self):
+        """Tests converting cycles at 48 MHz."""
+
+        blob = struct.pack("<BBI", 1, 1, 48_000_000)
+        blob += struct.pack("<12sIIIQ", b"ctrl_txn", 1, 48, 48, 48)
+        (stats,) = decode_stats(blob)
+        self.assertAlmostEqual(1e-6, stats.min)
+
+    def test_invalid(self):
+        """Tests rejecting truncated tables and other versions."""
+
+        with self.assertRaises(ValueError):
+            decode_stats(BLOB[:-1])
+        with self.assertRaises(ValueError):
+            decode_stats(b"\x02" + BLOB[1:])
+        with self.assertRaises(ValueError):
+            decode_stats(b"\x01")
+
+
+class TestLog(unittest.TestCase):
+    """Tests finding tables in a log."""
+
+    def test_find(self):
+        """Tests tables between text lines."""
+
+        text = (
+            "1s000:Sleeping until next upload\r\n"
+            f"60s000:Profile: {BLOB.hex().upper()}\r\n"
+            "61s000:SEND REQUEST\r\n"
+            "120s000:Profile: 010000CA9A3B\r\n"
+        )
+        blobs = find_blobs(text)
+        self.assertEqual(2, len(blobs))
+        self.assertEqual(BLOB, blobs[0])
+        self.assertEqual([], decode_stats(blobs[1]))
+
+    def test_format(self):
+        """Tests sorting by total time."""
+
+        lines = format_stats(decode_stats(BLOB)).splitlines()
+        self.assertEqual(4, len(lines))
+        self.assertTrue(lines[1].startswith("lm_send"))
+        self.assertEqual(
+            ["fifo_put", "2", "0.5", "0.5", "0.5", "0.0"], lines[2].split()
+        )
+
+
+if __name__ == "__main__":
+    unittest.main()
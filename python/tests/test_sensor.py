@@ -5,8 +5,10 @@ import unittest
 from ents.proto.sensor import (
     decode_repeated_sensor_measurements,
     decode_sensor_measurement,
+    decode_sensor_response,
     encode_repeated_sensor_measurements,
     encode_sensor_measurement,
+    encode_sensor_response,
     get_sensor_data,
     update_repeated_metadata,
 )
@@ -214,6 +216,29 @@ class TestProtoSensor(unittest.TestCase):
 
         self.assertEqual(sensor_data, expected_data)
 
+    def test_sensor_response(self):
+        """Tests encoding/decoding of RepeatedSensorResponses."""
+
+        resp_in = {
+            "seq": 42,
+            "responses": [
+                {
+                    "idx": 2,
+                    "error": "GENERAL",
+                },
+                {
+                    "idx": 4,
+                    "error": "CELL",
+                },
+            ],
+        }
+
+        serialized = encode_sensor_response(resp_in)
+
+        resp_out = decode_sensor_response(serialized)
+
+        self.assertEqual(resp_in, resp_out)
+
 
 if __name__ == "__main__":
     unittest.main()
@@ -29,7 +29,7 @@ extern "C" {
 #include "main.h"
 
 /* USER CODE BEGIN Includes */
-
+#include <stdbool.h>
 /* USER CODE END Includes */
 
 extern I2C_HandleTypeDef hi2c1;
@@ -42,6 +42,31 @@ void MX_I2C1_Init(void);
 
 /* USER CODE BEGIN Prototypes */
 
+/**
+ * @brief Claim I2C1 for blocking transfers
+ *
+ * Interrupt driven transfers chained from a timer, such as the continuous
+ * conversions of the ADS1219, skip their tick while the bus is claimed.
+ * Waits for a chain in flight to finish. Claims nest and are only made from
+ * the main context.
+ *
+ * @param timeout Time to wait for the bus in ms
+ * @return HAL_TIMEOUT if the bus stayed busy, then it is not claimed
+ */
+HAL_StatusTypeDef I2C1_Claim(uint32_t timeout);
+
+/**
+ * @brief Release a claim of I2C1
+ */
+void I2C1_Release(void);
+
+/**
+ * @brief Check if I2C1 is claimed for blocking transfers
+ *
+ * @return true while claimed
+ */
+bool I2C1_Claimed(void);
+
 /* USER CODE END Prototypes */
 
 #ifdef __cplusplus
@@ -0,0 +1,111 @@
+/**
+ * @file log_conf.h
+ * @brief Compile time thresholds of the trace logs
+ *
+ * APP_LOG and BINLOG are filtered by UTIL_ADV_TRACE_SetVerboseLevel at run
+ * time, but the format strings and the code evaluating the arguments are
+ * still in the image. Calls above the threshold of their module are removed
+ * by the compiler instead, together with their format string and arguments.
+ *
+ * A source file joins a module by defining APP_LOG_MODULE before its first
+ * include:
+ *
+ * @code
+ * #define APP_LOG_MODULE PCAP02
+ *
+ * #include "pcap02.h"
+ * @endcode
+ *
+ * The threshold of a module is APP_LOG_LEVEL_<module> and defaults to
+ * APP_LOG_LEVEL, which defaults to VERBOSE_LEVEL. Files outside of a module
+ * use APP_LOG_LEVEL. Both can be set in the build flags, for example
+ * -DAPP_LOG_LEVEL_PCAP02=VLEVEL_L keeps the errors of the pcap02 and drops
+ * its register dumps. A level of VLEVEL_OFF keeps only VLEVEL_ALWAYS.
+ *
+ * log_report.py builds the firmware at each level and reports the flash and
+ * stack used by the logging of each module.
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef INC_LOG_CONF_H_
+#define INC_LOG_CONF_H_
+
+#include "stm32_adv_trace.h"
+#include "sys_conf.h"
+
+/** Threshold of all modules */
+#ifndef APP_LOG_LEVEL
+#define APP_LOG_LEVEL VERBOSE_LEVEL
+#endif /* APP_LOG_LEVEL */
+
+#ifndef APP_LOG_LEVEL_ADS
+#define APP_LOG_LEVEL_ADS APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_ADS */
+
+#ifndef APP_LOG_LEVEL_BME280
+#define APP_LOG_LEVEL_BME280 APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_BME280 */
+
+#ifndef APP_LOG_LEVEL_CONTROLLER
+#define APP_LOG_LEVEL_CONTROLLER APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_CONTROLLER */
+
+#ifndef APP_LOG_LEVEL_DFROBOT
+#define APP_LOG_LEVEL_DFROBOT APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_DFROBOT */
+
+#ifndef APP_LOG_LEVEL_LORA
+#define APP_LOG_LEVEL_LORA APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_LORA */
+
+#ifndef APP_LOG_LEVEL_MICROSD
+#define APP_LOG_LEVEL_MICROSD APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_MICROSD */
+
+#ifndef APP_LOG_LEVEL_PAYLOAD
+#define APP_LOG_LEVEL_PAYLOAD APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_PAYLOAD */
+
+#ifndef APP_LOG_LEVEL_PCAP02
+#define APP_LOG_LEVEL_PCAP02 APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_PCAP02 */
+
+#ifndef APP_LOG_LEVEL_SDI12
+#define APP_LOG_LEVEL_SDI12 APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_SDI12 */
+
+#ifndef APP_LOG_LEVEL_SENSORS
+#define APP_LOG_LEVEL_SENSORS APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_SENSORS */
+
+#ifndef APP_LOG_LEVEL_TCA9535
+#define APP_LOG_LEVEL_TCA9535 APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_TCA9535 */
+
+#ifndef APP_LOG_LEVEL_USER_CONFIG
+#define APP_LOG_LEVEL_USER_CONFIG APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_USER_CONFIG */
+
+#ifndef APP_LOG_LEVEL_WIFI
+#define APP_LOG_LEVEL_WIFI APP_LOG_LEVEL
+#endif /* APP_LOG_LEVEL_WIFI */
+
+#define APP_LOG_CAT(a, b) APP_LOG_CAT_(a, b)
+#define APP_LOG_CAT_(a, b) a##b
+
+/** Threshold of the current file */
+#ifdef APP_LOG_MODULE
+#define APP_LOG_MODULE_LEVEL APP_LOG_CAT(APP_LOG_LEVEL_, APP_LOG_MODULE)
+#else
+#define APP_LOG_MODULE_LEVEL APP_LOG_LEVEL
+#endif /* APP_LOG_MODULE */
+
+/**
+ * @brief Check if a level is compiled in the current file
+ *
+ * @param level Verbose level of the call
+ */
+#define APP_LOG_COMPILED(level) ((level) <= APP_LOG_MODULE_LEVEL)
+
+#endif  // INC_LOG_CONF_H_
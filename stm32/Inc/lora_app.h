@@ -73,9 +73,26 @@ extern "C" {
 
 /*!
  * LoRaWAN default confirm state
+ *
+ * Unconfirmed uplinks are dropped from the FRAM buffer at the next tx, unless
+ * the backend asked for a reupload on LORAWAN_SPS_RESPONSE_PORT, so an uplink
+ * no gateway heard loses its measurements.
+ *
+ * Set to LORAMAC_HANDLER_CONFIRMED_MSG for at least once delivery. Measurements
+ * are then only dropped once the network acked the uplink, at the cost of a
+ * downlink per uplink and of retransmissions, see
+ * LORAWAN_CONFIRMED_MSG_MAX_TRANS.
  */
 #define LORAWAN_DEFAULT_CONFIRMED_MSG_STATE LORAMAC_HANDLER_UNCONFIRMED_MSG
 
+/*!
+ * Max transmissions of a confirmed uplink that is not acked
+ *
+ * The LoRaMac layer does not report how many were used, so every confirmed
+ * uplink is charged this many times its airtime in the duty cycle budget.
+ */
+#define LORAWAN_CONFIRMED_MSG_MAX_TRANS 8
+
 /*!
  * LoRaWAN Adaptive Data Rate
  * @note Please note that when ADR is enabled the end-device should be static
@@ -139,11 +156,26 @@ extern "C" {
  *
  * Port 1 is used for original measurement format.
  * Port 2 is used for a new generic measurement format.
+ * Port 4 is used for the generic format compressed with CodecCompress, the
+ * first byte is the CodecId. Port 3 is taken by the class switch downlink.
+ * Port 5 is used for RepeatedPowerDeltas records from ADC burst sampling.
+ * Port 6 is used for RepeatedSensorResponses downlinks from the backend, which
+ * confirm or reject the measurements of the last uplink.
  *
  * @note do not use 224. It is reserved for certification
  */
 #define LORAWAN_SPS_MEAS_PORT 1
 #define LORAWAN_SPS_MEAS_GENERIC_PORT 2
+#define LORAWAN_SPS_MEAS_COMPRESSED_PORT 4
+#define LORAWAN_SPS_POWER_DELTAS_PORT 5
+#define LORAWAN_SPS_RESPONSE_PORT 6
+
+/*!
+ * Max estimated cycles spent selecting a codec for an uplink
+ *
+ * Only used when built with COMPRESS_PAYLOAD. Roughly 4ms at 48MHz.
+ */
+#define LORAWAN_COMPRESS_BUDGET 200000
 
 /* USER CODE END EC */
 
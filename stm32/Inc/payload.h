@@ -25,6 +25,10 @@ typedef enum _PayloadStatus {
   PAYLOAD_OK,
   PAYLOAD_ERROR,
   PAYLOAD_NO_DATA,
+  /** Payload is a RepeatedPowerDeltas record from burst sampling */
+  PAYLOAD_POWER_DELTAS,
+  /** Payload has to be uploaded again */
+  PAYLOAD_REUPLOAD,
 } PayloadStatus;
 
 /**
@@ -38,11 +42,41 @@ typedef enum _PayloadStatus {
  * @param size Size of the output buffer.
  * @param length Pointer to the length of the formatted payload.
  *
+ * Records written by burst sampling are already serialized as
+ * RepeatedPowerDeltas and are returned on their own, unmodified.
+ *
+ * The measurements are moved to the pending window of the FIFO buffer. Once
+ * the upload is done call FramCommit or PayloadAck if it succeeded, and
+ * FramRollback if it failed so they are uploaded again. The seq field of the
+ * message numbers the first measurement, see FramSeq.
+ *
  * @return PAYLOAD_OK on success, PAYLOAD_NO_DATA if no data is available,
+ * PAYLOAD_POWER_DELTAS if the payload is a RepeatedPowerDeltas message,
  * PAYLOAD_ERROR on failure.
  */
 PayloadStatus FormatPayload(uint8_t* buffer, size_t size, size_t* length);
 
+/**
+ * @brief Settles the pending upload with a response of the backend.
+ *
+ * The response is a RepeatedSensorResponses message. Its seq has to match the
+ * first pending measurement or be 0. A response with idx 0 is for the whole
+ * upload, otherwise idx counts the measurements of the upload from 1.
+ *
+ * Measurements are committed unless a response asks for a reupload, see
+ * CheckSensorResponse. Only the measurements that failed are queued again with
+ * FramCommitExcept, and all of them if the whole upload failed or the buffer
+ * has no room for the copies. Measurements with a format error are dropped.
+ *
+ * @param buffer Pointer to the response.
+ * @param length Length of the response.
+ *
+ * @return PAYLOAD_OK if committed, PAYLOAD_REUPLOAD if any are queued again,
+ * PAYLOAD_NO_DATA if nothing is pending, PAYLOAD_ERROR if the response can
+ * not be decoded or is for another upload.
+ */
+PayloadStatus PayloadAck(const uint8_t* buffer, size_t length);
+
 #ifdef __cplusplus
 }
 #endif
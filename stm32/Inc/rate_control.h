@@ -0,0 +1,41 @@
+/**
+ * @file rate_control.h
+ * @brief Adapts the upload rate of the node
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef INC_RATE_CONTROL_H_
+#define INC_RATE_CONTROL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Update the upload rate from the FRAM backlog
+ *
+ * Reads FramBufferLen() into the controller of lib/rate. Call from a task
+ * before arming the next upload, not from an interrupt.
+ *
+ * @return true if the rate changed
+ */
+bool RateControlUpdate(void);
+
+/**
+ * @brief Scale the upload period to the current rate
+ *
+ * @param period Upload period from the user config in ms
+ *
+ * @return Upload period in ms
+ */
+uint32_t RateControlUploadPeriod(uint32_t period);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // INC_RATE_CONTROL_H_
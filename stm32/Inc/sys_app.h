@@ -31,7 +31,7 @@ extern "C" {
 #include "stm32_adv_trace.h"
 #include "sys_conf.h"
 /* USER CODE BEGIN Includes */
-
+#include "log_conf.h"
 /* USER CODE END Includes */
 
 /* Exported defines ----------------------------------------------------------*/
@@ -77,7 +77,7 @@ extern "C" {
 #if defined(APP_LOG_ENABLED) && (APP_LOG_ENABLED == 1)
 #define APP_LOG(TS, VL, ...)                                     \
   do {                                                           \
-    {                                                            \
+    if (APP_LOG_COMPILED(VL)) {                                  \
       UTIL_ADV_TRACE_COND_FSend(VL, T_REG_OFF, TS, __VA_ARGS__); \
     }                                                            \
   } while (0);
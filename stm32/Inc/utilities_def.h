@@ -47,7 +47,9 @@ typedef enum {
   CFG_LPM_APPLI_Id,
   CFG_LPM_UART_TX_Id,
   /* USER CODE BEGIN CFG_LPM_Id_t */
-
+  CFG_LPM_ADC_Id,
+  CFG_LPM_ESP32_Id,
+  CFG_LPM_SDI12_Id,
   /* USER CODE END CFG_LPM_Id_t */
 } CFG_LPM_Id_t;
 
@@ -0,0 +1,74 @@
+/**
+ * @example example_adc_burst.c
+ *
+ * Example of high rate power sampling with the ADC.
+ *
+ * A burst of voltage and current samples is taken every 10 seconds and
+ * stored in the FRAM buffer as RepeatedPowerDeltas records. The records are
+ * read back, printed as hex and removed from the buffer. Each line can be
+ * decoded as a RepeatedPowerDeltas message after dropping the first byte.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+
+#include "ads.h"
+#include "board.h"
+#include "dma.h"
+#include "fifo.h"
+#include "gpio.h"
+#include "i2c.h"
+#include "rtc.h"
+#include "sys_app.h"
+#include "usart.h"
+
+/** Length of a burst in ms */
+#ifndef BURST_DURATION
+#define BURST_DURATION 1000
+#endif
+
+/** Delay between bursts in ms */
+#ifndef BURST_DELAY
+#define BURST_DELAY 10000
+#endif
+
+int main(void) {
+  HAL_Init();
+
+  SystemClock_Config();
+
+  MX_GPIO_Init();
+  MX_DMA_Init();
+  MX_USART2_UART_Init();
+  MX_I2C1_Init();
+
+  SystemApp_Init();
+
+  UserConfigLoad();
+  FIFO_Init();
+  FramBufferClear();
+
+  APP_PRINTF("example_adc_burst, compiled on %s %s\r\n", __DATE__, __TIME__);
+
+  ADC_init();
+
+  uint8_t record[256];
+  uint8_t record_len = 0;
+
+  while (1) {
+    const uint32_t start = HAL_GetTick();
+    HAL_StatusTypeDef status = ADC_burst(1, BURST_DURATION, ADC_RATE_330SPS);
+    APP_PRINTF("Burst status %d in %lu ms, %u records\r\n", status,
+               HAL_GetTick() - start, FramBufferLen());
+
+    while (FramGet(record, &record_len) == FRAM_OK) {
+      for (int i = 0; i < record_len; i++) {
+        APP_PRINTF("%02X", record[i]);
+      }
+      APP_PRINTF("\r\n");
+    }
+
+    HAL_Delay(BURST_DELAY);
+  }
+}
@@ -0,0 +1,179 @@
+/**
+ * @example example_binlog.c
+ *
+ * Cycle count of logging with APP_LOG and with BINLOG.
+ *
+ * A payload hex dump is logged the way SendTxData did before, with an
+ * APP_LOG per byte, and with a single BINLOG. A log with a single integer is
+ * compared as well. Only the log calls are counted, the trace is drained
+ * between calls so APP_LOG never finds its fifo full. The cost of flushing a
+ * BINLOG record, which is deferred until the sequencer is idle, is printed
+ * separately. The cycles are counted with the DWT cycle counter and printed
+ * every 10 seconds.
+ *
+ * Decode the output with
+ *
+ * @code
+ * ents binlog .pio/build/example_binlog/binlog.json <port>
+ * @endcode
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+
+#include "binlog.h"
+#include "board.h"
+#include "gpio.h"
+#include "sys_app.h"
+#include "usart.h"
+
+/** Number of log calls averaged */
+#define ITERATIONS 10
+
+/** Length of the payload */
+#define PAYLOAD_SIZE 50
+
+/** Delay between runs in ms */
+#ifndef BENCH_DELAY
+#define BENCH_DELAY 10000
+#endif
+
+/** Payload dumped as hex */
+static uint8_t payload[PAYLOAD_SIZE];
+
+/** Cycles spent flushing */
+static uint32_t flush_cycles = 0;
+
+/**
+ * @brief Start the DWT cycle counter
+ */
+static void CycleCounterInit(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Wait until the trace is sent
+ */
+static void WaitForTrace(void) {
+  while (!UTIL_ADV_TRACE_IsBufferEmpty()) {
+  }
+}
+
+/**
+ * @brief Send the frame to the trace
+ */
+static bool Send(const uint8_t *data, size_t len) {
+  return UTIL_ADV_TRACE_Send(data, len) == UTIL_ADV_TRACE_OK;
+}
+
+/**
+ * @brief Flush the binary log and count its cycles
+ */
+static void Flush(void) {
+  const uint32_t start = DWT->CYCCNT;
+  BinlogFlush(Send);
+  flush_cycles += DWT->CYCCNT - start;
+  WaitForTrace();
+}
+
+/**
+ * @brief Cycles per hex dump with APP_LOG
+ */
+static uint32_t HexAppLog(void) {
+  uint32_t cycles = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    const uint32_t start = DWT->CYCCNT;
+    APP_LOG(TS_ON, VLEVEL_M, "Payload (%d): ", PAYLOAD_SIZE);
+    for (int j = 0; j < PAYLOAD_SIZE; j++) {
+      APP_LOG(TS_OFF, VLEVEL_M, "%02X ", payload[j]);
+    }
+    APP_LOG(TS_OFF, VLEVEL_M, "\r\n");
+    cycles += DWT->CYCCNT - start;
+    WaitForTrace();
+  }
+  return cycles / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per hex dump with BINLOG
+ */
+static uint32_t HexBinlog(void) {
+  uint32_t cycles = 0;
+  flush_cycles = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    const uint32_t start = DWT->CYCCNT;
+    BINLOG(VLEVEL_M, "Payload (%d): %H\r\n", PAYLOAD_SIZE,
+           BINLOG_BLOB(payload, PAYLOAD_SIZE));
+    cycles += DWT->CYCCNT - start;
+    Flush();
+  }
+  return cycles / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per integer log with APP_LOG
+ */
+static uint32_t IntAppLog(void) {
+  uint32_t cycles = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    const uint32_t start = DWT->CYCCNT;
+    APP_LOG(TS_ON, VLEVEL_M, "Buffer length: %u\r\n", PAYLOAD_SIZE);
+    cycles += DWT->CYCCNT - start;
+    WaitForTrace();
+  }
+  return cycles / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per integer log with BINLOG
+ */
+static uint32_t IntBinlog(void) {
+  uint32_t cycles = 0;
+  flush_cycles = 0;
+  for (int i = 0; i < ITERATIONS; i++) {
+    const uint32_t start = DWT->CYCCNT;
+    BINLOG(VLEVEL_M, "Buffer length: %u\r\n", PAYLOAD_SIZE);
+    cycles += DWT->CYCCNT - start;
+    Flush();
+  }
+  return cycles / ITERATIONS;
+}
+
+int main(void) {
+  HAL_Init();
+
+  SystemClock_Config();
+
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  SystemApp_Init();
+
+  APP_PRINTF("example_binlog, compiled on %s %s\r\n", __DATE__, __TIME__);
+
+  CycleCounterInit();
+
+  for (int i = 0; i < PAYLOAD_SIZE; i++) {
+    payload[i] = i * 37;
+  }
+
+  while (1) {
+    const uint32_t hex_app_log = HexAppLog();
+    const uint32_t hex_binlog = HexBinlog();
+    const uint32_t hex_flush = flush_cycles / ITERATIONS;
+    const uint32_t int_app_log = IntAppLog();
+    const uint32_t int_binlog = IntBinlog();
+    const uint32_t int_flush = flush_cycles / ITERATIONS;
+
+    APP_PRINTF("%-10s %8s %8s %8s\r\n", "log", "APP_LOG", "BINLOG", "flush");
+    APP_PRINTF("%-10s %8lu %8lu %8lu\r\n", "hex dump", hex_app_log, hex_binlog,
+               hex_flush);
+    APP_PRINTF("%-10s %8lu %8lu %8lu\r\n", "integer", int_app_log, int_binlog,
+               int_flush);
+
+    HAL_Delay(BENCH_DELAY);
+  }
+}
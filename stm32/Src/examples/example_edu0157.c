@@ -63,11 +63,12 @@ int main(void) {
           TS_OFF, VLEVEL_ALWAYS,
           "WindSpeed: %.2f m/s, WindDirection: %s, Altitude: %.2f m, "
           "Pressure: %.2f hPa, Temperature: %.2f C, Humidity: %.2f %%RH\r\n",
-          data.wind_speed,
+          Q32ToDouble(data.wind_speed),
           (data.wind_direction >= 0 && data.wind_direction < 8)
               ? dir_str[data.wind_direction]
               : "UNKNOWN",
-          data.altitude, data.pressure, data.temperature, data.humidity);
+          Q32ToDouble(data.altitude), Q32ToDouble(data.pressure),
+          Q32ToDouble(data.temperature), Q32ToDouble(data.humidity));
     } else {
       APP_LOG(TS_OFF, VLEVEL_ALWAYS, "failed to read \r\n");
     }
@@ -0,0 +1,212 @@
+/**
+ * @example example_fixed_point.c
+ *
+ * Cycle count of the sensor conversions in double and in fixed point.
+ *
+ * Each conversion runs over a sweep of raw readings, once with the double
+ * equation the drivers used before and once with the fixed point calibration
+ * they use now. The cycles are counted with the DWT cycle counter and printed
+ * per conversion with the max difference between both, every 10 seconds.
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include "board.h"
+#include "calibration.h"
+#include "fixed.h"
+#include "gpio.h"
+#include "sys_app.h"
+#include "usart.h"
+
+/** Number of raw readings per conversion */
+#define SWEEP 256
+
+/** Delay between runs in ms */
+#ifndef BENCH_DELAY
+#define BENCH_DELAY 10000
+#endif
+
+/** Raw readings, volatile so the sweep is not folded */
+static volatile int32_t raw_codes[SWEEP];
+
+/** Results of the double equations */
+static double ref[SWEEP];
+
+/** Results of the fixed point calibrations */
+static double fixed[SWEEP];
+
+/**
+ * @brief Start the DWT cycle counter
+ */
+static void CycleCounterInit(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Print the cycles per conversion and the max difference
+ */
+static void PrintBench(const char *name, uint32_t ref_cycles,
+                       uint32_t fixed_cycles) {
+  double max_diff = 0;
+  for (int i = 0; i < SWEEP; i++) {
+    max_diff = fmax(max_diff, fabs(fixed[i] - ref[i]));
+  }
+
+  APP_PRINTF("%-20s %8lu %8lu %12.3e\r\n", name, ref_cycles / SWEEP,
+             fixed_cycles / SWEEP, max_diff);
+}
+
+/**
+ * @brief Watermark200 soil tension, 12 bit ADC code to kPa
+ */
+static void BenchWatermarkSS(void) {
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < SWEEP; i++) {
+    const double v = (double)raw_codes[i] * 3.3 / ((1 << 12) - 1);
+    ref[i] = v / 0.0117;
+  }
+  const uint32_t ref_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  const Calibration *cal =
+      CalibrationGet(SensorType_WATERMARK200SS_SOIL_TENSION);
+  for (int i = 0; i < SWEEP; i++) {
+    fixed[i] = Q32ToDouble(CalibrationApply(cal, Q32FromInt(raw_codes[i])));
+  }
+  const uint32_t fixed_cycles = DWT->CYCCNT - start;
+
+  PrintBench("watermark ss", ref_cycles, fixed_cycles);
+}
+
+/**
+ * @brief Watermark200 soil temperature, 12 bit ADC code to C
+ */
+static void BenchWatermarkTS(void) {
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < SWEEP; i++) {
+    const double v = (double)raw_codes[i] * 3.3 / ((1 << 12) - 1);
+    const double f = 50.68 * (v - 0.490) + 20;
+    ref[i] = (f - 32) * 5.0 / 9.0;
+  }
+  const uint32_t ref_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  const Calibration *cal =
+      CalibrationGet(SensorType_WATERMARK200TS_SOIL_TEMPERATURE);
+  for (int i = 0; i < SWEEP; i++) {
+    fixed[i] = Q32ToDouble(CalibrationApply(cal, Q32FromInt(raw_codes[i])));
+  }
+  const uint32_t fixed_cycles = DWT->CYCCNT - start;
+
+  PrintBench("watermark ts", ref_cycles, fixed_cycles);
+}
+
+/**
+ * @brief Teros12 calibrated counts to vwc in percent
+ */
+static void BenchTeros12(void) {
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < SWEEP; i++) {
+    const float vwc = (float)raw_codes[i] / 2 + 1500;
+    float vwc_adj = (3.879e-4 * vwc) - 0.6956;
+    vwc_adj *= 100;
+    ref[i] = vwc_adj;
+  }
+  const uint32_t ref_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  const Calibration *cal = CalibrationGet(SensorType_TEROS12_VWC_ADJ);
+  for (int i = 0; i < SWEEP; i++) {
+    const float vwc = (float)raw_codes[i] / 2 + 1500;
+    fixed[i] = Q32ToDouble(CalibrationApply(cal, Q32FromFloat(vwc)));
+  }
+  const uint32_t fixed_cycles = DWT->CYCCNT - start;
+
+  PrintBench("teros12 vwc", ref_cycles, fixed_cycles);
+}
+
+/**
+ * @brief YFS210C pulses over 1 s to L/min
+ */
+static void BenchFlow(void) {
+  const uint32_t sub_seconds = 100;
+
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < SWEEP; i++) {
+    const float minutes = (float)sub_seconds / 6000.0f;
+    ref[i] = ((float)raw_codes[i] / 7.5f) / minutes;
+  }
+  const uint32_t ref_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  const Calibration *cal = CalibrationGet(SensorType_YFS210C_FLOW);
+  for (int i = 0; i < SWEEP; i++) {
+    fixed[i] = Q32ToFloat(
+        CalibrationApply(cal, Q32FromRatio(raw_codes[i], sub_seconds)));
+  }
+  const uint32_t fixed_cycles = DWT->CYCCNT - start;
+
+  PrintBench("yfs210c flow", ref_cycles, fixed_cycles);
+}
+
+/**
+ * @brief ADS1219 code to V
+ */
+static void BenchAds(void) {
+  const double m = 1.0 / 1000;
+  const double b = 0;
+
+  uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < SWEEP; i++) {
+    ref[i] = (m * (raw_codes[i] << 11)) + b;
+  }
+  const uint32_t ref_cycles = DWT->CYCCNT - start;
+
+  start = DWT->CYCCNT;
+  const Calibration *cal = CalibrationGet(SensorType_POWER_VOLTAGE);
+  for (int i = 0; i < SWEEP; i++) {
+    fixed[i] =
+        Q32ToDouble(CalibrationApply(cal, Q32FromInt(raw_codes[i] << 11)));
+  }
+  const uint32_t fixed_cycles = DWT->CYCCNT - start;
+
+  PrintBench("ads voltage", ref_cycles, fixed_cycles);
+}
+
+int main(void) {
+  HAL_Init();
+
+  SystemClock_Config();
+
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  SystemApp_Init();
+
+  APP_PRINTF("example_fixed_point, compiled on %s %s\r\n", __DATE__,
+             __TIME__);
+
+  CycleCounterInit();
+
+  // 12 bit codes spread over the full range
+  for (int i = 0; i < SWEEP; i++) {
+    raw_codes[i] = (i * 4095) / (SWEEP - 1);
+  }
+
+  while (1) {
+    APP_PRINTF("%-20s %8s %8s %12s\r\n", "conversion", "double", "fixed",
+               "max diff");
+    BenchWatermarkSS();
+    BenchWatermarkTS();
+    BenchTeros12();
+    BenchFlow();
+    BenchAds();
+
+    HAL_Delay(BENCH_DELAY);
+  }
+}
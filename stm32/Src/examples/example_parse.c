@@ -0,0 +1,141 @@
+/**
+ * @example example_parse.c
+ *
+ * Cycle count of parsing sensor responses with sscanf and with the parsers
+ * from parse.h.
+ *
+ * A Teros12 response and an EDU0157 response are parsed with their original
+ * sscanf formats and with the parsers the drivers use now. The DWT cycles of
+ * each are printed every 10 seconds. The environment links the float
+ * support of sscanf, which the firmware no longer needs.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "parse.h"
+#include "sys_app.h"
+#include "usart.h"
+
+/** Number of parses averaged */
+#define ITERATIONS 100
+
+/** Delay between runs in ms */
+#ifndef BENCH_DELAY
+#define BENCH_DELAY 10000
+#endif
+
+/** Teros12 response */
+static const char teros12[] = "0+1846.16+22.3+20000";
+
+/** EDU0157 response */
+static const char edu0157[] =
+    "WindSpeed:1.20 m/s, WindDirection:NE, Altitude:312.50 m, "
+    "Pressure:978.30 hPa, Temp:21.40 C, Humi:45.10 %RH";
+
+/**
+ * @brief Start the DWT cycle counter
+ */
+static void CycleCounterInit(void) {
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Cycles per Teros12 parse with sscanf
+ */
+static uint32_t Teros12Sscanf(void) {
+  const uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < ITERATIONS; i++) {
+    char addr = 0;
+    float vwc = 0;
+    float temp = 0;
+    int ec = 0;
+    sscanf(teros12, "%1c+%f%f+%d", &addr, &vwc, &temp, &ec);
+  }
+  return (DWT->CYCCNT - start) / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per Teros12 parse with parse.h
+ */
+static uint32_t Teros12Parse(void) {
+  const uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < ITERATIONS; i++) {
+    char addr = 0;
+    q32_t vwc = 0;
+    q32_t temp = 0;
+    int32_t ec = 0;
+    const char *s = teros12;
+    (void)(ParseChar(&s, &addr) && ParseLiteral(&s, "+") &&
+           ParseFixed(&s, &vwc) && ParseFixed(&s, &temp) &&
+           ParseLiteral(&s, "+") && ParseInt(&s, &ec));
+  }
+  return (DWT->CYCCNT - start) / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per EDU0157 parse with sscanf
+ */
+static uint32_t Edu0157Sscanf(void) {
+  const uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < ITERATIONS; i++) {
+    float values[5] = {0};
+    char direction[4];
+    sscanf(edu0157,
+           "WindSpeed:%f m/s, WindDirection:%3[^,], Altitude:%f m, "
+           "Pressure:%f hPa, Temp:%f C, Humi:%f %%RH",
+           &values[0], direction, &values[1], &values[2], &values[3],
+           &values[4]);
+  }
+  return (DWT->CYCCNT - start) / ITERATIONS;
+}
+
+/**
+ * @brief Cycles per EDU0157 parse with parse.h
+ */
+static uint32_t Edu0157Parse(void) {
+  const uint32_t start = DWT->CYCCNT;
+  for (int i = 0; i < ITERATIONS; i++) {
+    q32_t values[5] = {0};
+    char direction[4];
+    const char *s = edu0157;
+    (void)(ParseLiteral(&s, "WindSpeed:") && ParseFixed(&s, &values[0]) &&
+           ParseLiteral(&s, " m/s, WindDirection:") &&
+           ParseToken(&s, ',', direction, sizeof(direction)) &&
+           ParseLiteral(&s, ", Altitude:") && ParseFixed(&s, &values[1]) &&
+           ParseLiteral(&s, " m, Pressure:") && ParseFixed(&s, &values[2]) &&
+           ParseLiteral(&s, " hPa, Temp:") && ParseFixed(&s, &values[3]) &&
+           ParseLiteral(&s, " C, Humi:") && ParseFixed(&s, &values[4]));
+  }
+  return (DWT->CYCCNT - start) / ITERATIONS;
+}
+
+int main(void) {
+  HAL_Init();
+
+  SystemClock_Config();
+
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  SystemApp_Init();
+
+  APP_PRINTF("example_parse, compiled on %s %s\r\n", __DATE__, __TIME__);
+
+  CycleCounterInit();
+
+  while (1) {
+    APP_PRINTF("%-10s %8s %8s\r\n", "response", "sscanf", "parse");
+    APP_PRINTF("%-10s %8lu %8lu\r\n", "teros12", Teros12Sscanf(),
+               Teros12Parse());
+    APP_PRINTF("%-10s %8lu %8lu\r\n", "edu0157", Edu0157Sscanf(),
+               Edu0157Parse());
+
+    HAL_Delay(BENCH_DELAY);
+  }
+}
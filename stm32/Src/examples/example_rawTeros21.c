@@ -78,8 +78,8 @@ int main(void) {
     status = Teros21GetMeasurement('0', &data);
 
     APP_PRINTF("Status code: %d\r\n", status);
-    APP_PRINTF("Water potential: %f, Temperature: %f\r\n", data.matric_pot,
-    data.temp);
+    APP_PRINTF("Water potential: %f, Temperature: %f\r\n",
+               Q32ToDouble(data.matric_pot), Q32ToDouble(data.temp));
     */
 
     /*
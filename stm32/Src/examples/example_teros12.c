@@ -58,7 +58,8 @@ int main(void) {
 
     snprintf(print_buffer, sizeof(print_buffer),
              "Status code: %d; addr = %c; vwc: %f; temp: %f; ec: %d", status,
-             data.addr, data.vwc, data.temp, data.ec);
+             data.addr, Q32ToDouble(data.vwc), Q32ToDouble(data.temp),
+             data.ec);
 
     APP_PRINTF("%s\r\n", print_buffer);
 
@@ -69,8 +69,8 @@ int main(void) {
 
     char print_buffer[256];
     snprintf(print_buffer, sizeof(print_buffer),
-             "Water potential: %f, Temperature: %f\r\n", data.matric_pot,
-             data.temp);
+             "Water potential: %f, Temperature: %f\r\n",
+             Q32ToDouble(data.matric_pot), Q32ToDouble(data.temp));
     APP_PRINTF("%s", print_buffer);
 
     // Sleep
@@ -22,6 +22,9 @@
 
 /* USER CODE BEGIN 0 */
 
+/** Number of claims of I2C1, only changed from the main context */
+static volatile uint8_t i2c1_claims = 0;
+
 /* USER CODE END 0 */
 
 I2C_HandleTypeDef hi2c1;
@@ -146,4 +149,35 @@ void HAL_I2C_MspDeInit(I2C_HandleTypeDef* i2cHandle)
 
 /* USER CODE BEGIN 1 */
 
+HAL_StatusTypeDef I2C1_Claim(uint32_t timeout)
+{
+  // set before waiting, a tick after this no longer starts a chain
+  ++i2c1_claims;
+
+  const uint32_t start = HAL_GetTick();
+  while (HAL_I2C_GetState(&hi2c1) != HAL_I2C_STATE_READY)
+  {
+    if (HAL_GetTick() - start >= timeout)
+    {
+      --i2c1_claims;
+      return HAL_TIMEOUT;
+    }
+  }
+
+  return HAL_OK;
+}
+
+void I2C1_Release(void)
+{
+  if (i2c1_claims > 0)
+  {
+    --i2c1_claims;
+  }
+}
+
+bool I2C1_Claimed(void)
+{
+  return i2c1_claims > 0;
+}
+
 /* USER CODE END 1 */
@@ -18,6 +18,8 @@
 /* USER CODE END Header */
 
 /* Includes ------------------------------------------------------------------*/
+#define APP_LOG_MODULE LORA
+
 #include "lora_app.h"
 
 #include "LmHandler.h"
@@ -32,15 +34,26 @@
 #include "utilities_def.h"
 
 /* USER CODE BEGIN Includes */
+#include <string.h>
 #include <time.h>
 
 #include "LmhpClockSync.h"
+#include "binlog.h"
+#ifdef COMPRESS_PAYLOAD
+#include "codec.h"
+#endif  // COMPRESS_PAYLOAD
+#include "energy.h"
+#include "fifo.h"
 #include "lora_size.h"
 #include "payload.h"
+#include "prof.h"
+#include "rate_control.h"
 #include "sensors.h"
 #include "status_led.h"
+#include "txplan.h"
 #include "userConfig.h"
 #include "user_config.h"
+#include "wakeup.h"
 
 /* USER CODE END Includes */
 
@@ -94,6 +107,9 @@ typedef enum TxEventType_e {
 
 /* USER CODE BEGIN PD */
 #define TIMESYNC_PERIOD 1000
+
+/** Shortest tx period in ms */
+#define TX_PERIOD_MIN 10000
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -161,6 +177,11 @@ static void StoreContext(void);
  */
 static void StopJoin(void);
 
+/**
+ * @brief  Process the LoRaWAN stack, charged to its energy account
+ */
+static void LmHandlerProcessTask(void);
+
 /**
  * @brief  Join switch timer callback function
  * @param  context ptr of Join switch context
@@ -222,6 +243,16 @@ static void OnPingSlotPeriodicityChanged(uint8_t pingSlotPeriodicity);
 static void OnSystemReset(void);
 
 /* USER CODE BEGIN PFP */
+/**
+ * @brief Airtime of an uplink charged to the duty cycle budget
+ *
+ * Confirmed uplinks are charged for every retransmission.
+ *
+ * @param region Active region
+ * @param dr Data rate
+ * @param len Length of the application payload in bytes
+ */
+static uint32_t UplinkAirtime(LoRaMacRegion_t region, int8_t dr, uint8_t len);
 /* USER CODE END PFP */
 
 /* Private variables ---------------------------------------------------------*/
@@ -235,6 +266,12 @@ static ActivationType_t ActivationType = LORAWAN_DEFAULT_ACTIVATION_TYPE;
  */
 static bool ForceRejoin = LORAWAN_FORCE_REJOIN_AT_BOOT;
 
+/**
+ * @brief The uplink of the pending measurements was sent, and acked if
+ * confirmed
+ */
+static bool PendingDelivered = false;
+
 /**
  * @brief LoRaWAN handler Callbacks
  */
@@ -306,6 +343,13 @@ static uint8_t AppDataBuffer[LORAWAN_APP_DATA_BUFFER_MAX_SIZE];
  */
 static LmHandlerAppData_t AppData = {0, 0, AppDataBuffer};
 
+/**
+ * @brief Tx period from the user configuration
+ *
+ * TxPeriodicity is this period scaled by the rate controller.
+ */
+static UTIL_TIMER_Time_t TxNominalPeriodicity = APP_TX_DUTYCYCLE;
+
 /* USER CODE END PV */
 
 /* Exported functions
@@ -337,7 +381,7 @@ void LoRaWAN_Init(void) {
                     OnStopJoinTimerEvent, NULL);
 
   UTIL_SEQ_RegTask((1 << CFG_SEQ_Task_LmHandlerProcess), UTIL_SEQ_RFU,
-                   LmHandlerProcess);
+                   LmHandlerProcessTask);
 
   UTIL_SEQ_RegTask((1 << CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent),
                    UTIL_SEQ_RFU, SendTxData);
@@ -419,6 +463,13 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin) {
 
 /* Private functions ---------------------------------------------------------*/
 /* USER CODE BEGIN PrFD */
+static uint32_t UplinkAirtime(LoRaMacRegion_t region, int8_t dr, uint8_t len) {
+  const uint32_t airtime = TxPlanAirtime(region, dr, len);
+  if (LORAWAN_DEFAULT_CONFIRMED_MSG_STATE == LORAMAC_HANDLER_CONFIRMED_MSG) {
+    return airtime * LORAWAN_CONFIRMED_MSG_MAX_TRANS;
+  }
+  return airtime;
+}
 
 /* USER CODE END PrFD */
 
@@ -445,6 +496,13 @@ static void OnRxData(LmHandlerAppData_t *appData, LmHandlerRxParams_t *params) {
         // CommissioningParams skipped.
     switch (appData->Port) {
       // TODO add cases for incoming data on ports
+      case LORAWAN_SPS_RESPONSE_PORT: {
+        const PayloadStatus status =
+            PayloadAck(appData->Buffer, appData->BufferSize);
+        APP_LOG(TS_OFF, VLEVEL_M, "Backend response, PayloadStatus = %d\r\n",
+                status);
+        break;
+      }
       default:
         APP_LOG(TS_OFF, VLEVEL_H, "OnRxData Port: %u\r\n", appData->Port);
         APP_LOG(TS_OFF, VLEVEL_H, "OnRxData BufferSize: %u\r\n",
@@ -462,6 +520,7 @@ static void OnRxData(LmHandlerAppData_t *appData, LmHandlerRxParams_t *params) {
 
 static void SendTxData(void) {
   /* USER CODE BEGIN SendTxData_1 */
+  ENERGY_SCOPE(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent);
 
   // preconditions
 
@@ -492,13 +551,17 @@ static void SendTxData(void) {
               TxPeriodicity);
 
       // clamp to 10s
-      if (TxPeriodicity < 10000) {
-        TxPeriodicity = 10000;
+      if (TxPeriodicity < TX_PERIOD_MIN) {
+        TxPeriodicity = TX_PERIOD_MIN;
         APP_LOG(TS_OFF, VLEVEL_L,
                 "Warning : upload interval too low, clamping to 10s\r\n");
       }
+      TxNominalPeriodicity = TxPeriodicity;
 
-      UTIL_TIMER_SetPeriod(&TxTimer, TxPeriodicity);
+      // restarts the timer, on a deadline shared with other tasks
+      UTIL_TIMER_SetPeriod(
+          &TxTimer, WakeupDelay(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent,
+                                TxPeriodicity, WAKEUP_SLACK));
 
       // start taking measurements
       SensorsStart();
@@ -510,12 +573,38 @@ static void SendTxData(void) {
     return;
   }
 
+  // speed up while there is a backlog, the timer picks up the new period when
+  // it is rearmed
+  const bool rate_changed = RateControlUpdate();
+  TxPeriodicity = RateControlUploadPeriod(TxNominalPeriodicity);
+  if (TxPeriodicity < TX_PERIOD_MIN) {
+    TxPeriodicity = TX_PERIOD_MIN;
+  }
+  if (rate_changed) {
+    APP_LOG(TS_ON, VLEVEL_M, "Upload interval set to %lums\r\n",
+            TxPeriodicity);
+  }
+
   // check if radio is busy
   if (LmHandlerIsBusy()) {
     APP_LOG(TS_ON, VLEVEL_M, "LmHandler is busy\r\n");
     return;
   }
 
+  // settle the last uplink once its receive windows closed, so a response in
+  // the same downlink as the ack was handled first
+  if (FramPendingLen() > 0) {
+    if (PendingDelivered) {
+      FramCommit();
+    } else {
+      APP_LOG(TS_ON, VLEVEL_M,
+              "Uplink of %u measurements not delivered, sending again\r\n",
+              FramPendingLen());
+      FramRollback();
+    }
+  }
+  PendingDelivered = false;
+
   // check if buffer is empty
   if (FramBufferLen() <= 0) {
     APP_LOG(TS_ON, VLEVEL_M, "Nothing in buffer\r\n");
@@ -532,9 +621,46 @@ static void SendTxData(void) {
   LmHandlerGetTxDatarate(&dr);
   uint8_t max_payload_size = lorawan_max_payload(region, dr);
 
+  // duty cycle budget of the region, known once joined
+  static TxPlan plan;
+  static bool plan_init = false;
+  if (!plan_init) {
+    TxPlanConfig plan_config;
+    TxPlanRegion(region, &plan_config);
+    TxPlanInit(&plan, &plan_config, UTIL_TIMER_GetCurrentTime());
+    plan_init = true;
+  }
+
+  // keep a single uplink within the dwell time limit
+  const uint8_t dwell_size = TxPlanMaxPayload(region, dr, plan.config.dwell_ms);
+  if (max_payload_size > dwell_size) {
+    max_payload_size = dwell_size;
+  }
+
+  // only format a payload that fits in the duty cycle budget, a refused one
+  // would only be rolled back
+  const uint32_t max_airtime = UplinkAirtime(region, dr, max_payload_size);
+  const uint32_t budget_wait =
+      TxPlanWait(&plan, UTIL_TIMER_GetCurrentTime(), max_airtime);
+  if (budget_wait != 0) {
+    APP_LOG(TS_ON, VLEVEL_M, "Duty cycle budget exhausted for %lums\r\n",
+            budget_wait);
+    return;
+  }
+
+#ifdef COMPRESS_PAYLOAD
+  // leave room for the codec id so the payload fits even if uncompressed
+  static uint8_t uncompressed[LORAWAN_APP_DATA_BUFFER_MAX_SIZE];
+  size_t uncompressed_len = 0;
+
+  PayloadStatus payload_status = PAYLOAD_OK;
+  payload_status = FormatPayload(
+      uncompressed, max_payload_size - CODEC_HEADER_SIZE, &uncompressed_len);
+#else
   PayloadStatus payload_status = PAYLOAD_OK;
   payload_status = FormatPayload(AppData.Buffer, max_payload_size,
                                  (size_t *)&AppData.BufferSize);
+#endif  // COMPRESS_PAYLOAD
   if (payload_status == PAYLOAD_ERROR) {
     APP_LOG(TS_ON, VLEVEL_M, "Error formatting payload\r\n");
     return;
@@ -543,6 +669,28 @@ static void SendTxData(void) {
     return;
   }
 
+#ifdef COMPRESS_PAYLOAD
+  if (payload_status == PAYLOAD_POWER_DELTAS) {
+    // already delta encoded
+    memcpy(AppData.Buffer, uncompressed, uncompressed_len);
+    AppData.BufferSize = uncompressed_len;
+  } else {
+    size_t compressed_len = 0;
+    CodecId codec = CODEC_NONE;
+    if (CodecCompress(uncompressed, uncompressed_len, LORAWAN_COMPRESS_BUDGET,
+                      AppData.Buffer, max_payload_size, &compressed_len,
+                      &codec) != COMPRESS_OK) {
+      APP_LOG(TS_ON, VLEVEL_M, "Error compressing payload\r\n");
+      FramRollback();
+      return;
+    }
+    AppData.BufferSize = compressed_len;
+    APP_LOG(TS_ON, VLEVEL_M, "Compressed %u -> %u bytes with codec %d\r\n",
+            (unsigned int)uncompressed_len, (unsigned int)compressed_len,
+            codec);
+  }
+#endif  // COMPRESS_PAYLOAD
+
   // Old code for measurements
   // FramStatus status = FramGet(AppData.Buffer, &AppData.BufferSize);
   // if (status != FRAM_OK)
@@ -569,23 +717,48 @@ static void SendTxData(void) {
   //  AppData.BufferSize = (uint8_t) size;
   //}
 
-  APP_LOG(TS_ON, VLEVEL_M, "Payload (%d): ", AppData.BufferSize);
-  for (int i = 0; i < AppData.BufferSize; i++) {
-    APP_LOG(TS_OFF, VLEVEL_M, "%02X ", AppData.Buffer[i]);
-  }
-  APP_LOG(TS_OFF, VLEVEL_M, "\r\n");
-  APP_LOG(TS_ON, VLEVEL_M, "%d\r\n", AppData.BufferSize);
+  BINLOG(VLEVEL_M, "Payload (%d): %H\r\n", AppData.BufferSize,
+         BINLOG_BLOB(AppData.Buffer, AppData.BufferSize));
 
-  AppData.Port = LORAWAN_SPS_MEAS_GENERIC_PORT;
+  if (payload_status == PAYLOAD_POWER_DELTAS) {
+    AppData.Port = LORAWAN_SPS_POWER_DELTAS_PORT;
+  } else {
+#ifdef COMPRESS_PAYLOAD
+    AppData.Port = LORAWAN_SPS_MEAS_COMPRESSED_PORT;
+#else
+    AppData.Port = LORAWAN_SPS_MEAS_GENERIC_PORT;
+#endif  // COMPRESS_PAYLOAD
+  }
 
   LmHandlerErrorStatus_t lmstatus;
-  lmstatus =
-      LmHandlerSend(&AppData, LORAWAN_DEFAULT_CONFIRMED_MSG_STATE, false);
+  {
+    PROF_SCOPE("lm_send");
+    lmstatus =
+        LmHandlerSend(&AppData, LORAWAN_DEFAULT_CONFIRMED_MSG_STATE, false);
+  }
   if (lmstatus == LORAMAC_HANDLER_SUCCESS) {
     APP_LOG(TS_ON, VLEVEL_L, "SEND REQUEST\r\n");
+
+    const uint32_t now = UTIL_TIMER_GetCurrentTime();
+    TxPlanSent(&plan, now, UplinkAirtime(region, dr, AppData.BufferSize));
+
+    // send a backlog back to back while the budget has room
+    const uint16_t backlog = FramBufferLen();
+    const uint32_t delay =
+        TxPlanNext(&plan, now, max_airtime, backlog, TxPeriodicity);
+    if (delay < TxPeriodicity) {
+      APP_LOG(TS_ON, VLEVEL_M, "Draining %u measurements, next in %lums\r\n",
+              backlog, delay);
+      // restarts the timer, the next tx rearms it with the period
+      UTIL_TIMER_SetPeriod(
+          &TxTimer,
+          WakeupDelay(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent, delay, 0));
+    }
   } else {
     APP_LOG(TS_OFF, VLEVEL_M, "Could not send request\r\n");
     APP_LOG(TS_OFF, VLEVEL_M, "LmHandlerSend status = %d\r\n", lmstatus);
+    // uploaded again on the next tx
+    FramRollback();
   }
 
   StatusLedOff();
@@ -596,7 +769,10 @@ static void SendTxData(void) {
 
 static void OnTxTimerEvent(void *context) {
   /* USER CODE BEGIN OnTxTimerEvent_1 */
-
+  // next tx slot one period after the last, moved onto a shared wakeup
+  UTIL_TIMER_SetPeriod(
+      &TxTimer, WakeupPeriod(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent,
+                             TxPeriodicity, WAKEUP_SLACK));
   /* USER CODE END OnTxTimerEvent_1 */
   UTIL_SEQ_SetTask((1 << CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent),
                    CFG_SEQ_Prio_0);
@@ -632,6 +808,21 @@ static void OnTxData(LmHandlerTxParams_t *params) {
       } else {
         APP_LOG(TS_OFF, VLEVEL_H, "UNCONFIRMED\r\n");
       }
+
+      // roll back the measurements of a failed uplink. A delivered one is
+      // only committed at the next tx, since the ack is handled before a
+      // response in the same downlink, which may queue some of them again
+      if (FramPendingLen() > 0 && params->AppData.Port == AppData.Port) {
+        if (params->Status == LORAMAC_EVENT_INFO_STATUS_OK &&
+            (params->MsgType == LORAMAC_HANDLER_UNCONFIRMED_MSG ||
+             params->AckReceived != 0)) {
+          PendingDelivered = true;
+        } else {
+          APP_LOG(TS_OFF, VLEVEL_M, "Uplink failed, %u measurements kept\r\n",
+                  FramPendingLen());
+          FramRollback();
+        }
+      }
     }
   }
   /* USER CODE END OnTxData_1 */
@@ -698,7 +889,11 @@ static void OnTxPeriodicityChanged(uint32_t periodicity) {
   UTIL_TIMER_SetPeriod(&TxTimer, TxPeriodicity);
   UTIL_TIMER_Start(&TxTimer);
   /* USER CODE BEGIN OnTxPeriodicityChanged_2 */
-
+  TxNominalPeriodicity = TxPeriodicity;
+  // restart on a deadline shared with other tasks
+  UTIL_TIMER_SetPeriod(
+      &TxTimer, WakeupDelay(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent,
+                            TxPeriodicity, WAKEUP_SLACK));
   /* USER CODE END OnTxPeriodicityChanged_2 */
 }
 
@@ -737,7 +932,8 @@ static void OnSystemReset(void) {
 
 static void StopJoin(void) {
   /* USER CODE BEGIN StopJoin_1 */
-
+  ENERGY_SCOPE(CFG_SEQ_Task_LoRaStopJoinEvent);
+  WakeupCancel(CFG_SEQ_Task_LoRaSendOnTxTimerOrButtonEvent);
   /* USER CODE END StopJoin_1 */
 
   UTIL_TIMER_Stop(&TxTimer);
@@ -779,7 +975,7 @@ static void StoreContext(void) {
   LmHandlerErrorStatus_t status = LORAMAC_HANDLER_ERROR;
 
   /* USER CODE BEGIN StoreContext_1 */
-
+  ENERGY_SCOPE(CFG_SEQ_Task_LoRaStoreContextEvent);
   /* USER CODE END StoreContext_1 */
   status = LmHandlerNvmDataStore();
 
@@ -793,6 +989,11 @@ static void StoreContext(void) {
   /* USER CODE END StoreContext_Last */
 }
 
+static void LmHandlerProcessTask(void) {
+  ENERGY_SCOPE(CFG_SEQ_Task_LmHandlerProcess);
+  LmHandlerProcess();
+}
+
 static void OnNvmDataChange(LmHandlerNvmContextStates_t state) {
   /* USER CODE BEGIN OnNvmDataChange_1 */
 
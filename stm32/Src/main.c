@@ -42,6 +42,7 @@
 #include "teros21.h"
 #include "userConfig.h"
 #include "user_config.h"
+#include "wakeup.h"
 #include "waterFlowD10.h"
 #include "waterFlowYFS210C.h"
 #include "waterLevel.h"
@@ -149,20 +150,20 @@ int main(void) {
     EnabledSensorMultiple* sensor_ctx = &(cfg->enabled_sensors_multiple[i]);
     if (sensor == EnabledSensor_Voltage) {
       ADC_init();
-      SensorsAdd(ADC_measureVoltage, sensor_ctx);
+      SensorsAddAsync(&ADC_asyncVoltage, ADC_encodeVoltage, sensor_ctx);
       APP_LOG(TS_OFF, VLEVEL_M, "Voltage Enabled!\n");
     }
     if (sensor == EnabledSensor_Current) {
       ADC_init();
-      SensorsAdd(ADC_measureCurrent, sensor_ctx);
+      SensorsAddAsync(&ADC_asyncCurrent, ADC_encodeCurrent, sensor_ctx);
       APP_LOG(TS_OFF, VLEVEL_M, "Current Enabled!\n");
     }
     if (sensor == EnabledSensor_Teros12) {
       APP_LOG(TS_OFF, VLEVEL_M, "Teros12 Enabled!\n");
-      SensorsAdd(Teros12Measure, sensor_ctx);
+      SensorsAddAsync(&Teros12Async, Teros12Encode, sensor_ctx);
     }
     if (sensor == EnabledSensor_Teros21) {
-      SensorsAdd(Teros21Measure, sensor_ctx);
+      SensorsAddAsync(&Teros21Async, Teros21Encode, sensor_ctx);
       APP_LOG(TS_OFF, VLEVEL_M, "Teros21 Enabled!\n");
     }
     if (sensor == EnabledSensor_BME280) {
@@ -229,6 +230,9 @@ int main(void) {
 
   // init either WiFi or LoRaWAN
   if (cfg->Upload_method == Uploadmethod_LoRa) {
+    // the receive windows dominate the wakeups, coalescing only makes tasks
+    // late
+    WakeupSetMaxSlack(0);
     MX_LoRaWAN_Init();
   } else if (cfg->Upload_method == Uploadmethod_WiFi) {
     WiFiInit();
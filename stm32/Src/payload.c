@@ -1,11 +1,49 @@
+#define APP_LOG_MODULE PAYLOAD
+
 #include "payload.h"
 
+#include <string.h>
+
+#include "binlog.h"
 #include "fifo.h"
+#include "power_delta.h"
+#include "prof.h"
 #include "sensor.h"
 
+/**
+ * @brief Formats a RepeatedPowerDeltas record peeked into buffer
+ *
+ * The marker byte is stripped and the record is moved to the pending window of
+ * the FIFO. Records larger than the payload can never be sent so they are
+ * dropped.
+ */
+static PayloadStatus FormatPowerDeltas(uint8_t* buffer, size_t size,
+                                       size_t* length) {
+  const size_t record_len = *((uint8_t*)length) - 1;
+
+  if (record_len > size) {
+    FramDrop();
+    APP_LOG(TS_ON, VLEVEL_M,
+            "Dropped power delta record of %d bytes, max payload %d\r\n",
+            (int)record_len, (int)size);
+    return PAYLOAD_ERROR;
+  }
+
+  FramPend(1);
+
+  memmove(buffer, buffer + 1, record_len);
+  *length = record_len;
+
+  return PAYLOAD_POWER_DELTAS;
+}
+
 PayloadStatus FormatPayload(uint8_t* buffer, size_t size, size_t* length) {
-  // array of measurements that will get uploaded
-  SensorMeasurement meas[16] = {};
+  PROF_SCOPE("payload_fmt");
+
+  // array of measurements that will get uploaded, static since the summary
+  // in the value makes it too large for the stack
+  static SensorMeasurement meas[16];
+  memset(meas, 0, sizeof(meas));
   size_t meas_count = 0;
 
   // storing current payload size
@@ -19,8 +57,12 @@ PayloadStatus FormatPayload(uint8_t* buffer, size_t size, size_t* length) {
   // would be automatically handled and optimized for packet size.
   Metadata meta = Metadata_init_default;
 
-  // Loop until the payload size is exceeded
-  while (current_payload_size <= size) {
+  // number of the first measurement, kept if it is uploaded again
+  const uint32_t seq = FramSeq() + FramPendingLen();
+
+  // Loop until the next measurement would exceed the payload size
+  const size_t max_meas = sizeof(meas) / sizeof(meas[0]);
+  while (meas_count < max_meas) {
     // get next serialized measurement
     fram_status = FramPeek(meas_count, buffer, (uint8_t*) length);
     if (fram_status == FRAM_BUFFER_EMPTY || fram_status == FRAM_OUT_OF_RANGE) {
@@ -36,42 +78,125 @@ PayloadStatus FormatPayload(uint8_t* buffer, size_t size, size_t* length) {
       return PAYLOAD_ERROR;
     }
 
-    APP_LOG(TS_ON, VLEVEL_H, "FramPeek(idx=%d, data=0x%p, length=%d): 0x",
-            meas_count, buffer, *((uint8_t*)length));
-    for (uint8_t i = 0; i < *((uint8_t*)length); i++) {
-      APP_LOG(TS_OFF, VLEVEL_H, " %02X", buffer[i]);
+    // burst records are sent on their own
+    if (*((uint8_t*)length) > 0 && buffer[0] == POWER_DELTA_RECORD_MARKER) {
+      if (meas_count > 0) {
+        break;
+      }
+      return FormatPowerDeltas(buffer, size, length);
     }
-    APP_LOG(TS_OFF, VLEVEL_H, "\r\n");
+
+    BINLOG(VLEVEL_H, "FramPeek(idx=%d, length=%d): %H\r\n", meas_count,
+           *((uint8_t*)length), BINLOG_BLOB(buffer, *((uint8_t*)length)));
 
     // decode measurement
     sensor_status =
-        DecodeSensorMeasurement(buffer, *((uint8_t*)length), &meas[meas_count++]);
+        DecodeSensorMeasurement(buffer, *((uint8_t*)length), &meas[meas_count]);
     if (sensor_status != SENSOR_OK) {
       APP_LOG(TS_ON, VLEVEL_M,
               "Error decoding sensor measurement from buffer. SensorStatus = %d\r\n", sensor_status);
       return PAYLOAD_ERROR;
     }
 
-    sensor_status = RepeatedSensorMeasurementsSize(meta, meas,
-        meas_count, &current_payload_size); 
+    sensor_status = SequencedSensorMeasurementsSize(seq, meta, meas,
+        meas_count + 1, &current_payload_size);
     if (sensor_status != SENSOR_OK) {
       APP_LOG(TS_ON, VLEVEL_M,
               "Error calculating repeated sensor measurements size. SensorStatus = %d\r\n", sensor_status);
       return PAYLOAD_ERROR;
     }
-  }
 
-  // when exit we are over the payload limit so back off one
-  //meas_count--;
+    // leave the measurement for the next payload
+    if (current_payload_size > size) {
+      if (meas_count == 0) {
+        APP_LOG(TS_ON, VLEVEL_M,
+                "Measurement of %d bytes does not fit in %d byte payload\r\n",
+                (int)current_payload_size, (int)size);
+        return PAYLOAD_ERROR;
+      }
+      break;
+    }
+
+    ++meas_count;
+  }
 
   // encode measurements into AppData buffer
-  EncodeRepeatedSensorMeasurements(meta, meas,
+  sensor_status = EncodeSequencedSensorMeasurements(seq, meta, meas,
       meas_count, buffer, size, length);
-
-  // drop uploaded measurements
-  for (int i = 0; i < meas_count; i++) {
-    FramDrop();
+  if (sensor_status != SENSOR_OK) {
+    APP_LOG(TS_ON, VLEVEL_M,
+            "Error encoding sensor measurements. SensorStatus = %d\r\n",
+            sensor_status);
+    return PAYLOAD_ERROR;
   }
 
+  // kept in the buffer until the upload is confirmed
+  FramPend(meas_count);
+
   return PAYLOAD_OK;
 }
+
+PayloadStatus PayloadAck(const uint8_t* buffer, size_t length) {
+  static RepeatedSensorResponses resp;
+  memset(&resp, 0, sizeof(resp));
+
+  if (DecodeRepeatedSensorReponses(buffer, length, &resp) != SENSOR_OK) {
+    return PAYLOAD_ERROR;
+  }
+
+  // a late response to an uplink that was already settled
+  if (resp.seq != 0 && resp.seq != FramSeq()) {
+    APP_LOG(TS_ON, VLEVEL_M, "Response for seq %lu, pending %lu\r\n",
+            resp.seq, FramSeq());
+    return PAYLOAD_ERROR;
+  }
+
+  if (FramPendingLen() == 0) {
+    return PAYLOAD_NO_DATA;
+  }
+
+  // indices in the pending window of measurements to upload again
+  uint16_t failed[sizeof(resp.responses) / sizeof(resp.responses[0])];
+  uint16_t failed_count = 0;
+
+  for (pb_size_t i = 0; i < resp.responses_count; i++) {
+    const SensorResponse* r = &resp.responses[i];
+    const SensorStatus status = CheckSensorResponse(r);
+
+    // idx 0 is the whole upload, the backend drops duplicates
+    if (r->idx == 0) {
+      if (status == SENSOR_REUPLOAD) {
+        APP_LOG(TS_ON, VLEVEL_M, "Upload of %u measurements failed\r\n",
+                FramPendingLen());
+        FramRollback();
+        return PAYLOAD_REUPLOAD;
+      }
+      continue;
+    }
+
+    // otherwise the measurement at idx counted from 1
+    if (r->idx > FramPendingLen()) {
+      APP_LOG(TS_ON, VLEVEL_M, "Response for idx %lu of %u measurements\r\n",
+              r->idx, FramPendingLen());
+    } else if (status == SENSOR_REUPLOAD) {
+      failed[failed_count++] = r->idx - 1;
+    } else if (status == SENSOR_FORMAT) {
+      // can never be stored by the backend
+      APP_LOG(TS_ON, VLEVEL_M, "Measurement %lu rejected, error %d\r\n",
+              r->idx, r->error);
+    }
+  }
+
+  if (failed_count == 0) {
+    FramCommit();
+    return PAYLOAD_OK;
+  }
+
+  APP_LOG(TS_ON, VLEVEL_M, "Upload of %u of %u measurements failed\r\n",
+          failed_count, FramPendingLen());
+  // without room for the failed ones all of them are uploaded again
+  if (FramCommitExcept(failed, failed_count) != FRAM_OK) {
+    FramRollback();
+  }
+  return PAYLOAD_REUPLOAD;
+}
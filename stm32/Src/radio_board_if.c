@@ -22,7 +22,7 @@
 #include "radio_board_if.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "energy.h"
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -111,7 +111,19 @@ int32_t RBI_DeInit(void)
 int32_t RBI_ConfigRFSwitch(RBI_Switch_TypeDef Config)
 {
   /* USER CODE BEGIN RBI_ConfigRFSwitch_1 */
-
+  switch (Config)
+  {
+    case RBI_SWITCH_RX:
+      EnergyRadio(ENERGY_RADIO_RX);
+      break;
+    case RBI_SWITCH_RFO_LP:
+    case RBI_SWITCH_RFO_HP:
+      EnergyRadio(ENERGY_RADIO_TX);
+      break;
+    default:
+      EnergyRadio(ENERGY_RADIO_OFF);
+      break;
+  }
   /* USER CODE END RBI_ConfigRFSwitch_1 */
 #if defined(USE_BSP_DRIVER)
 
@@ -0,0 +1,26 @@
+#define APP_LOG_MODULE SENSORS
+
+#include "rate_control.h"
+
+#include "fifo.h"
+#include "rate.h"
+#include "sys_app.h"
+
+/** Controller, starts at the nominal rate */
+static RateController rate = {RATE_CONFIG_DEFAULT, false, RATE_SCALE_NOMINAL};
+
+bool RateControlUpdate(void) {
+  const uint16_t backlog = FramBufferLen();
+
+  if (!RateUpdate(&rate, backlog)) {
+    return false;
+  }
+
+  APP_LOG(TS_ON, VLEVEL_M, "Rates: backlog %u, upload %u%%\r\n", backlog,
+          rate.upload_scale);
+  return true;
+}
+
+uint32_t RateControlUploadPeriod(uint32_t period) {
+  return RateUploadPeriod(&rate, period);
+}
@@ -25,7 +25,7 @@
 #include "usart_if.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "energy.h"
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -65,7 +65,10 @@ const struct UTIL_LPM_Driver_s UTIL_PowerDriver =
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN PV */
-
+/**
+  * Energy account before the low power mode, a task when waiting in LowPowerDelay
+  */
+static int EnergyPrev = ENERGY_RUN;
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -92,7 +95,7 @@ void PWR_ExitOffMode(void)
 void PWR_EnterStopMode(void)
 {
   /* USER CODE BEGIN EnterStopMode_1 */
-
+  EnergyPrev = EnergyEnter(ENERGY_STOP);
   /* USER CODE END EnterStopMode_1 */
   HAL_SuspendTick();
   /* Clear Status Flag before entering STOP/STANDBY Mode */
@@ -110,7 +113,7 @@ void PWR_EnterStopMode(void)
 void PWR_ExitStopMode(void)
 {
   /* USER CODE BEGIN ExitStopMode_1 */
-
+  EnergyReturn(EnergyPrev);
   /* USER CODE END ExitStopMode_1 */
   /* Resume sysTick : work around for debugger problem in dual core */
   HAL_ResumeTick();
@@ -130,7 +133,7 @@ void PWR_ExitStopMode(void)
 void PWR_EnterSleepMode(void)
 {
   /* USER CODE BEGIN EnterSleepMode_1 */
-
+  EnergyPrev = EnergyEnter(ENERGY_SLEEP);
   /* USER CODE END EnterSleepMode_1 */
   /* Suspend sysTick */
   HAL_SuspendTick();
@@ -146,7 +149,7 @@ void PWR_EnterSleepMode(void)
 void PWR_ExitSleepMode(void)
 {
   /* USER CODE BEGIN ExitSleepMode_1 */
-
+  EnergyReturn(EnergyPrev);
   /* USER CODE END ExitSleepMode_1 */
   /* Resume sysTick */
   HAL_ResumeTick();
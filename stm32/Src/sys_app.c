@@ -37,7 +37,11 @@
 #include "sys_sensors.h"
 
 /* USER CODE BEGIN Includes */
-
+#include "binlog.h"
+#include "energy.h"
+#include "lowpower.h"
+#include "prof.h"
+#include "wakeup.h"
 /* USER CODE END Includes */
 
 /* External variables ---------------------------------------------------------*/
@@ -59,7 +63,10 @@
 #define LORAWAN_MAX_BAT   254
 
 /* USER CODE BEGIN PD */
-
+/**
+  * Period of the profiling and energy reports in ms
+  */
+#define STATS_REPORT_PERIOD 60000
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -71,7 +78,20 @@
 static uint8_t SYS_TimerInitialisedFlag = 0;
 
 /* USER CODE BEGIN PV */
+/**
+  * Time of the last profiling and energy report in ms
+  */
+static uint32_t StatsReportTime = 0;
+
+/**
+  * Serialized profiling table
+  */
+static uint8_t ProfBlob[PROF_BLOB_SIZE];
 
+/**
+  * Serialized energy accounts
+  */
+static uint8_t EnergyBlob[ENERGY_BLOB_SIZE];
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -88,7 +108,23 @@ static void TimestampNow(uint8_t *buff, uint16_t *size);
 static void tiny_snprintf_like(char *buf, uint32_t maxsize, const char *strFormat, ...);
 
 /* USER CODE BEGIN PFP */
+/**
+  * @brief Returns the timestamp of binary log records in ms
+  */
+static uint32_t BinlogTimestamp(void);
 
+/**
+  * @brief Queues a binary log frame on the terminal
+  * @param data frame
+  * @param len length of the frame
+  * @retval false if the trace fifo is full
+  */
+static bool BinlogSend(const uint8_t *data, size_t len);
+
+/**
+  * @brief Logs the profiling table and energy accounts every STATS_REPORT_PERIOD
+  */
+static void StatsReport(void);
 /* USER CODE END PFP */
 
 /* Exported functions ---------------------------------------------------------*/
@@ -136,7 +172,11 @@ void SystemApp_Init(void)
 #endif /* LOW_POWER_DISABLE */
 
   /* USER CODE BEGIN SystemApp_Init_2 */
-
+  BinlogInit(VERBOSE_LEVEL, BinlogTimestamp);
+  ProfInit();
+  EnergyInit(TIMER_IF_GetTimerValue, 1 << RTC_N_PREDIV_S);
+  LowPowerInit();
+  WakeupInit(UTIL_TIMER_GetCurrentTime, WAKEUP_GRID);
   /* USER CODE END SystemApp_Init_2 */
 }
 
@@ -146,7 +186,8 @@ void SystemApp_Init(void)
 void UTIL_SEQ_Idle(void)
 {
   /* USER CODE BEGIN UTIL_SEQ_Idle_1 */
-
+  StatsReport();
+  BinlogFlush(BinlogSend);
   /* USER CODE END UTIL_SEQ_Idle_1 */
   UTIL_LPM_EnterLowPower();
   /* USER CODE BEGIN UTIL_SEQ_Idle_2 */
@@ -322,7 +363,32 @@ static void tiny_snprintf_like(char *buf, uint32_t maxsize, const char *strForma
 }
 
 /* USER CODE BEGIN PrFD */
+static uint32_t BinlogTimestamp(void)
+{
+  SysTime_t curtime = SysTimeGet();
+  return curtime.Seconds * 1000 + curtime.SubSeconds;
+}
+
+static bool BinlogSend(const uint8_t *data, size_t len)
+{
+  return UTIL_ADV_TRACE_Send(data, len) == UTIL_ADV_TRACE_OK;
+}
 
+static void StatsReport(void)
+{
+  const uint32_t now = BinlogTimestamp();
+  if (now - StatsReportTime < STATS_REPORT_PERIOD)
+  {
+    return;
+  }
+  StatsReportTime = now;
+
+  const size_t prof_len = ProfSerialize(ProfBlob, sizeof(ProfBlob));
+  BINLOG(VLEVEL_ALWAYS, "Profile: %H\r\n", BINLOG_BLOB(ProfBlob, prof_len));
+
+  const size_t energy_len = EnergySerialize(EnergyBlob, sizeof(EnergyBlob));
+  BINLOG(VLEVEL_ALWAYS, "Energy: %H\r\n", BINLOG_BLOB(EnergyBlob, energy_len));
+}
 /* USER CODE END PrFD */
 
 /* HAL overload functions ---------------------------------------------------------*/
@@ -366,11 +432,11 @@ void HAL_Delay(__IO uint32_t Delay)
 {
   /* TIMER_IF can be based on other counter the SysTick e.g. RTC */
   /* USER CODE BEGIN HAL_Delay_1 */
-
+  const int prev = EnergyEnter(ENERGY_WAIT);
   /* USER CODE END HAL_Delay_1 */
   TIMER_IF_DelayMs(Delay);
   /* USER CODE BEGIN HAL_Delay_2 */
-
+  EnergyReturn(prev);
   /* USER CODE END HAL_Delay_2 */
 }
 
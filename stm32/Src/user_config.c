@@ -1,18 +1,26 @@
+#define APP_LOG_MODULE USER_CONFIG
+
 #include "user_config.h"
 
 #include "controller/power.h"
 #include "controller/wifi.h"
 #include "controller/wifi_userconfig.h"
+#include "energy.h"
+#include "lowpower.h"
 #include "stm32_seq.h"
 #include "stm32_timer.h"
 #include "sys_app.h"
 #include "userConfig.h"
 #include "utilities_def.h"
 #include "status_led.h"
+#include "wakeup.h"
 
 static UTIL_TIMER_Object_t UserConfigStopTimer = {};
 static UTIL_TIMER_Object_t UserConfigCheckTimer = {};
 
+/** Period of the check timer in ms */
+static uint32_t UserConfigCheckPeriod = 0;
+
 void UserConfigStopEvent(void* context);
 void UserConfigCheckEvent(void* context);
 
@@ -68,7 +76,7 @@ void UserConfigStart(unsigned int checkInterval) {
       // it's a trap! No valid userconfig
       // Waiting for new configuration on reset
       while (1) {
-        HAL_Delay(1000);
+        LowPowerDelay(1000);
         status = ControllerUserConfigRequest();
         if (status == USERCONFIG_OK) {
           break;
@@ -116,6 +124,8 @@ void UserConfigStopEvent(void* context) {
 }
 
 void UserConfigStop(void) {
+  ENERGY_SCOPE(CFG_SEQ_Task_UserConfigStop);
+
   APP_LOG(TS_ON, VLEVEL_M, "Stopping UserConfig webserver...\t");
 
   uint8_t clients = 0;
@@ -132,6 +142,7 @@ void UserConfigStop(void) {
       APP_LOG(TS_OFF, VLEVEL_M, "Stopped!\n");
 
       UTIL_TIMER_Stop(&UserConfigCheckTimer);
+      WakeupCancel(CFG_SEQ_Task_UserConfigCheck);
       // if uploading via LoRaWAN deep sleep esp32
       const UserConfiguration* cfg = UserConfigGet();
       if (cfg->Upload_method == Uploadmethod_LoRa) {
@@ -145,15 +156,26 @@ void UserConfigStop(void) {
 void UserConfigSetupCheck(unsigned int timeout) {
   UTIL_SEQ_RegTask((1 << CFG_SEQ_Task_UserConfigCheck), UTIL_SEQ_RFU,
                    UserConfigCheck);
-  UTIL_TIMER_Create(&UserConfigCheckTimer, timeout * 1000, UTIL_TIMER_PERIODIC,
-                    UserConfigCheckEvent, NULL);
+  // one shot timer rearmed by the event on a deadline shared with other tasks
+  UserConfigCheckPeriod = timeout * 1000;
+  UTIL_TIMER_Create(&UserConfigCheckTimer,
+                    WakeupDelay(CFG_SEQ_Task_UserConfigCheck,
+                                UserConfigCheckPeriod, WAKEUP_SLACK),
+                    UTIL_TIMER_ONESHOT, UserConfigCheckEvent, NULL);
   UTIL_TIMER_Start(&UserConfigCheckTimer);
 }
 
 void UserConfigCheckEvent(void* context) {
   UTIL_SEQ_SetTask((1 << CFG_SEQ_Task_UserConfigCheck), CFG_SEQ_Prio_0);
+
+  UTIL_TIMER_SetPeriod(&UserConfigCheckTimer,
+                       WakeupPeriod(CFG_SEQ_Task_UserConfigCheck,
+                                    UserConfigCheckPeriod, WAKEUP_SLACK));
+  UTIL_TIMER_Start(&UserConfigCheckTimer);
 }
 
 void UserConfigCheck(void) {
+  ENERGY_SCOPE(CFG_SEQ_Task_UserConfigCheck);
+
   UserConfigStatus status = ControllerUserConfigRequest();
 }
@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE WIFI
+
 #include "wifi.h"
 
 #include <stdbool.h>
@@ -9,13 +11,16 @@
 // #include "ads.h"
 #include "app_lorawan.h"
 // #include "bme280_sensor.h"
+#include "binlog.h"
 #include "board.h"
 #include "controller/controller.h"
 #include "controller/wifi.h"
 #include "dma.h"
+#include "energy.h"
 #include "fifo.h"
 #include "gpio.h"
 #include "i2c.h"
+#include "lowpower.h"
 #include "main.h"
 // #include "phytos31.h"
 #include "rtc.h"
@@ -27,10 +32,12 @@
 // #include "teros12.h"
 // #include "teros21.h"
 #include "payload.h"
+#include "rate_control.h"
 #include "tim.h"
 #include "usart.h"
 #include "userConfig.h"
 #include "user_config.h"
+#include "wakeup.h"
 #include "wifi.h"
 
 /**
@@ -39,6 +46,16 @@
  */
 static UTIL_TIMER_Object_t UploadTimer = {};
 
+/**
+ * @brief Upload period from the user configuration in ms
+ */
+static uint32_t UploadInterval = 0;
+
+/**
+ * @brief Period of the upload timer in ms, scaled by the rate controller
+ */
+static uint32_t UploadPeriod = 0;
+
 /**
  * @brief Maximum number of retries for any event
  */
@@ -56,6 +73,16 @@ const unsigned int retry_delay = 1000;
  */
 void UploadEvent(void* context);
 
+/**
+ * @brief Upload timer callback
+ *
+ * Starts an upload and rearms the timer on a deadline shared with other
+ * tasks.
+ *
+ * @param context Timer context.
+ */
+static void OnUploadTimerEvent(void* context);
+
 /**
  * @brief Upload data to hub
  *
@@ -135,7 +162,7 @@ void WiFiInit(void) {
     // Check for new user config on ESP32 since the check
     // timer is only active during MX_LoRaWAN_Process().
     UserConfigCheck();
-    HAL_Delay(5000);
+    LowPowerDelay(5000);
   }
 
   // start timers for uploading
@@ -147,7 +174,26 @@ void UploadEvent(void* context) {
   UTIL_SEQ_SetTask((1 << CFG_SEQ_Task_WiFiUpload), CFG_SEQ_Prio_1);
 }
 
+static void OnUploadTimerEvent(void* context) {
+  UploadEvent(context);
+
+  UTIL_TIMER_SetPeriod(&UploadTimer, WakeupPeriod(CFG_SEQ_Task_WiFiUpload,
+                                                  UploadPeriod, WAKEUP_SLACK));
+  UTIL_TIMER_Start(&UploadTimer);
+}
+
 void Upload(void) {
+  ENERGY_SCOPE(CFG_SEQ_Task_WiFiUpload);
+
+  // speed up while there is a backlog, the timer picks up the new period when
+  // it is rearmed
+  const bool rate_changed = RateControlUpdate();
+  UploadPeriod = RateControlUploadPeriod(UploadInterval);
+  if (rate_changed) {
+    APP_LOG(TS_ON, VLEVEL_M, "Upload interval set to %lums\r\n",
+            UploadPeriod);
+  }
+
   const size_t buffer_size = 256;
   size_t buffer_len = 0;
   uint8_t buffer[buffer_size];
@@ -161,14 +207,20 @@ void Upload(void) {
   } else if (payload_status == PAYLOAD_NO_DATA) {
     APP_LOG(TS_OFF, VLEVEL_M, "No data to send\r\n");
     return;
+  } else if (payload_status == PAYLOAD_POWER_DELTAS) {
+    // the backend only takes power deltas on the LoRaWAN port, drop the
+    // record so it does not block the measurements behind it
+    APP_LOG(TS_OFF, VLEVEL_M, "Dropping power deltas, not sent on WiFi\r\n");
+    FramCommit();
+    if (FramBufferLen() > 0) {
+      UploadEvent(NULL);
+    }
+    return;
   }
 
   // print buffer
-  APP_LOG(TS_ON, VLEVEL_M, "Payload[%d]: ", buffer_len);
-  for (int i = 0; i < buffer_len; i++) {
-    APP_LOG(TS_OFF, VLEVEL_M, "%02X ", buffer[i]);
-  }
-  APP_LOG(TS_OFF, VLEVEL_M, "\r\n");
+  BINLOG(VLEVEL_M, "Payload[%d]: %H\r\n", buffer_len,
+         BINLOG_BLOB(buffer, buffer_len));
 
   // posts data to website
   APP_LOG(TS_ON, VLEVEL_M, "Uploading data.");
@@ -176,14 +228,21 @@ void Upload(void) {
     APP_LOG(TS_OFF, VLEVEL_M, "Error! Could not communicate with esp32!\r\n");
   }
 
+  PayloadStatus ack_status = PAYLOAD_OK;
   for (unsigned int retries = 0;; retries++) {
-    HAL_Delay(retry_delay);
+    LowPowerDelay(retry_delay);
     APP_LOG(TS_OFF, VLEVEL_M, ".");
 
     ControllerWiFiResponse resp = ControllerWiFiCheckRequest();
     APP_LOG(TS_OFF, VLEVEL_M, "(%d) \r\n", resp.http_code);
 
     if (resp.http_code == 200) {
+      // the body may hold a RepeatedSensorResponses, otherwise the status code
+      // confirms the upload
+      ack_status = PayloadAck(resp.bytes, resp.size);
+      if (ack_status == PAYLOAD_ERROR) {
+        FramCommit();
+      }
       break;
     } else {
       // check category of error
@@ -200,13 +259,19 @@ void Upload(void) {
       // give up after max retries and tirgger error handler
       if (retries >= max_retries) {
         APP_LOG(TS_ON, VLEVEL_M, "Max retries reached! Stopping upload.\r\n");
+        // kept in the buffer for the next upload
+        FramRollback();
         ErrorHandler();
         return;
       }
     }
   }
 
-  if (FramBufferLen() > 0) {
+  if (ack_status == PAYLOAD_REUPLOAD) {
+    // sending again straight away loops for as long as the backend rejects
+    // the upload, wait for the next period of the upload timer instead
+    APP_LOG(TS_ON, VLEVEL_M, "Upload rejected, sending again next period\r\n");
+  } else if (FramBufferLen() > 0) {
     APP_LOG(TS_ON, VLEVEL_M, "Buffer not empty, starting another upload\r\n");
     UploadEvent(NULL);
   }
@@ -222,14 +287,17 @@ void StartUploads(void) {
 
   // get upload period from user config
   const UserConfiguration* cfg = UserConfigGet();
-  UTIL_TIMER_Time_t UploadPeriod = cfg->Upload_interval * 1000;
+  UploadInterval = cfg->Upload_interval * 1000;
+  UploadPeriod = RateControlUploadPeriod(UploadInterval);
 
   // setup upload task
   APP_LOG(TS_ON, VLEVEL_M, "Starting upload task...\t")
   UTIL_SEQ_RegTask((1 << CFG_SEQ_Task_WiFiUpload), UTIL_SEQ_RFU, Upload);
   UploadEvent(NULL);
-  UTIL_TIMER_Create(&UploadTimer, UploadPeriod, UTIL_TIMER_PERIODIC,
-                    UploadEvent, NULL);
+  UTIL_TIMER_Create(&UploadTimer,
+                    WakeupDelay(CFG_SEQ_Task_WiFiUpload, UploadPeriod,
+                                WAKEUP_SLACK),
+                    UTIL_TIMER_ONESHOT, OnUploadTimerEvent, NULL);
   UTIL_TIMER_Start(&UploadTimer);
   APP_LOG(TS_OFF, VLEVEL_M, "Started!\r\n");
 }
@@ -238,12 +306,15 @@ void StopUploads(void) {
   // stop upload timer
   APP_LOG(TS_ON, VLEVEL_M, "Stopping upload task...\t");
   UTIL_TIMER_Stop(&UploadTimer);
+  WakeupCancel(CFG_SEQ_Task_WiFiUpload);
   APP_LOG(TS_OFF, VLEVEL_M, "Stopped!\r\n");
 }
 
 void ResumeUploads(void) {
   // stop upload timer
   APP_LOG(TS_ON, VLEVEL_M, "Starting upload task...\t")
+  UTIL_TIMER_SetPeriod(&UploadTimer, WakeupDelay(CFG_SEQ_Task_WiFiUpload,
+                                                 UploadPeriod, WAKEUP_SLACK));
   UTIL_TIMER_Start(&UploadTimer);
   APP_LOG(TS_OFF, VLEVEL_M, "Started!\r\n");
 }
@@ -276,7 +347,7 @@ bool Connect(void) {
   }
 
   for (unsigned int retries = 0;; retries++) {
-    HAL_Delay(retry_delay);
+    LowPowerDelay(retry_delay);
     APP_LOG(TS_OFF, VLEVEL_M, ".")
 
     ControllerWiFiStatus status = ControllerWiFiCheckWiFi();
@@ -314,7 +385,7 @@ bool Disconnect(void) {
   }
 
   for (unsigned int retries = 0;; retries++) {
-    HAL_Delay(retry_delay);
+    LowPowerDelay(retry_delay);
     APP_LOG(TS_OFF, VLEVEL_M, ".")
 
     ControllerWiFiStatus status = ControllerWiFiCheckWiFi();
@@ -345,7 +416,7 @@ bool TimeSync(void) {
   }
 
   for (unsigned int retries = 0;; retries++) {
-    HAL_Delay(retry_delay);
+    LowPowerDelay(retry_delay);
     APP_LOG(TS_OFF, VLEVEL_M, ".");
 
     ts.Seconds = ControllerWiFiTime();
@@ -411,7 +482,7 @@ bool Check(void) {
       }
     }
 
-    HAL_Delay(retry_delay);
+    LowPowerDelay(retry_delay);
   }
 
   return true;
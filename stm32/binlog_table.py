@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+"""Extracts the format strings of BINLOG into a table
+
+Every BINLOG call stores its format string in a static named binlog_fmt and
+logs the address of it. This script reads those symbols from the ELF and
+writes a JSON object from address to format string, which is what
+`ents binlog` needs to decode the records.
+
+Runs after every PlatformIO build and writes binlog.json next to
+firmware.elf. It can also be run on its own:
+
+    python binlog_table.py .pio/build/stm32/firmware.elf binlog.json
+"""
+
+import json
+import os
+import re
+import struct
+import sys
+
+SYMBOL = re.compile(r"^binlog_fmt(\.\d+)?$")
+
+STT_OBJECT = 1
+SHT_SYMTAB = 2
+
+
+def read_table(path: str) -> dict[str, str]:
+    """Reads the format strings from an ELF
+
+    Args:
+        path: Path to the ELF
+
+    Returns:
+        Format strings keyed by their address as hex
+    """
+
+    with open(path, "rb") as f:
+        elf = f.read()
+
+    if elf[:4] != b"\x7fELF" or elf[5] != 1:
+        raise ValueError(f"{path} is not a little endian ELF")
+    is64 = elf[4] == 2
+
+    if is64:
+        shoff, shentsize, shnum = struct.unpack_from("<40xQ10xHH", elf)
+        sh_fmt = "<IIQQQQIIQQ"
+        sym_fmt, sym_size = "<IBBHQQ", 24
+    else:
+        shoff, shentsize, shnum = struct.unpack_from("<32xI10xHH", elf)
+        sh_fmt = "<IIIIIIIIII"
+        sym_fmt, sym_size = "<IIIBBH", 16
+
+    sections = [
+        struct.unpack_from(sh_fmt, elf, shoff + i * shentsize) for i in range(shnum)
+    ]
+
+    table = {}
+    for section in sections:
+        if section[1] != SHT_SYMTAB:
+            continue
+        _, _, _, _, offset, size, link, _, _, _ = section
+        strtab = sections[link][4]
+
+        for pos in range(offset, offset + size, sym_size):
+            if is64:
+                name, info, _, shndx, value, length = struct.unpack_from(
+                    sym_fmt, elf, pos
+                )
+            else:
+                name, value, length, info, _, shndx = struct.unpack_from(
+                    sym_fmt, elf, pos
+                )
+
+            if info & 0xF != STT_OBJECT or shndx >= len(sections):
+                continue
+            end = elf.index(b"\0", strtab + name)
+            if not SYMBOL.match(elf[strtab + name : end].decode()):
+                continue
+
+            addr, data_offset = sections[shndx][3:5]
+            start = data_offset + value - addr
+            fmt = elf[start : start + length].rstrip(b"\0")
+            table[f"0x{value & 0xFFFFFFFF:08x}"] = fmt.decode(errors="replace")
+
+    return table
+
+
+def write_table(elf: str, path: str):
+    """Writes the format strings of an ELF to a JSON file
+
+    Args:
+        elf: Path to the ELF
+        path: Path of the table
+    """
+
+    table = read_table(elf)
+    with open(path, "w") as f:
+        json.dump(table, f, indent=2, sort_keys=True)
+    print(f"binlog: {len(table)} format strings in {path}")
+
+
+def post_build(target, source, env):
+    """PlatformIO post action on firmware.elf"""
+
+    elf = str(target[0])
+    write_table(elf, os.path.join(os.path.dirname(elf), "binlog.json"))
+
+
+try:
+    Import("env")  # noqa: F821
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", post_build)  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        write_table(sys.argv[1], sys.argv[2])
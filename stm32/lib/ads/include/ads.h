@@ -18,7 +18,9 @@ extern "C" {
 
 #include <stdio.h>
 
+#include "async.h"
 #include "i2c.h"
+#include "oversample.h"
 #include "stm32_systime.h"
 #include "transcoder.h"
 #include "usart.h"
@@ -42,6 +44,52 @@ extern "C" {
  * @{
  */
 
+/** Data rates of the ADS1219 */
+typedef enum {
+  ADC_RATE_20SPS = 0,
+  ADC_RATE_90SPS = 1,
+  ADC_RATE_330SPS = 2,
+  ADC_RATE_1000SPS = 3,
+} AdcDataRate;
+
+/** Channels of the analog frontend */
+typedef enum {
+  ADC_CH_VOLTAGE = 0,
+  ADC_CH_CURRENT = 1,
+  /** Number of channels */
+  ADC_CH_COUNT,
+} AdcChannel;
+
+#ifndef ADC_OVERSAMPLE_RATE
+/** Data rate of the conversions during an oversampling window */
+#define ADC_OVERSAMPLE_RATE ADC_RATE_90SPS
+#endif /* ADC_OVERSAMPLE_RATE */
+
+#ifndef ADC_OVERSAMPLE_WINDOW
+/** Length of an oversampling window in ms */
+#define ADC_OVERSAMPLE_WINDOW 1000
+#endif /* ADC_OVERSAMPLE_WINDOW */
+
+#ifndef ADC_OVERSAMPLE_DECIMATION
+/** Number of conversions averaged into each decimated sample */
+#define ADC_OVERSAMPLE_DECIMATION 4
+#endif /* ADC_OVERSAMPLE_DECIMATION */
+
+/**
+ * @brief Oversampled reading of a channel
+ *
+ * Values are in the units of ADC_readVoltage and ADC_readCurrent.
+ */
+typedef struct {
+  double mean;
+  double min;
+  double max;
+  /** Root mean square */
+  double rms;
+  /** Number of decimated samples, 0 if the window failed */
+  uint32_t count;
+} AdcReading;
+
 /**
  * @brief    This function starts up the ADS1219
  *
@@ -103,6 +151,131 @@ size_t ADC_measureVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
 size_t ADC_measureCurrent(uint8_t *data, SysTime_t ts, uint32_t idx,
                           EnabledSensorMultiple *sensor);
 
+/**
+ * @brief Async driver for the voltage channel
+ *
+ * Starts an oversampling window of ADC_OVERSAMPLE_WINDOW ms in continuous
+ * mode, see ADC_continuousStart. A channel started while the window is open
+ * joins it, so voltage and current measured in the same cycle share a single
+ * window. Polls drain the sample ring into the decimation filters before it
+ * fills up. The reading is encoded with ADC_encodeVoltage and kept for
+ * ADC_lastReading.
+ *
+ * @see async.h
+ */
+extern const AsyncDriver ADC_asyncVoltage;
+
+/**
+ * @brief Async driver for the current channel
+ *
+ * @see ADC_asyncVoltage
+ */
+extern const AsyncDriver ADC_asyncCurrent;
+
+/**
+ * @brief Encodes the mean of the last reading of ADC_asyncVoltage
+ *
+ * Min, max and RMS are logged.
+ *
+ * @see SensorsPrototypeMeasure
+ */
+size_t ADC_encodeVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
+                         EnabledSensorMultiple *sensor);
+
+/**
+ * @brief Encodes the mean of the last reading of ADC_asyncCurrent
+ *
+ * Min, max and RMS are logged.
+ *
+ * @see SensorsPrototypeMeasure
+ */
+size_t ADC_encodeCurrent(uint8_t *data, SysTime_t ts, uint32_t idx,
+                         EnabledSensorMultiple *sensor);
+
+/**
+ * @brief Get the last oversampled reading of a channel
+ *
+ * @param channel Channel
+ *
+ * @return Reading, updated when an async measurement of the channel finishes
+ */
+const AdcReading *ADC_lastReading(AdcChannel channel);
+
+/**
+ * @brief Start continuous conversions alternating between the channels
+ *
+ * There is no data ready line, so a UTIL_TIMER reads a conversion every
+ * period of @p rate. Each tick chains interrupt driven I2C transfers that read
+ * the conversion into a SampleRing, switch the channel and restart the
+ * conversion. The MCU can sleep between ticks, but Stop mode is disabled
+ * since the I2C transfers need the peripheral clocked.
+ *
+ * Other drivers on the bus claim it with I2C1_Claim for their blocking
+ * transfers, which waits for the transfers of a tick in flight. Ticks while
+ * the bus is claimed are skipped and counted by ADC_continuousLost.
+ *
+ * @param rate Data rate of each conversion
+ *
+ * @return HAL_BUSY if already running, otherwise the status of the
+ * configuration
+ */
+HAL_StatusTypeDef ADC_continuousStart(AdcDataRate rate);
+
+/**
+ * @brief Stop continuous conversions and power down the ADC
+ *
+ * Samples left in the ring can still be drained.
+ */
+void ADC_continuousStop(void);
+
+/**
+ * @brief Move the samples in the ring into the decimation filters
+ *
+ * @param os Filter of each channel indexed by AdcChannel
+ *
+ * @return Number of samples drained
+ */
+size_t ADC_continuousDrain(Oversample os[ADC_CH_COUNT]);
+
+/**
+ * @brief Get the number of conversions lost since the start
+ *
+ * Counts samples dropped on a full ring and ticks whose transfers were skipped
+ * or failed.
+ *
+ * @return Number of lost conversions
+ */
+uint32_t ADC_continuousLost(void);
+
+/**
+ * @brief Samples voltage and current at a high rate into the FRAM buffer
+ *
+ * The ADS1219 is put in continuous conversion mode and the voltage and
+ * current channels are read alternately for @p duration_ms. Samples are delta
+ * encoded into a RAM ring which is flushed to the FRAM buffer as
+ * RepeatedPowerDeltas records prefixed with POWER_DELTA_RECORD_MARKER whenever
+ * it fills up and at the end of the burst. Sampling pauses while the ring is
+ * flushed.
+ *
+ * Values are raw ADC codes, calibration is applied when decoding. Blocks for
+ * the duration of the burst.
+ *
+ * Only started from the example_adc_burst example. The records are uplinked on
+ * LORAWAN_SPS_POWER_DELTAS_PORT and dropped by the WiFi upload, nothing in the
+ * python package decodes them yet.
+ *
+ * @see power_delta.h
+ *
+ * @param cell_id Cell Id stored in the records
+ * @param duration_ms Length of the burst in milliseconds
+ * @param rate Data rate of each channel conversion
+ *
+ * @return HAL_ERROR if the FRAM buffer fills up before the end of the burst,
+ * HAL_BUSY while continuous conversions are running
+ */
+HAL_StatusTypeDef ADC_burst(uint32_t cell_id, uint32_t duration_ms,
+                            AdcDataRate rate);
+
 /**
  * @}
  */
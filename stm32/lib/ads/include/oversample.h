@@ -0,0 +1,103 @@
+/**
+ * @file oversample.h
+ * @brief Decimation and statistics of oversampled ADC readings
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_ADS_INCLUDE_OVERSAMPLE_H_
+#define LIB_ADS_INCLUDE_OVERSAMPLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @ingroup ads
+ * @defgroup oversample Oversampling
+ * @brief Averages raw conversions into a reading with mean, min, max and RMS
+ *
+ * Raw conversions are decimated by a boxcar average of @c factor samples,
+ * which lowers the white noise by sqrt(factor). The statistics are kept over
+ * the decimated samples, so min and max reflect the signal rather than single
+ * noisy conversions. Conversions left over when a window ends that do not fill
+ * a decimated sample are discarded.
+ *
+ * Sums are exact integers. A 24-bit code squared fits 2^46, so more than
+ * 2^17 decimated samples fit the 64-bit sum of squares.
+ *
+ * @{
+ */
+
+/** Statistics over decimated samples */
+typedef struct {
+  /** Number of decimated samples */
+  uint32_t count;
+  int32_t min;
+  int32_t max;
+  /** Sum of the samples */
+  int64_t sum;
+  /** Sum of the squared samples */
+  uint64_t sum_sq;
+} OversampleStats;
+
+/** Decimation filter feeding the statistics of one channel */
+typedef struct {
+  /** Number of raw conversions per decimated sample */
+  uint16_t factor;
+  /** Raw conversions in the current decimated sample */
+  uint16_t pending;
+  /** Sum of the pending conversions */
+  int64_t acc;
+  OversampleStats stats;
+} Oversample;
+
+/**
+ * @brief Reset the filter and statistics
+ *
+ * @param os Filter
+ * @param factor Number of raw conversions per decimated sample, 0 is treated
+ * as 1
+ */
+void OversampleInit(Oversample *os, uint16_t factor);
+
+/**
+ * @brief Add a raw conversion
+ *
+ * @param os Filter
+ * @param raw Raw conversion
+ *
+ * @return true if the conversion completed a decimated sample
+ */
+bool OversamplePush(Oversample *os, int32_t raw);
+
+/**
+ * @brief Get the mean of the decimated samples
+ *
+ * @param stats Statistics
+ *
+ * @return Mean, 0 if there are no samples
+ */
+double OversampleMean(const OversampleStats *stats);
+
+/**
+ * @brief Get the root mean square of the decimated samples
+ *
+ * @param stats Statistics
+ *
+ * @return RMS, 0 if there are no samples
+ */
+double OversampleRms(const OversampleStats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_ADS_INCLUDE_OVERSAMPLE_H_
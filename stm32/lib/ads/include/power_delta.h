@@ -0,0 +1,208 @@
+/**
+ * @file power_delta.h
+ * @brief Delta encoding of high rate power samples
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_ADS_INCLUDE_POWER_DELTA_H_
+#define LIB_ADS_INCLUDE_POWER_DELTA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "soil_power_sensor.pb.h"
+
+/**
+ * @ingroup ads
+ * @defgroup powerDelta Power delta encoding
+ * @brief Buffers power samples as deltas and packs them as RepeatedPowerDeltas
+ *
+ * Samples are stored in a RAM ring as the difference to the previous sample.
+ * Each delta is three varints, milliseconds since the previous sample followed
+ * by the zigzag encoded voltage and current differences. Consecutive ADC codes
+ * differ by a few counts so a sample typically takes 3-6 bytes instead of 12.
+ * The oldest sample is kept in absolute form so the ring can be drained from
+ * either end without a reference.
+ *
+ * Samples are drained into RepeatedPowerDeltas messages. The entries are
+ * stored in packed_entries as three varints each, in the same layout as the
+ * ring, since a repeated PowerDeltaEntry spends a tag and length on every
+ * entry and tags on every field:
+ * - First entry: ts is Unix seconds, voltage_delta and current_delta are the
+ *   zigzag encoded raw ADC codes
+ * - Following entries: ts is milliseconds since the previous entry,
+ *   voltage_delta and current_delta are the zigzag encoded differences to the
+ *   previous entry
+ *
+ * Every message is self contained and can be decoded with PowerDeltaUnpack
+ * followed by PowerDeltaExpand.
+ *
+ * @{
+ */
+
+#ifndef POWER_DELTA_RING_SIZE
+/** Bytes of RAM used to buffer deltas */
+#define POWER_DELTA_RING_SIZE 1024
+#endif
+
+#ifndef POWER_DELTA_RECORD_SIZE
+/**
+ * Max size of a RepeatedPowerDeltas record. Defaults to the smallest EU868
+ * payload so records can be uplinked at any data rate.
+ */
+#define POWER_DELTA_RECORD_SIZE 51
+#endif
+
+/**
+ * First byte of FIFO records holding RepeatedPowerDeltas. Field number 0 is
+ * invalid in protobuf so it never starts a serialized SensorMeasurement.
+ */
+#define POWER_DELTA_RECORD_MARKER 0x00
+
+/** Max bytes of a single delta in the ring, three 32-bit varints */
+#define POWER_DELTA_MAX_SAMPLE_SIZE 15
+
+typedef enum {
+  POWER_DELTA_OK = 0,
+  /** Not enough space in the ring or output buffer */
+  POWER_DELTA_FULL,
+  /** No samples in the ring */
+  POWER_DELTA_EMPTY,
+  /** Encoding or decoding error */
+  POWER_DELTA_ERROR,
+} PowerDeltaStatus;
+
+/** Single power sample */
+typedef struct {
+  /** Unix epoch */
+  uint32_t seconds;
+  /** Milliseconds within the second */
+  uint16_t ms;
+  /** Raw voltage ADC code */
+  int32_t voltage;
+  /** Raw current ADC code */
+  int32_t current;
+} PowerSample;
+
+/** Ring of delta encoded samples */
+typedef struct {
+  /** Delta encoded samples, excluding the oldest */
+  uint8_t buf[POWER_DELTA_RING_SIZE];
+  /** Index of the next byte written */
+  uint16_t head;
+  /** Index of the next byte read */
+  uint16_t tail;
+  /** Number of bytes in buf */
+  uint16_t used;
+  /** Number of samples, including the oldest */
+  uint16_t count;
+  /** Oldest sample */
+  PowerSample first;
+  /** Newest sample, reference for the next delta */
+  PowerSample last;
+} PowerDeltaRing;
+
+/**
+ * @brief Zigzag encode a signed value so small magnitudes have short varints
+ */
+uint32_t PowerDeltaZigZag(int32_t value);
+
+/**
+ * @brief Reverse of PowerDeltaZigZag
+ */
+int32_t PowerDeltaUnZigZag(uint32_t value);
+
+/**
+ * @brief Clear the ring
+ *
+ * @param ring Ring to initialize
+ */
+void PowerDeltaRingInit(PowerDeltaRing *ring);
+
+/**
+ * @brief Append a sample to the ring
+ *
+ * Timestamps are expected to be non-decreasing, a sample older than the
+ * previous is stored with a time delta of 0.
+ *
+ * @param ring Ring
+ * @param sample Sample to store
+ *
+ * @return POWER_DELTA_FULL if there is no space for the delta
+ */
+PowerDeltaStatus PowerDeltaRingPush(PowerDeltaRing *ring,
+                                    const PowerSample *sample);
+
+/**
+ * @brief Remove the oldest sample from the ring
+ *
+ * @param ring Ring
+ * @param sample Oldest sample
+ *
+ * @return POWER_DELTA_EMPTY if there are no samples
+ */
+PowerDeltaStatus PowerDeltaRingPop(PowerDeltaRing *ring, PowerSample *sample);
+
+/**
+ * @brief Drain the oldest samples into a RepeatedPowerDeltas message
+ *
+ * As many samples as fit in @p size are removed from the ring. Samples that do
+ * not fit are left for the next call.
+ *
+ * @param ring Ring
+ * @param logger_id Logger Id
+ * @param cell_id Cell Id
+ * @param buffer Buffer to store the serialized message
+ * @param size Size of @p buffer
+ * @param len Number of bytes written to @p buffer
+ *
+ * @return POWER_DELTA_EMPTY if there are no samples, POWER_DELTA_FULL if not
+ * even a single sample fits in @p size
+ */
+PowerDeltaStatus PowerDeltaRecord(PowerDeltaRing *ring, uint32_t logger_id,
+                                  uint32_t cell_id, uint8_t *buffer,
+                                  size_t size, size_t *len);
+
+/**
+ * @brief Split the packed_entries of a RepeatedPowerDeltas record into entries
+ *
+ * @param data Packed entries
+ * @param len Length of @p data
+ * @param entries Decoded entries
+ * @param max_count Capacity of @p entries
+ * @param count Number of entries decoded
+ *
+ * @return POWER_DELTA_FULL if @p entries is too small, POWER_DELTA_ERROR if
+ * @p data ends within an entry
+ */
+PowerDeltaStatus PowerDeltaUnpack(const uint8_t *data, size_t len,
+                                  PowerDeltaEntry *entries, size_t max_count,
+                                  size_t *count);
+
+/**
+ * @brief Reconstruct samples from the entries of a RepeatedPowerDeltas record
+ *
+ * The first sample has a millisecond offset of 0 since the first entry only
+ * stores seconds.
+ *
+ * @param entries Entries in the order they were decoded
+ * @param count Number of entries
+ * @param samples Array of at least @p count samples
+ */
+void PowerDeltaExpand(const PowerDeltaEntry *entries, size_t count,
+                      PowerSample *samples);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_ADS_INCLUDE_POWER_DELTA_H_
@@ -0,0 +1,108 @@
+/**
+ * @file sample_ring.h
+ * @brief Lock-free ring of raw ADC samples
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_ADS_INCLUDE_SAMPLE_RING_H_
+#define LIB_ADS_INCLUDE_SAMPLE_RING_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @ingroup ads
+ * @defgroup sampleRing Sample ring
+ * @brief Single producer single consumer ring of raw ADC samples
+ *
+ * Continuous conversions are pushed from the I2C interrupt and popped by the
+ * measurement callbacks. Only the producer writes head and only the consumer
+ * writes tail, so neither side needs to disable interrupts. The indices are
+ * free running and wrap at 2^32, the capacity must be a power of two.
+ *
+ * A sample pushed to a full ring is dropped and counted, the samples already
+ * in the ring are kept.
+ *
+ * @{
+ */
+
+#ifndef SAMPLE_RING_SIZE
+/** Number of samples in the ring, power of two */
+#define SAMPLE_RING_SIZE 64
+#endif /* SAMPLE_RING_SIZE */
+
+#if (SAMPLE_RING_SIZE & (SAMPLE_RING_SIZE - 1)) != 0
+#error "SAMPLE_RING_SIZE must be a power of two"
+#endif
+
+/** Raw conversion of a single channel */
+typedef struct {
+  /** Sign extended 24-bit ADC code */
+  int32_t raw;
+  /** Channel the conversion was taken on */
+  uint8_t channel;
+} AdcSample;
+
+typedef struct {
+  AdcSample samples[SAMPLE_RING_SIZE];
+  /** Number of samples pushed, written by the producer */
+  uint32_t head;
+  /** Number of samples popped, written by the consumer */
+  uint32_t tail;
+  /** Number of samples dropped on a full ring, written by the producer */
+  uint32_t dropped;
+} SampleRing;
+
+/**
+ * @brief Empty the ring
+ *
+ * Must not run concurrently with the producer or consumer.
+ *
+ * @param ring Ring
+ */
+void SampleRingInit(SampleRing *ring);
+
+/**
+ * @brief Add a sample, called by the producer only
+ *
+ * @param ring Ring
+ * @param sample Sample to copy into the ring
+ *
+ * @return false if the ring is full and the sample was dropped
+ */
+bool SampleRingPush(SampleRing *ring, const AdcSample *sample);
+
+/**
+ * @brief Remove the oldest sample, called by the consumer only
+ *
+ * @param ring Ring
+ * @param sample Oldest sample
+ *
+ * @return false if the ring is empty
+ */
+bool SampleRingPop(SampleRing *ring, AdcSample *sample);
+
+/**
+ * @brief Get the number of samples in the ring
+ *
+ * @param ring Ring
+ *
+ * @return Number of samples
+ */
+size_t SampleRingCount(const SampleRing *ring);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_ADS_INCLUDE_SAMPLE_RING_H_
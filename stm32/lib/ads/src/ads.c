@@ -10,12 +10,28 @@
  * TODO (jmadden173): Add offset calibration at startup
  **/
 
+#define APP_LOG_MODULE ADS
+
 #include "ads.h"
 
 #include <stm32wlxx_hal_gpio.h>
+#include <string.h>
 
+#include "calibration.h"
+#include "fifo.h"
+#include "lowpower.h"
+#include "power_delta.h"
+#include "sample_ring.h"
 #include "sensor.h"
+#include "stm32_lpm.h"
+#include "stm32_timer.h"
+#include "sys_app.h"
 #include "userConfig.h"
+#include "utilities_def.h"
+
+#if POWER_DELTA_RECORD_SIZE + 1 > 255
+#error "Power delta records must fit in a single FIFO entry"
+#endif
 
 /** i2c address */
 static const uint8_t addr = 0x40;
@@ -40,12 +56,6 @@ static const uint8_t cmd_wreg = 0x40;
 int32_t previous_voltage_reading = 0;
 int32_t previous_current_reading = 0;
 
-// default sane calibration
-static double voltage_calibration_m = 0.0;
-static double voltage_calibration_b = 0.0;
-static double current_calibration_m = 0.0;
-static double current_calibration_b = 0.0;
-
 /**
  * Control register breakdown.
  *
@@ -85,6 +95,52 @@ typedef union {
 /** Uart timeout in ms */
 static const unsigned int g_timeout = 5000;
 
+/** Conversion period in ms of each AdcDataRate, rounded up */
+static const uint32_t burst_period_ms[] = {50, 12, 4, 1};
+
+/** Delta encoded samples collected during a burst */
+static PowerDeltaRing burst_ring;
+
+/** Time in ms to wait for a transfer in flight when stopping */
+static const uint32_t continuous_stop_timeout = 10;
+
+/**
+ * State of continuous conversions
+ *
+ * Written from the timer and I2C interrupts while running.
+ */
+static struct {
+  /** Raw samples read by the interrupts */
+  SampleRing ring;
+  /** Periodic timer reading the latest conversion */
+  UTIL_TIMER_Object_t timer;
+  /** Configuration of each channel */
+  ConfigReg reg[ADC_CH_COUNT];
+  /** Channel of the conversion in progress */
+  volatile uint8_t channel;
+  /** Channel being configured by the interrupt chain */
+  volatile uint8_t next;
+  volatile bool running;
+  /** Ticks skipped because a transfer was still in flight, or failed */
+  volatile uint32_t overruns;
+  /** Bytes of the conversion being read */
+  uint8_t rx[3];
+  /** Configuration being written */
+  uint8_t cfg;
+} cont;
+
+/** Decimation filters of the current oversampling window */
+static Oversample window_os[ADC_CH_COUNT];
+
+/** Channels measured by sensors in the current window, bit per AdcChannel */
+static uint8_t window_users = 0;
+
+/** End of the current window in ms */
+static uint32_t window_end = 0;
+
+/** Last oversampled reading of each channel */
+static AdcReading last_reading[ADC_CH_COUNT];
+
 /**
  * @brief Turn on power to analog circuit
  *
@@ -105,7 +161,7 @@ void PowerOn(void);
  *
  * @see data_ready_pin
  */
-void PowerDown(void);
+void PowerOff(void);
 
 /**
  * @brief Measure from the adc
@@ -116,6 +172,24 @@ void PowerDown(void);
  */
 HAL_StatusTypeDef Measure(int32_t *meas);
 
+/**
+ * @brief Combine the 3 bytes of a conversion into a sign extended value
+ *
+ * @param rx_data Bytes in the order they are read, MSB first
+ *
+ * @return Raw measurement
+ */
+static int32_t RawFromBytes(const uint8_t rx_data[3]);
+
+/**
+ * @brief Read the result of the latest conversion
+ *
+ * @param meas Raw measurement
+ *
+ * @return HAL status of the i2c transfers
+ */
+HAL_StatusTypeDef ReadData(int32_t *meas);
+
 /**
  * @brief This function reconfigures the ADS1219 based on the parameter reg_data
  *
@@ -124,14 +198,131 @@ HAL_StatusTypeDef Measure(int32_t *meas);
  */
 HAL_StatusTypeDef Configure(const ConfigReg reg_data);
 
+/**
+ * @brief Configuration selecting the voltage channel in single shot mode
+ */
+static ConfigReg VoltageReg(void) {
+  ConfigReg reg_data = {0};
+  reg_data.bits.vref = 1;
+  return reg_data;
+}
+
+/**
+ * @brief Configuration selecting the current channel in single shot mode
+ */
+static ConfigReg CurrentReg(void) {
+  ConfigReg reg_data = {0};
+  reg_data.bits.mux = 0b001;
+  reg_data.bits.vref = 1;
+  return reg_data;
+}
+
+/**
+ * @brief Calibration converting raw codes of a channel
+ *
+ * @param channel Channel
+ */
+static const Calibration *ChannelCalibration(AdcChannel channel) {
+  return CalibrationGet((channel == ADC_CH_VOLTAGE) ? SensorType_POWER_VOLTAGE
+                                                    : SensorType_POWER_CURRENT);
+}
+
+/**
+ * @brief Convert a raw code of a channel
+ */
+static q32_t Convert(AdcChannel channel, int32_t raw) {
+  return CalibrationApply(ChannelCalibration(channel), Q32FromInt(raw));
+}
+
+/**
+ * @brief Square root of a sum of three terms that may not fit in Q32.32
+ *
+ * The terms are halved until they fit in 14 integer bits so their squares can
+ * not overflow, and the root is scaled back.
+ *
+ * @param a Squared term
+ * @param b Factor of the cross term
+ * @param c Factor of the cross term
+ * @param d Squared term
+ *
+ * @return sqrt(a^2 + 2 b c + d^2), 0 if negative from rounding
+ */
+static q32_t RootOfSum(q32_t a, q32_t b, q32_t c, q32_t d) {
+  const q32_t limit = Q32FromInt(1 << 14);
+  int shift = 0;
+  while ((a > limit || a < -limit || b > limit || b < -limit ||
+          c > limit || c < -limit || d > limit || d < -limit) &&
+         shift < 31) {
+    a /= 2;
+    b /= 2;
+    c /= 2;
+    d /= 2;
+    ++shift;
+  }
+
+  const q32_t sum = Q32Mul(a, a) + 2 * Q32Mul(b, c) + Q32Mul(d, d);
+  const q32_t root = Q32Sqrt(sum);
+  if (root > (Q32_MAX >> shift)) {
+    return Q32_MAX;
+  }
+  return root << shift;
+}
+
+/**
+ * @brief Convert the statistics of a channel into a reading
+ *
+ * The conversion is linear, so the mean, min and max convert directly. The RMS
+ * is recomputed from the mean square since the offset does not scale.
+ *
+ * @param channel Channel
+ * @param stats Statistics of raw codes
+ * @param reading Converted reading
+ */
+static void ConvertReading(AdcChannel channel, const OversampleStats *stats,
+                           AdcReading *reading) {
+  memset(reading, 0, sizeof(*reading));
+  reading->count = stats->count;
+  if (stats->count == 0) {
+    return;
+  }
+
+  const Calibration *cal = ChannelCalibration(channel);
+
+  const q32_t mean = Q32FromRatio(stats->sum, stats->count);
+  const q32_t rms = Q32SqrtRatio(stats->sum_sq, stats->count);
+
+  reading->mean = Q32ToDouble(CalibrationApply(cal, mean));
+  // a negative slope swaps min and max
+  const q32_t lo = Convert(channel, stats->min);
+  const q32_t hi = Convert(channel, stats->max);
+  reading->min = Q32ToDouble((lo < hi) ? lo : hi);
+  reading->max = Q32ToDouble((lo < hi) ? hi : lo);
+  // E[(mx + b)^2] = m^2 E[x^2] + 2mb E[x] + b^2
+  reading->rms = Q32ToDouble(
+      RootOfSum(Q32Mul(cal->m, rms), Q32Mul(cal->m, mean), cal->b, cal->b));
+}
+
+/**
+ * @brief Encode a power measurement
+ *
+ * @see SensorsPrototypeMeasure
+ */
+static size_t EncodePower(uint8_t *data, SysTime_t ts,
+                          EnabledSensorMultiple *sensor, double value,
+                          SensorType type);
+
 HAL_StatusTypeDef ADC_init(void) {
+#ifndef DISABLE_CALIBRATION
   const UserConfiguration *cfg = UserConfigGet();
 
-  // read calibration values
-  voltage_calibration_m = cfg->Voltage_Slope;
-  voltage_calibration_b = cfg->Voltage_Offset;
-  current_calibration_m = cfg->Current_Slope;
-  current_calibration_b = cfg->Current_Offset;
+  // read calibration values, voltage is reported in V
+  const Calibration voltage_cal = {Q32FromFloat(cfg->Voltage_Slope) / 1000,
+                                   Q32FromFloat(cfg->Voltage_Offset) / 1000};
+  const Calibration current_cal = {Q32FromFloat(cfg->Current_Slope),
+                                   Q32FromFloat(cfg->Current_Offset)};
+  CalibrationSet(SensorType_POWER_VOLTAGE, &voltage_cal);
+  CalibrationSet(SensorType_POWER_CURRENT, &current_cal);
+#endif
 
   HAL_StatusTypeDef ret = HAL_OK;
 
@@ -158,13 +349,9 @@ HAL_StatusTypeDef Configure(const ConfigReg reg_data) {
 double ADC_readVoltage(void) {
   HAL_StatusTypeDef ret = HAL_OK;
   int32_t raw = 0;
-  double meas = 0.0;
-
-  ConfigReg reg_data = {0};
-  reg_data.bits.vref = 1;
 
   // 0x01 is single shot 0x03 is continuous
-  ret = Configure(reg_data);
+  ret = Configure(VoltageReg());
   if (ret != HAL_OK) {
     return -1;  // Return -1 on error
   }
@@ -174,28 +361,15 @@ double ADC_readVoltage(void) {
     return -1;  // Return -1 on error
   }
 
-#ifdef DISABLE_CALIBRATION
-  meas = (double)raw;
-#else
-  meas = (voltage_calibration_m * raw) + voltage_calibration_b;
-#endif
-
-  meas /= 1000;
-
-  return meas;
+  return Q32ToDouble(Convert(ADC_CH_VOLTAGE, raw));
 }
 
 double ADC_readCurrent(void) {
   HAL_StatusTypeDef ret = HAL_OK;
   int32_t raw = 0;
-  double meas = 0.0;
-
-  ConfigReg reg_data = {0};
-  reg_data.bits.mux = 0b001;
-  reg_data.bits.vref = 1;
 
   // 0x21 is single shot and 0x23 is continuos
-  ret = Configure(reg_data);  // configure to read current
+  ret = Configure(CurrentReg());  // configure to read current
   if (ret != HAL_OK) {
     return -1;  // Return -1 on error
   }
@@ -205,13 +379,7 @@ double ADC_readCurrent(void) {
     return -1;  // Return -1 on error
   }
 
-#ifdef DISABLE_CALIBRATION
-  meas = (double)raw;
-#else
-  meas = (current_calibration_m * raw) + current_calibration_b;
-#endif
-
-  return meas;
+  return Q32ToDouble(Convert(ADC_CH_CURRENT, raw));
 }
 
 HAL_StatusTypeDef probeADS12(void) {
@@ -220,10 +388,9 @@ HAL_StatusTypeDef probeADS12(void) {
   return ret;
 }
 
-size_t ADC_measureVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
-                          EnabledSensorMultiple *sensor) {
-  double voltage = ADC_readVoltage();
-
+static size_t EncodePower(uint8_t *data, SysTime_t ts,
+                          EnabledSensorMultiple *sensor, double value,
+                          SensorType type) {
   const UserConfiguration *cfg = UserConfigGet();
 
   Metadata meta = Metadata_init_zero;
@@ -234,8 +401,7 @@ size_t ADC_measureVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
   size_t data_len = 0;
 
   SensorStatus status = SENSOR_OK;
-  status = EncodeDoubleMeasurement(meta, voltage, SensorType_POWER_VOLTAGE,
-                                   data, &data_len);
+  status = EncodeDoubleMeasurement(meta, value, type, data, &data_len);
   if (status != SENSOR_OK) {
     return -1;
   }
@@ -243,27 +409,169 @@ size_t ADC_measureVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
   return data_len;
 }
 
+size_t ADC_measureVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
+                          EnabledSensorMultiple *sensor) {
+  double voltage = ADC_readVoltage();
+  return EncodePower(data, ts, sensor, voltage, SensorType_POWER_VOLTAGE);
+}
+
 size_t ADC_measureCurrent(uint8_t *data, SysTime_t ts, uint32_t idx,
                           EnabledSensorMultiple *sensor) {
-  double voltage = ADC_readCurrent();
+  double current = ADC_readCurrent();
+  return EncodePower(data, ts, sensor, current, SensorType_POWER_CURRENT);
+}
 
-  const UserConfiguration *cfg = UserConfigGet();
+/**
+ * @brief Time to wait before draining the ring or ending the window
+ *
+ * The ring is drained before it can fill up.
+ */
+static uint32_t WindowWait(void) {
+  const uint32_t drain_ms =
+      (SAMPLE_RING_SIZE / 2) * (burst_period_ms[ADC_OVERSAMPLE_RATE] + 1);
+  const int32_t remaining = (int32_t)(window_end - HAL_GetTick());
 
-  Metadata meta = Metadata_init_zero;
-  meta.ts = ts.Seconds;
-  meta.logger_id = cfg->logger_id;
-  meta.cell_id = sensor->cell_id;
+  if (remaining <= 0) {
+    return 0;
+  }
+  return ((uint32_t)remaining < drain_ms) ? (uint32_t)remaining : drain_ms;
+}
 
-  size_t data_len = 0;
+/**
+ * @brief Join the oversampling window, starting it if needed
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus WindowStart(AdcChannel channel, uint32_t *wait_ms) {
+  const uint8_t bit = 1 << channel;
 
-  SensorStatus status = SENSOR_OK;
-  status = EncodeDoubleMeasurement(meta, voltage, SensorType_POWER_CURRENT,
-                                   data, &data_len);
-  if (status != SENSOR_OK) {
-    return -1;
+  if (window_users & bit) {
+    return ASYNC_BUSY;
   }
 
-  return data_len;
+  if (window_users == 0) {
+    // continuous mode used outside of a window
+    if (cont.running) {
+      return ASYNC_BUSY;
+    }
+
+    for (int ch = 0; ch < ADC_CH_COUNT; ch++) {
+      OversampleInit(&window_os[ch], ADC_OVERSAMPLE_DECIMATION);
+    }
+
+    if (ADC_continuousStart(ADC_OVERSAMPLE_RATE) != HAL_OK) {
+      return ASYNC_ERROR;
+    }
+
+    window_end = HAL_GetTick() + ADC_OVERSAMPLE_WINDOW;
+  } else if (!cont.running) {
+    // window ended, the other channel has not collected its reading yet
+    return ASYNC_BUSY;
+  }
+
+  window_users |= bit;
+  *wait_ms = WindowWait();
+
+  return ASYNC_WAIT;
+}
+
+static AsyncStatus WindowStartVoltage(void *ctx, uint32_t *wait_ms) {
+  return WindowStart(ADC_CH_VOLTAGE, wait_ms);
+}
+
+static AsyncStatus WindowStartCurrent(void *ctx, uint32_t *wait_ms) {
+  return WindowStart(ADC_CH_CURRENT, wait_ms);
+}
+
+/**
+ * @brief Drain the ring and collect the reading once the window ends
+ *
+ * The first channel polled after the end stops the conversions, both channels
+ * then read the same filters.
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus WindowPoll(AdcChannel channel, uint32_t *wait_ms) {
+  if (cont.running) {
+    ADC_continuousDrain(window_os);
+
+    *wait_ms = WindowWait();
+    if (*wait_ms > 0) {
+      return ASYNC_WAIT;
+    }
+
+    ADC_continuousStop();
+    // conversions read between the drain and the stop
+    ADC_continuousDrain(window_os);
+
+    const uint32_t lost = ADC_continuousLost();
+    if (lost > 0) {
+      APP_LOG(TS_ON, VLEVEL_M, "ADC: %u samples lost\r\n", (unsigned)lost);
+    }
+  }
+
+  window_users &= ~(1 << channel);
+  ConvertReading(channel, &window_os[channel].stats, &last_reading[channel]);
+
+  return (last_reading[channel].count > 0) ? ASYNC_DONE : ASYNC_ERROR;
+}
+
+static AsyncStatus WindowPollVoltage(void *ctx, uint32_t *wait_ms) {
+  return WindowPoll(ADC_CH_VOLTAGE, wait_ms);
+}
+
+static AsyncStatus WindowPollCurrent(void *ctx, uint32_t *wait_ms) {
+  return WindowPoll(ADC_CH_CURRENT, wait_ms);
+}
+
+/**
+ * @brief Leave the window, stopping it when no channel is left
+ */
+static void WindowCancel(AdcChannel channel) {
+  window_users &= ~(1 << channel);
+  if (window_users == 0) {
+    ADC_continuousStop();
+  }
+}
+
+static void WindowCancelVoltage(void *ctx) { WindowCancel(ADC_CH_VOLTAGE); }
+
+static void WindowCancelCurrent(void *ctx) { WindowCancel(ADC_CH_CURRENT); }
+
+const AsyncDriver ADC_asyncVoltage = {WindowStartVoltage, WindowPollVoltage,
+                                      WindowCancelVoltage};
+
+const AsyncDriver ADC_asyncCurrent = {WindowStartCurrent, WindowPollCurrent,
+                                      WindowCancelCurrent};
+
+const AdcReading *ADC_lastReading(AdcChannel channel) {
+  return &last_reading[channel];
+}
+
+/**
+ * @brief Log the statistics of a reading
+ */
+static void LogReading(const char *name, const AdcReading *reading) {
+  APP_LOG(TS_ON, VLEVEL_H,
+          "%s: mean %f min %f max %f rms %f (%u samples)\r\n", name,
+          reading->mean, reading->min, reading->max, reading->rms,
+          (unsigned)reading->count);
+}
+
+size_t ADC_encodeVoltage(uint8_t *data, SysTime_t ts, uint32_t idx,
+                         EnabledSensorMultiple *sensor) {
+  const AdcReading *reading = &last_reading[ADC_CH_VOLTAGE];
+  LogReading("voltage", reading);
+  return EncodePower(data, ts, sensor, reading->mean,
+                     SensorType_POWER_VOLTAGE);
+}
+
+size_t ADC_encodeCurrent(uint8_t *data, SysTime_t ts, uint32_t idx,
+                         EnabledSensorMultiple *sensor) {
+  const AdcReading *reading = &last_reading[ADC_CH_CURRENT];
+  LogReading("current", reading);
+  return EncodePower(data, ts, sensor, reading->mean,
+                     SensorType_POWER_CURRENT);
 }
 
 // TODO: Power on/off for the ADS1219 is moved to toggling the power to the I2C
@@ -284,7 +592,6 @@ void PowerOff(void) {
 
 HAL_StatusTypeDef Measure(int32_t *meas) {
   HAL_StatusTypeDef ret = HAL_OK;
-  uint8_t rx_data[3] = {0x00, 0x00, 0x00};
 
   PowerOn();
 
@@ -292,7 +599,7 @@ HAL_StatusTypeDef Measure(int32_t *meas) {
   HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_start, 1, g_timeout);
 
   // wait for conversion
-  HAL_Delay(60);
+  LowPowerDelay(60);
 
   // TODO: Since the ADS1219 is now on its own I2C-only module/board, there is
   // not data ready pin.
@@ -300,30 +607,306 @@ HAL_StatusTypeDef Measure(int32_t *meas) {
   // Wait for the DRDY pin on the ADS12 to go low, this means data is ready
   // while (HAL_GPIO_ReadPin(data_ready_port, data_ready_pin)) {
   // }
-  HAL_Delay(60);
+  LowPowerDelay(60);
+
+  ret = ReadData(meas);
+  if (ret != HAL_OK) {
+    return -1;
+  }
+
+  PowerOff();
+
+  return ret;
+}
+
+HAL_StatusTypeDef ReadData(int32_t *meas) {
+  HAL_StatusTypeDef ret = HAL_OK;
+  uint8_t rx_data[3] = {0x00, 0x00, 0x00};
 
   // send read data command
   ret = HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_rdata, 1, g_timeout);
   if (ret != HAL_OK) {
-    return -1;
+    return ret;
   }
 
   // read 3 bytes of data
   ret = HAL_I2C_Master_Receive(&hi2c1, addrls, rx_data, 3, g_timeout);
   if (ret != HAL_OK) {
-    return -1;
+    return ret;
   }
 
-  PowerOff();
+  *meas = RawFromBytes(rx_data);
 
+  return ret;
+}
+
+static int32_t RawFromBytes(const uint8_t rx_data[3]) {
   // Combine the 3 bytes into a 24-bit value
-  *meas = ((int32_t)rx_data[0] << 16) | ((int32_t)rx_data[1] << 8) |
-          ((int32_t)rx_data[2]);
+  int32_t meas = ((int32_t)rx_data[0] << 16) | ((int32_t)rx_data[1] << 8) |
+                 ((int32_t)rx_data[2]);
   // Check if the sign bit (24th bit) is set
-  if (*meas & 0x800000) {
+  if (meas & 0x800000) {
     // Extend the sign to 32 bits
-    *meas |= 0xFF000000;
+    meas |= 0xFF000000;
+  }
+
+  return meas;
+}
+
+/**
+ * @brief Switch channels and read the next conversion in continuous mode
+ *
+ * @param reg Configuration selecting the channel
+ * @param period Conversion period in ms
+ * @param meas Raw measurement
+ */
+static HAL_StatusTypeDef BurstRead(const ConfigReg reg, uint32_t period,
+                                   int32_t *meas) {
+  HAL_StatusTypeDef ret = Configure(reg);
+  if (ret != HAL_OK) {
+    return ret;
+  }
+
+  // restart so the conversion is entirely on the new channel
+  ret = HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_start, 1, g_timeout);
+  if (ret != HAL_OK) {
+    return ret;
+  }
+
+  // no data ready line, wait out a full conversion
+  LowPowerDelay(period);
+
+  return ReadData(meas);
+}
+
+/**
+ * @brief Drain the burst ring into the FRAM buffer
+ */
+static HAL_StatusTypeDef BurstFlush(uint32_t logger_id, uint32_t cell_id) {
+  uint8_t record[POWER_DELTA_RECORD_SIZE + 1];
+  record[0] = POWER_DELTA_RECORD_MARKER;
+
+  while (burst_ring.count > 0) {
+    size_t len = 0;
+    if (PowerDeltaRecord(&burst_ring, logger_id, cell_id, record + 1,
+                         POWER_DELTA_RECORD_SIZE, &len) != POWER_DELTA_OK) {
+      return HAL_ERROR;
+    }
+
+    if (FramPut(record, len + 1) != FRAM_OK) {
+      return HAL_ERROR;
+    }
+  }
+
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef ADC_burst(uint32_t cell_id, uint32_t duration_ms,
+                            AdcDataRate rate) {
+  const UserConfiguration *cfg = UserConfigGet();
+
+  if (cont.running) {
+    return HAL_BUSY;
+  }
+
+  ConfigReg voltage_reg = {0};
+  voltage_reg.bits.vref = 1;
+  voltage_reg.bits.mode = 1;
+  voltage_reg.bits.dr = rate;
+
+  ConfigReg current_reg = voltage_reg;
+  current_reg.bits.mux = 0b001;
+
+  const uint32_t period = burst_period_ms[rate];
+
+  PowerDeltaRingInit(&burst_ring);
+
+  PowerOn();
+
+  HAL_StatusTypeDef ret = HAL_OK;
+  const uint32_t start = HAL_GetTick();
+  while (HAL_GetTick() - start < duration_ms) {
+    const SysTime_t ts = SysTimeGet();
+
+    PowerSample sample = {0};
+    sample.seconds = ts.Seconds;
+    sample.ms = (uint16_t)ts.SubSeconds;
+
+    ret = BurstRead(voltage_reg, period, &sample.voltage);
+    if (ret != HAL_OK) {
+      break;
+    }
+
+    ret = BurstRead(current_reg, period, &sample.current);
+    if (ret != HAL_OK) {
+      break;
+    }
+
+    if (PowerDeltaRingPush(&burst_ring, &sample) == POWER_DELTA_FULL) {
+      ret = BurstFlush(cfg->logger_id, cell_id);
+      if (ret != HAL_OK) {
+        break;
+      }
+      PowerDeltaRingPush(&burst_ring, &sample);
+    }
+  }
+
+  // stop continuous conversions, the next single shot wakes the adc
+  HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_powerdown, 1, g_timeout);
+
+  PowerOff();
+
+  // keep samples taken before an error
+  if (BurstFlush(cfg->logger_id, cell_id) != HAL_OK) {
+    ret = HAL_ERROR;
   }
 
   return ret;
 }
+
+/**
+ * @brief Read the conversion of the current channel
+ *
+ * Runs from the timer interrupt. The read completes in
+ * HAL_I2C_MemRxCpltCallback which continues the chain.
+ */
+static void ContinuousTick(void *context) {
+  if (!cont.running) {
+    return;
+  }
+
+  // a blocking transfer holds the bus, the conversion is lost
+  if (I2C1_Claimed()) {
+    ++cont.overruns;
+    return;
+  }
+
+  // previous chain still in flight, its conversion is read next tick
+  if (HAL_I2C_GetState(&hi2c1) != HAL_I2C_STATE_READY) {
+    ++cont.overruns;
+    return;
+  }
+
+  if (HAL_I2C_Mem_Read_IT(&hi2c1, addrls, cmd_rdata, I2C_MEMADD_SIZE_8BIT,
+                          cont.rx, sizeof(cont.rx)) != HAL_OK) {
+    ++cont.overruns;
+  }
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c != &hi2c1 || !cont.running) {
+    return;
+  }
+
+  const AdcSample sample = {RawFromBytes(cont.rx), cont.channel};
+  SampleRingPush(&cont.ring, &sample);
+
+  // switch to the other channel
+  cont.next = (cont.channel + 1) % ADC_CH_COUNT;
+  cont.cfg = cont.reg[cont.next].value;
+  if (HAL_I2C_Mem_Write_IT(&hi2c1, addrls, cmd_wreg, I2C_MEMADD_SIZE_8BIT,
+                           &cont.cfg, 1) != HAL_OK) {
+    ++cont.overruns;
+  }
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c != &hi2c1 || !cont.running) {
+    return;
+  }
+
+  // restart so the conversion is entirely on the new channel
+  cont.channel = cont.next;
+  if (HAL_I2C_Master_Transmit_IT(&hi2c1, addrls, &cmd_start, 1) != HAL_OK) {
+    ++cont.overruns;
+  }
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+  if (hi2c != &hi2c1 || !cont.running) {
+    return;
+  }
+
+  // the chain restarts on the next tick
+  ++cont.overruns;
+}
+
+HAL_StatusTypeDef ADC_continuousStart(AdcDataRate rate) {
+  if (cont.running) {
+    return HAL_BUSY;
+  }
+
+  ConfigReg reg = {0};
+  reg.bits.vref = 1;
+  reg.bits.mode = 1;
+  reg.bits.dr = rate;
+  cont.reg[ADC_CH_VOLTAGE] = reg;
+  reg.bits.mux = 0b001;
+  cont.reg[ADC_CH_CURRENT] = reg;
+
+  SampleRingInit(&cont.ring);
+  cont.overruns = 0;
+  cont.channel = ADC_CH_VOLTAGE;
+  cont.next = ADC_CH_VOLTAGE;
+
+  PowerOn();
+
+  HAL_StatusTypeDef ret = Configure(cont.reg[ADC_CH_VOLTAGE]);
+  if (ret == HAL_OK) {
+    ret = HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_start, 1, g_timeout);
+  }
+  if (ret != HAL_OK) {
+    PowerOff();
+    return ret;
+  }
+
+  // the interrupt chain needs the I2C peripheral clocked between ticks
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_ADC_Id), UTIL_LPM_DISABLE);
+
+  cont.running = true;
+
+  // one conversion per tick, with margin for the chain switching channels
+  UTIL_TIMER_Create(&cont.timer, burst_period_ms[rate] + 1,
+                    UTIL_TIMER_PERIODIC, ContinuousTick, NULL);
+  UTIL_TIMER_Start(&cont.timer);
+
+  return HAL_OK;
+}
+
+void ADC_continuousStop(void) {
+  if (!cont.running) {
+    return;
+  }
+
+  cont.running = false;
+  UTIL_TIMER_Stop(&cont.timer);
+
+  // let a transfer in flight finish, the callbacks no longer chain
+  const uint32_t start = HAL_GetTick();
+  while (HAL_I2C_GetState(&hi2c1) != HAL_I2C_STATE_READY &&
+         HAL_GetTick() - start < continuous_stop_timeout) {
+  }
+
+  // stop continuous conversions, the next single shot wakes the adc
+  HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_powerdown, 1, g_timeout);
+
+  PowerOff();
+
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_ADC_Id), UTIL_LPM_ENABLE);
+}
+
+size_t ADC_continuousDrain(Oversample os[ADC_CH_COUNT]) {
+  size_t count = 0;
+  AdcSample sample = {0};
+
+  while (SampleRingPop(&cont.ring, &sample)) {
+    OversamplePush(&os[sample.channel], sample.raw);
+    ++count;
+  }
+
+  return count;
+}
+
+uint32_t ADC_continuousLost(void) {
+  return cont.ring.dropped + cont.overruns;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file oversample.c
+ *
+ * @see oversample.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "oversample.h"
+
+#include <math.h>
+
+void OversampleInit(Oversample *os, uint16_t factor) {
+  os->factor = (factor == 0) ? 1 : factor;
+  os->pending = 0;
+  os->acc = 0;
+
+  os->stats.count = 0;
+  os->stats.min = INT32_MAX;
+  os->stats.max = INT32_MIN;
+  os->stats.sum = 0;
+  os->stats.sum_sq = 0;
+}
+
+bool OversamplePush(Oversample *os, int32_t raw) {
+  os->acc += raw;
+  if (++os->pending < os->factor) {
+    return false;
+  }
+
+  // average rounded to the nearest code
+  const int64_t half = os->factor / 2;
+  const int32_t sample = (int32_t)((os->acc >= 0 ? os->acc + half
+                                                 : os->acc - half) /
+                                   os->factor);
+  os->pending = 0;
+  os->acc = 0;
+
+  OversampleStats *stats = &os->stats;
+  ++stats->count;
+  if (sample < stats->min) {
+    stats->min = sample;
+  }
+  if (sample > stats->max) {
+    stats->max = sample;
+  }
+  stats->sum += sample;
+  stats->sum_sq += (uint64_t)((int64_t)sample * sample);
+
+  return true;
+}
+
+double OversampleMean(const OversampleStats *stats) {
+  if (stats->count == 0) {
+    return 0;
+  }
+  return (double)stats->sum / stats->count;
+}
+
+double OversampleRms(const OversampleStats *stats) {
+  if (stats->count == 0) {
+    return 0;
+  }
+  return sqrt((double)stats->sum_sq / stats->count);
+}
@@ -0,0 +1,338 @@
+/**
+ * @file power_delta.c
+ *
+ * @see power_delta.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "power_delta.h"
+
+#include <string.h>
+
+#include "pb_encode.h"
+
+/** Capacity of RepeatedPowerDeltas.packed_entries so records can be decoded */
+#define PACKED_ENTRIES_MAX_SIZE \
+  sizeof(((RepeatedPowerDeltas *)0)->packed_entries.bytes)
+
+/**
+ * @brief Milliseconds between two samples, clamped to 0 if time went backwards
+ */
+static uint32_t ElapsedMs(const PowerSample *from, const PowerSample *to) {
+  const int64_t ms = ((int64_t)to->seconds - from->seconds) * 1000 +
+                     ((int64_t)to->ms - from->ms);
+  if (ms < 0) {
+    return 0;
+  }
+  if (ms > UINT32_MAX) {
+    return UINT32_MAX;
+  }
+  return (uint32_t)ms;
+}
+
+/**
+ * @brief Advance a sample by a number of milliseconds
+ */
+static void AddMs(PowerSample *sample, uint32_t ms) {
+  const uint32_t total = sample->ms + ms;
+  sample->seconds += total / 1000;
+  sample->ms = total % 1000;
+}
+
+/**
+ * @brief Difference of two codes, wrapping instead of overflowing
+ */
+static int32_t Diff(int32_t a, int32_t b) {
+  return (int32_t)((uint32_t)a - (uint32_t)b);
+}
+
+/**
+ * @brief Sum of two codes, wrapping instead of overflowing
+ */
+static int32_t Sum(int32_t a, int32_t b) {
+  return (int32_t)((uint32_t)a + (uint32_t)b);
+}
+
+static size_t WriteVarint(uint8_t *buf, uint32_t value) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    buf[n++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buf[n++] = (uint8_t)value;
+  return n;
+}
+
+/**
+ * @brief Read a varint from the ring, advancing the tail
+ */
+static PowerDeltaStatus RingReadVarint(PowerDeltaRing *ring, uint32_t *value) {
+  *value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (ring->used == 0) {
+      return POWER_DELTA_ERROR;
+    }
+    const uint8_t b = ring->buf[ring->tail];
+    ring->tail = (ring->tail + 1) % POWER_DELTA_RING_SIZE;
+    --ring->used;
+
+    *value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      return POWER_DELTA_OK;
+    }
+  }
+  return POWER_DELTA_ERROR;
+}
+
+/**
+ * @brief Read a varint from a buffer, advancing @p pos
+ */
+static PowerDeltaStatus ReadVarint(const uint8_t *data, size_t len,
+                                   size_t *pos, uint32_t *value) {
+  *value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (*pos >= len) {
+      return POWER_DELTA_ERROR;
+    }
+    const uint8_t b = data[(*pos)++];
+
+    *value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) {
+      return POWER_DELTA_OK;
+    }
+  }
+  return POWER_DELTA_ERROR;
+}
+
+static size_t VarintSize(uint32_t value) {
+  size_t n = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++n;
+  }
+  return n;
+}
+
+uint32_t PowerDeltaZigZag(int32_t value) {
+  return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int32_t PowerDeltaUnZigZag(uint32_t value) {
+  return (int32_t)((value >> 1) ^ (~(value & 1) + 1));
+}
+
+void PowerDeltaRingInit(PowerDeltaRing *ring) {
+  ring->head = 0;
+  ring->tail = 0;
+  ring->used = 0;
+  ring->count = 0;
+}
+
+PowerDeltaStatus PowerDeltaRingPush(PowerDeltaRing *ring,
+                                    const PowerSample *sample) {
+  if (ring->count == UINT16_MAX) {
+    return POWER_DELTA_FULL;
+  }
+
+  if (ring->count == 0) {
+    ring->first = *sample;
+    ring->last = *sample;
+    ring->count = 1;
+    return POWER_DELTA_OK;
+  }
+
+  uint8_t delta[POWER_DELTA_MAX_SAMPLE_SIZE];
+  size_t n = 0;
+  n += WriteVarint(delta + n, ElapsedMs(&ring->last, sample));
+  n += WriteVarint(delta + n,
+                   PowerDeltaZigZag(Diff(sample->voltage, ring->last.voltage)));
+  n += WriteVarint(delta + n,
+                   PowerDeltaZigZag(Diff(sample->current, ring->last.current)));
+
+  if (ring->used + n > POWER_DELTA_RING_SIZE) {
+    return POWER_DELTA_FULL;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    ring->buf[ring->head] = delta[i];
+    ring->head = (ring->head + 1) % POWER_DELTA_RING_SIZE;
+  }
+  ring->used += n;
+
+  ring->last = *sample;
+  ++ring->count;
+
+  return POWER_DELTA_OK;
+}
+
+PowerDeltaStatus PowerDeltaRingPop(PowerDeltaRing *ring, PowerSample *sample) {
+  if (ring->count == 0) {
+    return POWER_DELTA_EMPTY;
+  }
+
+  *sample = ring->first;
+  --ring->count;
+
+  if (ring->count == 0) {
+    return POWER_DELTA_OK;
+  }
+
+  // apply the next delta so the oldest sample stays absolute
+  uint32_t ms = 0;
+  uint32_t dv = 0;
+  uint32_t di = 0;
+  if (RingReadVarint(ring, &ms) != POWER_DELTA_OK ||
+      RingReadVarint(ring, &dv) != POWER_DELTA_OK ||
+      RingReadVarint(ring, &di) != POWER_DELTA_OK) {
+    PowerDeltaRingInit(ring);
+    return POWER_DELTA_ERROR;
+  }
+
+  AddMs(&ring->first, ms);
+  ring->first.voltage = Sum(ring->first.voltage, PowerDeltaUnZigZag(dv));
+  ring->first.current = Sum(ring->first.current, PowerDeltaUnZigZag(di));
+
+  return POWER_DELTA_OK;
+}
+
+PowerDeltaStatus PowerDeltaRecord(PowerDeltaRing *ring, uint32_t logger_id,
+                                  uint32_t cell_id, uint8_t *buffer,
+                                  size_t size, size_t *len) {
+  if (ring->count == 0) {
+    return POWER_DELTA_EMPTY;
+  }
+
+  pb_ostream_t stream = pb_ostream_from_buffer(buffer, size);
+
+  // zero values are omitted the same as proto3 encoders
+  if (logger_id != 0) {
+    if (!pb_encode_tag(&stream, PB_WT_VARINT,
+                       RepeatedPowerDeltas_logger_id_tag) ||
+        !pb_encode_varint(&stream, logger_id)) {
+      return POWER_DELTA_FULL;
+    }
+  }
+  if (cell_id != 0) {
+    if (!pb_encode_tag(&stream, PB_WT_VARINT,
+                       RepeatedPowerDeltas_cell_id_tag) ||
+        !pb_encode_varint(&stream, cell_id)) {
+      return POWER_DELTA_FULL;
+    }
+  }
+
+  // the length of packed_entries is written once the entries are known, space
+  // is reserved for the longest possible length
+  if (!pb_encode_tag(&stream, PB_WT_STRING,
+                     RepeatedPowerDeltas_packed_entries_tag)) {
+    return POWER_DELTA_FULL;
+  }
+  const size_t len_pos = stream.bytes_written;
+  const size_t len_size = VarintSize(size);
+  const size_t start = len_pos + len_size;
+  size_t pos = start;
+
+  size_t entries = 0;
+  PowerSample prev = {0};
+
+  while (ring->count > 0) {
+    // popping is undone if the entry does not fit
+    const uint16_t saved_tail = ring->tail;
+    const uint16_t saved_used = ring->used;
+    const uint16_t saved_count = ring->count;
+    const PowerSample saved_first = ring->first;
+
+    PowerSample sample;
+    if (PowerDeltaRingPop(ring, &sample) != POWER_DELTA_OK) {
+      return POWER_DELTA_ERROR;
+    }
+
+    uint8_t entry[POWER_DELTA_MAX_SAMPLE_SIZE];
+    size_t n = 0;
+    if (entries == 0) {
+      n += WriteVarint(entry + n, sample.seconds);
+      n += WriteVarint(entry + n, PowerDeltaZigZag(sample.voltage));
+      n += WriteVarint(entry + n, PowerDeltaZigZag(sample.current));
+    } else {
+      n += WriteVarint(entry + n, ElapsedMs(&prev, &sample));
+      n += WriteVarint(entry + n,
+                       PowerDeltaZigZag(Diff(sample.voltage, prev.voltage)));
+      n += WriteVarint(entry + n,
+                       PowerDeltaZigZag(Diff(sample.current, prev.current)));
+    }
+
+    if (pos + n > size ||
+        pos + n - start > PACKED_ENTRIES_MAX_SIZE) {
+      ring->tail = saved_tail;
+      ring->used = saved_used;
+      ring->count = saved_count;
+      ring->first = saved_first;
+      break;
+    }
+
+    memcpy(buffer + pos, entry, n);
+    pos += n;
+
+    prev = sample;
+    ++entries;
+  }
+
+  if (entries == 0) {
+    return POWER_DELTA_FULL;
+  }
+
+  // close the gap left by reserving space for the length
+  const size_t packed_len = pos - start;
+  const size_t n = WriteVarint(buffer + len_pos, packed_len);
+  memmove(buffer + len_pos + n, buffer + start, packed_len);
+
+  *len = len_pos + n + packed_len;
+
+  return POWER_DELTA_OK;
+}
+
+PowerDeltaStatus PowerDeltaUnpack(const uint8_t *data, size_t len,
+                                  PowerDeltaEntry *entries, size_t max_count,
+                                  size_t *count) {
+  *count = 0;
+
+  size_t pos = 0;
+  while (pos < len) {
+    if (*count == max_count) {
+      return POWER_DELTA_FULL;
+    }
+
+    uint32_t values[3];
+    for (int v = 0; v < 3; v++) {
+      if (ReadVarint(data, len, &pos, &values[v]) != POWER_DELTA_OK) {
+        return POWER_DELTA_ERROR;
+      }
+    }
+
+    entries[*count].ts = values[0];
+    entries[*count].voltage_delta = values[1];
+    entries[*count].current_delta = values[2];
+    ++*count;
+  }
+
+  return POWER_DELTA_OK;
+}
+
+void PowerDeltaExpand(const PowerDeltaEntry *entries, size_t count,
+                      PowerSample *samples) {
+  for (size_t i = 0; i < count; i++) {
+    if (i == 0) {
+      samples[i].seconds = entries[i].ts;
+      samples[i].ms = 0;
+      samples[i].voltage = PowerDeltaUnZigZag(entries[i].voltage_delta);
+      samples[i].current = PowerDeltaUnZigZag(entries[i].current_delta);
+    } else {
+      samples[i] = samples[i - 1];
+      AddMs(&samples[i], entries[i].ts);
+      samples[i].voltage =
+          Sum(samples[i].voltage, PowerDeltaUnZigZag(entries[i].voltage_delta));
+      samples[i].current =
+          Sum(samples[i].current, PowerDeltaUnZigZag(entries[i].current_delta));
+    }
+  }
+}
@@ -0,0 +1,54 @@
+/**
+ * @file sample_ring.c
+ *
+ * @see sample_ring.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "sample_ring.h"
+
+// The acquire loads and release stores order the sample copy against the
+// index update. On the single core stm32 they only stop the compiler from
+// reordering, on the host they make the ring safe across threads.
+
+void SampleRingInit(SampleRing *ring) {
+  ring->head = 0;
+  ring->tail = 0;
+  ring->dropped = 0;
+}
+
+bool SampleRingPush(SampleRing *ring, const AdcSample *sample) {
+  const uint32_t head = ring->head;
+  const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+  if (head - tail >= SAMPLE_RING_SIZE) {
+    ++ring->dropped;
+    return false;
+  }
+
+  ring->samples[head & (SAMPLE_RING_SIZE - 1)] = *sample;
+  __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+bool SampleRingPop(SampleRing *ring, AdcSample *sample) {
+  const uint32_t tail = ring->tail;
+  const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+  if (head == tail) {
+    return false;
+  }
+
+  *sample = ring->samples[tail & (SAMPLE_RING_SIZE - 1)];
+  __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+
+  return true;
+}
+
+size_t SampleRingCount(const SampleRing *ring) {
+  const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+  const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+  return head - tail;
+}
@@ -0,0 +1,260 @@
+/**
+ * @file binlog.h
+ * @brief Deferred binary logging
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_BINLOG_INCLUDE_BINLOG_H_
+#define LIB_BINLOG_INCLUDE_BINLOG_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log_conf.h"
+
+/**
+ * @defgroup binlog Binary log
+ * @brief Log records formatted on the host instead of the node
+ *
+ * APP_LOG formats every call with vsnprintf before it is queued for the
+ * UART, which is expensive on the hot path, especially for hex dumps of
+ * payloads where every byte is a separate call. BINLOG instead copies the
+ * address of its format string and the raw arguments into a RAM ring.
+ * Formatting is left to the host.
+ *
+ * The format strings stay in flash and their address is the id of the
+ * record. binlog_table.py runs after every build and extracts the strings
+ * into binlog.json next to firmware.elf. ents binlog uses the table to turn
+ * the records back into text.
+ *
+ * The ring is flushed with BinlogFlush when the sequencer is idle, so
+ * records can show up after text logs that were written later. Each record
+ * carries a timestamp in the same format as APP_LOG. Records are sent as
+ * COBS frames enclosed by 0x00 bytes, which never occur in text logs, so
+ * both can share the UART.
+ *
+ * Arguments are stored by type:
+ * - integers up to 32 bits as 4 bytes
+ * - long long as 8 bytes
+ * - float and double as 8 byte doubles
+ * - strings with their terminator
+ * - BinlogBlob as a 2 byte length followed by the data, printed as hex with
+ *   the %H conversion
+ *
+ * Pointers have to be cast to uintptr_t. At most BINLOG_MAX_ARGS arguments
+ * are supported. Arguments are evaluated with interrupts disabled, so keep
+ * them simple.
+ *
+ * @{
+ */
+
+/** Size of the ring in bytes, a power of two */
+#ifndef BINLOG_BUFFER_SIZE
+#define BINLOG_BUFFER_SIZE 1024
+#endif /* BINLOG_BUFFER_SIZE */
+
+/** Max number of arguments of a record */
+#define BINLOG_MAX_ARGS 8
+
+/** Bytes of a record before its arguments */
+#define BINLOG_HEADER_SIZE 11
+
+/** Id of the record reporting dropped records */
+#define BINLOG_ID_DROPPED 0
+
+/** Data printed as hex with %H */
+typedef struct {
+  /** Data */
+  const uint8_t *data;
+  /** Length of the data */
+  size_t len;
+} BinlogBlob;
+
+/** Record being written, see BINLOG */
+typedef struct {
+  /** Ring position of the record */
+  size_t start;
+  /** Ring position of the next byte */
+  size_t pos;
+  /** Interrupt mask before the record */
+  uint32_t primask;
+  /** Cleared when the record does not fit */
+  bool ok;
+} BinlogRecord;
+
+/**
+ * @brief Current time in ms
+ */
+typedef uint32_t (*BinlogTimestampFn)(void);
+
+/**
+ * @brief Write a frame to the output
+ *
+ * @param data Frame
+ * @param len Length of the frame
+ *
+ * @return false if the frame could not be written, it is retried on the next
+ * flush
+ */
+typedef bool (*BinlogWriteFn)(const uint8_t *data, size_t len);
+
+/**
+ * @brief Log a record
+ *
+ * Same as APP_LOG with a timestamp, but formatted on the host.
+ *
+ * @code
+ * BINLOG(VLEVEL_M, "Payload (%d): %H\r\n", len, BINLOG_BLOB(buffer, len));
+ * @endcode
+ *
+ * @param level Verbose level, records above the level set by BinlogInit are
+ * skipped and records above the threshold of the module in log_conf.h are
+ * compiled out
+ * @param ... Format string literal followed by the arguments
+ */
+#define BINLOG(level, ...)                                               \
+  do {                                                                   \
+    if (APP_LOG_COMPILED(level)) {                                       \
+      static const char binlog_fmt[] = BINLOG_FIRST(__VA_ARGS__, );      \
+      BinlogRecord binlog_rec;                                           \
+      if (BinlogBegin(&binlog_rec, (level), binlog_fmt)) {               \
+        BINLOG_CAT(BINLOG_PUT_, BINLOG_NARG(__VA_ARGS__))                \
+        (&binlog_rec, __VA_ARGS__) BinlogEnd(&binlog_rec);               \
+      }                                                                  \
+    }                                                                    \
+  } while (0)
+
+/**
+ * @brief Blob argument printed as hex
+ *
+ * @param data Pointer to the data
+ * @param len Length of the data
+ */
+#define BINLOG_BLOB(data, len) \
+  ((BinlogBlob){(const uint8_t *)(data), (size_t)(len)})
+
+/** @cond INTERNAL */
+#define BINLOG_CAT(a, b) BINLOG_CAT_(a, b)
+#define BINLOG_CAT_(a, b) a##b
+#define BINLOG_FIRST(first, ...) first
+#define BINLOG_NARG(...) BINLOG_NARG_(__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, )
+#define BINLOG_NARG_(_1, _2, _3, _4, _5, _6, _7, _8, _9, n, ...) n
+
+#define BINLOG_PUT(rec, x)                                               \
+  _Generic((x),                                                          \
+      float: BinlogPutDouble,                                            \
+      double: BinlogPutDouble,                                           \
+      char *: BinlogPutString,                                           \
+      const char *: BinlogPutString,                                     \
+      long long: BinlogPutU64,                                           \
+      unsigned long long: BinlogPutU64,                                  \
+      BinlogBlob: BinlogPutBlob,                                         \
+      default: BinlogPutU32)(rec, x);
+
+#define BINLOG_PUT_1(rec, fmt)
+#define BINLOG_PUT_2(rec, fmt, a) BINLOG_PUT(rec, a)
+#define BINLOG_PUT_3(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_2(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_4(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_3(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_5(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_4(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_6(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_5(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_7(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_6(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_8(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_7(rec, fmt, __VA_ARGS__)
+#define BINLOG_PUT_9(rec, fmt, a, ...) \
+  BINLOG_PUT(rec, a) BINLOG_PUT_8(rec, fmt, __VA_ARGS__)
+/** @endcond */
+
+/**
+ * @brief Reset the ring and set the verbose level
+ *
+ * @param level Max verbose level of logged records, same as
+ * UTIL_ADV_TRACE_SetVerboseLevel
+ * @param timestamp Time source of the records, NULL for 0
+ */
+void BinlogInit(uint8_t level, BinlogTimestampFn timestamp);
+
+/**
+ * @brief Start a record, use BINLOG instead
+ *
+ * Disables interrupts until BinlogEnd when it returns true.
+ *
+ * @param rec Record
+ * @param level Verbose level of the record
+ * @param fmt Format string, its address is the id of the record
+ *
+ * @return false if the level is skipped
+ */
+bool BinlogBegin(BinlogRecord *rec, uint8_t level, const char *fmt);
+
+/**
+ * @brief Add an integer argument of up to 32 bits
+ */
+void BinlogPutU32(BinlogRecord *rec, uint32_t value);
+
+/**
+ * @brief Add a 64 bit integer argument
+ */
+void BinlogPutU64(BinlogRecord *rec, uint64_t value);
+
+/**
+ * @brief Add a floating point argument
+ */
+void BinlogPutDouble(BinlogRecord *rec, double value);
+
+/**
+ * @brief Add a string argument
+ */
+void BinlogPutString(BinlogRecord *rec, const char *str);
+
+/**
+ * @brief Add a blob argument
+ */
+void BinlogPutBlob(BinlogRecord *rec, BinlogBlob blob);
+
+/**
+ * @brief Commit a record, use BINLOG instead
+ *
+ * The record is dropped if it did not fit in the ring.
+ *
+ * @param rec Record
+ */
+void BinlogEnd(BinlogRecord *rec);
+
+/**
+ * @brief Write the records in the ring as frames
+ *
+ * A record with id BINLOG_ID_DROPPED and the count as argument is written
+ * first if records were dropped. Stops at the first frame that could not be
+ * written.
+ *
+ * @param write Output of the frames
+ *
+ * @return Number of frames written
+ */
+size_t BinlogFlush(BinlogWriteFn write);
+
+/**
+ * @brief Number of records dropped since the last flush
+ */
+uint32_t BinlogDropped(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_BINLOG_INCLUDE_BINLOG_H_
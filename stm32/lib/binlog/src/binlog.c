@@ -0,0 +1,226 @@
+/**
+ * @file binlog.c
+ *
+ * @see binlog.h
+ *
+ * Records are stored in the ring as
+ *
+ * | Bytes | Field |
+ * |---|---|
+ * | 2 | length of the rest of the record |
+ * | 1 | verbose level |
+ * | 4 | timestamp in ms |
+ * | 4 | address of the format string |
+ * | ... | arguments |
+ *
+ * All fields are little endian. Frames on the output are 0x00, the COBS
+ * encoded record, 0x00.
+ *
+ * @date 2026-10-19
+ */
+
+#include "binlog.h"
+
+#include <string.h>
+
+#include "stm32wlxx_hal.h"
+
+#if (BINLOG_BUFFER_SIZE & (BINLOG_BUFFER_SIZE - 1)) != 0
+#error "BINLOG_BUFFER_SIZE must be a power of two"
+#endif
+
+#if BINLOG_BUFFER_SIZE > UINT16_MAX
+#error "BINLOG_BUFFER_SIZE must fit the length of a record"
+#endif
+
+/** Mask of ring positions */
+#define BUFFER_MASK (BINLOG_BUFFER_SIZE - 1)
+
+/** Size of the length field */
+#define LENGTH_SIZE 2
+
+/** Max size of a frame, one COBS code per 254 bytes and the delimiters */
+#define FRAME_SIZE (BINLOG_BUFFER_SIZE + BINLOG_BUFFER_SIZE / 254 + 3)
+
+/** Ring of records */
+static uint8_t buffer[BINLOG_BUFFER_SIZE];
+
+/** Position after the last committed record */
+static volatile size_t head = 0;
+
+/** Position of the oldest record */
+static volatile size_t tail = 0;
+
+/** Records dropped since the last flush */
+static volatile uint32_t dropped = 0;
+
+/** Max verbose level */
+static uint8_t verbose_level = 0;
+
+/** Time source */
+static BinlogTimestampFn timestamp_fn = NULL;
+
+/** Encoded frame */
+static uint8_t frame[FRAME_SIZE];
+
+/**
+ * @brief Copy data into the record if it fits
+ */
+static void Write(BinlogRecord *rec, const void *data, size_t len) {
+  if (!rec->ok) {
+    return;
+  }
+  if (rec->pos - tail + len > BINLOG_BUFFER_SIZE) {
+    rec->ok = false;
+    return;
+  }
+
+  const size_t offset = rec->pos & BUFFER_MASK;
+  const size_t first =
+      (len < BINLOG_BUFFER_SIZE - offset) ? len : BINLOG_BUFFER_SIZE - offset;
+  memcpy(&buffer[offset], data, first);
+  memcpy(buffer, (const uint8_t *)data + first, len - first);
+  rec->pos += len;
+}
+
+/**
+ * @brief COBS encode a record between 0x00 delimiters into the frame
+ *
+ * @param data Record or ring
+ * @param mask Mask of positions in @p data
+ * @param start Position of the record in @p data
+ * @param len Length of the record
+ *
+ * @return Length of the frame
+ */
+static size_t Encode(const uint8_t *data, size_t mask, size_t start,
+                     size_t len) {
+  size_t out = 0;
+  frame[out++] = 0x00;
+
+  size_t code_pos = out++;
+  uint8_t code = 1;
+  for (size_t i = 0; i < len; i++) {
+    const uint8_t byte = data[(start + i) & mask];
+    if (byte != 0x00) {
+      frame[out++] = byte;
+      code++;
+    }
+    if (byte == 0x00 || code == 0xFF) {
+      frame[code_pos] = code;
+      code_pos = out++;
+      code = 1;
+    }
+  }
+  frame[code_pos] = code;
+
+  frame[out++] = 0x00;
+  return out;
+}
+
+void BinlogInit(uint8_t level, BinlogTimestampFn timestamp) {
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  verbose_level = level;
+  timestamp_fn = timestamp;
+}
+
+bool BinlogBegin(BinlogRecord *rec, uint8_t level, const char *fmt) {
+  if (level > verbose_level) {
+    return false;
+  }
+
+  rec->primask = __get_PRIMASK();
+  __disable_irq();
+
+  rec->start = head;
+  rec->pos = head + LENGTH_SIZE;
+  rec->ok = true;
+
+  const uint32_t ts = (timestamp_fn != NULL) ? timestamp_fn() : 0;
+  const uint32_t id = (uint32_t)(uintptr_t)fmt;
+  Write(rec, &level, sizeof(level));
+  Write(rec, &ts, sizeof(ts));
+  Write(rec, &id, sizeof(id));
+
+  return true;
+}
+
+void BinlogPutU32(BinlogRecord *rec, uint32_t value) {
+  Write(rec, &value, sizeof(value));
+}
+
+void BinlogPutU64(BinlogRecord *rec, uint64_t value) {
+  Write(rec, &value, sizeof(value));
+}
+
+void BinlogPutDouble(BinlogRecord *rec, double value) {
+  Write(rec, &value, sizeof(value));
+}
+
+void BinlogPutString(BinlogRecord *rec, const char *str) {
+  Write(rec, str, strlen(str) + 1);
+}
+
+void BinlogPutBlob(BinlogRecord *rec, BinlogBlob blob) {
+  const uint16_t len = (uint16_t)blob.len;
+  Write(rec, &len, sizeof(len));
+  Write(rec, blob.data, len);
+}
+
+void BinlogEnd(BinlogRecord *rec) {
+  if (rec->ok) {
+    const size_t len = rec->pos - rec->start - LENGTH_SIZE;
+    buffer[rec->start & BUFFER_MASK] = len & 0xFF;
+    buffer[(rec->start + 1) & BUFFER_MASK] = len >> 8;
+    head = rec->pos;
+  } else {
+    dropped++;
+  }
+
+  __set_PRIMASK(rec->primask);
+}
+
+size_t BinlogFlush(BinlogWriteFn write) {
+  size_t count = 0;
+
+  const uint32_t lost = dropped;
+  if (lost > 0) {
+    uint8_t record[BINLOG_HEADER_SIZE + sizeof(lost)];
+    const uint16_t len = sizeof(record) - LENGTH_SIZE;
+    const uint8_t level = 0;
+    const uint32_t ts = (timestamp_fn != NULL) ? timestamp_fn() : 0;
+    const uint32_t id = BINLOG_ID_DROPPED;
+    memcpy(&record[0], &len, sizeof(len));
+    memcpy(&record[2], &level, sizeof(level));
+    memcpy(&record[3], &ts, sizeof(ts));
+    memcpy(&record[7], &id, sizeof(id));
+    memcpy(&record[11], &lost, sizeof(lost));
+
+    if (!write(frame, Encode(record, SIZE_MAX, 0, sizeof(record)))) {
+      return count;
+    }
+    count++;
+
+    // records can be dropped while writing
+    const uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    dropped -= lost;
+    __set_PRIMASK(primask);
+  }
+
+  while (tail != head) {
+    const size_t len = LENGTH_SIZE + (buffer[tail & BUFFER_MASK] |
+                                      buffer[(tail + 1) & BUFFER_MASK] << 8);
+    if (!write(frame, Encode(buffer, BUFFER_MASK, tail, len))) {
+      break;
+    }
+    tail += len;
+    count++;
+  }
+
+  return count;
+}
+
+uint32_t BinlogDropped(void) { return dropped; }
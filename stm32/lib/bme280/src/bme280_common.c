@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#define APP_LOG_MODULE BME280
+
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -11,6 +13,7 @@
 #include "sys_app.h"
 #include "stm32wlxx_hal.h"
 #include "i2c.h"
+#include "lowpower.h"
 
 #include "bme280.h"
 #include "bme280_common.h"
@@ -40,9 +43,13 @@ BME280_INTF_RET_TYPE bme280_i2c_read(uint8_t reg_addr, uint8_t *reg_data, uint32
 {
     dev_addr = *(uint8_t*)intf_ptr;
 
+    if (I2C1_Claim(i2c_timeout) != HAL_OK) {
+        return BME280_E_COMM_FAIL;
+    }
     HAL_StatusTypeDef status = HAL_I2C_Mem_Read(&hi2c1, dev_addr << 1, reg_addr,
                                                 I2C_MEMADD_SIZE_8BIT, reg_data,
                                                 length, i2c_timeout);
+    I2C1_Release();
 
     if (status != HAL_OK) {
         return BME280_E_COMM_FAIL;
@@ -58,9 +65,13 @@ BME280_INTF_RET_TYPE bme280_i2c_write(uint8_t reg_addr, const uint8_t *reg_data,
 {
     dev_addr = *(uint8_t*)intf_ptr;
 
+    if (I2C1_Claim(i2c_timeout) != HAL_OK) {
+        return BME280_E_COMM_FAIL;
+    }
     HAL_StatusTypeDef status = HAL_I2C_Mem_Write(&hi2c1, dev_addr << 1,
                                                  reg_addr, I2C_MEMADD_SIZE_8BIT,
                                                  (uint8_t *) reg_data, length, i2c_timeout);
+    I2C1_Release();
 
     if (status != HAL_OK) {
         return BME280_E_COMM_FAIL;
@@ -101,7 +112,7 @@ void bme280_delay_us(uint32_t period, void *intf_ptr)
     }
 
     // delay
-    HAL_Delay(period_ms);
+    LowPowerDelay(period_ms);
 }
 
 /*!
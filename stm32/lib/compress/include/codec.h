@@ -0,0 +1,149 @@
+/**
+ * @file codec.h
+ * @brief Per payload codec selection
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_COMPRESS_INCLUDE_CODEC_H_
+#define LIB_COMPRESS_INCLUDE_CODEC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "compress.h"
+
+/**
+ * @ingroup compress
+ * @defgroup codec Codec selection
+ * @brief Picks the codec producing the smallest payload
+ *
+ * Different sensor mixes compress very differently, so every available
+ * codec is tried on each payload and the smallest output is kept. The
+ * output is prefixed with a single byte CodecId so the backend can dispatch
+ * to the matching decoder, see ents.compress.codec in the Python package.
+ *
+ * Codecs can be excluded to save flash by defining any of the following:
+ * - COMPRESS_DISABLE_RLE
+ * - COMPRESS_DISABLE_DELTA
+ * - COMPRESS_DISABLE_LZ77 (also excludes the dictionary)
+ * - COMPRESS_DISABLE_LZ77_DICT
+ *
+ * CODEC_NONE is always available so a payload can always be sent.
+ *
+ * @{
+ */
+
+/** Codec ids stored in the first byte of a payload, never reorder */
+typedef enum {
+  /** Payload is stored as is */
+  CODEC_NONE = 0,
+  /** See rle.h */
+  CODEC_RLE = 1,
+  /** See delta.h */
+  CODEC_DELTA = 2,
+  /** See lz77.h, without a dictionary */
+  CODEC_LZ77 = 3,
+  /** See lz77.h, primed with lz77_dict */
+  CODEC_LZ77_DICT = 4,
+  /** Number of codec ids */
+  CODEC_COUNT,
+} CodecId;
+
+/** Number of bytes added in front of the compressed data */
+#define CODEC_HEADER_SIZE 1
+
+/** Largest payload CodecCompress accepts, sized for LoRaWAN */
+#define CODEC_MAX_PAYLOAD 256
+
+/** No CPU budget, try every available codec */
+#define CODEC_BUDGET_UNLIMITED 0
+
+/**
+ * @brief Checks if a codec was compiled in
+ *
+ * @param id Codec id
+ *
+ * @return true if available
+ */
+bool CodecAvailable(CodecId id);
+
+/**
+ * @brief Estimated number of cycles to encode a payload
+ *
+ * Coarse per byte model used to enforce the budget of CodecCompress.
+ *
+ * @param id Codec id
+ * @param length Number of bytes in the payload
+ *
+ * @return Estimated cycles
+ */
+uint32_t CodecCost(CodecId id, size_t length);
+
+/**
+ * @brief Encode a payload with a specific codec
+ *
+ * @param id Codec id
+ * @param data Input data
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the codec id and compressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return COMPRESS_ERROR if the codec is not available, otherwise see
+ * CompressStatus
+ */
+CompressStatus CodecEncode(CodecId id, const uint8_t *data, size_t length,
+                           uint8_t *buffer, size_t size, size_t *out_len);
+
+/**
+ * @brief Encode a payload with the codec producing the smallest output
+ *
+ * Codecs are tried from cheapest to most expensive and skipped once their
+ * estimated cost exceeds what is left of @p budget. CODEC_NONE is always
+ * tried so the call only fails if @p size is smaller than
+ * @p length + CODEC_HEADER_SIZE.
+ *
+ * @param data Input data
+ * @param length Number of bytes in @p data, at most CODEC_MAX_PAYLOAD
+ * @param budget Max estimated cycles to spend, CODEC_BUDGET_UNLIMITED for no
+ * limit
+ * @param buffer Buffer to store the codec id and compressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ * @param selected Codec used, can be NULL
+ *
+ * @return See CompressStatus
+ */
+CompressStatus CodecCompress(const uint8_t *data, size_t length,
+                             uint32_t budget, uint8_t *buffer, size_t size,
+                             size_t *out_len, CodecId *selected);
+
+/**
+ * @brief Decode a payload created by CodecEncode or CodecCompress
+ *
+ * @param data Payload starting with the codec id
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the decompressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus CodecDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_COMPRESS_INCLUDE_CODEC_H_
@@ -0,0 +1,51 @@
+/**
+ * @file compress.h
+ * @brief Common definitions shared by the compression codecs
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_COMPRESS_INCLUDE_COMPRESS_H_
+#define LIB_COMPRESS_INCLUDE_COMPRESS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @ingroup stm32
+ * @defgroup compress Compression
+ * @brief Lossless codecs for serialized measurement payloads
+ *
+ * The codecs operate on byte buffers, typically protobuf serialized
+ * measurements, and never allocate from the heap. All working memory is
+ * either static to the codec or provided by the caller so the worst case RAM
+ * usage is known at compile time.
+ *
+ * @{
+ */
+
+/** Status codes for the compression library */
+typedef enum {
+  /** Operation completed */
+  COMPRESS_OK = 0,
+  /** General error, ie. invalid arguments */
+  COMPRESS_ERROR = -1,
+  /** Output buffer is too small for the result */
+  COMPRESS_OVERFLOW = -2,
+  /** Input stream is malformed */
+  COMPRESS_CORRUPT = -3,
+} CompressStatus;
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_COMPRESS_INCLUDE_COMPRESS_H_
@@ -0,0 +1,80 @@
+/**
+ * @file delta.h
+ * @brief Provides declarations for delta encoding of serialized messages
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_COMPRESS_INCLUDE_DELTA_H_
+#define LIB_COMPRESS_INCLUDE_DELTA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "compress.h"
+
+/**
+ * @ingroup compress
+ * @defgroup delta Delta encoding
+ * @brief Record stride delta with zero run coding
+ *
+ * Payloads made of repeated measurements, ie. power deltas, contain records
+ * with the same layout where only a few bytes (timestamp, low bits of the
+ * value) change. Each byte is XORed with the byte one record earlier, the
+ * stride, turning the unchanged bytes into zeros. The stride is picked by
+ * the encoder as the one producing the most zeros.
+ *
+ * The stream is the stride followed by (zeros, literals) pairs, both as
+ * base 128 varints, with the literal bytes following each pair. Bytes before
+ * the first stride are stored as is.
+ *
+ * The payload is opaque at this point, so the delta is taken on bytes rather
+ * than decoded field values.
+ *
+ * @{
+ */
+
+/** Largest record stride searched by the encoder */
+#define DELTA_MAX_STRIDE 32
+
+/**
+ * @brief Delta encode a string of bytes
+ *
+ * @param data Input data
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the compressed stream
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus DeltaEncode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len);
+
+/**
+ * @brief Decode a stream created by DeltaEncode
+ *
+ * @param data Compressed stream
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the decompressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus DeltaDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_COMPRESS_INCLUDE_DELTA_H_
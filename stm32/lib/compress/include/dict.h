@@ -16,53 +16,135 @@
 extern "C" {
 #endif
 
-#include <stdlib.h>
-#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
 
-#include "uthash.h"
+/**
+ * @ingroup compress
+ * @defgroup dict Dictionary
+ * @brief Phrase dictionary for LZ78/LZW style codecs
+ *
+ * Phrases are stored as a trie inside a fixed size arena. Each entry only
+ * holds the code of its parent phrase and the byte that extends it, so a
+ * phrase of any length costs three bytes plus four bytes of hash table, two
+ * 16-bit slots per entry. Child lookup is done through an open addressing hash
+ * table keyed on the (parent, byte) pair.
+ *
+ * Since phrases are never stored as strings the dictionary is binary safe, ie.
+ * protobuf data containing zero bytes can be represented. The dictionary does
+ * not allocate memory and is expected to be reset with DictInit() at the start
+ * of every message.
+ *
+ * Codes are assigned sequentially starting at 1. The code @ref DICT_ROOT
+ * refers to the empty phrase and is the parent of all single byte phrases.
+ *
+ * @{
+ */
+
+#ifndef DICT_MAX_ENTRIES
+/** Maximum number of phrases stored in the dictionary */
+#define DICT_MAX_ENTRIES 256
+#endif /* DICT_MAX_ENTRIES */
+
+#ifndef DICT_HASH_SIZE
+/** Number of slots in the child lookup table, must be a power of two */
+#define DICT_HASH_SIZE (2 * DICT_MAX_ENTRIES)
+#endif /* DICT_HASH_SIZE */
+
+#if DICT_MAX_ENTRIES >= 0xFFFF
+#error "DICT_MAX_ENTRIES must fit in a 16-bit code"
+#endif
 
-// Dictionary entry structure
+#if (DICT_HASH_SIZE & (DICT_HASH_SIZE - 1)) != 0
+#error "DICT_HASH_SIZE must be a power of two"
+#endif
+
+#if DICT_HASH_SIZE <= DICT_MAX_ENTRIES
+#error "DICT_HASH_SIZE must be greater than DICT_MAX_ENTRIES"
+#endif
+
+/** Code of the empty phrase */
+#define DICT_ROOT 0
+
+/** Returned when a phrase is not found or cannot be added */
+#define DICT_NOT_FOUND -1
+
+/**
+ * @brief Arena backing the dictionary
+ *
+ * Index 0 of @p parent and @p byte is unused so codes can index the arrays
+ * directly.
+ */
 typedef struct {
-  char key[256];  // Key (string phrase)
-  int value;      // Associated value (index)
-  UT_hash_handle hh;
-} DictEntry;
+  /** Code of the parent phrase for each entry */
+  uint16_t parent[DICT_MAX_ENTRIES + 1];
+  /** Byte appended to the parent phrase for each entry */
+  uint8_t byte[DICT_MAX_ENTRIES + 1];
+  /** Child lookup table storing codes, 0 indicates an empty slot */
+  uint16_t table[DICT_HASH_SIZE];
+  /** Number of phrases in the dictionary */
+  uint16_t count;
+} Dict;
 
-// Function declarations
 /**
-******************************************************************************
-* @brief    Init dictionary
-*
-******************************************************************************
-*/
-void dict_init();
+ * @brief Resets the dictionary to an empty state
+ *
+ * @param dict Dictionary arena
+ */
+void DictInit(Dict *dict);
 
 /**
-******************************************************************************
-* @brief    Add an entry to dict
-*
-* @param    const char *key,
-* @param    int value
-******************************************************************************
-*/
-void dict_add(const char *key, int value);
+ * @brief Searches for the phrase formed by extending @p parent with @p byte
+ *
+ * @param dict Dictionary arena
+ * @param parent Code of the parent phrase, DICT_ROOT for single bytes
+ * @param byte Byte extending the parent phrase
+ *
+ * @return Code of the phrase, DICT_NOT_FOUND if not in the dictionary
+ */
+int DictFind(const Dict *dict, uint16_t parent, uint8_t byte);
 
 /**
-******************************************************************************
-* @brief    search the dict by key
-*
-* @param    const char *key,
-* @return    int value
-******************************************************************************
-*/
-int dict_search(const char *key);
+ * @brief Adds the phrase formed by extending @p parent with @p byte
+ *
+ * The caller is responsible for ensuring the phrase is not already in the
+ * dictionary.
+ *
+ * @param dict Dictionary arena
+ * @param parent Code of the parent phrase, DICT_ROOT for single bytes
+ * @param byte Byte extending the parent phrase
+ *
+ * @return Code of the new phrase, DICT_NOT_FOUND if the dictionary is full or
+ * @p parent is not a valid code
+ */
+int DictAdd(Dict *dict, uint16_t parent, uint8_t byte);
 
 /**
-******************************************************************************
-* @brief    free all dict entries
-******************************************************************************
-*/
-void dict_free();
+ * @brief Gets the length of a phrase in bytes
+ *
+ * @param dict Dictionary arena
+ * @param code Code of the phrase
+ *
+ * @return Length of the phrase, 0 for DICT_ROOT or an invalid code
+ */
+size_t DictPhraseLen(const Dict *dict, uint16_t code);
+
+/**
+ * @brief Copies a phrase into a buffer
+ *
+ * @param dict Dictionary arena
+ * @param code Code of the phrase
+ * @param buffer Buffer to store the phrase
+ * @param size Size of @p buffer
+ *
+ * @return Number of bytes written, 0 if the phrase does not fit in @p buffer
+ */
+size_t DictPhrase(const Dict *dict, uint16_t code, uint8_t *buffer,
+                  size_t size);
+
+/**
+ * @}
+ */
 
 #ifdef __cplusplus
 }
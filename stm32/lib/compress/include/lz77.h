@@ -0,0 +1,125 @@
+/**
+ * @file lz77.h
+ * @brief Provides declarations for LZ77 serialized message compression.
+ *
+ * Assumes the messages passed have already been serailized via protobuf
+ *
+ * @author Steve Taylor <stevegtaylor@pm.me>
+ * @date 2025-04-01
+ */
+
+#ifndef LIB_COMPRESS_INCLUDE_LZ77_H_
+#define LIB_COMPRESS_INCLUDE_LZ77_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "compress.h"
+
+/**
+ * @ingroup compress
+ * @defgroup lz77 LZ77
+ * @brief LZ77 compression primed with a static dictionary
+ *
+ * Uplinks are too short for an adaptive window to find many repeats. The
+ * window is instead initialised with a static dictionary of common
+ * substrings (field tags, sensor types, ids) trained offline with
+ * extras/compression/train_dict.py, so matches can be found from the first
+ * byte of a payload.
+ *
+ * The stream starts with the dictionary id (0 for none) followed by the
+ * uncompressed length as a base 128 varint. Tokens are packed MSB first:
+ * - 0 followed by an 8 bit literal
+ * - 1 followed by an 11 bit distance - 1 and a 5 bit length - 3
+ *
+ * The encoder is greedy and picks the longest match, preferring the closest
+ * one on ties. The output is identical to ents.compress.lz77 in the Python
+ * package which carries the same dictionaries.
+ *
+ * No state is kept between calls, the functions are reentrant.
+ *
+ * @{
+ */
+
+/** Minimum match length encoded as a back reference */
+#define LZ77_MIN_MATCH 3
+
+/** Number of bits to encode the distance of a match */
+#define LZ77_DISTANCE_BITS 11
+
+/** Number of bits to encode the length of a match */
+#define LZ77_LENGTH_BITS 5
+
+/** Max distance of a match */
+#define LZ77_WINDOW_SIZE (1 << LZ77_DISTANCE_BITS)
+
+/** Max length of a match */
+#define LZ77_MAX_MATCH (LZ77_MIN_MATCH + (1 << LZ77_LENGTH_BITS) - 1)
+
+/** Max size of a static dictionary, leaves room in the window for data */
+#define LZ77_MAX_DICT_SIZE 1024
+
+/** Dictionary id for compressing without a dictionary */
+#define LZ77_DICT_NONE 0
+
+/** Static dictionary stored in flash */
+typedef struct {
+  /** Version of the dictionary stored in the stream, never LZ77_DICT_NONE */
+  uint8_t id;
+  /** Dictionary contents */
+  const uint8_t *data;
+  /** Number of bytes in @p data, at most LZ77_MAX_DICT_SIZE */
+  uint16_t len;
+} LZ77Dict;
+
+/** Dictionary trained on captured uplinks, see lz77_dict.c */
+extern const LZ77Dict lz77_dict;
+
+/**
+ * @brief Encode a Protobuf serialized string of bytes using LZ77
+ *
+ * @param data Input data
+ * @param length Number of bytes in @p data
+ * @param dict Static dictionary to prime the window, NULL for none
+ * @param buffer Buffer to store the compressed stream
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus LZ77Encode(const uint8_t *data, size_t length,
+                          const LZ77Dict *dict, uint8_t *buffer, size_t size,
+                          size_t *out_len);
+
+/**
+ * @brief Decode a stream created by LZ77Encode
+ *
+ * The dictionary id in the stream must match @p dict, otherwise
+ * COMPRESS_CORRUPT is returned.
+ *
+ * @param data Compressed stream
+ * @param length Number of bytes in @p data
+ * @param dict Static dictionary used to encode, NULL for none
+ * @param buffer Buffer to store the decompressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus LZ77Decode(const uint8_t *data, size_t length,
+                          const LZ77Dict *dict, uint8_t *buffer, size_t size,
+                          size_t *out_len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_COMPRESS_INCLUDE_LZ77_H_
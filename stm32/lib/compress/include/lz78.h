@@ -18,21 +18,62 @@ extern "C" {
 #include <stdint.h>
 #include <stdlib.h>
 
-#include "uthash.h"
+#include "compress.h"
+#include "dict.h"
 
 /**
-******************************************************************************
-* @brief    Encode a Protobuf serialized string of bytes using LZ78
-*
-* @param    const uint8_t *, data
-* @param    size_t length
-* @return   void
-******************************************************************************
-*/
-void LZ78_encode(const uint8_t *data, size_t length);
+ * @ingroup compress
+ * @defgroup lz78 LZ78
+ * @brief LZ78 compression backed by the arena dictionary
+ *
+ * The compressed stream starts with the uncompressed length encoded as a
+ * base 128 varint followed by (code, byte) tokens. Codes are packed MSB first
+ * with the minimum number of bits required to represent the current size of
+ * the dictionary, so the width grows as phrases are added. Once the
+ * dictionary is full no new phrases are added and the code width stays
+ * constant.
+ *
+ * The dictionary is reset at the start of every call, each message is
+ * compressed independently. The functions share a static dictionary and are
+ * not reentrant.
+ *
+ * @{
+ */
+
+/**
+ * @brief Encode a Protobuf serialized string of bytes using LZ78
+ *
+ * @param data Input data
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the compressed stream
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus LZ78Encode(const uint8_t *data, size_t length, uint8_t *buffer,
+                          size_t size, size_t *out_len);
+
+/**
+ * @brief Decode a stream created by LZ78Encode
+ *
+ * @param data Compressed stream
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the decompressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus LZ78Decode(const uint8_t *data, size_t length, uint8_t *buffer,
+                          size_t size, size_t *out_len);
+
+/**
+ * @}
+ */
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif  // LIB_COMPRESS_INCLUDE_lz78_H_
\ No newline at end of file
+#endif  // LIB_COMPRESS_INCLUDE_lz78_H_
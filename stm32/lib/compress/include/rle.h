@@ -0,0 +1,81 @@
+/**
+ * @file rle.h
+ * @brief Provides declarations for run length encoding of serialized messages
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_COMPRESS_INCLUDE_RLE_H_
+#define LIB_COMPRESS_INCLUDE_RLE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "compress.h"
+
+/**
+ * @ingroup compress
+ * @defgroup rle Run length encoding
+ * @brief PackBits style run length encoding
+ *
+ * The stream is a sequence of packets each starting with a control byte:
+ * - 0x00-0x7F: followed by control + 1 literal bytes
+ * - 0x80-0xFF: followed by a single byte repeated (control & 0x7F) + 3 times
+ *
+ * Runs shorter than 3 bytes are stored as literals so incompressible data
+ * grows by at most 1 byte in 128. Targets the zero padding of doubles and
+ * fixed width integers in protobuf payloads.
+ *
+ * @{
+ */
+
+/** Minimum run length encoded as a repeat packet */
+#define RLE_MIN_RUN 3
+
+/** Max run length of a single repeat packet */
+#define RLE_MAX_RUN (RLE_MIN_RUN + 0x7F)
+
+/** Max number of bytes in a single literal packet */
+#define RLE_MAX_LITERAL 128
+
+/**
+ * @brief Run length encode a string of bytes
+ *
+ * @param data Input data
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the compressed stream
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus RLEEncode(const uint8_t *data, size_t length, uint8_t *buffer,
+                         size_t size, size_t *out_len);
+
+/**
+ * @brief Decode a stream created by RLEEncode
+ *
+ * @param data Compressed stream
+ * @param length Number of bytes in @p data
+ * @param buffer Buffer to store the decompressed data
+ * @param size Size of @p buffer
+ * @param out_len Number of bytes written to @p buffer
+ *
+ * @return See CompressStatus
+ */
+CompressStatus RLEDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                         size_t size, size_t *out_len);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_COMPRESS_INCLUDE_RLE_H_
@@ -0,0 +1,131 @@
+/**
+ * @file bitstream.h
+ * @brief MSB first bit packing and varints shared by the codecs
+ *
+ * Private to the compression library.
+ *
+ * @author Steve Taylor <stevegtaylor@pm.me>
+ * @date 2025-04-01
+ */
+
+#ifndef LIB_COMPRESS_SRC_BITSTREAM_H_
+#define LIB_COMPRESS_SRC_BITSTREAM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** MSB first bit packer over a byte buffer */
+typedef struct {
+  uint8_t *buffer;
+  size_t size;
+  /** Number of bits written */
+  size_t bits;
+} BitWriter;
+
+/** MSB first bit reader over a byte buffer */
+typedef struct {
+  const uint8_t *buffer;
+  size_t size;
+  /** Number of bits read */
+  size_t bits;
+} BitReader;
+
+/**
+ * @brief Writes the lower @p nbits of @p value
+ *
+ * @return false if the buffer is full
+ */
+static inline bool BitWrite(BitWriter *bw, uint32_t value, uint8_t nbits) {
+  if (bw->bits + nbits > bw->size * 8) {
+    return false;
+  }
+
+  for (int i = nbits - 1; i >= 0; i--) {
+    const size_t byte = bw->bits / 8;
+    const uint8_t mask = 0x80 >> (bw->bits % 8);
+    // clear new bytes so the padding in the last byte is zero
+    if (mask == 0x80) {
+      bw->buffer[byte] = 0;
+    }
+    if (value & (1u << i)) {
+      bw->buffer[byte] |= mask;
+    }
+    ++bw->bits;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Reads @p nbits into @p value
+ *
+ * @return false if the end of the buffer is reached
+ */
+static inline bool BitRead(BitReader *br, uint32_t *value, uint8_t nbits) {
+  if (br->bits + nbits > br->size * 8) {
+    return false;
+  }
+
+  *value = 0;
+  for (int i = 0; i < nbits; i++) {
+    const size_t byte = br->bits / 8;
+    const uint8_t mask = 0x80 >> (br->bits % 8);
+    *value = (*value << 1) | ((br->buffer[byte] & mask) ? 1 : 0);
+    ++br->bits;
+  }
+
+  return true;
+}
+
+/** Number of bytes used by a BitWriter, rounded up to whole bytes */
+static inline size_t BitWriterBytes(const BitWriter *bw) {
+  return (bw->bits + 7) / 8;
+}
+
+/**
+ * @brief Writes @p value as a base 128 varint
+ *
+ * @return Number of bytes written, 0 if @p size is too small
+ */
+static inline size_t VarintWrite(size_t value, uint8_t *buffer, size_t size) {
+  size_t len = 0;
+  do {
+    if (len >= size) {
+      return 0;
+    }
+    uint8_t b = value & 0x7F;
+    value >>= 7;
+    if (value > 0) {
+      b |= 0x80;
+    }
+    buffer[len++] = b;
+  } while (value > 0);
+
+  return len;
+}
+
+/**
+ * @brief Reads a base 128 varint into @p value
+ *
+ * @return Number of bytes read, 0 if the varint is truncated or too long
+ */
+static inline size_t VarintRead(const uint8_t *data, size_t length,
+                                size_t *value) {
+  size_t len = 0;
+  uint8_t shift = 0;
+  *value = 0;
+  for (;;) {
+    if (len >= length || shift >= 32) {
+      return 0;
+    }
+    const uint8_t b = data[len++];
+    *value |= (size_t)(b & 0x7F) << shift;
+    shift += 7;
+    if ((b & 0x80) == 0) {
+      return len;
+    }
+  }
+}
+
+#endif  // LIB_COMPRESS_SRC_BITSTREAM_H_
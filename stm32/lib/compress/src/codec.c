@@ -0,0 +1,212 @@
+/**
+ * @file codec.c
+ * @brief See codec.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "codec.h"
+
+#include <string.h>
+
+#include "delta.h"
+#include "lz77.h"
+#include "rle.h"
+
+/**
+ * @brief Order codecs are tried in, cheapest first
+ */
+static const CodecId codec_order[] = {
+    CODEC_NONE, CODEC_RLE, CODEC_DELTA, CODEC_LZ77, CODEC_LZ77_DICT,
+};
+
+/** Holds candidate output while searching for the smallest */
+static uint8_t scratch[CODEC_MAX_PAYLOAD + CODEC_HEADER_SIZE];
+
+bool CodecAvailable(CodecId id) {
+  switch (id) {
+    case CODEC_NONE:
+      return true;
+#ifndef COMPRESS_DISABLE_RLE
+    case CODEC_RLE:
+      return true;
+#endif
+#ifndef COMPRESS_DISABLE_DELTA
+    case CODEC_DELTA:
+      return true;
+#endif
+#ifndef COMPRESS_DISABLE_LZ77
+    case CODEC_LZ77:
+      return true;
+#ifndef COMPRESS_DISABLE_LZ77_DICT
+    case CODEC_LZ77_DICT:
+      return true;
+#endif
+#endif
+    default:
+      return false;
+  }
+}
+
+uint32_t CodecCost(CodecId id, size_t length) {
+  switch (id) {
+    case CODEC_NONE:
+      return 2 * length;
+    case CODEC_RLE:
+      return 16 * length;
+    case CODEC_DELTA:
+      // stride search dominates
+      return (DELTA_MAX_STRIDE * 6 + 24) * length;
+    case CODEC_LZ77:
+      // every position searches on average half the payload
+      return 8 * length * (length / 2 + 1);
+#if !defined(COMPRESS_DISABLE_LZ77) && !defined(COMPRESS_DISABLE_LZ77_DICT)
+    case CODEC_LZ77_DICT:
+      return 8 * length * (length / 2 + lz77_dict.len);
+#endif
+    default:
+      return 0;
+  }
+}
+
+CompressStatus CodecEncode(CodecId id, const uint8_t *data, size_t length,
+                           uint8_t *buffer, size_t size, size_t *out_len) {
+  if (!CodecAvailable(id)) {
+    return COMPRESS_ERROR;
+  }
+  if (size < CODEC_HEADER_SIZE) {
+    return COMPRESS_OVERFLOW;
+  }
+
+  buffer[0] = (uint8_t)id;
+  uint8_t *out = buffer + CODEC_HEADER_SIZE;
+  size -= CODEC_HEADER_SIZE;
+
+  CompressStatus status = COMPRESS_ERROR;
+  size_t len = 0;
+
+  switch (id) {
+    case CODEC_NONE:
+      if (length > size) {
+        return COMPRESS_OVERFLOW;
+      }
+      memcpy(out, data, length);
+      len = length;
+      status = COMPRESS_OK;
+      break;
+#ifndef COMPRESS_DISABLE_RLE
+    case CODEC_RLE:
+      status = RLEEncode(data, length, out, size, &len);
+      break;
+#endif
+#ifndef COMPRESS_DISABLE_DELTA
+    case CODEC_DELTA:
+      status = DeltaEncode(data, length, out, size, &len);
+      break;
+#endif
+#ifndef COMPRESS_DISABLE_LZ77
+    case CODEC_LZ77:
+      status = LZ77Encode(data, length, NULL, out, size, &len);
+      break;
+#ifndef COMPRESS_DISABLE_LZ77_DICT
+    case CODEC_LZ77_DICT:
+      status = LZ77Encode(data, length, &lz77_dict, out, size, &len);
+      break;
+#endif
+#endif
+    default:
+      break;
+  }
+
+  if (status == COMPRESS_OK) {
+    *out_len = len + CODEC_HEADER_SIZE;
+  }
+
+  return status;
+}
+
+CompressStatus CodecCompress(const uint8_t *data, size_t length,
+                             uint32_t budget, uint8_t *buffer, size_t size,
+                             size_t *out_len, CodecId *selected) {
+  if (length > CODEC_MAX_PAYLOAD) {
+    return COMPRESS_ERROR;
+  }
+
+  // always fits if the payload can be sent uncompressed
+  CompressStatus status =
+      CodecEncode(CODEC_NONE, data, length, buffer, size, out_len);
+  if (status != COMPRESS_OK) {
+    return status;
+  }
+
+  CodecId best = CODEC_NONE;
+  uint32_t spent = CodecCost(CODEC_NONE, length);
+
+  for (size_t i = 1; i < sizeof(codec_order) / sizeof(codec_order[0]); i++) {
+    const CodecId id = codec_order[i];
+    if (!CodecAvailable(id)) {
+      continue;
+    }
+
+    const uint32_t cost = CodecCost(id, length);
+    if (budget != CODEC_BUDGET_UNLIMITED && spent + cost > budget) {
+      continue;
+    }
+    spent += cost;
+
+    // only output smaller than the current best is useful, stops encoding
+    // early otherwise
+    size_t len = 0;
+    if (CodecEncode(id, data, length, scratch, *out_len - 1, &len) ==
+        COMPRESS_OK) {
+      memcpy(buffer, scratch, len);
+      *out_len = len;
+      best = id;
+    }
+  }
+
+  if (selected != NULL) {
+    *selected = best;
+  }
+
+  return COMPRESS_OK;
+}
+
+CompressStatus CodecDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len) {
+  if (length < CODEC_HEADER_SIZE) {
+    return COMPRESS_CORRUPT;
+  }
+
+  const CodecId id = (CodecId)data[0];
+  const uint8_t *in = data + CODEC_HEADER_SIZE;
+  length -= CODEC_HEADER_SIZE;
+
+  switch (id) {
+    case CODEC_NONE:
+      if (length > size) {
+        return COMPRESS_OVERFLOW;
+      }
+      memcpy(buffer, in, length);
+      *out_len = length;
+      return COMPRESS_OK;
+#ifndef COMPRESS_DISABLE_RLE
+    case CODEC_RLE:
+      return RLEDecode(in, length, buffer, size, out_len);
+#endif
+#ifndef COMPRESS_DISABLE_DELTA
+    case CODEC_DELTA:
+      return DeltaDecode(in, length, buffer, size, out_len);
+#endif
+#ifndef COMPRESS_DISABLE_LZ77
+    case CODEC_LZ77:
+      return LZ77Decode(in, length, NULL, buffer, size, out_len);
+#ifndef COMPRESS_DISABLE_LZ77_DICT
+    case CODEC_LZ77_DICT:
+      return LZ77Decode(in, length, &lz77_dict, buffer, size, out_len);
+#endif
+#endif
+    default:
+      return COMPRESS_CORRUPT;
+  }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file delta.c
+ * @brief See delta.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "delta.h"
+
+#include "bitstream.h"
+
+/**
+ * @brief Byte @p i of the delta stream for a given stride
+ */
+static inline uint8_t DeltaAt(const uint8_t *data, size_t i, size_t stride) {
+  return (i < stride) ? data[i] : data[i] ^ data[i - stride];
+}
+
+/**
+ * @brief Picks the stride producing the most zero bytes
+ *
+ * Ties go to the smallest stride.
+ *
+ * @return Stride between 1 and DELTA_MAX_STRIDE
+ */
+static size_t BestStride(const uint8_t *data, size_t length) {
+  size_t best_stride = 1;
+  size_t best_zeros = 0;
+
+  for (size_t stride = 1; stride <= DELTA_MAX_STRIDE && stride < length;
+       stride++) {
+    size_t zeros = 0;
+    for (size_t i = 0; i < length; i++) {
+      zeros += DeltaAt(data, i, stride) == 0;
+    }
+    if (zeros > best_zeros) {
+      best_zeros = zeros;
+      best_stride = stride;
+    }
+  }
+
+  return best_stride;
+}
+
+CompressStatus DeltaEncode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len) {
+  if (data == NULL && length > 0) {
+    return COMPRESS_ERROR;
+  }
+
+  if (size < 1) {
+    return COMPRESS_OVERFLOW;
+  }
+
+  const size_t stride = BestStride(data, length);
+  size_t out = 0;
+  buffer[out++] = (uint8_t)stride;
+
+  size_t in = 0;
+  while (in < length) {
+    size_t zeros = 0;
+    while (in + zeros < length && DeltaAt(data, in + zeros, stride) == 0) {
+      ++zeros;
+    }
+    size_t lit = 0;
+    while (in + zeros + lit < length &&
+           DeltaAt(data, in + zeros + lit, stride) != 0) {
+      ++lit;
+    }
+
+    size_t n = VarintWrite(zeros, buffer + out, size - out);
+    if (n == 0) {
+      return COMPRESS_OVERFLOW;
+    }
+    out += n;
+
+    n = VarintWrite(lit, buffer + out, size - out);
+    if (n == 0 || out + n + lit > size) {
+      return COMPRESS_OVERFLOW;
+    }
+    out += n;
+
+    in += zeros;
+    for (size_t i = 0; i < lit; i++) {
+      buffer[out++] = DeltaAt(data, in++, stride);
+    }
+  }
+
+  *out_len = out;
+
+  return COMPRESS_OK;
+}
+
+CompressStatus DeltaDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                           size_t size, size_t *out_len) {
+  if (length < 1) {
+    return COMPRESS_CORRUPT;
+  }
+
+  const size_t stride = data[0];
+  if (stride < 1 || stride > DELTA_MAX_STRIDE) {
+    return COMPRESS_CORRUPT;
+  }
+
+  size_t in = 1;
+  size_t out = 0;
+  while (in < length) {
+    size_t zeros = 0;
+    size_t lit = 0;
+    size_t n = VarintRead(data + in, length - in, &zeros);
+    if (n == 0) {
+      return COMPRESS_CORRUPT;
+    }
+    in += n;
+    n = VarintRead(data + in, length - in, &lit);
+    if (n == 0 || in + n + lit > length) {
+      return COMPRESS_CORRUPT;
+    }
+    in += n;
+
+    if (out + zeros + lit > size) {
+      return COMPRESS_OVERFLOW;
+    }
+
+    // undo the delta, a zero delta repeats the byte one stride back
+    for (size_t i = 0; i < zeros + lit; i++) {
+      const uint8_t d = (i < zeros) ? 0 : data[in++];
+      buffer[out] = (out < stride) ? d : d ^ buffer[out - stride];
+      ++out;
+    }
+  }
+
+  *out_len = out;
+
+  return COMPRESS_OK;
+}
@@ -1,37 +1,94 @@
+/**
+ * @file dict.c
+ * @brief See dict.h
+ *
+ * @author Steve Taylor <stevegtaylor@pm.me>
+ * @date 2025-04-01
+ */
+
 #include "dict.h"
 
-#include <stdio.h>
+#include <string.h>
 
-// Global dictionary variable
-static DictEntry *dictionary = NULL;
+/**
+ * @brief Hashes a (parent, byte) pair into a slot of the lookup table
+ *
+ * Multiplicative hashing, the upper bits of the product are the best mixed.
+ *
+ * @param parent Code of the parent phrase
+ * @param byte Byte extending the parent phrase
+ *
+ * @return Slot index
+ */
+static inline uint16_t DictHash(uint16_t parent, uint8_t byte) {
+  const uint32_t key = ((uint32_t)parent << 8) | byte;
+  return (uint16_t)((key * 2654435761u) >> 16) & (DICT_HASH_SIZE - 1);
+}
 
-// Initialize the dictionary (optional, uthash initializes on first use)
-void dict_init() { dictionary = NULL; }
+void DictInit(Dict *dict) {
+  memset(dict->table, 0, sizeof(dict->table));
+  dict->count = 0;
+}
 
-// Add an entry to the dictionary
-void dict_add(const char *key, int value) {
-  DictEntry *entry = malloc(sizeof(DictEntry));
-  if (!entry) {
-    fprintf(stderr, "Memory allocation failed\n");
-    return;
+int DictFind(const Dict *dict, uint16_t parent, uint8_t byte) {
+  uint16_t slot = DictHash(parent, byte);
+
+  // linear probe until an empty slot, the table is never full
+  for (uint16_t code = dict->table[slot]; code != 0;
+       code = dict->table[slot]) {
+    if (dict->parent[code] == parent && dict->byte[code] == byte) {
+      return code;
+    }
+    slot = (slot + 1) & (DICT_HASH_SIZE - 1);
   }
-  strcpy(entry->key, key);
-  entry->value = value;
-  HASH_ADD_STR(dictionary, key, entry);
+
+  return DICT_NOT_FOUND;
 }
 
-// Search for an entry in the dictionary by key
-int dict_search(const char *key) {
-  DictEntry *entry;
-  HASH_FIND_STR(dictionary, key, entry);
-  return entry ? entry->value : -1;  // Return -1 if not found
+int DictAdd(Dict *dict, uint16_t parent, uint8_t byte) {
+  if (dict->count >= DICT_MAX_ENTRIES || parent > dict->count) {
+    return DICT_NOT_FOUND;
+  }
+
+  const uint16_t code = ++dict->count;
+  dict->parent[code] = parent;
+  dict->byte[code] = byte;
+
+  uint16_t slot = DictHash(parent, byte);
+  while (dict->table[slot] != 0) {
+    slot = (slot + 1) & (DICT_HASH_SIZE - 1);
+  }
+  dict->table[slot] = code;
+
+  return code;
 }
 
-// Free all dictionary entries
-void dict_free() {
-  DictEntry *entry, *tmp;
-  HASH_ITER(hh, dictionary, entry, tmp) {
-    HASH_DEL(dictionary, entry);
-    free(entry);
+size_t DictPhraseLen(const Dict *dict, uint16_t code) {
+  if (code > dict->count) {
+    return 0;
   }
+
+  size_t len = 0;
+  // parents always have a lower code so the walk terminates at the root
+  for (; code != DICT_ROOT; code = dict->parent[code]) {
+    ++len;
+  }
+
+  return len;
+}
+
+size_t DictPhrase(const Dict *dict, uint16_t code, uint8_t *buffer,
+                  size_t size) {
+  const size_t len = DictPhraseLen(dict, code);
+  if (len > size) {
+    return 0;
+  }
+
+  // the trie is walked from the leaf so fill the buffer backwards
+  for (size_t i = len; i > 0; i--) {
+    buffer[i - 1] = dict->byte[code];
+    code = dict->parent[code];
+  }
+
+  return len;
 }
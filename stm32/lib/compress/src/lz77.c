@@ -0,0 +1,207 @@
+/**
+ * @file lz77.c
+ * @brief Provides definitions for LZ77 serialized message compression.
+ *
+ * Assumes the messages passed have already been serailized via protobuf
+ *
+ * @author Steve Taylor <stevegtaylor@pm.me>
+ * @date 2025-04-01
+ */
+
+#include "lz77.h"
+
+#include "bitstream.h"
+
+/**
+ * @brief Read only view of the window, dictionary followed by data
+ *
+ * Avoids copying the dictionary into RAM.
+ */
+typedef struct {
+  const uint8_t *dict;
+  size_t dict_len;
+  const uint8_t *data;
+} Window;
+
+/**
+ * @brief Byte at position @p pos of the window
+ */
+static inline uint8_t WindowAt(const Window *w, size_t pos) {
+  return (pos < w->dict_len) ? w->dict[pos] : w->data[pos - w->dict_len];
+}
+
+/**
+ * @brief Finds the longest match for the lookahead at @p cur
+ *
+ * Candidates are searched from the closest so the first longest match found
+ * has the smallest distance.
+ *
+ * @param w Window
+ * @param cur Position of the lookahead in the window
+ * @param end Length of the window
+ * @param dist Distance to the best match
+ *
+ * @return Length of the best match
+ */
+static size_t LongestMatch(const Window *w, size_t cur, size_t end,
+                           size_t *dist) {
+  size_t best_len = 0;
+  size_t max_len = end - cur;
+  if (max_len > LZ77_MAX_MATCH) {
+    max_len = LZ77_MAX_MATCH;
+  }
+  const size_t max_dist = (cur < LZ77_WINDOW_SIZE) ? cur : LZ77_WINDOW_SIZE;
+
+  const uint8_t first = WindowAt(w, cur);
+  for (size_t d = 1; d <= max_dist; d++) {
+    const size_t start = cur - d;
+    if (WindowAt(w, start) != first) {
+      continue;
+    }
+
+    size_t len = 1;
+    while (len < max_len &&
+           WindowAt(w, start + len) == WindowAt(w, cur + len)) {
+      ++len;
+    }
+
+    if (len > best_len) {
+      best_len = len;
+      *dist = d;
+      if (len == max_len) {
+        break;
+      }
+    }
+  }
+
+  return best_len;
+}
+
+CompressStatus LZ77Encode(const uint8_t *data, size_t length,
+                          const LZ77Dict *dict, uint8_t *buffer, size_t size,
+                          size_t *out_len) {
+  if ((data == NULL && length > 0) ||
+      (dict != NULL &&
+       (dict->id == LZ77_DICT_NONE || dict->len > LZ77_MAX_DICT_SIZE))) {
+    return COMPRESS_ERROR;
+  }
+
+  if (size < 1) {
+    return COMPRESS_OVERFLOW;
+  }
+  buffer[0] = (dict != NULL) ? dict->id : LZ77_DICT_NONE;
+
+  const size_t varint_len = VarintWrite(length, buffer + 1, size - 1);
+  if (varint_len == 0) {
+    return COMPRESS_OVERFLOW;
+  }
+  const size_t header_len = 1 + varint_len;
+
+  const Window w = {
+      .dict = (dict != NULL) ? dict->data : NULL,
+      .dict_len = (dict != NULL) ? dict->len : 0,
+      .data = data,
+  };
+
+  BitWriter bw = {buffer + header_len, size - header_len, 0};
+
+  const size_t end = w.dict_len + length;
+  size_t cur = w.dict_len;
+  while (cur < end) {
+    size_t dist = 0;
+    const size_t len = LongestMatch(&w, cur, end, &dist);
+
+    bool ok;
+    if (len >= LZ77_MIN_MATCH) {
+      ok = BitWrite(&bw, 1, 1) &&
+           BitWrite(&bw, dist - 1, LZ77_DISTANCE_BITS) &&
+           BitWrite(&bw, len - LZ77_MIN_MATCH, LZ77_LENGTH_BITS);
+      cur += len;
+    } else {
+      ok = BitWrite(&bw, 0, 1) && BitWrite(&bw, WindowAt(&w, cur), 8);
+      ++cur;
+    }
+
+    if (!ok) {
+      return COMPRESS_OVERFLOW;
+    }
+  }
+
+  *out_len = header_len + BitWriterBytes(&bw);
+
+  return COMPRESS_OK;
+}
+
+CompressStatus LZ77Decode(const uint8_t *data, size_t length,
+                          const LZ77Dict *dict, uint8_t *buffer, size_t size,
+                          size_t *out_len) {
+  if (length < 1) {
+    return COMPRESS_CORRUPT;
+  }
+
+  // stream must have been encoded with the same dictionary
+  const uint8_t dict_id = (dict != NULL) ? dict->id : LZ77_DICT_NONE;
+  if (data[0] != dict_id) {
+    return COMPRESS_CORRUPT;
+  }
+
+  size_t expected = 0;
+  const size_t varint_len = VarintRead(data + 1, length - 1, &expected);
+  if (varint_len == 0) {
+    return COMPRESS_CORRUPT;
+  }
+  const size_t header_len = 1 + varint_len;
+
+  if (expected > size) {
+    return COMPRESS_OVERFLOW;
+  }
+
+  // output is the data part of the window
+  const Window w = {
+      .dict = (dict != NULL) ? dict->data : NULL,
+      .dict_len = (dict != NULL) ? dict->len : 0,
+      .data = buffer,
+  };
+
+  BitReader br = {data + header_len, length - header_len, 0};
+
+  size_t written = 0;
+  while (written < expected) {
+    uint32_t flag = 0;
+    if (!BitRead(&br, &flag, 1)) {
+      return COMPRESS_CORRUPT;
+    }
+
+    if (flag) {
+      uint32_t dist = 0;
+      uint32_t len = 0;
+      if (!BitRead(&br, &dist, LZ77_DISTANCE_BITS) ||
+          !BitRead(&br, &len, LZ77_LENGTH_BITS)) {
+        return COMPRESS_CORRUPT;
+      }
+      dist += 1;
+      len += LZ77_MIN_MATCH;
+
+      const size_t cur = w.dict_len + written;
+      if (dist > cur || written + len > expected) {
+        return COMPRESS_CORRUPT;
+      }
+
+      // byte by byte since the match may overlap the output
+      for (size_t i = 0; i < len; i++) {
+        buffer[written + i] = WindowAt(&w, cur - dist + i);
+      }
+      written += len;
+    } else {
+      uint32_t byte = 0;
+      if (!BitRead(&br, &byte, 8)) {
+        return COMPRESS_CORRUPT;
+      }
+      buffer[written++] = (uint8_t)byte;
+    }
+  }
+
+  *out_len = written;
+
+  return COMPRESS_OK;
+}
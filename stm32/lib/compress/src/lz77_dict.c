@@ -0,0 +1,44 @@
+/**
+ * @file lz77_dict.c
+ * @brief Static dictionary used to prime LZ77
+ *
+ * Generated by extras/compression/train_dict.py, do not edit. The same
+ * dictionary is in python/src/ents/compress/dictionary.py.
+ */
+
+#include "lz77.h"
+
+static const uint8_t lz77_dict_data[304] = {
+    0x0a, 0x0a, 0x08, 0x01, 0x10, 0x01, 0x18, 0xc1, 0xb0, 0xff, 0xbf, 0x06,
+    0x12, 0x09, 0x19, 0x91, 0x0a, 0x0a, 0x08, 0x01, 0x10, 0x01, 0x18, 0x87,
+    0xad, 0xff, 0xbf, 0x06, 0x12, 0x09, 0x19, 0x91, 0x0a, 0x0a, 0x08, 0x01,
+    0x10, 0x01, 0x18, 0xc9, 0xe0, 0xe0, 0xbf, 0x06, 0x12, 0x09, 0x19, 0x91,
+    0x0a, 0x0a, 0x08, 0x04, 0x10, 0x07, 0x18, 0xf0, 0xab, 0xe3, 0xac, 0x05,
+    0x12, 0x12, 0x11, 0x00, 0x81, 0x25, 0xc9, 0xf7, 0x3f, 0xeb, 0x3f, 0x19,
+    0xea, 0x98, 0x9c, 0x0c, 0x78, 0x37, 0x48, 0x3f, 0x48, 0x5a, 0x8f, 0xe7,
+    0x3f, 0x19, 0x80, 0x16, 0x06, 0xff, 0xaf, 0x1c, 0x47, 0x3f, 0x0a, 0x0a,
+    0x37, 0xef, 0xc6, 0xe3, 0x3f, 0x19, 0x97, 0xc0, 0x87, 0x39, 0x8e, 0xea,
+    0x45, 0x3f, 0x0a, 0x0a, 0xfa, 0x11, 0xd5, 0xdf, 0x3f, 0x19, 0xad, 0x55,
+    0x4a, 0x06, 0x48, 0xa2, 0x44, 0x3f, 0x0a, 0x0a, 0x65, 0x1c, 0xfc, 0xd7,
+    0x3f, 0x19, 0x82, 0xab, 0x5c, 0x0e, 0x29, 0x45, 0x43, 0x3f, 0x0a, 0x0a,
+    0x5d, 0xeb, 0x0a, 0xd0, 0x3f, 0x19, 0x9b, 0xd3, 0x9e, 0x0a, 0x92, 0xd4,
+    0x41, 0x3f, 0x0a, 0x0a, 0x12, 0x12, 0x11, 0x9d, 0x81, 0x25, 0xc9, 0xf7,
+    0x3f, 0xeb, 0x3f, 0x19, 0xea, 0x98, 0x9c, 0x0c, 0x12, 0x12, 0x11, 0x18,
+    0xa9, 0xa8, 0x48, 0x5a, 0x8f, 0xe7, 0x3f, 0x19, 0x80, 0x16, 0x06, 0xff,
+    0x12, 0x12, 0x11, 0x4f, 0xe9, 0x2f, 0x37, 0xef, 0xc6, 0xe3, 0x3f, 0x19,
+    0x97, 0xc0, 0x87, 0x39, 0x12, 0x12, 0x11, 0x96, 0x07, 0x1c, 0xfa, 0x11,
+    0xd5, 0xdf, 0x3f, 0x19, 0xad, 0x55, 0x4a, 0x06, 0x12, 0x12, 0x11, 0xe0,
+    0x5b, 0xa1, 0x5d, 0xeb, 0x0a, 0xd0, 0x3f, 0x19, 0x9b, 0xd3, 0x9e, 0x0a,
+    0x12, 0x12, 0x11, 0x78, 0x7a, 0x03, 0x65, 0x1c, 0xfc, 0xd7, 0x3f, 0x19,
+    0x82, 0xab, 0x5c, 0x0e, 0x19, 0x99, 0xd0, 0x65, 0x5f, 0xf7, 0x51, 0x40,
+    0x3f, 0x0a, 0x0a, 0x08, 0x01, 0x10, 0x01, 0x18, 0xbf, 0x06, 0x12, 0x12,
+    0x11, 0x79, 0x93, 0xe0, 0x1b, 0x0a, 0x13, 0xc0, 0x3f, 0x19, 0x99, 0xd0,
+    0xff, 0xbf, 0x06, 0x12, 0x09, 0x19, 0x91, 0xcb, 0x7f, 0x48, 0xbf, 0x7d,
+    0x3d, 0x3f, 0x0a, 0x0a,
+};
+
+const LZ77Dict lz77_dict = {
+    .id = 1,
+    .data = lz77_dict_data,
+    .len = sizeof(lz77_dict_data),
+};
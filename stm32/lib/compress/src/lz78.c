@@ -10,7 +10,131 @@
 
 #include "lz78.h"
 
-void LZ78_encode(const uint8_t *data, size_t length) {
-  for (int i = 0; i < length; i++) {
+#include "bitstream.h"
+
+/** Dictionary shared between the encoder and decoder */
+static Dict dict;
+
+/**
+ * @brief Number of bits needed to store any code in the dictionary
+ *
+ * @param count Number of phrases in the dictionary
+ *
+ * @return Code width in bits
+ */
+static uint8_t CodeWidth(uint16_t count) {
+  uint8_t width = 0;
+  while (count > 0) {
+    ++width;
+    count >>= 1;
+  }
+  return width;
+}
+
+/**
+ * @brief Emits a (code, byte) token and adds the phrase to the dictionary
+ *
+ * The code width is based on the dictionary size before the phrase is added,
+ * matching the state of the decoder when it reads the token.
+ */
+static bool EmitToken(BitWriter *bw, uint16_t code, uint8_t byte) {
+  if (!BitWrite(bw, code, CodeWidth(dict.count))) {
+    return false;
+  }
+  if (!BitWrite(bw, byte, 8)) {
+    return false;
+  }
+
+  // fails silently once the dictionary is full
+  DictAdd(&dict, code, byte);
+
+  return true;
+}
+
+CompressStatus LZ78Encode(const uint8_t *data, size_t length, uint8_t *buffer,
+                          size_t size, size_t *out_len) {
+  if (data == NULL && length > 0) {
+    return COMPRESS_ERROR;
   }
-}
\ No newline at end of file
+
+  DictInit(&dict);
+
+  // uncompressed length as varint
+  const size_t header_len = VarintWrite(length, buffer, size);
+  if (header_len == 0) {
+    return COMPRESS_OVERFLOW;
+  }
+
+  BitWriter bw = {buffer + header_len, size - header_len, 0};
+
+  uint16_t cur = DICT_ROOT;
+  for (size_t i = 0; i < length; i++) {
+    const int next = DictFind(&dict, cur, data[i]);
+    if (next != DICT_NOT_FOUND) {
+      // keep extending the current phrase
+      cur = (uint16_t)next;
+      continue;
+    }
+
+    if (!EmitToken(&bw, cur, data[i])) {
+      return COMPRESS_OVERFLOW;
+    }
+    cur = DICT_ROOT;
+  }
+
+  // flush a trailing phrase that is already in the dictionary
+  if (cur != DICT_ROOT) {
+    if (!EmitToken(&bw, dict.parent[cur], dict.byte[cur])) {
+      return COMPRESS_OVERFLOW;
+    }
+  }
+
+  *out_len = header_len + BitWriterBytes(&bw);
+
+  return COMPRESS_OK;
+}
+
+CompressStatus LZ78Decode(const uint8_t *data, size_t length, uint8_t *buffer,
+                          size_t size, size_t *out_len) {
+  DictInit(&dict);
+
+  // uncompressed length
+  size_t expected = 0;
+  const size_t header_len = VarintRead(data, length, &expected);
+  if (header_len == 0) {
+    return COMPRESS_CORRUPT;
+  }
+
+  if (expected > size) {
+    return COMPRESS_OVERFLOW;
+  }
+
+  BitReader br = {data + header_len, length - header_len, 0};
+
+  size_t written = 0;
+  while (written < expected) {
+    uint32_t code = 0;
+    uint32_t byte = 0;
+    if (!BitRead(&br, &code, CodeWidth(dict.count)) ||
+        !BitRead(&br, &byte, 8)) {
+      return COMPRESS_CORRUPT;
+    }
+    if (code > dict.count) {
+      return COMPRESS_CORRUPT;
+    }
+
+    const size_t phrase_len = DictPhraseLen(&dict, code);
+    if (written + phrase_len + 1 > expected) {
+      return COMPRESS_CORRUPT;
+    }
+    DictPhrase(&dict, code, buffer + written, phrase_len);
+    written += phrase_len;
+    buffer[written++] = (uint8_t)byte;
+
+    DictAdd(&dict, code, byte);
+  }
+
+  *out_len = written;
+
+  return COMPRESS_OK;
+}
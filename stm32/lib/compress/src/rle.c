@@ -0,0 +1,99 @@
+/**
+ * @file rle.c
+ * @brief See rle.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "rle.h"
+
+#include <string.h>
+
+/**
+ * @brief Length of the run of identical bytes starting at @p data
+ *
+ * @return Run length capped at RLE_MAX_RUN
+ */
+static size_t RunLength(const uint8_t *data, size_t length) {
+  size_t run = 1;
+  while (run < length && run < RLE_MAX_RUN && data[run] == data[0]) {
+    ++run;
+  }
+  return run;
+}
+
+CompressStatus RLEEncode(const uint8_t *data, size_t length, uint8_t *buffer,
+                         size_t size, size_t *out_len) {
+  if (data == NULL && length > 0) {
+    return COMPRESS_ERROR;
+  }
+
+  size_t in = 0;
+  size_t out = 0;
+  while (in < length) {
+    const size_t run = RunLength(data + in, length - in);
+    if (run >= RLE_MIN_RUN) {
+      if (out + 2 > size) {
+        return COMPRESS_OVERFLOW;
+      }
+      buffer[out++] = 0x80 | (uint8_t)(run - RLE_MIN_RUN);
+      buffer[out++] = data[in];
+      in += run;
+      continue;
+    }
+
+    // collect literals until the next run worth encoding
+    size_t lit = run;
+    while (in + lit < length && lit < RLE_MAX_LITERAL &&
+           RunLength(data + in + lit, length - in - lit) < RLE_MIN_RUN) {
+      ++lit;
+    }
+
+    if (out + 1 + lit > size) {
+      return COMPRESS_OVERFLOW;
+    }
+    buffer[out++] = (uint8_t)(lit - 1);
+    memcpy(buffer + out, data + in, lit);
+    out += lit;
+    in += lit;
+  }
+
+  *out_len = out;
+
+  return COMPRESS_OK;
+}
+
+CompressStatus RLEDecode(const uint8_t *data, size_t length, uint8_t *buffer,
+                         size_t size, size_t *out_len) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < length) {
+    const uint8_t ctrl = data[in++];
+    if (ctrl & 0x80) {
+      const size_t run = (ctrl & 0x7F) + RLE_MIN_RUN;
+      if (in >= length) {
+        return COMPRESS_CORRUPT;
+      }
+      if (out + run > size) {
+        return COMPRESS_OVERFLOW;
+      }
+      memset(buffer + out, data[in++], run);
+      out += run;
+    } else {
+      const size_t lit = ctrl + 1;
+      if (in + lit > length) {
+        return COMPRESS_CORRUPT;
+      }
+      if (out + lit > size) {
+        return COMPRESS_OVERFLOW;
+      }
+      memcpy(buffer + out, data + in, lit);
+      in += lit;
+      out += lit;
+    }
+  }
+
+  *out_len = out;
+
+  return COMPRESS_OK;
+}
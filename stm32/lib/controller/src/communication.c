@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE CONTROLLER
+
 #include "communication.h"
 
 #include <stdlib.h>
@@ -5,6 +7,7 @@
 
 #include "controller/controller.h"
 #include "i2c.h"
+#include "prof.h"
 #include "sys_app.h"  // APP_LOG
 
 /** Global timeout for i2c communication with esp32 */
@@ -178,6 +181,8 @@ ControllerStatus ControllerReceive(unsigned int timeout) {
 }
 
 ControllerStatus ControllerTransaction(unsigned int timeout) {
+  PROF_SCOPE("ctrl_txn");
+
   // status code
   ControllerStatus status = CONTROLLER_SUCCESS;
 
@@ -3,9 +3,12 @@
 #include <stdlib.h>
 
 #include "communication.h"
+#include "lowpower.h"
 #include "main.h"
 #include "soil_power_sensor.pb.h"
+#include "stm32_lpm.h"
 #include "tca9535.h"
+#include "utilities_def.h"
 
 void ControllerInit(void) {
   const size_t buffer_size = Esp32Command_size;
@@ -51,25 +54,30 @@ void ControllerWakeup(void) {
   TCA9535WritePin(TCA9535_WAKEUP_PORT, TCA9535_WAKEUP_PIN, GPIO_PIN_SET);
   // HAL_GPIO_WritePin(ESP32_WAKEUP_GPIO_Port, ESP32_WAKEUP_Pin, GPIO_PIN_SET);
 
-  HAL_Delay(50);
+  LowPowerDelay(50);
 
   TCA9535WritePin(TCA9535_WAKEUP_PORT, TCA9535_WAKEUP_PIN, GPIO_PIN_RESET);
   // HAL_GPIO_WritePin(ESP32_WAKEUP_GPIO_Port, ESP32_WAKEUP_Pin,
   // GPIO_PIN_RESET);
 
-  HAL_Delay(50);
+  LowPowerDelay(50);
 }
 
 void ControllerDeviceEnable(void) {
+  // Waking from Stop2 runs MX_GPIO_Init, which pulls ESP32_EN low
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_ESP32_Id), UTIL_LPM_DISABLE);
+
   HAL_GPIO_WritePin(ESP32_EN_GPIO_Port, ESP32_EN_Pin, GPIO_PIN_SET);
 
   // A delay is necessary to give the ESP32 enough time to initialize.
   // Not recommended to go below 500 ms. ESP32 may fail to receive a
   // subsequent command when there is <500 ms delay between ESP32_EN
   // being enabled and the next I2C transaction with the ESP32.
-  HAL_Delay(500);
+  LowPowerDelay(500);
 }
 
 void ControllerDeviceDisable(void) {
   HAL_GPIO_WritePin(ESP32_EN_GPIO_Port, ESP32_EN_Pin, GPIO_PIN_RESET);
+
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_ESP32_Id), UTIL_LPM_ENABLE);
 }
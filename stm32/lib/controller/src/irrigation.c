@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE CONTROLLER
+
 #include "controller/irrigation.h"
 
 #include "communication.h"
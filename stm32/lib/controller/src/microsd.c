@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE MICROSD
+
 #include "controller/microsd.h"
 
 #include "communication.h"
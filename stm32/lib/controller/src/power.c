@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE CONTROLLER
+
 #include "communication.h"
 #include "controller/wifi.h"
 #include "sys_app.h"  // APP_LOG
@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE CONTROLLER
+
 #include "controller/wifi_userconfig.h"
 
 #include "communication.h"
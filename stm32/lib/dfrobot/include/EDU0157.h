@@ -12,13 +12,15 @@
  */
 #include <stddef.h>
 #include <stdint.h>
+
+#include "fixed.h"
 typedef struct {
-  float wind_speed;
+  q32_t wind_speed;
   int32_t wind_direction;
-  float altitude;
-  float pressure;
-  float temperature;
-  float humidity;
+  q32_t altitude;
+  q32_t pressure;
+  q32_t temperature;
+  q32_t humidity;
 } EDU0157Data;
 /*
 
@@ -11,6 +11,8 @@
  *
  */
 
+#define APP_LOG_MODULE DFROBOT
+
 #include "EDU0157.h"
 
 #include <stdint.h>
@@ -19,6 +21,7 @@
 #include <string.h>
 
 #include "i2c.h"
+#include "lowpower.h"
 #include "stm32wlxx_hal.h"
 #include "sys_app.h"
 
@@ -100,7 +103,7 @@ void EDU0157_delay_us(uint32_t period, void *intf_ptr) {
   }
 
   // delay
-  HAL_Delay(period_ms);
+  LowPowerDelay(period_ms);
 }
 
 int EDU0157_init(struct EDU0157_dev *dev) {
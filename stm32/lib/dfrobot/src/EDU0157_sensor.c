@@ -12,6 +12,8 @@
 
 #include "EDU0157_sensor.h"
 
+#include "parse.h"
+
 /**
  * @brief Required time between measurements
  *
@@ -62,14 +64,23 @@ int EDU0157MeasureAll(EDU0157Data *sensor_data) {
 
   char direction[4];
 
-  int ret = sscanf(value,
-                   "WindSpeed:%f m/s, WindDirection:%3[^,], Altitude:%f m, "
-                   "Pressure:%f hPa, Temp:%f C, Humi:%f %%RH",
-                   &sensor_data->wind_speed, direction, &sensor_data->altitude,
-                   &sensor_data->pressure, &sensor_data->temperature,
-                   &sensor_data->humidity);
-
-  if (ret != 6) return -1;
+  // same as "WindSpeed:%f m/s, WindDirection:%3[^,], Altitude:%f m, "
+  // "Pressure:%f hPa, Temp:%f C, Humi:%f %%RH"
+  const char *s = value;
+  if (!ParseLiteral(&s, "WindSpeed:") ||
+      !ParseFixed(&s, &sensor_data->wind_speed) ||
+      !ParseLiteral(&s, " m/s, WindDirection:") ||
+      !ParseToken(&s, ',', direction, sizeof(direction)) ||
+      !ParseLiteral(&s, ", Altitude:") ||
+      !ParseFixed(&s, &sensor_data->altitude) ||
+      !ParseLiteral(&s, " m, Pressure:") ||
+      !ParseFixed(&s, &sensor_data->pressure) ||
+      !ParseLiteral(&s, " hPa, Temp:") ||
+      !ParseFixed(&s, &sensor_data->temperature) ||
+      !ParseLiteral(&s, " C, Humi:") ||
+      !ParseFixed(&s, &sensor_data->humidity)) {
+    return -1;
+  }
 
   sensor_data->wind_direction = direction_to_int(direction);
 
@@ -95,7 +106,7 @@ size_t EDU0157Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
 
   // wind speed
   sen_status =
-      EncodeDoubleMeasurement(meta, sensor_data.wind_speed,
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sensor_data.wind_speed),
                               SensorType_EDU0157_WIND_SPEED, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
@@ -112,32 +123,36 @@ size_t EDU0157Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   SensorsAddMeasurement(data, data_len);
 
   // altitude
-  sen_status = EncodeDoubleMeasurement(
-      meta, sensor_data.altitude, SensorType_EDU0157_ALTITUDE, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sensor_data.altitude),
+                              SensorType_EDU0157_ALTITUDE, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
   SensorsAddMeasurement(data, data_len);
 
   // pressure
-  sen_status = EncodeDoubleMeasurement(
-      meta, sensor_data.pressure, SensorType_EDU0157_PRESSURE, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sensor_data.pressure),
+                              SensorType_EDU0157_PRESSURE, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
   SensorsAddMeasurement(data, data_len);
 
   // temp
-  sen_status = EncodeDoubleMeasurement(
-      meta, sensor_data.temperature, SensorType_EDU0157_TEMP, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sensor_data.temperature),
+                              SensorType_EDU0157_TEMP, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
   SensorsAddMeasurement(data, data_len);
 
   // relative humidity
-  sen_status = EncodeDoubleMeasurement(
-      meta, sensor_data.humidity, SensorType_EDU0157_HUMIDITY, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sensor_data.humidity),
+                              SensorType_EDU0157_HUMIDITY, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
@@ -0,0 +1,272 @@
+/**
+ * @file energy.h
+ * @brief Time spent in each task and low power state
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_ENERGY_INCLUDE_ENERGY_H_
+#define LIB_ENERGY_INCLUDE_ENERGY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @defgroup energy Energy accounting
+ * @brief Residency of the node and the energy it takes
+ *
+ * Wall time is charged to exactly one account at a time. Accounts below
+ * ENERGY_MAX_TASKS are sequencer tasks, by their CFG_SEQ_Task_* id. The
+ * others are the states in EnergyState. ENERGY_SCOPE charges the rest of a
+ * block to an account and returns to the previous account at its end, so a
+ * HAL_Delay inside a task is charged to ENERGY_WAIT and not to the task. The
+ * account that was waiting keeps the time it spent in ENERGY_WAIT in its wait
+ * field, so the energy of a measurement includes the settling time of its
+ * sensors. Waits in LowPowerDelay are charged to ENERGY_SLEEP or ENERGY_STOP
+ * and not to the wait field.
+ *
+ * The radio is tracked separately, since it transmits and receives while the
+ * mcu is in any state. Its time is charged to the state set by EnergyRadio.
+ *
+ * The time comes from a clock passed to EnergyInit, the RTC on the stm32 and
+ * a virtual clock in the host simulation of extras/energy. EnergyMicrojoules
+ * turns the time of an account into energy with the currents in
+ * EnergyCurrents.
+ *
+ * EnergySerialize writes the accounts as a blob, which sys_app.c logs
+ * periodically with BINLOG. ents energy decodes it from the log of the node
+ * and estimates the energy per measurement and per uplink.
+ *
+ * @{
+ */
+
+/** Number of accounts for sequencer tasks */
+#define ENERGY_MAX_TASKS 16
+
+/** Version of the blob */
+#define ENERGY_VERSION 1
+
+/** Bytes of the blob before the accounts */
+#define ENERGY_HEADER_SIZE 7
+
+/** Bytes of an account in the blob */
+#define ENERGY_ACCOUNT_SIZE 20
+
+/** Bytes of a radio state in the blob */
+#define ENERGY_RADIO_SIZE 12
+
+/** States of the mcu outside of tasks */
+typedef enum {
+  /** Awake outside of tasks, in the sequencer and interrupts */
+  ENERGY_RUN = ENERGY_MAX_TASKS,
+  /** Blocking waits such as HAL_Delay */
+  ENERGY_WAIT,
+  /** Sleep mode */
+  ENERGY_SLEEP,
+  /** Stop2 mode */
+  ENERGY_STOP,
+  /** Number of accounts */
+  ENERGY_ACCOUNTS,
+} EnergyState;
+
+/** States of the radio */
+typedef enum {
+  ENERGY_RADIO_OFF,
+  ENERGY_RADIO_RX,
+  ENERGY_RADIO_TX,
+  /** Number of radio states */
+  ENERGY_RADIO_STATES,
+} EnergyRadioState;
+
+/** Max size of the blob */
+#define ENERGY_BLOB_SIZE                                        \
+  (ENERGY_HEADER_SIZE + ENERGY_ACCOUNTS * ENERGY_ACCOUNT_SIZE + \
+   ENERGY_RADIO_STATES * ENERGY_RADIO_SIZE)
+
+/** Time and entries of an account */
+typedef struct {
+  /** Number of times the account was entered */
+  uint32_t count;
+  /** Time in ticks of the clock */
+  uint64_t ticks;
+  /** Time in ENERGY_WAIT entered from this account, in ticks */
+  uint64_t wait;
+} EnergyAccount;
+
+/**
+ * @brief Current draw of the board in each state
+ *
+ * Radio currents are added to the current of the mcu state.
+ */
+typedef struct {
+  /** Running a task, waiting or awake, in uA */
+  uint32_t run_ua;
+  /** Sleep mode in uA */
+  uint32_t sleep_ua;
+  /** Stop2 mode in uA */
+  uint32_t stop_ua;
+  /** Added while the radio receives, in uA */
+  uint32_t radio_rx_ua;
+  /** Added while the radio transmits, in uA */
+  uint32_t radio_tx_ua;
+  /** Supply voltage in mV */
+  uint32_t voltage_mv;
+} EnergyCurrents;
+
+/**
+ * @brief Currents measured in extras/power_consumption at 3.9 V
+ *
+ * Run is the measure range, sleep the idle range with LOW_POWER_DISABLE set
+ * and tx the comm range minus the idle range. Stop2 was not measured and is
+ * set to the idle range until it is. Rx is the radio receive current of the
+ * STM32WLE5 datasheet.
+ */
+#define ENERGY_CURRENTS_DEFAULT {11811, 4820, 4820, 5000, 100054, 3900}
+
+/** Time in ticks */
+typedef uint32_t (*EnergyClockFn)(void);
+
+/**
+ * @brief Charge the rest of the block to an account
+ *
+ * @param account Task id or EnergyState
+ */
+#define ENERGY_SCOPE(account)                                \
+  int ENERGY_CAT(energy_prev_, __LINE__)                     \
+      __attribute__((cleanup(EnergyScopeEnd), unused)) =     \
+          EnergyEnter(account)
+
+/** @cond INTERNAL */
+#define ENERGY_CAT(a, b) ENERGY_CAT_(a, b)
+#define ENERGY_CAT_(a, b) a##b
+/** @endcond */
+
+/**
+ * @brief Clear the accounts and start charging ENERGY_RUN
+ *
+ * @param clock Time source, wraps around at 2^32 ticks
+ * @param ticks_per_second Rate of the clock
+ */
+void EnergyInit(EnergyClockFn clock, uint32_t ticks_per_second);
+
+/**
+ * @brief Charge time to an account from now on
+ *
+ * @param account Task id or EnergyState
+ *
+ * @return Previous account, to pass to EnergyReturn
+ */
+int EnergyEnter(int account);
+
+/**
+ * @brief Charge time to a previous account without counting an entry
+ *
+ * @param account Return value of EnergyEnter
+ */
+void EnergyReturn(int account);
+
+/**
+ * @brief Set the state of the radio
+ *
+ * @param state New state, entries are counted when the state changes
+ */
+void EnergyRadio(EnergyRadioState state);
+
+/**
+ * @brief Time and entries of an account up to now
+ *
+ * @param account Task id or EnergyState
+ *
+ * @return NULL if the account is out of range
+ */
+const EnergyAccount *EnergyGet(int account);
+
+/**
+ * @brief Time and entries of a radio state up to now
+ *
+ * @param state Radio state
+ *
+ * @return NULL if the state is out of range
+ */
+const EnergyAccount *EnergyGetRadio(EnergyRadioState state);
+
+/**
+ * @brief Energy of an account
+ *
+ * Tasks, ENERGY_RUN and ENERGY_WAIT draw the run current.
+ *
+ * @param account Task id or EnergyState
+ * @param currents Current draw of the board
+ *
+ * @return Energy in uJ
+ */
+uint64_t EnergyMicrojoules(int account, const EnergyCurrents *currents);
+
+/**
+ * @brief Energy of a task including its waits
+ *
+ * @param account Task id or EnergyState
+ * @param currents Current draw of the board
+ *
+ * @return Energy in uJ
+ */
+uint64_t EnergyTaskMicrojoules(int account, const EnergyCurrents *currents);
+
+/**
+ * @brief Energy the radio adds in a state
+ *
+ * @param state Radio state
+ * @param currents Current draw of the board
+ *
+ * @return Energy in uJ
+ */
+uint64_t EnergyRadioMicrojoules(EnergyRadioState state,
+                                const EnergyCurrents *currents);
+
+/**
+ * @brief Ticks per second of the clock
+ */
+uint32_t EnergyTicksPerSecond(void);
+
+/**
+ * @brief Write the accounts as a blob
+ *
+ * The blob is little endian:
+ *
+ * | Bytes | Field |
+ * |---|---|
+ * | 1 | ENERGY_VERSION |
+ * | 1 | ENERGY_ACCOUNTS |
+ * | 1 | ENERGY_RADIO_STATES |
+ * | 4 | ticks per second |
+ *
+ * followed by each account as the count in 4 bytes, the ticks in 8 bytes and
+ * the wait in 8 bytes, then each radio state as the count in 4 bytes and the
+ * ticks in 8 bytes.
+ *
+ * @param buffer Output, ENERGY_BLOB_SIZE fits the blob
+ * @param size Size of the output
+ *
+ * @return Length of the blob, 0 if it does not fit
+ */
+size_t EnergySerialize(uint8_t *buffer, size_t size);
+
+/**
+ * @brief End a scope, called when the variable of ENERGY_SCOPE goes out of
+ * scope
+ */
+void EnergyScopeEnd(int *prev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_ENERGY_INCLUDE_ENERGY_H_
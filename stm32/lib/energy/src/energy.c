@@ -0,0 +1,249 @@
+/**
+ * @file energy.c
+ *
+ * @see energy.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "energy.h"
+
+#include <string.h>
+
+#include "stm32wlxx_hal.h"
+
+/** Time of each account */
+static EnergyAccount accounts[ENERGY_ACCOUNTS];
+
+/** Time of each radio state */
+static EnergyAccount radio[ENERGY_RADIO_STATES];
+
+/** Account charged since last_tick */
+static int current = ENERGY_RUN;
+
+/** Account that entered ENERGY_WAIT */
+static int waiting = ENERGY_RUN;
+
+/** Radio state since radio_tick */
+static EnergyRadioState radio_state = ENERGY_RADIO_OFF;
+
+/** Time of the last switch of the account */
+static uint32_t last_tick = 0;
+
+/** Time of the last switch of the radio state */
+static uint32_t radio_tick = 0;
+
+/** Time source */
+static EnergyClockFn clock_fn = NULL;
+
+/** Rate of the time source */
+static uint32_t ticks_per_second = 1;
+
+/**
+ * @brief Current time, 0 before EnergyInit
+ */
+static uint32_t Now(void) { return (clock_fn != NULL) ? clock_fn() : 0; }
+
+/**
+ * @brief Charge the time since the last switch to the current account and
+ * radio state
+ */
+static void Charge(void) {
+  const uint32_t now = Now();
+  const uint32_t elapsed = now - last_tick;
+  accounts[current].ticks += elapsed;
+  if (current == ENERGY_WAIT) {
+    accounts[waiting].wait += elapsed;
+  }
+  last_tick = now;
+  radio[radio_state].ticks += (uint32_t)(now - radio_tick);
+  radio_tick = now;
+}
+
+/**
+ * @brief Write a little endian integer
+ *
+ * @return Position after the integer
+ */
+static uint8_t *Put(uint8_t *out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    *out++ = (uint8_t)(value >> (8 * i));
+  }
+  return out;
+}
+
+/**
+ * @brief Energy of a time at a current
+ *
+ * @return Energy in uJ
+ */
+static uint64_t Microjoules(uint64_t ticks, uint32_t ua, uint32_t mv) {
+  // charge in nC first, which does not overflow for a year in stop mode
+  const uint64_t nc = ticks * ua * 1000 / ticks_per_second;
+  return nc * mv / 1000000;
+}
+
+void EnergyInit(EnergyClockFn clock, uint32_t rate) {
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  clock_fn = clock;
+  ticks_per_second = (rate > 0) ? rate : 1;
+  memset(accounts, 0, sizeof(accounts));
+  memset(radio, 0, sizeof(radio));
+  current = ENERGY_RUN;
+  waiting = ENERGY_RUN;
+  radio_state = ENERGY_RADIO_OFF;
+  last_tick = Now();
+  radio_tick = last_tick;
+
+  __set_PRIMASK(primask);
+}
+
+int EnergyEnter(int account) {
+  if (account < 0 || account >= ENERGY_ACCOUNTS) {
+    return current;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  Charge();
+  const int prev = current;
+  if (account == ENERGY_WAIT && prev != ENERGY_WAIT) {
+    waiting = prev;
+  }
+  current = account;
+  accounts[account].count++;
+
+  __set_PRIMASK(primask);
+  return prev;
+}
+
+void EnergyReturn(int account) {
+  if (account < 0 || account >= ENERGY_ACCOUNTS) {
+    return;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  Charge();
+  current = account;
+
+  __set_PRIMASK(primask);
+}
+
+void EnergyRadio(EnergyRadioState state) {
+  if (state >= ENERGY_RADIO_STATES || state == radio_state) {
+    return;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  Charge();
+  radio_state = state;
+  radio[state].count++;
+
+  __set_PRIMASK(primask);
+}
+
+const EnergyAccount *EnergyGet(int account) {
+  if (account < 0 || account >= ENERGY_ACCOUNTS) {
+    return NULL;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  Charge();
+  __set_PRIMASK(primask);
+
+  return &accounts[account];
+}
+
+const EnergyAccount *EnergyGetRadio(EnergyRadioState state) {
+  if (state >= ENERGY_RADIO_STATES) {
+    return NULL;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  Charge();
+  __set_PRIMASK(primask);
+
+  return &radio[state];
+}
+
+uint64_t EnergyMicrojoules(int account, const EnergyCurrents *currents) {
+  const EnergyAccount *acc = EnergyGet(account);
+  if (acc == NULL) {
+    return 0;
+  }
+
+  uint32_t ua = currents->run_ua;
+  if (account == ENERGY_SLEEP) {
+    ua = currents->sleep_ua;
+  } else if (account == ENERGY_STOP) {
+    ua = currents->stop_ua;
+  }
+  return Microjoules(acc->ticks, ua, currents->voltage_mv);
+}
+
+uint64_t EnergyTaskMicrojoules(int account, const EnergyCurrents *currents) {
+  const EnergyAccount *acc = EnergyGet(account);
+  if (acc == NULL) {
+    return 0;
+  }
+
+  return EnergyMicrojoules(account, currents) +
+         Microjoules(acc->wait, currents->run_ua, currents->voltage_mv);
+}
+
+uint64_t EnergyRadioMicrojoules(EnergyRadioState state,
+                                const EnergyCurrents *currents) {
+  const EnergyAccount *acc = EnergyGetRadio(state);
+  if (acc == NULL) {
+    return 0;
+  }
+
+  uint32_t ua = 0;
+  if (state == ENERGY_RADIO_RX) {
+    ua = currents->radio_rx_ua;
+  } else if (state == ENERGY_RADIO_TX) {
+    ua = currents->radio_tx_ua;
+  }
+  return Microjoules(acc->ticks, ua, currents->voltage_mv);
+}
+
+uint32_t EnergyTicksPerSecond(void) { return ticks_per_second; }
+
+size_t EnergySerialize(uint8_t *buffer, size_t size) {
+  if (size < ENERGY_BLOB_SIZE) {
+    return 0;
+  }
+
+  const uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  Charge();
+
+  uint8_t *out = buffer;
+  out = Put(out, ENERGY_VERSION, 1);
+  out = Put(out, ENERGY_ACCOUNTS, 1);
+  out = Put(out, ENERGY_RADIO_STATES, 1);
+  out = Put(out, ticks_per_second, 4);
+  for (int i = 0; i < ENERGY_ACCOUNTS; i++) {
+    out = Put(out, accounts[i].count, 4);
+    out = Put(out, accounts[i].ticks, 8);
+    out = Put(out, accounts[i].wait, 8);
+  }
+  for (int i = 0; i < ENERGY_RADIO_STATES; i++) {
+    out = Put(out, radio[i].count, 4);
+    out = Put(out, radio[i].ticks, 8);
+  }
+
+  __set_PRIMASK(primask);
+  return ENERGY_BLOB_SIZE;
+}
+
+void EnergyScopeEnd(int *prev) { EnergyReturn(*prev); }
@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE TCA9535
+
 #include "tca9535.h"
 
 #include "i2c.h"
@@ -0,0 +1,78 @@
+/**
+ * @file lowpower.h
+ * @brief Timed waits in low power mode
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_LOWPOWER_INCLUDE_LOWPOWER_H_
+#define LIB_LOWPOWER_INCLUDE_LOWPOWER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup lowpower Low power waits
+ * @brief Replacement for HAL_Delay that does not keep the core running
+ *
+ * HAL_Delay polls the RTC with the core running at full current. The waits
+ * here start a UTIL_TIMER and enter the low power mode of UTIL_LPM until it
+ * expires, the same way the sequencer idles. Stop2 is entered unless a module
+ * disabled it with UTIL_LPM_SetStopMode, otherwise the core sleeps. Interrupts
+ * are serviced during the wait, but sequencer tasks are not run, so a driver
+ * can wait in the middle of a transaction the way it did with HAL_Delay.
+ *
+ * @code
+ * // start conversion, then wait for it in low power
+ * HAL_I2C_Master_Transmit(&hi2c1, addrls, &cmd_start, 1, g_timeout);
+ * LowPowerDelay(60);
+ * @endcode
+ *
+ * The waits are for sequencer context. Before LowPowerInit, from an interrupt
+ * or with interrupts disabled, they fall back to HAL_Delay since the timer
+ * could never fire. Waits of a few ms gain little, as each wakeup from Stop2
+ * reinitializes the board.
+ *
+ * @{
+ */
+
+/**
+ * @brief Create the timer of the waits
+ *
+ * Call after UTIL_TIMER_Init. Waits before this call use HAL_Delay.
+ */
+void LowPowerInit(void);
+
+/**
+ * @brief Wait in low power mode
+ *
+ * @param ms Time to wait in ms
+ */
+void LowPowerDelay(uint32_t ms);
+
+/**
+ * @brief Wait in low power mode until a flag is set or a timeout
+ *
+ * The flag is meant to be set from an interrupt or timer callback, which
+ * wakes the core.
+ *
+ * @param flag Flag to wait for
+ * @param timeout_ms Max time to wait in ms
+ *
+ * @return true if the flag was set, false on timeout
+ */
+bool LowPowerWaitFor(volatile const bool *flag, uint32_t timeout_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_LOWPOWER_INCLUDE_LOWPOWER_H_
@@ -0,0 +1,98 @@
+/**
+ * @file lowpower.c
+ *
+ * @see lowpower.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "lowpower.h"
+
+#include <stddef.h>
+
+#include "stm32_lpm.h"
+#include "stm32_timer.h"
+#include "stm32wlxx_hal.h"
+
+/** Timer ending the wait */
+static UTIL_TIMER_Object_t timer;
+
+/** Set by the timer */
+static volatile bool expired = false;
+
+/** Timer created */
+static bool initialized = false;
+
+/**
+ * @brief Timer callback
+ */
+static void OnExpired(void *context) { expired = true; }
+
+/**
+ * @brief Whether the timer can end a wait
+ *
+ * @return false before LowPowerInit, in an interrupt or with interrupts
+ * disabled
+ */
+static bool CanSleep(void) {
+  return initialized && __get_IPSR() == 0 && __get_PRIMASK() == 0;
+}
+
+/**
+ * @brief Busy wait in steps of 1 ms until the flag is set
+ */
+static bool BusyWaitFor(volatile const bool *flag, uint32_t timeout_ms) {
+  for (uint32_t i = 0; i < timeout_ms; i++) {
+    if (*flag) {
+      return true;
+    }
+    HAL_Delay(1);
+  }
+  return *flag;
+}
+
+void LowPowerInit(void) {
+  UTIL_TIMER_Create(&timer, 1, UTIL_TIMER_ONESHOT, OnExpired, NULL);
+  initialized = true;
+}
+
+void LowPowerDelay(uint32_t ms) {
+  if (ms == 0) {
+    return;
+  }
+  if (!CanSleep()) {
+    HAL_Delay(ms);
+    return;
+  }
+
+  static const bool never = false;
+  LowPowerWaitFor(&never, ms);
+}
+
+bool LowPowerWaitFor(volatile const bool *flag, uint32_t timeout_ms) {
+  if (*flag || timeout_ms == 0) {
+    return *flag;
+  }
+  if (!CanSleep()) {
+    return BusyWaitFor(flag, timeout_ms);
+  }
+
+  expired = false;
+  UTIL_TIMER_SetPeriod(&timer, timeout_ms);
+  UTIL_TIMER_Start(&timer);
+
+  // same as the sequencer idle, an interrupt between the check and the wfi
+  // still wakes the core since it is pending
+  for (;;) {
+    __disable_irq();
+    if (expired || *flag) {
+      __enable_irq();
+      break;
+    }
+    UTIL_LPM_EnterLowPower();
+    __enable_irq();
+  }
+
+  UTIL_TIMER_Stop(&timer);
+  return *flag;
+}
@@ -1,3 +1,5 @@
+#define APP_LOG_MODULE PCAP02
+
 #include "pcap02.h"
 
 #include "board.h"
@@ -0,0 +1,203 @@
+/**
+ * @file prof.h
+ * @brief Cycle counts of the hot paths
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_PROF_INCLUDE_PROF_H_
+#define LIB_PROF_INCLUDE_PROF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @defgroup prof Profiling
+ * @brief Time spent in each scope of the firmware
+ *
+ * PROF_SCOPE times the rest of the enclosing block, including every return
+ * path, and adds it to a named entry of a static table with the count, min,
+ * max and total. Scopes with the same name share an entry. On the stm32 the
+ * time is the DWT cycle counter, which stops in Stop2, so only awake time is
+ * counted. On the host it is clock_gettime in ns.
+ *
+ * @code
+ * FramStatus FramPut(const uint8_t *data, const size_t num_bytes) {
+ *   PROF_SCOPE("fifo_put");
+ *   ...
+ * }
+ * @endcode
+ *
+ * Entries are claimed on the first call of a scope. Once PROF_MAX_SCOPES are
+ * claimed, new scopes are not recorded. The table is updated without
+ * disabling interrupts, so scopes are meant for the main loop and not for
+ * interrupt handlers. Nested scopes each count their full time.
+ *
+ * ProfSerialize writes the table as a blob, which sys_app.c logs
+ * periodically with BINLOG. ents prof decodes it from the log of the node.
+ *
+ * @{
+ */
+
+/** Max number of entries */
+#ifndef PROF_MAX_SCOPES
+#define PROF_MAX_SCOPES 16
+#endif /* PROF_MAX_SCOPES */
+
+/** Size of a name including the terminator, longer names are truncated */
+#define PROF_NAME_SIZE 12
+
+/** Version of the blob */
+#define PROF_VERSION 1
+
+/** Bytes of the blob before the entries */
+#define PROF_HEADER_SIZE 6
+
+/** Bytes of an entry in the blob */
+#define PROF_ENTRY_SIZE (PROF_NAME_SIZE + 20)
+
+/** Max size of the blob */
+#define PROF_BLOB_SIZE (PROF_HEADER_SIZE + PROF_MAX_SCOPES * PROF_ENTRY_SIZE)
+
+/** Id of a scope that is not registered yet */
+#define PROF_UNREGISTERED (-2)
+
+/** Id of a scope that did not fit in the table */
+#define PROF_FULL (-1)
+
+/** Statistics of a scope */
+typedef struct {
+  /** Name, NUL terminated */
+  char name[PROF_NAME_SIZE];
+  /** Number of calls */
+  uint32_t count;
+  /** Shortest call in ticks */
+  uint32_t min;
+  /** Longest call in ticks */
+  uint32_t max;
+  /** Sum of all calls in ticks */
+  uint64_t total;
+} ProfStats;
+
+/** Running scope, see PROF_SCOPE */
+typedef struct {
+  /** Entry of the scope */
+  int id;
+  /** Ticks at the start */
+  uint32_t start;
+} ProfTimer;
+
+/**
+ * @brief Time the rest of the block
+ *
+ * @param name String literal naming the entry
+ */
+#define PROF_SCOPE(name)                                                 \
+  static int PROF_CAT(prof_id_, __LINE__) = PROF_UNREGISTERED;           \
+  ProfTimer PROF_CAT(prof_timer_, __LINE__)                              \
+      __attribute__((cleanup(ProfScopeEnd), unused)) =                   \
+          ProfScopeBegin(&PROF_CAT(prof_id_, __LINE__), (name))
+
+/** @cond INTERNAL */
+#define PROF_CAT(a, b) PROF_CAT_(a, b)
+#define PROF_CAT_(a, b) a##b
+/** @endcond */
+
+/**
+ * @brief Start the time source
+ *
+ * Call before the first scope. The DWT counter is not running after reset.
+ */
+void ProfInit(void);
+
+/**
+ * @brief Current time in ticks
+ */
+uint32_t ProfNow(void);
+
+/**
+ * @brief Ticks per second of ProfNow
+ */
+uint32_t ProfTicksPerSecond(void);
+
+/**
+ * @brief Find or claim the entry of a name
+ *
+ * The name is copied, so it does not have to outlive the call.
+ *
+ * @param name Name of the entry
+ *
+ * @return Id of the entry, PROF_FULL if the table is full
+ */
+int ProfRegister(const char *name);
+
+/**
+ * @brief Add a call to an entry
+ *
+ * @param id Id from ProfRegister, ignored if negative
+ * @param ticks Duration of the call
+ */
+void ProfRecord(int id, uint32_t ticks);
+
+/**
+ * @brief Statistics of an entry
+ *
+ * @param id Id from ProfRegister
+ *
+ * @return NULL if the entry is not claimed
+ */
+const ProfStats *ProfGet(int id);
+
+/**
+ * @brief Clear the statistics and keep the names
+ */
+void ProfReset(void);
+
+/**
+ * @brief Write the table as a blob
+ *
+ * The blob is little endian:
+ *
+ * | Bytes | Field |
+ * |---|---|
+ * | 1 | PROF_VERSION |
+ * | 1 | number of entries |
+ * | 4 | ticks per second |
+ *
+ * followed by each entry as PROF_NAME_SIZE bytes of name padded with NUL, then
+ * the count, min and max as 4 bytes and the total as 8 bytes.
+ *
+ * @param buffer Output, PROF_BLOB_SIZE fits every table
+ * @param size Size of the output
+ *
+ * @return Length of the blob, 0 if it does not fit
+ */
+size_t ProfSerialize(uint8_t *buffer, size_t size);
+
+/**
+ * @brief Start a scope, use PROF_SCOPE instead
+ *
+ * @param id Entry of the scope, registered on the first call
+ * @param name Name of the entry
+ */
+ProfTimer ProfScopeBegin(int *id, const char *name);
+
+/**
+ * @brief End a scope, called when the variable of PROF_SCOPE goes out of
+ * scope
+ */
+void ProfScopeEnd(ProfTimer *timer);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_PROF_INCLUDE_PROF_H_
@@ -0,0 +1,153 @@
+/**
+ * @file prof.c
+ *
+ * @see prof.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "prof.h"
+
+#include <string.h>
+
+#ifdef __arm__
+#include "stm32wlxx_hal.h"
+#else
+#include <time.h>
+#endif /* __arm__ */
+
+/** Statistics of the claimed entries */
+static ProfStats table[PROF_MAX_SCOPES];
+
+/** Number of claimed entries */
+static int table_len = 0;
+
+/**
+ * @brief Write a little endian integer
+ *
+ * @return Position after the integer
+ */
+static uint8_t *Put(uint8_t *out, uint64_t value, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    *out++ = (uint8_t)(value >> (8 * i));
+  }
+  return out;
+}
+
+/**
+ * @brief Clear the statistics of an entry
+ */
+static void Clear(ProfStats *stats) {
+  stats->count = 0;
+  stats->min = UINT32_MAX;
+  stats->max = 0;
+  stats->total = 0;
+}
+
+void ProfInit(void) {
+#ifdef __arm__
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* __arm__ */
+}
+
+uint32_t ProfNow(void) {
+#ifdef __arm__
+  return DWT->CYCCNT;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000000u + (uint32_t)ts.tv_nsec;
+#endif /* __arm__ */
+}
+
+uint32_t ProfTicksPerSecond(void) {
+#ifdef __arm__
+  return SystemCoreClock;
+#else
+  return 1000000000u;
+#endif /* __arm__ */
+}
+
+int ProfRegister(const char *name) {
+  for (int i = 0; i < table_len; i++) {
+    if (strncmp(table[i].name, name, PROF_NAME_SIZE - 1) == 0) {
+      return i;
+    }
+  }
+
+  if (table_len >= PROF_MAX_SCOPES) {
+    return PROF_FULL;
+  }
+
+  ProfStats *stats = &table[table_len];
+  strncpy(stats->name, name, PROF_NAME_SIZE - 1);
+  stats->name[PROF_NAME_SIZE - 1] = '\0';
+  Clear(stats);
+  return table_len++;
+}
+
+void ProfRecord(int id, uint32_t ticks) {
+  if (id < 0 || id >= table_len) {
+    return;
+  }
+
+  ProfStats *stats = &table[id];
+  stats->count++;
+  if (ticks < stats->min) {
+    stats->min = ticks;
+  }
+  if (ticks > stats->max) {
+    stats->max = ticks;
+  }
+  stats->total += ticks;
+}
+
+const ProfStats *ProfGet(int id) {
+  if (id < 0 || id >= table_len) {
+    return NULL;
+  }
+  return &table[id];
+}
+
+void ProfReset(void) {
+  for (int i = 0; i < table_len; i++) {
+    Clear(&table[i]);
+  }
+}
+
+size_t ProfSerialize(uint8_t *buffer, size_t size) {
+  const size_t len = PROF_HEADER_SIZE + table_len * PROF_ENTRY_SIZE;
+  if (len > size) {
+    return 0;
+  }
+
+  uint8_t *out = buffer;
+  out = Put(out, PROF_VERSION, 1);
+  out = Put(out, table_len, 1);
+  out = Put(out, ProfTicksPerSecond(), 4);
+
+  for (int i = 0; i < table_len; i++) {
+    const ProfStats *stats = &table[i];
+    memcpy(out, stats->name, PROF_NAME_SIZE);
+    out += PROF_NAME_SIZE;
+    out = Put(out, stats->count, 4);
+    out = Put(out, (stats->count > 0) ? stats->min : 0, 4);
+    out = Put(out, stats->max, 4);
+    out = Put(out, stats->total, 8);
+  }
+
+  return len;
+}
+
+ProfTimer ProfScopeBegin(int *id, const char *name) {
+  if (*id == PROF_UNREGISTERED) {
+    *id = ProfRegister(name);
+  }
+  return (ProfTimer){*id, ProfNow()};
+}
+
+void ProfScopeEnd(ProfTimer *timer) {
+  ProfRecord(timer->id, ProfNow() - timer->start);
+}
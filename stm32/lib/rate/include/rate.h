@@ -0,0 +1,102 @@
+/**
+ * @file rate.h
+ * @brief Adapts the upload rate to the backlog
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_RATE_INCLUDE_RATE_H_
+#define LIB_RATE_INCLUDE_RATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup rate Rate controller
+ * @brief Speeds up uploads to drain a backlog
+ *
+ * The upload interval from the user config is the nominal rate. The
+ * controller turns the number of measurements waiting in the FRAM buffer into
+ * a scale of the upload period, in percent of the nominal one. With a backlog
+ * the upload period is divided by drain_scale, so the buffer empties faster
+ * after an outage.
+ *
+ * Draining starts at backlog_high measurements and stops at backlog_clear, so
+ * the rate does not oscillate around a single threshold. The scale is clamped
+ * to min_scale.
+ *
+ * The module has no hardware dependencies, see extras/rate for a host
+ * simulation of an upload outage.
+ *
+ * @{
+ */
+
+/** Scale of a period at its nominal rate */
+#define RATE_SCALE_NOMINAL 100
+
+/** Thresholds of a ~40 measurement buffer */
+#define RATE_CONFIG_DEFAULT {16, 4, 200, 50}
+
+/** Thresholds and scales of the controller */
+typedef struct {
+  /** Start draining at this many buffered measurements */
+  uint16_t backlog_high;
+  /** Stop draining at this many buffered measurements */
+  uint16_t backlog_clear;
+  /** Upload period is divided by this while draining, in percent */
+  uint16_t drain_scale;
+  /** Smallest scale in percent */
+  uint16_t min_scale;
+} RateConfig;
+
+/** State of the controller */
+typedef struct {
+  /** Thresholds and scales */
+  RateConfig config;
+  /** Draining the backlog */
+  bool draining;
+  /** Scale of the upload period in percent */
+  uint16_t upload_scale;
+} RateController;
+
+/**
+ * @brief Start at the nominal rate
+ *
+ * @param rate Controller
+ * @param config Thresholds and scales
+ */
+void RateInit(RateController *rate, const RateConfig *config);
+
+/**
+ * @brief Update the rate from the backlog
+ *
+ * @param rate Controller
+ * @param backlog Number of measurements waiting to be uploaded
+ *
+ * @return true if the scale changed
+ */
+bool RateUpdate(RateController *rate, uint32_t backlog);
+
+/**
+ * @brief Scale the upload period
+ *
+ * @param rate Controller
+ * @param period Nominal period
+ *
+ * @return Period at the current rate, saturated at UINT32_MAX
+ */
+uint32_t RateUploadPeriod(const RateController *rate, uint32_t period);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_RATE_INCLUDE_RATE_H_
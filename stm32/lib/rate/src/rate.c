@@ -0,0 +1,51 @@
+/**
+ * @file rate.c
+ *
+ * @see rate.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "rate.h"
+
+static uint16_t Clamp(const RateConfig *config, uint32_t scale) {
+  if (scale < config->min_scale) {
+    return config->min_scale;
+  }
+  return (uint16_t)scale;
+}
+
+static uint32_t Scale(uint32_t period, uint16_t scale) {
+  const uint64_t scaled = (uint64_t)period * scale / RATE_SCALE_NOMINAL;
+  return scaled > UINT32_MAX ? UINT32_MAX : (uint32_t)scaled;
+}
+
+void RateInit(RateController *rate, const RateConfig *config) {
+  rate->config = *config;
+  rate->draining = false;
+  rate->upload_scale = Clamp(config, RATE_SCALE_NOMINAL);
+}
+
+bool RateUpdate(RateController *rate, uint32_t backlog) {
+  const RateConfig *config = &rate->config;
+
+  if (rate->draining) {
+    rate->draining = backlog > config->backlog_clear;
+  } else {
+    rate->draining = backlog >= config->backlog_high;
+  }
+
+  uint32_t upload_scale = RATE_SCALE_NOMINAL;
+  if (rate->draining && config->drain_scale != 0) {
+    upload_scale = upload_scale * RATE_SCALE_NOMINAL / config->drain_scale;
+  }
+
+  const uint16_t upload = Clamp(config, upload_scale);
+  const bool changed = upload != rate->upload_scale;
+  rate->upload_scale = upload;
+  return changed;
+}
+
+uint32_t RateUploadPeriod(const RateController *rate, uint32_t period) {
+  return Scale(period, rate->upload_scale);
+}
@@ -22,6 +22,7 @@ extern "C" {
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "async.h"
 #include "gpio.h"
 #include "main.h"
 #include "tim.h"
@@ -43,12 +44,24 @@ extern "C" {
  * @{
  */
 
+#ifndef SDI12_MAX_MEASUREMENTS
+/** Max number of async measurements in progress at the same time */
+#define SDI12_MAX_MEASUREMENTS 10
+#endif /* SDI12_MAX_MEASUREMENTS */
+
+/**
+ * Size of a buffer for a response line with CRLF and null terminator, a
+ * 75 character aR! response with a CRC is the longest
+ */
+#define SDI12_LINE_SIZE 81
+
 /** Status codes for the Fram library*/
 typedef enum {
   SDI12_OK = 0,
   SDI12_ERROR = -1,
   SDI12_TIMEOUT_ON_READ = -2,
   SDI12_PARSING_ERROR = -3,
+  SDI12_CRC_ERROR = -4,
 } SDI12Status;
 
 /* The returned values from a SDI12 get measurement command*/
@@ -92,6 +105,47 @@ SDI12Status SDI12SendCommand(const char *command, uint8_t size);
 SDI12Status SDI12ReadData(char *buffer, uint16_t bufferSize,
                           uint16_t timeoutMillis);
 
+/**
+ * @brief Read a response line terminated by CRLF
+ *
+ * The line is received by DMA with idle line detection, so the read returns
+ * as soon as the CRLF arrives instead of waiting for a fixed number of
+ * characters or the timeout like SDI12ReadData.
+ *
+ * @param buffer Buffer for the null terminated line including the CRLF
+ * @param size Size of @p buffer, SDI12_LINE_SIZE fits any response
+ * @param timeoutMillis Time to wait for the CRLF in ms
+ *
+ * @return SDI12_TIMEOUT_ON_READ if no CRLF arrived, SDI12_ERROR if the line
+ * does not fit @p buffer
+ */
+SDI12Status SDI12ReadLine(char *buffer, uint16_t size, uint16_t timeoutMillis);
+
+/**
+ * @brief Compute the CRC of a response
+ *
+ * CRC-16-IBM as defined by SDI-12 v1.4 section 4.4.12.
+ *
+ * @param data Response starting with the address
+ * @param len Number of characters in @p data
+ *
+ * @return CRC
+ */
+uint16_t SDI12Crc(const char *data, size_t len);
+
+/**
+ * @brief Check and remove the CRC of a response
+ *
+ * Responses to the data commands of aMC! and aCC! end with the CRC encoded as
+ * three characters before the CRLF.
+ *
+ * @param line Null terminated response without the CRLF, the CRC is removed
+ * when valid
+ *
+ * @return SDI12_CRC_ERROR if the CRC does not match
+ */
+SDI12Status SDI12CheckCrc(char *line);
+
 /**
 ******************************************************************************
 * @brief    This is a function to read a measurement from a particular sensor.
@@ -99,7 +153,8 @@ SDI12Status SDI12ReadData(char *buffer, uint16_t bufferSize,
 * @param    char const addr, the device address
 * @param    SDI12_Measure_TypeDef, a custom struct to store the measurement
 *information returned from start measurement
-* @param    char* the measurement data returned
+* @param    char* the measurement data returned without the trailing CRLF,
+* must fit the full response
 * @param    uint16_t timeoutMillis time out in milliseconds
 * @return   SDI12Status
 ******************************************************************************
@@ -119,6 +174,71 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
  */
 SDI12Status SDI12GetAddress(char *addr, uint16_t timeoutMillis);
 
+/**
+ * @brief Get the address of a sensor from the user config index field
+ *
+ * The numbers 0-9 are accepted in place of the characters '0'-'9'.
+ *
+ * @param index Index field of EnabledSensorMultiple
+ * @param addr Address of the sensor
+ *
+ * @return SDI12_PARSING_ERROR if @p index is not a valid address
+ */
+SDI12Status SDI12AddressFromIndex(uint32_t index, char *addr);
+
+/**
+ * @brief Start a measurement without blocking
+ *
+ * Steps through the same commands as SDI12GetMeasurement. The waits for the
+ * wake up break and for the measurement are returned through @p wait_ms
+ * instead of being spent blocking. The data is requested after the time
+ * reported by the sensor rather than on the service request.
+ *
+ * With @p concurrent the measurement is started with aC! instead of aM!. The
+ * bus is released while the sensor measures, so measurements of other
+ * sensors can be started and the cycle takes about as long as the slowest
+ * sensor. An aM! measurement holds the bus until its data is read, since
+ * any traffic aborts it.
+ *
+ * With @p crc the data is requested with aMC! or aCC! and responses with an
+ * invalid CRC fail the measurement.
+ *
+ * @param addr Address of the sensor
+ * @param concurrent Use the concurrent measurement command
+ * @param crc Request a CRC on the data
+ * @param wait_ms Time until SDI12MeasurePoll should be called
+ *
+ * @return ASYNC_BUSY if the bus is held, the sensor is already measuring or
+ * SDI12_MAX_MEASUREMENTS are in progress
+ * @see async.h
+ */
+AsyncStatus SDI12MeasureStart(char addr, bool concurrent, bool crc,
+                              uint32_t *wait_ms);
+
+/**
+ * @brief Continue a measurement started with SDI12MeasureStart
+ *
+ * A sensor that finished measuring while another sensor holds the bus waits
+ * for the bus to be released.
+ *
+ * @param addr Address of the sensor
+ * @param data Buffer for the null terminated measurement string, without the
+ * trailing CRLF
+ * @param size Size of @p data
+ * @param wait_ms Time until the next call when ASYNC_WAIT is returned
+ *
+ * @return ASYNC_DONE when @p data holds the measurement
+ */
+AsyncStatus SDI12MeasurePoll(char addr, char *data, size_t size,
+                             uint32_t *wait_ms);
+
+/**
+ * @brief Abort a measurement started with SDI12MeasureStart
+ *
+ * @param addr Address of the sensor
+ */
+void SDI12MeasureCancel(char addr);
+
 /**
  * @}
  */
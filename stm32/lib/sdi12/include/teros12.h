@@ -8,6 +8,7 @@
 #ifndef LIB_SDI12_INCLUDE_TEROS12_H_
 #define LIB_SDI12_INCLUDE_TEROS12_H_
 
+#include "fixed.h"
 #include "sdi12.h"
 #include "sensors.h"
 #include "stm32_systime.h"
@@ -33,8 +34,10 @@ extern "C" {
 
 typedef struct {
   char addr;
-  float vwc;
-  float temp;
+  /** Calibrated counts of VWC */
+  q32_t vwc;
+  /** Temperature in C */
+  q32_t temp;
   unsigned int ec;
 } Teros12Data;
 
@@ -78,6 +81,27 @@ SDI12Status Teros12GetMeasurement(char addr, Teros12Data *data);
 size_t Teros12Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
                       EnabledSensorMultiple *sensor);
 
+/**
+ * @brief Async driver for Teros12 sensors
+ *
+ * The address is read from the index field of the EnabledSensorMultiple passed
+ * as the context. Measurements use the concurrent command aCC!, so probes on
+ * the same bus measure at the same time, and the data is checked by CRC. A
+ * start while another probe is addressed returns ASYNC_BUSY. The result is
+ * encoded with Teros12Encode.
+ *
+ * @see SDI12MeasureStart
+ */
+extern const AsyncDriver Teros12Async;
+
+/**
+ * @brief Encode the last measurement of Teros12Async
+ *
+ * @see SensorsPrototypeMeasure
+ */
+size_t Teros12Encode(uint8_t *data, SysTime_t ts, uint32_t idx,
+                     EnabledSensorMultiple *sensor);
+
 /**
  * @}
  */
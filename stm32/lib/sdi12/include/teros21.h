@@ -8,6 +8,7 @@
 #ifndef LIB_SDI12_INCLUDE_TEROS21_H_
 #define LIB_SDI12_INCLUDE_TEROS21_H_
 
+#include "fixed.h"
 #include "sdi12.h"
 #include "sensors.h"
 #include "stm32_systime.h"
@@ -34,8 +35,10 @@ extern "C" {
 
 typedef struct {
   char addr;
-  float matric_pot;
-  float temp;
+  /** Matric potential in kPa */
+  q32_t matric_pot;
+  /** Temperature in C */
+  q32_t temp;
 } Teros21Data;
 
 /**
@@ -69,6 +72,27 @@ SDI12Status Teros21GetMeasurement(char addr, Teros21Data *data);
 size_t Teros21Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
                       EnabledSensorMultiple *sensor);
 
+/**
+ * @brief Async driver for Teros21 sensors
+ *
+ * The address is read from the index field of the EnabledSensorMultiple passed
+ * as the context. Measurements use the concurrent command aCC!, so probes on
+ * the same bus measure at the same time, and the data is checked by CRC. A
+ * start while another probe is addressed returns ASYNC_BUSY. The result is
+ * encoded with Teros21Encode.
+ *
+ * @see SDI12MeasureStart
+ */
+extern const AsyncDriver Teros21Async;
+
+/**
+ * @brief Encode the last measurement of Teros21Async
+ *
+ * @see SensorsPrototypeMeasure
+ */
+size_t Teros21Encode(uint8_t *data, SysTime_t ts, uint32_t idx,
+                     EnabledSensorMultiple *sensor);
+
 /**
  * @}
  */
@@ -12,17 +12,72 @@
  ******************************************************************************
  **/
 
+#define APP_LOG_MODULE SDI12
+
 #include "sdi12.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-static const uint16_t REQUEST_MEASURMENT_RESPONSE_SIZE = 7;
-static const uint16_t SERVICE_REQUEST_SIZE = 3;
-static const uint16_t MEASURMENT_DATA_SIZE = 30;
+#include "lowpower.h"
+#include "parse.h"
+#include "stm32_lpm.h"
+#include "utilities_def.h"
+
 static const uint16_t SEND_COMMAND_TIMEOUT = 1000;
 
+/** Time in ms for the break (12 ms) and marking (8.33 ms) that wake sensors */
+static const uint32_t WAKE_TIME = 21;
+
+/** Timeout in ms for responses during async measurements */
+static const uint16_t ASYNC_READ_TIMEOUT = 1000;
+
+/** Steps of an async measurement */
+typedef enum {
+  SDI12_ASYNC_IDLE = 0,
+  /** Waking sensors before aM! or aC! */
+  SDI12_ASYNC_WAKE_MEASURE,
+  /** Waiting for the sensor to finish measuring */
+  SDI12_ASYNC_MEASURING,
+  /** Waking sensors before aD0! */
+  SDI12_ASYNC_WAKE_DATA,
+} SDI12AsyncState;
+
+/** Async measurement of a single sensor */
+typedef struct {
+  SDI12AsyncState state;
+  char addr;
+  /** Measurement started with aC! instead of aM! */
+  bool concurrent;
+  /** Data is requested with a CRC */
+  bool crc;
+  SDI12_Measure_TypeDef info;
+} SDI12AsyncMeasurement;
+
+/** Async measurements in progress */
+static SDI12AsyncMeasurement measurements[SDI12_MAX_MEASUREMENTS] = {};
+
+/**
+ * Address of the sensor holding the bus, '\0' if the bus is free
+ *
+ * The bus is held from the break until the response of a command. An aM!
+ * measurement is aborted by any traffic on the bus, so the bus is held until
+ * its data is read. Sensors measuring after aC! ignore other traffic.
+ */
+static char bus_owner = '\0';
+
+/** Line received by DMA, written from the UART interrupt */
+static struct {
+  char buffer[SDI12_LINE_SIZE];
+  /** Offset of the current DMA transfer in buffer */
+  uint16_t start;
+  /** Number of characters received */
+  volatile uint16_t len;
+  /** Set when a CRLF or an overflow was received */
+  volatile bool done;
+} rx = {};
+
 /* Helper function to parse the sensor's response to a get measurement command*/
 SDI12Status ParseMeasurementResponse(const char *responseBuffer, char addr,
                                      SDI12_Measure_TypeDef *measurement_info);
@@ -30,22 +85,29 @@ SDI12Status ParseMeasurementResponse(const char *responseBuffer, char addr,
 /* Helper function to parse a sensor's service request */
 SDI12Status ParseServiceRequest(const char *requestBuffer, char addr);
 
-void SDI12WakeSensors(void) {
+/**
+ * @brief Parse the "atttnn" response to a concurrent measurement command
+ */
+static SDI12Status ParseConcurrentResponse(
+    const char *responseBuffer, char addr,
+    SDI12_Measure_TypeDef *measurement_info);
+
+/**
+ * @brief Send a break followed by marking without waiting for it to finish
+ */
+static void SendBreak(void) {
   HAL_LIN_SendBreak(&hlpuart1);  // Send a break
   HAL_GPIO_WritePin(SDI12_DIR_GPIO_Port, SDI12_DIR_Pin,
                     GPIO_PIN_RESET);  // Send the marking
-  // HAL_Delay(20); // Need an extra 10ms to account for the fact
-  // that HAL_LIN_SendBreak is nonblocking
-  for (int i = 0; i <= 40000; i++) {
-    // TODO: Figure out a way to do this delay with the low-power timer htim1
-    // (or schedule a one-time non-periodic event through the scheduler)
-    asm("nop");
-  }
 }
 
-SDI12Status SDI12SendCommand(const char *command, uint8_t size) {
+/**
+ * @brief Transmit a command to awake sensors and switch to RX mode
+ *
+ * The caller is responsible for waking the sensors first.
+ */
+static SDI12Status Transmit(const char *command, uint8_t size) {
   HAL_StatusTypeDef ret;
-  SDI12WakeSensors();
   ret = HAL_UART_Transmit(&hlpuart1, (const uint8_t *)command, size,
                           SEND_COMMAND_TIMEOUT);
   HAL_GPIO_WritePin(SDI12_DIR_GPIO_Port, SDI12_DIR_Pin,
@@ -57,6 +119,18 @@ SDI12Status SDI12SendCommand(const char *command, uint8_t size) {
   }
 }
 
+void SDI12WakeSensors(void) {
+  // HAL_LIN_SendBreak is nonblocking, the break and marking finish while
+  // sleeping
+  SendBreak();
+  LowPowerDelay(WAKE_TIME);
+}
+
+SDI12Status SDI12SendCommand(const char *command, uint8_t size) {
+  SDI12WakeSensors();
+  return Transmit(command, size);
+}
+
 SDI12Status SDI12ReadData(char *buffer, uint16_t bufferSize,
                           uint16_t timeoutMillis) {
   HAL_StatusTypeDef ret;
@@ -74,11 +148,146 @@ SDI12Status SDI12ReadData(char *buffer, uint16_t bufferSize,
   }
 }
 
+/**
+ * @brief Get the length of the line in the rx buffer including the CRLF
+ *
+ * @return 0 if no CRLF was received yet
+ */
+static uint16_t LineLength(void) {
+  for (uint16_t i = 1; i < rx.len; i++) {
+    if (rx.buffer[i - 1] == '\r' && rx.buffer[i] == '\n') {
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Receive into the rest of the rx buffer until the line goes idle
+ */
+static HAL_StatusTypeDef RxStart(void) {
+  HAL_StatusTypeDef ret = HAL_UARTEx_ReceiveToIdle_DMA(
+      &hlpuart1, (uint8_t *)rx.buffer + rx.start, sizeof(rx.buffer) - rx.start);
+  // only idle and transfer complete events are of interest
+  __HAL_DMA_DISABLE_IT(hlpuart1.hdmarx, DMA_IT_HT);
+  return ret;
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
+  if (huart != &hlpuart1) {
+    return;
+  }
+
+  rx.len = rx.start + Size;
+  if (LineLength() > 0 || rx.len >= sizeof(rx.buffer)) {
+    rx.done = true;
+    return;
+  }
+
+  // idle within a line, keep receiving after what arrived so far
+  rx.start = rx.len;
+  if (RxStart() != HAL_OK) {
+    rx.done = true;
+  }
+}
+
+SDI12Status SDI12ReadLine(char *buffer, uint16_t size,
+                          uint16_t timeoutMillis) {
+  HAL_GPIO_WritePin(SDI12_DIR_GPIO_Port, SDI12_DIR_Pin,
+                    GPIO_PIN_SET);  // Set to RX mode
+  __HAL_UART_FLUSH_DRREGISTER(&hlpuart1);
+
+  rx.start = 0;
+  rx.len = 0;
+  rx.done = false;
+  if (RxStart() != HAL_OK) {
+    return SDI12_ERROR;
+  }
+
+  // the transfer completes in the background, only the CRLF is waited for.
+  // DMA does not run in stop mode, so the core only sleeps.
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_SDI12_Id), UTIL_LPM_DISABLE);
+  const bool done = LowPowerWaitFor(&rx.done, timeoutMillis);
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_SDI12_Id), UTIL_LPM_ENABLE);
+  if (!done) {
+    HAL_UART_AbortReceive(&hlpuart1);
+    return SDI12_TIMEOUT_ON_READ;
+  }
+
+  const uint16_t len = LineLength();
+  if (len == 0 || len >= size) {
+    return SDI12_ERROR;
+  }
+
+  memcpy(buffer, rx.buffer, len);
+  buffer[len] = '\0';
+
+  return SDI12_OK;
+}
+
+/**
+ * @brief Remove the trailing CRLF of a line read by SDI12ReadLine
+ */
+static void StripLine(char *line) {
+  char *end = strstr(line, "\r\n");
+  if (end) {
+    *end = '\0';
+  }
+}
+
+uint16_t SDI12Crc(const char *data, size_t len) {
+  // CRC-16-IBM, reflected polynomial 0xA001 with an initial value of 0
+  uint16_t crc = 0;
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint8_t)data[i];
+    for (int j = 0; j < 8; j++) {
+      if (crc & 1) {
+        crc = (crc >> 1) ^ 0xA001;
+      } else {
+        crc >>= 1;
+      }
+    }
+  }
+  return crc;
+}
+
+SDI12Status SDI12CheckCrc(char *line) {
+  const size_t len = strlen(line);
+  // address and three CRC characters
+  if (len < 4) {
+    return SDI12_PARSING_ERROR;
+  }
+
+  // the CRC is sent as three printable characters of 4, 6 and 6 bits
+  const uint16_t crc = SDI12Crc(line, len - 3);
+  const char *sent = line + len - 3;
+  if (sent[0] != (char)(0x40 | (crc >> 12)) ||
+      sent[1] != (char)(0x40 | ((crc >> 6) & 0x3F)) ||
+      sent[2] != (char)(0x40 | (crc & 0x3F))) {
+    return SDI12_CRC_ERROR;
+  }
+
+  line[len - 3] = '\0';
+  return SDI12_OK;
+}
+
 SDI12Status ParseMeasurementResponse(const char *responseBuffer, char addr,
                                      SDI12_Measure_TypeDef *measurement_info) {
-  sscanf(responseBuffer, "%1c%3hu%1hhu", &(measurement_info->Address),
-         &(measurement_info->Time), &(measurement_info->NumValues));
-  // Parse the response and populate the structure
+  // Parse the response and populate the structure, same as "%1c%3hu%1hhu"
+  const char *s = responseBuffer;
+  if (!ParseChar(&s, &(measurement_info->Address))) {
+    return SDI12_PARSING_ERROR;
+  }
+
+  uint32_t time = 0;
+  uint32_t num_values = 0;
+  if (ParseUint(&s, 3, &time)) {
+    measurement_info->Time = time;
+    if (ParseUint(&s, 1, &num_values)) {
+      measurement_info->NumValues = num_values;
+    }
+  }
+
   // Check if the response address matches the expected address
   if (measurement_info->Address == addr) {
     return SDI12_OK;  // Return success
@@ -87,6 +296,27 @@ SDI12Status ParseMeasurementResponse(const char *responseBuffer, char addr,
   }
 }
 
+static SDI12Status ParseConcurrentResponse(
+    const char *responseBuffer, char addr,
+    SDI12_Measure_TypeDef *measurement_info) {
+  char address = 0;
+  uint32_t time = 0;
+  uint32_t num_values = 0;
+
+  // same as "%1c%3hu%2hhu"
+  const char *s = responseBuffer;
+  if (!ParseChar(&s, &address) || !ParseUint(&s, 3, &time) ||
+      !ParseUint(&s, 2, &num_values) || address != addr) {
+    return SDI12_PARSING_ERROR;
+  }
+
+  measurement_info->Address = address;
+  measurement_info->Time = time;
+  measurement_info->NumValues = num_values;
+
+  return SDI12_OK;
+}
+
 SDI12Status ParseServiceRequest(const char *requestBuffer, char addr) {
   char expectedResponse[12];
   // Construct the expected response ("a\r\n")
@@ -110,6 +340,9 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
   // Command for device to send the data
   char sendData[5];
 
+  // Responses are read as lines, the read ends on the CRLF
+  char line[SDI12_LINE_SIZE];
+
   SDI12Status ret;
 
   //
@@ -119,11 +352,9 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
   // Construct a command to request a measurement
   uint8_t size = snprintf(reqMeas, sizeof(reqMeas), "%cM!", addr);
 
-  char meas_resp_buffer[REQUEST_MEASURMENT_RESPONSE_SIZE];
   // Request a measurement and read the response
   SDI12SendCommand(reqMeas, size);
-  ret = SDI12ReadData(meas_resp_buffer, REQUEST_MEASURMENT_RESPONSE_SIZE,
-                      timeoutMillis);
+  ret = SDI12ReadLine(line, sizeof(line), timeoutMillis);
   if (ret != SDI12_OK) {
     return ret;
   }
@@ -131,7 +362,7 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
   // Check if the addresses match from the response above.
   // The response from a teros is the same every
   // time so we're going to leave it for now
-  ret = ParseMeasurementResponse(meas_resp_buffer, addr, measurement_info);
+  ret = ParseMeasurementResponse(line, addr, measurement_info);
 
   if (ret != SDI12_OK) {
     return ret;
@@ -140,31 +371,23 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
   // Construct a command to send the data
   size = snprintf(sendData, sizeof(sendData), "%cD0!", addr);
 
-  // optimization
-  if (measurement_info->Time == 0) {  // If data is ready now
-    SDI12SendCommand(sendData, size);
-    // hard coded for a teros measurement response size
-    ret = SDI12ReadData(measurement_data, MEASURMENT_DATA_SIZE, timeoutMillis);
-    return ret;
-  }
-
   //
   // Blocks until the sensor sends the service request, noted by a "a\r\n"
   //
 
-  char service_request_resp[SERVICE_REQUEST_SIZE];
-
-  // Read the service request, wait's for one to arrive
-  ret =
-      SDI12ReadData(service_request_resp, SERVICE_REQUEST_SIZE, timeoutMillis);
-  if (ret != SDI12_OK) {
-    return ret;
-  }
+  // optimization, skip the service request if data is ready now
+  if (measurement_info->Time != 0) {
+    // Read the service request, wait's for one to arrive
+    ret = SDI12ReadLine(line, sizeof(line), timeoutMillis);
+    if (ret != SDI12_OK) {
+      return ret;
+    }
 
-  // make sure the service request is correct
-  ret = ParseServiceRequest(service_request_resp, measurement_info->Address);
-  if (ret != SDI12_OK) {
-    return ret;
+    // make sure the service request is correct
+    ret = ParseServiceRequest(line, measurement_info->Address);
+    if (ret != SDI12_OK) {
+      return ret;
+    }
   }
 
   //
@@ -172,24 +395,16 @@ SDI12Status SDI12GetMeasurement(uint8_t addr,
   //
 
   SDI12SendCommand(sendData, size);
-  ret = SDI12ReadData(measurement_data, MEASURMENT_DATA_SIZE, timeoutMillis);
-
-  if ((ret == SDI12_OK) || (ret == SDI12_TIMEOUT_ON_READ)) {
-    // remove trailing characters after \r\n
-    char *end = strstr(measurement_data, "\r\n");
-
-    if (!end) {
-      return SDI12_ERROR;
-    }
+  ret = SDI12ReadLine(line, sizeof(line), timeoutMillis);
+  if (ret != SDI12_OK) {
+    return ret;
+  }
 
-    *end = '\0';
+  // remove trailing \r\n
+  StripLine(line);
+  strcpy(measurement_data, line);
 
-    return SDI12_OK;
-  }
-  // IT IS VERY IMPORTANT THAT THE AMOUNT OF DATA EXPECTED
-  // TO BE READ (bufferSize) MATCH WHAT IS SENT EXACTLY.
-  // Or maybe slightly smaller, but any greater causes the program to hang
-  return ret;
+  return SDI12_OK;
 }
 
 SDI12Status SDI12GetAddress(char *addr, uint16_t timeoutMillis) {
@@ -203,20 +418,193 @@ SDI12Status SDI12GetAddress(char *addr, uint16_t timeoutMillis) {
   }
 
   // get response
-  char resp_buffer[4] = {};
-  ret = SDI12ReadData(resp_buffer, 4, timeoutMillis);
-  if (ret == SDI12_OK || ret == SDI12_TIMEOUT_ON_READ) {
-    ret = SDI12_OK;
-  } else {
+  char resp_buffer[SDI12_LINE_SIZE] = {};
+  ret = SDI12ReadLine(resp_buffer, sizeof(resp_buffer), timeoutMillis);
+  if (ret != SDI12_OK) {
     return ret;
   }
 
   // parse the response, return error if parsing fails
-  int params = 0;
-  params = sscanf(resp_buffer, "%1c\r\n", addr);
-  if (params != 1) {
+  const char *s = resp_buffer;
+  if (!ParseChar(&s, addr)) {
     return SDI12_PARSING_ERROR;
   }
 
   return ret;
 }
+
+SDI12Status SDI12AddressFromIndex(uint32_t index, char *addr) {
+  // SDI-12 spec 1.4: 0-9 (48-57), A-Z (65-90), a-z (97-122)
+  switch (index) {
+    case 0 ... 9:  // default address is '0'. Also fix common user error of not
+                   // putting the ascii decimal for '0'-'9'.
+      *addr = index + '0';
+      return SDI12_OK;
+    case '0' ... '9':
+    case 'A' ... 'Z':
+    case 'a' ... 'z':
+      *addr = index;
+      return SDI12_OK;
+    default:
+      return SDI12_PARSING_ERROR;
+  }
+}
+
+/**
+ * @brief Find the measurement in progress for a sensor
+ *
+ * @return NULL if the sensor is not measuring
+ */
+static SDI12AsyncMeasurement *FindMeasurement(char addr) {
+  for (int i = 0; i < SDI12_MAX_MEASUREMENTS; i++) {
+    if (measurements[i].state != SDI12_ASYNC_IDLE &&
+        measurements[i].addr == addr) {
+      return &measurements[i];
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Release the bus if held by the measurement
+ */
+static void ReleaseBus(const SDI12AsyncMeasurement *meas) {
+  if (bus_owner == meas->addr) {
+    bus_owner = '\0';
+  }
+}
+
+/**
+ * @brief End a measurement and release its bus
+ */
+static void Finish(SDI12AsyncMeasurement *meas) {
+  ReleaseBus(meas);
+  meas->state = SDI12_ASYNC_IDLE;
+}
+
+AsyncStatus SDI12MeasureStart(char addr, bool concurrent, bool crc,
+                              uint32_t *wait_ms) {
+  if (bus_owner != '\0' || FindMeasurement(addr) != NULL) {
+    return ASYNC_BUSY;
+  }
+
+  SDI12AsyncMeasurement *meas = NULL;
+  for (int i = 0; i < SDI12_MAX_MEASUREMENTS; i++) {
+    if (measurements[i].state == SDI12_ASYNC_IDLE) {
+      meas = &measurements[i];
+      break;
+    }
+  }
+  if (meas == NULL) {
+    return ASYNC_BUSY;
+  }
+
+  // the break and marking finish while sleeping
+  bus_owner = addr;
+  SendBreak();
+  meas->state = SDI12_ASYNC_WAKE_MEASURE;
+  meas->addr = addr;
+  meas->concurrent = concurrent;
+  meas->crc = crc;
+  *wait_ms = WAKE_TIME;
+
+  return ASYNC_WAIT;
+}
+
+AsyncStatus SDI12MeasurePoll(char addr, char *data, size_t size,
+                             uint32_t *wait_ms) {
+  char cmd[5];
+  uint8_t cmd_len = 0;
+  char resp[SDI12_LINE_SIZE];
+  SDI12Status ret = SDI12_OK;
+
+  SDI12AsyncMeasurement *meas = FindMeasurement(addr);
+  if (meas == NULL) {
+    return ASYNC_ERROR;
+  }
+
+  switch (meas->state) {
+    case SDI12_ASYNC_WAKE_MEASURE:
+      // request a measurement, the response is "atttn\r\n" for aM! and
+      // "atttnn\r\n" for aC!, the C suffix requests a CRC on the data
+      cmd_len = snprintf(cmd, sizeof(cmd), "%c%c%s!", addr,
+                         meas->concurrent ? 'C' : 'M', meas->crc ? "C" : "");
+      ret = Transmit(cmd, cmd_len);
+      if (ret == SDI12_OK) {
+        ret = SDI12ReadLine(resp, sizeof(resp), ASYNC_READ_TIMEOUT);
+      }
+      if (ret == SDI12_OK) {
+        if (meas->concurrent) {
+          ret = ParseConcurrentResponse(resp, addr, &meas->info);
+        } else {
+          ret = ParseMeasurementResponse(resp, addr, &meas->info);
+        }
+      }
+      if (ret != SDI12_OK) {
+        Finish(meas);
+        return ASYNC_ERROR;
+      }
+
+      // other sensors can be addressed during a concurrent measurement
+      if (meas->concurrent) {
+        ReleaseBus(meas);
+      }
+
+      // sleep until the data is guaranteed to be ready instead of listening
+      // for the service request
+      meas->state = SDI12_ASYNC_MEASURING;
+      *wait_ms = (uint32_t)meas->info.Time * 1000;
+      return ASYNC_WAIT;
+
+    case SDI12_ASYNC_MEASURING:
+      // wait for another sensor to finish its command
+      if (bus_owner != '\0' && bus_owner != addr) {
+        *wait_ms = WAKE_TIME;
+        return ASYNC_WAIT;
+      }
+
+      bus_owner = addr;
+      SendBreak();
+      meas->state = SDI12_ASYNC_WAKE_DATA;
+      *wait_ms = WAKE_TIME;
+      return ASYNC_WAIT;
+
+    case SDI12_ASYNC_WAKE_DATA: {
+      Finish(meas);
+
+      cmd_len = snprintf(cmd, sizeof(cmd), "%cD0!", addr);
+      ret = Transmit(cmd, cmd_len);
+      if (ret != SDI12_OK) {
+        return ASYNC_ERROR;
+      }
+
+      ret = SDI12ReadLine(resp, sizeof(resp), ASYNC_READ_TIMEOUT);
+      if (ret != SDI12_OK) {
+        return ASYNC_ERROR;
+      }
+
+      StripLine(resp);
+      if (meas->crc && SDI12CheckCrc(resp) != SDI12_OK) {
+        return ASYNC_ERROR;
+      }
+      if (strlen(resp) >= size) {
+        return ASYNC_ERROR;
+      }
+      strcpy(data, resp);
+
+      return ASYNC_DONE;
+    }
+
+    default:
+      Finish(meas);
+      return ASYNC_ERROR;
+  }
+}
+
+void SDI12MeasureCancel(char addr) {
+  SDI12AsyncMeasurement *meas = FindMeasurement(addr);
+  if (meas != NULL) {
+    Finish(meas);
+  }
+}
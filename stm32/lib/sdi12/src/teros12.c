@@ -1,24 +1,56 @@
+#define APP_LOG_MODULE SDI12
+
 #include "teros12.h"
 
+#include "calibration.h"
+#include "parse.h"
 #include "sensor.h"
 #include "userConfig.h"
 
+/** Max length of a measurement string, 0+1846.16+22.3+20000 */
+#define TEROS12_MEASUREMENT_LEN 20
+
+/** Result of the last async measurement */
+static Teros12Data async_data = {};
+
+/**
+ * @brief Encode a Teros12 measurement
+ *
+ * The vwc, vwc_adj and temp measurements are added to the upload queue and the
+ * ec measurement is returned in @p data.
+ *
+ * @see SensorsPrototypeMeasure
+ */
+static size_t Encode(uint8_t *data, SysTime_t ts,
+                     EnabledSensorMultiple *sensor,
+                     const Teros12Data *sens_data);
+
 SDI12Status Teros12ParseMeasurement(const char *buffer, Teros12Data *data) {
-  // parse string and check number of characters parsed
-  int rc = sscanf(buffer, "%1c+%f%f+%d", &data->addr, &data->vwc, &data->temp,
-                  &data->ec);
-  if (rc < 4) {
+  char addr = 0;
+  q32_t vwc = 0;
+  q32_t temp = 0;
+  int32_t ec = 0;
+
+  // parse string, same as "%1c+%f%f+%d"
+  const char *s = buffer;
+  if (!ParseChar(&s, &addr) || !ParseLiteral(&s, "+") ||
+      !ParseFixed(&s, &vwc) || !ParseFixed(&s, &temp) ||
+      !ParseLiteral(&s, "+") || !ParseInt(&s, &ec)) {
     return SDI12_PARSING_ERROR;
   }
 
+  // assign data to struct
+  data->addr = addr;
+  data->vwc = vwc;
+  data->temp = temp;
+  data->ec = ec;
+
   return SDI12_OK;
 }
 
 SDI12Status Teros12GetMeasurement(char addr, Teros12Data *data) {
   // buffer to store measurement
-  // based on the measurement range of the device the max string length is
-  // 0+1846.16+22.3+20000 = 20
-  char buffer[20];
+  char buffer[TEROS12_MEASUREMENT_LEN + 1];
 
   // status messages
   SDI12Status status = SDI12_OK;
@@ -45,42 +77,37 @@ size_t Teros12Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   Teros12Data sens_data = {};
   SDI12Status status = SDI12_OK;
 
-  const UserConfiguration *cfg = UserConfigGet();
-
-  // SDI-12 spec 1.4: 0-9 (48-57), A-Z (65-90), a-z (97-122)
   char sdi12_address = '0';
-
-  switch (sensor->index) {
-    case 0 ... 9:  // default address is '0'. Also fix common user error of not
-                   // putting the ascii decimal for '0'-'9'.
-      sdi12_address = sensor->index + '0';
-      break;
-    case '0' ... '9':
-    case 'A' ... 'Z':
-    case 'a' ... 'z':
-      sdi12_address = sensor->index;
-      break;
-    default:
-      APP_LOG(TS_ON, VLEVEL_H,
-              "Invalid SDI-12 address provided in the userconfig index field: "
-              "0x%X ('%c')\r\n",
-              sensor->index, sensor->index);
-      return -1;
-      break;
+  if (SDI12AddressFromIndex(sensor->index, &sdi12_address) != SDI12_OK) {
+    APP_LOG(TS_ON, VLEVEL_H,
+            "Invalid SDI-12 address provided in the userconfig index field: "
+            "0x%X ('%c')\r\n",
+            sensor->index, sensor->index);
+    return -1;
   }
+
   status = Teros12GetMeasurement(sdi12_address, &sens_data);
   APP_LOG(TS_ON, VLEVEL_H,
           "\tTeros12GetMeasurement() return %d (vwc=%f, temp=%f, ec=%d)\r\n",
-          status, sens_data.vwc, sens_data.temp, sens_data.ec);
+          status, Q32ToDouble(sens_data.vwc), Q32ToDouble(sens_data.temp),
+          sens_data.ec);
   if (status != SDI12_OK) {
     return -1;
   }
 
+  return Encode(data, ts, sensor, &sens_data);
+}
+
+static size_t Encode(uint8_t *data, SysTime_t ts,
+                     EnabledSensorMultiple *sensor,
+                     const Teros12Data *sens_data) {
+  const UserConfiguration *cfg = UserConfigGet();
+
   // calibration equation for mineral soils from Teros12 user manual and scale
   // to percent scale
   // https://publications.metergroup.com/Manuals/20587_TEROS11-12_Manual_Web.pdf?_gl=1*174xdyp*_gcl_au*MTIxODkwMzcuMTc0MTIwMjU3Nw..
-  float vwc_adj = (3.879e-4 * sens_data.vwc) - 0.6956;
-  vwc_adj *= 100;
+  const double vwc_adj = Q32ToDouble(CalibrationApply(
+      CalibrationGet(SensorType_TEROS12_VWC_ADJ), sens_data->vwc));
   APP_LOG(TS_ON, VLEVEL_H, "\tvwc_adj == %f \r\n", vwc_adj);
 
   // metadata
@@ -94,8 +121,9 @@ size_t Teros12Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   SensorStatus sen_status = SENSOR_OK;
 
   // vwc
-  sen_status = EncodeDoubleMeasurement(meta, sens_data.vwc,
-                                       SensorType_TEROS12_VWC, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sens_data->vwc),
+                              SensorType_TEROS12_VWC, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
@@ -110,15 +138,16 @@ size_t Teros12Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   SensorsAddMeasurement(data, data_len);
 
   // temp
-  sen_status = EncodeDoubleMeasurement(
-      meta, sens_data.temp, SensorType_TEROS12_TEMP, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sens_data->temp),
+                              SensorType_TEROS12_TEMP, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
   SensorsAddMeasurement(data, data_len);
 
   // ec
-  sen_status = EncodeUint32Measurement(meta, sens_data.ec,
+  sen_status = EncodeUint32Measurement(meta, sens_data->ec,
                                        SensorType_TEROS12_EC, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
@@ -126,3 +155,65 @@ size_t Teros12Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
 
   return data_len;
 }
+
+/**
+ * @brief Get the SDI-12 address from the sensor configuration
+ */
+static SDI12Status Address(const void *ctx, char *addr) {
+  const EnabledSensorMultiple *sensor = ctx;
+  return SDI12AddressFromIndex(sensor->index, addr);
+}
+
+/**
+ * @brief Start a concurrent measurement with CRC on the SDI-12 bus
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus MeasureStart(void *ctx, uint32_t *wait_ms) {
+  char sdi12_address = '0';
+  if (Address(ctx, &sdi12_address) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  return SDI12MeasureStart(sdi12_address, true, true, wait_ms);
+}
+
+/**
+ * @brief Continue the measurement and parse the result when done
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus MeasurePoll(void *ctx, uint32_t *wait_ms) {
+  char sdi12_address = '0';
+  char buffer[TEROS12_MEASUREMENT_LEN + 1];
+
+  if (Address(ctx, &sdi12_address) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  const AsyncStatus status =
+      SDI12MeasurePoll(sdi12_address, buffer, sizeof(buffer), wait_ms);
+  if (status != ASYNC_DONE) {
+    return status;
+  }
+
+  if (Teros12ParseMeasurement(buffer, &async_data) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  return ASYNC_DONE;
+}
+
+static void MeasureCancel(void *ctx) {
+  char sdi12_address = '0';
+  if (Address(ctx, &sdi12_address) == SDI12_OK) {
+    SDI12MeasureCancel(sdi12_address);
+  }
+}
+
+const AsyncDriver Teros12Async = {MeasureStart, MeasurePoll, MeasureCancel};
+
+size_t Teros12Encode(uint8_t *data, SysTime_t ts, uint32_t idx,
+                     EnabledSensorMultiple *sensor) {
+  return Encode(data, ts, sensor, &async_data);
+}
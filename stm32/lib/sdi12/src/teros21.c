@@ -1,17 +1,39 @@
+#define APP_LOG_MODULE SDI12
+
 #include "teros21.h"
 
+#include "parse.h"
 #include "sensor.h"
 #include "sensors.h"
 #include "userConfig.h"
 
+/** Max length of a measurement string */
+#define TEROS21_MEASUREMENT_LEN 17
+
+/** Result of the last async measurement */
+static Teros21Data async_data = {};
+
+/**
+ * @brief Encode a Teros21 measurement
+ *
+ * The matric potential is added to the upload queue and the temperature is
+ * returned in @p data.
+ *
+ * @see SensorsPrototypeMeasure
+ */
+static size_t Encode(uint8_t *data, SysTime_t ts,
+                     EnabledSensorMultiple *sensor,
+                     const Teros21Data *sens_data);
+
 SDI12Status Teros21ParseMeasurement(const char *buffer, Teros21Data *data) {
   char addr = 0;
-  float matric_pot = 0.;
-  float temp = 0.;
+  q32_t matric_pot = 0;
+  q32_t temp = 0;
 
-  // parse string
-  int rc = sscanf(buffer, "%1c-%f%f", &addr, &matric_pot, &temp);
-  if (rc < 3) {
+  // parse string, same as "%1c-%f%f"
+  const char *s = buffer;
+  if (!ParseChar(&s, &addr) || !ParseLiteral(&s, "-") ||
+      !ParseFixed(&s, &matric_pot) || !ParseFixed(&s, &temp)) {
     return SDI12_PARSING_ERROR;
   }
 
@@ -25,7 +47,7 @@ SDI12Status Teros21ParseMeasurement(const char *buffer, Teros21Data *data) {
 
 SDI12Status Teros21GetMeasurement(char addr, Teros21Data *data) {
   // buffer to store measurement
-  char buffer[18];
+  char buffer[TEROS21_MEASUREMENT_LEN + 1];
 
   // status messages
   SDI12Status status = SDI12_OK;
@@ -52,34 +74,28 @@ size_t Teros21Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   Teros21Data sens_data = {};
   SDI12Status status = SDI12_OK;
 
-  const UserConfiguration *cfg = UserConfigGet();
-
-  // SDI-12 spec 1.4: 0-9 (48-57), A-Z (65-90), a-z (97-122)
   char sdi12_address = '0';
-
-  switch (sensor->index) {
-    case 0 ... 9:  // default address is '0'. Also fix common user error of not
-                   // putting the ascii decimal for '0'-'9'.
-      sdi12_address = sensor->index + '0';
-      break;
-    case '0' ... '9':
-    case 'A' ... 'Z':
-    case 'a' ... 'z':
-      sdi12_address = sensor->index;
-      break;
-    default:
-      APP_LOG(TS_ON, VLEVEL_H,
-              "Invalid SDI-12 address provided in the userconfig index field: "
-              "0x%X ('%c')\r\n",
-              sensor->index, sensor->index);
-      return -1;
-      break;
+  if (SDI12AddressFromIndex(sensor->index, &sdi12_address) != SDI12_OK) {
+    APP_LOG(TS_ON, VLEVEL_H,
+            "Invalid SDI-12 address provided in the userconfig index field: "
+            "0x%X ('%c')\r\n",
+            sensor->index, sensor->index);
+    return -1;
   }
+
   status = Teros21GetMeasurement(sdi12_address, &sens_data);
   if (status != SDI12_OK) {
     return -1;
   }
 
+  return Encode(data, ts, sensor, &sens_data);
+}
+
+static size_t Encode(uint8_t *data, SysTime_t ts,
+                     EnabledSensorMultiple *sensor,
+                     const Teros21Data *sens_data) {
+  const UserConfiguration *cfg = UserConfigGet();
+
   // metadata
   Metadata meta = Metadata_init_zero;
   meta.ts = ts.Seconds;
@@ -91,7 +107,7 @@ size_t Teros21Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
 
   // matric potential
   sen_status =
-      EncodeDoubleMeasurement(meta, sens_data.matric_pot,
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sens_data->matric_pot),
                               SensorType_TEROS21_MATRIC_POT, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
@@ -99,11 +115,74 @@ size_t Teros21Measure(uint8_t *data, SysTime_t ts, uint32_t idx,
   SensorsAddMeasurement(data, data_len);
 
   // temperature
-  sen_status = EncodeDoubleMeasurement(
-      meta, sens_data.temp, SensorType_TEROS21_TEMP, data, &data_len);
+  sen_status =
+      EncodeDoubleMeasurement(meta, Q32ToDouble(sens_data->temp),
+                              SensorType_TEROS21_TEMP, data, &data_len);
   if (sen_status != SENSOR_OK) {
     return -1;
   }
 
   return data_len;
 }
+
+/**
+ * @brief Get the SDI-12 address from the sensor configuration
+ */
+static SDI12Status Address(const void *ctx, char *addr) {
+  const EnabledSensorMultiple *sensor = ctx;
+  return SDI12AddressFromIndex(sensor->index, addr);
+}
+
+/**
+ * @brief Start a concurrent measurement with CRC on the SDI-12 bus
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus MeasureStart(void *ctx, uint32_t *wait_ms) {
+  char sdi12_address = '0';
+  if (Address(ctx, &sdi12_address) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  return SDI12MeasureStart(sdi12_address, true, true, wait_ms);
+}
+
+/**
+ * @brief Continue the measurement and parse the result when done
+ *
+ * @see AsyncStep
+ */
+static AsyncStatus MeasurePoll(void *ctx, uint32_t *wait_ms) {
+  char sdi12_address = '0';
+  char buffer[TEROS21_MEASUREMENT_LEN + 1];
+
+  if (Address(ctx, &sdi12_address) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  const AsyncStatus status =
+      SDI12MeasurePoll(sdi12_address, buffer, sizeof(buffer), wait_ms);
+  if (status != ASYNC_DONE) {
+    return status;
+  }
+
+  if (Teros21ParseMeasurement(buffer, &async_data) != SDI12_OK) {
+    return ASYNC_ERROR;
+  }
+
+  return ASYNC_DONE;
+}
+
+static void MeasureCancel(void *ctx) {
+  char sdi12_address = '0';
+  if (Address(ctx, &sdi12_address) == SDI12_OK) {
+    SDI12MeasureCancel(sdi12_address);
+  }
+}
+
+const AsyncDriver Teros21Async = {MeasureStart, MeasurePoll, MeasureCancel};
+
+size_t Teros21Encode(uint8_t *data, SysTime_t ts, uint32_t idx,
+                     EnabledSensorMultiple *sensor) {
+  return Encode(data, ts, sensor, &async_data);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file aggregate.h
+ * @brief Windowed summaries of sensor measurements
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_AGGREGATE_H_
+#define LIB_SENSORS_INCLUDE_AGGREGATE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sensor.pb.h"
+
+/**
+ * @ingroup sensors
+ * @defgroup aggregate Aggregate
+ * @brief Replaces raw samples with min/mean/max/stddev over a window
+ *
+ * Sensors measured far more often than the data is looked at spend most of the
+ * uplink on samples nobody needs individually. A window is kept for every
+ * (sensor, type) pair and each numeric sample is folded into it with Welford's
+ * algorithm, so the memory does not depend on the window length. A window is
+ * closed after aggregate_count samples, or by the first sample at least
+ * aggregate_period seconds after the first sample of the window. Either limit
+ * is disabled by 0. The closed window is returned as a Summary measurement
+ * carrying the metadata of its first sample.
+ *
+ * Samples that are not numeric, or that arrive while every window is in use,
+ * are returned as raw so nothing is dropped.
+ *
+ * The module has no hardware dependencies, see extras/aggregation for a host
+ * replay of the uplink size.
+ *
+ * @{
+ */
+
+#ifndef AGGREGATE_MAX_STREAMS
+/** Max number of windows open at the same time */
+#define AGGREGATE_MAX_STREAMS 16
+#endif /* AGGREGATE_MAX_STREAMS */
+
+/** Running statistics of a window */
+typedef struct {
+  /** Number of samples */
+  uint32_t count;
+  /** Running mean */
+  double mean;
+  /** Sum of squared differences from the mean */
+  double m2;
+  /** Smallest sample */
+  double min;
+  /** Largest sample */
+  double max;
+} Welford;
+
+/** Open window of a single (sensor, type) pair */
+typedef struct {
+  /** Set while the window holds samples */
+  bool used;
+  /** Index of the sensor as returned by SensorsAdd */
+  uint8_t sensor;
+  /** Type of the measurement */
+  SensorType type;
+  /** Metadata of the first sample */
+  Metadata meta;
+  /** Index of the first sample */
+  uint32_t idx;
+  /** Statistics of the samples */
+  Welford stats;
+} AggregateStream;
+
+/** All open windows */
+typedef struct {
+  AggregateStream streams[AGGREGATE_MAX_STREAMS];
+} Aggregator;
+
+typedef enum {
+  /** Sample is not aggregated and is uploaded as is */
+  AGGREGATE_RAW = 0,
+  /** Sample was added to its window */
+  AGGREGATE_HELD,
+  /** A window closed and the summary is uploaded instead of the sample */
+  AGGREGATE_SUMMARY,
+} AggregateStatus;
+
+/**
+ * @brief Clear the statistics
+ *
+ * @param stats Statistics
+ */
+void WelfordReset(Welford *stats);
+
+/**
+ * @brief Add a sample to the statistics
+ *
+ * @param stats Statistics
+ * @param x Sample
+ */
+void WelfordAdd(Welford *stats, double x);
+
+/**
+ * @brief Sample standard deviation
+ *
+ * @param stats Statistics
+ *
+ * @return Standard deviation, 0 with less than two samples
+ */
+double WelfordStddev(const Welford *stats);
+
+/**
+ * @brief Drop all open windows
+ *
+ * @param agg Aggregator
+ */
+void AggregateInit(Aggregator *agg);
+
+/**
+ * @brief Add a measurement to the window of its sensor and type
+ *
+ * @param agg Aggregator
+ * @param sensor Index of the sensor
+ * @param count Samples per window, 0 to disable
+ * @param period Window length in seconds, 0 to disable
+ * @param meas Decoded measurement
+ * @param summary Summary of the closed window when returning
+ * AGGREGATE_SUMMARY
+ *
+ * @return Whether @p meas is uploaded, held or replaced by @p summary
+ */
+AggregateStatus AggregateAdd(Aggregator *agg, uint8_t sensor, uint32_t count,
+                             uint32_t period, const SensorMeasurement *meas,
+                             SensorMeasurement *summary);
+
+/**
+ * @brief Close one open window regardless of its limits
+ *
+ * Call until it returns false to upload partial windows, for example before
+ * the sensors are stopped.
+ *
+ * @param agg Aggregator
+ * @param summary Summary of the closed window
+ *
+ * @return false if no window is open
+ */
+bool AggregateFlush(Aggregator *agg, SensorMeasurement *summary);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_AGGREGATE_H_
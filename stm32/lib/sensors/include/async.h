@@ -0,0 +1,183 @@
+/**
+ * @file async.h
+ * @brief Non-blocking sensor measurements
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_ASYNC_H_
+#define LIB_SENSORS_INCLUDE_ASYNC_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @ingroup sensors
+ * @defgroup async Async
+ * @brief Runs sensor drivers as state machines instead of blocking waits
+ *
+ * Sensors such as the ADS1219 or SDI-12 probes spend most of a measurement
+ * waiting for a conversion. A blocking driver keeps the MCU running through
+ * every wait, and the waits of all sensors add up. An async driver splits the
+ * measurement into a start and any number of polls. Each step returns how long
+ * to wait before the next one. The queue interleaves the steps of all
+ * submitted drivers so conversions overlap, and the caller sleeps until the
+ * earliest wakeup returned by AsyncNext.
+ *
+ * Drivers sharing a bus return ASYNC_BUSY from start while another
+ * measurement holds the bus. The start is retried after any other task was
+ * polled or finished, since that step may have released the bus, and
+ * otherwise after ASYNC_BUSY_RETRY ms.
+ *
+ * The module has no hardware dependencies, see extras/scheduling for a host
+ * simulation of the awake time.
+ *
+ * @{
+ */
+
+#ifndef ASYNC_MAX_TASKS
+/** Max number of measurements in flight */
+#define ASYNC_MAX_TASKS 32
+#endif /* ASYNC_MAX_TASKS */
+
+#ifndef ASYNC_BUSY_RETRY
+/** Time in ms before a busy start is retried if no task finishes */
+#define ASYNC_BUSY_RETRY 100
+#endif /* ASYNC_BUSY_RETRY */
+
+/** Max passes over the queue in a single AsyncRun */
+#define ASYNC_MAX_PASSES 8
+
+typedef enum {
+  /** Measurement finished */
+  ASYNC_DONE = 0,
+  /** Call poll after the returned wait */
+  ASYNC_WAIT,
+  /** Bus is held by another measurement, start again later */
+  ASYNC_BUSY,
+  /** Measurement failed */
+  ASYNC_ERROR,
+} AsyncStatus;
+
+/**
+ * @brief Step of an async driver
+ *
+ * @param ctx Context passed to AsyncSubmit
+ * @param wait_ms Time until the next step when returning ASYNC_WAIT
+ */
+typedef AsyncStatus (*AsyncStep)(void *ctx, uint32_t *wait_ms);
+
+/** Async driver, the same instance is shared by all sensors of a type */
+typedef struct {
+  /** Starts a measurement */
+  AsyncStep start;
+  /** Continues a started measurement */
+  AsyncStep poll;
+  /** Aborts a started measurement and releases its bus, can be NULL */
+  void (*cancel)(void *ctx);
+} AsyncDriver;
+
+/**
+ * @brief Called when a task finishes with ASYNC_DONE or ASYNC_ERROR
+ *
+ * @param id Id passed to AsyncSubmit
+ * @param status Final status
+ */
+typedef void (*AsyncDone)(uint8_t id, AsyncStatus status);
+
+/** Source of the current time in ms */
+typedef uint32_t (*AsyncClock)(void);
+
+typedef enum {
+  /** Start on the next run */
+  ASYNC_TASK_PENDING = 0,
+  /** Started, poll at wake */
+  ASYNC_TASK_WAITING,
+  /** Start returned ASYNC_BUSY, retry at wake */
+  ASYNC_TASK_BLOCKED,
+} AsyncTaskState;
+
+/** Measurement in flight */
+typedef struct {
+  /** Driver of the sensor */
+  const AsyncDriver *driver;
+  /** Context passed to the driver */
+  void *ctx;
+  /** Time of the next step in ms */
+  uint32_t wake;
+  /** Caller defined id */
+  uint8_t id;
+  /** Current state */
+  AsyncTaskState state;
+} AsyncTask;
+
+/** Measurements in flight in submission order */
+typedef struct {
+  AsyncTask tasks[ASYNC_MAX_TASKS];
+  uint8_t len;
+} AsyncQueue;
+
+/**
+ * @brief Remove all tasks without cancelling them
+ *
+ * @param queue Queue
+ */
+void AsyncInit(AsyncQueue *queue);
+
+/**
+ * @brief Queue a measurement, started by the next AsyncRun
+ *
+ * @param queue Queue
+ * @param driver Driver of the sensor
+ * @param ctx Context passed to the driver
+ * @param id Id passed to the done callback
+ *
+ * @return false if the queue is full
+ */
+bool AsyncSubmit(AsyncQueue *queue, const AsyncDriver *driver, void *ctx,
+                 uint8_t id);
+
+/**
+ * @brief Run every step that is due
+ *
+ * Pending tasks are started and waiting tasks past their wake time are polled.
+ * Blocked tasks are retried in the same run after another task was polled.
+ * Steps can take time, so @p clock is read before every pass.
+ *
+ * @param queue Queue
+ * @param clock Current time in ms
+ * @param done Called for every finished task
+ */
+void AsyncRun(AsyncQueue *queue, AsyncClock clock, AsyncDone done);
+
+/**
+ * @brief Get the time of the earliest step
+ *
+ * @param queue Queue
+ * @param wake Earliest wake time in ms
+ *
+ * @return false if no task is waiting
+ */
+bool AsyncNext(const AsyncQueue *queue, uint32_t *wake);
+
+/**
+ * @brief Cancel all started tasks and empty the queue
+ *
+ * @param queue Queue
+ */
+void AsyncCancel(AsyncQueue *queue);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_ASYNC_H_
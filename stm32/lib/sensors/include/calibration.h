@@ -0,0 +1,99 @@
+/**
+ * @file calibration.h
+ * @brief Per sensor type calibration in fixed point
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_CALIBRATION_H_
+#define LIB_SENSORS_INCLUDE_CALIBRATION_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include "fixed.h"
+#include "sensor.pb.h"
+
+/**
+ * @ingroup sensors
+ * @defgroup calibration Calibration
+ * @brief Linear conversions from raw readings keyed by SensorType
+ *
+ * Each measurement type has a slope and offset in Q32.32 converting the raw
+ * reading of its driver into the reported unit. The defaults are constants
+ * folded from the equations in the datasheets, so no float math runs on the
+ * device. Coefficients that come from the user configuration, such as the
+ * ADS1219 calibration, override the defaults at runtime with CalibrationSet.
+ *
+ * Types without an entry convert with the identity.
+ *
+ * @{
+ */
+
+#ifndef CALIBRATION_MAX_OVERRIDES
+/** Max number of types calibrated at runtime */
+#define CALIBRATION_MAX_OVERRIDES 8
+#endif /* CALIBRATION_MAX_OVERRIDES */
+
+/** Linear conversion y = m * x + b */
+typedef struct {
+  /** Slope */
+  q32_t m;
+  /** Offset */
+  q32_t b;
+} Calibration;
+
+/** Calibration of a single measurement type */
+typedef struct {
+  SensorType type;
+  Calibration cal;
+} CalibrationEntry;
+
+/**
+ * @brief Get the calibration of a measurement type
+ *
+ * Runtime overrides take precedence over the defaults.
+ *
+ * @param type Measurement type
+ *
+ * @return Calibration, the identity if the type has none
+ */
+const Calibration *CalibrationGet(SensorType type);
+
+/**
+ * @brief Override the calibration of a measurement type
+ *
+ * @param type Measurement type
+ * @param cal Calibration
+ *
+ * @return false if every override is in use
+ */
+bool CalibrationSet(SensorType type, const Calibration *cal);
+
+/**
+ * @brief Drop all runtime overrides
+ */
+void CalibrationClear(void);
+
+/**
+ * @brief Apply a calibration
+ *
+ * @param cal Calibration
+ * @param x Raw reading
+ *
+ * @return m * x + b, saturated
+ */
+q32_t CalibrationApply(const Calibration *cal, q32_t x);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_CALIBRATION_H_
@@ -0,0 +1,138 @@
+/**
+ * @file deadband.h
+ * @brief Send-on-delta filtering of sensor measurements
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_DEADBAND_H_
+#define LIB_SENSORS_INCLUDE_DEADBAND_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "sensor.pb.h"
+
+/**
+ * @ingroup sensors
+ * @defgroup deadband Deadband
+ * @brief Drops samples that did not move since the last stored one
+ *
+ * Channels such as soil temperature or leaf wetness sit flat for hours. The
+ * last stored value of every (sensor, type) pair is kept, and a new sample is
+ * only stored if it moved by more than an absolute or relative threshold, or
+ * if no sample was stored for the heartbeat. A missing sample therefore means
+ * the value stayed within the deadband of the previous one, and the heartbeat
+ * bounds how long that can go unconfirmed.
+ *
+ * The reference only moves once the caller confirms the sample was stored
+ * with DeadbandUpdate, so a sample lost to a full buffer is not filtered
+ * against. The entries are plain data so the caller can mirror the updated
+ * entry to FRAM and restore all of them after a reset.
+ *
+ * Samples that are not numeric, or that arrive while every entry is in use,
+ * are always stored.
+ *
+ * The module has no hardware dependencies, see extras/deadband for a host
+ * replay of the FIFO and airtime savings.
+ *
+ * @{
+ */
+
+#ifndef DEADBAND_MAX_STREAMS
+/** Max number of (sensor, type) pairs that are filtered */
+#define DEADBAND_MAX_STREAMS 16
+#endif /* DEADBAND_MAX_STREAMS */
+
+/** Last stored sample of a (sensor, type) pair */
+typedef struct {
+  /** Set once a sample was stored */
+  bool used;
+  /** Index of the sensor as returned by SensorsAdd */
+  uint8_t sensor;
+  /** Type of the measurement */
+  SensorType type;
+  /** Cell of the measurement, a new cell resets the entry */
+  uint32_t cell_id;
+  /** Timestamp of the stored sample */
+  uint32_t ts;
+  /** Value of the stored sample */
+  double value;
+} DeadbandEntry;
+
+/** Last stored samples */
+typedef struct {
+  DeadbandEntry entries[DEADBAND_MAX_STREAMS];
+} Deadband;
+
+/** Thresholds of a sensor */
+typedef struct {
+  /** Absolute threshold in the units of the measurement */
+  float absolute;
+  /** Relative threshold as a fraction of the last stored value */
+  float relative;
+  /** Max time in seconds without a stored sample, 0 disables */
+  uint32_t heartbeat;
+} DeadbandLimits;
+
+/**
+ * @brief Forget all stored samples
+ *
+ * @param db Deadband
+ */
+void DeadbandInit(Deadband *db);
+
+/**
+ * @brief Check if the limits filter anything
+ *
+ * @param limits Thresholds of a sensor
+ *
+ * @return false if every sample is stored
+ */
+bool DeadbandEnabled(const DeadbandLimits *limits);
+
+/**
+ * @brief Decide if a measurement is stored
+ *
+ * A sample is stored if it is the first of its (sensor, type), if it moved by
+ * more than limits->absolute or more than limits->relative times the last
+ * stored value, or if limits->heartbeat seconds passed since the last stored
+ * sample. With both thresholds 0 any change is stored.
+ *
+ * @param db Deadband
+ * @param sensor Index of the sensor
+ * @param limits Thresholds of the sensor
+ * @param meas Decoded measurement
+ * @param entry Entry to pass to DeadbandUpdate once @p meas is stored, -1 if
+ * the measurement is not tracked
+ *
+ * @return true if @p meas is stored
+ */
+bool DeadbandCheck(const Deadband *db, uint8_t sensor,
+                   const DeadbandLimits *limits, const SensorMeasurement *meas,
+                   int *entry);
+
+/**
+ * @brief Record a stored measurement as the reference of its entry
+ *
+ * @param db Deadband
+ * @param entry Entry from DeadbandCheck
+ * @param sensor Index of the sensor
+ * @param meas Stored measurement
+ */
+void DeadbandUpdate(Deadband *db, int entry, uint8_t sensor,
+                    const SensorMeasurement *meas);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_DEADBAND_H_
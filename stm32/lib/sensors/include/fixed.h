@@ -0,0 +1,170 @@
+/**
+ * @file fixed.h
+ * @brief Fixed point arithmetic for sensor conversions
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_FIXED_H_
+#define LIB_SENSORS_INCLUDE_FIXED_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+ * @ingroup sensors
+ * @defgroup fixed Fixed
+ * @brief Q16.16 and Q32.32 arithmetic without soft float
+ *
+ * The STM32WLE5 has no FPU, so every float or double operation is a call into
+ * the soft float library. Conversions of raw sensor readings are done in fixed
+ * point instead. Q16.16 (q16_t) covers small ranges such as temperatures and
+ * flow rates, Q32.32 (q32_t) is used for calibration coefficients and values
+ * that need more range or resolution, such as raw ADS1219 codes.
+ *
+ * Every operation rounds to nearest and saturates instead of overflowing.
+ * Conversions from float and to double work on the IEEE 754 bits directly, so
+ * the only soft float left is in the protobuf encoding of the final value.
+ *
+ * Constants are written with Q16_CONST and Q32_CONST, which the compiler
+ * folds when the argument is a constant expression.
+ *
+ * The module has no hardware dependencies, see extras/fixed_point for a host
+ * comparison against the double reference.
+ *
+ * @{
+ */
+
+/** Q16.16 signed fixed point */
+typedef int32_t q16_t;
+
+/** Q32.32 signed fixed point */
+typedef int64_t q32_t;
+
+/** 1.0 in Q16.16 */
+#define Q16_ONE ((q16_t)1 << 16)
+
+/** 1.0 in Q32.32 */
+#define Q32_ONE ((q32_t)1 << 32)
+
+/** Largest Q16.16 value */
+#define Q16_MAX INT32_MAX
+
+/** Smallest Q16.16 value */
+#define Q16_MIN INT32_MIN
+
+/** Largest Q32.32 value */
+#define Q32_MAX INT64_MAX
+
+/** Smallest Q32.32 value */
+#define Q32_MIN INT64_MIN
+
+/** Q16.16 of a constant expression, rounded to nearest */
+#define Q16_CONST(x) ((q16_t)((x) * 65536.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+/** Q32.32 of a constant expression, rounded to nearest */
+#define Q32_CONST(x) ((q32_t)((x) * 4294967296.0 + ((x) < 0 ? -0.5 : 0.5)))
+
+/**
+ * @brief Convert an integer to Q16.16, saturating
+ */
+q16_t Q16FromInt(int32_t x);
+
+/**
+ * @brief Multiply two Q16.16 values
+ */
+q16_t Q16Mul(q16_t a, q16_t b);
+
+/**
+ * @brief Divide two Q16.16 values
+ *
+ * Division by zero saturates in the direction of @p a.
+ */
+q16_t Q16Div(q16_t a, q16_t b);
+
+/**
+ * @brief Convert an integer to Q32.32
+ */
+static inline q32_t Q32FromInt(int32_t x) { return (q32_t)x * Q32_ONE; }
+
+/**
+ * @brief Convert a Q16.16 value to Q32.32
+ */
+static inline q32_t Q32FromQ16(q16_t x) { return (q32_t)x * Q16_ONE; }
+
+/**
+ * @brief Convert a Q32.32 value to Q16.16, saturating
+ */
+q16_t Q16FromQ32(q32_t x);
+
+/**
+ * @brief Round a Q32.32 value to the nearest integer, saturating
+ */
+int32_t Q32Round(q32_t x);
+
+/**
+ * @brief Add two Q32.32 values, saturating
+ */
+q32_t Q32Add(q32_t a, q32_t b);
+
+/**
+ * @brief Multiply two Q32.32 values
+ */
+q32_t Q32Mul(q32_t a, q32_t b);
+
+/**
+ * @brief Q32.32 of a ratio of integers
+ *
+ * Used for means of integer sums without losing the fraction.
+ *
+ * @param num Numerator
+ * @param den Denominator, 0 saturates in the direction of @p num
+ */
+q32_t Q32FromRatio(int64_t num, int64_t den);
+
+/**
+ * @brief Square root of a Q32.32 value
+ *
+ * @return 0 for negative values
+ */
+q32_t Q32Sqrt(q32_t x);
+
+/**
+ * @brief Q32.32 square root of a ratio of integers
+ *
+ * Used for the RMS of a sum of squares that does not fit in Q32.32.
+ *
+ * @param num Numerator
+ * @param den Denominator, 0 returns Q32_MAX
+ */
+q32_t Q32SqrtRatio(uint64_t num, uint64_t den);
+
+/**
+ * @brief Convert a float to Q32.32 from its bits, saturating
+ *
+ * Used for values from the user configuration. NaN converts to 0.
+ */
+q32_t Q32FromFloat(float x);
+
+/**
+ * @brief Convert a Q32.32 value to the nearest double from its bits
+ */
+double Q32ToDouble(q32_t x);
+
+/**
+ * @brief Convert a Q32.32 value to the nearest float from its bits
+ */
+float Q32ToFloat(q32_t x);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_FIXED_H_
@@ -0,0 +1,127 @@
+/**
+ * @file parse.h
+ * @brief Single pass parsers for sensor response strings
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_PARSE_H_
+#define LIB_SENSORS_INCLUDE_PARSE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "fixed.h"
+
+/**
+ * @ingroup sensors
+ * @defgroup parse Parse
+ * @brief Tokenizers replacing sscanf for sensor responses
+ *
+ * Sensors such as the Teros12 reply with strings like "0+1846.16+22.3+20000"
+ * that used to be parsed with sscanf. Besides being slow and using a lot of
+ * stack, the %f conversion pulls the float scanf support and the soft float
+ * library into the image. These functions parse the same fields in a single
+ * pass without allocating, and decimal values go straight into Q32.32.
+ *
+ * Each function takes a cursor into the string and advances it past the
+ * parsed field. On failure the cursor and the output are left untouched.
+ * Parsers are composed to follow a sscanf format, see Teros12ParseMeasurement
+ * for an example.
+ *
+ * The accepted input matches the sscanf conversion each function replaces,
+ * with the exceptions listed per function. extras/sscanf_free has a fuzzer
+ * checking the sensor parsers against sscanf.
+ *
+ * @{
+ */
+
+/**
+ * @brief Parse a single character, same as %1c
+ *
+ * @param str Cursor
+ * @param c Parsed character
+ *
+ * @return false at the end of the string
+ */
+bool ParseChar(const char **str, char *c);
+
+/**
+ * @brief Match a literal, same as literal text in a sscanf format
+ *
+ * Whitespace in @p lit matches any amount of whitespace, including none.
+ *
+ * @param str Cursor
+ * @param lit Literal
+ *
+ * @return false if the string does not match
+ */
+bool ParseLiteral(const char **str, const char *lit);
+
+/**
+ * @brief Parse an unsigned integer of limited width, same as %<width>u
+ *
+ * Leading whitespace is skipped. Unlike sscanf a sign is not accepted, as the
+ * fields it is used for are unsigned digits.
+ *
+ * @param str Cursor
+ * @param width Max number of digits
+ * @param value Parsed value, saturated to UINT32_MAX
+ *
+ * @return false if there are no digits
+ */
+bool ParseUint(const char **str, size_t width, uint32_t *value);
+
+/**
+ * @brief Parse a signed integer, same as %d
+ *
+ * Leading whitespace is skipped.
+ *
+ * @param str Cursor
+ * @param value Parsed value, saturated to the int32_t range
+ *
+ * @return false if there are no digits
+ */
+bool ParseInt(const char **str, int32_t *value);
+
+/**
+ * @brief Parse a decimal value into Q32.32, same as %f
+ *
+ * Leading whitespace is skipped. Accepts an optional sign followed by digits
+ * with an optional decimal point, such as the "+1846.16" values of SDI-12.
+ * Unlike sscanf, exponents, infinity and NaN are not accepted. Digits past the
+ * 18th after the decimal point are skipped.
+ *
+ * @param str Cursor
+ * @param value Parsed value rounded to nearest, saturated to +/- Q32_MAX
+ *
+ * @return false if there are no digits
+ */
+bool ParseFixed(const char **str, q32_t *value);
+
+/**
+ * @brief Parse a token up to a delimiter, same as %<size - 1>[^<stop>]
+ *
+ * @param str Cursor
+ * @param stop Delimiter, not consumed
+ * @param token Buffer for the token, null terminated
+ * @param size Size of @p token
+ *
+ * @return false if the token is empty
+ */
+bool ParseToken(const char **str, char stop, char *token, size_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_PARSE_H_
@@ -0,0 +1,133 @@
+/**
+ * @file schedule.h
+ * @brief Min-heap of periodic deadlines driven by a single timer
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_SENSORS_INCLUDE_SCHEDULE_H_
+#define LIB_SENSORS_INCLUDE_SCHEDULE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @ingroup sensors
+ * @defgroup schedule Schedule
+ * @brief Tracks when each sensor is next due
+ *
+ * Every entry has a period and the absolute time it is next due. Entries are
+ * kept in a binary min-heap ordered by due time so the next wakeup is always
+ * the root, and only one hardware timer is needed for any number of sensors.
+ *
+ * When the timer fires every entry due within the coalescing window is popped
+ * at once. Sensors with close deadlines are measured in the same wakeup instead
+ * of waking the MCU separately for each, at the cost of measuring some of them
+ * up to the window early. Popped entries are rescheduled from their nominal due
+ * time so early or late wakeups do not accumulate drift. Periods that were
+ * missed entirely, for example while the radio was busy, are skipped.
+ *
+ * Times are in ms and compared with wrapping arithmetic, so periods must be
+ * shorter than SCHEDULE_MAX_PERIOD.
+ *
+ * The module has no hardware dependencies, see extras/scheduling for a host
+ * simulation.
+ *
+ * @{
+ */
+
+#ifndef SCHEDULE_MAX_ENTRIES
+/** Max number of entries in a schedule */
+#define SCHEDULE_MAX_ENTRIES 32
+#endif /* SCHEDULE_MAX_ENTRIES */
+
+#ifndef SCHEDULE_WINDOW
+/** Default coalescing window in ms */
+#define SCHEDULE_WINDOW 1000
+#endif /* SCHEDULE_WINDOW */
+
+/** Longest period that can be compared with wrapping arithmetic */
+#define SCHEDULE_MAX_PERIOD ((uint32_t)INT32_MAX)
+
+/** Single periodic deadline */
+typedef struct {
+  /** Time the entry is next due in ms */
+  uint32_t due;
+  /** Period in ms */
+  uint32_t period;
+  /** Caller defined id, returned by SchedulePopDue */
+  uint8_t id;
+} ScheduleEntry;
+
+/** Heap of deadlines */
+typedef struct {
+  /** Entries ordered as a binary min-heap on due */
+  ScheduleEntry heap[SCHEDULE_MAX_ENTRIES];
+  /** Number of entries */
+  uint8_t len;
+  /** Entries due within this many ms of the root are popped together */
+  uint32_t window;
+} Schedule;
+
+/**
+ * @brief Remove all entries
+ *
+ * @param schedule Schedule
+ * @param window Coalescing window in ms
+ */
+void ScheduleInit(Schedule *schedule, uint32_t window);
+
+/**
+ * @brief Add a periodic entry
+ *
+ * @param schedule Schedule
+ * @param id Id returned when the entry is due
+ * @param period Period in ms, between 1 and SCHEDULE_MAX_PERIOD
+ * @param due Time of the first deadline in ms
+ *
+ * @return false if the schedule is full or the period is out of range
+ */
+bool ScheduleAdd(Schedule *schedule, uint8_t id, uint32_t period,
+                 uint32_t due);
+
+/**
+ * @brief Get the time of the earliest deadline
+ *
+ * @param schedule Schedule
+ * @param due Earliest deadline in ms
+ *
+ * @return false if the schedule is empty
+ */
+bool ScheduleNext(const Schedule *schedule, uint32_t *due);
+
+/**
+ * @brief Pop every entry due by @p now plus the coalescing window
+ *
+ * Popped entries are rescheduled to their first deadline after the window so
+ * an entry is returned at most once per call. Ids are returned in ascending
+ * order.
+ *
+ * @param schedule Schedule
+ * @param now Current time in ms
+ * @param ids Array to store the ids of due entries
+ * @param max Size of @p ids, entries beyond it stay due
+ *
+ * @return Number of ids stored
+ */
+size_t SchedulePopDue(Schedule *schedule, uint32_t now, uint8_t *ids,
+                      size_t max);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_SENSORS_INCLUDE_SCHEDULE_H_
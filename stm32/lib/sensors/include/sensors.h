@@ -8,6 +8,7 @@
 #ifndef LIB_SENSORS_INCLUDE_SENSORS_H_
 #define LIB_SENSORS_INCLUDE_SENSORS_H_
 
+#include "async.h"
 #include "fifo.h"
 #include "lora_app.h"
 #include "soil_power_sensor.pb.h"
@@ -27,12 +28,16 @@ extern "C" {
  * and uploading them to the server
  *
  * Provides an interface for querying sensors and adding the measurements to the
- * transmit buffer. Functions to query sensors are registered and called on a
- * interval that is global to all sensors.
+ * transmit buffer. Functions to query sensors are registered and called on the
+ * period set for each sensor in EnabledSensorMultiple, falling back to the
+ * upload interval. A single timer is set to the earliest deadline and sensors
+ * due within SCHEDULE_WINDOW of it are measured in the same wakeup, see
+ * schedule.h.
  *
  * The library expects all initialization code for registered sensors to be
- * called before SensorsStart. The timer utility library (UTIL_TIMER_Init) and
- * sequencer utility (UTIL_SEQ_Init) must be initialized as well.
+ * called before SensorsStart and SensorsInit to be called before SensorsAdd.
+ * The timer utility library (UTIL_TIMER_Init) and sequencer utility
+ * (UTIL_SEQ_Init) must be initialized as well.
  *
  * Currently there is no way to modify or remove sensors after adding the
  * callback function. This is based on the assumption sensors are not going
@@ -51,8 +56,22 @@ extern "C" {
 #define MAX_SENSORS 32
 #endif /* MAX_SENSORS */
 
+#ifndef SENSORS_DEADBAND_SIZE
+/** Bytes of FRAM reserved for the deadband mirror, magic and entries */
+#define SENSORS_DEADBAND_SIZE 388
+#endif /* SENSORS_DEADBAND_SIZE */
+
+#ifndef SENSORS_DEADBAND_ADDR
+/**
+ * FRAM address of the deadband mirror, between the end of the FRAM buffer and
+ * the sequence number stored before the user config length
+ */
+#define SENSORS_DEADBAND_ADDR \
+  (USER_CONFIG_LEN_ADDR - 4 - SENSORS_DEADBAND_SIZE)
+#endif /* SENSORS_DEADBAND_ADDR */
+
 #ifndef MEASUREMENT_PERIOD
-/** The amount of time between measurements */
+/** Measurement period in ms used when the upload interval is not set */
 #define MEASUREMENT_PERIOD 15000
 #endif /* MEASUREMENT_PERIOD */
 
@@ -76,6 +95,7 @@ void SensorsInit(void);
 /**
  * @brief Starts timer to take measurements and add to upload queue
  *
+ * The phase of each sensor is relative to this call.
  */
 void SensorsStart(void);
 
@@ -88,12 +108,33 @@ void SensorsStop(void);
 /**
  * @brief Adds sensor call to measurement cycle
  *
+ * The period and phase of @p sensor are read when added. A NULL @p sensor is
+ * measured every upload interval.
+ *
  * @param cb Callback to the measurement function
+ * @param sensor Sensor configuration passed to @p cb
  *
  * @return Index of callback in internal array, -1 indicates an error
  */
 int SensorsAdd(SensorsPrototypeMeasure cb, EnabledSensorMultiple *sensor);
 
+/**
+ * @brief Adds an async sensor to the measurement cycle
+ *
+ * The measurement is submitted to an AsyncQueue when the sensor is due, so its
+ * waits overlap with other sensors and the MCU sleeps in between. When the
+ * driver finishes, @p encode serializes the result the same way a callback
+ * registered with SensorsAdd does.
+ *
+ * @param driver Async driver of the sensor
+ * @param encode Serializes the last result of @p driver
+ * @param sensor Sensor configuration, passed to @p driver and @p encode
+ *
+ * @return Index of the sensor, -1 if the max number of sensors is reached
+ */
+int SensorsAddAsync(const AsyncDriver *driver, SensorsPrototypeMeasure encode,
+                    EnabledSensorMultiple *sensor);
+
 /**
  * @brief Manually add a measurement to the upload queue.
  *
@@ -101,6 +142,15 @@ int SensorsAdd(SensorsPrototypeMeasure cb, EnabledSensorMultiple *sensor);
  * additional measurements. For example the Teros12 sensors measures three
  * separate phenomena that requires separate measurement encodings.
  *
+ * Within a callback, sensors with aggregate_count or aggregate_period set in
+ * EnabledSensorMultiple fold the measurement into a window instead, and a
+ * Summary is added when the window closes, see aggregate.h. Sensors with a
+ * deadband or heartbeat only add the measurement if it moved since the last
+ * one added, see deadband.h.
+ *
+ * Measurements added while SensorsMeasure runs are staged in RAM and put into
+ * the tx buffer together at the end of the measurement cycle.
+ *
  * @param data Serialized measurement data.
  * @param data_len Length of serialized measurement data.
  */
@@ -0,0 +1,171 @@
+/**
+ * @file aggregate.c
+ *
+ * @see aggregate.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "aggregate.h"
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief Get the value of a numeric measurement
+ *
+ * @return false if the measurement has no numeric value
+ */
+static bool Value(const SensorMeasurement *meas, double *x) {
+  switch (meas->which_value) {
+    case SensorMeasurement_unsigned_int_tag:
+      *x = meas->value.unsigned_int;
+      return true;
+    case SensorMeasurement_signed_int_tag:
+      *x = meas->value.signed_int;
+      return true;
+    case SensorMeasurement_decimal_tag:
+      *x = meas->value.decimal;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Find the window of a sensor and type, opening a new one if needed
+ *
+ * @return NULL if every window is in use
+ */
+static AggregateStream *Find(Aggregator *agg, uint8_t sensor,
+                             SensorType type) {
+  AggregateStream *free_stream = NULL;
+
+  for (size_t i = 0; i < AGGREGATE_MAX_STREAMS; i++) {
+    AggregateStream *stream = &agg->streams[i];
+    if (!stream->used) {
+      if (free_stream == NULL) {
+        free_stream = stream;
+      }
+      continue;
+    }
+    if (stream->sensor == sensor && stream->type == type) {
+      return stream;
+    }
+  }
+
+  if (free_stream != NULL) {
+    free_stream->used = true;
+    free_stream->sensor = sensor;
+    free_stream->type = type;
+    WelfordReset(&free_stream->stats);
+  }
+
+  return free_stream;
+}
+
+/**
+ * @brief Write the summary of a window and empty it
+ */
+static void Close(AggregateStream *stream, SensorMeasurement *summary) {
+  memset(summary, 0, sizeof(*summary));
+  summary->has_meta = true;
+  summary->meta = stream->meta;
+  summary->type = stream->type;
+  summary->idx = stream->idx;
+  summary->which_value = SensorMeasurement_summary_tag;
+
+  Summary *s = &summary->value.summary;
+  s->count = stream->stats.count;
+  s->min = (float)stream->stats.min;
+  s->mean = (float)stream->stats.mean;
+  s->max = (float)stream->stats.max;
+  s->stddev = (float)WelfordStddev(&stream->stats);
+
+  WelfordReset(&stream->stats);
+}
+
+void WelfordReset(Welford *stats) { memset(stats, 0, sizeof(*stats)); }
+
+void WelfordAdd(Welford *stats, double x) {
+  if (stats->count == 0) {
+    stats->min = x;
+    stats->max = x;
+  } else {
+    if (x < stats->min) {
+      stats->min = x;
+    }
+    if (x > stats->max) {
+      stats->max = x;
+    }
+  }
+
+  ++stats->count;
+  const double delta = x - stats->mean;
+  stats->mean += delta / stats->count;
+  stats->m2 += delta * (x - stats->mean);
+}
+
+double WelfordStddev(const Welford *stats) {
+  if (stats->count < 2) {
+    return 0.0;
+  }
+  return sqrt(stats->m2 / (stats->count - 1));
+}
+
+void AggregateInit(Aggregator *agg) { memset(agg, 0, sizeof(*agg)); }
+
+AggregateStatus AggregateAdd(Aggregator *agg, uint8_t sensor, uint32_t count,
+                             uint32_t period, const SensorMeasurement *meas,
+                             SensorMeasurement *summary) {
+  double x = 0.0;
+  if ((count == 0 && period == 0) || !Value(meas, &x)) {
+    return AGGREGATE_RAW;
+  }
+
+  AggregateStream *stream = Find(agg, sensor, meas->type);
+  if (stream == NULL) {
+    return AGGREGATE_RAW;
+  }
+
+  AggregateStatus status = AGGREGATE_HELD;
+
+  // the sample past the end of the window starts the next one
+  if (period > 0 && stream->stats.count > 0 &&
+      meas->meta.ts - stream->meta.ts >= period) {
+    Close(stream, summary);
+    status = AGGREGATE_SUMMARY;
+  }
+
+  if (stream->stats.count == 0) {
+    stream->meta = meas->meta;
+    stream->idx = meas->idx;
+  }
+  WelfordAdd(&stream->stats, x);
+
+  // a window restarted by the period holds a single sample, it reaches count
+  // here only if count is 1 and then no window is left open for the period
+  if (count > 0 && stream->stats.count >= count) {
+    Close(stream, summary);
+    stream->used = false;
+    status = AGGREGATE_SUMMARY;
+  }
+
+  return status;
+}
+
+bool AggregateFlush(Aggregator *agg, SensorMeasurement *summary) {
+  for (size_t i = 0; i < AGGREGATE_MAX_STREAMS; i++) {
+    AggregateStream *stream = &agg->streams[i];
+    if (!stream->used) {
+      continue;
+    }
+
+    // windows in use always hold at least one sample
+    Close(stream, summary);
+    stream->used = false;
+    return true;
+  }
+
+  return false;
+}
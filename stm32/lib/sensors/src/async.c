@@ -0,0 +1,138 @@
+/**
+ * @file async.c
+ *
+ * @see async.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "async.h"
+
+/**
+ * @brief Check if time @p a is before time @p b, accounting for wrap around
+ */
+static bool Before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+/**
+ * @brief Remove a task keeping the submission order
+ */
+static void Remove(AsyncQueue *queue, size_t i) {
+  for (size_t j = i + 1; j < queue->len; j++) {
+    queue->tasks[j - 1] = queue->tasks[j];
+  }
+  --queue->len;
+}
+
+void AsyncInit(AsyncQueue *queue) { queue->len = 0; }
+
+bool AsyncSubmit(AsyncQueue *queue, const AsyncDriver *driver, void *ctx,
+                 uint8_t id) {
+  if (queue->len >= ASYNC_MAX_TASKS) {
+    return false;
+  }
+
+  AsyncTask *task = &queue->tasks[queue->len++];
+  task->driver = driver;
+  task->ctx = ctx;
+  task->wake = 0;
+  task->id = id;
+  task->state = ASYNC_TASK_PENDING;
+
+  return true;
+}
+
+void AsyncRun(AsyncQueue *queue, AsyncClock clock, AsyncDone done) {
+  // blocked tasks are retried right after another task may have released
+  // its bus
+  bool retry_blocked = false;
+
+  for (int pass = 0; pass < ASYNC_MAX_PASSES; pass++) {
+    const uint32_t now = clock();
+    bool stepped = false;
+    bool polled = false;
+
+    size_t i = 0;
+    while (i < queue->len) {
+      AsyncTask *task = &queue->tasks[i];
+
+      bool due = false;
+      switch (task->state) {
+        case ASYNC_TASK_PENDING:
+          due = true;
+          break;
+        case ASYNC_TASK_WAITING:
+          due = !Before(now, task->wake);
+          break;
+        case ASYNC_TASK_BLOCKED:
+          due = retry_blocked || !Before(now, task->wake);
+          break;
+      }
+      if (!due) {
+        ++i;
+        continue;
+      }
+
+      stepped = true;
+      uint32_t wait = 0;
+      AsyncStatus status = ASYNC_ERROR;
+      if (task->state == ASYNC_TASK_WAITING) {
+        polled = true;
+        status = task->driver->poll(task->ctx, &wait);
+        // only a start can be refused
+        if (status == ASYNC_BUSY) {
+          status = ASYNC_ERROR;
+        }
+      } else {
+        status = task->driver->start(task->ctx, &wait);
+      }
+
+      if (status == ASYNC_WAIT) {
+        task->state = ASYNC_TASK_WAITING;
+        task->wake = clock() + wait;
+        ++i;
+      } else if (status == ASYNC_BUSY) {
+        task->state = ASYNC_TASK_BLOCKED;
+        task->wake = clock() + ASYNC_BUSY_RETRY;
+        ++i;
+      } else {
+        const uint8_t id = task->id;
+        Remove(queue, i);
+        polled = true;
+        done(id, status);
+      }
+    }
+
+    if (!stepped) {
+      break;
+    }
+    retry_blocked = polled;
+  }
+}
+
+bool AsyncNext(const AsyncQueue *queue, uint32_t *wake) {
+  bool found = false;
+
+  for (size_t i = 0; i < queue->len; i++) {
+    const AsyncTask *task = &queue->tasks[i];
+    if (task->state == ASYNC_TASK_PENDING) {
+      continue;
+    }
+    if (!found || Before(task->wake, *wake)) {
+      *wake = task->wake;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+void AsyncCancel(AsyncQueue *queue) {
+  for (size_t i = 0; i < queue->len; i++) {
+    const AsyncTask *task = &queue->tasks[i];
+    if (task->state == ASYNC_TASK_WAITING && task->driver->cancel != NULL) {
+      task->driver->cancel(task->ctx);
+    }
+  }
+
+  queue->len = 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file calibration.c
+ *
+ * @see calibration.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "calibration.h"
+
+#include <stddef.h>
+
+/** Reference voltage of the internal ADC in V */
+#define ADC_VREF 3.3
+
+/** Full scale code of the 12 bit internal ADC */
+#define ADC_FULL_SCALE 4095
+
+/**
+ * Default calibrations
+ *
+ * The inputs are the raw readings passed by the drivers.
+ */
+static const CalibrationEntry defaults[] = {
+    // uncalibrated ADS1219 codes, voltage is reported in V, overridden by
+    // ADC_init
+    {SensorType_POWER_VOLTAGE, {Q32_CONST(1.0 / 1000), 0}},
+    // vwc from calibrated counts for mineral soils in percent, see the
+    // Teros12 user manual
+    {SensorType_TEROS12_VWC_ADJ,
+     {Q32_CONST(3.879e-4 * 100), Q32_CONST(-0.6956 * 100)}},
+    // flow in L/min from pulses per SubSeconds / 6000, the sensor outputs 7.5
+    // pulses per L/min
+    {SensorType_YFS210C_FLOW, {Q32_CONST(6000.0 / 7.5), 0}},
+    // tension in kPa from ADC code, 0 - 239 kPa from 0 - 2.8 V,
+    // kPa = V / 0.0117
+    {SensorType_WATERMARK200SS_SOIL_TENSION,
+     {Q32_CONST(ADC_VREF / ADC_FULL_SCALE / 0.0117), 0}},
+    // temperature in C from ADC code, 20 - 132 F from 0.49 - 2.8 V,
+    // F = 50.68 * (V - 0.490) + 20
+    {SensorType_WATERMARK200TS_SOIL_TEMPERATURE,
+     {Q32_CONST(ADC_VREF / ADC_FULL_SCALE * 50.68 * 5.0 / 9.0),
+      Q32_CONST((20 - (50.68 * 0.490) - 32) * 5.0 / 9.0)}},
+};
+
+/** Identity for types without a calibration */
+static const Calibration identity = {Q32_ONE, 0};
+
+/** Calibrations set at runtime */
+static CalibrationEntry overrides[CALIBRATION_MAX_OVERRIDES];
+
+/** Number of used @ref overrides */
+static size_t overrides_len = 0;
+
+const Calibration *CalibrationGet(SensorType type) {
+  for (size_t i = 0; i < overrides_len; i++) {
+    if (overrides[i].type == type) {
+      return &overrides[i].cal;
+    }
+  }
+
+  for (size_t i = 0; i < sizeof(defaults) / sizeof(defaults[0]); i++) {
+    if (defaults[i].type == type) {
+      return &defaults[i].cal;
+    }
+  }
+
+  return &identity;
+}
+
+bool CalibrationSet(SensorType type, const Calibration *cal) {
+  for (size_t i = 0; i < overrides_len; i++) {
+    if (overrides[i].type == type) {
+      overrides[i].cal = *cal;
+      return true;
+    }
+  }
+
+  if (overrides_len >= CALIBRATION_MAX_OVERRIDES) {
+    return false;
+  }
+
+  overrides[overrides_len].type = type;
+  overrides[overrides_len].cal = *cal;
+  ++overrides_len;
+
+  return true;
+}
+
+void CalibrationClear(void) { overrides_len = 0; }
+
+q32_t CalibrationApply(const Calibration *cal, q32_t x) {
+  return Q32Add(Q32Mul(cal->m, x), cal->b);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file deadband.c
+ *
+ * @see deadband.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "deadband.h"
+
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief Get the value of a numeric measurement
+ *
+ * @return false if the measurement has no numeric value
+ */
+static bool Value(const SensorMeasurement *meas, double *x) {
+  switch (meas->which_value) {
+    case SensorMeasurement_unsigned_int_tag:
+      *x = meas->value.unsigned_int;
+      return true;
+    case SensorMeasurement_signed_int_tag:
+      *x = meas->value.signed_int;
+      return true;
+    case SensorMeasurement_decimal_tag:
+      *x = meas->value.decimal;
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Find the entry of a sensor and type
+ *
+ * @return Index of the entry, a free entry if there is none or -1 if every
+ * entry is in use
+ */
+static int Find(const Deadband *db, uint8_t sensor, SensorType type) {
+  int free_entry = -1;
+
+  for (int i = 0; i < DEADBAND_MAX_STREAMS; i++) {
+    const DeadbandEntry *entry = &db->entries[i];
+    if (!entry->used) {
+      if (free_entry < 0) {
+        free_entry = i;
+      }
+      continue;
+    }
+    if (entry->sensor == sensor && entry->type == type) {
+      return i;
+    }
+  }
+
+  return free_entry;
+}
+
+/**
+ * @brief Check if a sample moved out of the deadband of the stored one
+ */
+static bool Moved(const DeadbandEntry *entry, const DeadbandLimits *limits,
+                  double x) {
+  const double delta = fabs(x - entry->value);
+
+  if (limits->absolute <= 0 && limits->relative <= 0) {
+    return delta > 0;
+  }
+
+  if (limits->absolute > 0 && delta > limits->absolute) {
+    return true;
+  }
+
+  return limits->relative > 0 && delta > limits->relative * fabs(entry->value);
+}
+
+void DeadbandInit(Deadband *db) { memset(db, 0, sizeof(*db)); }
+
+bool DeadbandEnabled(const DeadbandLimits *limits) {
+  return limits->absolute > 0 || limits->relative > 0 ||
+         limits->heartbeat > 0;
+}
+
+bool DeadbandCheck(const Deadband *db, uint8_t sensor,
+                   const DeadbandLimits *limits, const SensorMeasurement *meas,
+                   int *entry) {
+  *entry = -1;
+
+  double x = 0.0;
+  if (!DeadbandEnabled(limits) || !Value(meas, &x)) {
+    return true;
+  }
+
+  const int i = Find(db, sensor, meas->type);
+  if (i < 0) {
+    return true;
+  }
+  *entry = i;
+
+  const DeadbandEntry *last = &db->entries[i];
+  if (!last->used || last->cell_id != meas->meta.cell_id) {
+    return true;
+  }
+
+  // a clock that went backwards wraps around and expires the heartbeat
+  if (limits->heartbeat > 0 && meas->meta.ts - last->ts >= limits->heartbeat) {
+    return true;
+  }
+
+  return Moved(last, limits, x);
+}
+
+void DeadbandUpdate(Deadband *db, int entry, uint8_t sensor,
+                    const SensorMeasurement *meas) {
+  double x = 0.0;
+  if (entry < 0 || entry >= DEADBAND_MAX_STREAMS || !Value(meas, &x)) {
+    return;
+  }
+
+  DeadbandEntry *e = &db->entries[entry];
+  e->used = true;
+  e->sensor = sensor;
+  e->type = meas->type;
+  e->cell_id = meas->meta.cell_id;
+  e->ts = meas->meta.ts;
+  e->value = x;
+}
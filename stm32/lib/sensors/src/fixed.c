@@ -0,0 +1,322 @@
+/**
+ * @file fixed.c
+ *
+ * @see fixed.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "fixed.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * @brief Magnitude of a signed value, valid for INT64_MIN
+ */
+static uint64_t Abs64(int64_t x) {
+  return (x < 0) ? -(uint64_t)x : (uint64_t)x;
+}
+
+/**
+ * @brief Apply a sign to a magnitude, saturating to the int64_t range
+ */
+static int64_t Saturate64(uint64_t mag, bool neg) {
+  if (neg) {
+    if (mag >= (uint64_t)1 << 63) {
+      return INT64_MIN;
+    }
+    return -(int64_t)mag;
+  }
+
+  if (mag > INT64_MAX) {
+    return INT64_MAX;
+  }
+  return (int64_t)mag;
+}
+
+/**
+ * @brief Apply a sign to a magnitude, saturating to the int32_t range
+ */
+static int32_t Saturate32(uint64_t mag, bool neg) {
+  if (neg) {
+    if (mag >= (uint64_t)1 << 31) {
+      return INT32_MIN;
+    }
+    return -(int32_t)mag;
+  }
+
+  if (mag > INT32_MAX) {
+    return INT32_MAX;
+  }
+  return (int32_t)mag;
+}
+
+/**
+ * @brief Shift right rounding to nearest, ties away from zero
+ */
+static uint64_t RoundShift(uint64_t x, int shift) {
+  if (shift == 0) {
+    return x;
+  }
+  return (x >> shift) + ((x >> (shift - 1)) & 1);
+}
+
+/**
+ * @brief Integer square root rounded to nearest
+ */
+static uint64_t Isqrt(uint64_t x) {
+  uint64_t res = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > x) {
+    bit >>= 2;
+  }
+
+  while (bit != 0) {
+    if (x >= res + bit) {
+      x -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  // remainder above res means the root is closer to res + 1
+  if (x > res) {
+    ++res;
+  }
+
+  return res;
+}
+
+/**
+ * @brief Pack a Q32.32 magnitude into IEEE 754 bits
+ *
+ * @param mag Magnitude, not 0
+ * @param neg Sign
+ * @param mant_bits Explicit mantissa bits, 52 for double and 23 for float
+ * @param exp_bits Exponent bits, 11 for double and 8 for float
+ */
+static uint64_t PackIeee(uint64_t mag, bool neg, int mant_bits, int exp_bits) {
+  const int bias = (1 << (exp_bits - 1)) - 1;
+  const int msb = 63 - __builtin_clzll(mag);
+  uint64_t exp = msb - 32 + bias;
+
+  uint64_t mant = 0;
+  if (msb > mant_bits) {
+    // round to nearest, ties to even
+    const int shift = msb - mant_bits;
+    const uint64_t rem = mag & (((uint64_t)1 << shift) - 1);
+    const uint64_t half = (uint64_t)1 << (shift - 1);
+    mant = mag >> shift;
+    if (rem > half || (rem == half && (mant & 1))) {
+      ++mant;
+    }
+    // rounding carried into the next power of two
+    if (mant >> (mant_bits + 1)) {
+      mant >>= 1;
+      ++exp;
+    }
+  } else {
+    mant = mag << (mant_bits - msb);
+  }
+
+  return ((uint64_t)neg << (mant_bits + exp_bits)) | (exp << mant_bits) |
+         (mant & (((uint64_t)1 << mant_bits) - 1));
+}
+
+q16_t Q16FromInt(int32_t x) {
+  if (x > (Q16_MAX >> 16)) {
+    return Q16_MAX;
+  }
+  if (x < (Q16_MIN >> 16)) {
+    return Q16_MIN;
+  }
+  return x * Q16_ONE;
+}
+
+q16_t Q16Mul(q16_t a, q16_t b) {
+  const int64_t p = (int64_t)a * b;
+  return Saturate32(RoundShift(Abs64(p), 16), p < 0);
+}
+
+q16_t Q16Div(q16_t a, q16_t b) {
+  if (b == 0) {
+    return (a < 0) ? Q16_MIN : Q16_MAX;
+  }
+
+  const uint64_t num = Abs64(a) << 16;
+  const uint64_t den = Abs64(b);
+  return Saturate32((num + den / 2) / den, (a < 0) != (b < 0));
+}
+
+q16_t Q16FromQ32(q32_t x) {
+  return Saturate32(RoundShift(Abs64(x), 16), x < 0);
+}
+
+int32_t Q32Round(q32_t x) {
+  return Saturate32(RoundShift(Abs64(x), 32), x < 0);
+}
+
+q32_t Q32Add(q32_t a, q32_t b) {
+  q32_t sum = 0;
+  if (__builtin_add_overflow(a, b, &sum)) {
+    return (a < 0) ? Q32_MIN : Q32_MAX;
+  }
+  return sum;
+}
+
+q32_t Q32Mul(q32_t a, q32_t b) {
+  const bool neg = (a < 0) != (b < 0);
+  const uint64_t ua = Abs64(a);
+  const uint64_t ub = Abs64(b);
+  const uint64_t a1 = ua >> 32;
+  const uint64_t a0 = ua & UINT32_MAX;
+  const uint64_t b1 = ub >> 32;
+  const uint64_t b0 = ub & UINT32_MAX;
+
+  // (a * b) >> 32 = (a1 b1 << 32) + a1 b0 + a0 b1 + (a0 b0 >> 32)
+  const uint64_t hi = a1 * b1;
+  if (hi >> 31) {
+    return Saturate64(UINT64_MAX, neg);
+  }
+
+  const uint64_t lo = a0 * b0;
+  const uint64_t terms[] = {a1 * b0, a0 * b1, RoundShift(lo, 32)};
+
+  uint64_t mag = hi << 32;
+  for (int i = 0; i < 3; i++) {
+    if (terms[i] > UINT64_MAX - mag) {
+      return Saturate64(UINT64_MAX, neg);
+    }
+    mag += terms[i];
+  }
+
+  return Saturate64(mag, neg);
+}
+
+q32_t Q32FromRatio(int64_t num, int64_t den) {
+  if (den == 0) {
+    return (num < 0) ? Q32_MIN : Q32_MAX;
+  }
+
+  const bool neg = (num < 0) != (den < 0);
+  const uint64_t un = Abs64(num);
+  const uint64_t ud = Abs64(den);
+
+  const uint64_t q = un / ud;
+  if (q >> 31) {
+    return Saturate64(UINT64_MAX, neg);
+  }
+
+  // long division of the remainder for 32 fraction bits and a rounding bit
+  uint64_t r = un % ud;
+  uint64_t frac = 0;
+  for (int i = 0; i < 33; i++) {
+    const bool carry = r >> 63;
+    r <<= 1;
+    frac <<= 1;
+    if (carry || r >= ud) {
+      r -= ud;
+      frac |= 1;
+    }
+  }
+
+  return Saturate64((q << 32) + ((frac + 1) >> 1), neg);
+}
+
+q32_t Q32Sqrt(q32_t x) {
+  if (x <= 0) {
+    return 0;
+  }
+
+  // sqrt(x * 2^32) = sqrt(x << s) * 2^(16 - s / 2), s even and as large as
+  // possible for precision
+  int s = __builtin_clzll((uint64_t)x) & ~1;
+  if (s > 32) {
+    s = 32;
+  }
+
+  return Isqrt((uint64_t)x << s) << (16 - s / 2);
+}
+
+q32_t Q32SqrtRatio(uint64_t num, uint64_t den) {
+  if (den == 0) {
+    return Q32_MAX;
+  }
+  if (num == 0) {
+    return 0;
+  }
+
+  // sqrt(num / den) * 2^32 = sqrt((num << s) / den) * 2^(32 - s / 2)
+  const int s = __builtin_clzll(num) & ~1;
+  const int shift = 32 - s / 2;
+  const uint64_t root = Isqrt((num << s) / den);
+  if (root >> (63 - shift)) {
+    return Q32_MAX;
+  }
+
+  return root << shift;
+}
+
+q32_t Q32FromFloat(float x) {
+  uint32_t bits = 0;
+  memcpy(&bits, &x, sizeof(bits));
+
+  const bool neg = bits >> 31;
+  const int exp = (bits >> 23) & 0xff;
+  uint64_t mant = bits & 0x7fffff;
+
+  // infinity saturates and NaN has no sensible value
+  if (exp == 0xff) {
+    if (mant != 0) {
+      return 0;
+    }
+    return neg ? Q32_MIN : Q32_MAX;
+  }
+
+  // subnormals are far below the resolution
+  if (exp == 0) {
+    return 0;
+  }
+
+  // x = mant * 2^(exp - 150), so x in Q32.32 is mant * 2^(exp - 118)
+  mant |= 0x800000;
+  const int shift = exp - 118;
+  if (shift >= 40) {
+    return Saturate64(UINT64_MAX, neg);
+  }
+  if (shift >= 0) {
+    return Saturate64(mant << shift, neg);
+  }
+  if (shift < -24) {
+    return 0;
+  }
+  return Saturate64(RoundShift(mant, -shift), neg);
+}
+
+double Q32ToDouble(q32_t x) {
+  if (x == 0) {
+    return 0;
+  }
+
+  const uint64_t bits = PackIeee(Abs64(x), x < 0, 52, 11);
+
+  double d = 0;
+  memcpy(&d, &bits, sizeof(d));
+  return d;
+}
+
+float Q32ToFloat(q32_t x) {
+  if (x == 0) {
+    return 0;
+  }
+
+  const uint32_t bits = PackIeee(Abs64(x), x < 0, 23, 8);
+
+  float f = 0;
+  memcpy(&f, &bits, sizeof(f));
+  return f;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file parse.c
+ *
+ * @see parse.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "parse.h"
+
+/** Max number of fraction digits kept by ParseFixed */
+#define FRACTION_DIGITS 18
+
+/**
+ * @brief Check for whitespace, same as isspace in the C locale
+ */
+static bool IsSpace(char c) {
+  return (c == ' ') || (c >= '\t' && c <= '\r');
+}
+
+/**
+ * @brief Check for a decimal digit
+ */
+static bool IsDigit(char c) { return (c >= '0') && (c <= '9'); }
+
+/**
+ * @brief Skip whitespace
+ */
+static const char *SkipSpace(const char *s) {
+  while (IsSpace(*s)) {
+    ++s;
+  }
+  return s;
+}
+
+bool ParseChar(const char **str, char *c) {
+  if (**str == '\0') {
+    return false;
+  }
+
+  *c = **str;
+  ++*str;
+  return true;
+}
+
+bool ParseLiteral(const char **str, const char *lit) {
+  const char *s = *str;
+
+  while (*lit != '\0') {
+    if (IsSpace(*lit)) {
+      s = SkipSpace(s);
+      lit = SkipSpace(lit);
+      continue;
+    }
+
+    if (*s != *lit) {
+      return false;
+    }
+    ++s;
+    ++lit;
+  }
+
+  *str = s;
+  return true;
+}
+
+bool ParseUint(const char **str, size_t width, uint32_t *value) {
+  const char *s = SkipSpace(*str);
+
+  uint64_t v = 0;
+  size_t n = 0;
+  while (n < width && IsDigit(*s)) {
+    if (v <= UINT32_MAX) {
+      v = (v * 10) + (*s - '0');
+    }
+    ++s;
+    ++n;
+  }
+
+  if (n == 0) {
+    return false;
+  }
+
+  *value = (v > UINT32_MAX) ? UINT32_MAX : v;
+  *str = s;
+  return true;
+}
+
+bool ParseInt(const char **str, int32_t *value) {
+  const char *s = SkipSpace(*str);
+
+  bool neg = false;
+  if (*s == '+' || *s == '-') {
+    neg = (*s == '-');
+    ++s;
+  }
+
+  // magnitude of INT32_MIN
+  const uint64_t limit = (uint64_t)INT32_MAX + 1;
+  uint64_t v = 0;
+  const char *digits = s;
+  while (IsDigit(*s)) {
+    if (v <= limit) {
+      v = (v * 10) + (*s - '0');
+    }
+    ++s;
+  }
+
+  if (s == digits) {
+    return false;
+  }
+
+  if (neg) {
+    *value = (v >= limit) ? INT32_MIN : -(int32_t)v;
+  } else {
+    *value = (v > INT32_MAX) ? INT32_MAX : (int32_t)v;
+  }
+  *str = s;
+  return true;
+}
+
+bool ParseFixed(const char **str, q32_t *value) {
+  const char *s = SkipSpace(*str);
+
+  bool neg = false;
+  if (*s == '+' || *s == '-') {
+    neg = (*s == '-');
+    ++s;
+  }
+
+  bool digits = false;
+
+  uint64_t integer = 0;
+  while (IsDigit(*s)) {
+    if (integer <= INT32_MAX) {
+      integer = (integer * 10) + (*s - '0');
+    }
+    digits = true;
+    ++s;
+  }
+
+  uint64_t fraction = 0;
+  uint64_t scale = 1;
+  if (*s == '.') {
+    ++s;
+    for (int n = 0; IsDigit(*s); n++) {
+      if (n < FRACTION_DIGITS) {
+        fraction = (fraction * 10) + (*s - '0');
+        scale *= 10;
+      }
+      digits = true;
+      ++s;
+    }
+  }
+
+  if (!digits) {
+    return false;
+  }
+
+  q32_t mag = Q32_MAX;
+  if (integer <= INT32_MAX) {
+    mag = Q32Add(Q32FromInt(integer), Q32FromRatio(fraction, scale));
+  }
+
+  *value = neg ? -mag : mag;
+  *str = s;
+  return true;
+}
+
+bool ParseToken(const char **str, char stop, char *token, size_t size) {
+  const char *s = *str;
+
+  size_t n = 0;
+  while (n + 1 < size && *s != stop && *s != '\0') {
+    token[n++] = *s++;
+  }
+
+  if (n == 0) {
+    return false;
+  }
+
+  token[n] = '\0';
+  *str = s;
+  return true;
+}
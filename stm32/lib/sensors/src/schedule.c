@@ -0,0 +1,122 @@
+/**
+ * @file schedule.c
+ *
+ * @see schedule.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "schedule.h"
+
+/**
+ * @brief Check if time @p a is before time @p b, accounting for wrap around
+ */
+static bool Before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+static bool Less(const ScheduleEntry *a, const ScheduleEntry *b) {
+  if (a->due != b->due) {
+    return Before(a->due, b->due);
+  }
+  return a->id < b->id;
+}
+
+static void Swap(ScheduleEntry *a, ScheduleEntry *b) {
+  const ScheduleEntry tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+static void SiftUp(Schedule *schedule, size_t i) {
+  while (i > 0) {
+    const size_t parent = (i - 1) / 2;
+    if (!Less(&schedule->heap[i], &schedule->heap[parent])) {
+      break;
+    }
+    Swap(&schedule->heap[i], &schedule->heap[parent]);
+    i = parent;
+  }
+}
+
+static void SiftDown(Schedule *schedule, size_t i) {
+  for (;;) {
+    const size_t left = 2 * i + 1;
+    const size_t right = left + 1;
+    size_t smallest = i;
+
+    if (left < schedule->len &&
+        Less(&schedule->heap[left], &schedule->heap[smallest])) {
+      smallest = left;
+    }
+    if (right < schedule->len &&
+        Less(&schedule->heap[right], &schedule->heap[smallest])) {
+      smallest = right;
+    }
+    if (smallest == i) {
+      break;
+    }
+
+    Swap(&schedule->heap[i], &schedule->heap[smallest]);
+    i = smallest;
+  }
+}
+
+void ScheduleInit(Schedule *schedule, uint32_t window) {
+  schedule->len = 0;
+  schedule->window = window;
+}
+
+bool ScheduleAdd(Schedule *schedule, uint8_t id, uint32_t period,
+                 uint32_t due) {
+  if (schedule->len >= SCHEDULE_MAX_ENTRIES) {
+    return false;
+  }
+  if (period == 0 || period > SCHEDULE_MAX_PERIOD) {
+    return false;
+  }
+
+  ScheduleEntry *entry = &schedule->heap[schedule->len];
+  entry->due = due;
+  entry->period = period;
+  entry->id = id;
+
+  SiftUp(schedule, schedule->len++);
+
+  return true;
+}
+
+bool ScheduleNext(const Schedule *schedule, uint32_t *due) {
+  if (schedule->len == 0) {
+    return false;
+  }
+
+  *due = schedule->heap[0].due;
+  return true;
+}
+
+size_t SchedulePopDue(Schedule *schedule, uint32_t now, uint8_t *ids,
+                      size_t max) {
+  const uint32_t horizon = now + schedule->window;
+  size_t count = 0;
+
+  while (schedule->len > 0 && count < max &&
+         !Before(horizon, schedule->heap[0].due)) {
+    ScheduleEntry *root = &schedule->heap[0];
+
+    // insertion sort keeps the ids in ascending order
+    size_t i = count++;
+    while (i > 0 && ids[i - 1] > root->id) {
+      ids[i] = ids[i - 1];
+      --i;
+    }
+    ids[i] = root->id;
+
+    // next deadline after the window so the entry is not popped again and
+    // missed deadlines are skipped
+    const uint32_t elapsed = horizon - root->due;
+    root->due += (elapsed / root->period + 1) * root->period;
+
+    SiftDown(schedule, 0);
+  }
+
+  return count;
+}
@@ -29,9 +29,22 @@
  * SOFTWARE.
  */
 
+#define APP_LOG_MODULE SENSORS
+
 #include "sensors.h"
 
+#include <stdio.h>
+
+#include "aggregate.h"
+#include "async.h"
+#include "binlog.h"
+#include "deadband.h"
+#include "energy.h"
+#include "prof.h"
+#include "schedule.h"
+#include "sensor.h"
 #include "userConfig.h"
+#include "wakeup.h"
 
 #ifdef SAVE_TO_MICROSD
 #include "controller/microsd.h"
@@ -44,13 +57,76 @@ static EnabledSensorMultiple *callback_arr_context[MAX_SENSORS];
 /** Length of @ref callback_arr */
 static unsigned int callback_arr_len = 0;
 
-static const uint8_t kBufferSize = LORAWAN_APP_DATA_BUFFER_MAX_SIZE;
+/** Buffer to store serialized measurements */
+static uint8_t measure_buffer[LORAWAN_APP_DATA_BUFFER_MAX_SIZE];
+
+#if MAX_SENSORS > SCHEDULE_MAX_ENTRIES
+#error "MAX_SENSORS must not exceed SCHEDULE_MAX_ENTRIES"
+#endif
+
+/** Period of each sensor in ms */
+static uint32_t callback_arr_period[MAX_SENSORS];
 
-/** Periodic timer for querying sensors */
+/** Offset of the first measurement of each sensor in ms */
+static uint32_t callback_arr_phase[MAX_SENSORS];
+
+/** One shot timer set to the next sensor deadline */
 static UTIL_TIMER_Object_t MeasureTimer;
 
+/** Default measurement period in ms */
 static uint32_t measure_period = 0;
 
+/** Async drivers, NULL for sensors measured with a blocking callback */
+static const AsyncDriver *callback_arr_async[MAX_SENSORS];
+
+/** Timestamp of async measurements in progress */
+static SysTime_t callback_arr_ts[MAX_SENSORS];
+
+/** Set while an async measurement of the sensor is in progress */
+static bool callback_arr_pending[MAX_SENSORS];
+
+/** Profiling entry of each callback, named sensor_<index> */
+static int callback_arr_prof[MAX_SENSORS];
+
+/** Deadlines of all sensors */
+static Schedule schedule;
+
+/** Async measurements in progress */
+static AsyncQueue async_queue;
+
+/** Set between SensorsStart and SensorsStop */
+static bool running = false;
+
+/** Windows of sensors uploading summaries */
+static Aggregator aggregator;
+
+/** Index of the sensor whose callback is running, -1 outside of callbacks */
+static int current_sensor = -1;
+
+/** Last stored samples of sensors with a deadband, mirrored to FRAM */
+static Deadband deadband;
+
+/** Marks a valid deadband mirror in FRAM, change with DeadbandEntry */
+#define SENSORS_DEADBAND_MAGIC 0x44420001
+
+#if SENSORS_DEADBAND_ADDR <= FRAM_BUFFER_END
+#error "Deadband mirror overlaps the FRAM buffer"
+#endif
+
+#if SENSORS_DEADBAND_ADDR + SENSORS_DEADBAND_SIZE > USER_CONFIG_LEN_ADDR - 4
+#error "Deadband mirror overlaps the sequence number"
+#endif
+
+_Static_assert(sizeof(uint32_t) + sizeof(deadband.entries) <=
+                   SENSORS_DEADBAND_SIZE,
+               "Deadband mirror does not fit in SENSORS_DEADBAND_SIZE");
+
+/** Measurements of the current cycle, put into the tx buffer at once */
+static FramBatch batch;
+
+/** Set while measurements are staged in @ref batch */
+static bool batching = false;
+
 /** Measurement index counter */
 static uint32_t meas_idx = 1;
 
@@ -69,31 +145,144 @@ void SensorsMeasure(void);
  */
 void SensorsRun(void *arg);
 
+/**
+ * @brief Adds a serialized measurement to the microSD card and tx buffer
+ *
+ * Within a measurement cycle the measurement is staged in @ref batch and only
+ * written to the tx buffer by SensorsCommit.
+ *
+ * @param buffer Serialized measurement
+ * @param buffer_len Length of @p buffer
+ *
+ * @return true if the measurement was added or staged
+ */
+static bool SensorsStore(const uint8_t *buffer, size_t buffer_len);
+
+/**
+ * @brief Writes the staged measurements to the tx buffer
+ */
+static void SensorsCommit(void);
+
+/**
+ * @brief Encodes the summary of a closed window and stores it
+ *
+ * @param summary Summary from AggregateAdd or AggregateFlush
+ */
+static void SensorsAddSummary(const SensorMeasurement *summary);
+
+/**
+ * @brief Restores the deadband entries mirrored in FRAM
+ *
+ * The entries are cleared if the FRAM holds no valid mirror, for example on
+ * the first boot, and the mirror is rewritten.
+ */
+static void SensorsDeadbandLoad(void);
+
+/**
+ * @brief Mirrors a single deadband entry to FRAM
+ *
+ * @param entry Index of the entry
+ */
+static void SensorsDeadbandSave(int entry);
+
+/**
+ * @brief Convert seconds to ms, limited to the longest schedule period
+ */
+static uint32_t SecondsToMs(uint32_t seconds) {
+  if (seconds > SCHEDULE_MAX_PERIOD / 1000) {
+    return SCHEDULE_MAX_PERIOD;
+  }
+  return seconds * 1000;
+}
+
+/**
+ * @brief Sets the timer to the earliest sensor deadline or async step
+ *
+ * Sensor deadlines can be moved later onto the wakeup of another task, async
+ * steps are not since a bus is held until they finish. The task is run
+ * directly if the deadline already passed.
+ */
+static void SensorsArm(void) {
+  uint32_t due = 0;
+  bool armed = ScheduleNext(&schedule, &due);
+  uint32_t slack = WAKEUP_SLACK;
+
+  uint32_t wake = 0;
+  if (AsyncNext(&async_queue, &wake) &&
+      (!armed || (int32_t)(wake - due) < 0)) {
+    due = wake;
+    armed = true;
+    slack = 0;
+  }
+
+  if (!armed) {
+    return;
+  }
+
+  const uint32_t delay = WakeupAt(CFG_SEQ_Task_Measurement, due, slack);
+  if (delay == 0) {
+    SensorsRun(NULL);
+    return;
+  }
+
+  UTIL_TIMER_SetPeriod(&MeasureTimer, delay);
+  UTIL_TIMER_Start(&MeasureTimer);
+}
+
 void SensorsInit(void) {
   // set upload interval
   const UserConfiguration *cfg = UserConfigGet();
   // convert to ms
-  measure_period = cfg->Upload_interval * 1000;
+  measure_period = SecondsToMs(cfg->Upload_interval);
+  if (measure_period == 0) {
+    measure_period = MEASUREMENT_PERIOD;
+  }
 
   // registers the task
   UTIL_SEQ_RegTask((1 << CFG_SEQ_Task_Measurement), UTIL_SEQ_RFU,
                    SensorsMeasure);
 
-  // create the run timer
-  UTIL_TIMER_Create(&MeasureTimer, measure_period, UTIL_TIMER_PERIODIC,
+  // create the run timer, period is set to the next deadline when armed
+  UTIL_TIMER_Create(&MeasureTimer, measure_period, UTIL_TIMER_ONESHOT,
                     SensorsRun, NULL);
 }
 
 void SensorsStart(void) {
-  // start the timer
+  // deadlines are relative to the start of measurements
+  const uint32_t now = UTIL_TIMER_GetCurrentTime();
+  ScheduleInit(&schedule, SCHEDULE_WINDOW);
+  AsyncInit(&async_queue);
+  AggregateInit(&aggregator);
+  SensorsDeadbandLoad();
+  FramBatchInit(&batch);
+  for (int i = 0; i < callback_arr_len; i++) {
+    ScheduleAdd(&schedule, i, callback_arr_period[i],
+                now + callback_arr_phase[i]);
+    callback_arr_pending[i] = false;
+  }
+  running = true;
+
   APP_LOG(TS_OFF, VLEVEL_H, "Sensor measurement timer started.\r\n");
-  UTIL_TIMER_Start(&MeasureTimer);
-  SensorsRun(NULL);
+  SensorsArm();
 }
 
 void SensorsStop(void) {
   // stop the timer
+  running = false;
   UTIL_TIMER_Stop(&MeasureTimer);
+  WakeupCancel(CFG_SEQ_Task_Measurement);
+
+  // release buses held by async measurements
+  AsyncCancel(&async_queue);
+
+  // upload partial windows
+  batching = true;
+  SensorMeasurement summary;
+  while (AggregateFlush(&aggregator, &summary)) {
+    SensorsAddSummary(&summary);
+  }
+  SensorsCommit();
+  batching = false;
 }
 
 int SensorsAdd(SensorsPrototypeMeasure cb, EnabledSensorMultiple *sensor) {
@@ -106,61 +295,271 @@ int SensorsAdd(SensorsPrototypeMeasure cb, EnabledSensorMultiple *sensor) {
   // store callback in array
   callback_arr[callback_arr_len] = cb;
   callback_arr_context[callback_arr_len] = sensor;
+  callback_arr_async[callback_arr_len] = NULL;
+
+  // sensors without their own period use the upload interval
+  uint32_t period = measure_period;
+  uint32_t phase = 0;
+  if (sensor != NULL) {
+    if (sensor->period != 0) {
+      period = SecondsToMs(sensor->period);
+    }
+    phase = SecondsToMs(sensor->phase);
+  }
+  callback_arr_period[callback_arr_len] = period;
+  callback_arr_phase[callback_arr_len] = phase;
+
+  char name[PROF_NAME_SIZE];
+  snprintf(name, sizeof(name), "sensor_%u", (uint8_t)callback_arr_len);
+  callback_arr_prof[callback_arr_len] = ProfRegister(name);
 
   // return index and increment
   return callback_arr_len++;
 }
 
+int SensorsAddAsync(const AsyncDriver *driver, SensorsPrototypeMeasure encode,
+                    EnabledSensorMultiple *sensor) {
+  const int idx = SensorsAdd(encode, sensor);
+  if (idx >= 0) {
+    callback_arr_async[idx] = driver;
+  }
+
+  return idx;
+}
+
+/**
+ * @brief Call the measurement callback of a sensor and queue the result
+ *
+ * @param i Index of the sensor
+ * @param ts Timestamp of the measurement
+ */
+static void SensorsCall(int i, SysTime_t ts) {
+  APP_LOG(TS_ON, VLEVEL_M, "Callback index: %d\r\n", i);
+
+  // call measurement function
+  // NOTE: Sensors must be queued in sequential order using
+  // SensorsAdd() since the callback order is used by the sensor measurement
+  // callback function to identify which (if any) sensor it is in the case of
+  // multiple of the same sensor type.
+
+  // measurements added by the callback are aggregated for this sensor
+  current_sensor = i;
+
+  const uint32_t start = ProfNow();
+  const size_t buffer_len =
+      callback_arr[i](measure_buffer, ts, i, callback_arr_context[i]);
+  ProfRecord(callback_arr_prof[i], ProfNow() - start);
+
+  meas_idx++;
+
+  if (buffer_len == ((size_t)-1)) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: buffer_len == -1\r\n");
+  } else {
+    SensorsAddMeasurement(measure_buffer, buffer_len);
+  }
+
+  current_sensor = -1;
+}
+
+/**
+ * @brief Encodes finished async measurements
+ *
+ * @see AsyncDone
+ */
+static void SensorsAsyncDone(uint8_t id, AsyncStatus status) {
+  callback_arr_pending[id] = false;
+
+  if (status != ASYNC_DONE) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: async measurement %u failed\r\n", id);
+    return;
+  }
+
+  SensorsCall(id, callback_arr_ts[id]);
+}
+
 void SensorsMeasure(void) {
-  // buffer to store measurements
-  uint8_t buffer[kBufferSize];
-  size_t buffer_len;
+  ENERGY_SCOPE(CFG_SEQ_Task_Measurement);
 
-  // get timestamp
-  SysTime_t ts = SysTimeGet();
+  if (!running) {
+    return;
+  }
 
-  // loop over callbacks
-  for (int i = 0; i < callback_arr_len; i++) {
-    APP_LOG(TS_ON, VLEVEL_M, "Callback index: %d\r\n", i);
+  // sensors due in this wakeup
+  uint8_t due[MAX_SENSORS];
+  const size_t due_len = SchedulePopDue(&schedule, UTIL_TIMER_GetCurrentTime(),
+                                        due, MAX_SENSORS);
 
-    // call measurement function
-    // NOTE: Sensors must be queued in sequential order using
-    // SensorsAdd() since the callback order is used by the sensor measurement
-    // callback function to identify which (if any) sensor it is in the case of
-    // multiple of the same sensor type.
+  // get timestamp
+  SysTime_t ts = SysTimeGet();
 
-    buffer_len = callback_arr[i](buffer, ts, i, callback_arr_context[i]);
+  // stage everything measured in this wakeup
+  batching = true;
 
-    meas_idx++;
+  // start async sensors first so their waits overlap the blocking sensors
+  for (size_t j = 0; j < due_len; j++) {
+    const int i = due[j];
+    if (callback_arr_async[i] == NULL) {
+      continue;
+    }
 
-    if (buffer_len == ((size_t)-1)) {
-      APP_LOG(TS_ON, VLEVEL_M, "Error: buffer_len == -1\r\n");
+    if (callback_arr_pending[i]) {
+      APP_LOG(TS_ON, VLEVEL_M, "Error: sensor %d still measuring\r\n", i);
       continue;
     }
 
-    SensorsAddMeasurement(buffer, buffer_len);
+    callback_arr_ts[i] = ts;
+    callback_arr_pending[i] = AsyncSubmit(&async_queue, callback_arr_async[i],
+                                          callback_arr_context[i], i);
   }
+  AsyncRun(&async_queue, UTIL_TIMER_GetCurrentTime, SensorsAsyncDone);
+
+  // loop over due blocking callbacks
+  for (size_t j = 0; j < due_len; j++) {
+    const int i = due[j];
+    if (callback_arr_async[i] == NULL) {
+      SensorsCall(i, ts);
+    }
+  }
+
+  // steps that became due while measuring
+  AsyncRun(&async_queue, UTIL_TIMER_GetCurrentTime, SensorsAsyncDone);
+
+  SensorsCommit();
+  batching = false;
+
+  SensorsArm();
 }
 
 void SensorsAddMeasurement(uint8_t *buffer, size_t buffer_len) {
-  APP_LOG(TS_ON, VLEVEL_M, "Buffer length: %u\r\n", buffer_len);
-  APP_LOG(TS_ON, VLEVEL_M, "Buffer: ");
+  const EnabledSensorMultiple *sensor = NULL;
+  if (current_sensor >= 0) {
+    sensor = callback_arr_context[current_sensor];
+  }
+
+  if (sensor == NULL) {
+    SensorsStore(buffer, buffer_len);
+    return;
+  }
+
+  const bool aggregate =
+      sensor->aggregate_count != 0 || sensor->aggregate_period != 0;
+  const DeadbandLimits limits = {sensor->deadband_absolute,
+                                 sensor->deadband_relative, sensor->heartbeat};
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  if ((!aggregate && !DeadbandEnabled(&limits)) ||
+      DecodeSensorMeasurement(buffer, buffer_len, &meas) != SENSOR_OK) {
+    SensorsStore(buffer, buffer_len);
+    return;
+  }
+
+  // summaries already reduce the samples, the deadband only filters raw ones
+  if (aggregate) {
+    SensorMeasurement summary;
+    switch (AggregateAdd(&aggregator, current_sensor, sensor->aggregate_count,
+                         sensor->aggregate_period, &meas, &summary)) {
+      case AGGREGATE_HELD:
+        return;
+      case AGGREGATE_SUMMARY:
+        SensorsAddSummary(&summary);
+        return;
+      case AGGREGATE_RAW:
+        SensorsStore(buffer, buffer_len);
+        return;
+    }
+  }
 
-  for (int j = 0; j < buffer_len; j++) {
-    APP_LOG(TS_OFF, VLEVEL_M, "%02X", buffer[j]);
+  int entry = -1;
+  if (!DeadbandCheck(&deadband, current_sensor, &limits, &meas, &entry)) {
+    APP_LOG(TS_ON, VLEVEL_H, "Within deadband, not stored\r\n");
+    return;
   }
-  APP_LOG(TS_OFF, VLEVEL_M, "\r\n");
+
+  if (SensorsStore(buffer, buffer_len) && entry >= 0) {
+    DeadbandUpdate(&deadband, entry, current_sensor, &meas);
+    SensorsDeadbandSave(entry);
+  }
+}
+
+static void SensorsAddSummary(const SensorMeasurement *summary) {
+  uint8_t buffer[SensorMeasurement_size];
+  size_t buffer_len = sizeof(buffer);
+  if (EncodeSensorMeasurement(summary, buffer, &buffer_len) != SENSOR_OK) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: could not encode summary\r\n");
+    return;
+  }
+
+  SensorsStore(buffer, buffer_len);
+}
+
+static bool SensorsStore(const uint8_t *buffer, size_t buffer_len) {
+  BINLOG(VLEVEL_M, "Buffer (%u): %H\r\n", buffer_len,
+         BINLOG_BLOB(buffer, buffer_len));
 
 #ifdef SAVE_TO_MICROSD
   ControllerMicroSDSave(buffer, buffer_len);
 #endif
 
   // add to tx buffer
-  FramStatus status = FramPut(buffer, buffer_len);
+  FramStatus status = FRAM_OK;
+  if (batching) {
+    status = FramBatchAdd(&batch, buffer, buffer_len);
+    // staging area is full, write what is staged and try again
+    if (status == FRAM_OUT_OF_RANGE && batch.count > 0) {
+      SensorsCommit();
+      status = FramBatchAdd(&batch, buffer, buffer_len);
+    }
+  } else {
+    status = FramPut(buffer, buffer_len);
+  }
+
+  if (status == FRAM_BUFFER_FULL) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: TX Buffer full!\r\n");
+  } else if (status != FRAM_OK) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: General FRAM buffer! %d\r\n", status);
+  }
+
+  return status == FRAM_OK;
+}
+
+static void SensorsCommit(void) {
+  const uint16_t count = batch.count;
+  const FramStatus status = FramBatchCommit(&batch);
   if (status == FRAM_BUFFER_FULL) {
     APP_LOG(TS_ON, VLEVEL_M, "Error: TX Buffer full!\r\n");
   } else if (status != FRAM_OK) {
     APP_LOG(TS_ON, VLEVEL_M, "Error: General FRAM buffer! %d\r\n", status);
+  } else if (count > 0) {
+    APP_LOG(TS_ON, VLEVEL_H, "Committed %u measurements\r\n", count);
+  }
+}
+
+static void SensorsDeadbandLoad(void) {
+  uint32_t magic = 0;
+  if (FramRead(SENSORS_DEADBAND_ADDR, sizeof(magic), (uint8_t *)&magic) ==
+          FRAM_OK &&
+      magic == SENSORS_DEADBAND_MAGIC &&
+      FramRead(SENSORS_DEADBAND_ADDR + sizeof(magic), sizeof(deadband.entries),
+               (uint8_t *)deadband.entries) == FRAM_OK) {
+    return;
+  }
+
+  DeadbandInit(&deadband);
+  magic = SENSORS_DEADBAND_MAGIC;
+  if (FramWrite(SENSORS_DEADBAND_ADDR + sizeof(magic),
+                (const uint8_t *)deadband.entries,
+                sizeof(deadband.entries)) != FRAM_OK ||
+      FramWrite(SENSORS_DEADBAND_ADDR, (const uint8_t *)&magic,
+                sizeof(magic)) != FRAM_OK) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: could not mirror deadband to FRAM\r\n");
+  }
+}
+
+static void SensorsDeadbandSave(int entry) {
+  const FramAddr addr =
+      SENSORS_DEADBAND_ADDR + sizeof(uint32_t) + entry * sizeof(DeadbandEntry);
+  if (FramWrite(addr, (const uint8_t *)&deadband.entries[entry],
+                sizeof(DeadbandEntry)) != FRAM_OK) {
+    APP_LOG(TS_ON, VLEVEL_M, "Error: could not mirror deadband to FRAM\r\n");
   }
 }
 
@@ -32,27 +32,38 @@ extern "C" {
  * the length number of bytes are read into RAM. Ensure the read buffer used
  * is of sufficient size.
  *
+ * Every put writes the length, the data and the buffer state separately. When
+ * several measurements are taken together they can be staged in a FramBatch
+ * and written with FramBatchCommit, which writes all of them contiguously and
+ * saves the buffer state once.
+ *
  * The buffer's implementation does not allow for overwriting of data. Once
  * the buffer is full, indicated by FRAM_BUFFER_FULL, data needs to be removed
  * by getting the next measurement or clearing the buffer entirely.
  *
- * @todo Implement a clear pointer in the following
- *
- * The buffer operates as a circular queue with three pointers:
+ * Uploads are delivered at least once. The buffer is a circular queue with
+ * three pointers:
  *
- * - Read Pointer: Points to the address of the next measurement to be uploaded.
+ * - Read Pointer: Points to the oldest measurement that has not been
+ * confirmed by the backend.
+ * - Pending Pointer: Points to the address of the next measurement to be
+ * uploaded.
  * - Write Pointer: Points to the address where the next measurement will be
  * stored.
- * - Clear Pointer: Points to the last measurement that has been confirmed by
- * the backend.
  *
- * Unlike traditional circular buffers that maintain only read and write
- * pointers with overflow protection, the ENTS design adds a clear pointer to
- * track backend uplink confirmations. This pointer ensures that unacknowledged
- * data is not overwritten by subsequent writes. The write pointer is allowed
- * to wrap around but is restricted from advancing past the clear pointer. This
- * constraint protects data integrity in field deployments where network
- * failures may delay acknowledgment indefinitely.
+ * FramPend moves measurements from the pending pointer into a pending window
+ * once they are formatted into an uplink. FramCommit drops the window when the
+ * uplink is confirmed, by a LoRaWAN ack or a response of the backend, and
+ * FramRollback returns it to the queue to be uploaded again. When only some
+ * measurements failed, FramCommitExcept queues just those again. The write
+ * pointer is restricted from advancing past the read pointer, so unconfirmed
+ * data is never overwritten. The pending pointer is only kept in RAM, a reset
+ * rolls back the window.
+ *
+ * Every measurement is numbered in the order it was put into the buffer, see
+ * FramSeq. A measurement that is uploaded again keeps its number, so the
+ * backend can drop duplicates. The number of the oldest measurement is saved
+ * in the 4 bytes before the user config.
  *
  * @{
  */
@@ -63,8 +74,11 @@ extern "C" {
 #endif /* FRAM_BUFFER_START */
 
 #ifndef FRAM_BUFFER_END
-/** Ending address of buffer, which is INCLUSIVE */
-#define FRAM_BUFFER_END 1769
+/**
+ * Ending address of buffer, which is INCLUSIVE. The deadband mirror of the
+ * sensors library follows it, see SENSORS_DEADBAND_ADDR.
+ */
+#define FRAM_BUFFER_END 1399
 #endif /* FRAM_BUFFER_END */
 
 #if FRAM_BUFFER_START > FRAM_BUFFER_END
@@ -74,6 +88,21 @@ extern "C" {
 /** Amount of bytes that can be stored in the buffer*/
 static const uint16_t kFramBufferSize = FRAM_BUFFER_END - FRAM_BUFFER_START + 1;
 
+#ifndef FRAM_BATCH_SIZE
+/** Size of the RAM staging area of a batch in bytes */
+#define FRAM_BATCH_SIZE 512
+#endif /* FRAM_BATCH_SIZE */
+
+/** Measurements staged in RAM before they are put into the buffer at once */
+typedef struct {
+  /** Measurements in the buffer format, a length byte followed by the data */
+  uint8_t data[FRAM_BATCH_SIZE];
+  /** Number of bytes used in data */
+  uint16_t len;
+  /** Number of measurements in data */
+  uint16_t count;
+} FramBatch;
+
 /**
  * @brief Puts a measurement into the circular buffer
  *
@@ -83,6 +112,41 @@ static const uint16_t kFramBufferSize = FRAM_BUFFER_END - FRAM_BUFFER_START + 1;
  */
 FramStatus FramPut(const uint8_t *data, size_t num_bytes);
 
+/**
+ * @brief Empties a batch without writing it
+ *
+ * @param batch Batch
+ */
+void FramBatchInit(FramBatch *batch);
+
+/**
+ * @brief Stages a measurement in a batch
+ *
+ * The space of the measurement is checked against the buffer together with
+ * everything already staged, so a commit of the batch only fails if the
+ * buffer is modified in between or on a bus error.
+ *
+ * @param batch Batch
+ * @param data An array of data bytes.
+ * @param num_bytes The number of bytes to be staged.
+ * @return FRAM_BUFFER_FULL if the buffer has no space left for it,
+ * FRAM_OUT_OF_RANGE if the staging area is full, FRAM_OK otherwise
+ */
+FramStatus FramBatchAdd(FramBatch *batch, const uint8_t *data,
+                        size_t num_bytes);
+
+/**
+ * @brief Puts all staged measurements into the buffer
+ *
+ * The measurements are written with a single write, or two if they wrap
+ * around the end of the buffer, followed by a single save of the buffer
+ * state. The batch is empty afterwards even if the write failed.
+ *
+ * @param batch Batch
+ * @return See FramStatus
+ */
+FramStatus FramBatchCommit(FramBatch *batch);
+
 /**
  * @brief    Reads a measurement from the queue
  *
@@ -97,7 +161,7 @@ FramStatus FramGet(uint8_t *data, uint8_t *len);
  * @brief Peeks at the next measurement in the buffer without removing it
  *
  * Alternative to FramGet when the data is needed but should remain in the
- * buffer. Index starts at the read pointer.
+ * buffer. Index starts at the pending pointer, after the pending window.
  *
  * @param idx Index of the measurement to peek
  * @param data Array to be read into
@@ -109,14 +173,73 @@ FramStatus FramPeek(size_t idx, uint8_t *data, uint8_t *len);
 /**
  * @brief Drops the next measurement in the buffer
  *
- * Alternative to FramGet when the data is not needed.
+ * Alternative to FramGet when the data is not needed. Like FramGet, it removes
+ * the oldest measurement, which is part of the pending window if there is one.
  *
  * @return See FramStatus
  */
 FramStatus FramDrop(void);
 
 /**
- * @brief Get the current number of measurements stored in the buffer
+ * @brief Moves measurements into the pending window
+ *
+ * The measurements are no longer returned by FramPeek or counted by
+ * FramBufferLen, but stay in FRAM until FramCommit.
+ *
+ * @param count Number of measurements from the pending pointer
+ * @return FRAM_OUT_OF_RANGE if fewer measurements are waiting, see FramStatus
+ */
+FramStatus FramPend(uint16_t count);
+
+/**
+ * @brief Drops the pending window from the buffer after a confirmed upload
+ *
+ * @return See FramStatus
+ */
+FramStatus FramCommit(void);
+
+/**
+ * @brief Commits the pending window except for measurements that failed
+ *
+ * The failed measurements are copied behind the newest one and numbered as
+ * new measurements. The copies are only kept with the buffer state saved by
+ * the commit, so a reset before it rolls back the whole window. The buffer is
+ * unchanged on an error, call FramRollback to upload all of them again.
+ *
+ * @param idx Indices of the failed measurements in the pending window
+ * @param count Number of indices
+ * @return FRAM_OUT_OF_RANGE for an index outside of the window,
+ * FRAM_BUFFER_FULL if the copies do not fit, see FramStatus
+ */
+FramStatus FramCommitExcept(const uint16_t idx[], uint16_t count);
+
+/**
+ * @brief Returns the pending window to the buffer after a failed upload
+ */
+void FramRollback(void);
+
+/**
+ * @brief Get the number of measurements in the pending window
+ *
+ * @return Number of measurements
+ */
+uint16_t FramPendingLen(void);
+
+/**
+ * @brief Get the sequence number of the oldest measurement in the buffer
+ *
+ * The oldest measurement is the first of the pending window if there is one.
+ * Measurements are numbered consecutively from there, the next measurement
+ * returned by FramPeek has FramSeq() + FramPendingLen(). Never 0.
+ *
+ * @return Sequence number
+ */
+uint32_t FramSeq(void);
+
+/**
+ * @brief Get the current number of measurements waiting to be uploaded
+ *
+ * Measurements in the pending window are not counted.
  *
  * @return Number of measurements
  */
@@ -126,7 +249,8 @@ uint16_t FramBufferLen(void);
  * @brief Clears the buffer
  *
  * Read and write addresses are set to their default values allowing for the
- * buffer to be overwritten.
+ * buffer to be overwritten. The pending window is dropped and the sequence
+ * numbers of the cleared measurements are not reused.
  */
 FramStatus FramBufferClear(void);
 
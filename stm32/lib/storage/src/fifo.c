@@ -10,19 +10,36 @@
 
 #include "fifo.h"
 
+#include <stdbool.h>
+
+#include "prof.h"
 #include "sys_app.h"
 #include "usart.h"
 #include "userConfig.h"  // need to know the userconfig start and length in order to put the FRAM buffer after it
 
+// read address, write address and length are stored contiguously from here
 static const uint16_t FRAM_BUFFER_READ_ADDR = USER_CONFIG_START_ADDRESS + 2;
-static const uint16_t FRAM_BUFFER_WRITE_ADDR = FRAM_BUFFER_READ_ADDR + 2;
-static const uint16_t FRAM_BUFFER_LEN_ADDR = FRAM_BUFFER_WRITE_ADDR + 2;
+
+// sequence number of the measurement at the read address
+static const uint16_t FRAM_BUFFER_SEQ_ADDR =
+    USER_CONFIG_LEN_ADDR - sizeof(uint32_t);
+
+#if FRAM_BUFFER_END >= USER_CONFIG_LEN_ADDR - 4
+#error "Buffer end address overlaps the sequence number"
+#endif
 
 // head and tail
 static uint16_t read_addr;
 static uint16_t write_addr;
 static uint16_t buffer_len;
 
+// measurements handed out for upload, the pending address follows them
+static uint16_t pending_addr;
+static uint16_t pending;
+
+// sequence number of the measurement at the read address
+static uint32_t seq = 1;
+
 /**
  * @brief Updates circular buffer address based on number of bytes
  *
@@ -33,6 +50,91 @@ static inline void update_addr(uint16_t *addr, const uint16_t num_bytes) {
   *addr = (*addr + num_bytes) % kFramBufferSize;
 }
 
+/**
+ * @brief Advances the sequence number past dropped measurements
+ *
+ * Saved before the buffer state. A reset in between uploads the measurements
+ * again under new numbers, which risks a duplicate but never reuses a number.
+ *
+ * @param count Number of measurements dropped
+ */
+static FramStatus advance_seq(uint16_t count) {
+  seq += count;
+  // 0 means not numbered
+  if (seq == 0) {
+    seq = 1;
+  }
+  return FramWrite(FRAM_BUFFER_SEQ_ADDR, (const uint8_t *)&seq, sizeof(seq));
+}
+
+/**
+ * @brief Removes the oldest measurement after the read address moved past it
+ */
+static void drop_oldest(void) {
+  --buffer_len;
+  if (pending > 0) {
+    --pending;
+  } else {
+    pending_addr = read_addr;
+  }
+  advance_seq(1);
+}
+
+/**
+ * @brief Reads from the buffer, wrapping around its end
+ *
+ * @param addr Address to read from, advanced past the data
+ * @param data Buffer for the data
+ * @param len Number of bytes
+ */
+static FramStatus read_wrapped(uint16_t *addr, uint8_t *data, size_t len) {
+  FramStatus status = FRAM_OK;
+  if (*addr + len > (FRAM_BUFFER_END + 1)) {
+    const size_t first_half = (FRAM_BUFFER_END + 1) - *addr;
+    status = FramRead(*addr, first_half, data);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(addr, first_half);
+    data += first_half;
+    len -= first_half;
+  }
+  status = FramRead(*addr, len, data);
+  if (status != FRAM_OK) {
+    return status;
+  }
+  update_addr(addr, len);
+  return FRAM_OK;
+}
+
+/**
+ * @brief Writes to the buffer, wrapping around its end
+ *
+ * @param addr Address to write to, advanced past the data
+ * @param data Data to write
+ * @param len Number of bytes
+ */
+static FramStatus write_wrapped(uint16_t *addr, const uint8_t *data,
+                                size_t len) {
+  FramStatus status = FRAM_OK;
+  if (*addr + len > (FRAM_BUFFER_END + 1)) {
+    const size_t first_half = (FRAM_BUFFER_END + 1) - *addr;
+    status = FramWrite(*addr, data, first_half);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(addr, first_half);
+    data += first_half;
+    len -= first_half;
+  }
+  status = FramWrite(*addr, data, len);
+  if (status != FRAM_OK) {
+    return status;
+  }
+  update_addr(addr, len);
+  return FRAM_OK;
+}
+
 /**
  * @brief Get the remaining space in the buffer
  *
@@ -63,6 +165,8 @@ static uint16_t get_remaining_space(void) {
 }
 
 FramStatus FramPut(const uint8_t *data, const size_t num_bytes) {
+  PROF_SCOPE("fifo_put");
+
   // check remaining space
   if (num_bytes > get_remaining_space()) {
     return FRAM_BUFFER_FULL;
@@ -109,6 +213,79 @@ FramStatus FramPut(const uint8_t *data, const size_t num_bytes) {
   return FRAM_OK;
 }
 
+void FramBatchInit(FramBatch *batch) {
+  batch->len = 0;
+  batch->count = 0;
+}
+
+FramStatus FramBatchAdd(FramBatch *batch, const uint8_t *data,
+                        size_t num_bytes) {
+  // lengths are stored in a single byte
+  if (num_bytes > UINT8_MAX) {
+    return FRAM_OUT_OF_RANGE;
+  }
+
+  if (batch->len + 1 + num_bytes > get_remaining_space()) {
+    return FRAM_BUFFER_FULL;
+  }
+
+  if (batch->len + 1 + num_bytes > FRAM_BATCH_SIZE) {
+    return FRAM_OUT_OF_RANGE;
+  }
+
+  batch->data[batch->len] = num_bytes;
+  memcpy(batch->data + batch->len + 1, data, num_bytes);
+  batch->len += 1 + num_bytes;
+  ++batch->count;
+
+  return FRAM_OK;
+}
+
+FramStatus FramBatchCommit(FramBatch *batch) {
+  const uint16_t len = batch->len;
+  const uint16_t count = batch->count;
+  FramBatchInit(batch);
+
+  if (count == 0) {
+    return FRAM_OK;
+  }
+
+  if (len > get_remaining_space()) {
+    return FRAM_BUFFER_FULL;
+  }
+
+  FramStatus status = FRAM_OK;
+  uint16_t addr = write_addr;
+
+  // if the data must wraparound, then make two writes
+  if (addr + len > (FRAM_BUFFER_END + 1)) {
+    size_t num_bytes_first_half = (FRAM_BUFFER_END + 1) - addr;
+    status = FramWrite(addr, batch->data, num_bytes_first_half);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(&addr, num_bytes_first_half);
+    status = FramWrite(addr, batch->data + num_bytes_first_half,
+                       len - num_bytes_first_half);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(&addr, len - num_bytes_first_half);
+  } else {
+    status = FramWrite(addr, batch->data, len);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(&addr, len);
+  }
+
+  // only publish the measurements once all of them are written
+  write_addr = addr;
+  buffer_len += count;
+
+  return FramSaveBufferState(read_addr, write_addr, buffer_len);
+}
+
 FramStatus FramGet(uint8_t *data, uint8_t *len) {
   // Check if buffer is empty
   if (buffer_len == 0) {
@@ -147,24 +324,25 @@ FramStatus FramGet(uint8_t *data, uint8_t *len) {
     update_addr(&read_addr, *len);
   }
 
-  // Decrement buffer length
-  --buffer_len;
+  drop_oldest();
 
   FramSaveBufferState(read_addr, write_addr, buffer_len);
   return FRAM_OK;
 }
 
 FramStatus FramPeek(size_t idx, uint8_t *data, uint8_t *len) {
+  PROF_SCOPE("fifo_peek");
+
   // Check if buffer is empty
-  if (buffer_len == 0) {
+  if (buffer_len == pending) {
     return FRAM_BUFFER_EMPTY;
   }
-  if (idx >= buffer_len) {
+  if (idx >= (size_t)(buffer_len - pending)) {
     return FRAM_OUT_OF_RANGE;
   }
 
   FramStatus status = FRAM_OK;
-  uint16_t temp_read_addr = read_addr;
+  uint16_t temp_read_addr = pending_addr;
 
   // advance to idx
   for (size_t i = 0; i < idx; i++) {
@@ -233,34 +411,172 @@ FramStatus FramDrop(void) {
   }
   update_addr(&read_addr, 1 + len);
 
-  // Decrement buffer length
-  --buffer_len;
+  drop_oldest();
 
   FramSaveBufferState(read_addr, write_addr, buffer_len);
   return FRAM_OK;
 }
 
-uint16_t FramBufferLen(void) { return buffer_len; }
+FramStatus FramPend(uint16_t count) {
+  if (count > buffer_len - pending) {
+    return FRAM_OUT_OF_RANGE;
+  }
+
+  // only the lengths are read to skip over the measurements
+  for (uint16_t i = 0; i < count; i++) {
+    uint8_t len;
+    FramStatus status = FramRead(pending_addr, 1, &len);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(&pending_addr, 1 + len);
+    ++pending;
+  }
+
+  return FRAM_OK;
+}
+
+FramStatus FramCommit(void) {
+  if (pending == 0) {
+    return FRAM_OK;
+  }
+
+  read_addr = pending_addr;
+  buffer_len -= pending;
+  const uint16_t count = pending;
+  pending = 0;
+
+  FramStatus status = advance_seq(count);
+  if (status != FRAM_OK) {
+    return status;
+  }
+  return FramSaveBufferState(read_addr, write_addr, buffer_len);
+}
+
+FramStatus FramCommitExcept(const uint16_t idx[], uint16_t count) {
+  for (uint16_t i = 0; i < count; i++) {
+    if (idx[i] >= pending) {
+      return FRAM_OUT_OF_RANGE;
+    }
+  }
+
+  // the copies are written to free space, the state is only saved by the
+  // commit so nothing is published before
+  uint16_t src = read_addr;
+  uint16_t dst = write_addr;
+  uint16_t space = get_remaining_space();
+  uint16_t copies = 0;
+
+  for (uint16_t i = 0; i < pending; i++) {
+    uint8_t len;
+    FramStatus status = FramRead(src, 1, &len);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    update_addr(&src, 1);
+
+    bool failed = false;
+    for (uint16_t j = 0; j < count; j++) {
+      failed |= idx[j] == i;
+    }
+    if (!failed) {
+      update_addr(&src, len);
+      continue;
+    }
+
+    if (1 + len > space) {
+      return FRAM_BUFFER_FULL;
+    }
+    space -= 1 + len;
+
+    uint8_t data[UINT8_MAX];
+    status = read_wrapped(&src, data, len);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    status = write_wrapped(&dst, &len, 1);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    status = write_wrapped(&dst, data, len);
+    if (status != FRAM_OK) {
+      return status;
+    }
+    ++copies;
+  }
+
+  write_addr = dst;
+  buffer_len += copies;
+  return FramCommit();
+}
+
+void FramRollback(void) {
+  pending_addr = read_addr;
+  pending = 0;
+}
+
+uint16_t FramPendingLen(void) { return pending; }
+
+uint32_t FramSeq(void) { return seq; }
+
+uint16_t FramBufferLen(void) { return buffer_len - pending; }
 
 FramStatus FramBufferClear(void) {
+  // numbers of cleared measurements are not reused
+  advance_seq(buffer_len);
+
   // Set read and write addresses to their default values
   read_addr = FRAM_BUFFER_START;
   write_addr = FRAM_BUFFER_START;
+  pending_addr = FRAM_BUFFER_START;
 
   // reset buffer len
   buffer_len = 0;
+  pending = 0;
   FramSaveBufferState(read_addr, write_addr, buffer_len);
 
   return FRAM_OK;
 }
 
+/**
+ * @brief Checks that a loaded buffer state fits the buffer
+ *
+ * A state saved with a different FRAM_BUFFER_END, or never saved, may point
+ * outside of the buffer or count more measurements than it can hold.
+ */
+static bool buffer_state_valid(void) {
+  if ((uint16_t)(read_addr - FRAM_BUFFER_START) >= kFramBufferSize ||
+      (uint16_t)(write_addr - FRAM_BUFFER_START) >= kFramBufferSize) {
+    return false;
+  }
+
+  // every measurement takes at least its length byte
+  const uint16_t space_used = kFramBufferSize - get_remaining_space();
+  if (buffer_len > space_used || (buffer_len == 0 && space_used > 0)) {
+    return false;
+  }
+
+  return true;
+}
+
 FramStatus FIFO_Init(void) {
+  // an unused FRAM starts numbering from whatever it holds
+  if (FramRead(FRAM_BUFFER_SEQ_ADDR, sizeof(seq), (uint8_t *)&seq) != FRAM_OK ||
+      seq == 0) {
+    seq = 1;
+  }
+
+  pending = 0;
   FramStatus status = FramLoadBufferState(&read_addr, &write_addr, &buffer_len);
+  pending_addr = read_addr;
   if (status != FRAM_OK) {
     // APP_PRINTF("Failed to load FIFO state. FRAM Status: %d\n", status);
     // If loading the buffer state fails, assume it's an empty state
     // APP_PRINTF("Initialized to empty buffer state.\n");
     return FramBufferClear();
+  } else if (!buffer_state_valid()) {
+    APP_PRINTF("Invalid buffer state, clearing the buffer.\n");
+    return FramBufferClear();
   } else {
     if (read_addr == FRAM_BUFFER_START && write_addr == FRAM_BUFFER_START &&
         buffer_len == 0) {
@@ -274,31 +590,13 @@ FramStatus FIFO_Init(void) {
 
 FramStatus FramSaveBufferState(uint16_t read_addr, uint16_t write_addr,
                                uint16_t buffer_len) {
-  uint8_t *read_addr_bytes = (uint8_t *)&read_addr;
-  uint8_t *write_addr_bytes = (uint8_t *)&write_addr;
-  uint8_t *buffer_len_bytes = (uint8_t *)&buffer_len;
+  // the state is contiguous in FRAM so it is saved with a single write
+  const uint16_t state[3] = {read_addr, write_addr, buffer_len};
 
-  // Save read_addr
   FramStatus status =
-      FramWrite(FRAM_BUFFER_READ_ADDR, read_addr_bytes, sizeof(read_addr));
-  if (status != FRAM_OK) {
-    // APP_PRINTF("Failed to save read address. FRAM Status: %d\n", status);
-    return status;
-  }
-
-  // Save write_addr
-  status =
-      FramWrite(FRAM_BUFFER_WRITE_ADDR, write_addr_bytes, sizeof(write_addr));
-  if (status != FRAM_OK) {
-    // APP_PRINTF("Failed to save write address. FRAM Status: %d\n", status);
-    return status;
-  }
-
-  // Save buffer_len
-  status =
-      FramWrite(FRAM_BUFFER_LEN_ADDR, buffer_len_bytes, sizeof(buffer_len));
+      FramWrite(FRAM_BUFFER_READ_ADDR, (const uint8_t *)state, sizeof(state));
   if (status != FRAM_OK) {
-    // APP_PRINTF("Failed to save buffer length. FRAM Status: %d\n", status);
+    // APP_PRINTF("Failed to save buffer state. FRAM Status: %d\n", status);
     return status;
   }
 
@@ -313,29 +611,16 @@ FramStatus FramSaveBufferState(uint16_t read_addr, uint16_t write_addr,
 
 FramStatus FramLoadBufferState(uint16_t *read_addr, uint16_t *write_addr,
                                uint16_t *buffer_len) {
-  FramStatus status;
-
-  // Load read_addr and print each byte
-  status =
-      FramRead(FRAM_BUFFER_READ_ADDR, sizeof(*read_addr), (uint8_t *)read_addr);
-  if (status != FRAM_OK) return status;
-  // APP_PRINTF("Loaded Read Address: 0x%02X 0x%02X (%d)\n", ((uint8_t
-  // *)read_addr)[0],
-  //       ((uint8_t *)read_addr)[1], *read_addr);
+  uint16_t state[3];
 
-  // Load write_addr and print each byte
-  status = FramRead(FRAM_BUFFER_WRITE_ADDR, sizeof(*write_addr),
-                    (uint8_t *)write_addr);
+  FramStatus status =
+      FramRead(FRAM_BUFFER_READ_ADDR, sizeof(state), (uint8_t *)state);
   if (status != FRAM_OK) return status;
-  // APP_PRINTF("Loaded Write Address: 0x%02X 0x%02X (%d)\n",
-  //       ((uint8_t *)write_addr)[0], ((uint8_t *)write_addr)[1], *write_addr);
+  // APP_PRINTF("Loaded State: %d %d %d\n", state[0], state[1], state[2]);
 
-  // Load buffer_len and print each byte
-  status = FramRead(FRAM_BUFFER_LEN_ADDR, sizeof(*buffer_len),
-                    (uint8_t *)buffer_len);
-  if (status != FRAM_OK) return status;
-  // APP_PRINTF("Loaded Buffer Length: 0x%02X 0x%02X (%d)\n",
-  //       ((uint8_t *)buffer_len)[0], ((uint8_t *)buffer_len)[1], *buffer_len);
+  *read_addr = state[0];
+  *write_addr = state[1];
+  *buffer_len = state[2];
 
   return FRAM_OK;
 }
@@ -1,6 +1,10 @@
 #include "fram.h"
 
 #include "fram_def.h"
+#include "i2c.h"
+
+/** Time to wait for I2C1 to be free in ms */
+static const uint32_t fram_claim_timeout = 100;
 
 // #define FRAM_FM24CL16B
 // #define FRAM_MB85RC1MT
@@ -27,7 +31,13 @@ FramStatus FramWrite(FramAddr addr, const uint8_t *data, size_t len) {
     return FRAM_OUT_OF_RANGE;
   }
 
-  return FramInterface.WritePtr(addr, data, len);
+  if (I2C1_Claim(fram_claim_timeout) != HAL_OK) {
+    return FRAM_ERROR;
+  }
+  FramStatus status = FramInterface.WritePtr(addr, data, len);
+  I2C1_Release();
+
+  return status;
 }
 
 FramStatus FramRead(FramAddr addr, size_t len, uint8_t *data) {
@@ -36,7 +46,13 @@ FramStatus FramRead(FramAddr addr, size_t len, uint8_t *data) {
     return FRAM_OUT_OF_RANGE;
   }
 
-  return FramInterface.ReadPtr(addr, len, data);
+  if (I2C1_Claim(fram_claim_timeout) != HAL_OK) {
+    return FRAM_ERROR;
+  }
+  FramStatus status = FramInterface.ReadPtr(addr, len, data);
+  I2C1_Release();
+
+  return status;
 }
 
 FramAddr FramSize(void) { return FramInterface.size; }
@@ -69,19 +69,19 @@ FramStatus Mb85rc1mtWrite(FramAddr addr, const uint8_t *data, size_t len) {
       write_len = len;
     }
 
-    for (int i = 0; i < write_len; i++) {
-      // transmit data
-      hal_status =
-          HAL_I2C_Mem_Write(&hi2c1, i2c_addr.dev, i2c_addr.mem,
-                            I2C_MEMADD_SIZE_16BIT, data, len, g_timeout);
-      fram_status = ConvertStatus(hal_status);
-      if (fram_status != FRAM_OK) {
-        return fram_status;
-      }
+    // transmit data, the address auto increments over the whole segment
+    hal_status =
+        HAL_I2C_Mem_Write(&hi2c1, i2c_addr.dev, i2c_addr.mem,
+                          I2C_MEMADD_SIZE_16BIT, (uint8_t *)data, write_len,
+                          g_timeout);
+    fram_status = ConvertStatus(hal_status);
+    if (fram_status != FRAM_OK) {
+      return fram_status;
     }
 
     // update address and length
     addr += write_len;
+    data += write_len;
     len -= write_len;
 
     // sleep device
@@ -120,7 +120,8 @@ FramStatus Mb85rc1mtRead(FramAddr addr, size_t len, uint8_t *data) {
 
     // read from memory
     hal_status = HAL_I2C_Mem_Read(&hi2c1, i2c_addr.dev | 1, i2c_addr.mem,
-                                  I2C_MEMADD_SIZE_16BIT, data, len, g_timeout);
+                                  I2C_MEMADD_SIZE_16BIT, data, read_len,
+                                  g_timeout);
     fram_status = ConvertStatus(hal_status);
     if (fram_status != FRAM_OK) {
       return fram_status;
@@ -128,6 +129,7 @@ FramStatus Mb85rc1mtRead(FramAddr addr, size_t len, uint8_t *data) {
 
     // update addr and len
     addr += read_len;
+    data += read_len;
     len -= read_len;
 
     // sleep device
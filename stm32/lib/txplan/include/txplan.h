@@ -0,0 +1,178 @@
+/**
+ * @file txplan.h
+ * @brief Plans LoRaWAN uplinks within the duty cycle and dwell time limits
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_TXPLAN_INCLUDE_TXPLAN_H_
+#define LIB_TXPLAN_INCLUDE_TXPLAN_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup txplan Transmit planner
+ * @brief Time on air, duty cycle budget and back to back uplinks
+ *
+ * The time on air of an uplink follows from the spreading factor and
+ * bandwidth of its data rate and the length of the frame, see Semtech
+ * AN1200.13. Frames have an 8 symbol preamble, explicit header, CRC and coding
+ * rate 4/5.
+ *
+ * The duty cycle is tracked over a sliding observation window, e.g. the 1% of
+ * an hour in EU868. Airtime is accumulated in TXPLAN_BINS bins that together
+ * span at least the window, so the budget is never overrun within any window
+ * that ends now. The bins make the estimate conservative by up to one bin.
+ *
+ * After an uplink the planner picks the delay of the next one. With a backlog
+ * of at least drain_backlog measurements the next uplink is sent as soon as
+ * the receive windows closed and the budget has room for it, instead of a
+ * full period later.
+ *
+ * The LoRaMac stack enforces its own duty cycle. The planner keeps the node
+ * from formatting a payload that the stack refuses to send. The module has no
+ * hardware dependencies, see
+ * extras/duty_cycle for a host model of the EU868 and US915 rules.
+ *
+ * @{
+ */
+
+/** Number of bins of the duty cycle window */
+#define TXPLAN_BINS 32
+
+/** Bytes of a frame around the application payload, MHDR, FHDR, FPort, MIC */
+#define TXPLAN_OVERHEAD 13
+
+/** EU868 region, same value as LORAMAC_REGION_EU868 */
+#define TXPLAN_REGION_EU868 5
+
+/** US915 region, same value as LORAMAC_REGION_US915 */
+#define TXPLAN_REGION_US915 8
+
+/** 1% per hour on the g1 sub band of EU868, no dwell time limit */
+#define TXPLAN_CONFIG_EU868 {3600000, 36000, 0, 3000, 8}
+
+/** No duty cycle in US915, 400 ms dwell time limit */
+#define TXPLAN_CONFIG_US915 {3600000, 0, 400, 3000, 8}
+
+/** Limits of a region and when to send back to back */
+typedef struct {
+  /** Observation window of the duty cycle in ms */
+  uint32_t window_ms;
+  /** Airtime allowed within the window in ms, 0 for no duty cycle */
+  uint32_t budget_ms;
+  /** Max airtime of a single uplink in ms, 0 for no dwell time limit */
+  uint32_t dwell_ms;
+  /** Delay between back to back uplinks in ms, covers the receive windows */
+  uint32_t min_gap_ms;
+  /** Send back to back from this many buffered measurements, 0 to never */
+  uint16_t drain_backlog;
+} TxPlanConfig;
+
+/** State of the planner */
+typedef struct {
+  /** Limits */
+  TxPlanConfig config;
+  /** Time each bin spans in ms */
+  uint32_t bin_ms;
+  /** Start of the current bin in ms */
+  uint32_t bin_start;
+  /** Index of the current bin */
+  uint8_t current;
+  /** Airtime in each bin in ms */
+  uint32_t bins[TXPLAN_BINS];
+} TxPlan;
+
+/**
+ * @brief Get the limits of a region
+ *
+ * Regions other than EU868 and US915 get no limits and are never sent back to
+ * back.
+ *
+ * @param region LoRaMacRegion_t value
+ * @param config Limits of the region
+ *
+ * @return true if the region is known
+ */
+bool TxPlanRegion(unsigned int region, TxPlanConfig *config);
+
+/**
+ * @brief Time on air of an uplink
+ *
+ * @param region LoRaMacRegion_t value
+ * @param dr Data rate
+ * @param len Length of the application payload in bytes
+ *
+ * @return Time on air in ms rounded up, 0 for an unknown region or a data rate
+ * that is not LoRa
+ */
+uint32_t TxPlanAirtime(unsigned int region, int8_t dr, uint8_t len);
+
+/**
+ * @brief Longest application payload within a dwell time limit
+ *
+ * @param region LoRaMacRegion_t value
+ * @param dr Data rate
+ * @param dwell_ms Dwell time limit in ms, 0 for none
+ *
+ * @return Length in bytes, UINT8_MAX without a limit
+ */
+uint8_t TxPlanMaxPayload(unsigned int region, int8_t dr, uint32_t dwell_ms);
+
+/**
+ * @brief Start with an empty window
+ *
+ * @param plan Planner
+ * @param config Limits
+ * @param now Current time in ms
+ */
+void TxPlanInit(TxPlan *plan, const TxPlanConfig *config, uint32_t now);
+
+/**
+ * @brief Time until an uplink fits in the budget
+ *
+ * @param plan Planner
+ * @param now Current time in ms
+ * @param airtime Time on air of the uplink in ms
+ *
+ * @return Delay in ms, 0 if it fits now, UINT32_MAX if it never fits
+ */
+uint32_t TxPlanWait(TxPlan *plan, uint32_t now, uint32_t airtime);
+
+/**
+ * @brief Account an uplink
+ *
+ * @param plan Planner
+ * @param now Time of the uplink in ms
+ * @param airtime Time on air of the uplink in ms
+ */
+void TxPlanSent(TxPlan *plan, uint32_t now, uint32_t airtime);
+
+/**
+ * @brief Delay of the next uplink
+ *
+ * @param plan Planner
+ * @param now Current time in ms
+ * @param airtime Time on air of the next uplink in ms
+ * @param backlog Number of measurements waiting to be uploaded
+ * @param period Nominal period of the uplinks in ms
+ *
+ * @return Delay in ms, at most @p period
+ */
+uint32_t TxPlanNext(TxPlan *plan, uint32_t now, uint32_t airtime,
+                    uint32_t backlog, uint32_t period);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_TXPLAN_INCLUDE_TXPLAN_H_
@@ -0,0 +1,180 @@
+/**
+ * @file txplan.c
+ *
+ * @see txplan.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "txplan.h"
+
+#include <stddef.h>
+
+/** LoRa modulation of a data rate */
+typedef struct {
+  /** Spreading factor */
+  uint8_t sf;
+  /** Bandwidth in kHz */
+  uint16_t bw_khz;
+} DataRate;
+
+/** EU868 data rates 0 to 6, DR7 is FSK */
+static const DataRate eu868[] = {{12, 125}, {11, 125}, {10, 125}, {9, 125},
+                                 {8, 125},  {7, 125},  {7, 250}};
+
+/** US915 uplink data rates 0 to 4 */
+static const DataRate us915[] = {
+    {10, 125}, {9, 125}, {8, 125}, {7, 125}, {8, 500}};
+
+/**
+ * @brief Modulation of a data rate, NULL if it is not LoRa
+ */
+static const DataRate *Lookup(unsigned int region, int8_t dr) {
+  const DataRate *rates = NULL;
+  size_t len = 0;
+  if (region == TXPLAN_REGION_EU868) {
+    rates = eu868;
+    len = sizeof(eu868) / sizeof(eu868[0]);
+  } else if (region == TXPLAN_REGION_US915) {
+    rates = us915;
+    len = sizeof(us915) / sizeof(us915[0]);
+  }
+
+  if (rates == NULL || dr < 0 || (size_t)dr >= len) {
+    return NULL;
+  }
+  return &rates[dr];
+}
+
+/**
+ * @brief Time on air in us, AN1200.13 with an 8 symbol preamble, explicit
+ * header, CRC and coding rate 4/5
+ */
+static uint32_t AirtimeUs(const DataRate *rate, uint32_t len) {
+  const int32_t sf = rate->sf;
+  const uint32_t symbol_us = (1UL << sf) * 1000 / rate->bw_khz;
+  // low data rate optimization for symbols of 16 ms and longer
+  const int32_t ldro = symbol_us >= 16000;
+
+  const int32_t bits = 8 * (int32_t)(len + TXPLAN_OVERHEAD) - 4 * sf + 28 + 16;
+  const int32_t per_block = 4 * (sf - 2 * ldro);
+  const int32_t blocks = bits > 0 ? (bits + per_block - 1) / per_block : 0;
+
+  // preamble of 8 + 4.25 symbols, in quarter symbols
+  const uint32_t quarters = 49 + 4 * (8 + (uint32_t)blocks * 5);
+  return quarters * symbol_us / 4;
+}
+
+/**
+ * @brief Start new bins for the time since the current one started
+ */
+static void Advance(TxPlan *plan, uint32_t now) {
+  const uint32_t elapsed = now - plan->bin_start;
+  if ((int32_t)elapsed < 0) {
+    return;
+  }
+
+  const uint32_t steps = elapsed / plan->bin_ms;
+  const uint32_t clear = steps < TXPLAN_BINS ? steps : TXPLAN_BINS;
+  for (uint32_t i = 0; i < clear; i++) {
+    plan->current = (plan->current + 1) % TXPLAN_BINS;
+    plan->bins[plan->current] = 0;
+  }
+  plan->bin_start += steps * plan->bin_ms;
+}
+
+bool TxPlanRegion(unsigned int region, TxPlanConfig *config) {
+  static const TxPlanConfig eu868_config = TXPLAN_CONFIG_EU868;
+  static const TxPlanConfig us915_config = TXPLAN_CONFIG_US915;
+
+  if (region == TXPLAN_REGION_EU868) {
+    *config = eu868_config;
+    return true;
+  }
+  if (region == TXPLAN_REGION_US915) {
+    *config = us915_config;
+    return true;
+  }
+  *config = (TxPlanConfig){us915_config.window_ms, 0, 0, 0, 0};
+  return false;
+}
+
+uint32_t TxPlanAirtime(unsigned int region, int8_t dr, uint8_t len) {
+  const DataRate *rate = Lookup(region, dr);
+  if (rate == NULL) {
+    return 0;
+  }
+  return (AirtimeUs(rate, len) + 999) / 1000;
+}
+
+uint8_t TxPlanMaxPayload(unsigned int region, int8_t dr, uint32_t dwell_ms) {
+  const DataRate *rate = Lookup(region, dr);
+  if (rate == NULL || dwell_ms == 0) {
+    return UINT8_MAX;
+  }
+
+  // time on air only grows with the length
+  uint32_t len = 0;
+  while (len < UINT8_MAX && AirtimeUs(rate, len + 1) <= dwell_ms * 1000) {
+    len++;
+  }
+  return (uint8_t)len;
+}
+
+void TxPlanInit(TxPlan *plan, const TxPlanConfig *config, uint32_t now) {
+  plan->config = *config;
+  // the bins span at least the window, whichever bin now falls in
+  plan->bin_ms = config->window_ms / (TXPLAN_BINS - 1);
+  if (plan->bin_ms == 0) {
+    plan->bin_ms = 1;
+  }
+  plan->bin_start = now;
+  plan->current = 0;
+  for (int i = 0; i < TXPLAN_BINS; i++) {
+    plan->bins[i] = 0;
+  }
+}
+
+uint32_t TxPlanWait(TxPlan *plan, uint32_t now, uint32_t airtime) {
+  const uint32_t budget = plan->config.budget_ms;
+  if (budget == 0) {
+    return 0;
+  }
+  if (airtime > budget) {
+    return UINT32_MAX;
+  }
+
+  Advance(plan, now);
+  uint32_t total = 0;
+  for (int i = 0; i < TXPLAN_BINS; i++) {
+    total += plan->bins[i];
+  }
+
+  // the oldest bins leave the window one bin length apart
+  for (uint32_t j = 0; j < TXPLAN_BINS; j++) {
+    if (total + airtime <= budget) {
+      return j == 0 ? 0 : plan->bin_start + j * plan->bin_ms - now;
+    }
+    total -= plan->bins[(plan->current + 1 + j) % TXPLAN_BINS];
+  }
+  return plan->bin_start + TXPLAN_BINS * plan->bin_ms - now;
+}
+
+void TxPlanSent(TxPlan *plan, uint32_t now, uint32_t airtime) {
+  Advance(plan, now);
+  plan->bins[plan->current] += airtime;
+}
+
+uint32_t TxPlanNext(TxPlan *plan, uint32_t now, uint32_t airtime,
+                    uint32_t backlog, uint32_t period) {
+  const TxPlanConfig *config = &plan->config;
+  if (config->drain_backlog == 0 || backlog < config->drain_backlog) {
+    return period;
+  }
+
+  uint32_t delay = TxPlanWait(plan, now, airtime);
+  if (delay < config->min_gap_ms) {
+    delay = config->min_gap_ms;
+  }
+  return delay < period ? delay : period;
+}
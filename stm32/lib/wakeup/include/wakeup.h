@@ -0,0 +1,159 @@
+/**
+ * @file wakeup.h
+ * @brief Coalesces the deadlines of independent timers
+ *
+ * @date 2026-10-19
+ */
+
+#ifndef LIB_WAKEUP_INCLUDE_WAKEUP_H_
+#define LIB_WAKEUP_INCLUDE_WAKEUP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @defgroup wakeup Wakeup coalescer
+ * @brief Snaps timer deadlines onto shared deadlines
+ *
+ * The measurement, LoRaWAN tx, WiFi upload and user config timers are armed
+ * from different places with independent phases, so tasks with the same
+ * period still wake the mcu separately, a few ms apart. Each timer asks the
+ * coalescer for its delay instead of using its period directly. The nominal
+ * deadline is moved later by at most the slack of the timer:
+ *
+ * - onto the earliest deadline of another client within the slack, or
+ * - up to the next multiple of the grid passed to WakeupInit.
+ *
+ * Deadlines of clients armed with WakeupPeriod are projected a whole number of
+ * periods ahead. A deadline just before the next tx is moved onto the nominal
+ * deadline of that tx, and the tx snaps onto it when its timer is rearmed.
+ * Deadlines are never moved earlier, so a task never runs before it is due.
+ *
+ * Moving a deadline makes the task late by up to the slack, and it can wait
+ * behind the other tasks of the shared wakeup. This only pays off where tasks
+ * share a period, as the measurement and upload with WiFi do. With LoRaWAN
+ * the receive windows make up most of the wakeups and are not coalesced, so
+ * WakeupSetMaxSlack(0) keeps every deadline nominal while WakeupPeriod still
+ * keeps the timers from drifting.
+ *
+ * WakeupPeriod advances the nominal deadline by the period instead of
+ * restarting from the time the timer fired, so the slack does not accumulate
+ * into the period.
+ *
+ * @code
+ * void UploadEvent(void *context) {
+ *   UTIL_SEQ_SetTask((1 << CFG_SEQ_Task_WiFiUpload), CFG_SEQ_Prio_1);
+ *   // one shot timer, rearmed on the next shared deadline
+ *   UTIL_TIMER_SetPeriod(&UploadTimer, WakeupPeriod(CFG_SEQ_Task_WiFiUpload,
+ *                                                   period, WAKEUP_SLACK));
+ *   UTIL_TIMER_Start(&UploadTimer);
+ * }
+ * @endcode
+ *
+ * Clients are keyed by their CFG_SEQ_Task_* id. Times are in ms and compared
+ * with wrapping arithmetic. The module has no hardware dependencies, see
+ * extras/scheduling for a host simulation.
+ *
+ * @{
+ */
+
+/** Number of clients, the same as the sequencer tasks */
+#define WAKEUP_MAX_CLIENTS 16
+
+#ifndef WAKEUP_GRID
+/** Spacing of the shared deadlines in ms */
+#define WAKEUP_GRID 1000
+#endif /* WAKEUP_GRID */
+
+#ifndef WAKEUP_SLACK
+/** Default time a deadline can be moved later in ms */
+#define WAKEUP_SLACK 2000
+#endif /* WAKEUP_SLACK */
+
+/** Time in ms */
+typedef uint32_t (*WakeupClockFn)(void);
+
+/**
+ * @brief Forget all deadlines
+ *
+ * @param clock Time source in ms, wraps around at 2^32
+ * @param grid Spacing of the shared deadlines in ms, 0 or 1 to only snap onto
+ * deadlines of other clients
+ */
+void WakeupInit(WakeupClockFn clock, uint32_t grid);
+
+/**
+ * @brief Limit the slack of every client
+ *
+ * Applies to clients armed after the call. Reset by WakeupInit.
+ *
+ * @param slack Max time any deadline can be moved later in ms, 0 to disable
+ * coalescing
+ */
+void WakeupSetMaxSlack(uint32_t slack);
+
+/**
+ * @brief Arm a client for a deadline
+ *
+ * @param client Task id
+ * @param due Nominal deadline in ms
+ * @param slack Max time the deadline can be moved later in ms
+ *
+ * @return Time from now to the coalesced deadline in ms, 0 if it passed
+ */
+uint32_t WakeupAt(int client, uint32_t due, uint32_t slack);
+
+/**
+ * @brief Arm a client a delay from now
+ *
+ * @param client Task id
+ * @param delay Nominal delay in ms
+ * @param slack Max time the deadline can be moved later in ms
+ *
+ * @return Time from now to the coalesced deadline in ms
+ */
+uint32_t WakeupDelay(int client, uint32_t delay, uint32_t slack);
+
+/**
+ * @brief Arm a client one period after its last nominal deadline
+ *
+ * Starts from now if the client is not armed or missed a whole period.
+ *
+ * @param client Task id
+ * @param period Period in ms
+ * @param slack Max time the deadline can be moved later in ms
+ *
+ * @return Time from now to the coalesced deadline in ms
+ */
+uint32_t WakeupPeriod(int client, uint32_t period, uint32_t slack);
+
+/**
+ * @brief Disarm a client when its timer is stopped
+ *
+ * @param client Task id
+ */
+void WakeupCancel(int client);
+
+/**
+ * @brief Get the coalesced deadline of a client
+ *
+ * @param client Task id
+ * @param due Deadline in ms
+ *
+ * @return false if the client is not armed or its deadline passed
+ */
+bool WakeupGet(int client, uint32_t *due);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // LIB_WAKEUP_INCLUDE_WAKEUP_H_
@@ -0,0 +1,182 @@
+/**
+ * @file wakeup.c
+ *
+ * @see wakeup.h
+ *
+ * @date 2026-10-19
+ */
+
+#include "wakeup.h"
+
+#include <stddef.h>
+
+/** Deadline each client asked for */
+static uint32_t nominal[WAKEUP_MAX_CLIENTS];
+
+/** Deadline each client was armed for after coalescing */
+static uint32_t deadline[WAKEUP_MAX_CLIENTS];
+
+/** Period of clients armed by WakeupPeriod, 0 for one shot deadlines */
+static uint32_t interval[WAKEUP_MAX_CLIENTS];
+
+/** Bit set for each armed client */
+static uint32_t armed = 0;
+
+/** Spacing of the shared deadlines */
+static uint32_t spacing = 0;
+
+/** Limit of the slack of every client */
+static uint32_t max_slack = UINT32_MAX;
+
+/** Time source */
+static WakeupClockFn clock_fn = NULL;
+
+/**
+ * @brief Current time, 0 before WakeupInit
+ */
+static uint32_t Now(void) { return (clock_fn != NULL) ? clock_fn() : 0; }
+
+/**
+ * @brief Check if time @p a is before time @p b, accounting for wrap around
+ */
+static bool Before(uint32_t a, uint32_t b) { return (int32_t)(a - b) < 0; }
+
+static bool Valid(int client) {
+  return client >= 0 && client < WAKEUP_MAX_CLIENTS;
+}
+
+/**
+ * @brief Check if a client is armed for a deadline that did not pass
+ */
+static bool Pending(int client, uint32_t now) {
+  return (armed & (1UL << client)) && !Before(deadline[client], now);
+}
+
+/**
+ * @brief Time from now to a deadline, 0 if it passed
+ */
+static uint32_t Until(uint32_t due, uint32_t now) {
+  return Before(now, due) ? due - now : 0;
+}
+
+/**
+ * @brief First nominal deadline of a periodic client after its pending one
+ * that is not before @p due
+ */
+static uint32_t Project(int client, uint32_t due) {
+  const uint32_t next = nominal[client] + interval[client];
+  if (!Before(next, due)) {
+    return next;
+  }
+  const uint32_t missed =
+      (due - next + interval[client] - 1) / interval[client];
+  return next + missed * interval[client];
+}
+
+/**
+ * @brief Move a deadline onto a shared deadline within the slack
+ */
+static uint32_t Coalesce(int client, uint32_t due, uint32_t slack,
+                         uint32_t now) {
+  // earliest deadline of another client, those wake the mcu anyway
+  bool found = false;
+  uint32_t best = due;
+  for (int i = 0; i < WAKEUP_MAX_CLIENTS; i++) {
+    if (i == client || !(armed & (1UL << i))) {
+      continue;
+    }
+
+    // deadlines before due wrap around to a large offset
+    if (Pending(i, now) && deadline[i] - due <= slack &&
+        (!found || Before(deadline[i], best))) {
+      best = deadline[i];
+      found = true;
+    }
+
+    // a periodic client snaps onto this deadline when it rearms for the
+    // nominal one
+    if (interval[i] != 0) {
+      const uint32_t later = Project(i, due);
+      if (later - due <= slack && (!found || Before(later, best))) {
+        best = later;
+        found = true;
+      }
+    }
+  }
+  if (found) {
+    return best;
+  }
+
+  if (spacing > 1) {
+    const uint32_t rem = due % spacing;
+    if (rem != 0 && spacing - rem <= slack) {
+      return due + (spacing - rem);
+    }
+  }
+  return due;
+}
+
+/**
+ * @brief Arm a client with a period, 0 for a one shot deadline
+ */
+static uint32_t Arm(int client, uint32_t due, uint32_t period,
+                    uint32_t slack) {
+  const uint32_t now = Now();
+  if (!Valid(client)) {
+    return Until(due, now);
+  }
+
+  if (slack > max_slack) {
+    slack = max_slack;
+  }
+
+  nominal[client] = due;
+  interval[client] = period;
+  deadline[client] = Coalesce(client, due, slack, now);
+  armed |= 1UL << client;
+  return Until(deadline[client], now);
+}
+
+void WakeupInit(WakeupClockFn clock, uint32_t grid) {
+  clock_fn = clock;
+  spacing = grid;
+  max_slack = UINT32_MAX;
+  armed = 0;
+}
+
+void WakeupSetMaxSlack(uint32_t slack) { max_slack = slack; }
+
+uint32_t WakeupAt(int client, uint32_t due, uint32_t slack) {
+  return Arm(client, due, 0, slack);
+}
+
+uint32_t WakeupDelay(int client, uint32_t delay, uint32_t slack) {
+  return WakeupAt(client, Now() + delay, slack);
+}
+
+uint32_t WakeupPeriod(int client, uint32_t period, uint32_t slack) {
+  const uint32_t now = Now();
+  uint32_t due = now + period;
+  if (Valid(client) && (armed & (1UL << client))) {
+    // keep the phase unless a period was missed or the period got shorter
+    const uint32_t next = nominal[client] + period;
+    if (Before(now, next) && !Before(due, next)) {
+      due = next;
+    }
+  }
+  return Arm(client, due, period, slack);
+}
+
+void WakeupCancel(int client) {
+  if (Valid(client)) {
+    armed &= ~(1UL << client);
+  }
+}
+
+bool WakeupGet(int client, uint32_t *due) {
+  if (!Valid(client) || !Pending(client, Now())) {
+    return false;
+  }
+  *due = deadline[client];
+  return true;
+}
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "calibration.h"
 #include "sensor.h"
 #include "sensors.h"
 #include "stm32wlxx_hal_def.h"
@@ -29,15 +30,15 @@
 // Variables
 extern volatile uint32_t
     pulse_count;  // Managed by GPIO interrupt in stm32wlxx_it.c
-static volatile float last_flow_lpm = 0;
+static volatile q32_t last_flow_lpm = 0;
 static SysTime_t currentTime;
 static SysTime_t lastTime;
-static volatile float flow_history[FLOW_AVG_COUNT] = {0};
+static volatile q32_t flow_history[FLOW_AVG_COUNT] = {0};
 static uint8_t flow_index = 0;
 
 // For every one liter of water that passes through the sensor in one minute,
 // there are 450 pulses. Therefore the calibration factor becomes [450/60 = 7.5]
-const float calibration_factor = 7.5;
+// and is applied by the SensorType_YFS210C_FLOW calibration.
 
 void FlowYFS210CInit() {
   GPIO_InitTypeDef GPIO_InitStruct = {0};
@@ -71,11 +72,12 @@ YFS210CMeasurement FlowYFS210CGetMeasurement() {
 
   YFS210CMeasurement flowMeas;
 
-  // Calculate liters per minute based on actual time elapsed
-  float time_elapsed_minutes =
-      (float)diff.SubSeconds / 6000.0f;  // Convert subseconds to minutes
-  if (time_elapsed_minutes > 0) {
-    last_flow_lpm = ((float)pulses / calibration_factor) / time_elapsed_minutes;
+  // Calculate liters per minute based on actual time elapsed, the time in
+  // minutes is SubSeconds / 6000
+  if (diff.SubSeconds > 0) {
+    last_flow_lpm =
+        CalibrationApply(CalibrationGet(SensorType_YFS210C_FLOW),
+                         Q32FromRatio(pulses, diff.SubSeconds));
     pulse_count = 0;  // Reset after calculation
     lastTime = currentTime;
   }
@@ -84,11 +86,11 @@ YFS210CMeasurement FlowYFS210CGetMeasurement() {
   flow_history[flow_index] = last_flow_lpm;
   flow_index = (flow_index + 1) % FLOW_AVG_COUNT;
 
-  float sum = 0.0f;
+  q32_t sum = 0;
   for (int i = 0; i < FLOW_AVG_COUNT; i++) {
-    sum += flow_history[i];
+    sum = Q32Add(sum, flow_history[i]);
   }
-  flowMeas.flow = sum / FLOW_AVG_COUNT;
+  flowMeas.flow = Q32ToFloat(sum / FLOW_AVG_COUNT);
 
   return flowMeas;
 }
@@ -104,7 +106,7 @@ size_t WatFlowYFS210C_measure(uint8_t* data, SysTime_t ts, uint32_t idx,
   }
 
   /// read measurement
-  flowMeas.flow = last_flow_lpm;
+  flowMeas.flow = Q32ToFloat(last_flow_lpm);
   const UserConfiguration* cfg = UserConfigGet();
 
   // metadata
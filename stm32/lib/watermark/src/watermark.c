@@ -15,6 +15,7 @@
 #include <string.h>
 
 #include "adc.h"
+#include "calibration.h"
 #include "sensor.h"
 #include "sensors.h"
 #include "transcoder.h"
@@ -57,8 +58,6 @@ void Watermark200Init(EnabledSensorMultiple *sensor) {
 
 double Watermark200SS_GetMeasurement(EnabledSensorMultiple *sensor) {
   uint32_t value_raw = 0;
-  double value_voltage = 0.0;
-  double tension_kPa = 0.0;
 
   // 0 - 239 kPa from 0 - 2.8 V :: kPa = Volts / 0.0117
   uint32_t channel = 0;
@@ -74,17 +73,15 @@ double Watermark200SS_GetMeasurement(EnabledSensorMultiple *sensor) {
     channel = ADC_CHANNEL_11;
   }
   value_raw = ADC_Convert_Single(channel);
-  value_voltage = (double)value_raw * 3.3 / ((1 << 12) - 1);
-  tension_kPa = value_voltage / 0.0117;
+  const q32_t tension_kPa = CalibrationApply(
+      CalibrationGet(SensorType_WATERMARK200SS_SOIL_TENSION),
+      Q32FromInt(value_raw));
 
-  return tension_kPa;
+  return Q32ToDouble(tension_kPa);
 }
 
 double Watermark200TS_GetMeasurement(EnabledSensorMultiple *sensor) {
   uint32_t value_raw = 0;
-  double value_voltage = 0.0;
-  double temperature_f = 0.0;
-  double WMTemp_C = 0.0;
   uint32_t channel = 0;
   if (sensor->index == 16) {
     channel = ADC_CHANNEL_0;
@@ -99,11 +96,11 @@ double Watermark200TS_GetMeasurement(EnabledSensorMultiple *sensor) {
   }
   value_raw = ADC_Convert_Single(channel);
   // 20 - 132 F from 0.49 - 2.8 V :: F = 50.68 * (Volts - 0.490) + 20
-  value_voltage = (double)value_raw * 3.3 / ((1 << 12) - 1);
-  temperature_f = 50.68 * (value_voltage - 0.490) + 20;
-  WMTemp_C = (temperature_f - 32) * 5.0 / 9.0;
+  const q32_t WMTemp_C = CalibrationApply(
+      CalibrationGet(SensorType_WATERMARK200TS_SOIL_TEMPERATURE),
+      Q32FromInt(value_raw));
 
-  return WMTemp_C;
+  return Q32ToDouble(WMTemp_C);
 }
 size_t Watermark200SS_measure(uint8_t *data, SysTime_t ts, uint32_t idx,
                               EnabledSensorMultiple *sensor) {
@@ -0,0 +1,213 @@
+#!/usr/bin/env python
+"""Reports the flash and stack used by the logging of each module
+
+Builds the firmware with APP_LOG_LEVEL set to every verbose level and compares
+the objects of each module, see Inc/log_conf.h. The flash of a level is the
+text and data of the module above the build with VLEVEL_OFF, which only keeps
+VLEVEL_ALWAYS. The stack is the largest frame of the module from
+-fstack-usage, also above VLEVEL_OFF. Files outside of a module are reported
+as "other".
+
+    python log_report.py -e stm32
+
+The objects are measured before the linker removes unused sections, so the
+flash is an upper bound. The firmware line is the size of firmware.elf.
+"""
+
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+
+LEVELS = ["VLEVEL_OFF", "VLEVEL_L", "VLEVEL_M", "VLEVEL_H"]
+
+MODULE = re.compile(r"^#define APP_LOG_MODULE (\w+)", re.MULTILINE)
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+
+def find_modules(root: str = ROOT) -> dict[str, str]:
+    """Finds the module of every source file.
+
+    Args:
+        root: Directory with Src and lib.
+
+    Returns:
+        Module keyed by the path of the source relative to root.
+    """
+
+    modules = {}
+    sources = glob.glob(os.path.join(root, "Src", "*.c"))
+    sources += glob.glob(os.path.join(root, "lib", "*", "src", "*.c"))
+    for path in sources:
+        with open(path, errors="replace") as f:
+            match = MODULE.search(f.read())
+        if match:
+            modules[os.path.relpath(path, root)] = match.group(1)
+    return modules
+
+
+def object_module(obj: str, build_dir: str, modules: dict[str, str]) -> str:
+    """Finds the module of an object.
+
+    Objects of Src are in build_dir/src and objects of a library are in a
+    directory named after the library.
+
+    Args:
+        obj: Path to the object.
+        build_dir: Build directory.
+        modules: Output of find_modules.
+
+    Returns:
+        Name of the module, "other" if the source is not part of one.
+    """
+
+    parts = os.path.relpath(obj, build_dir).split(os.sep)
+    stem = os.path.splitext(parts[-1])[0]
+    for source, module in modules.items():
+        src_parts = source.split(os.sep)
+        if os.path.splitext(src_parts[-1])[0] != stem:
+            continue
+        if src_parts[0] == "Src" and parts[0] == "src":
+            return module
+        if src_parts[0] == "lib" and src_parts[1] in parts[:-1]:
+            return module
+    return "other"
+
+
+def stack_usage(obj: str) -> int:
+    """Largest stack frame of an object from its .su file, 0 if missing."""
+
+    path = os.path.splitext(obj)[0] + ".su"
+    if not os.path.exists(path):
+        return 0
+    frames = [0]
+    with open(path) as f:
+        for line in f:
+            fields = line.rstrip("\n").split("\t")
+            if len(fields) >= 2 and fields[1].isdigit():
+                frames.append(int(fields[1]))
+    return max(frames)
+
+
+def measure(
+    build_dir: str, modules: dict[str, str], size_tool: str = "size"
+) -> dict[str, tuple[int, int]]:
+    """Measures the objects of a build.
+
+    Args:
+        build_dir: Build directory with the objects.
+        modules: Output of find_modules.
+        size_tool: size of the toolchain.
+
+    Returns:
+        Flash (text and data) and largest stack frame keyed by module.
+    """
+
+    objs = sorted(glob.glob(os.path.join(build_dir, "**", "*.o"), recursive=True))
+    if not objs:
+        return {}
+
+    out = subprocess.run(
+        [size_tool, *objs], check=True, capture_output=True, text=True
+    ).stdout
+
+    results = {}
+    for line in out.splitlines()[1:]:
+        fields = line.split()
+        text, data, obj = int(fields[0]), int(fields[1]), fields[-1]
+        module = object_module(obj, build_dir, modules)
+        flash, stack = results.get(module, (0, 0))
+        results[module] = (flash + text + data, max(stack, stack_usage(obj)))
+    return results
+
+
+def format_report(results: dict[str, dict[str, tuple[int, int]]]) -> str:
+    """Formats the cost of each module at each level.
+
+    Args:
+        results: Output of measure keyed by level, including VLEVEL_OFF.
+
+    Returns:
+        Table of the flash and stack above VLEVEL_OFF.
+    """
+
+    base = results[LEVELS[0]]
+    levels = [level for level in LEVELS[1:] if level in results]
+
+    header = f"{'module':<12}"
+    header += "".join(f"{'flash ' + level[-1]:>10}" for level in levels)
+    header += "".join(f"{'stack ' + level[-1]:>10}" for level in levels)
+    lines = [header]
+
+    for module in sorted(base):
+        line = f"{module:<12}"
+        line += "".join(
+            f"{results[level].get(module, (0, 0))[0] - base[module][0]:>10}"
+            for level in levels
+        )
+        line += "".join(
+            f"{results[level].get(module, (0, 0))[1] - base[module][1]:>10}"
+            for level in levels
+        )
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def build(env: str, level: str) -> str:
+    """Builds an environment with a log threshold.
+
+    Args:
+        env: PlatformIO environment.
+        level: Value of APP_LOG_LEVEL.
+
+    Returns:
+        Build directory.
+    """
+
+    flags = f"-fstack-usage -DAPP_LOG_LEVEL={level}"
+    subprocess.run(
+        ["pio", "run", "-e", env],
+        check=True,
+        cwd=ROOT,
+        env={**os.environ, "PLATFORMIO_BUILD_FLAGS": flags},
+    )
+    return os.path.join(ROOT, ".pio", "build", env)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-e", "--env", default="stm32", help="Environment")
+    parser.add_argument(
+        "--size", default="arm-none-eabi-size", help="size of the toolchain"
+    )
+    args = parser.parse_args()
+
+    size_tool = shutil.which(args.size) or os.path.expanduser(
+        "~/.platformio/packages/toolchain-gccarmnoneeabi/bin/arm-none-eabi-size"
+    )
+
+    modules = find_modules()
+    results = {}
+    firmware = {}
+    for level in LEVELS:
+        build_dir = build(args.env, level)
+        results[level] = measure(build_dir, modules, size_tool)
+        elf = os.path.join(build_dir, "firmware.elf")
+        out = subprocess.run(
+            [size_tool, elf], check=True, capture_output=True, text=True
+        ).stdout
+        text, data, bss = (int(x) for x in out.splitlines()[1].split()[:3])
+        firmware[level] = (text + data, data + bss)
+
+    print(format_report(results))
+    print()
+    for level in LEVELS:
+        flash, ram = firmware[level]
+        print(f"firmware {level:<12} flash {flash:>8} ram {ram:>8}")
+
+
+if __name__ == "__main__":
+    main()
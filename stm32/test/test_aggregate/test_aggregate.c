@@ -0,0 +1,291 @@
+/**
+ * @file test_aggregate.c
+ * @brief Tests windowed summaries of sensor measurements
+ *
+ * The uplink size with recorded data is replayed on the host by
+ * extras/aggregation/aggregate_replay.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "aggregate.h"
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "sensor.h"
+#include "usart.h"
+
+/** Aggregator under test */
+static Aggregator agg;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { AggregateInit(&agg); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+/**
+ * @brief Build a decimal measurement
+ */
+static SensorMeasurement Decimal(SensorType type, uint32_t ts, double x) {
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.has_meta = true;
+  meas.meta.cell_id = 1;
+  meas.meta.logger_id = 2;
+  meas.meta.ts = ts;
+  meas.type = type;
+  meas.which_value = SensorMeasurement_decimal_tag;
+  meas.value.decimal = x;
+  return meas;
+}
+
+void TestWelford(void) {
+  const double x[] = {2, 4, 4, 4, 5, 5, 7, 9};
+  Welford stats;
+  WelfordReset(&stats);
+  for (int i = 0; i < 8; i++) {
+    WelfordAdd(&stats, x[i]);
+  }
+
+  TEST_ASSERT_EQUAL(8, stats.count);
+  TEST_ASSERT_EQUAL_DOUBLE(5.0, stats.mean);
+  TEST_ASSERT_EQUAL_DOUBLE(2.0, stats.min);
+  TEST_ASSERT_EQUAL_DOUBLE(9.0, stats.max);
+  // sum of squares 32 over n - 1
+  TEST_ASSERT_DOUBLE_WITHIN(1e-12, 2.138089935299395, WelfordStddev(&stats));
+}
+
+void TestWelfordSingle(void) {
+  Welford stats;
+  WelfordReset(&stats);
+  WelfordAdd(&stats, -3.5);
+
+  TEST_ASSERT_EQUAL_DOUBLE(-3.5, stats.mean);
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, WelfordStddev(&stats));
+}
+
+void TestWelfordLargeOffset(void) {
+  // the naive sum of squares loses all precision around 1e9
+  Welford stats;
+  WelfordReset(&stats);
+  WelfordAdd(&stats, 1e9 + 4);
+  WelfordAdd(&stats, 1e9 + 7);
+  WelfordAdd(&stats, 1e9 + 13);
+  WelfordAdd(&stats, 1e9 + 16);
+
+  TEST_ASSERT_DOUBLE_WITHIN(1e-6, 30.0, stats.m2 / 3);
+}
+
+void TestDisabled(void) {
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_VWC, 0, 1.0);
+  SensorMeasurement summary;
+
+  TEST_ASSERT_EQUAL(AGGREGATE_RAW,
+                    AggregateAdd(&agg, 0, 0, 0, &meas, &summary));
+}
+
+void TestCount(void) {
+  SensorMeasurement summary;
+
+  for (int i = 0; i < 3; i++) {
+    SensorMeasurement meas = Decimal(SensorType_TEROS12_VWC, 100 + i, i + 1);
+    meas.idx = 10 + i;
+    TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                      AggregateAdd(&agg, 0, 4, 0, &meas, &summary));
+  }
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_VWC, 103, 10.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_SUMMARY,
+                    AggregateAdd(&agg, 0, 4, 0, &meas, &summary));
+
+  TEST_ASSERT_TRUE(summary.has_meta);
+  TEST_ASSERT_EQUAL(100, summary.meta.ts);
+  TEST_ASSERT_EQUAL(1, summary.meta.cell_id);
+  TEST_ASSERT_EQUAL(2, summary.meta.logger_id);
+  TEST_ASSERT_EQUAL(10, summary.idx);
+  TEST_ASSERT_EQUAL(SensorType_TEROS12_VWC, summary.type);
+  TEST_ASSERT_EQUAL(SensorMeasurement_summary_tag, summary.which_value);
+  TEST_ASSERT_EQUAL(4, summary.value.summary.count);
+  TEST_ASSERT_EQUAL_FLOAT(1.0, summary.value.summary.min);
+  TEST_ASSERT_EQUAL_FLOAT(4.0, summary.value.summary.mean);
+  TEST_ASSERT_EQUAL_FLOAT(10.0, summary.value.summary.max);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 4.08248, summary.value.summary.stddev);
+
+  // window is empty again
+  TEST_ASSERT_FALSE(AggregateFlush(&agg, &summary));
+}
+
+void TestPeriod(void) {
+  SensorMeasurement summary;
+
+  SensorMeasurement meas = Decimal(SensorType_POWER_VOLTAGE, 1000, 1.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 0, 60, &meas, &summary));
+  meas = Decimal(SensorType_POWER_VOLTAGE, 1059, 3.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 0, 60, &meas, &summary));
+
+  // first sample past the window closes it and starts the next one
+  meas = Decimal(SensorType_POWER_VOLTAGE, 1060, 100.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_SUMMARY,
+                    AggregateAdd(&agg, 0, 0, 60, &meas, &summary));
+  TEST_ASSERT_EQUAL(1000, summary.meta.ts);
+  TEST_ASSERT_EQUAL(2, summary.value.summary.count);
+  TEST_ASSERT_EQUAL_FLOAT(2.0, summary.value.summary.mean);
+
+  TEST_ASSERT_TRUE(AggregateFlush(&agg, &summary));
+  TEST_ASSERT_EQUAL(1060, summary.meta.ts);
+  TEST_ASSERT_EQUAL(1, summary.value.summary.count);
+  TEST_ASSERT_EQUAL_FLOAT(100.0, summary.value.summary.mean);
+  TEST_ASSERT_EQUAL_FLOAT(0.0, summary.value.summary.stddev);
+}
+
+void TestCountBeforePeriod(void) {
+  SensorMeasurement summary;
+
+  SensorMeasurement meas = Decimal(SensorType_POWER_VOLTAGE, 0, 1.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 2, 3600, &meas, &summary));
+  meas = Decimal(SensorType_POWER_VOLTAGE, 1, 2.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_SUMMARY,
+                    AggregateAdd(&agg, 0, 2, 3600, &meas, &summary));
+  TEST_ASSERT_EQUAL(2, summary.value.summary.count);
+}
+
+void TestIntegerValues(void) {
+  SensorMeasurement summary;
+
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.type = SensorType_TEROS12_EC;
+  meas.which_value = SensorMeasurement_unsigned_int_tag;
+  meas.value.unsigned_int = 4000000000u;
+  AggregateAdd(&agg, 0, 2, 0, &meas, &summary);
+
+  meas.which_value = SensorMeasurement_signed_int_tag;
+  meas.value.signed_int = -2000000000;
+  TEST_ASSERT_EQUAL(AGGREGATE_SUMMARY,
+                    AggregateAdd(&agg, 0, 2, 0, &meas, &summary));
+  TEST_ASSERT_EQUAL_FLOAT(-2e9f, summary.value.summary.min);
+  TEST_ASSERT_EQUAL_FLOAT(4e9f, summary.value.summary.max);
+  TEST_ASSERT_EQUAL_FLOAT(1e9f, summary.value.summary.mean);
+}
+
+void TestNonNumericIsRaw(void) {
+  SensorMeasurement summary;
+
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.type = SensorType_TEROS12_VWC;
+  meas.which_value = SensorMeasurement_summary_tag;
+  TEST_ASSERT_EQUAL(AGGREGATE_RAW,
+                    AggregateAdd(&agg, 0, 2, 0, &meas, &summary));
+
+  meas.which_value = 0;
+  TEST_ASSERT_EQUAL(AGGREGATE_RAW,
+                    AggregateAdd(&agg, 0, 2, 0, &meas, &summary));
+  TEST_ASSERT_FALSE(AggregateFlush(&agg, &summary));
+}
+
+void TestSeparateStreams(void) {
+  SensorMeasurement summary;
+
+  // same type on two sensors and two types on the same sensor
+  SensorMeasurement a = Decimal(SensorType_BME280_TEMP, 0, 1.0);
+  SensorMeasurement b = Decimal(SensorType_BME280_TEMP, 0, 50.0);
+  SensorMeasurement c = Decimal(SensorType_BME280_HUMIDITY, 0, 90.0);
+
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 2, 0, &a, &summary));
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 1, 2, 0, &b, &summary));
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 2, 0, &c, &summary));
+
+  a.value.decimal = 3.0;
+  TEST_ASSERT_EQUAL(AGGREGATE_SUMMARY,
+                    AggregateAdd(&agg, 0, 2, 0, &a, &summary));
+  TEST_ASSERT_EQUAL(SensorType_BME280_TEMP, summary.type);
+  TEST_ASSERT_EQUAL_FLOAT(2.0, summary.value.summary.mean);
+
+  int flushed = 0;
+  while (AggregateFlush(&agg, &summary)) {
+    ++flushed;
+  }
+  TEST_ASSERT_EQUAL(2, flushed);
+}
+
+void TestFull(void) {
+  SensorMeasurement summary;
+
+  for (int i = 0; i < AGGREGATE_MAX_STREAMS; i++) {
+    SensorMeasurement meas = Decimal(SensorType_POWER_VOLTAGE, 0, i);
+    TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                      AggregateAdd(&agg, i, 10, 0, &meas, &summary));
+  }
+
+  // no free window, the sample is uploaded raw
+  SensorMeasurement meas = Decimal(SensorType_POWER_VOLTAGE, 0, 1.0);
+  TEST_ASSERT_EQUAL(AGGREGATE_RAW,
+                    AggregateAdd(&agg, AGGREGATE_MAX_STREAMS, 10, 0, &meas,
+                                 &summary));
+
+  // open windows keep aggregating
+  TEST_ASSERT_EQUAL(AGGREGATE_HELD,
+                    AggregateAdd(&agg, 0, 10, 0, &meas, &summary));
+}
+
+void TestSummaryEncodes(void) {
+  SensorMeasurement summary;
+
+  for (int i = 0; i < 60; i++) {
+    SensorMeasurement meas =
+        Decimal(SensorType_TEROS12_TEMP, 1700000000 + i * 10, 20.0 + i * 0.1);
+    AggregateAdd(&agg, 0, 60, 0, &meas, &summary);
+  }
+
+  uint8_t buffer[SensorMeasurement_size];
+  size_t size = sizeof(buffer);
+  TEST_ASSERT_EQUAL(SENSOR_OK,
+                    EncodeSensorMeasurement(&summary, buffer, &size));
+
+  SensorMeasurement decoded = SensorMeasurement_init_zero;
+  TEST_ASSERT_EQUAL(SENSOR_OK,
+                    DecodeSensorMeasurement(buffer, size, &decoded));
+  TEST_ASSERT_EQUAL(SensorMeasurement_summary_tag, decoded.which_value);
+  TEST_ASSERT_EQUAL(60, decoded.value.summary.count);
+  TEST_ASSERT_EQUAL(1700000000, decoded.meta.ts);
+  TEST_ASSERT_FLOAT_WITHIN(1e-4, 22.95, decoded.value.summary.mean);
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestWelford);
+  RUN_TEST(TestWelfordSingle);
+  RUN_TEST(TestWelfordLargeOffset);
+  RUN_TEST(TestDisabled);
+  RUN_TEST(TestCount);
+  RUN_TEST(TestPeriod);
+  RUN_TEST(TestCountBeforePeriod);
+  RUN_TEST(TestIntegerValues);
+  RUN_TEST(TestNonNumericIsRaw);
+  RUN_TEST(TestSeparateStreams);
+  RUN_TEST(TestFull);
+  RUN_TEST(TestSummaryEncodes);
+
+  UNITY_END();
+}
@@ -0,0 +1,374 @@
+/**
+ * @file test_async.c
+ * @brief Tests the async measurement queue with fake drivers and clock
+ *
+ * The awake time of a full measurement cycle is simulated on the host by
+ * extras/scheduling/async_sim.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "async.h"
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+
+/** Fake sensor passed as driver context */
+typedef struct {
+  /** Time between start and poll in ms */
+  uint32_t conversion;
+  /** Bus shared with other fake sensors, NULL for a private bus */
+  bool *bus;
+  /** Status returned by poll */
+  AsyncStatus result;
+  /** Number of polls returning ASYNC_WAIT before the result */
+  int steps;
+  /** Number of calls to start */
+  int starts;
+  /** Number of calls to poll */
+  int polls;
+  /** Number of calls to cancel */
+  int cancels;
+} FakeSensor;
+
+/** Queue under test */
+static AsyncQueue queue;
+
+/** Fake time in ms */
+static uint32_t now;
+
+/** Ids passed to the done callback in order */
+static uint8_t done_ids[ASYNC_MAX_TASKS];
+
+/** Status passed to the done callback in order */
+static AsyncStatus done_status[ASYNC_MAX_TASKS];
+
+/** Number of done callbacks */
+static int done_len;
+
+static uint32_t FakeClock(void) { return now; }
+
+static void FakeDone(uint8_t id, AsyncStatus status) {
+  done_ids[done_len] = id;
+  done_status[done_len] = status;
+  ++done_len;
+}
+
+static AsyncStatus FakeStart(void *ctx, uint32_t *wait_ms) {
+  FakeSensor *sensor = ctx;
+  if (sensor->bus != NULL) {
+    if (*sensor->bus) {
+      return ASYNC_BUSY;
+    }
+    *sensor->bus = true;
+  }
+
+  ++sensor->starts;
+  *wait_ms = sensor->conversion;
+  return ASYNC_WAIT;
+}
+
+static AsyncStatus FakePoll(void *ctx, uint32_t *wait_ms) {
+  FakeSensor *sensor = ctx;
+  if (sensor->bus != NULL) {
+    *sensor->bus = false;
+  }
+
+  // the bus is released on the first poll like a concurrent measurement
+  ++sensor->polls;
+  if (sensor->polls <= sensor->steps) {
+    *wait_ms = sensor->conversion;
+    return ASYNC_WAIT;
+  }
+
+  *wait_ms = 0;
+  return sensor->result;
+}
+
+static void FakeCancel(void *ctx) {
+  FakeSensor *sensor = ctx;
+  if (sensor->bus != NULL) {
+    *sensor->bus = false;
+  }
+
+  ++sensor->cancels;
+}
+
+/** Driver of the fake sensors */
+static const AsyncDriver fake_driver = {FakeStart, FakePoll, FakeCancel};
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {
+  AsyncInit(&queue);
+  now = 1000;
+  done_len = 0;
+}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestEmpty(void) {
+  uint32_t wake = 0;
+
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_FALSE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(0, done_len);
+}
+
+void TestSubmitFull(void) {
+  FakeSensor sensor = {.conversion = 10, .result = ASYNC_DONE};
+
+  for (int i = 0; i < ASYNC_MAX_TASKS; i++) {
+    TEST_ASSERT_TRUE(AsyncSubmit(&queue, &fake_driver, &sensor, i));
+  }
+  TEST_ASSERT_FALSE(AsyncSubmit(&queue, &fake_driver, &sensor, 0));
+}
+
+void TestPendingNotNext(void) {
+  FakeSensor sensor = {.conversion = 10, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &sensor, 0);
+
+  // not started yet, nothing to wait for
+  TEST_ASSERT_FALSE(AsyncNext(&queue, &wake));
+}
+
+void TestStartPollDone(void) {
+  FakeSensor sensor = {.conversion = 120, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &sensor, 3);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_EQUAL(1, sensor.starts);
+  TEST_ASSERT_EQUAL(0, sensor.polls);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1120, wake);
+
+  // early wakeup does not poll
+  now = 1119;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(0, sensor.polls);
+  TEST_ASSERT_EQUAL(0, done_len);
+
+  now = 1120;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(1, sensor.polls);
+  TEST_ASSERT_EQUAL(1, done_len);
+  TEST_ASSERT_EQUAL(3, done_ids[0]);
+  TEST_ASSERT_EQUAL(ASYNC_DONE, done_status[0]);
+  TEST_ASSERT_FALSE(AsyncNext(&queue, &wake));
+}
+
+void TestOverlap(void) {
+  FakeSensor slow = {.conversion = 500, .result = ASYNC_DONE};
+  FakeSensor fast = {.conversion = 100, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &slow, 0);
+  AsyncSubmit(&queue, &fake_driver, &fast, 1);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  // both conversions run at the same time
+  TEST_ASSERT_EQUAL(1, slow.starts);
+  TEST_ASSERT_EQUAL(1, fast.starts);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1100, wake);
+
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(1, done_len);
+  TEST_ASSERT_EQUAL(1, done_ids[0]);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1500, wake);
+
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(2, done_len);
+  TEST_ASSERT_EQUAL(0, done_ids[1]);
+}
+
+void TestBusyRetryAfterDone(void) {
+  bool bus = false;
+  FakeSensor first = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  FakeSensor second = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &first, 0);
+  AsyncSubmit(&queue, &fake_driver, &second, 1);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_EQUAL(1, first.starts);
+  TEST_ASSERT_EQUAL(0, second.starts);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1050, wake);
+
+  // second starts in the same run the bus is released
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(1, done_len);
+  TEST_ASSERT_EQUAL(1, second.starts);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1100, wake);
+
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(2, done_len);
+  TEST_ASSERT_EQUAL(1, done_ids[1]);
+}
+
+void TestBusyRetryAfterPoll(void) {
+  bool bus = false;
+  FakeSensor first = {
+      .conversion = 50, .bus = &bus, .result = ASYNC_DONE, .steps = 1};
+  FakeSensor second = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &first, 0);
+  AsyncSubmit(&queue, &fake_driver, &second, 1);
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(0, second.starts);
+
+  // first releases the bus but keeps measuring
+  now = 1050;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(0, done_len);
+  TEST_ASSERT_EQUAL(1, second.starts);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1100, wake);
+
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(2, done_len);
+}
+
+void TestBusyRetryTimeout(void) {
+  bool bus = true;
+  FakeSensor sensor = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  // bus held outside of the queue
+  AsyncSubmit(&queue, &fake_driver, &sensor, 0);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_EQUAL(0, sensor.starts);
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(1000 + ASYNC_BUSY_RETRY, wake);
+
+  bus = false;
+  now = wake;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(1, sensor.starts);
+}
+
+void TestError(void) {
+  FakeSensor ok = {.conversion = 10, .result = ASYNC_DONE};
+  FakeSensor failed = {.conversion = 10, .result = ASYNC_ERROR};
+
+  AsyncSubmit(&queue, &fake_driver, &failed, 0);
+  AsyncSubmit(&queue, &fake_driver, &ok, 1);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  now = 1010;
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_EQUAL(2, done_len);
+  TEST_ASSERT_EQUAL(0, done_ids[0]);
+  TEST_ASSERT_EQUAL(ASYNC_ERROR, done_status[0]);
+  TEST_ASSERT_EQUAL(1, done_ids[1]);
+  TEST_ASSERT_EQUAL(ASYNC_DONE, done_status[1]);
+}
+
+void TestPollBusyIsError(void) {
+  FakeSensor sensor = {.conversion = 10, .result = ASYNC_BUSY};
+
+  AsyncSubmit(&queue, &fake_driver, &sensor, 0);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  now = 1010;
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_EQUAL(1, done_len);
+  TEST_ASSERT_EQUAL(ASYNC_ERROR, done_status[0]);
+}
+
+void TestCancel(void) {
+  bool bus = false;
+  FakeSensor started = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  FakeSensor blocked = {.conversion = 50, .bus = &bus, .result = ASYNC_DONE};
+  FakeSensor pending = {.conversion = 50, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  AsyncSubmit(&queue, &fake_driver, &started, 0);
+  AsyncSubmit(&queue, &fake_driver, &blocked, 1);
+  AsyncRun(&queue, FakeClock, FakeDone);
+  AsyncSubmit(&queue, &fake_driver, &pending, 2);
+
+  AsyncCancel(&queue);
+
+  // only the started measurement holds a bus
+  TEST_ASSERT_EQUAL(1, started.cancels);
+  TEST_ASSERT_EQUAL(0, blocked.cancels);
+  TEST_ASSERT_EQUAL(0, pending.cancels);
+  TEST_ASSERT_FALSE(bus);
+  TEST_ASSERT_FALSE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(0, done_len);
+}
+
+void TestWrapAround(void) {
+  FakeSensor sensor = {.conversion = 200, .result = ASYNC_DONE};
+  uint32_t wake = 0;
+
+  now = UINT32_MAX - 99;
+  AsyncSubmit(&queue, &fake_driver, &sensor, 0);
+  AsyncRun(&queue, FakeClock, FakeDone);
+
+  TEST_ASSERT_TRUE(AsyncNext(&queue, &wake));
+  TEST_ASSERT_EQUAL(100, wake);
+
+  // past the wrap but before the wake
+  now = 50;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(0, done_len);
+
+  now = 100;
+  AsyncRun(&queue, FakeClock, FakeDone);
+  TEST_ASSERT_EQUAL(1, done_len);
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestEmpty);
+  RUN_TEST(TestSubmitFull);
+  RUN_TEST(TestPendingNotNext);
+  RUN_TEST(TestStartPollDone);
+  RUN_TEST(TestOverlap);
+  RUN_TEST(TestBusyRetryAfterDone);
+  RUN_TEST(TestBusyRetryAfterPoll);
+  RUN_TEST(TestBusyRetryTimeout);
+  RUN_TEST(TestError);
+  RUN_TEST(TestPollBusyIsError);
+  RUN_TEST(TestCancel);
+  RUN_TEST(TestWrapAround);
+
+  UNITY_END();
+}
@@ -0,0 +1,283 @@
+/**
+ * @file test_binlog.c
+ * @brief Tests the deferred binary log
+ *
+ * The frames are decoded here the same way as ents.binlog in the Python
+ * package.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "binlog.h"
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+
+/** Size of the captured output */
+#define CAPTURE_SIZE 4096
+
+/** Output of BinlogFlush */
+static uint8_t capture[CAPTURE_SIZE];
+
+/** Length of the output */
+static size_t capture_len = 0;
+
+/** Number of writes that succeed before the output is full */
+static int writes_left = 0;
+
+/** Timestamp of the records */
+static uint32_t Timestamp(void) { return 12345; }
+
+/** Append a frame to the capture */
+static bool Capture(const uint8_t *data, size_t len) {
+  if (writes_left == 0 || capture_len + len > CAPTURE_SIZE) {
+    return false;
+  }
+  writes_left--;
+  memcpy(&capture[capture_len], data, len);
+  capture_len += len;
+  return true;
+}
+
+/**
+ * @brief Decode a frame of the capture
+ *
+ * @param index Index of the frame
+ * @param record Decoded record
+ *
+ * @return Length of the record, 0 if there is no such frame
+ */
+static size_t DecodeFrame(int index, uint8_t *record) {
+  size_t pos = 0;
+  for (int i = 0; i < index; i++) {
+    // skip both delimiters
+    pos++;
+    while (pos < capture_len && capture[pos] != 0x00) {
+      pos++;
+    }
+    pos++;
+  }
+  if (pos >= capture_len || capture[pos] != 0x00) {
+    return 0;
+  }
+  pos++;
+
+  size_t len = 0;
+  while (capture[pos] != 0x00) {
+    const uint8_t code = capture[pos++];
+    for (int i = 1; i < code; i++) {
+      record[len++] = capture[pos++];
+    }
+    if (code < 0xFF && capture[pos] != 0x00) {
+      record[len++] = 0x00;
+    }
+  }
+  return len;
+}
+
+/** Length field of a record */
+static uint16_t RecordLength(const uint8_t *record) {
+  return record[0] | record[1] << 8;
+}
+
+/** Format string of a record */
+static const char *RecordFormat(const uint8_t *record) {
+  uint32_t id = 0;
+  memcpy(&id, &record[7], sizeof(id));
+  return (const char *)(uintptr_t)id;
+}
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {
+  BinlogInit(2, Timestamp);
+  capture_len = 0;
+  writes_left = -1;
+}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestRecord(void) {
+  BINLOG(1, "%d %u %s\r\n", -5, 7u, "ab");
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+
+  uint8_t record[64];
+  const size_t len = DecodeFrame(0, record);
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 4 + 4 + 3, len);
+  TEST_ASSERT_EQUAL(len - 2, RecordLength(record));
+  TEST_ASSERT_EQUAL(1, record[2]);
+
+  uint32_t ts = 0;
+  memcpy(&ts, &record[3], sizeof(ts));
+  TEST_ASSERT_EQUAL(12345, ts);
+  TEST_ASSERT_EQUAL_STRING("%d %u %s\r\n", RecordFormat(record));
+
+  int32_t i = 0;
+  uint32_t u = 0;
+  memcpy(&i, &record[11], sizeof(i));
+  memcpy(&u, &record[15], sizeof(u));
+  TEST_ASSERT_EQUAL_INT32(-5, i);
+  TEST_ASSERT_EQUAL_UINT32(7, u);
+  TEST_ASSERT_EQUAL_STRING("ab", (const char *)&record[19]);
+
+  // nothing left
+  TEST_ASSERT_EQUAL(0, BinlogFlush(Capture));
+}
+
+void TestTypes(void) {
+  const uint8_t blob[] = {0x00, 0x01, 0x00};
+  BINLOG(0, "%f %lld %H\r\n", 1.5f, -3LL, BINLOG_BLOB(blob, sizeof(blob)));
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+
+  uint8_t record[64];
+  const size_t len = DecodeFrame(0, record);
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 8 + 8 + 2 + sizeof(blob), len);
+
+  double d = 0;
+  int64_t ll = 0;
+  uint16_t blob_len = 0;
+  memcpy(&d, &record[11], sizeof(d));
+  memcpy(&ll, &record[19], sizeof(ll));
+  memcpy(&blob_len, &record[27], sizeof(blob_len));
+  TEST_ASSERT_TRUE(d == 1.5);
+  TEST_ASSERT_TRUE(ll == -3);
+  TEST_ASSERT_EQUAL(sizeof(blob), blob_len);
+  TEST_ASSERT_EQUAL_MEMORY(blob, &record[29], sizeof(blob));
+}
+
+void TestLevel(void) {
+  BINLOG(3, "skipped\r\n");
+  BINLOG(2, "logged\r\n");
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+
+  uint8_t record[64];
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE, DecodeFrame(0, record));
+  TEST_ASSERT_EQUAL_STRING("logged\r\n", RecordFormat(record));
+}
+
+void TestFrames(void) {
+  BINLOG(0, "a\r\n");
+  BINLOG(0, "b %u\r\n", 0);
+  TEST_ASSERT_EQUAL(2, BinlogFlush(Capture));
+
+  // delimited by 0x00 and no 0x00 within
+  TEST_ASSERT_EQUAL(0x00, capture[0]);
+  TEST_ASSERT_EQUAL(0x00, capture[capture_len - 1]);
+  int zeros = 0;
+  for (size_t i = 0; i < capture_len; i++) {
+    zeros += capture[i] == 0x00;
+  }
+  TEST_ASSERT_EQUAL(4, zeros);
+
+  uint8_t record[64];
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 4, DecodeFrame(1, record));
+  TEST_ASSERT_EQUAL_STRING("b %u\r\n", RecordFormat(record));
+  TEST_ASSERT_EQUAL(0, DecodeFrame(2, record));
+}
+
+void TestLongBlob(void) {
+  // COBS blocks longer than 254 bytes
+  uint8_t blob[600];
+  for (size_t i = 0; i < sizeof(blob); i++) {
+    blob[i] = (i % 300 == 0) ? 0x00 : i;
+  }
+  BINLOG(0, "%H\r\n", BINLOG_BLOB(blob, sizeof(blob)));
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+
+  static uint8_t record[1024];
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 2 + sizeof(blob),
+                    DecodeFrame(0, record));
+  TEST_ASSERT_EQUAL_MEMORY(blob, &record[BINLOG_HEADER_SIZE + 2],
+                           sizeof(blob));
+}
+
+void TestDropped(void) {
+  uint8_t blob[100] = {0};
+  const int records = BINLOG_BUFFER_SIZE / sizeof(blob) + 3;
+  for (int i = 0; i < records; i++) {
+    BINLOG(0, "%H\r\n", BINLOG_BLOB(blob, sizeof(blob)));
+  }
+  const uint32_t dropped = BinlogDropped();
+  TEST_ASSERT_GREATER_THAN(0, dropped);
+
+  TEST_ASSERT_EQUAL(records - dropped + 1, BinlogFlush(Capture));
+  TEST_ASSERT_EQUAL(0, BinlogDropped());
+
+  uint8_t record[64];
+  TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 4, DecodeFrame(0, record));
+  uint32_t id = 0;
+  uint32_t count = 0;
+  memcpy(&id, &record[7], sizeof(id));
+  memcpy(&count, &record[11], sizeof(count));
+  TEST_ASSERT_EQUAL(BINLOG_ID_DROPPED, id);
+  TEST_ASSERT_EQUAL(dropped, count);
+
+  // space is available again
+  BINLOG(0, "%H\r\n", BINLOG_BLOB(blob, sizeof(blob)));
+  TEST_ASSERT_EQUAL(0, BinlogDropped());
+}
+
+void TestRetry(void) {
+  BINLOG(0, "a\r\n");
+  BINLOG(0, "b\r\n");
+
+  writes_left = 1;
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+  writes_left = -1;
+  TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+
+  uint8_t record[64];
+  DecodeFrame(0, record);
+  TEST_ASSERT_EQUAL_STRING("a\r\n", RecordFormat(record));
+  DecodeFrame(1, record);
+  TEST_ASSERT_EQUAL_STRING("b\r\n", RecordFormat(record));
+}
+
+void TestWrap(void) {
+  uint8_t record[64];
+  for (uint32_t i = 0; i < 3 * BINLOG_BUFFER_SIZE / 19; i++) {
+    BINLOG(0, "%u %u\r\n", i, ~i);
+    capture_len = 0;
+    TEST_ASSERT_EQUAL(1, BinlogFlush(Capture));
+    TEST_ASSERT_EQUAL(BINLOG_HEADER_SIZE + 8, DecodeFrame(0, record));
+
+    uint32_t a = 0;
+    uint32_t b = 0;
+    memcpy(&a, &record[11], sizeof(a));
+    memcpy(&b, &record[15], sizeof(b));
+    TEST_ASSERT_EQUAL_UINT32(i, a);
+    TEST_ASSERT_EQUAL_UINT32(~i, b);
+  }
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestRecord);
+  RUN_TEST(TestTypes);
+  RUN_TEST(TestLevel);
+  RUN_TEST(TestFrames);
+  RUN_TEST(TestLongBlob);
+  RUN_TEST(TestDropped);
+  RUN_TEST(TestRetry);
+  RUN_TEST(TestWrap);
+
+  UNITY_END();
+}
@@ -0,0 +1,527 @@
+/**
+ * @file test_compress.c
+ * @brief Tests the compression library
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "codec.h"
+#include "delta.h"
+#include "dict.h"
+#include "gpio.h"
+#include "lz77.h"
+#include "lz78.h"
+#include "main.h"
+#include "rle.h"
+#include "usart.h"
+
+/** Dictionary under test */
+static Dict dict;
+
+/** Serialized power measurement containing zero bytes */
+static const uint8_t meas_power[] = {
+    0x0a, 0x0a, 0x08, 0x04, 0x10, 0x07, 0x18, 0xf0, 0xab, 0xe3, 0xac,
+    0x05, 0x12, 0x12, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xa2,
+    0x40, 0x19, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 0x40};
+
+/** meas_power compressed without a dictionary by ents.compress.lz77 */
+static const uint8_t meas_power_lz77[] = {
+    0x00, 0x20, 0x05, 0x02, 0x81, 0x00, 0x40, 0x80, 0x1c, 0x30, 0xf0,
+    0x55, 0xb8, 0xd5, 0x80, 0x50, 0x90, 0x48, 0x22, 0x00, 0x80, 0x00,
+    0xb0, 0x14, 0x44, 0x00, 0xcc, 0x04, 0x08, 0x00, 0x59, 0x20, 0x00};
+
+/** meas_power compressed with dictionary 1 by ents.compress.lz77 */
+static const uint8_t meas_power_lz77_dict[] = {
+    0x01, 0x20, 0x8f, 0xf6, 0xc0, 0x00, 0x58, 0x0a, 0x22,
+    0x00, 0x66, 0x02, 0x04, 0x00, 0x2c, 0x90, 0x00};
+
+/** meas_power run length encoded by ents.compress.rle */
+static const uint8_t meas_power_rle[] = {
+    0x0e, 0x0a, 0x0a, 0x08, 0x04, 0x10, 0x07, 0x18, 0xf0, 0xab, 0xe3,
+    0xac, 0x05, 0x12, 0x12, 0x11, 0x82, 0x00, 0x03, 0xc0, 0xa2, 0x40,
+    0x19, 0x83, 0x00, 0x01, 0x59, 0x40};
+
+/** meas_power delta encoded by ents.compress.delta */
+static const uint8_t meas_power_delta[] = {
+    0x01, 0x00, 0x01, 0x0a, 0x01, 0x0b, 0x02, 0x0c, 0x14, 0x17, 0x1f,
+    0xe8, 0x5b, 0x48, 0x4f, 0xa9, 0x17, 0x01, 0x02, 0x03, 0x11, 0x04,
+    0x05, 0xc0, 0x62, 0xe2, 0x59, 0x19, 0x05, 0x02, 0x59, 0x19};
+
+/** meas_power compressed by ents.compress.codec.compress_payload */
+static const uint8_t meas_power_codec[] = {
+    0x04, 0x01, 0x20, 0x8f, 0xf6, 0xc0, 0x00, 0x58, 0x0a, 0x22, 0x00,
+    0x66, 0x02, 0x04, 0x00, 0x2c, 0x90, 0x00};
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { DictInit(&dict); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void test_Dict_Empty(void) {
+  TEST_ASSERT_EQUAL(0, dict.count);
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictFind(&dict, DICT_ROOT, 'a'));
+}
+
+void test_Dict_AddFind(void) {
+  int a = DictAdd(&dict, DICT_ROOT, 'a');
+  int ab = DictAdd(&dict, a, 'b');
+
+  TEST_ASSERT_EQUAL(1, a);
+  TEST_ASSERT_EQUAL(2, ab);
+  TEST_ASSERT_EQUAL(a, DictFind(&dict, DICT_ROOT, 'a'));
+  TEST_ASSERT_EQUAL(ab, DictFind(&dict, a, 'b'));
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictFind(&dict, DICT_ROOT, 'b'));
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictFind(&dict, ab, 'a'));
+}
+
+void test_Dict_BinarySafe(void) {
+  int zero = DictAdd(&dict, DICT_ROOT, 0x00);
+  int zero_zero = DictAdd(&dict, zero, 0x00);
+
+  TEST_ASSERT_EQUAL(zero, DictFind(&dict, DICT_ROOT, 0x00));
+  TEST_ASSERT_EQUAL(zero_zero, DictFind(&dict, zero, 0x00));
+
+  uint8_t phrase[4] = {0xff, 0xff, 0xff, 0xff};
+  TEST_ASSERT_EQUAL(2, DictPhrase(&dict, zero_zero, phrase, sizeof(phrase)));
+  TEST_ASSERT_EQUAL_HEX8(0x00, phrase[0]);
+  TEST_ASSERT_EQUAL_HEX8(0x00, phrase[1]);
+}
+
+void test_Dict_Phrase(void) {
+  const uint8_t expected[] = {'a', 'b', 'c'};
+  uint16_t code = DICT_ROOT;
+  for (int i = 0; i < sizeof(expected); i++) {
+    code = DictAdd(&dict, code, expected[i]);
+  }
+
+  uint8_t phrase[sizeof(expected)];
+  TEST_ASSERT_EQUAL(sizeof(expected), DictPhraseLen(&dict, code));
+  TEST_ASSERT_EQUAL(sizeof(expected),
+                    DictPhrase(&dict, code, phrase, sizeof(phrase)));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, phrase, sizeof(expected));
+
+  // buffer too small
+  TEST_ASSERT_EQUAL(0, DictPhrase(&dict, code, phrase, 2));
+}
+
+void test_Dict_Full(void) {
+  for (int i = 0; i < DICT_MAX_ENTRIES; i++) {
+    TEST_ASSERT_EQUAL(i + 1, DictAdd(&dict, i, (uint8_t)i));
+  }
+
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictAdd(&dict, DICT_ROOT, 'z'));
+  TEST_ASSERT_EQUAL(DICT_MAX_ENTRIES, dict.count);
+
+  // entries are still reachable after filling the table
+  for (int i = 0; i < DICT_MAX_ENTRIES; i++) {
+    TEST_ASSERT_EQUAL(i + 1, DictFind(&dict, i, (uint8_t)i));
+  }
+}
+
+void test_Dict_Reset(void) {
+  DictAdd(&dict, DICT_ROOT, 'a');
+  DictInit(&dict);
+
+  TEST_ASSERT_EQUAL(0, dict.count);
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictFind(&dict, DICT_ROOT, 'a'));
+}
+
+void test_Dict_InvalidParent(void) {
+  TEST_ASSERT_EQUAL(DICT_NOT_FOUND, DictAdd(&dict, 5, 'a'));
+}
+
+void test_LZ78_RoundTrip(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = LZ78Encode(meas_power, sizeof(meas_power),
+                                     compressed, sizeof(compressed),
+                                     &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+
+  status = LZ78Decode(compressed, compressed_len, decompressed,
+                      sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_LZ78_Repetitive(void) {
+  uint8_t data[200];
+  for (int i = 0; i < sizeof(data); i++) {
+    data[i] = i % 4;
+  }
+
+  uint8_t compressed[sizeof(data)];
+  uint8_t decompressed[sizeof(data)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = LZ78Encode(data, sizeof(data), compressed,
+                                     sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_LESS_THAN(sizeof(data), compressed_len);
+
+  status = LZ78Decode(compressed, compressed_len, decompressed,
+                      sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(data), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decompressed, sizeof(data));
+}
+
+void test_LZ78_Empty(void) {
+  uint8_t compressed[4];
+  uint8_t decompressed[4];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status =
+      LZ78Encode(NULL, 0, compressed, sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(1, compressed_len);
+
+  status = LZ78Decode(compressed, compressed_len, decompressed,
+                      sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(0, decompressed_len);
+}
+
+void test_LZ78_Overflow(void) {
+  uint8_t compressed[4];
+  size_t compressed_len = 0;
+
+  CompressStatus status = LZ78Encode(meas_power, sizeof(meas_power),
+                                     compressed, sizeof(compressed),
+                                     &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OVERFLOW, status);
+}
+
+void test_LZ78_Corrupt(void) {
+  // claims 10 bytes but has no tokens
+  const uint8_t compressed[] = {0x0a};
+  uint8_t decompressed[16];
+  size_t decompressed_len = 0;
+
+  CompressStatus status = LZ78Decode(compressed, sizeof(compressed),
+                                     decompressed, sizeof(decompressed),
+                                     &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_CORRUPT, status);
+}
+
+void test_LZ77_RoundTrip(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status =
+      LZ77Encode(meas_power, sizeof(meas_power), NULL, compressed,
+                 sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+
+  status = LZ77Decode(compressed, compressed_len, NULL, decompressed,
+                      sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_LZ77_RoundTripDict(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status =
+      LZ77Encode(meas_power, sizeof(meas_power), &lz77_dict, compressed,
+                 sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+
+  status = LZ77Decode(compressed, compressed_len, &lz77_dict, decompressed,
+                      sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_LZ77_Parity(void) {
+  uint8_t compressed[64];
+  size_t compressed_len = 0;
+
+  CompressStatus status =
+      LZ77Encode(meas_power, sizeof(meas_power), NULL, compressed,
+                 sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power_lz77), compressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power_lz77, compressed, compressed_len);
+
+  status = LZ77Encode(meas_power, sizeof(meas_power), &lz77_dict, compressed,
+                      sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power_lz77_dict), compressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power_lz77_dict, compressed,
+                                compressed_len);
+}
+
+void test_LZ77_WrongDict(void) {
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t decompressed_len = 0;
+
+  CompressStatus status =
+      LZ77Decode(meas_power_lz77_dict, sizeof(meas_power_lz77_dict), NULL,
+                 decompressed, sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_CORRUPT, status);
+}
+
+void test_LZ77_Overflow(void) {
+  uint8_t compressed[8];
+  size_t compressed_len = 0;
+
+  CompressStatus status =
+      LZ77Encode(meas_power, sizeof(meas_power), NULL, compressed,
+                 sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OVERFLOW, status);
+}
+
+void test_RLE_RoundTrip(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = RLEEncode(meas_power, sizeof(meas_power), compressed,
+                                    sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power_rle), compressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power_rle, compressed, compressed_len);
+
+  status = RLEDecode(compressed, compressed_len, decompressed,
+                     sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_RLE_LongRun(void) {
+  uint8_t data[300] = {0};
+  uint8_t compressed[16];
+  uint8_t decompressed[sizeof(data)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = RLEEncode(data, sizeof(data), compressed,
+                                    sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  // 130 + 130 + 40
+  TEST_ASSERT_EQUAL(6, compressed_len);
+
+  status = RLEDecode(compressed, compressed_len, decompressed,
+                     sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(data), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decompressed, sizeof(data));
+}
+
+void test_RLE_Corrupt(void) {
+  // literal packet claims 4 bytes
+  const uint8_t compressed[] = {0x03, 0x01, 0x02};
+  uint8_t decompressed[16];
+  size_t decompressed_len = 0;
+
+  CompressStatus status = RLEDecode(compressed, sizeof(compressed),
+                                    decompressed, sizeof(decompressed),
+                                    &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_CORRUPT, status);
+}
+
+void test_Delta_RoundTrip(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = DeltaEncode(meas_power, sizeof(meas_power),
+                                      compressed, sizeof(compressed),
+                                      &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power_delta), compressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power_delta, compressed, compressed_len);
+
+  status = DeltaDecode(compressed, compressed_len, decompressed,
+                       sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_Delta_Records(void) {
+  // 10 records of 12 bytes where only the counter changes
+  uint8_t data[120];
+  for (int i = 0; i < sizeof(data); i++) {
+    data[i] = (i % 12 == 3) ? i / 12 : 0x40 + i % 12;
+  }
+
+  uint8_t compressed[sizeof(data)];
+  uint8_t decompressed[sizeof(data)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+
+  CompressStatus status = DeltaEncode(data, sizeof(data), compressed,
+                                      sizeof(compressed), &compressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(12, compressed[0]);
+  TEST_ASSERT_LESS_THAN(sizeof(data) / 2, compressed_len);
+
+  status = DeltaDecode(compressed, compressed_len, decompressed,
+                       sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(data), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, decompressed, sizeof(data));
+}
+
+void test_Delta_InvalidStride(void) {
+  const uint8_t compressed[] = {0x00, 0x01, 0x00};
+  uint8_t decompressed[16];
+  size_t decompressed_len = 0;
+
+  CompressStatus status = DeltaDecode(compressed, sizeof(compressed),
+                                      decompressed, sizeof(decompressed),
+                                      &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_CORRUPT, status);
+}
+
+void test_Codec_Select(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+  size_t compressed_len = 0;
+  size_t decompressed_len = 0;
+  CodecId selected = CODEC_NONE;
+
+  CompressStatus status = CodecCompress(
+      meas_power, sizeof(meas_power), CODEC_BUDGET_UNLIMITED, compressed,
+      sizeof(compressed), &compressed_len, &selected);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(CODEC_LZ77_DICT, selected);
+  TEST_ASSERT_EQUAL(sizeof(meas_power_codec), compressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power_codec, compressed, compressed_len);
+
+  status = CodecDecode(compressed, compressed_len, decompressed,
+                       sizeof(decompressed), &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed, sizeof(meas_power));
+}
+
+void test_Codec_Budget(void) {
+  uint8_t compressed[64];
+  size_t compressed_len = 0;
+  CodecId selected = CODEC_LZ77;
+
+  // only enough budget to copy the payload
+  CompressStatus status =
+      CodecCompress(meas_power, sizeof(meas_power),
+                    CodecCost(CODEC_NONE, sizeof(meas_power)), compressed,
+                    sizeof(compressed), &compressed_len, &selected);
+  TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+  TEST_ASSERT_EQUAL(CODEC_NONE, selected);
+  TEST_ASSERT_EQUAL(sizeof(meas_power) + CODEC_HEADER_SIZE, compressed_len);
+  TEST_ASSERT_EQUAL(CODEC_NONE, compressed[0]);
+}
+
+void test_Codec_EncodeEach(void) {
+  uint8_t compressed[64];
+  uint8_t decompressed[sizeof(meas_power)];
+
+  for (int id = 0; id < CODEC_COUNT; id++) {
+    size_t compressed_len = 0;
+    size_t decompressed_len = 0;
+
+    CompressStatus status =
+        CodecEncode(id, meas_power, sizeof(meas_power), compressed,
+                    sizeof(compressed), &compressed_len);
+    TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+    TEST_ASSERT_EQUAL(id, compressed[0]);
+
+    status = CodecDecode(compressed, compressed_len, decompressed,
+                         sizeof(decompressed), &decompressed_len);
+    TEST_ASSERT_EQUAL(COMPRESS_OK, status);
+    TEST_ASSERT_EQUAL(sizeof(meas_power), decompressed_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(meas_power, decompressed,
+                                  sizeof(meas_power));
+  }
+}
+
+void test_Codec_Unknown(void) {
+  const uint8_t compressed[] = {CODEC_COUNT, 0x00};
+  uint8_t decompressed[16];
+  size_t decompressed_len = 0;
+
+  CompressStatus status = CodecDecode(compressed, sizeof(compressed),
+                                      decompressed, sizeof(decompressed),
+                                      &decompressed_len);
+  TEST_ASSERT_EQUAL(COMPRESS_CORRUPT, status);
+}
+
+/**
+ * @brief Entry point for compression test
+ * @retval int
+ */
+int main(void) {
+  /* Reset of all peripherals, Initializes the Flash interface and the Systick.
+   */
+  HAL_Init();
+
+  /* Configure the system clock */
+  SystemClock_Config();
+
+  /* Initialize all configured peripherals */
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  // Unit testing
+  UNITY_BEGIN();
+
+  RUN_TEST(test_Dict_Empty);
+  RUN_TEST(test_Dict_AddFind);
+  RUN_TEST(test_Dict_BinarySafe);
+  RUN_TEST(test_Dict_Phrase);
+  RUN_TEST(test_Dict_Full);
+  RUN_TEST(test_Dict_Reset);
+  RUN_TEST(test_Dict_InvalidParent);
+  RUN_TEST(test_LZ78_RoundTrip);
+  RUN_TEST(test_LZ78_Repetitive);
+  RUN_TEST(test_LZ78_Empty);
+  RUN_TEST(test_LZ78_Overflow);
+  RUN_TEST(test_LZ78_Corrupt);
+  RUN_TEST(test_LZ77_RoundTrip);
+  RUN_TEST(test_LZ77_RoundTripDict);
+  RUN_TEST(test_LZ77_Parity);
+  RUN_TEST(test_LZ77_WrongDict);
+  RUN_TEST(test_LZ77_Overflow);
+  RUN_TEST(test_RLE_RoundTrip);
+  RUN_TEST(test_RLE_LongRun);
+  RUN_TEST(test_RLE_Corrupt);
+  RUN_TEST(test_Delta_RoundTrip);
+  RUN_TEST(test_Delta_Records);
+  RUN_TEST(test_Delta_InvalidStride);
+  RUN_TEST(test_Codec_Select);
+  RUN_TEST(test_Codec_Budget);
+  RUN_TEST(test_Codec_EncodeEach);
+  RUN_TEST(test_Codec_Unknown);
+
+  UNITY_END();
+}
@@ -0,0 +1,285 @@
+/**
+ * @file test_deadband.c
+ * @brief Tests send-on-delta filtering of sensor measurements
+ *
+ * FIFO and airtime savings with longer recordings are replayed on the host by
+ * extras/deadband/deadband_replay.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "board.h"
+#include "deadband.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+
+/** Deadband under test */
+static Deadband db;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { DeadbandInit(&db); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+/**
+ * @brief Build a decimal measurement
+ */
+static SensorMeasurement Decimal(SensorType type, uint32_t ts, double x) {
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.has_meta = true;
+  meas.meta.cell_id = 1;
+  meas.meta.logger_id = 2;
+  meas.meta.ts = ts;
+  meas.type = type;
+  meas.which_value = SensorMeasurement_decimal_tag;
+  meas.value.decimal = x;
+  return meas;
+}
+
+/**
+ * @brief Check a measurement and record it when stored, like
+ * SensorsAddMeasurement
+ */
+static bool Add(uint8_t sensor, const DeadbandLimits *limits,
+                const SensorMeasurement *meas) {
+  int entry = -1;
+  const bool store = DeadbandCheck(&db, sensor, limits, meas, &entry);
+  if (store) {
+    DeadbandUpdate(&db, entry, sensor, meas);
+  }
+  return store;
+}
+
+void TestDisabled(void) {
+  const DeadbandLimits limits = {0, 0, 0};
+  TEST_ASSERT_FALSE(DeadbandEnabled(&limits));
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  int entry = 0;
+  TEST_ASSERT_TRUE(DeadbandCheck(&db, 0, &limits, &meas, &entry));
+  TEST_ASSERT_EQUAL(-1, entry);
+  TEST_ASSERT_TRUE(DeadbandCheck(&db, 0, &limits, &meas, &entry));
+}
+
+void TestFirstSampleStored(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+}
+
+void TestAbsolute(void) {
+  const DeadbandLimits limits = {0.5f, 0, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  // within the deadband of the stored 20.0, not of the previous sample
+  meas = Decimal(SensorType_TEROS12_TEMP, 60, 20.4);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 120, 19.6);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 180, 20.5);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+
+  meas = Decimal(SensorType_TEROS12_TEMP, 240, 20.6);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  // reference moved to 20.6
+  meas = Decimal(SensorType_TEROS12_TEMP, 300, 20.2);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 360, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+}
+
+void TestRelative(void) {
+  const DeadbandLimits limits = {0, 0.1f, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_POWER_VOLTAGE, 0, -200.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_POWER_VOLTAGE, 1, -219.0);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_POWER_VOLTAGE, 2, -179.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+}
+
+void TestEitherThreshold(void) {
+  // relative is tighter for small values, absolute for large ones
+  const DeadbandLimits limits = {5.0f, 0.01f, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_POWER_CURRENT, 0, 100.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_POWER_CURRENT, 1, 101.5);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  meas = Decimal(SensorType_POWER_CURRENT, 2, 10000.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_POWER_CURRENT, 3, 10006.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_POWER_CURRENT, 4, 10010.0);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+}
+
+void TestSendOnChange(void) {
+  // no thresholds with a heartbeat stores any change
+  const DeadbandLimits limits = {0, 0, 3600};
+
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.type = SensorType_PHYTOS31_LEAF_WETNESS;
+  meas.which_value = SensorMeasurement_unsigned_int_tag;
+  meas.value.unsigned_int = 3;
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+
+  meas.value.unsigned_int = 4;
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+}
+
+void TestHeartbeat(void) {
+  const DeadbandLimits limits = {1.0f, 0, 900};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 1000, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 1899, 20.0);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 1900, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  // heartbeat restarts from the stored sample
+  meas = Decimal(SensorType_TEROS12_TEMP, 2000, 20.0);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+}
+
+void TestClockBackwards(void) {
+  const DeadbandLimits limits = {1.0f, 0, 900};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 1000, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  meas = Decimal(SensorType_TEROS12_TEMP, 10, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+}
+
+void TestNotStoredKeepsReference(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  // sample out of the deadband that failed to store, e.g. on a full buffer
+  meas = Decimal(SensorType_TEROS12_TEMP, 60, 25.0);
+  int entry = -1;
+  TEST_ASSERT_TRUE(DeadbandCheck(&db, 0, &limits, &meas, &entry));
+
+  // the next one is still compared against 20.0
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+}
+
+void TestSeparateStreams(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  SensorMeasurement temp = Decimal(SensorType_BME280_TEMP, 0, 20.0);
+  SensorMeasurement hum = Decimal(SensorType_BME280_HUMIDITY, 0, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &temp));
+  TEST_ASSERT_TRUE(Add(0, &limits, &hum));
+  TEST_ASSERT_TRUE(Add(1, &limits, &temp));
+
+  TEST_ASSERT_FALSE(Add(0, &limits, &temp));
+  TEST_ASSERT_FALSE(Add(0, &limits, &hum));
+  TEST_ASSERT_FALSE(Add(1, &limits, &temp));
+}
+
+void TestNewCell(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+
+  // sensor moved to another cell after a configuration change
+  meas.meta.cell_id = 5;
+  TEST_ASSERT_TRUE(Add(0, &limits, &meas));
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+}
+
+void TestNonNumeric(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  SensorMeasurement meas = SensorMeasurement_init_zero;
+  meas.type = SensorType_TEROS12_TEMP;
+  meas.which_value = SensorMeasurement_summary_tag;
+  int entry = 0;
+  TEST_ASSERT_TRUE(DeadbandCheck(&db, 0, &limits, &meas, &entry));
+  TEST_ASSERT_EQUAL(-1, entry);
+}
+
+void TestFull(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  for (int i = 0; i < DEADBAND_MAX_STREAMS; i++) {
+    SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+    TEST_ASSERT_TRUE(Add(i, &limits, &meas));
+  }
+
+  // untracked pairs are always stored
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  int entry = 0;
+  TEST_ASSERT_TRUE(
+      DeadbandCheck(&db, DEADBAND_MAX_STREAMS, &limits, &meas, &entry));
+  TEST_ASSERT_EQUAL(-1, entry);
+  TEST_ASSERT_FALSE(Add(0, &limits, &meas));
+}
+
+void TestRestore(void) {
+  const DeadbandLimits limits = {1.0f, 0, 0};
+
+  SensorMeasurement meas = Decimal(SensorType_TEROS12_TEMP, 0, 20.0);
+  TEST_ASSERT_TRUE(Add(3, &limits, &meas));
+
+  // entries are copied byte for byte to and from FRAM
+  uint8_t mirror[sizeof(db.entries)];
+  memcpy(mirror, db.entries, sizeof(mirror));
+  DeadbandInit(&db);
+  memcpy(db.entries, mirror, sizeof(mirror));
+
+  meas = Decimal(SensorType_TEROS12_TEMP, 60, 20.5);
+  TEST_ASSERT_FALSE(Add(3, &limits, &meas));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestDisabled);
+  RUN_TEST(TestFirstSampleStored);
+  RUN_TEST(TestAbsolute);
+  RUN_TEST(TestRelative);
+  RUN_TEST(TestEitherThreshold);
+  RUN_TEST(TestSendOnChange);
+  RUN_TEST(TestHeartbeat);
+  RUN_TEST(TestClockBackwards);
+  RUN_TEST(TestNotStoredKeepsReference);
+  RUN_TEST(TestSeparateStreams);
+  RUN_TEST(TestNewCell);
+  RUN_TEST(TestNonNumeric);
+  RUN_TEST(TestFull);
+  RUN_TEST(TestRestore);
+
+  UNITY_END();
+}
@@ -0,0 +1,216 @@
+/**
+ * @file test_energy.c
+ * @brief Tests the energy accounts and their blob
+ *
+ * The accounts run on a fake clock that the tests advance by hand.
+ *
+ * @date 2026-10-19
+ */
+
+#include <unity.h>
+
+#include "board.h"
+#include "energy.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+
+/** Ticks per second of the fake clock */
+#define RATE 1000
+
+/** Time of the fake clock */
+static uint32_t now = 0;
+
+/** Fake clock */
+static uint32_t Clock(void) { return now; }
+
+/** Read a little endian integer from the blob */
+static uint64_t Get(const uint8_t *data, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= (uint64_t)data[i] << (8 * i);
+  }
+  return value;
+}
+
+/** Task that waits in the middle */
+static void Task(void) {
+  ENERGY_SCOPE(3);
+  now += 10;
+  {
+    ENERGY_SCOPE(ENERGY_WAIT);
+    now += 100;
+  }
+  now += 5;
+}
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {
+  now = 0;
+  EnergyInit(Clock, RATE);
+}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestEnterReturn(void) {
+  now = 20;
+  const int prev = EnergyEnter(ENERGY_SLEEP);
+  TEST_ASSERT_EQUAL(ENERGY_RUN, prev);
+  now = 70;
+  EnergyReturn(prev);
+  now = 75;
+
+  TEST_ASSERT_EQUAL_UINT32(1, EnergyGet(ENERGY_SLEEP)->count);
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_SLEEP)->ticks == 50);
+  // returning is not an entry
+  TEST_ASSERT_EQUAL_UINT32(0, EnergyGet(ENERGY_RUN)->count);
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_RUN)->ticks == 25);
+}
+
+void TestScope(void) {
+  Task();
+  Task();
+
+  TEST_ASSERT_EQUAL_UINT32(2, EnergyGet(3)->count);
+  TEST_ASSERT_TRUE(EnergyGet(3)->ticks == 30);
+  TEST_ASSERT_EQUAL_UINT32(2, EnergyGet(ENERGY_WAIT)->count);
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_WAIT)->ticks == 200);
+
+  // the task keeps its waits
+  TEST_ASSERT_TRUE(EnergyGet(3)->wait == 200);
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_RUN)->wait == 0);
+
+  // back in the account before the task
+  now += 7;
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_RUN)->ticks == 7);
+}
+
+void TestWrap(void) {
+  now = UINT32_MAX - 4;
+  EnergyInit(Clock, RATE);
+  EnergyEnter(ENERGY_STOP);
+  now += 10;
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_STOP)->ticks == 10);
+}
+
+void TestInvalid(void) {
+  TEST_ASSERT_NULL(EnergyGet(ENERGY_ACCOUNTS));
+  TEST_ASSERT_NULL(EnergyGet(-1));
+  TEST_ASSERT_NULL(EnergyGetRadio(ENERGY_RADIO_STATES));
+
+  // ignored, still charging ENERGY_RUN
+  TEST_ASSERT_EQUAL(ENERGY_RUN, EnergyEnter(ENERGY_ACCOUNTS));
+  EnergyReturn(-1);
+  now = 5;
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_RUN)->ticks == 5);
+}
+
+void TestRadio(void) {
+  now = 10;
+  EnergyRadio(ENERGY_RADIO_TX);
+  EnergyEnter(ENERGY_SLEEP);
+  now = 60;
+  EnergyRadio(ENERGY_RADIO_RX);
+  // same state is not an entry
+  EnergyRadio(ENERGY_RADIO_RX);
+  now = 80;
+  EnergyRadio(ENERGY_RADIO_OFF);
+
+  TEST_ASSERT_EQUAL_UINT32(1, EnergyGetRadio(ENERGY_RADIO_TX)->count);
+  TEST_ASSERT_TRUE(EnergyGetRadio(ENERGY_RADIO_TX)->ticks == 50);
+  TEST_ASSERT_EQUAL_UINT32(1, EnergyGetRadio(ENERGY_RADIO_RX)->count);
+  TEST_ASSERT_TRUE(EnergyGetRadio(ENERGY_RADIO_RX)->ticks == 20);
+  TEST_ASSERT_TRUE(EnergyGetRadio(ENERGY_RADIO_OFF)->ticks == 10);
+
+  // independent of the mcu state
+  TEST_ASSERT_TRUE(EnergyGet(ENERGY_SLEEP)->ticks == 70);
+}
+
+void TestMicrojoules(void) {
+  const EnergyCurrents currents = {
+      .run_ua = 10000,
+      .sleep_ua = 1000,
+      .stop_ua = 2,
+      .radio_rx_ua = 5000,
+      .radio_tx_ua = 100000,
+      .voltage_mv = 3000,
+  };
+
+  // 2 s at 10 mA and 3 V
+  Task();
+  now = 2 * RATE;
+  TEST_ASSERT_TRUE(EnergyMicrojoules(ENERGY_RUN, &currents) +
+                       EnergyMicrojoules(3, &currents) +
+                       EnergyMicrojoules(ENERGY_WAIT, &currents) ==
+                   60000);
+  // 115 ticks including the wait
+  TEST_ASSERT_TRUE(EnergyTaskMicrojoules(3, &currents) == 3450);
+
+  // 1 day in stop2
+  EnergyEnter(ENERGY_STOP);
+  now += 86400u * RATE;
+  TEST_ASSERT_TRUE(EnergyMicrojoules(ENERGY_STOP, &currents) == 518400);
+
+  EnergyRadio(ENERGY_RADIO_TX);
+  now += RATE / 10;
+  TEST_ASSERT_TRUE(EnergyRadioMicrojoules(ENERGY_RADIO_TX, &currents) ==
+                   30000);
+  TEST_ASSERT_TRUE(EnergyRadioMicrojoules(ENERGY_RADIO_OFF, &currents) == 0);
+}
+
+void TestSerialize(void) {
+  Task();
+  EnergyRadio(ENERGY_RADIO_RX);
+  now += 8;
+
+  uint8_t blob[ENERGY_BLOB_SIZE];
+  TEST_ASSERT_EQUAL(ENERGY_BLOB_SIZE, EnergySerialize(blob, sizeof(blob)));
+  TEST_ASSERT_EQUAL(ENERGY_VERSION, blob[0]);
+  TEST_ASSERT_EQUAL(ENERGY_ACCOUNTS, blob[1]);
+  TEST_ASSERT_EQUAL(ENERGY_RADIO_STATES, blob[2]);
+  TEST_ASSERT_EQUAL_UINT32(RATE, Get(&blob[3], 4));
+
+  const uint8_t *task = &blob[ENERGY_HEADER_SIZE + 3 * ENERGY_ACCOUNT_SIZE];
+  TEST_ASSERT_EQUAL_UINT32(1, Get(task, 4));
+  TEST_ASSERT_TRUE(Get(task + 4, 8) == 15);
+  TEST_ASSERT_TRUE(Get(task + 12, 8) == 100);
+
+  const uint8_t *wait =
+      &blob[ENERGY_HEADER_SIZE + ENERGY_WAIT * ENERGY_ACCOUNT_SIZE];
+  TEST_ASSERT_TRUE(Get(wait + 4, 8) == 100);
+
+  const uint8_t *rx = &blob[ENERGY_HEADER_SIZE +
+                            ENERGY_ACCOUNTS * ENERGY_ACCOUNT_SIZE +
+                            ENERGY_RADIO_RX * ENERGY_RADIO_SIZE];
+  TEST_ASSERT_EQUAL_UINT32(1, Get(rx, 4));
+  TEST_ASSERT_TRUE(Get(rx + 4, 8) == 8);
+
+  TEST_ASSERT_EQUAL(0, EnergySerialize(blob, ENERGY_BLOB_SIZE - 1));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestEnterReturn);
+  RUN_TEST(TestScope);
+  RUN_TEST(TestWrap);
+  RUN_TEST(TestInvalid);
+  RUN_TEST(TestRadio);
+  RUN_TEST(TestMicrojoules);
+  RUN_TEST(TestSerialize);
+
+  UNITY_END();
+}
@@ -239,9 +239,9 @@ void test_FramBuffer_Wraparound(void) {
   uint8_t buffer_length;
 
   // move write to before the end of physical memory in FRAM
-  // if the assigned FRAM memory is [0, 1769], then a block_size of 16 (+1
-  // length byte) means that the 104th block starts at 1768 and must wrap
-  // around. read 0, write 1768
+  // if the assigned FRAM memory is [0, 1399], then a block_size of 16 (+1
+  // length byte) means that the 82nd block starts at 1394 and must wrap
+  // around. read 0, write 1394
   status = FRAM_OK;
   while (status != FRAM_BUFFER_FULL) {
     TEST_ASSERT_EQUAL(FRAM_OK, status);
@@ -249,20 +249,20 @@ void test_FramBuffer_Wraparound(void) {
   }
 
   // advance read all the way to the end to make room for the wraparound
-  // read 1768, write 1768
+  // read 1394, write 1394
   while (FramBufferLen() != 0) {
     status = FramGet(buffer, &buffer_length);
     TEST_ASSERT_EQUAL(FRAM_OK, status);
   }
 
   // write one block for the wraparound
-  // read 1768, write 1768 + 17 = 14
-  // [{68} 69 70 0 1 2 3 4 5 6 7 8 9 10 11 12 13] 14
+  // read 1394, write 1394 + 17 = 11
+  // [{94} 95 96 97 98 99 0 1 2 3 4 5 6 7 8 9 10] 11
   status = FramPut(junk_data, block_size);
   TEST_ASSERT_EQUAL(FRAM_OK, status);
 
   // observe the wraparound
-  // read 14, write 14
+  // read 11, write 11
   status = FramGet(buffer, &buffer_length);
   TEST_ASSERT_EQUAL(FRAM_OK, status);
 
@@ -373,6 +373,430 @@ void test_FramDrop(void) {
   TEST_ASSERT_EQUAL(FRAM_BUFFER_EMPTY, status);
 }
 
+void test_FramBatch_Commit(void) {
+  FramBatch batch;
+  FramBatchInit(&batch);
+
+  uint8_t data[3][5] = {{1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11, 12}};
+  const size_t data_len[3] = {3, 4, 5};
+
+  for (int i = 0; i < 3; i++) {
+    FramStatus status = FramBatchAdd(&batch, data[i], data_len[i]);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+  }
+
+  // nothing is written before the commit
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+
+  FramStatus status = FramBatchCommit(&batch);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+  TEST_ASSERT_EQUAL(0, batch.count);
+  TEST_ASSERT_EQUAL(0, batch.len);
+
+  // batched measurements are read like single puts
+  uint8_t buffer[5];
+  uint8_t buffer_len;
+  for (int i = 0; i < 3; i++) {
+    status = FramGet(buffer, &buffer_len);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+    TEST_ASSERT_EQUAL(data_len[i], buffer_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data[i], buffer, data_len[i]);
+  }
+}
+
+void test_FramBatch_Empty(void) {
+  FramBatch batch;
+  FramBatchInit(&batch);
+
+  FramStatus status = FramBatchCommit(&batch);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+}
+
+void test_FramBatch_BufferFull(void) {
+  FramBatch batch;
+  FramBatchInit(&batch);
+
+  uint8_t data[100] = {0};
+
+  // fill the buffer leaving less than a single measurement
+  FramStatus status = FRAM_OK;
+  while (status == FRAM_OK) {
+    status = FramPut(data, sizeof(data));
+  }
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_FULL, status);
+
+  status = FramBatchAdd(&batch, data, sizeof(data));
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_FULL, status);
+  TEST_ASSERT_EQUAL(0, batch.count);
+}
+
+void test_FramBatch_StagingFull(void) {
+  FramBatch batch;
+  FramBatchInit(&batch);
+
+  uint8_t data[100] = {0};
+
+  // staging area fills up before the buffer
+  const int niters = FRAM_BATCH_SIZE / (sizeof(data) + 1);
+  for (int i = 0; i < niters; i++) {
+    FramStatus status = FramBatchAdd(&batch, data, sizeof(data));
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+  }
+
+  FramStatus status = FramBatchAdd(&batch, data, sizeof(data));
+  TEST_ASSERT_EQUAL(FRAM_OUT_OF_RANGE, status);
+  TEST_ASSERT_EQUAL(niters, batch.count);
+
+  status = FramBatchCommit(&batch);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(niters, FramBufferLen());
+}
+
+void test_FramBatch_Wraparound(void) {
+  FramBatch batch;
+  FramBatchInit(&batch);
+
+  uint8_t junk_data[50];
+  for (int i = 0; i < sizeof(junk_data); i++) {
+    junk_data[i] = i;
+  }
+
+  uint8_t buffer[sizeof(junk_data)];
+  uint8_t buffer_len;
+
+  // move the write address close to the end of the buffer
+  FramStatus status = FRAM_OK;
+  while (status == FRAM_OK) {
+    status = FramPut(junk_data, sizeof(junk_data) - 1);
+  }
+  while (FramBufferLen() != 0) {
+    status = FramGet(buffer, &buffer_len);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+  }
+
+  // batch wraps around the end of the buffer
+  for (int i = 0; i < 4; i++) {
+    junk_data[0] = i;
+    status = FramBatchAdd(&batch, junk_data, sizeof(junk_data));
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+  }
+  status = FramBatchCommit(&batch);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  for (int i = 0; i < 4; i++) {
+    junk_data[0] = i;
+    status = FramGet(buffer, &buffer_len);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+    TEST_ASSERT_EQUAL(sizeof(junk_data), buffer_len);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(junk_data, buffer, sizeof(junk_data));
+  }
+}
+
+/**
+ * @brief Puts measurements of a single byte counting up from 0
+ */
+static void PutCounting(int count) {
+  for (uint8_t i = 0; i < count; i++) {
+    FramStatus status = FramPut(&i, 1);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+  }
+}
+
+void test_FramPend_Commit(void) {
+  PutCounting(5);
+  const uint32_t seq = FramSeq();
+
+  FramStatus status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(2, FramPendingLen());
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+  TEST_ASSERT_EQUAL(seq, FramSeq());
+
+  // peeks start after the pending window
+  uint8_t data;
+  uint8_t len;
+  status = FramPeek(0, &data, &len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(2, data);
+  status = FramPeek(3, &data, &len);
+  TEST_ASSERT_EQUAL(FRAM_OUT_OF_RANGE, status);
+
+  status = FramCommit();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramPendingLen());
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+  TEST_ASSERT_EQUAL(seq + 2, FramSeq());
+
+  // the commit is saved
+  uint16_t read_addr, write_addr, buffer_len;
+  status = FramLoadBufferState(&read_addr, &write_addr, &buffer_len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_START + 4, read_addr);
+  TEST_ASSERT_EQUAL(3, buffer_len);
+
+  status = FramGet(&data, &len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(2, data);
+}
+
+void test_FramPend_Rollback(void) {
+  PutCounting(5);
+  const uint32_t seq = FramSeq();
+
+  FramStatus status = FramPend(3);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  FramRollback();
+  TEST_ASSERT_EQUAL(0, FramPendingLen());
+  TEST_ASSERT_EQUAL(5, FramBufferLen());
+  TEST_ASSERT_EQUAL(seq, FramSeq());
+
+  // the same measurements are uploaded again
+  uint8_t data;
+  uint8_t len;
+  status = FramPeek(0, &data, &len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, data);
+}
+
+void test_FramPend_OutOfRange(void) {
+  PutCounting(2);
+
+  FramStatus status = FramPend(3);
+  TEST_ASSERT_EQUAL(FRAM_OUT_OF_RANGE, status);
+
+  status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FramPend(1);
+  TEST_ASSERT_EQUAL(FRAM_OUT_OF_RANGE, status);
+
+  uint8_t data;
+  uint8_t len;
+  status = FramPeek(0, &data, &len);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_EMPTY, status);
+}
+
+void test_FramPend_BufferFull(void) {
+  uint8_t data[100] = {};
+  FramStatus status = FRAM_OK;
+  uint16_t count = 0;
+  while ((status = FramPut(data, sizeof(data))) == FRAM_OK) {
+    ++count;
+  }
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_FULL, status);
+
+  // pending measurements are not overwritten
+  status = FramPend(count);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+  status = FramPut(data, sizeof(data));
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_FULL, status);
+
+  status = FramCommit();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FramPut(data, sizeof(data));
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+}
+
+void test_FramPend_Drop(void) {
+  PutCounting(4);
+  const uint32_t seq = FramSeq();
+
+  FramStatus status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  // drops the oldest measurement, which is pending
+  status = FramDrop();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(1, FramPendingLen());
+  TEST_ASSERT_EQUAL(2, FramBufferLen());
+  TEST_ASSERT_EQUAL(seq + 1, FramSeq());
+
+  FramRollback();
+  uint8_t data;
+  uint8_t len;
+  status = FramPeek(0, &data, &len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(1, data);
+}
+
+void test_FramSeq_Reset(void) {
+  PutCounting(4);
+  const uint32_t seq = FramSeq();
+  TEST_ASSERT_NOT_EQUAL(0, seq);
+
+  FramStatus status = FramPend(1);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FramCommit();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  // a reset keeps the numbers and rolls back the pending window
+  status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FIFO_Init();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(seq + 1, FramSeq());
+  TEST_ASSERT_EQUAL(0, FramPendingLen());
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+
+  // cleared measurements are never numbered again
+  status = FramBufferClear();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(seq + 4, FramSeq());
+}
+
+void test_FIFO_Init_InvalidState(void) {
+  PutCounting(2);
+  const uint32_t seq = FramSeq();
+
+  // addresses past the end of the buffer, as saved by a larger buffer
+  FramStatus status = FramSaveBufferState(FRAM_BUFFER_END + 1, 0, 2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FIFO_Init();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+  // the numbers of the dropped measurements are not reused
+  TEST_ASSERT_EQUAL(seq + 2, FramSeq());
+
+  uint16_t read_addr, write_addr, buffer_len;
+  status = FramLoadBufferState(&read_addr, &write_addr, &buffer_len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_START, read_addr);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_START, write_addr);
+  TEST_ASSERT_EQUAL(0, buffer_len);
+
+  // more measurements than bytes between the addresses
+  status = FramSaveBufferState(FRAM_BUFFER_START, FRAM_BUFFER_START + 4, 5);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  FIFO_Init();
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+
+  // bytes between the addresses of an empty buffer
+  status = FramSaveBufferState(FRAM_BUFFER_START, FRAM_BUFFER_START + 4, 0);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  FIFO_Init();
+  TEST_ASSERT_EQUAL(0, FramBufferLen());
+  status = FramLoadBufferState(&read_addr, &write_addr, &buffer_len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_START, write_addr);
+
+  // a valid state is kept
+  PutCounting(3);
+  FIFO_Init();
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+}
+
+void test_FramCommitExcept(void) {
+  PutCounting(5);
+  const uint32_t seq = FramSeq();
+
+  FramStatus status = FramPend(4);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  // failed measurements are queued again behind the newest one
+  const uint16_t failed[] = {3, 1};
+  status = FramCommitExcept(failed, 2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramPendingLen());
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+  TEST_ASSERT_EQUAL(seq + 4, FramSeq());
+
+  const uint8_t expected[] = {4, 1, 3};
+  for (int i = 0; i < 3; i++) {
+    uint8_t data;
+    uint8_t len;
+    status = FramPeek(i, &data, &len);
+    TEST_ASSERT_EQUAL(FRAM_OK, status);
+    TEST_ASSERT_EQUAL(1, len);
+    TEST_ASSERT_EQUAL(expected[i], data);
+  }
+
+  // the copies are saved with the buffer state
+  status = FIFO_Init();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(3, FramBufferLen());
+}
+
+void test_FramCommitExcept_None(void) {
+  PutCounting(3);
+
+  FramStatus status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FramCommitExcept(NULL, 0);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(0, FramPendingLen());
+  TEST_ASSERT_EQUAL(1, FramBufferLen());
+}
+
+void test_FramCommitExcept_OutOfRange(void) {
+  PutCounting(3);
+
+  FramStatus status = FramPend(2);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  const uint16_t failed[] = {0, 2};
+  status = FramCommitExcept(failed, 2);
+  TEST_ASSERT_EQUAL(FRAM_OUT_OF_RANGE, status);
+  TEST_ASSERT_EQUAL(2, FramPendingLen());
+  TEST_ASSERT_EQUAL(1, FramBufferLen());
+}
+
+void test_FramCommitExcept_BufferFull(void) {
+  uint8_t data[100] = {};
+  FramStatus status = FRAM_OK;
+  uint16_t count = 0;
+  while ((status = FramPut(data, sizeof(data))) == FRAM_OK) {
+    ++count;
+  }
+
+  status = FramPend(count);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  // no room for the copy, the window is left for a rollback
+  const uint16_t failed[] = {0};
+  status = FramCommitExcept(failed, 1);
+  TEST_ASSERT_EQUAL(FRAM_BUFFER_FULL, status);
+  TEST_ASSERT_EQUAL(count, FramPendingLen());
+
+  FramRollback();
+  TEST_ASSERT_EQUAL(count, FramBufferLen());
+}
+
+void test_FramCommitExcept_Wraparound(void) {
+  uint8_t data[100];
+  for (int i = 0; i < sizeof(data); i++) {
+    data[i] = i;
+  }
+
+  FramStatus status = FRAM_OK;
+  uint16_t count = 0;
+  while ((status = FramPut(data, sizeof(data))) == FRAM_OK) {
+    ++count;
+  }
+
+  // frees the start of the buffer
+  status = FramPend(3);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  status = FramCommit();
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+
+  // the copy wraps around the end of the buffer
+  status = FramPend(1);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  const uint16_t failed[] = {0};
+  status = FramCommitExcept(failed, 1);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(count - 3, FramBufferLen());
+
+  uint8_t copy[100] = {};
+  uint8_t len;
+  status = FramPeek(count - 4, copy, &len);
+  TEST_ASSERT_EQUAL(FRAM_OK, status);
+  TEST_ASSERT_EQUAL(sizeof(data), len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(data, copy, sizeof(data));
+}
+
 /**
  * @brief  The application entry point.
  * @retval int
@@ -420,6 +844,23 @@ int main(void) {
   RUN_TEST(test_LoadSaveBufferState);
   RUN_TEST(test_FramPeek);
   RUN_TEST(test_FramDrop);
+  RUN_TEST(test_FramBatch_Commit);
+  RUN_TEST(test_FramBatch_Empty);
+  RUN_TEST(test_FramBatch_BufferFull);
+  RUN_TEST(test_FramBatch_StagingFull);
+  RUN_TEST(test_FramBatch_Wraparound);
+  RUN_TEST(test_FramPend_Commit);
+  RUN_TEST(test_FramPend_Rollback);
+  RUN_TEST(test_FramPend_OutOfRange);
+  RUN_TEST(test_FramPend_BufferFull);
+  RUN_TEST(test_FramPend_Drop);
+  RUN_TEST(test_FramSeq_Reset);
+  RUN_TEST(test_FIFO_Init_InvalidState);
+  RUN_TEST(test_FramCommitExcept);
+  RUN_TEST(test_FramCommitExcept_None);
+  RUN_TEST(test_FramCommitExcept_OutOfRange);
+  RUN_TEST(test_FramCommitExcept_BufferFull);
+  RUN_TEST(test_FramCommitExcept_Wraparound);
   UNITY_END();
   /* USER CODE END 3 */
 }
@@ -0,0 +1,203 @@
+/**
+ * @file test_fixed.c
+ * @brief Tests fixed point arithmetic and calibrations
+ *
+ * Sweeps of the driver conversions against the double reference are run on
+ * the host by extras/fixed_point/fixed_accuracy.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "calibration.h"
+#include "fixed.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { CalibrationClear(); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestQ16(void) {
+  TEST_ASSERT_EQUAL_INT32(3 * Q16_ONE, Q16FromInt(3));
+  TEST_ASSERT_EQUAL_INT32(Q16_MAX, Q16FromInt(40000));
+  TEST_ASSERT_EQUAL_INT32(Q16_MIN, Q16FromInt(-40000));
+
+  TEST_ASSERT_EQUAL_INT32(Q16_CONST(3.75), Q16Mul(Q16_CONST(1.5),
+                                                  Q16_CONST(2.5)));
+  TEST_ASSERT_EQUAL_INT32(Q16_CONST(-3.75), Q16Mul(Q16_CONST(-1.5),
+                                                   Q16_CONST(2.5)));
+  TEST_ASSERT_EQUAL_INT32(Q16_MAX, Q16Mul(Q16_CONST(300), Q16_CONST(300)));
+
+  TEST_ASSERT_EQUAL_INT32(Q16_CONST(0.6), Q16Div(Q16_CONST(1.5),
+                                                 Q16_CONST(2.5)));
+  TEST_ASSERT_EQUAL_INT32(Q16_MAX, Q16Div(Q16_ONE, 0));
+  TEST_ASSERT_EQUAL_INT32(Q16_MIN, Q16Div(-Q16_ONE, 0));
+}
+
+void TestQ32Mul(void) {
+  TEST_ASSERT_TRUE(Q32_CONST(3.75) ==
+                   Q32Mul(Q32_CONST(1.5), Q32_CONST(2.5)));
+  TEST_ASSERT_TRUE(Q32_CONST(-3.75) ==
+                   Q32Mul(Q32_CONST(1.5), Q32_CONST(-2.5)));
+  TEST_ASSERT_TRUE(Q32_CONST(3.75) ==
+                   Q32Mul(Q32_CONST(-1.5), Q32_CONST(-2.5)));
+  // smallest fraction times an integer
+  TEST_ASSERT_TRUE(1000 == Q32Mul(1, Q32FromInt(1000)));
+  // saturates
+  TEST_ASSERT_TRUE(Q32_MAX == Q32Mul(Q32FromInt(1 << 20), Q32FromInt(1 << 20)));
+  TEST_ASSERT_TRUE(Q32_MIN ==
+                   Q32Mul(Q32FromInt(-(1 << 20)), Q32FromInt(1 << 20)));
+  TEST_ASSERT_TRUE(Q32_MAX == Q32Add(Q32_MAX, Q32_ONE));
+  TEST_ASSERT_TRUE(Q32_MIN == Q32Add(Q32_MIN, -Q32_ONE));
+}
+
+void TestQ32FromRatio(void) {
+  TEST_ASSERT_TRUE(Q32_CONST(1.0 / 3) == Q32FromRatio(1, 3));
+  TEST_ASSERT_TRUE(Q32_CONST(-2.0 / 3) == Q32FromRatio(-2, 3));
+  TEST_ASSERT_TRUE(Q32_CONST(-1.5) == Q32FromRatio(3, -2));
+  // sum of large samples, like an oversampled mean
+  TEST_ASSERT_TRUE(Q32_CONST(-8388607.25) ==
+                   Q32FromRatio(-8388607LL * 3 - 8388608, 4));
+  TEST_ASSERT_TRUE(Q32_MAX == Q32FromRatio(1LL << 40, 1));
+  TEST_ASSERT_TRUE(Q32_MAX == Q32FromRatio(1, 0));
+}
+
+void TestQ32Sqrt(void) {
+  TEST_ASSERT_TRUE(Q32FromInt(3) == Q32Sqrt(Q32FromInt(9)));
+  TEST_ASSERT_TRUE(Q32_CONST(0.5) == Q32Sqrt(Q32_CONST(0.25)));
+  TEST_ASSERT_TRUE(0 == Q32Sqrt(-Q32_ONE));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, sqrt(2), Q32ToDouble(Q32Sqrt(2 * Q32_ONE)));
+
+  TEST_ASSERT_TRUE(Q32FromInt(8388608) ==
+                   Q32SqrtRatio(8388608ULL * 8388608 * 3, 3));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-9, sqrt(12.5),
+                            Q32ToDouble(Q32SqrtRatio(50, 4)));
+  TEST_ASSERT_TRUE(0 == Q32SqrtRatio(0, 4));
+}
+
+void TestFloatConversion(void) {
+  TEST_ASSERT_TRUE(Q32_CONST(1846.16015625) == Q32FromFloat(1846.16015625f));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-7, -0.6956, Q32ToDouble(Q32FromFloat(-0.6956f)));
+  TEST_ASSERT_TRUE(0 == Q32FromFloat(1e-20f));
+  TEST_ASSERT_TRUE(Q32_MAX == Q32FromFloat(1e20f));
+  TEST_ASSERT_TRUE(Q32_MIN == Q32FromFloat(-INFINITY));
+  TEST_ASSERT_TRUE(0 == Q32FromFloat(NAN));
+
+  TEST_ASSERT_EQUAL_DOUBLE(0.0, Q32ToDouble(0));
+  TEST_ASSERT_EQUAL_DOUBLE(-2.5, Q32ToDouble(Q32_CONST(-2.5)));
+  TEST_ASSERT_EQUAL_DOUBLE(8388607.0, Q32ToDouble(Q32FromInt(8388607)));
+  TEST_ASSERT_EQUAL_DOUBLE(ldexp(1, -32), Q32ToDouble(1));
+  TEST_ASSERT_EQUAL_DOUBLE(-ldexp(1, 31), Q32ToDouble(Q32_MIN));
+  // rounds to the nearest double
+  TEST_ASSERT_EQUAL_DOUBLE((double)Q32_MAX / 4294967296.0,
+                           Q32ToDouble(Q32_MAX));
+
+  TEST_ASSERT_EQUAL_FLOAT(22.3f, Q32ToFloat(Q32FromFloat(22.3f)));
+  TEST_ASSERT_EQUAL_FLOAT(-0.5f, Q32ToFloat(Q32_CONST(-0.5)));
+}
+
+void TestRounding(void) {
+  TEST_ASSERT_EQUAL_INT32(3, Q32Round(Q32_CONST(2.5)));
+  TEST_ASSERT_EQUAL_INT32(-3, Q32Round(Q32_CONST(-2.5)));
+  TEST_ASSERT_EQUAL_INT32(2, Q32Round(Q32_CONST(2.49)));
+  TEST_ASSERT_EQUAL_INT32(Q16_CONST(1.5), Q16FromQ32(Q32_CONST(1.5)));
+  TEST_ASSERT_EQUAL_INT32(Q16_MAX, Q16FromQ32(Q32FromInt(1 << 20)));
+}
+
+void TestCalibrationDefaults(void) {
+  // identity for types without a calibration
+  const Calibration *cal = CalibrationGet(SensorType_POWER_CURRENT);
+  TEST_ASSERT_TRUE(Q32FromInt(-1234) ==
+                   CalibrationApply(cal, Q32FromInt(-1234)));
+
+  // voltage codes are reported in V, the slope is exact to 1e-7
+  cal = CalibrationGet(SensorType_POWER_VOLTAGE);
+  TEST_ASSERT_DOUBLE_WITHIN(1234.567 * 1e-7, 1234.567,
+                            Q32ToDouble(CalibrationApply(
+                                cal, Q32FromInt(1234567))));
+
+  cal = CalibrationGet(SensorType_TEROS12_VWC_ADJ);
+  TEST_ASSERT_DOUBLE_WITHIN(
+      1e-6, ((3.879e-4 * 1846.25) - 0.6956) * 100,
+      Q32ToDouble(CalibrationApply(cal, Q32FromFloat(1846.25f))));
+
+  cal = CalibrationGet(SensorType_WATERMARK200SS_SOIL_TENSION);
+  TEST_ASSERT_DOUBLE_WITHIN(
+      1e-6, 2000 * 3.3 / 4095 / 0.0117,
+      Q32ToDouble(CalibrationApply(cal, Q32FromInt(2000))));
+
+  cal = CalibrationGet(SensorType_WATERMARK200TS_SOIL_TEMPERATURE);
+  TEST_ASSERT_DOUBLE_WITHIN(
+      1e-6, ((50.68 * ((2000 * 3.3 / 4095) - 0.490) + 20) - 32) * 5.0 / 9.0,
+      Q32ToDouble(CalibrationApply(cal, Q32FromInt(2000))));
+}
+
+void TestCalibrationOverride(void) {
+  const Calibration cal = {Q32_CONST(2.0), Q32_CONST(-0.5)};
+  TEST_ASSERT_TRUE(CalibrationSet(SensorType_POWER_CURRENT, &cal));
+  TEST_ASSERT_TRUE(Q32_CONST(19.5) ==
+                   CalibrationApply(CalibrationGet(SensorType_POWER_CURRENT),
+                                    Q32FromInt(10)));
+
+  // overrides replace the defaults
+  TEST_ASSERT_TRUE(CalibrationSet(SensorType_POWER_VOLTAGE, &cal));
+  TEST_ASSERT_TRUE(Q32_CONST(19.5) ==
+                   CalibrationApply(CalibrationGet(SensorType_POWER_VOLTAGE),
+                                    Q32FromInt(10)));
+
+  // setting again updates in place
+  const Calibration cal2 = {Q32_ONE, Q32_ONE};
+  TEST_ASSERT_TRUE(CalibrationSet(SensorType_POWER_CURRENT, &cal2));
+  TEST_ASSERT_TRUE(Q32FromInt(11) ==
+                   CalibrationApply(CalibrationGet(SensorType_POWER_CURRENT),
+                                    Q32FromInt(10)));
+
+  CalibrationClear();
+  TEST_ASSERT_TRUE(Q32FromInt(10) ==
+                   CalibrationApply(CalibrationGet(SensorType_POWER_CURRENT),
+                                    Q32FromInt(10)));
+}
+
+void TestCalibrationFull(void) {
+  const Calibration cal = {Q32_ONE, 0};
+  for (int i = 0; i < CALIBRATION_MAX_OVERRIDES; i++) {
+    TEST_ASSERT_TRUE(CalibrationSet((SensorType)(100 + i), &cal));
+  }
+  TEST_ASSERT_FALSE(CalibrationSet(SensorType_POWER_CURRENT, &cal));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestQ16);
+  RUN_TEST(TestQ32Mul);
+  RUN_TEST(TestQ32FromRatio);
+  RUN_TEST(TestQ32Sqrt);
+  RUN_TEST(TestFloatConversion);
+  RUN_TEST(TestRounding);
+  RUN_TEST(TestCalibrationDefaults);
+  RUN_TEST(TestCalibrationOverride);
+  RUN_TEST(TestCalibrationFull);
+
+  UNITY_END();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_lowpower.c
+ * @brief Tests the low power waits
+ *
+ * @date 2026-10-19
+ */
+
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "lowpower.h"
+#include "main.h"
+#include "stm32_lpm.h"
+#include "stm32_timer.h"
+#include "usart.h"
+#include "utilities_def.h"
+
+/** Tolerance of a wait in ms, the RTC ticks at 1024 Hz */
+#define TOLERANCE_MS 3
+
+/** Set by the flag timer */
+static volatile bool flag = false;
+
+/** Timer setting the flag */
+static UTIL_TIMER_Object_t flag_timer;
+
+/** Callback of the flag timer */
+static void OnFlagTimer(void *context) { flag = true; }
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { flag = false; }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) { UTIL_TIMER_Stop(&flag_timer); }
+
+void TestDelay(void) {
+  const uint32_t start = UTIL_TIMER_GetCurrentTime();
+  LowPowerDelay(100);
+  const uint32_t elapsed = UTIL_TIMER_GetCurrentTime() - start;
+
+  TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, 100, elapsed);
+}
+
+void TestDelayZero(void) {
+  const uint32_t start = UTIL_TIMER_GetCurrentTime();
+  LowPowerDelay(0);
+  TEST_ASSERT_UINT32_WITHIN(1, 0, UTIL_TIMER_GetCurrentTime() - start);
+}
+
+void TestWaitForFlag(void) {
+  UTIL_TIMER_SetPeriod(&flag_timer, 20);
+  UTIL_TIMER_Start(&flag_timer);
+
+  const uint32_t start = UTIL_TIMER_GetCurrentTime();
+  TEST_ASSERT_TRUE(LowPowerWaitFor(&flag, 1000));
+  const uint32_t elapsed = UTIL_TIMER_GetCurrentTime() - start;
+
+  TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, 20, elapsed);
+}
+
+void TestWaitForTimeout(void) {
+  const uint32_t start = UTIL_TIMER_GetCurrentTime();
+  TEST_ASSERT_FALSE(LowPowerWaitFor(&flag, 50));
+  const uint32_t elapsed = UTIL_TIMER_GetCurrentTime() - start;
+
+  TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, 50, elapsed);
+}
+
+void TestWaitForSet(void) {
+  flag = true;
+  TEST_ASSERT_TRUE(LowPowerWaitFor(&flag, 1000));
+}
+
+void TestDisabledIrq(void) {
+  // falls back to HAL_Delay, the timer could not fire
+  __disable_irq();
+  const uint32_t start = UTIL_TIMER_GetCurrentTime();
+  LowPowerDelay(20);
+  const uint32_t elapsed = UTIL_TIMER_GetCurrentTime() - start;
+  __enable_irq();
+
+  TEST_ASSERT_UINT32_WITHIN(TOLERANCE_MS, 20, elapsed);
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+  UTIL_TIMER_Init();
+
+  // sleep like the firmware built with LOW_POWER_DISABLE, the board is not
+  // fully initialized for Board_DeInit in Stop2
+  UTIL_LPM_Init();
+  UTIL_LPM_SetStopMode((1 << CFG_LPM_APPLI_Id), UTIL_LPM_DISABLE);
+
+  // wait for UART
+  WaitForSerial();
+
+  LowPowerInit();
+  UTIL_TIMER_Create(&flag_timer, 20, UTIL_TIMER_ONESHOT, OnFlagTimer, NULL);
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestDelay);
+  RUN_TEST(TestDelayZero);
+  RUN_TEST(TestWaitForFlag);
+  RUN_TEST(TestWaitForTimeout);
+  RUN_TEST(TestWaitForSet);
+  RUN_TEST(TestDisabledIrq);
+
+  UNITY_END();
+}
@@ -0,0 +1,165 @@
+/**
+ * @file test_oversample.c
+ * @brief Tests the decimation filter and statistics of oversampled readings
+ *
+ * @date 2026-10-19
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "oversample.h"
+#include "usart.h"
+
+/** Filter under test */
+static Oversample os;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { OversampleInit(&os, 4); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestEmpty(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, os.stats.count);
+  TEST_ASSERT_EQUAL_DOUBLE(0, OversampleMean(&os.stats));
+  TEST_ASSERT_EQUAL_DOUBLE(0, OversampleRms(&os.stats));
+}
+
+void TestFactorZero(void) {
+  OversampleInit(&os, 0);
+
+  TEST_ASSERT_TRUE(OversamplePush(&os, 7));
+  TEST_ASSERT_EQUAL_UINT32(1, os.stats.count);
+  TEST_ASSERT_EQUAL_INT32(7, os.stats.min);
+}
+
+void TestDecimation(void) {
+  TEST_ASSERT_FALSE(OversamplePush(&os, 10));
+  TEST_ASSERT_FALSE(OversamplePush(&os, 20));
+  TEST_ASSERT_FALSE(OversamplePush(&os, 30));
+  TEST_ASSERT_EQUAL_UINT32(0, os.stats.count);
+
+  TEST_ASSERT_TRUE(OversamplePush(&os, 40));
+  TEST_ASSERT_EQUAL_UINT32(1, os.stats.count);
+  TEST_ASSERT_EQUAL_INT64(25, os.stats.sum);
+}
+
+void TestRounding(void) {
+  // 2.5 rounds away from zero
+  OversamplePush(&os, 1);
+  OversamplePush(&os, 2);
+  OversamplePush(&os, 3);
+  OversamplePush(&os, 4);
+  TEST_ASSERT_EQUAL_INT32(3, os.stats.max);
+
+  // -2.5 as well, truncation would give -2
+  OversampleInit(&os, 4);
+  OversamplePush(&os, -1);
+  OversamplePush(&os, -2);
+  OversamplePush(&os, -3);
+  OversamplePush(&os, -4);
+  TEST_ASSERT_EQUAL_INT32(-3, os.stats.min);
+
+  // -2.25 rounds to -2
+  OversampleInit(&os, 4);
+  OversamplePush(&os, -1);
+  OversamplePush(&os, -2);
+  OversamplePush(&os, -3);
+  OversamplePush(&os, -3);
+  TEST_ASSERT_EQUAL_INT32(-2, os.stats.min);
+}
+
+void TestStats(void) {
+  OversampleInit(&os, 1);
+
+  const int32_t samples[] = {3, -4, 5, 0};
+  for (int i = 0; i < 4; i++) {
+    OversamplePush(&os, samples[i]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(4, os.stats.count);
+  TEST_ASSERT_EQUAL_INT32(-4, os.stats.min);
+  TEST_ASSERT_EQUAL_INT32(5, os.stats.max);
+  TEST_ASSERT_EQUAL_DOUBLE(1.0, OversampleMean(&os.stats));
+  // sqrt((9 + 16 + 25 + 0) / 4)
+  TEST_ASSERT_EQUAL_DOUBLE(sqrt(12.5), OversampleRms(&os.stats));
+}
+
+void TestMinMaxAfterDecimation(void) {
+  // a single spike is averaged out of the extremes
+  const int32_t samples[] = {100, 100, 100, 500, 100, 100, 100, 100};
+  for (int i = 0; i < 8; i++) {
+    OversamplePush(&os, samples[i]);
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(2, os.stats.count);
+  TEST_ASSERT_EQUAL_INT32(100, os.stats.min);
+  TEST_ASSERT_EQUAL_INT32(200, os.stats.max);
+  TEST_ASSERT_EQUAL_DOUBLE(150.0, OversampleMean(&os.stats));
+}
+
+void TestLeftoverDiscarded(void) {
+  for (int i = 0; i < 6; i++) {
+    OversamplePush(&os, 1000);
+  }
+
+  // the last two conversions do not fill a decimated sample
+  TEST_ASSERT_EQUAL_UINT32(1, os.stats.count);
+  TEST_ASSERT_EQUAL_UINT16(2, os.pending);
+  TEST_ASSERT_EQUAL_DOUBLE(1000.0, OversampleMean(&os.stats));
+}
+
+void TestFullScale(void) {
+  // sums of full scale 24-bit codes must not overflow
+  for (int i = 0; i < 4 * 1000; i++) {
+    OversamplePush(&os, (i % 2 == 0) ? 8388607 : -8388608);
+  }
+
+  // -0.5 rounds away from zero
+  TEST_ASSERT_EQUAL_UINT32(1000, os.stats.count);
+  TEST_ASSERT_EQUAL_INT32(-1, os.stats.min);
+  TEST_ASSERT_EQUAL_INT32(-1, os.stats.max);
+
+  OversampleInit(&os, 1);
+  for (int i = 0; i < 1000; i++) {
+    OversamplePush(&os, -8388608);
+  }
+  TEST_ASSERT_EQUAL_DOUBLE(-8388608.0, OversampleMean(&os.stats));
+  TEST_ASSERT_EQUAL_DOUBLE(8388608.0, OversampleRms(&os.stats));
+}
+
+/**
+ * @brief Entry point for oversample test
+ * @retval int
+ */
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestEmpty);
+  RUN_TEST(TestFactorZero);
+  RUN_TEST(TestDecimation);
+  RUN_TEST(TestRounding);
+  RUN_TEST(TestStats);
+  RUN_TEST(TestMinMaxAfterDecimation);
+  RUN_TEST(TestLeftoverDiscarded);
+  RUN_TEST(TestFullScale);
+
+  UNITY_END();
+}
@@ -0,0 +1,218 @@
+/**
+ * @file test_parse.c
+ * @brief Tests the sensor response parsers
+ *
+ * The sensor formats are fuzzed against sscanf on the host by
+ * extras/sscanf_free/parse_fuzz.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "parse.h"
+#include "usart.h"
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestChar(void) {
+  const char *str = "0+";
+  char c = 0;
+
+  TEST_ASSERT_TRUE(ParseChar(&str, &c));
+  TEST_ASSERT_EQUAL_CHAR('0', c);
+  TEST_ASSERT_TRUE(ParseChar(&str, &c));
+  TEST_ASSERT_EQUAL_CHAR('+', c);
+  TEST_ASSERT_FALSE(ParseChar(&str, &c));
+  TEST_ASSERT_EQUAL_CHAR('+', c);
+}
+
+void TestLiteral(void) {
+  const char *str = "m/s,  Dir";
+
+  TEST_ASSERT_FALSE(ParseLiteral(&str, "m/h"));
+  TEST_ASSERT_EQUAL_STRING("m/s,  Dir", str);
+
+  // whitespace matches any amount
+  TEST_ASSERT_TRUE(ParseLiteral(&str, "m/s, "));
+  TEST_ASSERT_EQUAL_STRING("Dir", str);
+  TEST_ASSERT_TRUE(ParseLiteral(&str, " Dir"));
+  TEST_ASSERT_EQUAL_STRING("", str);
+}
+
+void TestUint(void) {
+  const char *str = "00131";
+  uint32_t value = 0;
+
+  TEST_ASSERT_TRUE(ParseUint(&str, 1, &value));
+  TEST_ASSERT_EQUAL_UINT32(0, value);
+  TEST_ASSERT_TRUE(ParseUint(&str, 3, &value));
+  TEST_ASSERT_EQUAL_UINT32(13, value);
+  TEST_ASSERT_TRUE(ParseUint(&str, 3, &value));
+  TEST_ASSERT_EQUAL_UINT32(1, value);
+  TEST_ASSERT_FALSE(ParseUint(&str, 3, &value));
+
+  str = "+1";
+  TEST_ASSERT_FALSE(ParseUint(&str, 3, &value));
+
+  str = "99999999999";
+  TEST_ASSERT_TRUE(ParseUint(&str, 11, &value));
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, value);
+}
+
+void TestInt(void) {
+  const char *str = " +20000-12";
+  int32_t value = 0;
+
+  TEST_ASSERT_TRUE(ParseInt(&str, &value));
+  TEST_ASSERT_EQUAL_INT32(20000, value);
+  TEST_ASSERT_TRUE(ParseInt(&str, &value));
+  TEST_ASSERT_EQUAL_INT32(-12, value);
+  TEST_ASSERT_FALSE(ParseInt(&str, &value));
+
+  str = "-";
+  TEST_ASSERT_FALSE(ParseInt(&str, &value));
+  TEST_ASSERT_EQUAL_STRING("-", str);
+
+  str = "-2147483648";
+  TEST_ASSERT_TRUE(ParseInt(&str, &value));
+  TEST_ASSERT_EQUAL_INT32(INT32_MIN, value);
+
+  str = "2147483648";
+  TEST_ASSERT_TRUE(ParseInt(&str, &value));
+  TEST_ASSERT_EQUAL_INT32(INT32_MAX, value);
+}
+
+void TestFixed(void) {
+  const char *str = "+1846.16-22.3+1";
+  q32_t value = 0;
+
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_CONST(1846.16) == value);
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_CONST(-22.3) == value);
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_ONE == value);
+  TEST_ASSERT_FALSE(ParseFixed(&str, &value));
+}
+
+void TestFixedForms(void) {
+  const char *str = "1.";
+  q32_t value = 0;
+
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_ONE == value);
+
+  str = "-.5";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(-Q32_ONE / 2 == value);
+
+  str = "\t 0.25 ";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_ONE / 4 == value);
+  TEST_ASSERT_EQUAL_STRING(" ", str);
+
+  str = "+.";
+  TEST_ASSERT_FALSE(ParseFixed(&str, &value));
+  TEST_ASSERT_EQUAL_STRING("+.", str);
+
+  // fractions of the resolution
+  str = "0.00000000012";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(1 == value);
+
+  str = "0.00000000035";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(2 == value);
+
+  // digits past the 18th are skipped
+  str = "0.1000000000000000000000009,";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_CONST(0.1) == value);
+  TEST_ASSERT_EQUAL_STRING(",", str);
+}
+
+void TestFixedSaturate(void) {
+  const char *str = "2147483647.99999999999";
+  q32_t value = 0;
+
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_MAX == value);
+
+  str = "-99999999999";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(-Q32_MAX == value);
+
+  str = "-2147483647.5";
+  TEST_ASSERT_TRUE(ParseFixed(&str, &value));
+  TEST_ASSERT_TRUE(Q32_CONST(-2147483647.5) == value);
+}
+
+void TestToken(void) {
+  const char *str = "NNE, Altitude";
+  char token[4];
+
+  TEST_ASSERT_TRUE(ParseToken(&str, ',', token, sizeof(token)));
+  TEST_ASSERT_EQUAL_STRING("NNE", token);
+  TEST_ASSERT_EQUAL_STRING(", Altitude", str);
+  TEST_ASSERT_FALSE(ParseToken(&str, ',', token, sizeof(token)));
+
+  // limited by the buffer
+  str = "NNNE,";
+  TEST_ASSERT_TRUE(ParseToken(&str, ',', token, sizeof(token)));
+  TEST_ASSERT_EQUAL_STRING("NNN", token);
+  TEST_ASSERT_EQUAL_STRING("E,", str);
+}
+
+void TestFormat(void) {
+  // same as "%1c+%f%f+%d" of the Teros12
+  const char *str = "0+1846.16+22.3+20000";
+  char addr = 0;
+  q32_t vwc = 0;
+  q32_t temp = 0;
+  int32_t ec = 0;
+
+  TEST_ASSERT_TRUE(ParseChar(&str, &addr) && ParseLiteral(&str, "+") &&
+                   ParseFixed(&str, &vwc) && ParseFixed(&str, &temp) &&
+                   ParseLiteral(&str, "+") && ParseInt(&str, &ec));
+  TEST_ASSERT_EQUAL_CHAR('0', addr);
+  TEST_ASSERT_TRUE(Q32_CONST(1846.16) == vwc);
+  TEST_ASSERT_TRUE(Q32_CONST(22.3) == temp);
+  TEST_ASSERT_EQUAL_INT32(20000, ec);
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestChar);
+  RUN_TEST(TestLiteral);
+  RUN_TEST(TestUint);
+  RUN_TEST(TestInt);
+  RUN_TEST(TestFixed);
+  RUN_TEST(TestFixedForms);
+  RUN_TEST(TestFixedSaturate);
+  RUN_TEST(TestToken);
+  RUN_TEST(TestFormat);
+
+  UNITY_END();
+}
@@ -0,0 +1,321 @@
+/**
+ * @file test_power_delta.c
+ * @brief Tests delta encoding of high rate power samples
+ *
+ * Records are decoded with nanopb, unpacked and expanded back to samples to
+ * check the round trip. Captured ADC traces are checked on the host by
+ * extras/compression/bench/power_delta_test.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "pb_decode.h"
+#include "power_delta.h"
+#include "usart.h"
+
+/** Max number of entries decoded from a single record */
+#define MAX_ENTRIES 64
+
+/** Size of a raw sample, timestamp and two 32-bit codes */
+#define RAW_SAMPLE_SIZE 12
+
+/** Ring under test */
+static PowerDeltaRing ring;
+
+/** Entries decoded from a record */
+typedef struct {
+  PowerDeltaEntry entries[MAX_ENTRIES];
+  size_t count;
+} DecodedEntries;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { PowerDeltaRingInit(&ring); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+/**
+ * @brief Decode a record into @p decoded, asserting the ids
+ */
+static void DecodeRecord(const uint8_t *data, size_t len, uint32_t logger_id,
+                         uint32_t cell_id, DecodedEntries *decoded) {
+  RepeatedPowerDeltas deltas = RepeatedPowerDeltas_init_zero;
+
+  pb_istream_t stream = pb_istream_from_buffer(data, len);
+  TEST_ASSERT_TRUE(pb_decode(&stream, RepeatedPowerDeltas_fields, &deltas));
+  TEST_ASSERT_EQUAL(logger_id, deltas.logger_id);
+  TEST_ASSERT_EQUAL(cell_id, deltas.cell_id);
+
+  TEST_ASSERT_EQUAL(POWER_DELTA_OK,
+                    PowerDeltaUnpack(deltas.packed_entries.bytes,
+                                     deltas.packed_entries.size,
+                                     decoded->entries, MAX_ENTRIES,
+                                     &decoded->count));
+}
+
+static PowerSample Sample(uint32_t seconds, uint16_t ms, int32_t voltage,
+                          int32_t current) {
+  PowerSample s = {seconds, ms, voltage, current};
+  return s;
+}
+
+static void AssertSample(const PowerSample *expected,
+                         const PowerSample *actual) {
+  TEST_ASSERT_EQUAL_UINT32(expected->seconds, actual->seconds);
+  TEST_ASSERT_EQUAL_UINT16(expected->ms, actual->ms);
+  TEST_ASSERT_EQUAL_INT32(expected->voltage, actual->voltage);
+  TEST_ASSERT_EQUAL_INT32(expected->current, actual->current);
+}
+
+void TestZigZag(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, PowerDeltaZigZag(0));
+  TEST_ASSERT_EQUAL_UINT32(1, PowerDeltaZigZag(-1));
+  TEST_ASSERT_EQUAL_UINT32(2, PowerDeltaZigZag(1));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFF, PowerDeltaZigZag(INT32_MIN));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFE, PowerDeltaZigZag(INT32_MAX));
+
+  const int32_t values[] = {0, 1, -1, 8388607, -8388608, INT32_MAX, INT32_MIN};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+    TEST_ASSERT_EQUAL_INT32(values[i],
+                            PowerDeltaUnZigZag(PowerDeltaZigZag(values[i])));
+  }
+}
+
+void TestRingRoundTrip(void) {
+  const PowerSample samples[] = {
+      Sample(1436079600, 990, 12000, -300), Sample(1436079601, 1, 12003, -298),
+      Sample(1436079601, 12, 11990, -310), Sample(1436079601, 500, -8388608, 0),
+      Sample(1436079605, 0, 8388607, 8388607)};
+  const size_t n = sizeof(samples) / sizeof(samples[0]);
+
+  for (size_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &samples[i]));
+  }
+  TEST_ASSERT_EQUAL(n, ring.count);
+
+  PowerSample out;
+  for (size_t i = 0; i < n; i++) {
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPop(&ring, &out));
+    AssertSample(&samples[i], &out);
+  }
+  TEST_ASSERT_EQUAL(POWER_DELTA_EMPTY, PowerDeltaRingPop(&ring, &out));
+  TEST_ASSERT_EQUAL(0, ring.used);
+}
+
+void TestRingSmallDeltas(void) {
+  // slowly changing signal sampled at 90 SPS
+  PowerSample s = Sample(1436079600, 0, 50000, 1200);
+  TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &s));
+  for (int i = 0; i < 100; i++) {
+    s.ms += 11;
+    s.voltage += (i % 3) - 1;
+    s.current += (i % 5) - 2;
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &s));
+  }
+
+  // one byte per field
+  TEST_ASSERT_EQUAL(3 * 100, ring.used);
+}
+
+void TestRingBackwardsTime(void) {
+  const PowerSample a = Sample(1436079600, 500, 1, 2);
+  const PowerSample b = Sample(1436079600, 100, 3, 4);
+
+  PowerDeltaRingPush(&ring, &a);
+  PowerDeltaRingPush(&ring, &b);
+
+  PowerSample out;
+  PowerDeltaRingPop(&ring, &out);
+  PowerDeltaRingPop(&ring, &out);
+
+  // clamped to the previous timestamp
+  TEST_ASSERT_EQUAL_UINT32(a.seconds, out.seconds);
+  TEST_ASSERT_EQUAL_UINT16(a.ms, out.ms);
+  TEST_ASSERT_EQUAL_INT32(b.voltage, out.voltage);
+}
+
+void TestRingFullAndWrap(void) {
+  PowerSample s = Sample(0, 0, 0, 0);
+  TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &s));
+
+  // worst case deltas until full
+  size_t pushed = 1;
+  for (;;) {
+    s.ms += 1;
+    s.voltage = (pushed % 2) ? INT32_MIN : INT32_MAX;
+    s.current = (pushed % 2) ? INT32_MAX : INT32_MIN;
+    if (PowerDeltaRingPush(&ring, &s) != POWER_DELTA_OK) {
+      break;
+    }
+    ++pushed;
+  }
+  TEST_ASSERT_EQUAL(pushed, ring.count);
+  TEST_ASSERT_GREATER_THAN(POWER_DELTA_RING_SIZE - POWER_DELTA_MAX_SAMPLE_SIZE,
+                           ring.used);
+
+  // drain half and refill past the end of the buffer
+  PowerSample out;
+  for (size_t i = 0; i < pushed / 2; i++) {
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPop(&ring, &out));
+  }
+  PowerSample expected = ring.first;
+
+  s = ring.last;
+  for (int i = 0; i < 100; i++) {
+    s.ms += 1;
+    s.voltage = i;
+    s.current = -i;
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &s));
+  }
+
+  TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPop(&ring, &out));
+  AssertSample(&expected, &out);
+  while (ring.count > 1) {
+    PowerDeltaRingPop(&ring, &out);
+  }
+  PowerDeltaRingPop(&ring, &out);
+  AssertSample(&s, &out);
+}
+
+void TestRecordEmpty(void) {
+  uint8_t buffer[POWER_DELTA_RECORD_SIZE];
+  size_t len = 0;
+  const PowerDeltaStatus status =
+      PowerDeltaRecord(&ring, 1, 2, buffer, sizeof(buffer), &len);
+  TEST_ASSERT_EQUAL(POWER_DELTA_EMPTY, status);
+}
+
+void TestRecordTooSmall(void) {
+  const PowerSample s = Sample(1436079600, 0, 8388607, -8388608);
+  PowerDeltaRingPush(&ring, &s);
+
+  uint8_t buffer[8];
+  size_t len = 0;
+  const PowerDeltaStatus status =
+      PowerDeltaRecord(&ring, 1, 2, buffer, sizeof(buffer), &len);
+  TEST_ASSERT_EQUAL(POWER_DELTA_FULL, status);
+  // sample is kept
+  TEST_ASSERT_EQUAL(1, ring.count);
+}
+
+void TestRecordRoundTrip(void) {
+  // static to keep them off the stack
+  static PowerSample samples[200];
+  static DecodedEntries decoded;
+  static PowerSample expanded[MAX_ENTRIES];
+  const size_t n = sizeof(samples) / sizeof(samples[0]);
+
+  PowerSample s = Sample(1436079600, 0, 250000, -4000);
+  for (size_t i = 0; i < n; i++) {
+    samples[i] = s;
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRingPush(&ring, &s));
+
+    s.ms += 11 + (i % 2);
+    if (s.ms >= 1000) {
+      s.ms -= 1000;
+      s.seconds++;
+    }
+    s.voltage += (int32_t)(i * 7 % 13) - 6;
+    s.current += (int32_t)(i * 5 % 9) - 4;
+  }
+
+  uint8_t buffer[POWER_DELTA_RECORD_SIZE];
+  size_t total = 0;
+  size_t bytes = 0;
+
+  while (ring.count > 0) {
+    size_t len = 0;
+    TEST_ASSERT_EQUAL(POWER_DELTA_OK, PowerDeltaRecord(&ring, 7, 4, buffer,
+                                                       sizeof(buffer), &len));
+    TEST_ASSERT_LESS_OR_EQUAL(sizeof(buffer), len);
+    // only the last record may have space for another entry
+    if (ring.count > 0) {
+      TEST_ASSERT_GREATER_THAN(sizeof(buffer) - POWER_DELTA_MAX_SAMPLE_SIZE,
+                               len);
+    }
+    bytes += len;
+
+    DecodeRecord(buffer, len, 7, 4, &decoded);
+    TEST_ASSERT_GREATER_THAN(0, decoded.count);
+    PowerDeltaExpand(decoded.entries, decoded.count, expanded);
+
+    // first entry has second resolution, the rest are relative to it
+    const PowerSample *first = &samples[total];
+    for (size_t i = 0; i < decoded.count; i++) {
+      const PowerSample *orig = &samples[total + i];
+      const uint32_t orig_ms = (orig->seconds - first->seconds) * 1000 +
+                               orig->ms - first->ms;
+      const uint32_t out_ms =
+          (expanded[i].seconds - expanded[0].seconds) * 1000 + expanded[i].ms;
+
+      TEST_ASSERT_EQUAL_UINT32(orig_ms, out_ms);
+      TEST_ASSERT_EQUAL_INT32(orig->voltage, expanded[i].voltage);
+      TEST_ASSERT_EQUAL_INT32(orig->current, expanded[i].current);
+    }
+    TEST_ASSERT_EQUAL_UINT32(first->seconds, expanded[0].seconds);
+
+    total += decoded.count;
+  }
+
+  TEST_ASSERT_EQUAL(n, total);
+  // records are smaller than raw samples
+  TEST_ASSERT_LESS_THAN(n * RAW_SAMPLE_SIZE, bytes);
+}
+
+void TestUnpackTruncated(void) {
+  // ts, voltage and current of one entry, then an entry cut short
+  const uint8_t packed[] = {0x0B, 0x02, 0x01, 0x0B, 0x80};
+  PowerDeltaEntry entries[2];
+  size_t count = 0;
+
+  TEST_ASSERT_EQUAL(POWER_DELTA_OK,
+                    PowerDeltaUnpack(packed, 3, entries, 2, &count));
+  TEST_ASSERT_EQUAL(1, count);
+  TEST_ASSERT_EQUAL_UINT32(11, entries[0].ts);
+  TEST_ASSERT_EQUAL_UINT32(2, entries[0].voltage_delta);
+  TEST_ASSERT_EQUAL_UINT32(1, entries[0].current_delta);
+
+  TEST_ASSERT_EQUAL(POWER_DELTA_ERROR,
+                    PowerDeltaUnpack(packed, sizeof(packed), entries, 2,
+                                     &count));
+  TEST_ASSERT_EQUAL(POWER_DELTA_FULL,
+                    PowerDeltaUnpack(packed, 3, entries, 0, &count));
+}
+
+/**
+ * @brief Entry point for power delta test
+ * @retval int
+ */
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestZigZag);
+  RUN_TEST(TestRingRoundTrip);
+  RUN_TEST(TestRingSmallDeltas);
+  RUN_TEST(TestRingBackwardsTime);
+  RUN_TEST(TestRingFullAndWrap);
+  RUN_TEST(TestRecordEmpty);
+  RUN_TEST(TestRecordTooSmall);
+  RUN_TEST(TestRecordRoundTrip);
+  RUN_TEST(TestUnpackTruncated);
+
+  UNITY_END();
+}
@@ -0,0 +1,192 @@
+/**
+ * @file test_prof.c
+ * @brief Tests the profiling table and its blob
+ *
+ * The table is static and entries cannot be released, so TestFull runs last.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "prof.h"
+#include "usart.h"
+
+/** Loop iterations of a scope */
+static volatile int spin = 0;
+
+/** Read a little endian integer from the blob */
+static uint64_t Get(const uint8_t *data, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++) {
+    value |= (uint64_t)data[i] << (8 * i);
+  }
+  return value;
+}
+
+/** Function with a scope and two return paths */
+static int Scoped(int n) {
+  PROF_SCOPE("scoped");
+
+  for (spin = 0; spin < n; spin++) {
+  }
+  if (n > 100) {
+    return 1;
+  }
+  return 0;
+}
+
+/** Function with a scope calling another scope */
+static void Outer(void) {
+  PROF_SCOPE("outer");
+  Scoped(10);
+}
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { ProfReset(); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestRegister(void) {
+  const int a = ProfRegister("a");
+  const int b = ProfRegister("b");
+  TEST_ASSERT_GREATER_OR_EQUAL(0, a);
+  TEST_ASSERT_GREATER_OR_EQUAL(0, b);
+  TEST_ASSERT_NOT_EQUAL(a, b);
+  TEST_ASSERT_EQUAL(a, ProfRegister("a"));
+
+  // truncated to PROF_NAME_SIZE - 1 characters
+  const int long_name = ProfRegister("a_very_long_name");
+  TEST_ASSERT_EQUAL_STRING("a_very_long", ProfGet(long_name)->name);
+  TEST_ASSERT_EQUAL(long_name, ProfRegister("a_very_long_other"));
+
+  TEST_ASSERT_NULL(ProfGet(PROF_FULL));
+}
+
+void TestRecord(void) {
+  const int id = ProfRegister("record");
+  ProfRecord(id, 30);
+  ProfRecord(id, 10);
+  ProfRecord(id, 20);
+
+  const ProfStats *stats = ProfGet(id);
+  TEST_ASSERT_EQUAL_UINT32(3, stats->count);
+  TEST_ASSERT_EQUAL_UINT32(10, stats->min);
+  TEST_ASSERT_EQUAL_UINT32(30, stats->max);
+  TEST_ASSERT_TRUE(stats->total == 60);
+
+  // ignored
+  ProfRecord(PROF_FULL, 5);
+  TEST_ASSERT_EQUAL_UINT32(3, stats->count);
+}
+
+void TestScope(void) {
+  Scoped(10);
+  Scoped(1000);
+
+  const ProfStats *stats = ProfGet(ProfRegister("scoped"));
+  TEST_ASSERT_EQUAL_UINT32(2, stats->count);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, stats->min);
+  TEST_ASSERT_GREATER_THAN_UINT32(stats->min, stats->max);
+  TEST_ASSERT_TRUE(stats->total == (uint64_t)stats->min + stats->max);
+}
+
+void TestNested(void) {
+  Outer();
+
+  const ProfStats *outer = ProfGet(ProfRegister("outer"));
+  const ProfStats *inner = ProfGet(ProfRegister("scoped"));
+  TEST_ASSERT_EQUAL_UINT32(1, outer->count);
+  TEST_ASSERT_EQUAL_UINT32(1, inner->count);
+  TEST_ASSERT_TRUE(outer->total >= inner->total);
+}
+
+void TestReset(void) {
+  const int id = ProfRegister("reset");
+  ProfRecord(id, 7);
+  ProfReset();
+
+  const ProfStats *stats = ProfGet(id);
+  TEST_ASSERT_EQUAL_STRING("reset", stats->name);
+  TEST_ASSERT_EQUAL_UINT32(0, stats->count);
+  TEST_ASSERT_TRUE(stats->total == 0);
+}
+
+void TestSerialize(void) {
+  const int id = ProfRegister("blob");
+  ProfRecord(id, 4);
+  ProfRecord(id, 6);
+
+  uint8_t blob[PROF_BLOB_SIZE];
+  const size_t len = ProfSerialize(blob, sizeof(blob));
+  TEST_ASSERT_EQUAL(PROF_HEADER_SIZE + blob[1] * PROF_ENTRY_SIZE, len);
+  TEST_ASSERT_EQUAL(PROF_VERSION, blob[0]);
+  TEST_ASSERT_GREATER_THAN(id, blob[1]);
+  TEST_ASSERT_EQUAL_UINT32(ProfTicksPerSecond(), Get(&blob[2], 4));
+
+  const uint8_t *entry = &blob[PROF_HEADER_SIZE + id * PROF_ENTRY_SIZE];
+  TEST_ASSERT_EQUAL_STRING("blob", (const char *)entry);
+  entry += PROF_NAME_SIZE;
+  TEST_ASSERT_EQUAL_UINT32(2, Get(entry, 4));
+  TEST_ASSERT_EQUAL_UINT32(4, Get(entry + 4, 4));
+  TEST_ASSERT_EQUAL_UINT32(6, Get(entry + 8, 4));
+  TEST_ASSERT_TRUE(Get(entry + 12, 8) == 10);
+
+  // entries without calls have a min of 0
+  const int empty = ProfRegister("empty");
+  const size_t empty_len = ProfSerialize(blob, sizeof(blob));
+  TEST_ASSERT_EQUAL(len + PROF_ENTRY_SIZE, empty_len);
+  entry = &blob[PROF_HEADER_SIZE + empty * PROF_ENTRY_SIZE + PROF_NAME_SIZE];
+  TEST_ASSERT_EQUAL_UINT32(0, Get(entry + 4, 4));
+
+  TEST_ASSERT_EQUAL(0, ProfSerialize(blob, empty_len - 1));
+}
+
+void TestFull(void) {
+  char name[PROF_NAME_SIZE];
+  for (int i = 0; i < PROF_MAX_SCOPES; i++) {
+    snprintf(name, sizeof(name), "full_%u", (uint8_t)i);
+    ProfRegister(name);
+  }
+  TEST_ASSERT_EQUAL(PROF_FULL, ProfRegister("one_more"));
+
+  // existing entries are still found
+  TEST_ASSERT_GREATER_OR_EQUAL(0, ProfRegister("blob"));
+
+  uint8_t blob[PROF_BLOB_SIZE];
+  TEST_ASSERT_EQUAL(PROF_BLOB_SIZE, ProfSerialize(blob, sizeof(blob)));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  ProfInit();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestRegister);
+  RUN_TEST(TestRecord);
+  RUN_TEST(TestScope);
+  RUN_TEST(TestNested);
+  RUN_TEST(TestReset);
+  RUN_TEST(TestSerialize);
+  RUN_TEST(TestFull);
+
+  UNITY_END();
+}
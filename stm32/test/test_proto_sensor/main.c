@@ -237,6 +237,44 @@ void TestEncodeDoubleMeasurement(void) {
   TEST_ASSERT_GREATER_THAN(0, buffer_len);
 }
 
+void TestEncodeSummaryMeasurement(void) {
+  SensorStatus status = SENSOR_OK;
+
+  Metadata meta = Metadata_init_zero;
+  meta.ts = 1111;
+  meta.logger_id = 2222;
+  meta.cell_id = 3333;
+
+  Summary summary = Summary_init_zero;
+  summary.count = 60;
+  summary.min = -1.5f;
+  summary.mean = 2.25f;
+  summary.max = 7.0f;
+  summary.stddev = 0.5f;
+
+  uint8_t buffer[256];
+  size_t buffer_len = sizeof(buffer);
+  status = EncodeSummaryMeasurement(meta, &summary, SensorType_TEROS12_TEMP,
+                                    buffer, &buffer_len);
+
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+  TEST_ASSERT_GREATER_THAN(0, buffer_len);
+  TEST_ASSERT_LESS_OR_EQUAL(SensorMeasurement_size, buffer_len);
+
+  SensorMeasurement out = SensorMeasurement_init_zero;
+  status = DecodeSensorMeasurement(buffer, buffer_len, &out);
+
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+  TEST_ASSERT_EQUAL(SensorType_TEROS12_TEMP, out.type);
+  TEST_ASSERT_EQUAL(SensorMeasurement_summary_tag, out.which_value);
+  TEST_ASSERT_EQUAL_UINT32(meta.ts, out.meta.ts);
+  TEST_ASSERT_EQUAL_UINT32(summary.count, out.value.summary.count);
+  TEST_ASSERT_EQUAL_FLOAT(summary.min, out.value.summary.min);
+  TEST_ASSERT_EQUAL_FLOAT(summary.mean, out.value.summary.mean);
+  TEST_ASSERT_EQUAL_FLOAT(summary.max, out.value.summary.max);
+  TEST_ASSERT_EQUAL_FLOAT(summary.stddev, out.value.summary.stddev);
+}
+
 void TestRepeatedSensorResponses(void) {
   SensorStatus status = SENSOR_OK;
 
@@ -250,6 +288,8 @@ void TestRepeatedSensorResponses(void) {
   responses.responses[1].idx = 2;
   responses.responses[1].error = SensorError_DECODE;
 
+  responses.seq = 42;
+
   // encode
   uint8_t buffer[256];
   size_t buffer_len = sizeof(buffer);
@@ -267,6 +307,7 @@ void TestRepeatedSensorResponses(void) {
 
   TEST_ASSERT_EQUAL(SENSOR_OK, status);
   TEST_ASSERT_EQUAL(2, decoded.responses_count);
+  TEST_ASSERT_EQUAL(42, decoded.seq);
 
   TEST_ASSERT_EQUAL(responses.responses[0].idx, decoded.responses[0].idx);
   TEST_ASSERT_EQUAL(responses.responses[0].error, decoded.responses[0].error);
@@ -343,6 +384,46 @@ void TestRepeatedSensorMeasurementsSize(void) {
   TEST_ASSERT_GREATER_THAN(0, size);
 }
 
+void TestSequencedSensorMeasurements(void) {
+  SensorStatus status = SENSOR_OK;
+  uint8_t buffer[256];
+  size_t buffer_len = 0;
+
+  SensorMeasurement in_array[3] = {};
+  for (int i = 0; i < 3; i++) {
+    in_array[i].has_meta = true;
+    in_array[i].meta.ts = 123;
+    in_array[i].type = SensorType_POWER_VOLTAGE;
+    in_array[i].which_value = SensorMeasurement_unsigned_int_tag;
+    in_array[i].value.unsigned_int = 3300 + i;
+  }
+
+  status = EncodeSequencedSensorMeasurements(70000, METADATA_NONE, in_array, 3,
+                                             buffer, sizeof(buffer),
+                                             &buffer_len);
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+
+  // the size includes the sequence number
+  size_t size = 0;
+  status = SequencedSensorMeasurementsSize(70000, METADATA_NONE, in_array, 3,
+                                           &size);
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+  TEST_ASSERT_EQUAL(buffer_len, size);
+
+  size_t unsequenced = 0;
+  status = RepeatedSensorMeasurementsSize(METADATA_NONE, in_array, 3,
+                                          &unsequenced);
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+  TEST_ASSERT_EQUAL(unsequenced + 4, size);
+
+  RepeatedSensorMeasurements rep_out = RepeatedSensorMeasurements_init_zero;
+  status = DecodeRepeatedSensorMeasurements(buffer, buffer_len, &rep_out);
+  TEST_ASSERT_EQUAL(SENSOR_OK, status);
+  TEST_ASSERT_EQUAL(70000, rep_out.seq);
+  TEST_ASSERT_EQUAL(3, rep_out.measurements_count);
+  TEST_ASSERT_EQUAL(3302, rep_out.measurements[2].value.unsigned_int);
+}
+
 /**
  * @brief Entry point for protobuf test
  * @retval int
@@ -371,9 +452,11 @@ int main(void) {
   RUN_TEST(TestEncodeUint32Measurement);
   RUN_TEST(TestEncodeInt32Measurement);
   RUN_TEST(TestEncodeDoubleMeasurement);
+  RUN_TEST(TestEncodeSummaryMeasurement);
   RUN_TEST(TestRepeatedSensorResponses);
   RUN_TEST(TestCheckSensorResponse);
   RUN_TEST(TestRepeatedSensorMeasurementsSize);
+  RUN_TEST(TestSequencedSensorMeasurements);
 
   UNITY_END();
 }
@@ -0,0 +1,109 @@
+/**
+ * @file test_rate.c
+ * @brief Tests adapting the upload rate to the backlog
+ *
+ * The thresholds are tuned on the host by extras/rate/rate_sim.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "rate.h"
+#include "usart.h"
+
+/** Default thresholds, drain at 16, clear at 4 */
+static const RateConfig config = RATE_CONFIG_DEFAULT;
+
+static RateController rate;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { RateInit(&rate, &config); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestInit(void) {
+  TEST_ASSERT_FALSE(rate.draining);
+  TEST_ASSERT_EQUAL_UINT32(60000, RateUploadPeriod(&rate, 60000));
+}
+
+void TestUnchanged(void) {
+  TEST_ASSERT_FALSE(RateUpdate(&rate, 0));
+  TEST_ASSERT_FALSE(RateUpdate(&rate, 15));
+  TEST_ASSERT_EQUAL_UINT32(60000, RateUploadPeriod(&rate, 60000));
+}
+
+void TestDrain(void) {
+  RateUpdate(&rate, 15);
+  TEST_ASSERT_FALSE(rate.draining);
+
+  TEST_ASSERT_TRUE(RateUpdate(&rate, 16));
+  TEST_ASSERT_TRUE(rate.draining);
+  TEST_ASSERT_EQUAL_UINT32(30000, RateUploadPeriod(&rate, 60000));
+
+  // keeps draining until the backlog is cleared
+  TEST_ASSERT_FALSE(RateUpdate(&rate, 10));
+  TEST_ASSERT_TRUE(rate.draining);
+
+  TEST_ASSERT_TRUE(RateUpdate(&rate, 4));
+  TEST_ASSERT_FALSE(rate.draining);
+  TEST_ASSERT_EQUAL_UINT32(60000, RateUploadPeriod(&rate, 60000));
+}
+
+void TestClamp(void) {
+  RateConfig bounded = config;
+  bounded.drain_scale = 500;
+  bounded.min_scale = 80;
+  RateInit(&rate, &bounded);
+
+  RateUpdate(&rate, 20);
+  TEST_ASSERT_EQUAL_UINT16(80, rate.upload_scale);
+  TEST_ASSERT_EQUAL_UINT32(48000, RateUploadPeriod(&rate, 60000));
+}
+
+void TestNoDrainScale(void) {
+  RateConfig off = config;
+  off.drain_scale = 0;
+  RateInit(&rate, &off);
+
+  RateUpdate(&rate, 20);
+  TEST_ASSERT_EQUAL_UINT32(60000, RateUploadPeriod(&rate, 60000));
+}
+
+void TestSaturate(void) {
+  RateConfig slow = config;
+  slow.drain_scale = 50;
+  RateInit(&rate, &slow);
+
+  RateUpdate(&rate, 20);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, RateUploadPeriod(&rate, UINT32_MAX));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestInit);
+  RUN_TEST(TestUnchanged);
+  RUN_TEST(TestDrain);
+  RUN_TEST(TestClamp);
+  RUN_TEST(TestNoDrainScale);
+  RUN_TEST(TestSaturate);
+
+  UNITY_END();
+}
@@ -0,0 +1,168 @@
+/**
+ * @file test_sample_ring.c
+ * @brief Tests the ring of raw ADC samples
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "sample_ring.h"
+#include "usart.h"
+
+/** Ring under test */
+static SampleRing ring;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { SampleRingInit(&ring); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+/**
+ * @brief Push a sample with the given value on channel 0
+ */
+static bool Push(int32_t raw) {
+  const AdcSample sample = {raw, 0};
+  return SampleRingPush(&ring, &sample);
+}
+
+void TestEmpty(void) {
+  AdcSample sample = {0};
+
+  TEST_ASSERT_EQUAL(0, SampleRingCount(&ring));
+  TEST_ASSERT_FALSE(SampleRingPop(&ring, &sample));
+}
+
+void TestPushPop(void) {
+  const AdcSample in = {-8388608, 1};
+  AdcSample out = {0};
+
+  TEST_ASSERT_TRUE(SampleRingPush(&ring, &in));
+  TEST_ASSERT_EQUAL(1, SampleRingCount(&ring));
+
+  TEST_ASSERT_TRUE(SampleRingPop(&ring, &out));
+  TEST_ASSERT_EQUAL_INT32(in.raw, out.raw);
+  TEST_ASSERT_EQUAL_UINT8(in.channel, out.channel);
+  TEST_ASSERT_EQUAL(0, SampleRingCount(&ring));
+}
+
+void TestOrder(void) {
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_TRUE(Push(i));
+  }
+
+  AdcSample sample = {0};
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_TRUE(SampleRingPop(&ring, &sample));
+    TEST_ASSERT_EQUAL_INT32(i, sample.raw);
+  }
+  TEST_ASSERT_FALSE(SampleRingPop(&ring, &sample));
+}
+
+void TestFullDropsNewest(void) {
+  for (int i = 0; i < SAMPLE_RING_SIZE; i++) {
+    TEST_ASSERT_TRUE(Push(i));
+  }
+
+  TEST_ASSERT_FALSE(Push(-1));
+  TEST_ASSERT_FALSE(Push(-2));
+  TEST_ASSERT_EQUAL(SAMPLE_RING_SIZE, SampleRingCount(&ring));
+  TEST_ASSERT_EQUAL_UINT32(2, ring.dropped);
+
+  // the samples already in the ring are kept
+  AdcSample sample = {0};
+  TEST_ASSERT_TRUE(SampleRingPop(&ring, &sample));
+  TEST_ASSERT_EQUAL_INT32(0, sample.raw);
+
+  // a slot is free again
+  TEST_ASSERT_TRUE(Push(SAMPLE_RING_SIZE));
+  TEST_ASSERT_EQUAL_UINT32(2, ring.dropped);
+}
+
+void TestInterleaved(void) {
+  AdcSample sample = {0};
+  int32_t expected = 0;
+
+  // consumer drains in batches across many laps of the buffer
+  for (int32_t i = 0; i < SAMPLE_RING_SIZE * 20; i++) {
+    TEST_ASSERT_TRUE(Push(i));
+    if (i % 3 == 2) {
+      for (int j = 0; j < 3; j++) {
+        TEST_ASSERT_TRUE(SampleRingPop(&ring, &sample));
+        TEST_ASSERT_EQUAL_INT32(expected++, sample.raw);
+      }
+    }
+  }
+
+  while (SampleRingPop(&ring, &sample)) {
+    TEST_ASSERT_EQUAL_INT32(expected++, sample.raw);
+  }
+  TEST_ASSERT_EQUAL_INT32(SAMPLE_RING_SIZE * 20, expected);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.dropped);
+}
+
+void TestIndexWrapAround(void) {
+  // free running indices just before they wrap
+  ring.head = UINT32_MAX - 2;
+  ring.tail = UINT32_MAX - 2;
+
+  for (int i = 0; i < SAMPLE_RING_SIZE; i++) {
+    TEST_ASSERT_TRUE(Push(i));
+  }
+  TEST_ASSERT_FALSE(Push(-1));
+  TEST_ASSERT_EQUAL(SAMPLE_RING_SIZE, SampleRingCount(&ring));
+
+  AdcSample sample = {0};
+  for (int i = 0; i < SAMPLE_RING_SIZE; i++) {
+    TEST_ASSERT_TRUE(SampleRingPop(&ring, &sample));
+    TEST_ASSERT_EQUAL_INT32(i, sample.raw);
+  }
+  TEST_ASSERT_EQUAL(0, SampleRingCount(&ring));
+}
+
+void TestInitClears(void) {
+  Push(1);
+  for (int i = 0; i < SAMPLE_RING_SIZE; i++) {
+    Push(i);
+  }
+  TEST_ASSERT_NOT_EQUAL(0, ring.dropped);
+
+  SampleRingInit(&ring);
+  TEST_ASSERT_EQUAL(0, SampleRingCount(&ring));
+  TEST_ASSERT_EQUAL_UINT32(0, ring.dropped);
+}
+
+/**
+ * @brief Entry point for sample ring test
+ * @retval int
+ */
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestEmpty);
+  RUN_TEST(TestPushPop);
+  RUN_TEST(TestOrder);
+  RUN_TEST(TestFullDropsNewest);
+  RUN_TEST(TestInterleaved);
+  RUN_TEST(TestIndexWrapAround);
+  RUN_TEST(TestInitClears);
+
+  UNITY_END();
+}
@@ -0,0 +1,242 @@
+/**
+ * @file test_schedule.c
+ * @brief Tests the per sensor measurement schedule
+ *
+ * Wakeups per hour for larger sensor mixes are simulated on the host by
+ * extras/scheduling/schedule_sim.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <stdio.h>
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "schedule.h"
+#include "usart.h"
+
+/** Schedule under test */
+static Schedule schedule;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) { ScheduleInit(&schedule, 1000); }
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestEmpty(void) {
+  uint32_t due = 0;
+  uint8_t ids[4];
+
+  TEST_ASSERT_FALSE(ScheduleNext(&schedule, &due));
+  TEST_ASSERT_EQUAL(0, SchedulePopDue(&schedule, 0, ids, 4));
+}
+
+void TestAddInvalid(void) {
+  TEST_ASSERT_FALSE(ScheduleAdd(&schedule, 0, 0, 0));
+  TEST_ASSERT_FALSE(ScheduleAdd(&schedule, 0, SCHEDULE_MAX_PERIOD + 1, 0));
+  TEST_ASSERT_TRUE(ScheduleAdd(&schedule, 0, SCHEDULE_MAX_PERIOD, 0));
+}
+
+void TestAddFull(void) {
+  for (int i = 0; i < SCHEDULE_MAX_ENTRIES; i++) {
+    TEST_ASSERT_TRUE(ScheduleAdd(&schedule, i, 1000, i));
+  }
+  TEST_ASSERT_FALSE(ScheduleAdd(&schedule, 0, 1000, 0));
+}
+
+void TestNextIsEarliest(void) {
+  const uint32_t due[] = {50000, 20000, 90000, 30000, 10000, 70000};
+  for (int i = 0; i < 6; i++) {
+    ScheduleAdd(&schedule, i, 60000, due[i]);
+  }
+
+  uint32_t next = 0;
+  TEST_ASSERT_TRUE(ScheduleNext(&schedule, &next));
+  TEST_ASSERT_EQUAL_UINT32(10000, next);
+}
+
+void TestPopInOrder(void) {
+  const uint32_t due[] = {50000, 20000, 90000, 30000, 10000, 70000};
+  const uint8_t expected[] = {4, 1, 3, 0, 5, 2};
+  for (int i = 0; i < 6; i++) {
+    ScheduleAdd(&schedule, i, 100000, due[i]);
+  }
+
+  uint8_t ids[6];
+  for (int i = 0; i < 6; i++) {
+    uint32_t next = 0;
+    ScheduleNext(&schedule, &next);
+    TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, next, ids, 6));
+    TEST_ASSERT_EQUAL_UINT8(expected[i], ids[0]);
+  }
+}
+
+void TestCoalesce(void) {
+  ScheduleAdd(&schedule, 0, 60000, 10000);
+  ScheduleAdd(&schedule, 1, 60000, 10400);
+  ScheduleAdd(&schedule, 2, 60000, 11000);
+  ScheduleAdd(&schedule, 3, 60000, 11001);
+
+  // window is inclusive
+  uint8_t ids[4];
+  TEST_ASSERT_EQUAL(3, SchedulePopDue(&schedule, 10000, ids, 4));
+  TEST_ASSERT_EQUAL_UINT8(0, ids[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, ids[1]);
+  TEST_ASSERT_EQUAL_UINT8(2, ids[2]);
+
+  uint32_t next = 0;
+  ScheduleNext(&schedule, &next);
+  TEST_ASSERT_EQUAL_UINT32(11001, next);
+}
+
+void TestNotDue(void) {
+  ScheduleAdd(&schedule, 0, 60000, 10000);
+
+  uint8_t ids[1];
+  TEST_ASSERT_EQUAL(0, SchedulePopDue(&schedule, 8999, ids, 1));
+  TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, 9000, ids, 1));
+}
+
+void TestIdsAscending(void) {
+  for (int i = 7; i >= 0; i--) {
+    ScheduleAdd(&schedule, i, 60000, 1000 - i * 100);
+  }
+
+  uint8_t ids[8];
+  TEST_ASSERT_EQUAL(8, SchedulePopDue(&schedule, 300, ids, 8));
+  for (int i = 0; i < 8; i++) {
+    TEST_ASSERT_EQUAL_UINT8(i, ids[i]);
+  }
+}
+
+void TestNoDrift(void) {
+  ScheduleAdd(&schedule, 0, 60000, 0);
+
+  // late and early wakeups keep the nominal deadlines
+  const uint32_t wakeups[] = {300, 59500, 121000};
+  const uint32_t expected[] = {60000, 120000, 180000};
+
+  uint8_t ids[1];
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, wakeups[i], ids, 1));
+    uint32_t next = 0;
+    ScheduleNext(&schedule, &next);
+    TEST_ASSERT_EQUAL_UINT32(expected[i], next);
+  }
+}
+
+void TestSkipMissed(void) {
+  ScheduleAdd(&schedule, 0, 10000, 0);
+
+  uint8_t ids[1];
+  TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, 35000, ids, 1));
+
+  uint32_t next = 0;
+  ScheduleNext(&schedule, &next);
+  TEST_ASSERT_EQUAL_UINT32(40000, next);
+}
+
+void TestPeriodShorterThanWindow(void) {
+  ScheduleAdd(&schedule, 0, 300, 0);
+
+  // measured once per wakeup
+  uint8_t ids[2];
+  TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, 0, ids, 2));
+
+  uint32_t next = 0;
+  ScheduleNext(&schedule, &next);
+  TEST_ASSERT_EQUAL_UINT32(1200, next);
+}
+
+void TestMax(void) {
+  ScheduleAdd(&schedule, 0, 60000, 0);
+  ScheduleAdd(&schedule, 1, 60000, 0);
+  ScheduleAdd(&schedule, 2, 60000, 0);
+
+  uint8_t ids[2];
+  TEST_ASSERT_EQUAL(2, SchedulePopDue(&schedule, 0, ids, 2));
+  TEST_ASSERT_EQUAL_UINT8(0, ids[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, ids[1]);
+
+  // remaining entry is still due
+  TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, 0, ids, 2));
+  TEST_ASSERT_EQUAL_UINT8(2, ids[0]);
+}
+
+void TestWrapAround(void) {
+  const uint32_t start = UINT32_MAX - 15000;
+  ScheduleAdd(&schedule, 0, 20000, start + 10000);
+  ScheduleAdd(&schedule, 1, 20000, start + 30000);
+
+  uint32_t next = 0;
+  ScheduleNext(&schedule, &next);
+  TEST_ASSERT_EQUAL_UINT32(start + 10000, next);
+
+  uint8_t ids[2];
+  TEST_ASSERT_EQUAL(1, SchedulePopDue(&schedule, start + 10000, ids, 2));
+  TEST_ASSERT_EQUAL_UINT8(0, ids[0]);
+
+  // both deadlines are past the wrap
+  TEST_ASSERT_EQUAL(2, SchedulePopDue(&schedule, start + 30000, ids, 2));
+}
+
+void TestWakeupsPerHour(void) {
+  // two sensors every minute and one every 5 minutes offset by 30 s
+  ScheduleAdd(&schedule, 0, 60000, 0);
+  ScheduleAdd(&schedule, 1, 60000, 500);
+  ScheduleAdd(&schedule, 2, 300000, 30000);
+
+  int wakeups = 0;
+  int measurements = 0;
+  uint32_t now = 0;
+  uint8_t ids[3];
+
+  while (now < 3600000) {
+    measurements += SchedulePopDue(&schedule, now, ids, 3);
+    ++wakeups;
+    ScheduleNext(&schedule, &now);
+  }
+
+  TEST_ASSERT_EQUAL(60 + 12, wakeups);
+  TEST_ASSERT_EQUAL(60 * 2 + 12, measurements);
+}
+
+/**
+ * @brief Entry point for schedule test
+ * @retval int
+ */
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestEmpty);
+  RUN_TEST(TestAddInvalid);
+  RUN_TEST(TestAddFull);
+  RUN_TEST(TestNextIsEarliest);
+  RUN_TEST(TestPopInOrder);
+  RUN_TEST(TestCoalesce);
+  RUN_TEST(TestNotDue);
+  RUN_TEST(TestIdsAscending);
+  RUN_TEST(TestNoDrift);
+  RUN_TEST(TestSkipMissed);
+  RUN_TEST(TestPeriodShorterThanWindow);
+  RUN_TEST(TestMax);
+  RUN_TEST(TestWrapAround);
+  RUN_TEST(TestWakeupsPerHour);
+
+  UNITY_END();
+}
@@ -40,6 +40,21 @@ void test_SDI12_GetMeasurement_success(void) {
   TEST_ASSERT_EQUAL(SDI12_OK, status);
 }
 
+void test_SDI12_CheckCrc_success(void) {
+  // example from SDI-12 v1.4 section 4.4.12.3
+  char line[] = "0+3.14OqZ";
+
+  TEST_ASSERT_EQUAL(SDI12_OK, SDI12CheckCrc(line));
+  TEST_ASSERT_EQUAL_STRING("0+3.14", line);
+}
+
+void test_SDI12_CheckCrc_mismatch(void) {
+  char line[] = "0+3.15OqZ";
+
+  TEST_ASSERT_EQUAL(SDI12_CRC_ERROR, SDI12CheckCrc(line));
+  TEST_ASSERT_EQUAL_STRING("0+3.15OqZ", line);
+}
+
 /**
  * @brief  The application entry point.
  * @retval int
@@ -73,6 +88,8 @@ int main(void) {
   UNITY_BEGIN();
   RUN_TEST(test_SDI12_SendCommand_success);
   RUN_TEST(test_SDI12_GetMeasurement_success);
+  RUN_TEST(test_SDI12_CheckCrc_success);
+  RUN_TEST(test_SDI12_CheckCrc_mismatch);
   UNITY_END();
   /* USER CODE END 3 */
 }
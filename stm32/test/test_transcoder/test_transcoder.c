@@ -56,6 +56,20 @@ void TestEncodePower(void) {
   TEST_ASSERT_EQUAL_INT(data_len, buffer_len);
 }
 
+void TestEncodePowerDelta(void) {
+  uint8_t buffer[256];
+  size_t buffer_len;
+
+  buffer_len = EncodePowerDeltaMeasurement(1436079600, 7, 4, 100, 200, buffer);
+
+  uint8_t data[] = {0x8,  0x7,  0x10, 0x4, 0x1a, 0xb,  0x8,  0xf0, 0xab,
+                    0xe3, 0xac, 0x5,  0x10, 0x64, 0x18, 0xc8, 0x1};
+  size_t data_len = 17;
+
+  TEST_ASSERT_EQUAL_HEX8_ARRAY(data, buffer, buffer_len);
+  TEST_ASSERT_EQUAL_INT(data_len, buffer_len);
+}
+
 void TestEncodeTeros12(void) {
   uint8_t buffer[256];
   size_t buffer_len;
@@ -233,6 +247,7 @@ int main(void) {
   UNITY_BEGIN();
 
   RUN_TEST(TestEncodePower);
+  RUN_TEST(TestEncodePowerDelta);
   RUN_TEST(TestEncodeTeros12);
   RUN_TEST(TestEncodePhytos31);
   RUN_TEST(TestEncodeBME280);
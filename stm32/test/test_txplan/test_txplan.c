@@ -0,0 +1,175 @@
+/**
+ * @file test_txplan.c
+ * @brief Tests the time on air and duty cycle budget of LoRaWAN uplinks
+ *
+ * Time on air values are from the AN1200.13 formula. The planner is checked
+ * against a host model of the EU868 and US915 rules by
+ * extras/duty_cycle/duty_cycle_sim.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "txplan.h"
+#include "usart.h"
+
+static TxPlan plan;
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {
+  TxPlanConfig config;
+  TxPlanRegion(TXPLAN_REGION_EU868, &config);
+  TxPlanInit(&plan, &config, 0);
+}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestAirtimeEU868(void) {
+  // 10 byte payload, 61.7 ms at SF7 and 1482.8 ms at SF12
+  TEST_ASSERT_EQUAL_UINT32(1483, TxPlanAirtime(TXPLAN_REGION_EU868, 0, 10));
+  TEST_ASSERT_EQUAL_UINT32(62, TxPlanAirtime(TXPLAN_REGION_EU868, 5, 10));
+  TEST_ASSERT_EQUAL_UINT32(31, TxPlanAirtime(TXPLAN_REGION_EU868, 6, 10));
+  TEST_ASSERT_EQUAL_UINT32(400, TxPlanAirtime(TXPLAN_REGION_EU868, 5, 242));
+}
+
+void TestAirtimeUS915(void) {
+  TEST_ASSERT_EQUAL_UINT32(371, TxPlanAirtime(TXPLAN_REGION_US915, 0, 11));
+  TEST_ASSERT_EQUAL_UINT32(412, TxPlanAirtime(TXPLAN_REGION_US915, 0, 12));
+  TEST_ASSERT_EQUAL_UINT32(29, TxPlanAirtime(TXPLAN_REGION_US915, 4, 10));
+}
+
+void TestAirtimeUnknown(void) {
+  // FSK, downlink only and unknown regions
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanAirtime(TXPLAN_REGION_EU868, 7, 10));
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanAirtime(TXPLAN_REGION_US915, 8, 10));
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanAirtime(TXPLAN_REGION_US915, -1, 10));
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanAirtime(0, 0, 10));
+}
+
+void TestMaxPayload(void) {
+  // N of the US915 regional parameters with the 400 ms dwell time
+  TEST_ASSERT_EQUAL_UINT8(11, TxPlanMaxPayload(TXPLAN_REGION_US915, 0, 400));
+  TEST_ASSERT_EQUAL_UINT8(53, TxPlanMaxPayload(TXPLAN_REGION_US915, 1, 400));
+  TEST_ASSERT_EQUAL_UINT8(125, TxPlanMaxPayload(TXPLAN_REGION_US915, 2, 400));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX,
+                          TxPlanMaxPayload(TXPLAN_REGION_EU868, 0, 0));
+  TEST_ASSERT_EQUAL_UINT8(UINT8_MAX, TxPlanMaxPayload(0, 0, 400));
+}
+
+void TestRegion(void) {
+  TxPlanConfig config;
+  TEST_ASSERT_TRUE(TxPlanRegion(TXPLAN_REGION_US915, &config));
+  TEST_ASSERT_EQUAL_UINT32(0, config.budget_ms);
+  TEST_ASSERT_EQUAL_UINT32(400, config.dwell_ms);
+
+  TEST_ASSERT_FALSE(TxPlanRegion(0, &config));
+  TEST_ASSERT_EQUAL_UINT32(0, config.budget_ms);
+  TEST_ASSERT_EQUAL_UINT16(0, config.drain_backlog);
+}
+
+void TestWithinBudget(void) {
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, 1000, 1483));
+  TxPlanSent(&plan, 1000, 1483);
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, 5000, 1483));
+}
+
+void TestBudgetExhausted(void) {
+  // 24 uplinks at SF12 are 35.6 s of the 36 s per hour
+  uint32_t now = 0;
+  for (int i = 0; i < 24; i++) {
+    TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, now, 1483));
+    TxPlanSent(&plan, now, 1483);
+    now += 3000;
+  }
+
+  // waits until the bin of all of them left the window, a bin after an hour
+  TEST_ASSERT_EQUAL_UINT32(TXPLAN_BINS * plan.bin_ms - now,
+                           TxPlanWait(&plan, now, 1483));
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, now, 400));
+}
+
+void TestWindowSlides(void) {
+  TxPlanSent(&plan, 0, 30000);
+  TEST_ASSERT_NOT_EQUAL(0, TxPlanWait(&plan, 60000, 10000));
+  // a bin later than the window the airtime has left it
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, 3600000 + plan.bin_ms, 10000));
+}
+
+void TestNeverFits(void) {
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, TxPlanWait(&plan, 0, 36001));
+}
+
+void TestNoDutyCycle(void) {
+  TxPlanConfig config;
+  TxPlanRegion(TXPLAN_REGION_US915, &config);
+  TxPlanInit(&plan, &config, 0);
+  for (int i = 0; i < 100; i++) {
+    TxPlanSent(&plan, i * 1000, 371);
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, 100000, 371));
+}
+
+void TestNextPeriod(void) {
+  // small backlog, waits the full period
+  TEST_ASSERT_EQUAL_UINT32(60000, TxPlanNext(&plan, 0, 62, 7, 60000));
+}
+
+void TestNextDrain(void) {
+  // large backlog, right after the receive windows
+  TEST_ASSERT_EQUAL_UINT32(3000, TxPlanNext(&plan, 0, 62, 8, 60000));
+  // never after the period
+  TEST_ASSERT_EQUAL_UINT32(2000, TxPlanNext(&plan, 0, 62, 8, 2000));
+}
+
+void TestNextDrainBudget(void) {
+  TxPlanSent(&plan, 0, 35000);
+  // the budget is out until the uplink leaves the window
+  TEST_ASSERT_EQUAL_UINT32(900000, TxPlanNext(&plan, 1000, 1483, 20, 900000));
+  // a smaller uplink still fits
+  TEST_ASSERT_EQUAL_UINT32(3000, TxPlanNext(&plan, 1000, 400, 20, 900000));
+}
+
+void TestWrap(void) {
+  TxPlanInit(&plan, &plan.config, UINT32_MAX - 1000);
+  TxPlanSent(&plan, UINT32_MAX - 1000, 35000);
+  TEST_ASSERT_NOT_EQUAL(0, TxPlanWait(&plan, 5000, 1483));
+  TEST_ASSERT_EQUAL_UINT32(0, TxPlanWait(&plan, 3600000 + plan.bin_ms, 1483));
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestAirtimeEU868);
+  RUN_TEST(TestAirtimeUS915);
+  RUN_TEST(TestAirtimeUnknown);
+  RUN_TEST(TestMaxPayload);
+  RUN_TEST(TestRegion);
+  RUN_TEST(TestWithinBudget);
+  RUN_TEST(TestBudgetExhausted);
+  RUN_TEST(TestWindowSlides);
+  RUN_TEST(TestNeverFits);
+  RUN_TEST(TestNoDutyCycle);
+  RUN_TEST(TestNextPeriod);
+  RUN_TEST(TestNextDrain);
+  RUN_TEST(TestNextDrainBudget);
+  RUN_TEST(TestWrap);
+
+  UNITY_END();
+}
@@ -0,0 +1,233 @@
+/**
+ * @file test_wakeup.c
+ * @brief Tests coalescing the deadlines of timers
+ *
+ * The coalescer runs on a fake clock that the tests advance by hand. Wakeups
+ * per day for typical configurations are simulated on the host by
+ * extras/scheduling/wakeup_sim.c.
+ *
+ * @date 2026-10-19
+ */
+
+#include <unity.h>
+
+#include "board.h"
+#include "gpio.h"
+#include "main.h"
+#include "usart.h"
+#include "wakeup.h"
+
+/** Time of the fake clock in ms */
+static uint32_t now = 0;
+
+/** Fake clock */
+static uint32_t Clock(void) { return now; }
+
+/**
+ * @brief Setup code that runs at the start of every test
+ */
+void setUp(void) {
+  now = 0;
+  WakeupInit(Clock, 1000);
+}
+
+/**
+ * @brief Tear down code that runs at the end of every test
+ */
+void tearDown(void) {}
+
+void TestGrid(void) {
+  now = 123;
+  TEST_ASSERT_EQUAL_UINT32(9877, WakeupDelay(0, 9500, 2000));
+
+  uint32_t due = 0;
+  TEST_ASSERT_TRUE(WakeupGet(0, &due));
+  TEST_ASSERT_EQUAL_UINT32(10000, due);
+}
+
+void TestGridOutsideSlack(void) {
+  // the next grid point is 900 ms away
+  TEST_ASSERT_EQUAL_UINT32(10100, WakeupDelay(0, 10100, 500));
+}
+
+void TestOnGrid(void) {
+  TEST_ASSERT_EQUAL_UINT32(10000, WakeupDelay(0, 10000, 2000));
+}
+
+void TestSnapToOther(void) {
+  WakeupInit(Clock, 0);
+  TEST_ASSERT_EQUAL_UINT32(10350, WakeupDelay(0, 10350, 0));
+  TEST_ASSERT_EQUAL_UINT32(10350, WakeupDelay(1, 9000, 2000));
+  // never moved earlier onto a deadline before its own
+  TEST_ASSERT_EQUAL_UINT32(10400, WakeupDelay(2, 10400, 2000));
+}
+
+void TestSnapBeforeGrid(void) {
+  // a deadline of another client is preferred over the grid
+  WakeupDelay(0, 10700, 0);
+  TEST_ASSERT_EQUAL_UINT32(10700, WakeupDelay(1, 9500, 2000));
+}
+
+void TestPassedIgnored(void) {
+  WakeupInit(Clock, 0);
+  WakeupDelay(0, 1000, 0);
+  now = 1001;
+  TEST_ASSERT_EQUAL_UINT32(500, WakeupDelay(1, 500, 2000));
+
+  uint32_t due = 0;
+  TEST_ASSERT_FALSE(WakeupGet(0, &due));
+}
+
+void TestCancel(void) {
+  WakeupInit(Clock, 0);
+  WakeupDelay(0, 1000, 0);
+  WakeupCancel(0);
+  TEST_ASSERT_EQUAL_UINT32(500, WakeupDelay(1, 500, 2000));
+}
+
+void TestPeriodKeepsPhase(void) {
+  // fires late on the grid every time, the nominal phase stays at 300
+  now = 300;
+  TEST_ASSERT_EQUAL_UINT32(15700, WakeupPeriod(0, 15000, 2000));
+
+  uint32_t due = 0;
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT_TRUE(WakeupGet(0, &due));
+    now = due;
+    TEST_ASSERT_EQUAL_UINT32(15000, WakeupPeriod(0, 15000, 2000));
+  }
+}
+
+void TestPeriodMissed(void) {
+  WakeupPeriod(0, 10000, 0);
+  // a whole period missed, restarts from now
+  now = 25000;
+  TEST_ASSERT_EQUAL_UINT32(10000, WakeupPeriod(0, 10000, 0));
+}
+
+void TestPeriodShorter(void) {
+  WakeupPeriod(0, 60000, 0);
+  now = 1000;
+  TEST_ASSERT_EQUAL_UINT32(10000, WakeupPeriod(0, 10000, 0));
+}
+
+void TestShared(void) {
+  // measurement every 60 s and tx every 15 s with different phases share
+  // every fourth wakeup
+  now = 37;
+  WakeupPeriod(0, 60000, 2000);
+  now = 412;
+  WakeupPeriod(1, 15000, 2000);
+
+  uint32_t measure = 0;
+  uint32_t tx = 0;
+  TEST_ASSERT_TRUE(WakeupGet(0, &measure));
+  TEST_ASSERT_TRUE(WakeupGet(1, &tx));
+  TEST_ASSERT_EQUAL_UINT32(61000, measure);
+  TEST_ASSERT_EQUAL_UINT32(16000, tx);
+
+  for (int i = 0; i < 3; i++) {
+    now = tx;
+    WakeupPeriod(1, 15000, 2000);
+    WakeupGet(1, &tx);
+  }
+  TEST_ASSERT_EQUAL_UINT32(measure, tx);
+}
+
+void TestSnapToProjected(void) {
+  WakeupInit(Clock, 0);
+  // tx every 15 s at 16700, 31700, 46700, 61700
+  now = 1700;
+  WakeupPeriod(1, 15000, 0);
+  now = 15000;
+  // the pending tx is too early, the one after next is within the slack
+  TEST_ASSERT_EQUAL_UINT32(46700, WakeupAt(0, 61000, 2000));
+}
+
+void TestProjectedPeriodOnly(void) {
+  WakeupInit(Clock, 0);
+  WakeupDelay(1, 15000, 0);
+  // one shot deadlines are not projected
+  TEST_ASSERT_EQUAL_UINT32(29000, WakeupDelay(0, 29000, 2000));
+}
+
+void TestProjectedMerges(void) {
+  // measurement phase just before tx, both end up in one wakeup
+  WakeupInit(Clock, 0);
+  now = 412;
+  WakeupPeriod(1, 15000, 2000);
+  now = 37;
+  WakeupAt(0, 60037, 2000);
+
+  uint32_t measure = 0;
+  uint32_t tx = 0;
+  WakeupGet(0, &measure);
+  TEST_ASSERT_EQUAL_UINT32(60412, measure);
+  for (int i = 0; i < 3; i++) {
+    WakeupGet(1, &tx);
+    now = tx;
+    WakeupPeriod(1, 15000, 2000);
+  }
+  WakeupGet(1, &tx);
+  TEST_ASSERT_EQUAL_UINT32(measure, tx);
+}
+
+void TestWrap(void) {
+  now = UINT32_MAX - 500;
+  TEST_ASSERT_EQUAL_UINT32(1000, WakeupDelay(0, 1000, 0));
+  TEST_ASSERT_EQUAL_UINT32(1000, WakeupDelay(1, 800, 2000));
+}
+
+void TestMaxSlack(void) {
+  now = 123;
+  WakeupSetMaxSlack(0);
+  TEST_ASSERT_EQUAL_UINT32(9500, WakeupDelay(0, 9500, 2000));
+
+  // neither the grid nor the other client moves the deadline
+  TEST_ASSERT_EQUAL_UINT32(9000, WakeupDelay(1, 9000, 2000));
+
+  // reset by init
+  WakeupInit(Clock, 1000);
+  TEST_ASSERT_EQUAL_UINT32(9877, WakeupDelay(0, 9500, 2000));
+}
+
+void TestInvalid(void) {
+  TEST_ASSERT_EQUAL_UINT32(1234, WakeupDelay(-1, 1234, 2000));
+  TEST_ASSERT_EQUAL_UINT32(1234, WakeupDelay(WAKEUP_MAX_CLIENTS, 1234, 2000));
+
+  uint32_t due = 0;
+  TEST_ASSERT_FALSE(WakeupGet(WAKEUP_MAX_CLIENTS, &due));
+  WakeupCancel(-1);
+}
+
+int main(void) {
+  HAL_Init();
+  SystemClock_Config();
+  MX_GPIO_Init();
+  MX_USART2_UART_Init();
+
+  // wait for UART
+  WaitForSerial();
+
+  UNITY_BEGIN();
+
+  RUN_TEST(TestGrid);
+  RUN_TEST(TestGridOutsideSlack);
+  RUN_TEST(TestOnGrid);
+  RUN_TEST(TestSnapToOther);
+  RUN_TEST(TestSnapBeforeGrid);
+  RUN_TEST(TestPassedIgnored);
+  RUN_TEST(TestCancel);
+  RUN_TEST(TestPeriodKeepsPhase);
+  RUN_TEST(TestPeriodMissed);
+  RUN_TEST(TestPeriodShorter);
+  RUN_TEST(TestShared);
+  RUN_TEST(TestSnapToProjected);
+  RUN_TEST(TestProjectedPeriodOnly);
+  RUN_TEST(TestProjectedMerges);
+  RUN_TEST(TestWrap);
+  RUN_TEST(TestMaxSlack);
+  RUN_TEST(TestInvalid);
+
+  UNITY_END();
+}
@@ -5,13 +5,25 @@
 
 HTTP server used for testing functionality of the ESP32 WiFi interface.
 
+With --fail or --fail-rate the upload is answered with a
+RepeatedSensorResponses message that fails single measurements, to test that
+the node uploads only those again.
+
 @author John Madden <jmadden173@pm.me>
 @date 2024-01-01
 """
 
 import argparse
+import random
 from http.server import BaseHTTPRequestHandler, HTTPServer
 
+from google.protobuf.message import DecodeError
+
+from ents.proto.sensor import (
+    decode_repeated_sensor_measurements,
+    encode_sensor_response,
+)
+
 
 class DirtvizRequestHandler(BaseHTTPRequestHandler):
     simulate_error = 0
@@ -33,12 +45,47 @@ class DirtvizRequestHandler(BaseHTTPRequestHandler):
             self.send_header('Content-type', 'text/octet-stream')
             self.end_headers()
             self.wfile.write(b"I'm a teapot not a coffee maker!")
+        elif self.server.fail or self.server.fail_rate:
+            self.send_response(200)
+            self.send_header('Content-type', 'text/octet-stream')
+            self.end_headers()
+            self.wfile.write(self.partial_failure(data))
         else:
             self.send_response(200)
             self.send_header('Content-type', 'text/octet-stream')
             self.end_headers()
             self.wfile.write(b"The world is your oyster!")
 
+    def partial_failure(self, data: bytes) -> bytes:
+        """Fails single measurements of an upload
+
+        Args:
+            data: Serialized RepeatedSensorMeasurements.
+
+        Returns:
+            Serialized RepeatedSensorResponses, idx counts the measurements
+            from 1.
+        """
+
+        try:
+            meas = decode_repeated_sensor_measurements(data)
+        except DecodeError:
+            print("Not a RepeatedSensorMeasurements, accepted")
+            return b""
+
+        count = len(meas.get("measurements", []))
+        resp = {"seq": meas.get("seq", 0), "responses": []}
+        for idx in range(1, count + 1):
+            if idx in self.server.fail or (
+                random.random() * 100 < self.server.fail_rate
+            ):
+                resp["responses"].append(
+                    {"idx": idx, "error": self.server.fail_error}
+                )
+
+        print(f"Response: {resp}")
+        return encode_sensor_response(resp)
+
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -49,9 +96,28 @@ if __name__ == "__main__":
                         help='Server port (default: 8080)')
     parser.add_argument('--error', action='store_true',
                         help='Send error on response')
+    parser.add_argument('--fail', type=int, action='append', default=[],
+                        metavar='IDX',
+                        help='Fail the measurement at IDX counted from 1 of '
+                        'every upload, can be repeated')
+    parser.add_argument('--fail-rate', type=float, default=0,
+                        metavar='PCT',
+                        help='Fail each measurement with a probability in '
+                        'percent (default: 0)')
+    parser.add_argument('--fail-error', type=str, default='GENERAL',
+                        help='SensorError of failed measurements, GENERAL, '
+                        'INVALID and DECODE are uploaded again (default: '
+                        'GENERAL)')
+    parser.add_argument('--seed', type=int, default=None,
+                        help='Seed of --fail-rate')
     args = parser.parse_args()
 
+    random.seed(args.seed)
+
     server_address = (args.address, args.port)
     httpd = HTTPServer(server_address, DirtvizRequestHandler)
     httpd.simulate_error = args.error
+    httpd.fail = args.fail
+    httpd.fail_rate = args.fail_rate
+    httpd.fail_error = args.fail_error
     httpd.serve_forever()